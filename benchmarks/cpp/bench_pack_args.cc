@@ -0,0 +1,115 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*!
+ * \file bench_pack_args.cc
+ * \brief Per-launch cost of device argument packing.
+ *
+ * Measures PackFuncVoidAddr and its memoizing variant with the argument
+ * mix a typical kernel launch carries (buffer handles plus scalar shape
+ * arguments). The arg/s counter is the packing roofline: it bounds how many
+ * kernel launches per second the host can feed before packing becomes the
+ * bottleneck.
+ */
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "../../src/runtime/pack_args.h"
+
+namespace {
+
+namespace ffi = tvm::ffi;
+using tvm::runtime::PackFuncVoidAddr;
+using tvm::runtime::PackFuncVoidAddrCached;
+
+constexpr DLDataType kHandleType{kDLOpaqueHandle, 64, 1};
+constexpr DLDataType kInt32Type{kDLInt, 32, 1};
+constexpr DLDataType kFloat32Type{kDLFloat, 32, 1};
+
+// A launch-like argument list: handles interleaved with scalar args that
+// need narrowing conversions.
+ffi::Array<DLDataType> MakeArgTypes(int num_args) {
+  ffi::Array<DLDataType> arg_types;
+  for (int i = 0; i < num_args; ++i) {
+    switch (i % 3) {
+      case 0:
+        arg_types.push_back(kHandleType);
+        break;
+      case 1:
+        arg_types.push_back(kInt32Type);
+        break;
+      default:
+        arg_types.push_back(kFloat32Type);
+        break;
+    }
+  }
+  return arg_types;
+}
+
+std::vector<ffi::AnyView> MakeArgs(int num_args, int64_t* dummy) {
+  std::vector<ffi::AnyView> args(num_args);
+  for (int i = 0; i < num_args; ++i) {
+    switch (i % 3) {
+      case 0:
+        args[i] = static_cast<void*>(&dummy[i]);
+        break;
+      case 1:
+        args[i] = static_cast<int64_t>(i);
+        break;
+      default:
+        args[i] = static_cast<double>(i);
+        break;
+    }
+  }
+  return args;
+}
+
+template <typename FPack>
+void RunPackBenchmark(benchmark::State& state, FPack fpack) {
+  int num_args = static_cast<int>(state.range(0));
+  ffi::Function packed = fpack(
+      [](ffi::PackedArgs, ffi::Any*, void** addr) { benchmark::DoNotOptimize(addr); },
+      MakeArgTypes(num_args));
+  std::vector<int64_t> dummy(num_args);
+  std::vector<ffi::AnyView> args = MakeArgs(num_args, dummy.data());
+  ffi::Any rv;
+  for (auto _ : state) {
+    packed.CallPacked(ffi::PackedArgs(args.data(), num_args), &rv);
+  }
+  state.counters["arg/s"] = benchmark::Counter(
+      static_cast<double>(state.iterations()) * num_args, benchmark::Counter::kIsRate);
+}
+
+void BM_PackFuncVoidAddr(benchmark::State& state) {
+  RunPackBenchmark(state, [](auto f, const ffi::Array<DLDataType>& arg_types) {
+    return PackFuncVoidAddr(f, arg_types);
+  });
+}
+
+void BM_PackFuncVoidAddrCached(benchmark::State& state) {
+  RunPackBenchmark(state, [](auto f, const ffi::Array<DLDataType>& arg_types) {
+    return PackFuncVoidAddrCached(f, arg_types);
+  });
+}
+
+BENCHMARK(BM_PackFuncVoidAddr)->Arg(4)->Arg(8)->Arg(16);
+BENCHMARK(BM_PackFuncVoidAddrCached)->Arg(4)->Arg(8)->Arg(16);
+
+}  // namespace
@@ -0,0 +1,220 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*!
+ * \file bench_rewrite_simplify.cc
+ * \brief Throughput of RewriteSimplifier on randomized expression corpora.
+ *
+ * Changes to the rewrite rules regress compile times silently: a new rule
+ * adds a pattern-match attempt to every node of its category, whether it
+ * fires or not.  These benchmarks generate seeded, reproducible corpora of
+ * index, min/max and comparison expressions over range-bound loop variables
+ * and measure simplifier throughput per category.  Alongside expr/s and
+ * node/s, each benchmark reports rewrites attempted and performed per
+ * expression (from the per-category counters on RewriteSimplifier) and the
+ * average number of iterations to reach a rewrite fixed point, so a rule
+ * addition comes with its measured cost.
+ *
+ * The corpora are deterministic: the benchmark argument is the expression
+ * depth, and the generator seed is fixed per category.  Re-run with
+ * `--benchmark_filter=RewriteSimplify` before and after a rule change to
+ * compare.
+ */
+#include <benchmark/benchmark.h>
+#include <tvm/arith/analyzer.h>
+#include <tvm/tirx/analysis.h>
+#include <tvm/tirx/expr.h>
+#include <tvm/tirx/op.h>
+#include <tvm/tirx/stmt_functor.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+namespace ffi = tvm::ffi;
+using tvm::Range;
+using tvm::arith::Analyzer;
+using tvm::tirx::ExprDeepEqual;
+using tvm::tirx::PostOrderVisit;
+using tvm::tirx::Var;
+using tvm::PrimExpr;
+
+constexpr int kCorpusSize = 64;
+constexpr int kMaxFixedPointIters = 16;
+
+/*!
+ * \brief Seeded random generator for simplifiable expressions.
+ *
+ * Leaves are loop-style variables (bound to [0, 1024) in the analyzer) and
+ * small constants; interior nodes are drawn per category.  Constant divisors
+ * and strides are kept small so that the generated expressions exercise the
+ * div/mod recombination rules rather than degenerating to opaque terms.
+ */
+class ExprGenerator {
+ public:
+  ExprGenerator(uint64_t seed, const std::vector<Var>& vars) : rng_(seed), vars_(vars) {}
+
+  PrimExpr Index(int depth) {
+    if (depth == 0) return Leaf();
+    PrimExpr a = Index(depth - 1);
+    switch (rng_() % 5) {
+      case 0:
+        return a + Index(depth - 1);
+      case 1:
+        return a - Index(depth - 1);
+      case 2:
+        return a * SmallConst();
+      case 3:
+        return tvm::tirx::floordiv(a, SmallConst());
+      default:
+        return tvm::tirx::floormod(a, SmallConst());
+    }
+  }
+
+  PrimExpr MinMax(int depth) {
+    if (depth == 0) return Index(2);
+    PrimExpr a = MinMax(depth - 1);
+    PrimExpr b = MinMax(depth - 1);
+    return (rng_() % 2) ? tvm::tirx::min(a, b) : tvm::tirx::max(a, b);
+  }
+
+  PrimExpr Compare(int depth) {
+    if (depth == 0) {
+      PrimExpr a = Index(2);
+      PrimExpr b = Index(2);
+      switch (rng_() % 4) {
+        case 0:
+          return a < b;
+        case 1:
+          return a <= b;
+        case 2:
+          return a == b;
+        default:
+          return a != b;
+      }
+    }
+    PrimExpr a = Compare(depth - 1);
+    PrimExpr b = Compare(depth - 1);
+    switch (rng_() % 3) {
+      case 0:
+        return a && b;
+      case 1:
+        return a || b;
+      default:
+        return !a;
+    }
+  }
+
+ private:
+  PrimExpr Leaf() {
+    if (rng_() % 4 == 0) return SmallConst();
+    return vars_[rng_() % vars_.size()];
+  }
+
+  PrimExpr SmallConst() {
+    return tvm::tirx::MakeConst(tvm::PrimType::Int(32), static_cast<int>(1 + rng_() % 16));
+  }
+
+  std::mt19937_64 rng_;
+  std::vector<Var> vars_;
+};
+
+int64_t CountNodes(const PrimExpr& expr) {
+  int64_t count = 0;
+  PostOrderVisit(expr, [&count](const ffi::ObjectRef&) { ++count; });
+  return count;
+}
+
+template <typename FGen>
+void RunSimplifyBenchmark(benchmark::State& state, uint64_t seed, FGen fgen) {
+  std::vector<Var> vars;
+  Analyzer ana;
+  for (int i = 0; i < 4; ++i) {
+    Var v("v" + std::to_string(i));
+    ana->Bind(v, Range::FromMinExtent(0, 1024));
+    vars.push_back(v);
+  }
+
+  ExprGenerator gen(seed, vars);
+  int depth = static_cast<int>(state.range(0));
+  std::vector<PrimExpr> corpus;
+  int64_t total_nodes = 0;
+  for (int i = 0; i < kCorpusSize; ++i) {
+    corpus.push_back(fgen(&gen, depth));
+    total_nodes += CountNodes(corpus.back());
+  }
+
+  // Fixed-point iteration count per expression, measured outside the
+  // timing loop: how many rewrite passes until the output stabilizes.
+  int64_t fixed_point_iters = 0;
+  for (const PrimExpr& expr : corpus) {
+    PrimExpr current = expr;
+    for (int iter = 1; iter <= kMaxFixedPointIters; ++iter) {
+      PrimExpr next = ana->rewrite_simplify(current);
+      fixed_point_iters++;
+      if (ExprDeepEqual()(next, current)) break;
+      current = next;
+    }
+  }
+
+  ana->rewrite_simplify.ResetStatsCounters();
+  for (auto _ : state) {
+    for (const PrimExpr& expr : corpus) {
+      benchmark::DoNotOptimize(ana->rewrite_simplify(expr));
+    }
+  }
+
+  double num_exprs = static_cast<double>(state.iterations()) * kCorpusSize;
+  state.counters["expr/s"] = benchmark::Counter(num_exprs, benchmark::Counter::kIsRate);
+  state.counters["node/s"] = benchmark::Counter(
+      static_cast<double>(state.iterations()) * total_nodes, benchmark::Counter::kIsRate);
+  state.counters["fixedpoint_iters/expr"] =
+      benchmark::Counter(static_cast<double>(fixed_point_iters) / kCorpusSize);
+
+  int64_t attempted = 0;
+  int64_t performed = 0;
+  for (const auto& [category, hits] : ana->rewrite_simplify.GetRuleHitCounters()) {
+    attempted += hits.at("attempted");
+    performed += hits.at("performed");
+  }
+  state.counters["attempted/expr"] = benchmark::Counter(attempted / num_exprs);
+  state.counters["performed/expr"] = benchmark::Counter(performed / num_exprs);
+}
+
+void BM_RewriteSimplifyIndex(benchmark::State& state) {
+  RunSimplifyBenchmark(state, /*seed=*/0x5eed0001,
+                       [](ExprGenerator* gen, int depth) { return gen->Index(depth); });
+}
+
+void BM_RewriteSimplifyMinMax(benchmark::State& state) {
+  RunSimplifyBenchmark(state, /*seed=*/0x5eed0002,
+                       [](ExprGenerator* gen, int depth) { return gen->MinMax(depth); });
+}
+
+void BM_RewriteSimplifyCompare(benchmark::State& state) {
+  RunSimplifyBenchmark(state, /*seed=*/0x5eed0003,
+                       [](ExprGenerator* gen, int depth) { return gen->Compare(depth); });
+}
+
+BENCHMARK(BM_RewriteSimplifyIndex)->Arg(4)->Arg(6)->Arg(8);
+BENCHMARK(BM_RewriteSimplifyMinMax)->Arg(2)->Arg(3)->Arg(4);
+BENCHMARK(BM_RewriteSimplifyCompare)->Arg(2)->Arg(3);
+
+}  // namespace
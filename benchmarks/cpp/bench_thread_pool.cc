@@ -0,0 +1,63 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*!
+ * \file bench_thread_pool.cc
+ * \brief Launch latency of the runtime thread pool.
+ *
+ * Measures the fixed cost of TVMBackendParallelLaunch with a no-op lambda,
+ * i.e. the fork/join overhead every parallel kernel pays before doing any
+ * work. The task/s counter gives the dispatch roofline for tiny kernels.
+ */
+#include <benchmark/benchmark.h>
+#include <tvm/runtime/c_backend_api.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+struct LaunchPayload {
+  std::vector<int64_t> acc;
+};
+
+int NoopLambda(int task_id, TVMParallelGroupEnv* penv, void* cdata) {
+  auto* payload = static_cast<LaunchPayload*>(cdata);
+  payload->acc[task_id] += task_id;
+  return 0;
+}
+
+void BM_ParallelLaunch(benchmark::State& state) {
+  int num_task = static_cast<int>(state.range(0));
+  LaunchPayload payload;
+  payload.acc.resize(num_task);
+  // Warm up the worker threads so the first timed launch does not pay
+  // thread creation.
+  TVMBackendParallelLaunch(NoopLambda, &payload, num_task);
+  for (auto _ : state) {
+    TVMBackendParallelLaunch(NoopLambda, &payload, num_task);
+  }
+  state.counters["launch/s"] =
+      benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+  state.counters["task/s"] = benchmark::Counter(
+      static_cast<double>(state.iterations()) * num_task, benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(BM_ParallelLaunch)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+
+}  // namespace
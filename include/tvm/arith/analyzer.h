@@ -391,6 +391,15 @@ class RewriteSimplifier {
   /*! \brief Return the statistics counters */
   TVM_DLL ffi::ObjectRef GetStatsCounters() const;
 
+  /*! \brief Return per-rule-category hit counters
+   *
+   * Rewrite rules are grouped by the root node kind they apply to
+   * (e.g. "tirx.Add").  For each such category this returns a map of
+   * "attempted" and "performed" to the corresponding counts, allowing
+   * the cost of a rule group to be measured in isolation.
+   */
+  TVM_DLL ffi::Map<ffi::String, ffi::Map<ffi::String, int64_t>> GetRuleHitCounters() const;
+
   /*! \brief Reset the statistics counters */
   TVM_DLL void ResetStatsCounters();
 
@@ -653,6 +662,21 @@ class Z3Prover {
    */
   ffi::String GetStats();
 
+  /*!
+   * \brief Get per-query counters of the prover.
+   *
+   * Counts queries issued, queries proved, queries given up because the
+   * solver returned unknown (time or rlimit budget exhausted), and queries
+   * skipped without invoking the solver. Useful to see which transform is
+   * burning solver time; reset them around a pass to attribute cost.
+   *
+   * \return A map from counter name to value.
+   */
+  TVM_DLL ffi::Map<ffi::String, int64_t> GetQueryCounters() const;
+
+  /*! \brief Reset the per-query counters to zero. */
+  TVM_DLL void ResetQueryCounters();
+
   /*!
    * \brief Set timeout in milliseconds for Z3 prover.
    *
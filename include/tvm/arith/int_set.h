@@ -263,6 +263,19 @@ IntSet Union(const ffi::Array<IntSet>& sets);
  */
 ffi::Array<IntSet> UnionRegion(const ffi::Array<ffi::Array<IntSet>>& nd_int_sets);
 
+/*!
+ * \brief Create a union of the sets, preserving disjoint intervals
+ *
+ * Unlike Union, which collapses the result to a single convex hull, the
+ * returned set keeps up to a bounded number of provably disjoint member
+ * intervals and only falls back to the hull when that bound is exceeded.
+ * This preserves the gaps of strided access patterns for consumers such as
+ * buffer compaction.
+ * \param sets The sets to be combined
+ * \return the set after union
+ */
+IntSet UnionBounded(const ffi::Array<IntSet>& sets);
+
 /*!
  * \brief Create a lower-bound of union set, where some of the segments may be dropped
  * \param sets The sets to be combined
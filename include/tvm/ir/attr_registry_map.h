@@ -25,6 +25,7 @@
 
 #include <tvm/ffi/string.h>
 
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -93,9 +94,91 @@ class AttrRegistryMapContainerMap {
   AttrRegistryMapContainerMap() = default;
   template <typename, typename>
   friend class AttrRegistry;
+  template <typename, typename>
+  friend class AttrRegistryTable;
   friend class OpRegEntry;
 };
 
+/*!
+ * \brief Typed snapshot of an attribute map for hot lookup loops.
+ *
+ * AttrRegistryMap resolves every lookup through ffi::Any, paying a type cast
+ * per call. A table materializes the attribute column once, casting each
+ * registered entry to ValueType eagerly, so a lookup reduces to one vector
+ * index and a presence test with no per-call casting.
+ *
+ * The table is a snapshot: attributes registered after construction are not
+ * visible. Construct it after the registration static-init blocks have run,
+ * e.g. as a function-local static or at pass entry.
+ *
+ * \tparam KeyType The type of the key.
+ * \tparam ValueType The type of the value stored in the map.
+ */
+template <typename KeyType, typename ValueType>
+class AttrRegistryTable {
+ public:
+  /*!
+   * \brief constructor
+   * \param map The map to snapshot.
+   */
+  explicit AttrRegistryTable(const AttrRegistryMapContainerMap<KeyType>& map)
+      : attr_name_(map.attr_name_) {
+    data_.reserve(map.data_.size());
+    for (const auto& [value, plevel] : map.data_) {
+      if (plevel != 0) {
+        data_.push_back(value.template cast<ValueType>());
+      } else {
+        data_.push_back(std::nullopt);
+      }
+    }
+  }
+  /*!
+   * \brief Check if the table has key.
+   * \param key The key to the table.
+   * \return 1 if key is contained in the table, 0 otherwise.
+   */
+  int count(const KeyType& key) const {
+    if (key.defined()) {
+      const uint32_t idx = key->AttrRegistryIndex();
+      return idx < data_.size() ? data_[idx].has_value() : 0;
+    } else {
+      return 0;
+    }
+  }
+  /*!
+   * \brief get the corresponding value element at key.
+   * \param key The key to the table.
+   * \return the const reference to the content value.
+   */
+  const ValueType& operator[](const KeyType& key) const {
+    TVM_FFI_ICHECK(key.defined());
+    const uint32_t idx = key->AttrRegistryIndex();
+    TVM_FFI_ICHECK(idx < data_.size() && data_[idx].has_value())
+        << "Attribute " << attr_name_ << " has not been registered for " << key->name;
+    return *data_[idx];
+  }
+  /*!
+   * \brief get the corresponding value element at key with default value.
+   * \param key The key to the table.
+   * \param def_value The default value when the key does not exist.
+   * \return the content value.
+   */
+  ValueType get(const KeyType& key, ValueType def_value) const {
+    TVM_FFI_ICHECK(key.defined());
+    const uint32_t idx = key->AttrRegistryIndex();
+    if (idx < data_.size() && data_[idx].has_value()) {
+      return *data_[idx];
+    }
+    return def_value;
+  }
+
+ private:
+  /*! \brief The name of the attr field */
+  ffi::String attr_name_;
+  /*! \brief The pre-cast attribute column, indexed by registry index. */
+  std::vector<std::optional<ValueType>> data_;
+};
+
 /*!
  * \brief ffi::Map<Key, ValueType> used to store meta-data.
  * \tparam KeyType The type of the key
@@ -35,6 +35,7 @@
 #include <tvm/ir/source_map.h>
 #include <tvm/ir/type.h>
 
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -304,6 +305,82 @@ class IRModule : public ffi::ObjectRef {
   TVM_DEFINE_OBJECT_REF_COW_METHOD(IRModuleNode);
 };
 
+/*!
+ * \brief Stages a batch of function updates and removals against an IRModule
+ *        and commits them with a single rebuild of the underlying maps.
+ *
+ * IRModuleNode::Update and IRModuleNode::Remove go through the copy-on-write
+ * function map, so each call against a module whose maps are still shared
+ * pays a full map copy — a pass that rewrites a thousand functions can pay a
+ * thousand copies. A batch updater stages the changes in side tables and
+ * applies them in Commit with one pass over the module, rebuilding
+ * `functions` and `global_var_map_` exactly once.
+ *
+ * The updater also resolves global vars by name against the staged state, so
+ * name-keyed updates observe earlier staged additions and removals without
+ * touching the module per call.
+ *
+ * Operations are applied in staging order: updating a var that was staged
+ * for removal re-adds it, and removing a staged update drops it. The module
+ * is unchanged until Commit runs; a destroyed updater with uncommitted
+ * changes leaves the module as it was.
+ *
+ * \code
+ *   IRModuleBatchUpdater updater(mod);
+ *   for (const auto& [gvar, func] : new_funcs) {
+ *     updater.Update(gvar, func);
+ *   }
+ *   updater.Commit();
+ * \endcode
+ */
+class TVM_DLL IRModuleBatchUpdater {
+ public:
+  /*!
+   * \brief Construct an updater staging changes against a module.
+   * \param mod The module to update on Commit.
+   */
+  explicit IRModuleBatchUpdater(IRModule mod);
+
+  /*!
+   * \brief Stage an update (or addition) of a function.
+   * \param var The global var of the function.
+   * \param func The new function body.
+   */
+  void Update(const GlobalVar& var, BaseFunc func);
+
+  /*!
+   * \brief Stage a removal of a function.
+   * \param var The global var of the function to remove.
+   */
+  void Remove(const GlobalVar& var);
+
+  /*!
+   * \brief Look up a global var by name in the staged state.
+   * \param name The name of the global var.
+   * \return The global var, or std::nullopt if the staged module has no
+   *         function of that name.
+   */
+  std::optional<GlobalVar> GetGlobalVar(const ffi::String& name) const;
+
+  /*!
+   * \brief Apply all staged changes to the module with one map rebuild.
+   *
+   * After Commit the updater is empty and may be reused for another batch
+   * against the same module.
+   */
+  void Commit();
+
+ private:
+  /*! \brief The module the staged changes apply to. */
+  IRModule mod_;
+  /*! \brief Staged function updates and additions, latest write per var. */
+  std::unordered_map<GlobalVar, BaseFunc> updates_;
+  /*! \brief Vars staged for removal. */
+  std::unordered_set<GlobalVar> removed_;
+  /*! \brief Name index over the staged state, built once per batch. */
+  std::unordered_map<std::string, GlobalVar> name_index_;
+};
+
 namespace attr {
 
 // Following are attributes for IRModule only.
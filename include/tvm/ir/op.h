@@ -43,6 +43,14 @@ namespace tvm {
 // forward declare name.
 template <typename>
 class OpAttrMap;
+class Op;
+
+/*!
+ * \brief Typed attribute snapshot about Op, see AttrRegistryTable.
+ * \tparam ValueType The type of the value stored in the table.
+ */
+template <typename ValueType>
+using OpAttrTable = AttrRegistryTable<Op, ValueType>;
 
 /*!
  * \brief Information about an input field of an Op (name, type, description).
@@ -175,6 +183,20 @@ class Op : public Expr {
    */
   template <typename ValueType>
   inline static OpAttrMap<ValueType> GetAttrMap(const ffi::String& attr_name);
+  /*!
+   * \brief Get a typed snapshot of a registered attribute for hot lookup loops.
+   *
+   *  Unlike GetAttrMap, the returned table pre-casts every registered entry
+   *  to ValueType, so lookups are a plain vector index with no per-call Any
+   *  cast. Attributes registered after the snapshot is taken are not
+   *  visible; take the snapshot once per pass (e.g. as a function-local
+   *  static).
+   * \param attr_name The name of the attribute.
+   * \return An OpAttrTable of specified attr_name.
+   * \tparam ValueType The type of the attribute.
+   */
+  template <typename ValueType>
+  inline static OpAttrTable<ValueType> GetAttrTable(const ffi::String& attr_name);
   /*!
    * \brief Checks if an attr map is present in the registry.
    * \param attr_name The name of the attribute.
@@ -359,6 +381,11 @@ inline OpAttrMap<ValueType> Op::GetAttrMap(const ffi::String& key) {
   return OpAttrMap<ValueType>(Op::GetAttrMapContainer(key));
 }
 
+template <typename ValueType>
+inline OpAttrTable<ValueType> Op::GetAttrTable(const ffi::String& key) {
+  return OpAttrTable<ValueType>(Op::GetAttrMapContainer(key));
+}
+
 inline OpNode* OpRegEntry::get() { return const_cast<OpNode*>(op_.operator->()); }
 
 inline OpRegEntry& OpRegEntry::describe(const std::string& descr) {  // NOLINT(*)
@@ -344,6 +344,13 @@ class PassInfoNode : public ffi::Object {
   /*! \brief Boolean that tells whether this pass will be traced or not. */
   bool traceable;
 
+  /*!
+   * \brief Whether the pass only reads and rewrites the function it is applied
+   *  to, without touching the rest of the module. Function-pass executors may
+   *  map such passes across a module's functions in parallel.
+   */
+  bool function_local;
+
   /*! \brief The passes that are required to perform the current pass. */
   ffi::Array<ffi::String> required;
 
@@ -355,7 +362,8 @@ class PassInfoNode : public ffi::Object {
         .def_ro("opt_level", &PassInfoNode::opt_level)
         .def_ro("name", &PassInfoNode::name)
         .def_ro("required", &PassInfoNode::required)
-        .def_ro("traceable", &PassInfoNode::traceable);
+        .def_ro("traceable", &PassInfoNode::traceable)
+        .def_ro("function_local", &PassInfoNode::function_local);
   }
   TVM_FFI_DECLARE_OBJECT_INFO_FINAL("transform.PassInfo", PassInfoNode, ffi::Object);
 };
@@ -372,9 +380,11 @@ class PassInfo : public ffi::ObjectRef {
    * \param name Name of the pass.
    * \param required  The passes that are required to perform the current pass.
    * \param traceable Boolean that tells whether the pass is traceable.
+   * \param function_local Whether the pass is function-local and thus safe to
+   *        run over a module's functions in parallel.
    */
   TVM_DLL PassInfo(int opt_level, ffi::String name, ffi::Array<ffi::String> required,
-                   bool traceable);
+                   bool traceable, bool function_local = false);
 
   TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(PassInfo, ffi::ObjectRef, PassInfoNode);
 };
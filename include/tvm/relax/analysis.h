@@ -548,6 +548,41 @@ struct VarUsageInfo {
  */
 VarUsageInfo CollectVarUsage(const Expr& expr);
 
+/*!
+ * \brief Collect variable bindings and usage, memoizing the result.
+ *
+ * Equivalent to CollectVarUsage, but consults a process-wide cache keyed
+ * by the identity of the (immutable) expression.  A pipeline of transforms
+ * that each query use-def information for the same function therefore only
+ * traverses it once, rather than once per transform.
+ *
+ * The cache keeps a bounded number of entries, evicting the least recently
+ * used one when full, and holds strong references to the cached expressions
+ * so that a key cannot be freed and its address reused while an entry is
+ * alive.  The capacity can be adjusted with the
+ * TVM_RELAX_VAR_USAGE_CACHE_CAPACITY environment variable; a capacity of
+ * zero disables the cache.
+ *
+ * \param expr The expression to analyze
+ *
+ * \return The collected information
+ */
+VarUsageInfo CollectVarUsageCached(const Expr& expr);
+
+/*!
+ * \brief Seed the use-def cache with a known analysis result.
+ *
+ * Transforms that rewrite an already-analyzed expression in a way whose
+ * effect on the use-def chains is known (e.g. dropping a set of bindings)
+ * can derive the usage of the rewritten expression from the original
+ * analysis and record it here, so that downstream consumers of
+ * CollectVarUsageCached do not need to re-traverse the result.
+ *
+ * \param expr The expression the information describes
+ * \param info The usage information for the expression
+ */
+void UpdateVarUsageCache(const Expr& expr, VarUsageInfo info);
+
 /*!
  * \brief Get the used variables in an expression.
  *
@@ -51,12 +51,15 @@ using LayoutCb = ffi::TypedFunction<ffi::Map<ffi::String, ffi::Array<ffi::String
  * \param name The name of the function pass.
  * \param required The list of the passes that the function pass is dependent on.
  * \param traceable Boolean variable whether the dataflowblock pass is traceable.
+ * \param function_local Whether the pass is function-local, allowing the
+ *        executor to process the module's functions in parallel.
  *
  * \return The created function pass.
  */
 TVM_DLL Pass CreateFunctionPass(std::function<Function(Function, IRModule, PassContext)> pass_func,
                                 int opt_level, ffi::String name,
-                                tvm::ffi::Array<ffi::String> required, bool traceable = false);
+                                tvm::ffi::Array<ffi::String> required, bool traceable = false,
+                                bool function_local = false);
 
 /*!
  * \brief Create a dataflowblock pass.
@@ -218,6 +221,41 @@ TVM_DLL Pass BindParams(ffi::String func_name, ffi::Map<Any, ffi::ObjectRef> par
 TVM_DLL Pass BindSymbolicVars(ffi::Map<ffi::Variant<tirx::Var, ffi::String>, PrimExpr> binding_map,
                               ffi::Optional<ffi::String> func_name = std::nullopt);
 
+/*!
+ * \brief Specialize exposed functions for declared symbolic-shape buckets and
+ *  replace them with a runtime dispatcher.
+ *
+ * Each exposed function using a bucketed symbolic variable is cloned once per
+ * bucket value (per combination of values if it uses several bucketed
+ * variables) with the variable bound to that constant, so the clones compile
+ * with fully static shapes. The function itself becomes a dispatcher that
+ * compares the runtime shape value against the buckets and calls the matching
+ * clone, falling back to the original dynamic version.
+ *
+ * \param buckets A map from symbolic variable name (e.g. "seq_len") to the
+ *      shape values to specialize for.
+ *
+ * \return The Pass.
+ */
+TVM_DLL Pass ShapeBucketDispatch(ffi::Map<ffi::String, ffi::Array<IntImm>> buckets);
+
+/*!
+ * \brief Derive batched variants of per-request entry functions.
+ *
+ * Each selected exposed function is cloned into a `<name>_batched` variant in
+ * which every tensor parameter with a static leading dimension of 1 has that
+ * dimension replaced by one shared symbolic `batch_size`, and the body is
+ * re-derived so the batch dimension propagates through the call graph. Ragged
+ * sequence dimensions are unaffected: they stay flattened into the token axis
+ * per the KV cache convention. The original functions are kept.
+ *
+ * \param func_names The global symbols of the functions to batch. If empty,
+ *      every exposed function is considered.
+ *
+ * \return The Pass.
+ */
+TVM_DLL Pass AutoBatch(ffi::Array<ffi::String> func_names);
+
 /*!
  * \brief Fold constant expressions within dataflow blocks.
  *
@@ -273,6 +311,22 @@ TVM_DLL Pass RealizeVDevice();
  */
 TVM_DLL Pass AttachAttrLayoutFreeBuffers();
 
+/*!
+ * \brief Fuse `dequantize` into the `matmul` consuming its result.
+ *
+ * This pass groups `matmul(x, dequantize(w, scale, zero_point))` (optionally
+ * with a `permute_dims` between them) into one primitive function, so that
+ * after legalization FuseTIR emits a single kernel that dequantizes the
+ * weight on the fly. The quantized weight then stays in its packed layout
+ * end-to-end and only the quantized bits are read from memory, instead of a
+ * full-precision copy being materialized before the matmul.
+ *
+ * \note Apply before LegalizeOps. AttachAttrLayoutFreeBuffers can mark the
+ * quantized weight layout-free in the fused PrimFunc afterwards.
+ * \return The Pass.
+ */
+TVM_DLL Pass FuseDequantizeMatmul();
+
 /*!
  * \brief Split the layout rewrite preproc block to a separate tirx::PrimFunc.
  *
@@ -659,12 +713,48 @@ TVM_DLL Pass DataflowUseInplaceCalls();
  * \param out_dtype The output data type of gemm/conv, which is the data type of the accumulator.
  * \param fp16_input_names The names of function parameters whose dtype should become fp16. The
  * function signature would change accordingly.
+ * \param policy_override Per-op overrides of the registered TMixedPrecisionPolicy, mapping an op
+ * name to "always", "follow" or "never". Measurement-driven tuning (see
+ * tvm.relax.transform.tune_mixed_precision) produces this map per target.
  * \return The Pass.
  *
  * \note Mainly operates within dataflow blocks. ConvertToDataflow may need to be called first.
  */
 TVM_DLL Pass ToMixedPrecision(
-    DLDataType out_dtype, ffi::Optional<ffi::Array<ffi::String>> fp16_input_names = std::nullopt);
+    DLDataType out_dtype, ffi::Optional<ffi::Array<ffi::String>> fp16_input_names = std::nullopt,
+    ffi::Optional<ffi::Map<ffi::String, ffi::String>> policy_override = std::nullopt);
+
+/*!
+ * \brief Overlap cross-device `to_vdevice` transfers with compute. Transfers inside
+ * dataflow blocks are split into an asynchronous copy on a dedicated copy stream at the
+ * original binding site and a stream-wait in front of the first consumer, so compute
+ * issued in between runs while the copy is in flight.
+ * \note Only transfers to the "global" memory scope consumed within the same dataflow
+ * block are rewritten. ConvertToDataflow may need to be called first.
+ */
+TVM_DLL Pass OverlapDeviceTransfers();
+
+/*!
+ * \brief Assign independent dependency chains inside dataflow blocks to numbered
+ * compute streams, so parallel branches (e.g. MoE experts) overlap on the device.
+ * Stream switches and event joins are inserted as `vm.builtin.stream_switch` /
+ * `vm.builtin.stream_join` calls that thread a representative tensor, so no new
+ * VM opcodes are involved and the synchronization survives dead-code elimination.
+ * \param max_streams Number of physical streams chains are mapped onto, including
+ * the default stream 0.
+ * \note Purely serial blocks are left untouched. The pass should run before
+ * memory planning so the inserted bindings are visible to liveness analysis.
+ */
+TVM_DLL Pass AssignComputeStreams(int max_streams);
+
+/*!
+ * \brief Rewrite stateless QKV-projection + attention chains to the paged KV cache
+ * runtime builtins. Each rewritten function gains a trailing cache object parameter,
+ * and attention sites are assigned layer ids in program order.
+ * \note Only causal attention sites with static shapes are rewritten. Rotary embedding
+ * and cache append are performed inside the builtin per the cache configuration.
+ */
+TVM_DLL Pass RewriteAttentionKVCache();
 
 /*!
  * \brief Rewrite a Relax module for executing with CUDA graph. This pass identifies
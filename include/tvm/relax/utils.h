@@ -133,6 +133,19 @@ TVM_DLL bool IsImpureCall(const Call& call);
  */
 TVM_DLL Function CopyWithNewVars(Function func);
 
+/*!
+ * \brief Bind symbolic vars of a function to constant shape values.
+ *
+ * \param func The function to update.
+ * \param obj_remap The dictionary of symbolic variables and their replacement
+ *      values. Dictionary keys may be either a `tirx.Var` or a string name of
+ *      the variable; a name must uniquely identify a symbolic variable of the
+ *      function.
+ * \return The updated function.
+ */
+TVM_DLL Function FunctionBindSymbolicVars(
+    Function func, ffi::Map<ffi::Variant<tirx::Var, ffi::String>, PrimExpr> obj_remap);
+
 /*!
  * \brief Transform all dataflow structure to non-dataflow version.
  */
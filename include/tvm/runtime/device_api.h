@@ -189,6 +189,31 @@ class TVM_RUNTIME_DLL DeviceAPI {
    * \param ptr The data space.
    */
   virtual void FreeDataSpace(Device dev, void* ptr) = 0;
+  /*!
+   * \brief Allocate a data space ordered on a stream.
+   *
+   * The returned pointer may only be used by work ordered after the
+   * allocation on \p stream, which lets callers allocate without
+   * synchronizing the device.
+   *
+   * \param dev The device device to perform operation.
+   * \param nbytes The number of bytes in memory.
+   * \param alignment The alignment of the memory.
+   * \param type_hint The type of elements.
+   * \param stream The stream the allocation is ordered on.
+   * \return The allocated device pointer.
+   * \note Backends without stream-ordered allocation fall back to
+   *       AllocDataSpace.
+   */
+  virtual void* AllocDataSpaceAsync(Device dev, size_t nbytes, size_t alignment,
+                                    DLDataType type_hint, TVMStreamHandle stream);
+  /*!
+   * \brief Free a data space ordered on a stream.
+   * \param dev The device device to perform operation.
+   * \param ptr The data space.
+   * \param stream The stream the free is ordered on.
+   */
+  virtual void FreeDataSpaceAsync(Device dev, void* ptr, TVMStreamHandle stream);
   /*!
    * \brief copy data from one place to another
    * \note This API is designed to support special memory with shape dependent layout.
@@ -310,6 +335,53 @@ class TVM_RUNTIME_DLL DeviceAPI {
                               DLDataType type_hint, TVMStreamHandle stream);
 };
 
+/*!
+ * \brief Immutable snapshot of commonly queried device attributes.
+ *
+ * Fields stay at their defaults when the device does not exist or its API
+ * does not report the attribute. Volatile attributes such as
+ * kAvailableGlobalMemory are deliberately excluded: the snapshot is queried
+ * once per device and never refreshed.
+ */
+struct DeviceCapability {
+  /*! \brief Whether the device exists and its runtime is enabled. */
+  bool exist{false};
+  /*! \brief Maximum number of threads per block / work group. */
+  int max_threads_per_block{0};
+  /*! \brief Number of threads per warp / wavefront / subgroup. */
+  int warp_size{1};
+  /*! \brief Maximum shared memory per block in bytes. */
+  int max_shared_memory_per_block{0};
+  /*! \brief Number of streaming multiprocessors / compute units. */
+  int multi_processor_count{0};
+  /*! \brief Maximum number of registers per block. */
+  int max_registers_per_block{0};
+  /*! \brief Peak clock rate in kHz. */
+  int max_clock_rate{0};
+  /*! \brief Device API version. */
+  int api_version{0};
+  /*! \brief L2 cache size in bytes. */
+  int64_t l2_cache_size_bytes{0};
+  /*! \brief Total global memory in bytes. */
+  int64_t total_global_memory{0};
+  /*! \brief Device name as reported by the driver. */
+  std::string device_name;
+  /*! \brief Compute capability / version string. */
+  std::string compute_version;
+};
+
+/*!
+ * \brief Get the capability snapshot of a device.
+ *
+ * The snapshot is populated through DeviceAPI::GetAttr on first use and
+ * cached for the lifetime of the process, so hot paths can read device
+ * limits without paying a driver round trip per query.
+ *
+ * \param dev The device to query.
+ * \return The cached snapshot of the device.
+ */
+TVM_RUNTIME_DLL const DeviceCapability& GetDeviceCapability(Device dev);
+
 /*!
  * \brief The name of DLDeviceType.
  * \param type The device type.
@@ -139,6 +139,23 @@ TVM_RUNTIME_DLL void SendToWorker(Tensor buffer, int receiver_id);
  * \param sender_id The global sender worker id.
  */
 TVM_RUNTIME_DLL void RecvFromWorker(Tensor buffer, int sender_id);
+/*!
+ * \brief Redistribute a parameter sharded along dimension 0 when the number of shards
+ * changes, exchanging the overlapping row ranges between workers via direct worker-to-worker
+ * copies (GPU-to-GPU under NCCL). This enables elastic tensor parallelism: the tensor-parallel
+ * degree can be scaled up or down at runtime without reloading the model from disk.
+ * All workers must call this function with the same shard counts. Workers with id below
+ * `old_num_shards` must provide `send` (their current shard); workers with id below
+ * `new_num_shards` must provide `recv` (the buffer for their new shard); other workers
+ * pass None for both and no-op.
+ * \param send The local shard under the old sharding, or None if this worker holds no shard.
+ * \param old_num_shards The number of shards the parameter is currently divided into.
+ * \param new_num_shards The number of shards the parameter is redistributed into.
+ * \param recv The buffer for the local shard under the new sharding, or None if this worker
+ * receives no shard.
+ */
+TVM_RUNTIME_DLL void ReshardRowSharded(ffi::Optional<Tensor> send, int64_t old_num_shards,
+                                       int64_t new_num_shards, ffi::Optional<Tensor> recv);
 /*! \brief Get the local worker id */
 TVM_RUNTIME_DLL int WorkerId();
 /*!
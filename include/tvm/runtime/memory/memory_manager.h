@@ -27,6 +27,7 @@
 #include <tvm/runtime/base.h>
 #include <tvm/runtime/tensor.h>
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -41,6 +42,7 @@ namespace memory {
 enum AllocatorType {
   kNaive = 1,
   kPooled,
+  kAsync,
 };
 
 struct Buffer {
@@ -54,6 +56,46 @@ struct Buffer {
   AllocatorType alloc_type;
 };
 
+/*!
+ * \brief Process-wide tracer recording every allocator Alloc/Free.
+ *
+ * When enabled, each event is appended as a fixed-size record (byte delta,
+ * device, attribution tag, timestamp) to a bounded ring buffer that drops
+ * the oldest events, and a live per-tag byte count with its high-water mark
+ * is maintained, so an out-of-memory dump shows which op drove the peak.
+ * When disabled the only cost at an allocation site is one relaxed atomic
+ * load, so the tracing hooks can stay compiled in for production builds.
+ */
+class TVM_RUNTIME_DLL AllocationTracer {
+ public:
+  /*! \brief Whether tracing is active; allocation sites guard Record* calls with this. */
+  static bool Enabled() { return enabled_.load(std::memory_order_relaxed); }
+  /*!
+   * \brief Enable tracing, discarding previously recorded state.
+   * \param max_records Number of trace records retained; older events are dropped.
+   */
+  static void Start(int64_t max_records);
+  /*! \brief Disable tracing, keeping the recorded events for Dump. */
+  static void Stop();
+  /*!
+   * \brief Render the per-tag statistics and retained events as JSON,
+   *        draining the event ring.
+   */
+  static std::string Dump();
+  /*!
+   * \brief Set the attribution tag of the calling thread, typically the name
+   *        of the VM function about to run.
+   */
+  static void SetCurrentTag(const std::string& tag);
+  /*! \brief Record an allocation under the calling thread's tag. */
+  static void RecordAlloc(const Buffer& buffer);
+  /*! \brief Record a free, attributed to the tag that allocated the buffer. */
+  static void RecordFree(const Buffer& buffer);
+
+ private:
+  static std::atomic<bool> enabled_;
+};
+
 class TVM_RUNTIME_DLL Allocator {
  public:
   explicit Allocator(AllocatorType type) : type_(type) {}
@@ -29,6 +29,9 @@
 #include <tvm/runtime/device_api.h>
 #include <tvm/runtime/tensor.h>
 
+#include <cstdint>
+#include <string>
+
 namespace tvm {
 namespace runtime {
 
@@ -188,6 +191,34 @@ ffi::Function WrapTimeEvaluator(ffi::Function f, Device dev, int number, int rep
                                 int cooldown_interval_ms, int repeats_to_cooldown,
                                 int cache_flush_bytes = 0, ffi::Function f_preproc = nullptr);
 
+/*!
+ * \brief Check whether the global device trace recorder is collecting spans.
+ *
+ * The recorder is an always-compiled, opt-in tracing surface: spans are
+ * written into a fixed-size ring without taking locks, so leaving the check
+ * inline on hot paths costs a single relaxed atomic load when disabled.
+ * Enable it with the `runtime.trace.Enable` global function.
+ */
+TVM_RUNTIME_DLL bool DeviceTraceEnabled();
+
+/*!
+ * \brief Record one timestamped span into the global device trace recorder.
+ *
+ * No-op when the recorder is disabled. When the ring is full the oldest
+ * spans are overwritten, keeping the recorder safe to leave enabled in
+ * long-running serving processes.
+ *
+ * \param name The span name, e.g. the called function.
+ * \param dev The device the span is attributed to.
+ * \param begin_ns Span begin, as returned by DeviceTraceNowNanos.
+ * \param end_ns Span end, as returned by DeviceTraceNowNanos.
+ */
+TVM_RUNTIME_DLL void DeviceTraceRecordSpan(const std::string& name, Device dev, int64_t begin_ns,
+                                           int64_t end_ns);
+
+/*! \brief Monotonic timestamp in nanoseconds to pair with DeviceTraceRecordSpan. */
+TVM_RUNTIME_DLL int64_t DeviceTraceNowNanos();
+
 }  // namespace runtime
 }  // namespace tvm
 
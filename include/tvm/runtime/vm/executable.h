@@ -28,6 +28,7 @@
 #include <tvm/support/io.h>
 #include <tvm/support/serializer.h>
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -44,6 +45,9 @@ namespace tvm {
 namespace runtime {
 namespace vm {
 
+/*! \brief Frozen per-executable function resolution table, defined in vm.cc. */
+struct VMLinkTable;
+
 /*!
  * \brief Information entry in executable function table.
  *
@@ -125,6 +129,14 @@ class TVM_RUNTIME_DLL VMExecutable : public ffi::ModuleObj {
    * \return The binary bytes that save the executable to.
    */
   ffi::Bytes SaveToBytes() const final;
+  /*!
+   * \brief Write the VMExecutable in the legacy fixed-width (V2) layout.
+   *
+   * Only used by tests to guard that executables serialized before the
+   * compact V3 code section keep loading.
+   * \return The binary bytes of the legacy serialization.
+   */
+  ffi::Bytes SaveToBytesLegacy() const;
   /*!
    * \brief Load VMExecutable from the binary stream in serialized form.
    * \param bytes The binary bytes that load the executable from.
@@ -139,6 +151,15 @@ class TVM_RUNTIME_DLL VMExecutable : public ffi::ModuleObj {
   void WriteToFile(const ffi::String& file_name, const ffi::String& format) const final;
   /*! \brief Create a Relax virtual machine and load `this` as the executable. */
   ffi::Module VMLoadExecutable() const;
+  /*!
+   * \brief List the global functions the executable resolves by name at runtime.
+   *
+   * These are the environment functions (e.g. the `vm.builtin.*` surface) the
+   * bytecode calls, recorded by the exec builder. A deployment build can use
+   * the list to link a runtime that registers only what the artifact needs.
+   * \return The sorted, de-duplicated function names.
+   */
+  ffi::Array<ffi::String> UsedGlobalFuncNames() const;
   /*! \brief Check if the VMExecutable contains a specific function. */
   bool HasFunction(const ffi::String& name) const;
   /*!
@@ -147,6 +168,23 @@ class TVM_RUNTIME_DLL VMExecutable : public ffi::ModuleObj {
    * \return The loaded executable, in the form of a `runtime::Module`.
    */
   static ffi::Module LoadFromFile(const ffi::String& file_name);
+  /*!
+   * \brief Link two executables into one, so several models (e.g. a draft and a
+   * target model for speculative decoding) run in one virtual machine with shared
+   * streams and no inter-process communication.
+   *
+   * The constant pools are merged with value-based deduplication, so constants the
+   * two modules share (embedding tables, rotary tables, etc.) are stored and
+   * uploaded once. Bytecode of `rhs` is appended with its constant and function
+   * indices rewritten; packed-function and VMTIR entries are unified by name, and
+   * the VM functions of `rhs` are renamed with `rhs_prefix` to keep entry points
+   * like "prefill"/"decode" distinct.
+   * \param lhs The first executable.
+   * \param rhs The second executable.
+   * \param rhs_prefix The prefix prepended to the VM function names of `rhs`.
+   * \return The linked executable, in the form of a `runtime::Module`.
+   */
+  static ffi::Module Link(ffi::Module lhs, ffi::Module rhs, ffi::String rhs_prefix);
 
   /*! \brief The virtual machine's function table. */
   std::vector<VMFuncInfo> func_table;
@@ -160,6 +198,13 @@ class TVM_RUNTIME_DLL VMExecutable : public ffi::ModuleObj {
   std::vector<Index> instr_offset;
   /*! \brief The byte data of instruction. */
   std::vector<ExecWord> instr_data;
+  /*!
+   * \brief Frozen name-resolution results shared by all VM instances.
+   *
+   * Built lazily by the first virtual machine that loads this executable;
+   * later instances link against it without any name-based lookups.
+   */
+  std::shared_ptr<VMLinkTable> link_table;
 
   virtual ~VMExecutable() {}
 
@@ -216,8 +261,9 @@ class TVM_RUNTIME_DLL VMExecutable : public ffi::ModuleObj {
   /*!
    * \brief Load the instructions.
    * \param strm The input stream.
+   * \param header_magic The file magic, which selects the code encoding.
    */
-  void LoadCodeSection(support::Stream* strm);
+  void LoadCodeSection(support::Stream* strm, uint64_t header_magic);
   /*!
    * \brief Save the packed functions.
    * \param strm The input stream.
@@ -55,6 +55,24 @@ enum class VMInstrumentReturnKind : int {
   kSkipRun = 1,
 };
 
+/*!
+ * \brief The bytecode dispatch strategy used by the VM interpreter loop.
+ */
+enum class VMDispatchMode : int {
+  /*! \brief Dispatch instructions through a switch statement. */
+  kSwitch = 0,
+  /*!
+   * \brief Dispatch instructions through computed goto with hot frame
+   *        state cached in locals.
+   *
+   * This mode reduces interpreter overhead for workloads that execute
+   * many small instructions per call, such as token-by-token decoding.
+   * It requires compiler support for labels-as-values (gcc/clang) and
+   * silently falls back to kSwitch otherwise.
+   */
+  kDirectThreaded = 1,
+};
+
 /*!
  * \brief An object representing a vm closure.
  */
@@ -194,9 +212,11 @@ class VirtualMachine : public ffi::ModuleObj {
 
   /*!
    * \brief Create a specific instance of VM.
+   * \param dispatch_mode The bytecode dispatch strategy of the interpreter loop.
    * \return Created VM
    */
-  static ffi::ObjectPtr<VirtualMachine> Create();
+  static ffi::ObjectPtr<VirtualMachine> Create(
+      VMDispatchMode dispatch_mode = VMDispatchMode::kSwitch);
   /*!
    * \brief Helper function for vm closure functions to get the context ptr
    * \param arg The argument value.
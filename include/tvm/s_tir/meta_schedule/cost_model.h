@@ -26,6 +26,7 @@
 #include <tvm/ffi/string.h>
 #include <tvm/runtime/base.h>
 #include <tvm/s_tir/meta_schedule/arg_info.h>
+#include <tvm/s_tir/meta_schedule/feature_extractor.h>
 #include <tvm/s_tir/meta_schedule/measure_candidate.h>
 #include <tvm/s_tir/meta_schedule/runner.h>
 #include <tvm/s_tir/schedule/schedule.h>
@@ -145,6 +146,19 @@ class CostModel : public ffi::ObjectRef {
                                        PyCostModelNode::FSave f_save,      //
                                        PyCostModelNode::FUpdate f_update,  //
                                        PyCostModelNode::FPredict f_predict);
+  /*!
+   * \brief Create a cost model that runs tree-ensemble inference natively in-process.
+   *
+   * The model is trained offline and loaded from an xgboost JSON model file; prediction
+   * featurizes the candidates with the given extractor and evaluates the ensemble over
+   * the feature rows in C++, with no per-round Python round trip.
+   *
+   * \param extractor The feature extractor the model was trained against.
+   * \param path If given, the model file to load immediately.
+   * \return The cost model created.
+   */
+  TVM_DLL static CostModel TreeEnsemble(FeatureExtractor extractor,
+                                        ffi::Optional<ffi::String> path = std::nullopt);
   TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(CostModel, ffi::ObjectRef, CostModelNode);
 };
 
@@ -495,6 +495,18 @@ class Database : public ffi::ObjectRef {
    */
   TVM_DLL static Database JSONDatabase(ffi::String path_workload, ffi::String path_tuning_record,
                                        bool allow_missing, ffi::String mod_eq_name = "structural");
+  /*!
+   * \brief Create a database backed by an append-only binary record log and a
+   * memory-mapped hash index keyed by workload structural hash. Unlike JSONDatabase,
+   * opening does not parse the stored records; the best record of a workload is
+   * located through the index and only that record is deserialized.
+   * \param path_log The path to the binary record log. The index is kept next to
+   * it with an ".idx" suffix and is rebuilt automatically when out of date.
+   * \param allow_missing Whether to create a new log when the given path is not found.
+   * \param mod_eq_name A string to specify the module equality testing and hashing method.
+   */
+  TVM_DLL static Database BinaryLogDatabase(ffi::String path_log, bool allow_missing,
+                                            ffi::String mod_eq_name = "structural");
   /*!
    * \brief A database composed of multiple databases, allowing users to guide IR rewriting using
    * combined knowledge of those databases. To each query, it returns the best record among all the
@@ -56,6 +56,8 @@ class ProfilerNode : public ffi::Object {
  public:
   /*! \brief The segments that are already profiled */
   std::unordered_map<std::string, double> stats_sec;
+  /*! \brief Monotonic event counters, e.g. per-schedule-rule accounting */
+  std::unordered_map<std::string, int64_t> counters;
   /*! \brief Counter for the total time used */
   ffi::Function total_timer;
 
@@ -70,6 +72,8 @@ class ProfilerNode : public ffi::Object {
  public:
   /*! \brief Get the internal stats of the running time */
   ffi::Map<ffi::String, FloatImm> Get() const;
+  /*! \brief Get the internal event counters */
+  ffi::Map<ffi::String, IntImm> GetCounters() const;
   /*! \brief Return a summary of profiling results as table format */
   ffi::String Table() const;
 };
@@ -95,6 +99,12 @@ class Profiler : public ffi::ObjectRef {
    * \return A scope timer for time profiling.
    */
   static ScopedTimer TimedScope(ffi::String name);
+  /*!
+   * \brief Increment a named event counter on the current profiler, if any.
+   * \param name Name of the counter.
+   * \param delta The amount to add to the counter.
+   */
+  static void IncCounter(const ffi::String& name, int64_t delta = 1);
 };
 
 }  // namespace meta_schedule
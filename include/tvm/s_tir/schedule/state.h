@@ -74,6 +74,31 @@ struct SBlockInfo {
         stage_pipeline(stage_pipeline) {}
 };
 
+/*!
+ * \brief Memoized per-sref analysis results shared across schedule primitives.
+ *
+ * Primitives repeatedly re-derive facts such as the SBlockRealize of a block by
+ * walking the loop nest around it, which makes long trace replays quadratic in
+ * practice. Results are cached here keyed by sref, and `Replace` invalidates
+ * exactly the entries whose sref is an ancestor or a descendant of the replaced
+ * statement — the only entries the mutation can affect. Explicit invalidation
+ * is required because `Replace` mutates uniquely-referenced ancestors in place,
+ * so pointer identity of the cached statements cannot be used for validation.
+ */
+struct ScheduleAnalysisCache {
+  /*! \brief Mapping from a block sref to the SBlockRealize that wraps the block. */
+  std::unordered_map<StmtSRef, SBlockRealize, ffi::ObjectPtrHash, ffi::ObjectPtrEqual>
+      block_realize;
+  /*!
+   * \brief Drop every entry whose sref lies on the root path of `sref`,
+   * i.e. is `sref` itself, one of its ancestors, or one of its descendants.
+   * \param sref The sref about to be replaced.
+   */
+  TVM_DLL void Invalidate(const StmtSRefNode* sref);
+  /*! \brief Drop all entries. */
+  void Clear() { block_realize.clear(); }
+};
+
 /*!
  * \brief The bitmask of the debug flag in the ScheduleStateNode.
  * \sa ScheduleStateNode
@@ -119,6 +144,11 @@ class ScheduleStateNode : public ffi::Object {
    * \brief Whether to enable prequisite checks for schedule primitives.
    */
   bool enable_check;
+  /*!
+   * \brief Memoized analysis results, maintained by the `Replace` method.
+   * \sa ScheduleAnalysisCache
+   */
+  mutable ScheduleAnalysisCache analysis_cache;
 
   static void RegisterReflection() {
     namespace refl = tvm::ffi::reflection;
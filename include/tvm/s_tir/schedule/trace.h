@@ -19,8 +19,13 @@
 #ifndef TVM_S_TIR_SCHEDULE_TRACE_H_
 #define TVM_S_TIR_SCHEDULE_TRACE_H_
 
+#include <tvm/ir/module.h>
+#include <tvm/s_tir/random_engine.h>
 #include <tvm/s_tir/schedule/instruction.h>
 
+#include <memory>
+#include <mutex>
+
 namespace tvm {
 namespace s_tir {
 using namespace tvm::tirx;
@@ -135,6 +140,28 @@ class TraceNode : public ffi::Object {
    * \return A simplified trace
    */
   Trace Simplified(bool remove_postproc) const;
+
+  /*! \brief Pre-decoded replay form of a trace. Defined in trace.cc. */
+  struct Compiled;
+
+ private:
+  /*!
+   * \brief Return the compiled form of this trace, building it on first use.
+   *
+   * Database-driven compilation replays the same trace many times. The compiled form
+   * pre-resolves the per-instruction data that `ApplyToSchedule` would otherwise recompute
+   * on every replay: the postprocessing boundary, the decision made on each instruction,
+   * and a classification of each input so random-variable translation can skip type
+   * dispatch. The cache is invalidated by `Append` / `Pop` and may be built concurrently
+   * from multiple replay threads.
+   */
+  std::shared_ptr<const Compiled> GetCompiled() const;
+  /*! \brief Drop the compiled form after a structural mutation of the trace. */
+  void InvalidateCompiled();
+  /*! \brief The lazily built compiled form; guarded by compiled_mutex_. */
+  mutable std::shared_ptr<const Compiled> compiled_{nullptr};
+  /*! \brief Guards compiled_ against concurrent replays, e.g. under ThreadedTraceApply. */
+  mutable std::mutex compiled_mutex_;
 };
 
 /*!
@@ -161,6 +188,31 @@ class Trace : public ffi::ObjectRef {
   TVM_FFI_DEFINE_OBJECT_REF_METHODS_NOTNULLABLE(Trace, ffi::ObjectRef, TraceNode);
 };
 
+/*!
+ * \brief Draw complete trace samples from a design-space trace natively.
+ *
+ * Replays `trace` against `mod` `num_samples` times with the recorded sampling
+ * decisions dropped, so every sampling instruction redraws from the schedule's
+ * PRNG. The whole batch runs in C++, avoiding the per-instruction FFI round
+ * trip of driving the sampling primitives one call at a time. A single seed
+ * drives the batch: each worker thread forks its own PRNG stream from it, so
+ * the result is deterministic given (seed, num_threads).
+ *
+ * \param trace The design-space trace whose sampling instructions are redrawn.
+ * \param mod The module the trace is replayed against.
+ * \param seed The seed of the batch PRNG; -1 means seed from the device.
+ * \param num_samples The number of trace samples to draw.
+ * \param num_threads The number of worker threads replaying samples.
+ * \param max_fail_count The number of retries when a replay raises a
+ * ScheduleError before the sample is given up on.
+ * \return The sampled traces, with their decisions recorded. Samples that keep
+ * failing are omitted, so the result may contain fewer than `num_samples`
+ * entries.
+ */
+TVM_DLL ffi::Array<Trace> SampleTraces(const Trace& trace, const IRModule& mod,
+                                       LinearCongruentialEngine::TRandState seed, int num_samples,
+                                       int num_threads, int max_fail_count);
+
 }  // namespace s_tir
 }  // namespace tvm
 
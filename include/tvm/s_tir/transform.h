@@ -204,6 +204,20 @@ TVM_DLL Pass UnifyThreadBinding();
  */
 TVM_DLL Pass InjectSoftwarePipeline();
 
+/*!
+ * \brief Automatically annotate software pipeline stages for serial loops whose
+ *  body copies data from global to shared memory before computing on it.
+ *
+ * The annotations placed by this pass are the ones consumed by
+ * InjectSoftwarePipeline: the copy blocks become stage 0 and the consuming
+ * blocks stage 1, with the copy stage marked asynchronous when the target
+ * supports cp.async and `tirx.use_async_copy` is enabled. Loops that already
+ * carry pipeline annotations are left untouched.
+ *
+ * \return The IR transform pass.
+ */
+TVM_DLL Pass AnnotateSoftwarePipeline();
+
 /*!
  * \brief Automatically do memory optimizations for auto copy blocks
  * \return The pass.
@@ -157,6 +157,17 @@ class IRDocsifierNode : public ffi::Object {
   std::unordered_map<const ffi::Object*, std::vector<const ffi::Object*>> common_prefix;
   /*! \brief The IR usages for headers printing */
   std::unordered_set<std::string> ir_usage;
+  /*!
+   * \brief Per-dialect name prefixes, resolved from the config once at
+   * construction. The prefix helpers (IR/TIR/Relax) run for every dialect
+   * token printed, so they read these instead of repeating the extra-config
+   * lookup and cast per token.
+   */
+  ffi::String ir_prefix;
+  ffi::String tir_prefix;
+  ffi::String relax_prefix;
+  /*! \brief Cached "relax.show_all_ty" config, consulted once per binding. */
+  bool relax_show_all_ty = true;
 
   static void RegisterReflection() {
     namespace refl = tvm::ffi::reflection;
@@ -28,9 +28,12 @@
 #ifndef TVM_SCRIPT_PRINTER_PRINTER_H_
 #define TVM_SCRIPT_PRINTER_PRINTER_H_
 
+#include <tvm/ir/module.h>
 #include <tvm/ir/node_functor.h>
 #include <tvm/script/printer/config.h>
 
+#include <iosfwd>
+
 namespace tvm {
 
 /*! \brief Print \p node as TVMScript with the given \p config.
@@ -40,6 +43,25 @@ namespace tvm {
 TVM_DLL std::string Script(const ffi::ObjectRef& node,
                            const ffi::Optional<PrinterConfig>& config = std::nullopt);
 
+/*! \brief Print \p mod as TVMScript to \p os, one function at a time.
+ *
+ *  Unlike Script, which materializes the doc tree and the script of the whole
+ *  module before returning, this entry point docsifies and renders each
+ *  function with its own short-lived docsifier and writes it out immediately,
+ *  so peak memory is bounded by the largest function rather than the module.
+ *  Functions are emitted in the same deterministic order as Script.
+ *
+ *  \param mod The module to print.
+ *  \param os The stream the script is written to.
+ *  \param config The printer config; `show_meta` is not supported here.
+ *  \param num_threads If greater than one, independent functions are rendered
+ *         on that many threads; the output order is unchanged, at the cost of
+ *         buffering the rendered text of all functions.
+ */
+TVM_DLL void ScriptStreaming(const IRModule& mod, std::ostream& os,
+                             const ffi::Optional<PrinterConfig>& config = std::nullopt,
+                             int num_threads = 1);
+
 /*! \brief Dispatch vtable used by per-dialect printers to register their
  *         object-type printing functions.  Internal, but exposed here because
  *         TVM_REGISTER_SCRIPT_AS_REPR refers to it.
@@ -247,6 +247,67 @@ class TVM_DLL ExprVisitor : public ExprFunctor<void(const PrimExpr&)> {
   void VisitExpr_(const StringImmNode* op) override;
 };
 
+/*!
+ * \brief ExprVisitor that traverses deep expression chains from an explicit
+ *        work stack instead of the call stack.
+ *
+ * ExprVisitor consumes one call-stack frame per expression node, so trees
+ * whose depth grows with the program size — typically the left-leaning
+ * `a + b + c + ...` chains that full loop unrolling produces — need thread
+ * stacks proportional to the kernel size and overflow them on large kernels.
+ *
+ * This visitor expands the chain-forming node kinds (the binary arithmetic,
+ * comparison and logical operators, plus Not, Cast and Select) from an
+ * explicit heap-allocated stack in post order. For these kinds the operands
+ * have already been visited when `VisitExpr_` runs, and the implementations
+ * inherited from this class are therefore no-ops; subclass overrides may
+ * still call their immediate base class, so the usual "call base, then act"
+ * idiom remains valid. Every other node kind keeps the ordinary recursive
+ * `VisitExpr_` implementation; its operands re-enter the iterative driver,
+ * so the call-stack depth is bounded by the nesting of those kinds
+ * (Let, Call, Reduce, ...) rather than by the total expression depth.
+ *
+ * `EnterExpr` runs in pre order, exactly once per visited node, and can
+ * prune the traversal: when it returns false, neither the operands nor
+ * `VisitExpr_` are visited for that subtree.
+ */
+class TVM_DLL IterativeExprVisitor : public ExprVisitor {
+ public:
+  using ExprVisitor::operator();
+
+ protected:
+  void VisitExpr(const PrimExpr& e) override;
+  /*!
+   * \brief Pre-order hook, called once per node before its operands.
+   * \param e The expression about to be visited.
+   * \return Whether to visit the operands and the node itself.
+   */
+  virtual bool EnterExpr(const PrimExpr& e) { return true; }
+  // The operands of the iteratively-expanded kinds are visited by the
+  // driver in VisitExpr, so the inherited operand-visiting defaults must
+  // not run them a second time.
+  void VisitExpr_(const AddNode* op) override {}
+  void VisitExpr_(const SubNode* op) override {}
+  void VisitExpr_(const MulNode* op) override {}
+  void VisitExpr_(const DivNode* op) override {}
+  void VisitExpr_(const ModNode* op) override {}
+  void VisitExpr_(const FloorDivNode* op) override {}
+  void VisitExpr_(const FloorModNode* op) override {}
+  void VisitExpr_(const MinNode* op) override {}
+  void VisitExpr_(const MaxNode* op) override {}
+  void VisitExpr_(const EQNode* op) override {}
+  void VisitExpr_(const NENode* op) override {}
+  void VisitExpr_(const LTNode* op) override {}
+  void VisitExpr_(const LENode* op) override {}
+  void VisitExpr_(const GTNode* op) override {}
+  void VisitExpr_(const GENode* op) override {}
+  void VisitExpr_(const AndNode* op) override {}
+  void VisitExpr_(const OrNode* op) override {}
+  void VisitExpr_(const NotNode* op) override {}
+  void VisitExpr_(const CastNode* op) override {}
+  void VisitExpr_(const SelectNode* op) override {}
+};
+
 /*!
  * \brief ExprMutator that mutates expressions.
  */
@@ -734,6 +734,44 @@ TVM_DLL PrimExpr q_multiply_shift(PrimExpr x, PrimExpr y, PrimExpr q, PrimExpr s
  */
 TVM_DLL PrimExpr fast_erf_float_expr(PrimExpr arg, int bits);
 
+/*!
+ * \brief Range-specialized exp expression for arguments proven to lie in [lo, hi].
+ *
+ * Picks the cheapest polynomial meeting the requested accuracy on the proven
+ * domain: a truncated Taylor expansion when the domain is narrow enough to
+ * skip range reduction entirely, otherwise a range-reduced polynomial whose
+ * degree is selected by the accuracy budget. The clamp and overflow guard of
+ * the generic fast path are dropped since the domain is proven finite. Only
+ * float32 element types are supported.
+ *
+ * \param arg The input expression.
+ * \param lo The proven lower bound of the argument value.
+ * \param hi The proven upper bound of the argument value.
+ * \param accuracy_bits The required number of correct mantissa bits.
+ * \return The specialized expression, or std::nullopt when the accuracy budget
+ *         cannot be met on the given domain.
+ */
+TVM_DLL ffi::Optional<PrimExpr> bounded_exp_float_expr(PrimExpr arg, double lo, double hi,
+                                                       int accuracy_bits);
+
+/*!
+ * \brief Range-specialized erf expression for arguments proven to lie in [lo, hi].
+ *
+ * Uses a truncated odd Taylor polynomial of the lowest degree meeting the
+ * accuracy budget on narrow domains, and the clamp-free rational approximation
+ * when the domain is proven inside [-4, 4] but too wide for the Taylor form.
+ *
+ * \param arg The input expression.
+ * \param bits The number of bits in the type.
+ * \param lo The proven lower bound of the argument value.
+ * \param hi The proven upper bound of the argument value.
+ * \param accuracy_bits The required number of correct mantissa bits.
+ * \return The specialized expression, or std::nullopt when the accuracy budget
+ *         cannot be met on the given domain.
+ */
+TVM_DLL ffi::Optional<PrimExpr> bounded_erf_float_expr(PrimExpr arg, int bits, double lo, double hi,
+                                                       int accuracy_bits);
+
 inline void CheckMathUnaryOpInputDType(const char* op_name, const PrimType& dtype) {
   TVM_FFI_CHECK(dtype.code() == DLDataTypeCode::kDLFloat ||
                     dtype.MatchesElementType(DLDataTypeCode::kDLBfloat, 16),
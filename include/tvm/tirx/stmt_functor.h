@@ -339,6 +339,30 @@ class TVM_DLL StmtExprVisitor : public ExprVisitor, public StmtVisitor {
   void VisitExpr_(const BufferLoadNode* op) override;
 };
 
+/*!
+ * \brief StmtExprVisitor variant whose expression traversal runs on an
+ *        explicit work stack.
+ *
+ * Analysis passes that scan whole kernels should prefer this base over
+ * StmtExprVisitor: expressions produced by full loop unrolling form chains
+ * whose depth grows with the kernel size, and the recursive expression
+ * traversal overflows the call stack on such inputs. See IterativeExprVisitor
+ * for the traversal contract.
+ */
+class TVM_DLL IterativeStmtExprVisitor : public IterativeExprVisitor, public StmtVisitor {
+ public:
+  using StmtVisitor::operator();
+  using IterativeExprVisitor::operator();
+
+ protected:
+  using IterativeExprVisitor::VisitExpr;
+  using IterativeExprVisitor::VisitExpr_;
+  using StmtVisitor::VisitStmt;
+
+  void VisitExpr(const PrimExpr& e) override { return IterativeExprVisitor::VisitExpr(e); }
+  void VisitExpr_(const BufferLoadNode* op) override;
+};
+
 /*!
  * \brief Mutator that recursively mutates stmts and exprs on them.
  */
@@ -282,6 +282,15 @@ TVM_DLL Pass FlattenBuffer();
  */
 TVM_DLL Pass CommonSubexprElim();
 
+/*!
+ * \brief Re-materialize the module's IR nodes in traversal order so that
+ *        subsequent visitor passes access memory near-sequentially.
+ * \note Structural contents are preserved but node identity is not; any
+ *       externally held `same_as`-based cache is invalidated.
+ * \return The pass.
+ */
+TVM_DLL Pass CompactIRLayout();
+
 /*!
  * \brief This is the unified static memory planner pass that will
  * plan for memory intra- and inter- PrimFuncs together. The pass
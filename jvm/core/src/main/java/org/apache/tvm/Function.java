@@ -151,6 +151,32 @@ public class Function extends TVMObject {
     return this;
   }
 
+  /**
+   * Push a batch of tensor arguments with a single native transition.
+   *
+   * Equivalent to calling {@link #pushArg(TensorBase)} for each element,
+   * but crosses the JNI boundary once, which matters for functions taking
+   * many tensors per call.
+   *
+   * @param args Tensors to push, in argument order.
+   * @return this
+   */
+  public Function pushArgs(TensorBase... args) {
+    long[] handles = new long[args.length];
+    int[] argTypeIndices = new int[args.length];
+    for (int i = 0; i < args.length; ++i) {
+      if (args[i] instanceof Tensor) {
+        handles[i] = ((Tensor) args[i]).handle;
+        argTypeIndices[i] = TypeIndex.kTVMFFITensor;
+      } else {
+        handles[i] = args[i].dltensorHandle;
+        argTypeIndices[i] = TypeIndex.kTVMFFIDLTensorPtr;
+      }
+    }
+    Base._LIB.tvmFFIFunctionPushArgHandles(handles, argTypeIndices);
+    return this;
+  }
+
   /**
    * Push argument to the function.
    * @param arg Module.
@@ -40,6 +40,8 @@ class LibInfo {
 
   native void tvmFFIFunctionPushArgHandle(long arg, int argTypeIndex);
 
+  native void tvmFFIFunctionPushArgHandles(long[] args, int[] argTypeIndices);
+
   native void tvmFFIFunctionPushArgDevice(Device device);
 
   native int tvmFFIFunctionListGlobalNames(List<String> funcNames);
@@ -61,6 +63,13 @@ class LibInfo {
 
   native int tvmFFIDLTensorCopyToJArray(long from, byte[] to);
 
+  native int tvmFFIDLTensorCopyFromDirectBuffer(java.nio.ByteBuffer from, long offset, long to);
+
+  native int tvmFFIDLTensorCopyToDirectBuffer(long from, java.nio.ByteBuffer to, long offset);
+
+  native int tvmTensorFromDirectBuffer(java.nio.ByteBuffer buffer, long offset, long[] shape,
+      int dtypeCode, int dtypeBits, int dtypeLanes, Base.RefLong handle);
+
   // the following functions are binded to keep things simpler
   // One possibility is to enhance FFI to support shape directly
   // so we do not need to run this binding through JNI
@@ -166,6 +166,62 @@ public class Tensor extends TensorBase {
     Base.checkCall(Base._LIB.tvmFFIDLTensorCopyFromJArray(sourceArray, this.dltensorHandle));
   }
 
+  /**
+   * Copy tensor contents from a ByteBuffer, starting at its current position.
+   *
+   * For a direct buffer the bytes are handed to the runtime without an
+   * intermediate Java array, so no per-call copy is made on the JVM side.
+   * Heap buffers fall back to the byte array path.
+   *
+   * The buffer position is not advanced.
+   *
+   * @param buffer the source buffer, holding at least the tensor contents
+   *               in raw row-major layout after its position.
+   */
+  public void copyFrom(ByteBuffer buffer) {
+    int nbytes = (int) size() * dtype.numOfBytes;
+    if (buffer.remaining() < nbytes) {
+      throw new IllegalArgumentException(String.format(
+          "Buffer has %d bytes remaining, tensor needs %d", buffer.remaining(), nbytes));
+    }
+    if (buffer.isDirect()) {
+      Base.checkCall(Base._LIB.tvmFFIDLTensorCopyFromDirectBuffer(
+          buffer, buffer.position(), this.dltensorHandle));
+    } else {
+      byte[] bytes = new byte[nbytes];
+      buffer.duplicate().get(bytes);
+      copyFromRaw(bytes);
+    }
+  }
+
+  /**
+   * Copy tensor contents into a ByteBuffer, starting at its current position.
+   *
+   * For a direct buffer the runtime writes straight into the buffer memory,
+   * so no per-call copy is made on the JVM side. Heap buffers fall back to
+   * the byte array path.
+   *
+   * The buffer position is not advanced.
+   *
+   * @param buffer the destination buffer with at least the tensor size
+   *               remaining.
+   */
+  public void copyTo(ByteBuffer buffer) {
+    int nbytes = (int) size() * dtype.numOfBytes;
+    if (buffer.remaining() < nbytes) {
+      throw new IllegalArgumentException(String.format(
+          "Buffer has %d bytes remaining, tensor needs %d", buffer.remaining(), nbytes));
+    }
+    if (buffer.isDirect()) {
+      Base.checkCall(Base._LIB.tvmFFIDLTensorCopyToDirectBuffer(
+          this.dltensorHandle, buffer, buffer.position()));
+    } else {
+      byte[] bytes = new byte[nbytes];
+      Base.checkCall(Base._LIB.tvmFFIDLTensorCopyToJArray(this.dltensorHandle, bytes));
+      buffer.duplicate().put(bytes);
+    }
+  }
+
   /**
    * Get shape of current Tensor.
    * @return an array representing shape of current tensor
@@ -376,6 +432,39 @@ public class Tensor extends TensorBase {
     return empty(shape, dtype, Device.cpu(0));
   }
 
+  /**
+   * Create a cpu tensor that aliases the memory of a direct ByteBuffer,
+   * starting at its current position, without copying.
+   *
+   * The buffer is pinned for the lifetime of the returned tensor, so it is
+   * safe to drop the Java reference to the buffer after this call. Writes
+   * through either side are visible to the other; the caller is responsible
+   * for not mutating the buffer while a kernel reads it. The buffer must
+   * hold its data in raw row-major layout with native byte order.
+   *
+   * @param buffer The direct buffer backing the tensor data.
+   * @param shape The shape of the tensor.
+   * @param dtype The data type of the tensor.
+   * @return The tensor sharing storage with the buffer.
+   */
+  public static Tensor fromDirectBuffer(ByteBuffer buffer, long[] shape, TVMType dtype) {
+    if (!buffer.isDirect()) {
+      throw new IllegalArgumentException("fromDirectBuffer requires a direct ByteBuffer");
+    }
+    long nbytes = dtype.numOfBytes;
+    for (int i = 0; i < shape.length; ++i) {
+      nbytes *= shape[i];
+    }
+    if (buffer.remaining() < nbytes) {
+      throw new IllegalArgumentException(String.format(
+          "Buffer has %d bytes remaining, shape needs %d", buffer.remaining(), nbytes));
+    }
+    Base.RefLong refHandle = new Base.RefLong();
+    Base.checkCall(Base._LIB.tvmTensorFromDirectBuffer(buffer, buffer.position(), shape,
+        dtype.typeCode, dtype.bits, dtype.lanes, refHandle));
+    return new Tensor(refHandle.value, false, dtype, Device.cpu(0));
+  }
+
   /**
    * Create an empty float32 array on cpu given shape.
    * @param shape The shape of the array.
@@ -77,4 +77,35 @@ public class TensorTest {
     assertArrayEquals(new char[] {65535, 2, 3, 4}, tensor.asCharArray());
     tensor.release();
   }
+
+  @Test
+  public void test_direct_buffer_copy() {
+    Tensor tensor = Tensor.empty(new long[] {2, 2}, new TVMType("float32"));
+    java.nio.ByteBuffer src = java.nio.ByteBuffer.allocateDirect(4 * 4)
+        .order(java.nio.ByteOrder.nativeOrder());
+    src.asFloatBuffer().put(new float[] {1f, 2f, 3f, 4f});
+    tensor.copyFrom(src);
+    assertArrayEquals(new float[] {1f, 2f, 3f, 4f}, tensor.asFloatArray(), 1e-3f);
+
+    java.nio.ByteBuffer dst = java.nio.ByteBuffer.allocateDirect(4 * 4)
+        .order(java.nio.ByteOrder.nativeOrder());
+    tensor.copyTo(dst);
+    float[] out = new float[4];
+    dst.asFloatBuffer().get(out);
+    assertArrayEquals(new float[] {1f, 2f, 3f, 4f}, out, 1e-3f);
+    tensor.release();
+  }
+
+  @Test
+  public void test_from_direct_buffer_zero_copy() {
+    java.nio.ByteBuffer buffer = java.nio.ByteBuffer.allocateDirect(4 * 4)
+        .order(java.nio.ByteOrder.nativeOrder());
+    buffer.asFloatBuffer().put(new float[] {1f, 2f, 3f, 4f});
+    Tensor tensor = Tensor.fromDirectBuffer(buffer, new long[] {2, 2}, new TVMType("float32"));
+    assertArrayEquals(new float[] {1f, 2f, 3f, 4f}, tensor.asFloatArray(), 1e-3f);
+    // writes through the buffer are visible to the aliasing tensor
+    buffer.asFloatBuffer().put(0, 5f);
+    assertArrayEquals(new float[] {5f, 2f, 3f, 4f}, tensor.asFloatArray(), 1e-3f);
+    tensor.release();
+  }
 }
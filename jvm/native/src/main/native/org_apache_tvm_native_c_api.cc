@@ -114,6 +114,26 @@ JNIEXPORT void JNICALL Java_org_apache_tvm_LibInfo_tvmFFIFunctionPushArgHandle(J
   stack->packed_args.emplace_back(tvm::ffi::AnyView::CopyFromTVMFFIAny(temp));
 }
 
+JNIEXPORT void JNICALL Java_org_apache_tvm_LibInfo_tvmFFIFunctionPushArgHandles(
+    JNIEnv* env, jobject obj, jlongArray jargs, jintArray jargTypeIndices) {
+  // Batched variant of tvmFFIFunctionPushArgHandle: pushing every handle
+  // argument of a call in one native transition amortizes the JNI overhead
+  // for functions taking many tensors.
+  int num = static_cast<int>(env->GetArrayLength(jargs));
+  jlong* args = env->GetLongArrayElements(jargs, NULL);
+  jint* argTypeIndices = env->GetIntArrayElements(jargTypeIndices, NULL);
+  TVMFFIJVMStack* stack = TVMFFIJVMStack::ThreadLocal();
+  for (int i = 0; i < num; ++i) {
+    TVMFFIAny temp;
+    temp.v_int64 = static_cast<int64_t>(args[i]);
+    temp.type_index = static_cast<int>(argTypeIndices[i]);
+    temp.zero_padding = 0;
+    stack->packed_args.emplace_back(tvm::ffi::AnyView::CopyFromTVMFFIAny(temp));
+  }
+  env->ReleaseLongArrayElements(jargs, args, JNI_ABORT);
+  env->ReleaseIntArrayElements(jargTypeIndices, argTypeIndices, JNI_ABORT);
+}
+
 JNIEXPORT void JNICALL Java_org_apache_tvm_LibInfo_tvmFFIFunctionPushArgDevice(JNIEnv* env,
                                                                                jobject obj,
                                                                                jobject arg) {
@@ -392,6 +412,85 @@ JNIEXPORT jint JNICALL Java_org_apache_tvm_LibInfo_tvmFFIDLTensorCopyToJArray(JN
   TVM_FFI_SAFE_CALL_END();
 }
 
+JNIEXPORT jint JNICALL Java_org_apache_tvm_LibInfo_tvmFFIDLTensorCopyFromDirectBuffer(
+    JNIEnv* env, jobject obj, jobject jbuf, jlong joffset, jlong jto) {
+  TVM_FFI_SAFE_CALL_BEGIN();
+  void* pdata = env->GetDirectBufferAddress(jbuf);
+  TVM_FFI_ICHECK(pdata != nullptr) << "Expected a direct ByteBuffer";
+  DLTensor* to = reinterpret_cast<DLTensor*>(jto);
+  size_t size = tvm::ffi::GetDataSize(*to);
+  TVM_FFI_ICHECK_GE(env->GetDirectBufferCapacity(jbuf) - joffset, static_cast<jlong>(size))
+      << "Direct buffer is smaller than the tensor contents";
+  static auto fcopy_from_bytes =
+      tvm::ffi::Function::GetGlobalRequired("runtime.TVMTensorCopyFromBytes");
+  fcopy_from_bytes(to, static_cast<void*>(static_cast<char*>(pdata) + joffset), size);
+  TVM_FFI_SAFE_CALL_END();
+}
+
+JNIEXPORT jint JNICALL Java_org_apache_tvm_LibInfo_tvmFFIDLTensorCopyToDirectBuffer(
+    JNIEnv* env, jobject obj, jlong jfrom, jobject jbuf, jlong joffset) {
+  TVM_FFI_SAFE_CALL_BEGIN();
+  void* pdata = env->GetDirectBufferAddress(jbuf);
+  TVM_FFI_ICHECK(pdata != nullptr) << "Expected a direct ByteBuffer";
+  DLTensor* from = reinterpret_cast<DLTensor*>(jfrom);
+  size_t size = tvm::ffi::GetDataSize(*from);
+  TVM_FFI_ICHECK_GE(env->GetDirectBufferCapacity(jbuf) - joffset, static_cast<jlong>(size))
+      << "Direct buffer is smaller than the tensor contents";
+  static auto fcopy_to_bytes =
+      tvm::ffi::Function::GetGlobalRequired("runtime.TVMTensorCopyToBytes");
+  fcopy_to_bytes(from, static_cast<void*>(static_cast<char*>(pdata) + joffset), size);
+  TVM_FFI_SAFE_CALL_END();
+}
+
+JNIEXPORT jint JNICALL Java_org_apache_tvm_LibInfo_tvmTensorFromDirectBuffer(
+    JNIEnv* env, jobject obj, jobject jbuf, jlong joffset, jlongArray jshape, jint jdtypeCode,
+    jint jdtypeBits, jint jdtypeLanes, jobject jret) {
+  TVM_FFI_SAFE_CALL_BEGIN();
+  void* pdata = env->GetDirectBufferAddress(jbuf);
+  TVM_FFI_ICHECK(pdata != nullptr) << "Expected a direct ByteBuffer";
+  int ndim = static_cast<int>(env->GetArrayLength(jshape));
+  jlong* shapeArray = env->GetLongArrayElements(jshape, NULL);
+
+  // Pin the backing buffer for the lifetime of the wrapping tensor; the
+  // global reference keeps the JVM from collecting the buffer while native
+  // code holds its address, and is released by the DLPack deleter.
+  auto* managed = new DLManagedTensor();
+  managed->manager_ctx = env->NewGlobalRef(jbuf);
+  managed->deleter = [](DLManagedTensor* self) {
+    JNIEnv* env;
+    int jniStatus = _jvm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_6);
+    if (jniStatus == JNI_EDETACHED) {
+      _jvm->AttachCurrentThread(JNIEnvPtrHelper(&env), nullptr);
+    }
+    env->DeleteGlobalRef(static_cast<jobject>(self->manager_ctx));
+    delete[] self->dl_tensor.shape;
+    delete self;
+  };
+  DLTensor& dl = managed->dl_tensor;
+  dl.data = static_cast<void*>(static_cast<char*>(pdata) + joffset);
+  dl.device = DLDevice{kDLCPU, 0};
+  dl.ndim = ndim;
+  dl.dtype.code = static_cast<uint8_t>(jdtypeCode);
+  dl.dtype.bits = static_cast<uint8_t>(jdtypeBits);
+  dl.dtype.lanes = static_cast<int16_t>(jdtypeLanes);
+  dl.shape = new int64_t[ndim];
+  for (int i = 0; i < ndim; ++i) {
+    dl.shape[i] = static_cast<int64_t>(shapeArray[i]);
+  }
+  dl.strides = nullptr;
+  dl.byte_offset = 0;
+  env->ReleaseLongArrayElements(jshape, shapeArray, 0);
+
+  TVM_FFI_ICHECK_GE(env->GetDirectBufferCapacity(jbuf) - joffset,
+                    static_cast<jlong>(tvm::ffi::GetDataSize(dl)))
+      << "Direct buffer is smaller than the requested tensor shape";
+  tvm::ffi::Tensor out = tvm::ffi::Tensor::FromDLPack(managed, /*require_alignment=*/0,
+                                                      /*require_contiguous=*/true);
+  void* handle = tvm::ffi::details::ObjectUnsafe::MoveObjectRefToTVMFFIObjectPtr(std::move(out));
+  setLongField(env, jret, reinterpret_cast<jlong>(handle));
+  TVM_FFI_SAFE_CALL_END();
+}
+
 JNIEXPORT jint JNICALL Java_org_apache_tvm_LibInfo_tvmSynchronize(JNIEnv* env, jobject obj,
                                                                   jint jdeviceType,
                                                                   jint jdeviceId) {
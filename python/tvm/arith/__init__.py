@@ -21,6 +21,7 @@ from .int_set import (
     IntSet,
     IntervalSet,
     PresburgerSet,
+    UnionSet,
     estimate_region_lower_bound,
     estimate_region_strict_bound,
     estimate_region_upper_bound,
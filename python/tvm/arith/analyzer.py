@@ -315,6 +315,15 @@ class Analyzer(Object):
     def rewrite_simplify_stats(self):
         return _ffi_api.AnalyzerGetRewriteSimplifyStats(self)
 
+    @property
+    def rewrite_simplify_rule_hits(self):
+        """Per-rule-category counters of the rewrite simplifier.
+
+        Maps the type key of the root node a rule group applies to
+        (e.g. "tirx.Add") to a map with "attempted" and "performed" counts.
+        """
+        return _ffi_api.AnalyzerGetRewriteSimplifyRuleHits(self)
+
     def reset_rewrite_simplify_stats(self):
         _ffi_api.AnalyzerResetRewriteSimplifyStats(self)
 
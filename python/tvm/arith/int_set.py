@@ -85,6 +85,15 @@ class IntervalSet(IntSet):
         self.__init_handle_by_constructor__(_ffi_api.IntervalSet, min_value, max_value)
 
 
+@tvm_ffi.register_object("arith.UnionSet")
+class UnionSet(IntSet):
+    """Bounded union of disjoint intervals.
+
+    Keeps the member intervals of a union instead of collapsing them to a
+    single convex hull. Constructed through :py:func:`union_bounded`.
+    """
+
+
 @tvm_ffi.register_object("arith.PresburgerSet")
 class PresburgerSet(IntSet):
     """Represent of Presburger Set"""
@@ -197,6 +206,27 @@ def neg_inf():
     return _ffi_api.NegInf()
 
 
+def union_bounded(sets):
+    """Create a union of the sets, preserving disjoint intervals
+
+    Unlike a plain union, which collapses the result to a single convex
+    hull, the returned set keeps up to a bounded number of provably
+    disjoint member intervals, and only falls back to the hull when that
+    bound is exceeded.
+
+    Parameters
+    ----------
+    sets : List[IntSet]
+        The sets to be combined
+
+    Returns
+    ----------
+    union : IntSet
+        A UnionSet when disjoint segments survive, an IntervalSet otherwise
+    """
+    return _ffi_api.UnionBounded(sets)
+
+
 def union_lower_bound(sets):
     """Create a lower-bound of union set, where some of the segments may be dropped
 
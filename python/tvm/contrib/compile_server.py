@@ -0,0 +1,188 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Persistent compile server built on the RPC layer.
+
+Compile startup costs (target registry, op registration, pass pipeline
+construction) are paid once per process. Workloads that fork one compile
+process per job, such as autotuning, pay them thousands of times over.
+This module keeps a single warmed process alive instead: it serves compile
+jobs over the RPC protocol, holding its :py:class:`tvm.transform.PassContext`,
+parsed targets, and codegen state across jobs.
+
+Modules are uploaded once as snapshots keyed by content hash. IRModule
+transformations are functional (copy-on-write), so every job compiles
+against the shared snapshot without copying or re-deserializing it.
+
+Server side::
+
+    python -m tvm.exec.compile_server --port 9092
+
+Client side::
+
+    session = RemoteCompileSession("localhost", 9092)
+    lib_bytes = session.compile(mod, "llvm")
+"""
+
+import hashlib
+
+import tvm_ffi
+
+import tvm
+from tvm import rpc
+from tvm.support import utils
+
+
+def register_server_functions():
+    """Register the compile-job functions in the current process.
+
+    Pass this as ``server_init_callback`` to :py:class:`tvm.rpc.Server`, or
+    call it directly when embedding the server.
+    """
+    # Jobs share these across calls; this is the state whose construction a
+    # per-process compile flow pays for on every job.
+    snapshots = {}
+    targets = {}
+    pass_context = tvm.transform.PassContext()
+
+    @tvm_ffi.register_global_func("tvm.compile_server.upload_snapshot", override=True)
+    def upload_snapshot(mod_json: str) -> str:
+        key = hashlib.sha256(mod_json.encode("utf-8")).hexdigest()
+        if key not in snapshots:
+            snapshots[key] = tvm.ir.load_json(mod_json)
+        return key
+
+    @tvm_ffi.register_global_func("tvm.compile_server.has_snapshot", override=True)
+    def has_snapshot(key: str) -> bool:
+        return key in snapshots
+
+    @tvm_ffi.register_global_func("tvm.compile_server.warmup", override=True)
+    def warmup(target: str) -> None:
+        # Parsing the target pulls in its codegen; doing it ahead of the
+        # first job moves the cost off the critical path.
+        if target not in targets:
+            targets[target] = tvm.target.Target(target)
+
+    @tvm_ffi.register_global_func("tvm.compile_server.compile", override=True)
+    def compile_snapshot(key: str, target: str) -> bytes:
+        if key not in snapshots:
+            raise ValueError(f"Unknown module snapshot {key}; upload it first")
+        if target not in targets:
+            targets[target] = tvm.target.Target(target)
+        with pass_context:
+            executable = tvm.compile(snapshots[key], targets[target])
+        workspace = utils.tempdir()
+        lib_path = workspace.relpath("compiled.so")
+        executable.export_library(lib_path)
+        with open(lib_path, "rb") as lib_file:
+            return bytearray(lib_file.read())
+
+
+def serve(host="0.0.0.0", port=9092, port_end=9199, silent=False):
+    """Start a compile server and return the underlying RPC server.
+
+    Parameters
+    ----------
+    host : str
+        The host address the server binds to.
+
+    port : int
+        The port of the server.
+
+    port_end : int
+        The end port to search.
+
+    silent : bool
+        Whether to run the server in silent mode.
+
+    Returns
+    -------
+    server : tvm.rpc.Server
+        The running RPC server hosting the compile functions.
+    """
+    return rpc.Server(
+        host,
+        port,
+        port_end,
+        key="compile_server",
+        silent=silent,
+        server_init_callback=register_server_functions,
+    )
+
+
+class RemoteCompileSession:
+    """Client session against a compile server.
+
+    Uploads each module once per content hash and reuses the server-side
+    snapshot for subsequent jobs.
+
+    Parameters
+    ----------
+    host : str
+        The host address of the compile server.
+
+    port : int
+        The port of the compile server.
+
+    session_timeout : float
+        The duration of the connection in seconds; 0 means no timeout.
+    """
+
+    def __init__(self, host, port, session_timeout=0):
+        self._remote = rpc.connect(host, port, session_timeout=session_timeout)
+        self._upload = self._remote.get_function("tvm.compile_server.upload_snapshot")
+        self._has_snapshot = self._remote.get_function("tvm.compile_server.has_snapshot")
+        self._warmup = self._remote.get_function("tvm.compile_server.warmup")
+        self._compile = self._remote.get_function("tvm.compile_server.compile")
+        self._snapshot_keys = {}
+
+    def warmup(self, target) -> None:
+        """Ask the server to parse the target ahead of the first job."""
+        self._warmup(str(target))
+
+    def upload(self, mod) -> str:
+        """Upload a module snapshot and return its content-hash key.
+
+        The serialized module is only sent when the server does not already
+        hold a snapshot with the same content.
+        """
+        key = self._snapshot_keys.get(id(mod))
+        if key is not None and self._has_snapshot(key):
+            return key
+        mod_json = tvm.ir.save_json(mod)
+        key = self._upload(mod_json)
+        self._snapshot_keys[id(mod)] = key
+        return key
+
+    def compile(self, mod, target) -> bytes:
+        """Compile a module on the server and return the exported library.
+
+        Parameters
+        ----------
+        mod : tvm.IRModule
+            The module to compile.
+
+        target : Union[str, tvm.target.Target]
+            The target to compile for.
+
+        Returns
+        -------
+        lib_bytes : bytes
+            The contents of the exported shared library; write them to a
+            file and load with :py:func:`tvm.runtime.load_module`.
+        """
+        key = self.upload(mod)
+        return bytes(self._compile(key, str(target)))
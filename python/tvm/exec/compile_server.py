@@ -0,0 +1,53 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=redefined-outer-name, invalid-name
+"""Start a compile server"""
+
+import argparse
+import logging
+
+from ..contrib import compile_server
+
+
+def main(args):
+    """Main function
+
+    Parameters
+    ----------
+    args : argparse.Namespace
+        parsed args from command-line invocation
+    """
+    server = compile_server.serve(
+        args.host,
+        args.port,
+        args.port_end,
+        silent=args.silent,
+    )
+    server.proc.join()
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument(
+        "--host", type=str, default="0.0.0.0", help="The host IP address the server binds to"
+    )
+    parser.add_argument("--port", type=int, default=9092, help="The port of the compile server")
+    parser.add_argument("--port-end", type=int, default=9199, help="The end search port")
+    parser.add_argument("--silent", action="store_true", help="Whether run in silent mode.")
+    args = parser.parse_args()
+    logging.basicConfig(level=logging.INFO)
+    main(args)
@@ -0,0 +1,109 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Tool to diff two pass-profiling reports.
+
+Compares two JSON-lines reports written by
+:py:class:`tvm.ir.instrument.PassProfilingInstrument` and prints the passes
+with the largest wall-time regression, e.g.::
+
+    python -m tvm.exec.pass_report_diff baseline.jsonl current.jsonl
+"""
+
+import argparse
+import json
+from collections import defaultdict
+
+
+def load_report(path):
+    """Aggregate a JSON-lines report by pass name.
+
+    Returns a dict mapping pass name to a dict with summed ``wall_time_us``,
+    ``peak_rss_delta_kb``, ``nodes_delta`` and the invocation ``count``.
+    """
+    totals = defaultdict(lambda: {"wall_time_us": 0.0, "peak_rss_delta_kb": 0, "nodes_delta": 0, "count": 0})
+    with open(path, encoding="utf-8") as f:
+        for line in f:
+            line = line.strip()
+            if not line:
+                continue
+            record = json.loads(line)
+            # Skip container passes: their children are reported separately.
+            if record.get("depth", 0) > 0:
+                continue
+            entry = totals[record["name"]]
+            entry["wall_time_us"] += record.get("wall_time_us", 0.0)
+            entry["peak_rss_delta_kb"] += record.get("peak_rss_delta_kb", 0)
+            entry["nodes_delta"] += record.get("nodes_delta", 0)
+            entry["count"] += 1
+    return dict(totals)
+
+
+def diff_reports(baseline, current):
+    """Diff two aggregated reports.
+
+    Returns a list of rows sorted by wall-time increase, largest first. Each
+    row is a dict with the pass name, both wall times, the time ratio, and
+    the RSS/node-count deltas of the current report.
+    """
+    rows = []
+    for name in sorted(set(baseline) | set(current)):
+        base = baseline.get(name)
+        cur = current.get(name)
+        base_us = base["wall_time_us"] if base else 0.0
+        cur_us = cur["wall_time_us"] if cur else 0.0
+        rows.append(
+            {
+                "name": name,
+                "baseline_us": base_us,
+                "current_us": cur_us,
+                "delta_us": cur_us - base_us,
+                "ratio": cur_us / base_us if base_us > 0 else float("inf"),
+                "peak_rss_delta_kb": cur["peak_rss_delta_kb"] if cur else 0,
+                "nodes_delta": cur["nodes_delta"] if cur else 0,
+            }
+        )
+    rows.sort(key=lambda row: row["delta_us"], reverse=True)
+    return rows
+
+
+def main():
+    """Main function"""
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("baseline", type=str, help="the baseline report (JSON lines)")
+    parser.add_argument("current", type=str, help="the report to compare against the baseline")
+    parser.add_argument("--top", type=int, default=20, help="number of passes to print")
+    parser.add_argument("--json", action="store_true", help="emit the full diff as JSON")
+    args = parser.parse_args()
+
+    rows = diff_reports(load_report(args.baseline), load_report(args.current))
+    if args.json:
+        print(json.dumps(rows, indent=2))
+        return
+
+    header = f"{'pass':<50} {'baseline':>12} {'current':>12} {'ratio':>8} {'rss_kb':>10} {'nodes':>8}"
+    print(header)
+    print("-" * len(header))
+    for row in rows[: args.top]:
+        ratio = "new" if row["ratio"] == float("inf") else f"{row['ratio']:.2f}x"
+        print(
+            f"{row['name']:<50} {row['baseline_us']:>10.0f}us {row['current_us']:>10.0f}us "
+            f"{ratio:>8} {row['peak_rss_delta_kb']:>10} {row['nodes_delta']:>8}"
+        )
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,66 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Tool to localize the first diverging instruction between two VM traces.
+
+Compares two JSON-lines traces written by
+:py:class:`tvm.runtime.vm_trace.VMTraceRecorder` and prints the first call
+where the executions diverge, e.g.::
+
+    python -m tvm.exec.vm_trace_diff baseline.jsonl current.jsonl
+"""
+
+import argparse
+import json
+import sys
+
+from tvm.runtime.vm_trace import find_divergence, load_trace
+
+
+def main():
+    """Entry point for the trace diff tool."""
+    parser = argparse.ArgumentParser(
+        description="Localize the first diverging call between two VM execution traces."
+    )
+    parser.add_argument("baseline", help="Path to the baseline trace (JSON lines)")
+    parser.add_argument("current", help="Path to the current trace (JSON lines)")
+    parser.add_argument(
+        "--context",
+        type=int,
+        default=3,
+        help="Number of preceding calls to print around the divergence",
+    )
+    args = parser.parse_args()
+
+    baseline = load_trace(args.baseline)
+    current = load_trace(args.current)
+    divergence = find_divergence(baseline, current)
+    if divergence is None:
+        print(f"Traces agree over {len(baseline)} calls.")
+        return 0
+
+    index = divergence["index"]
+    print(f"First divergence at call #{index} (field: {divergence['field']})")
+    begin = max(0, index - args.context)
+    for i in range(begin, index):
+        print(f"  #{i} {baseline[i]['name']}: matches")
+    print("  baseline: " + json.dumps(divergence["baseline"]))
+    print("  current:  " + json.dumps(divergence["current"]))
+    return 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -44,11 +44,18 @@ class PassInfo(tvm.runtime.Object):
 
     required : List[str]
         The list of passes that are required by a certain pass.
+
+    traceable : bool
+        Whether the pass is traceable.
+
+    function_local : bool
+        Whether the pass only reads and rewrites the function it is applied
+        to, allowing the executor to process a module's functions in parallel.
     """
 
-    def __init__(self, opt_level, name, required=None, traceable=False):
+    def __init__(self, opt_level, name, required=None, traceable=False, function_local=False):
         self.__init_handle_by_constructor__(
-            _ffi_transform_api.PassInfo, opt_level, name, required, traceable
+            _ffi_transform_api.PassInfo, opt_level, name, required, traceable, function_local
         )
 
 
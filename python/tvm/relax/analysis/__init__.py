@@ -48,3 +48,4 @@ from .analysis import (
     well_formed,
 )
 from .estimate_memory_usage import estimate_memory_usage
+from .peak_memory import PeakMemoryModel, estimate_peak_memory
@@ -0,0 +1,178 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=abstract-method,unused-argument
+"""Symbolic peak-memory estimation for Relax functions."""
+
+from typing import Dict, Mapping, Union
+
+import tvm
+from tvm.ir.module import IRModule
+
+from ..expr import Call, Expr, Function, ShapeExpr
+from ..expr_functor import PyExprVisitor, visitor
+
+
+class PeakMemoryModel:
+    """Peak-memory model of an IRModule, parameterized by symbolic shapes.
+
+    The model maps every Relax function to a byte-size expression in terms of
+    the function's symbolic shape variables (e.g. ``batch_size``, ``seq_len``),
+    so the expected peak can be evaluated at serving time for admission
+    control without running the module.
+
+    Use :py:func:`estimate_peak_memory` to build the model.
+    """
+
+    def __init__(self, func_exprs: Dict[str, "tvm.tirx.PrimExpr"]):
+        self._func_exprs = func_exprs
+
+    @property
+    def function_names(self):
+        """The names of the functions covered by the model."""
+        return list(self._func_exprs.keys())
+
+    def peak_memory_expr(self, func_name: str) -> "tvm.tirx.PrimExpr":
+        """The symbolic peak-memory expression of a function, in bytes."""
+        if func_name not in self._func_exprs:
+            raise ValueError(f"Function {func_name} is not covered by the model")
+        return self._func_exprs[func_name]
+
+    def shape_params(self, func_name: str):
+        """The names of the symbolic shape variables the function's peak depends on."""
+        params = []
+
+        def fvisit(node):
+            if isinstance(node, tvm.tirx.Var) and node.name_hint not in params:
+                params.append(node.name_hint)
+
+        tvm.tirx.stmt_functor.post_order_visit(self.peak_memory_expr(func_name), fvisit)
+        return params
+
+    def query(self, func_name: str, shape_values: Mapping[str, int]) -> int:
+        """Evaluate the peak memory of a function, in bytes.
+
+        Parameters
+        ----------
+        func_name : str
+            The name of the function to query.
+
+        shape_values : Mapping[str, int]
+            The concrete value of every symbolic shape variable the function's
+            peak depends on, keyed by variable name.
+
+        Returns
+        -------
+        peak_bytes : int
+            The estimated peak memory in bytes.
+        """
+        expr = self.peak_memory_expr(func_name)
+        vmap = {}
+
+        def fvisit(node):
+            if isinstance(node, tvm.tirx.Var):
+                if node.name_hint not in shape_values:
+                    raise ValueError(
+                        f"Missing value for symbolic shape variable {node.name_hint!r}; "
+                        f"function {func_name} requires {self.shape_params(func_name)}"
+                    )
+                vmap[node] = tvm.tirx.IntImm(node.dtype, int(shape_values[node.name_hint]))
+
+        tvm.tirx.stmt_functor.post_order_visit(expr, fvisit)
+        if vmap:
+            expr = tvm.tirx.stmt_functor.substitute(expr, vmap)
+        expr = tvm.arith.Analyzer().simplify(expr)
+        if not isinstance(expr, tvm.tirx.IntImm):
+            raise ValueError(f"Peak memory of {func_name} did not fold to a constant: {expr}")
+        return int(expr.value)
+
+
+def estimate_peak_memory(mod: Union[IRModule, Function]) -> PeakMemoryModel:
+    """Build a symbolic peak-memory model of the Relax functions in an IRModule.
+
+    The estimation runs after memory planning: it accumulates the sizes of
+    every ``relax.memory.alloc_storage`` (the planned storage pool) and every
+    remaining ``relax.builtin.alloc_tensor`` (allocations planning could not
+    fold into the pool), keeping symbolic shape dimensions as free variables
+    instead of skipping dynamic allocations.
+
+    The result is an upper bound of the same static flavor as
+    :py:func:`estimate_memory_usage`: control flow is not modeled, and memory
+    managed outside the graph — notably runtime-constructed pools such as the
+    paged KV cache, which is sized at cache construction — must be accounted
+    for separately by the caller.
+
+    Parameters
+    ----------
+    mod : Union[IRModule, Function]
+        The input IRModule whose functions are to be analyzed.
+        If the input is a Function, we will wrap it with a IRModule, with
+        the function named "main".
+
+    Returns
+    -------
+    model : PeakMemoryModel
+        The peak-memory model, queryable per function with concrete shapes.
+    """
+
+    @visitor
+    class _PeakMemoryVisitor(PyExprVisitor):
+        """Accumulates a symbolic byte-size expression per function."""
+
+        builtin_alloc_tensor_op = tvm.ir.Op.get("relax.builtin.alloc_tensor")
+        memory_alloc_storage_op = tvm.ir.Op.get("relax.memory.alloc_storage")
+
+        def collect(self, func: Function) -> "tvm.tirx.PrimExpr":
+            self.total = tvm.tirx.IntImm("int64", 0)
+            self.visit_expr(func)
+            return tvm.arith.Analyzer().simplify(self.total)
+
+        def visit_call_(self, call: Call) -> None:  # pylint: disable=arguments-differ
+            if call.op == self.builtin_alloc_tensor_op:
+                self.accumulate_tensor_bytes(shape=call.args[0], dtype_str=call.args[1].value)
+            elif call.op == self.memory_alloc_storage_op:
+                size = call.args[0]
+                if not isinstance(size, ShapeExpr):
+                    raise TypeError(
+                        "The size of relax.memory.alloc_storage is expected to be ShapeExpr"
+                    )
+                self.total = self.total + self.cast_int64(size.values[0])
+
+        def accumulate_tensor_bytes(self, shape: Expr, dtype_str: str) -> None:
+            if not isinstance(shape, ShapeExpr):
+                raise TypeError(
+                    "The shape of relax.builtin.alloc_tensor is expected to be ShapeExpr"
+                )
+            dtype = tvm.DataType(dtype_str)
+            nbytes = tvm.tirx.IntImm("int64", ((dtype.bits + 7) // 8) * dtype.lanes)
+            for dim_len in shape.values:
+                nbytes = nbytes * self.cast_int64(dim_len)
+            self.total = self.total + nbytes
+
+        @staticmethod
+        def cast_int64(value: "tvm.tirx.PrimExpr") -> "tvm.tirx.PrimExpr":
+            if value.dtype != "int64":
+                return value.astype("int64")
+            return value
+
+    if isinstance(mod, Function):
+        mod = tvm.IRModule({tvm.ir.GlobalVar("main"): mod})
+
+    func_exprs: Dict[str, "tvm.tirx.PrimExpr"] = {}
+    for global_var, func in mod.functions_items():
+        if isinstance(func, Function):
+            func_exprs[global_var.name_hint] = _PeakMemoryVisitor().collect(func)
+    return PeakMemoryModel(func_exprs)
@@ -157,6 +157,7 @@ class SortScanDispatcher(BackendDispatcher):
                 and call.attrs.exclusive == 0
             ):
                 from tvm.relax.backend.gpu_generic import (  # pylint: disable=import-outside-toplevel
+                    gpu_2d_chained_cumsum,
                     gpu_2d_continuous_cumsum,
                 )
 
@@ -173,9 +174,20 @@ class SortScanDispatcher(BackendDispatcher):
                     cumsum_2d_shape,
                     ty_args=relax.TensorType(cumsum_2d_shape, out_dtype),
                 )
+                # With enough rows to occupy the device, the single-pass chained
+                # kernel (one block walking one row) beats the multi-round
+                # reduce-then-scan kernel, which reads the data several times.
+                try:
+                    static_rows = int(dim)
+                except (TypeError, ValueError):
+                    static_rows = None
+                if static_rows is not None and static_rows >= 64:
+                    kernel, kernel_name = gpu_2d_chained_cumsum, "gpu_2d_chained_cumsum"
+                else:
+                    kernel, kernel_name = gpu_2d_continuous_cumsum, "gpu_2d_continuous_cumsum"
                 gv = self.builder_.add_func(
-                    gpu_2d_continuous_cumsum(in_dtype=in_dtype, out_dtype=out_dtype),
-                    "gpu_2d_continuous_cumsum",
+                    kernel(in_dtype=in_dtype, out_dtype=out_dtype),
+                    kernel_name,
                 )
                 cumsum = relax.call_tir(
                     gv,
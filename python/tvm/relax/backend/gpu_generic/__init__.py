@@ -17,7 +17,7 @@
 # under the License.
 """The Relax Metal backend compilation pipeline and other passes."""
 
-from .cumsum import gpu_2d_continuous_cumsum
+from .cumsum import gpu_2d_chained_cumsum, gpu_2d_continuous_cumsum
 from .pipeline import (
     dataflow_lower_passes,
     finalize_passes,
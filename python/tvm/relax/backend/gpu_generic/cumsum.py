@@ -193,3 +193,114 @@ def gpu_2d_continuous_cumsum(
         update_cross_block(m, n, Tmp, Out, src_offset=0, out_offset=0)
 
     return cumsum
+
+
+def gpu_2d_chained_cumsum(
+    ty_len: int = 4,
+    tx_len: int = 32,
+    thread_elem: int = 4,
+    in_dtype: str = "int32",
+    out_dtype: str | None = None,
+) -> PrimFunc:
+    """Generate a single-pass GPU kernel for 2D continuous cumsum over the last axis.
+
+    One thread block owns one row and walks it tile by tile, carrying the running
+    prefix of the preceding tiles in shared memory, so every element is read and
+    written exactly once. This beats the multi-round reduce-then-scan kernel above
+    when there are enough rows to occupy the device, which is the shape sampling
+    pipelines produce: one vocabulary-sized scan per sequence.
+
+    Parameters
+    ----------
+    ty_len : int
+        The length of `threadIdx.y`
+
+    tx_len : int
+        The length of `threadIdx.x`
+
+    thread_elem : int
+        The number of elements processed by single thread
+
+    in_dtype : str
+        The input data type
+
+    out_dtype : Optional[str]
+        The output data type, if None, it will be the same as in_dtype
+
+    Returns
+    -------
+    cumsum : PrimFunc
+        The generated cumsum kernel
+    """
+
+    out_dtype = out_dtype or in_dtype
+
+    TX = T.int64(tx_len)  # threadIdx.x
+    TY = T.int64(ty_len)  # threadIdx.y
+    N = T.int64(thread_elem)  # number of elements in single thread
+
+    if not _is_power_of_two(TX) or not _is_power_of_two(TY) or not _is_power_of_two(N):
+        raise ValueError("Configuration of TX, TY, N must be power of 2")
+
+    # number of elements to be processed by single warp
+    warp_elem = T.int64(tx_len * thread_elem)
+    # number of elements to be processed by single block(SM) per tile
+    block_elem = T.int64(tx_len * ty_len * thread_elem)
+
+    LOG_TX = T.int64(int(math.log2(tx_len)))
+
+    @T.prim_func(private=True, s_tir=True)
+    def cumsum(var_a: T.handle, var_out: T.handle):
+        T.func_attr({"tirx.is_scheduled": True})  # prevent further scheduling
+        m, n = T.int64(), T.int64()
+        A = T.match_buffer(var_a, [m, n], dtype=in_dtype)
+        Out = T.match_buffer(var_out, [m, n], dtype=out_dtype)
+        for bx in T.thread_binding(m, thread="blockIdx.x"):
+            with T.sblock():
+                local_buf = T.sblock_alloc_buffer((thread_elem,), out_dtype, scope="local")
+                shared_buf = T.sblock_alloc_buffer((block_elem,), out_dtype, scope="shared")
+                carry_buf = T.sblock_alloc_buffer((1,), out_dtype, scope="shared")
+                for ty in T.thread_binding(TY, thread="threadIdx.y"):
+                    for tx in T.thread_binding(TX, thread="threadIdx.x"):
+                        if tx == 0 and ty == 0:
+                            carry_buf[0] = T.Cast(out_dtype, 0)
+                        for tile in T.serial(T.ceildiv(n, block_elem)):
+                            tile_base: T.let[T.int64] = tile * block_elem
+                            tx_idx: T.let[T.int64] = tile_base + ty * warp_elem + tx * thread_elem
+                            # Load one tile from global memory
+                            for i in T.vectorized(N):
+                                local_buf[i] = T.if_then_else(
+                                    tx_idx + i < n,
+                                    T.Cast(out_dtype, A[bx, tx_idx + i]),
+                                    T.Cast(out_dtype, 0),
+                                )
+                            # Inclusive scan inside thread
+                            for i in T.unroll(1, N):
+                                local_buf[i] += local_buf[i - 1]
+                            # Store data to shared memory
+                            for i in T.vectorized(N):
+                                shared_buf[ty * warp_elem + tx * thread_elem + i] = local_buf[i]
+                            # Inclusive scan inside warp
+                            for i in T.unroll(LOG_TX):
+                                for j in T.vectorized(N):
+                                    idx: T.let[T.int64] = ty * warp_elem + tx * thread_elem
+                                    if tx >= (1 << i):
+                                        shared_buf[idx + j] += shared_buf[
+                                            idx - (1 << i) * thread_elem + N - 1
+                                        ]
+                            # Inclusive scan inside the tile
+                            for i in T.unroll(1, TY):
+                                for j in T.vectorized(N):
+                                    if ty == 0:
+                                        idx: T.let[T.int64] = i * warp_elem + tx * thread_elem
+                                        shared_buf[idx + j] += shared_buf[i * warp_elem - 1]
+                            # Add the carried prefix of the preceding tiles and write out
+                            for i in T.vectorized(N):
+                                idx: T.let[T.int64] = ty * warp_elem + tx * thread_elem + i
+                                if tile_base + idx < n:
+                                    Out[bx, tile_base + idx] = shared_buf[idx] + carry_buf[0]
+                            # Fold the tile total into the carry for the next tile
+                            if tx == 0 and ty == 0:
+                                carry_buf[0] += shared_buf[block_elem - 1]
+
+    return cumsum
@@ -35,9 +35,12 @@ from tvm.script import tirx as T
 from tvm.target import Target
 
 from ._kernel_common import (
+    _check_kv_storage_dtype,
     _declare_length_info,
     _get_kv_chunk_len,
     _get_seq_offset,
+    _paged_k_load,
+    _paged_kv_load,
     _rope,
     _var,
     _var_cpu,
@@ -46,7 +49,8 @@ from ._kernel_common import (
 )
 
 
-def _attention_decode_cpu(num_kv_heads, num_qo_heads, head_dim, qkv_dtype, sliding_window: bool, rope_scaling: dict[str, Any], page_size: int = 16):
+def _attention_decode_cpu(num_kv_heads, num_qo_heads, head_dim, qkv_dtype, sliding_window: bool, rope_scaling: dict[str, Any], page_size: int = 16, kv_storage_dtype=None, kv_quant_scales=None):
+    kv_storage_dtype = _check_kv_storage_dtype(kv_storage_dtype, qkv_dtype, kv_quant_scales, num_kv_heads)
     H_qo = num_qo_heads
     H_kv = num_kv_heads
     D = head_dim
@@ -83,7 +87,7 @@ def _attention_decode_cpu(num_kv_heads, num_qo_heads, head_dim, qkv_dtype, slidi
         length_info_elem_offset = T.int32(is_size_var=True)
 
         Q = T.match_buffer(Q_handle, (B, H_qo, D), qkv_dtype)
-        pages = T.match_buffer(pages_handle, (max_num_pages, 2, H_kv, page_size, D), qkv_dtype)
+        pages = T.match_buffer(pages_handle, (max_num_pages, 2, H_kv, page_size, D), kv_storage_dtype or qkv_dtype)
         page_table_indptr = T.match_buffer(page_table_indptr_handle, (B + 1,), "int32", elem_offset=page_indptr_elem_offset)
         page_table_values = T.match_buffer(page_table_values_handle, (nnz_pages,), "int32", elem_offset=page_values_elem_offset)
         k_rope_pos_offset = T.match_buffer(k_rope_pos_offset_handle, (B,), "int32", elem_offset=k_rope_pos_offset_elem_offset)
@@ -145,11 +149,7 @@ def _attention_decode_cpu(num_kv_heads, num_qo_heads, head_dim, qkv_dtype, slidi
                         page_offset: T.let[T.int32(is_size_var=True)] = seq_offset % page_size
 
                         for d in T.serial(D):
-                            K_local[d] = T.if_then_else(
-                                rotary_mode == 1,
-                                _rope(pages, k_rope_pos_offset[b] + row_idx, head_dim, rope_theta, rope_scale, (page_no, 0, h_qo // group_size, page_offset, d), qkv_dtype, rope_scaling),
-                                pages[page_no, 0, h_qo // group_size, page_offset, d],
-                            )
+                            K_local[d] = _paged_k_load(pages, rotary_mode, k_rope_pos_offset[b] + row_idx, head_dim, rope_theta, rope_scale, (page_no, 0, h_qo // group_size, page_offset, d), h_qo // group_size, qkv_dtype, rope_scaling, kv_storage_dtype, kv_quant_scales)
                         S_val[0] = 0.0
                         for d in T.serial(D):
                             S_val[0] += Q_local[d] * K_local[d]
@@ -165,7 +165,7 @@ def _attention_decode_cpu(num_kv_heads, num_qo_heads, head_dim, qkv_dtype, slidi
 
                         m_val[0] = new_m[0]
                         for d in T.serial(D):
-                            V_local[d] = pages[page_no, 1, h_qo // group_size, page_offset, d]
+                            V_local[d] = _paged_kv_load(pages, (page_no, 1, h_qo // group_size, page_offset, d), h_qo // group_size, qkv_dtype, kv_storage_dtype, kv_quant_scales)
 
                         factor[0] = T.exp2(S_val[0] - m_val[0])
                         for d in T.serial(D):
@@ -178,7 +178,8 @@ def _attention_decode_cpu(num_kv_heads, num_qo_heads, head_dim, qkv_dtype, slidi
     return batch_decode_paged_kv
 
 
-def _attention_decode(num_kv_heads, num_qo_heads, head_dim, qkv_dtype, sliding_window: bool, rope_scaling: dict[str, Any], target: Target, page_size: int = 16):
+def _attention_decode(num_kv_heads, num_qo_heads, head_dim, qkv_dtype, sliding_window: bool, rope_scaling: dict[str, Any], target: Target, page_size: int = 16, kv_storage_dtype=None, kv_quant_scales=None):
+    kv_storage_dtype = _check_kv_storage_dtype(kv_storage_dtype, qkv_dtype, kv_quant_scales, num_kv_heads)
     qkv_dtype_bytes = 2
     H_qo = num_qo_heads
     H_kv = num_kv_heads
@@ -239,7 +240,7 @@ def _attention_decode(num_kv_heads, num_qo_heads, head_dim, qkv_dtype, sliding_w
         length_info_elem_offset = T.int32(is_size_var=True)
 
         Q = T.match_buffer(Q_handle, (B, H_qo, D), qkv_dtype)
-        pages = T.match_buffer(pages_handle, (max_num_pages, 2, H_kv, page_size, D), qkv_dtype, elem_offset=pages_elem_offset)
+        pages = T.match_buffer(pages_handle, (max_num_pages, 2, H_kv, page_size, D), kv_storage_dtype or qkv_dtype, elem_offset=pages_elem_offset)
         page_table_indptr = T.match_buffer(page_table_indptr_handle, (B + 1,), "int32", elem_offset=page_indptr_elem_offset)
         page_table_values = T.match_buffer(page_table_values_handle, (nnz_pages,), "int32", elem_offset=page_values_elem_offset)
         k_rope_pos_offset = T.match_buffer(k_rope_pos_offset_handle, (B,), "int32", elem_offset=k_rope_pos_offset_elem_offset)
@@ -316,12 +317,8 @@ def _attention_decode(num_kv_heads, num_qo_heads, head_dim, qkv_dtype, sliding_w
                                                 page_no: T.let[T.int32(is_size_var=True)] = page_table_values[cur_page_indptr_begin + T.floordiv(seq_offset, page_size)]  # type: ignore
                                                 page_offset: T.let[T.int32(is_size_var=True)] = T.floormod(seq_offset, page_size)  # type: ignore
                                                 for vec in T.vectorized(VEC_SIZE):
-                                                    K_smem[tile_start_s + j, tx * VEC_SIZE + vec] = T.if_then_else(
-                                                        rotary_mode == 1,
-                                                        _rope(pages, k_rope_pos_offset[batch_idx] + row_g, head_dim, rope_theta, rope_scale, (page_no, 0, by, page_offset, tx * VEC_SIZE + vec), qkv_dtype, rope_scaling),
-                                                        pages[page_no, 0, by, page_offset, tx * VEC_SIZE + vec]
-                                                    )
-                                                    V_smem[tile_start_s + j, tx * VEC_SIZE + vec] = pages[page_no, 1, by, page_offset, tx * VEC_SIZE + vec]
+                                                    K_smem[tile_start_s + j, tx * VEC_SIZE + vec] = _paged_k_load(pages, rotary_mode, k_rope_pos_offset[batch_idx] + row_g, head_dim, rope_theta, rope_scale, (page_no, 0, by, page_offset, tx * VEC_SIZE + vec), by, qkv_dtype, rope_scaling, kv_storage_dtype, kv_quant_scales)
+                                                    V_smem[tile_start_s + j, tx * VEC_SIZE + vec] = _paged_kv_load(pages, (page_no, 1, by, page_offset, tx * VEC_SIZE + vec), by, qkv_dtype, kv_storage_dtype, kv_quant_scales)
                                             else:
                                                 for vec in T.vectorized(VEC_SIZE):
                                                     K_smem[tile_start_s + j, tx * VEC_SIZE + vec] = 0.0
@@ -127,6 +127,69 @@ def _rope(buffer: T.Buffer, offset: tirx.Var, rotary_dim: int, theta: tirx.Var,
     return expr
 
 
+def _check_kv_storage_dtype(kv_storage_dtype, dtype, kv_quant_scales, num_kv_heads):
+    """Validate a quantized KV storage configuration.
+
+    Returns the normalized storage dtype, or ``None`` when the pages are
+    stored in the model dtype (no quantization).
+    """
+    if kv_storage_dtype is None or kv_storage_dtype == dtype:
+        return None
+    if kv_storage_dtype not in ("float8_e4m3fn", "int8"):
+        raise ValueError(
+            f'Unsupported KV storage dtype "{kv_storage_dtype}"; '
+            'expected "float8_e4m3fn" or "int8"'
+        )
+    if kv_storage_dtype == "int8" and (
+        kv_quant_scales is None or len(kv_quant_scales) != num_kv_heads
+    ):
+        raise ValueError("int8 KV storage requires one calibrated scale per KV head")
+    return kv_storage_dtype
+
+
+def _kv_head_scale(kv_quant_scales, head):
+    """The calibrated dequantization scale of a KV head, baked in as constants."""
+    expr = T.float32(float(kv_quant_scales[-1]))
+    for h in range(len(kv_quant_scales) - 2, -1, -1):
+        expr = T.if_then_else(head == h, T.float32(float(kv_quant_scales[h])), expr)
+    return expr
+
+
+def _paged_kv_store(value, head, kv_storage_dtype, kv_quant_scales):
+    """Convert a model-dtype K/V value to the page storage dtype."""
+    if kv_storage_dtype is None:
+        return value
+    if kv_storage_dtype == "int8":
+        scaled = value.astype("float32") / _kv_head_scale(kv_quant_scales, head)
+        return T.max(T.min(T.round(scaled), T.float32(127)), T.float32(-127)).astype("int8")
+    return value.astype(kv_storage_dtype)
+
+
+def _paged_kv_load(pages, indices, head, qkv_dtype, kv_storage_dtype, kv_quant_scales):
+    """Load one K/V element from paged storage, dequantized to the model dtype."""
+    if kv_storage_dtype is None:
+        return pages[indices]
+    if kv_storage_dtype == "int8":
+        return (pages[indices].astype("float32") * _kv_head_scale(kv_quant_scales, head)).astype(qkv_dtype)
+    return pages[indices].astype(qkv_dtype)
+
+
+def _paged_k_load(pages, rotary_mode, pos, rotary_dim, theta, scale, indices, head, qkv_dtype, rope_scaling, kv_storage_dtype, kv_quant_scales):
+    """Load one K element from paged storage, applying inline RoPE when enabled.
+
+    Quantized page storage does not support inline RoPE (the cache
+    construction enforces RoPE to be applied before append), so the
+    quantized load skips the rotary branch entirely.
+    """
+    if kv_storage_dtype is not None:
+        return _paged_kv_load(pages, indices, head, qkv_dtype, kv_storage_dtype, kv_quant_scales)
+    return T.if_then_else(
+        rotary_mode == 1,
+        _rope(pages, pos, rotary_dim, theta, scale, indices, qkv_dtype, rope_scaling),
+        pages[indices],
+    )
+
+
 def _causal_mask(causal, row, col, kv_len, qo_len):
     return T.if_then_else(
         causal > 0,
@@ -34,11 +34,17 @@ This module contains:
 from tvm.script import tirx as T
 from tvm.target import Target
 
-from ._kernel_common import get_max_num_threads_per_block
+from ._kernel_common import (
+    _check_kv_storage_dtype,
+    _paged_kv_load,
+    _paged_kv_store,
+    get_max_num_threads_per_block,
+)
 
 
-def _kv_cache_transpose_append(num_key_value_heads, head_dim, dtype, page_size: int = 16):
+def _kv_cache_transpose_append(num_key_value_heads, head_dim, dtype, page_size: int = 16, kv_storage_dtype=None, kv_quant_scales=None):
     """Return the TIR function that appends new k/v data to PagedKVCache."""
+    kv_storage_dtype = _check_kv_storage_dtype(kv_storage_dtype, dtype, kv_quant_scales, num_key_value_heads)
 
     @T.prim_func(s_tir=True)
     def tir_kv_cache_transpose_append(
@@ -52,7 +58,7 @@ def _kv_cache_transpose_append(num_key_value_heads, head_dim, dtype, page_size:
         num_pages = T.int64()
         pages_elem_offset = T.int64()
         position_map_elem_offset = T.int32()
-        pages = T.match_buffer(var_pages, (num_pages, 2, num_key_value_heads, page_size, head_dim), dtype, elem_offset=pages_elem_offset)
+        pages = T.match_buffer(var_pages, (num_pages, 2, num_key_value_heads, page_size, head_dim), kv_storage_dtype or dtype, elem_offset=pages_elem_offset)
         k_data = T.match_buffer(var_k_data, (ntoken, num_key_value_heads, head_dim), dtype)
         v_data = T.match_buffer(var_v_data, (ntoken, num_key_value_heads, head_dim), dtype)
         position_map = T.match_buffer(var_position_map, (ntoken,), "int32", elem_offset=position_map_elem_offset)
@@ -63,13 +69,13 @@ def _kv_cache_transpose_append(num_key_value_heads, head_dim, dtype, page_size:
                     T.reads(position_map[vgpos], k_data[vgpos, vh, vf])
                     T.writes(pages[position_map[vgpos] // page_size, 0, vh, position_map[vgpos] % page_size, vf])
                     position: T.int32 = position_map[vgpos]  # type: ignore
-                    pages[T.floordiv(position, page_size), 0, vh, T.floormod(position, page_size), vf] = k_data[vgpos, vh, vf]
+                    pages[T.floordiv(position, page_size), 0, vh, T.floormod(position, page_size), vf] = _paged_kv_store(k_data[vgpos, vh, vf], vh, kv_storage_dtype, kv_quant_scales)
                 with T.sblock("v_transpose_append"):
                     vgpos, vh, vf = T.axis.remap("SSS", [global_pos, h, f])
                     T.reads(position_map[vgpos], v_data[vgpos, vh, vf])
                     T.writes(pages[position_map[vgpos] // page_size, 1, vh, position_map[vgpos] % page_size, vf])
                     position: T.int32 = position_map[vgpos] # type: ignore[name-defined,no-redef]
-                    pages[T.floordiv(position, page_size), 1, vh, T.floormod(position, page_size), vf] = v_data[vgpos, vh, vf]
+                    pages[T.floordiv(position, page_size), 1, vh, T.floormod(position, page_size), vf] = _paged_kv_store(v_data[vgpos, vh, vf], vh, kv_storage_dtype, kv_quant_scales)
 
     return tir_kv_cache_transpose_append
 
@@ -103,8 +109,9 @@ def _kv_cache_transpose_append_mla(d_qk: int, dtype, page_size: int = 16):
     return tir_kv_cache_transpose_append_mla
 
 
-def _kv_cache_debug_get_kv(num_hidden_layers, num_key_value_heads, head_dim, dtype):
+def _kv_cache_debug_get_kv(num_hidden_layers, num_key_value_heads, head_dim, dtype, kv_storage_dtype=None, kv_quant_scales=None):
     """Return the TIR function that fetches the k/v data on given positions and layer."""
+    kv_storage_dtype = _check_kv_storage_dtype(kv_storage_dtype, dtype, kv_quant_scales, num_key_value_heads)
 
     @T.prim_func(s_tir=True)
     def tir_kv_cache_debug_get_kv(
@@ -120,7 +127,7 @@ def _kv_cache_debug_get_kv(num_hidden_layers, num_key_value_heads, head_dim, dty
         num_pages = T.int64()
         pages_elem_offset = T.int64()
         position_map_elem_offset = T.int64()
-        pages = T.match_buffer(var_pages, (num_pages, 2, num_key_value_heads, page_size, head_dim), dtype,elem_offset=pages_elem_offset)
+        pages = T.match_buffer(var_pages, (num_pages, 2, num_key_value_heads, page_size, head_dim), kv_storage_dtype or dtype, elem_offset=pages_elem_offset)
         position_map = T.match_buffer(var_position_map, (seqlen,), "int32", elem_offset=position_map_elem_offset)
         k_data = T.match_buffer(var_k_data, (num_hidden_layers, seqlen, num_key_value_heads, head_dim), dtype)
         v_data = T.match_buffer(var_v_data, (num_hidden_layers, seqlen, num_key_value_heads, head_dim), dtype)
@@ -130,8 +137,8 @@ def _kv_cache_debug_get_kv(num_hidden_layers, num_key_value_heads, head_dim, dty
                 T.reads(position_map[vp], pages[position_map[vp] // page_size, 0:2, vh, position_map[vp] % page_size, vd])
                 T.writes(k_data[layer_id, vp, vh, vd], v_data[layer_id, vp, vh, vd])
                 position: T.int32 = position_map[vp] # type: ignore[name-defined]
-                k_data[layer_id, vp, vh, vd] = pages[T.floordiv(position, page_size), 0, vh, T.floormod(position, page_size), vd]
-                v_data[layer_id, vp, vh, vd] = pages[T.floordiv(position, page_size), 1, vh, T.floormod(position, page_size), vd]
+                k_data[layer_id, vp, vh, vd] = _paged_kv_load(pages, (T.floordiv(position, page_size), 0, vh, T.floormod(position, page_size), vd), vh, dtype, kv_storage_dtype, kv_quant_scales)
+                v_data[layer_id, vp, vh, vd] = _paged_kv_load(pages, (T.floordiv(position, page_size), 1, vh, T.floormod(position, page_size), vd), vh, dtype, kv_storage_dtype, kv_quant_scales)
 
     return tir_kv_cache_debug_get_kv
 
@@ -166,8 +173,9 @@ def _kv_cache_debug_get_kv_mla(num_hidden_layers, d_qk, dtype):
     return tir_kv_cache_debug_get_kv_mla
 
 
-def _copy_single_page(num_heads, page_size, head_dim, dtype, target: Target):
+def _copy_single_page(num_heads, page_size, head_dim, dtype, target: Target, kv_storage_dtype=None):
     tx = get_max_num_threads_per_block(target)
+    dtype = kv_storage_dtype or dtype
 
     @T.prim_func(s_tir=True)
     def copy_single_page(var_pages: T.handle, src_page_id: T.int64, tgt_page_id: T.int64, copy_length: T.int64):
@@ -210,8 +218,9 @@ def _copy_single_page_mla(page_size, head_dim, dtype, target: Target):
     return copy_single_page_mla
 
 
-def _copy_single_page_cpu(num_heads, page_size, head_dim, dtype):
+def _copy_single_page_cpu(num_heads, page_size, head_dim, dtype, kv_storage_dtype=None):
     tx = 1
+    dtype = kv_storage_dtype or dtype
 
     @T.prim_func(s_tir=True)
     def copy_single_page_cpu(var_pages: T.handle, src_page_id: T.int64, tgt_page_id: T.int64, copy_length: T.int64):
@@ -232,8 +241,9 @@ def _copy_single_page_cpu(num_heads, page_size, head_dim, dtype):
     return copy_single_page_cpu
 
 
-def _compact_kv_copy(num_heads, head_dim, dtype, target: Target, page_size: int = 16):
+def _compact_kv_copy(num_heads, head_dim, dtype, target: Target, page_size: int = 16, kv_storage_dtype=None):
     tx = get_max_num_threads_per_block(target)
+    dtype = kv_storage_dtype or dtype
 
     @T.prim_func(s_tir=True)
     def compact_kv_copy(var_pages: T.handle, var_copy_length_indptr: T.handle, var_copy_src_dst_pos: T.handle, batch_size: T.int32):
@@ -263,8 +273,9 @@ def _compact_kv_copy(num_heads, head_dim, dtype, target: Target, page_size: int
     return compact_kv_copy
 
 
-def _compact_kv_copy_cpu(num_heads, head_dim, dtype, page_size: int = 16):
+def _compact_kv_copy_cpu(num_heads, head_dim, dtype, page_size: int = 16, kv_storage_dtype=None):
     tx = 8
+    dtype = kv_storage_dtype or dtype
 
     @T.prim_func(s_tir=True)
     def compact_kv_copy_cpu(var_pages: T.handle, var_copy_length_indptr: T.handle, var_copy_src_dst_pos: T.handle, batch_size: T.int32):
@@ -355,6 +355,8 @@ class FlashInferPagedKVCache(PagedKVCache):  # pylint: disable=too-few-public-me
         dtype: str,
         target: Target,
         name: str = "paged_kv_cache",
+        kv_storage_dtype: str | None = None,
+        kv_quant_scales: list[float] | None = None,
     ) -> None:
         """Create a paged KV cache object with FlashInfer kernels.
 
@@ -512,7 +514,12 @@ class FlashInferPagedKVCache(PagedKVCache):  # pylint: disable=too-few-public-me
 
 
 class TIRPagedKVCache(PagedKVCache):  # pylint: disable=too-few-public-methods
-    """Paged KV cache using TIR kernels."""
+    """Paged KV cache using TIR kernels.
+
+    Optionally stores K/V pages in a quantized dtype ("float8_e4m3fn" or
+    "int8") while the rest of the model keeps running in ``dtype``. See the
+    ``kv_storage_dtype`` parameter of ``__init__`` for the restrictions.
+    """
 
     def __init__(  # pylint: disable=too-many-locals
         self,
@@ -540,6 +547,8 @@ class TIRPagedKVCache(PagedKVCache):  # pylint: disable=too-few-public-methods
         dtype: str,
         target: Target,
         name: str = "paged_kv_cache",
+        kv_storage_dtype: str | None = None,
+        kv_quant_scales: list[float] | None = None,
     ) -> None:
         """Create a paged KV cache object with TIR kernels.
 
@@ -586,6 +595,21 @@ class TIRPagedKVCache(PagedKVCache):  # pylint: disable=too-few-public-methods
             Whether to enable disaggregation in the KV cache.
         target : Target
             The target to build the model to.
+        kv_storage_dtype : str | None
+            The dtype the K/V pages are stored in. None or ``dtype`` keeps the
+            unquantized layout. "float8_e4m3fn" quantizes by plain cast;
+            "int8" additionally requires ``kv_quant_scales``. The append
+            kernel quantizes on write and the TIR attention kernels
+            dequantize on read, so the quantization is invisible to the model.
+            Quantized storage is limited to the MHA TIR path: it requires
+            ``rope_mode != RopeMode.INLINE`` (RoPE must be applied before
+            append), and disables tree attention (speculative decoding) and
+            KV transfer. Use ``TIRPagedKVCache`` rather than the FlashInfer
+            variant when enabling it.
+        kv_quant_scales : list[float] | None
+            Per-KV-head calibrated scales for "int8" storage, one per KV head.
+            A stored value decodes as ``int8_value * scale``. The scales are
+            baked into the compiled kernels as constants.
         """
         rope_scaling = _prepare_yarn_rope_scaling(rope_scaling, rope_theta)
         attn_kind_single = attn_kind[0] if isinstance(attn_kind, list) else attn_kind
@@ -595,6 +619,16 @@ class TIRPagedKVCache(PagedKVCache):  # pylint: disable=too-few-public-methods
             attn_kind = [int(getattr(AttnKind, layer_kind.upper())) for layer_kind in attn_kind]
         else:
             attn_kind = [int(getattr(AttnKind, attn_kind.upper())) for _ in range(num_hidden_layers)]
+        if kv_storage_dtype == dtype:
+            kv_storage_dtype = None
+        if kv_storage_dtype is not None:
+            if attn_kind_single != "mha" or any(kind != int(AttnKind.MHA) for kind in attn_kind):
+                raise ValueError("Quantized KV storage is only supported for the MHA attention kind.")
+            if rope_mode == RopeMode.INLINE:
+                raise ValueError(
+                    "Quantized KV storage requires RoPE to be applied before appending K to the "
+                    "cache (rope_mode must not be RopeMode.INLINE)."
+                )
         bb = rx.BlockBuilder.current()
         args = [
             rx.ShapeExpr(
@@ -618,7 +652,7 @@ class TIRPagedKVCache(PagedKVCache):  # pylint: disable=too-few-public-methods
             rx.prim_value(rope_theta),
             rope_ext_factors,
             rx.op.zeros((), dtype),
-            bb.add_func(_kv_cache_transpose_append(num_key_value_heads, qk_head_dim, dtype), "kv_cache_transpose_append"),
+            bb.add_func(_kv_cache_transpose_append(num_key_value_heads, qk_head_dim, dtype, kv_storage_dtype=kv_storage_dtype, kv_quant_scales=kv_quant_scales), "kv_cache_transpose_append"),
             bb.add_func(_kv_cache_transpose_append_mla(qk_head_dim, dtype), "kv_cache_transpose_append_mla"),
         ]
 
@@ -628,18 +662,20 @@ class TIRPagedKVCache(PagedKVCache):  # pylint: disable=too-few-public-methods
             args.extend(
                 [
                     rx.Tuple([rx.StringImm("tirx"), bb.add_func(_attention_prefill_ragged_cpu(num_key_value_heads, num_attention_heads, qk_head_dim, v_head_dim, dtype, rope_scaling), "tir_attention_prefill_ragged_cpu")]),
-                    rx.Tuple([rx.StringImm("tirx"), bb.add_func(_attention_prefill_cpu(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, False, rope_scaling), "tir_attention_prefill_cpu")]),
-                    rx.Tuple([rx.StringImm("tirx"), bb.add_func(_attention_decode_cpu(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, False, rope_scaling), "tir_attention_decode_cpu")]),
-                    rx.Tuple([rx.StringImm("tirx"), bb.add_func(_attention_prefill_cpu(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, True, rope_scaling), "tir_attention_prefill_cpu_sliding_window")]),
-                    rx.Tuple([rx.StringImm("tirx"), bb.add_func(_attention_decode_cpu(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, True, rope_scaling), "tir_attention_decode_cpu_sliding_window")]),
+                    rx.Tuple([rx.StringImm("tirx"), bb.add_func(_attention_prefill_cpu(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, False, rope_scaling, kv_storage_dtype=kv_storage_dtype, kv_quant_scales=kv_quant_scales), "tir_attention_prefill_cpu")]),
+                    rx.Tuple([rx.StringImm("tirx"), bb.add_func(_attention_decode_cpu(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, False, rope_scaling, kv_storage_dtype=kv_storage_dtype, kv_quant_scales=kv_quant_scales), "tir_attention_decode_cpu")]),
+                    rx.Tuple([rx.StringImm("tirx"), bb.add_func(_attention_prefill_cpu(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, True, rope_scaling, kv_storage_dtype=kv_storage_dtype, kv_quant_scales=kv_quant_scales), "tir_attention_prefill_cpu_sliding_window")]),
+                    rx.Tuple([rx.StringImm("tirx"), bb.add_func(_attention_decode_cpu(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, True, rope_scaling, kv_storage_dtype=kv_storage_dtype, kv_quant_scales=kv_quant_scales), "tir_attention_decode_cpu_sliding_window")]),
+                    # The paged tree-attention kernel reads pages in the model dtype, so it is
+                    # disabled when the pages are stored quantized.
                     rx.Tuple([rx.StringImm("tirx"), bb.add_func(tree_attn_cpu(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, rope_scaling), "tir_attention_prefill_with_tree_mask_cpu")]),
-                    rx.Tuple([rx.StringImm("tirx"), bb.add_func(tree_attn_with_paged_kv_cache_cpu(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, rope_scaling), "tir_attention_prefill_with_tree_mask_with_paged_kv_cache_cpu")]),
+                    rx.Tuple([rx.StringImm("tirx"), bb.add_func(tree_attn_with_paged_kv_cache_cpu(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, rope_scaling), "tir_attention_prefill_with_tree_mask_with_paged_kv_cache_cpu")]) if kv_storage_dtype is None else rx.Tuple([]),
                     rx.Tuple([]),  # f_mla_prefill
                     rx.Tuple([bb.add_func(_merge_state_inplace_cpu(dtype), "tir_attention_merge_state_cpu")]),
                     bb.add_func(llama_rope_with_position_map(rope_theta, rope_scale, qk_head_dim, num_attention_heads, num_key_value_heads, dtype, rope_scaling, rotary_dim), "tir_split_rotary"),
-                    bb.add_func(_copy_single_page_cpu(num_key_value_heads, page_size, qk_head_dim, dtype), "kv_cache_copy_single_page_cpu"),
-                    bb.add_func(_kv_cache_debug_get_kv(num_hidden_layers, num_key_value_heads, qk_head_dim, dtype), "kv_cache_debug_get_kv"),
-                    bb.add_func(_compact_kv_copy_cpu(num_key_value_heads, qk_head_dim, dtype), "kv_cache_compact_kv_copy_cpu"),
+                    bb.add_func(_copy_single_page_cpu(num_key_value_heads, page_size, qk_head_dim, dtype, kv_storage_dtype=kv_storage_dtype), "kv_cache_copy_single_page_cpu"),
+                    bb.add_func(_kv_cache_debug_get_kv(num_hidden_layers, num_key_value_heads, qk_head_dim, dtype, kv_storage_dtype=kv_storage_dtype, kv_quant_scales=kv_quant_scales), "kv_cache_debug_get_kv"),
+                    bb.add_func(_compact_kv_copy_cpu(num_key_value_heads, qk_head_dim, dtype, kv_storage_dtype=kv_storage_dtype), "kv_cache_compact_kv_copy_cpu"),
                 ]
             )
         else:
@@ -648,11 +684,13 @@ class TIRPagedKVCache(PagedKVCache):  # pylint: disable=too-few-public-methods
             args.append(rx.Tuple([rx.StringImm("tirx"), bb.add_func(_attention_prefill_ragged(num_key_value_heads if attn_kind_single == "mha" else num_attention_heads, num_attention_heads, ragged_qk_head_dim, ragged_v_head_dim, dtype, rope_scaling, target), "tir_attention_prefill_ragged")]))
             mha_functions = (
                 [
-                    rx.Tuple([rx.StringImm("tirx"), bb.add_func(_attention_prefill(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, False, rope_scaling, target), "tir_attention_prefill")]),
-                    rx.Tuple([rx.StringImm("tirx"), bb.add_func(_attention_decode(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, False, rope_scaling, target), "tir_attention_decode")]),
-                    rx.Tuple([rx.StringImm("tirx"), bb.add_func(_attention_prefill(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, True, rope_scaling, target), "tir_attention_prefill_sliding_window")]),
-                    rx.Tuple([rx.StringImm("tirx"), bb.add_func(_attention_decode(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, True, rope_scaling, target), "tir_attention_decode_sliding_window")]),
-                    rx.Tuple([rx.StringImm("tirx"), bb.add_func(tree_attn_with_paged_kv_cache(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, rope_scaling, target), "tir_attention_prefill_with_tree_mask_with_paged_kv_cache")]),
+                    rx.Tuple([rx.StringImm("tirx"), bb.add_func(_attention_prefill(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, False, rope_scaling, target, kv_storage_dtype=kv_storage_dtype, kv_quant_scales=kv_quant_scales), "tir_attention_prefill")]),
+                    rx.Tuple([rx.StringImm("tirx"), bb.add_func(_attention_decode(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, False, rope_scaling, target, kv_storage_dtype=kv_storage_dtype, kv_quant_scales=kv_quant_scales), "tir_attention_decode")]),
+                    rx.Tuple([rx.StringImm("tirx"), bb.add_func(_attention_prefill(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, True, rope_scaling, target, kv_storage_dtype=kv_storage_dtype, kv_quant_scales=kv_quant_scales), "tir_attention_prefill_sliding_window")]),
+                    rx.Tuple([rx.StringImm("tirx"), bb.add_func(_attention_decode(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, True, rope_scaling, target, kv_storage_dtype=kv_storage_dtype, kv_quant_scales=kv_quant_scales), "tir_attention_decode_sliding_window")]),
+                    # The paged tree-attention kernel reads pages in the model dtype, so it is
+                    # disabled when the pages are stored quantized.
+                    rx.Tuple([rx.StringImm("tirx"), bb.add_func(tree_attn_with_paged_kv_cache(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, rope_scaling, target), "tir_attention_prefill_with_tree_mask_with_paged_kv_cache")]) if kv_storage_dtype is None else rx.Tuple([]),
                     rx.Tuple([rx.StringImm("tirx"), bb.add_func(tree_attn(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, rope_scaling, target), "tir_attention_prefill_with_tree_mask")]),
                 ]
                 if attn_kind_single == "mha"
@@ -670,12 +708,17 @@ class TIRPagedKVCache(PagedKVCache):  # pylint: disable=too-few-public-methods
                 [
                     rx.Tuple(attn_merge_functions),
                     bb.add_func(llama_rope_with_position_map(rope_theta, rope_scale, qk_head_dim, num_attention_heads, num_key_value_heads, dtype, rope_scaling, rotary_dim), "tir_split_rotary"),
-                    bb.add_func(_copy_single_page(num_key_value_heads, page_size, qk_head_dim, dtype, target) if attn_kind_single == "mha" else _copy_single_page_mla(page_size, qk_head_dim, dtype, target), "kv_cache_copy_single_page"),
-                    bb.add_func(_kv_cache_debug_get_kv(num_hidden_layers, num_key_value_heads, qk_head_dim, dtype), "kv_cache_debug_get_kv"),
-                    bb.add_func(_compact_kv_copy(num_key_value_heads, qk_head_dim, dtype, target), "kv_cache_compact_kv_copy"),
+                    bb.add_func(_copy_single_page(num_key_value_heads, page_size, qk_head_dim, dtype, target, kv_storage_dtype=kv_storage_dtype) if attn_kind_single == "mha" else _copy_single_page_mla(page_size, qk_head_dim, dtype, target), "kv_cache_copy_single_page"),
+                    bb.add_func(_kv_cache_debug_get_kv(num_hidden_layers, num_key_value_heads, qk_head_dim, dtype, kv_storage_dtype=kv_storage_dtype, kv_quant_scales=kv_quant_scales), "kv_cache_debug_get_kv"),
+                    bb.add_func(_compact_kv_copy(num_key_value_heads, qk_head_dim, dtype, target, kv_storage_dtype=kv_storage_dtype), "kv_cache_compact_kv_copy"),
                 ]
             )
 
+        if kv_storage_dtype is not None:
+            # Optional trailing argument of the create builtin: the dtype the
+            # K/V pages are allocated in on the runtime side.
+            args.append(rx.StringImm(kv_storage_dtype))
+
         super().__init__(
             _expr=rx.call_pure_packed(
                 "vm.builtin.paged_attention_kv_cache_create",
@@ -43,6 +43,7 @@ from .transform import (
     ExpandTupleArguments,
     FoldConstant,
     FunctionPass,
+    FuseDequantizeMatmul,
     FuseOps,
     FuseOpsByPattern,
     FuseTIR,
@@ -95,6 +96,11 @@ from .ipc_allreduce_rewrite import IPCAllReduceRewrite
 from .lazy_transform_params import LazyTransformParams
 from .lower_gpu_ipc_alloc_storage import LowerGPUIPCAllocStorage
 from .optimize_layout_transform import OptimizeLayoutTransform
+from .tune_mixed_precision import (
+    load_mixed_precision_decisions,
+    mixed_precision_candidate_ops,
+    tune_mixed_precision,
+)
 from .fold_batch_norm_to_conv2d_for_inference import FoldBatchnormToConv2D
 from .remove_redundant_reshape import RemoveRedundantReshape
 
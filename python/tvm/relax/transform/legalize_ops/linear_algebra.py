@@ -17,6 +17,9 @@
 # pylint: disable=invalid-name
 """Default legalization function for linear algebra operators."""
 
+import itertools
+from functools import lru_cache
+
 from tvm import DataTypeCode, relax, te, tirx, topi
 
 from ...block_builder import BlockBuilder
@@ -121,6 +124,135 @@ def _matmul(bb: BlockBuilder, call: Call) -> Expr:
     return bb.call_te(te_matmul, call.args[0], call.args[1], primfunc_name_hint="matmul")
 
 
+def _parse_einsum_subscripts(subscripts: str, shapes: list[list[int]]):
+    """Parse einsum subscripts into per-operand index strings, the output string,
+    and a letter -> extent map. Returns None for notations the contraction-path
+    optimizer does not handle (ellipsis, repeated in-operand letters, extent
+    mismatches)."""
+    subscripts = subscripts.replace(" ", "")
+    if "." in subscripts:
+        return None
+    if "->" in subscripts:
+        input_subs, output_sub = subscripts.split("->")
+    else:
+        input_subs, output_sub = subscripts, None
+    input_subs = input_subs.split(",")
+    if len(input_subs) != len(shapes):
+        return None
+    dim_sizes: dict[str, int] = {}
+    for sub, shape in zip(input_subs, shapes):
+        if len(sub) != len(shape) or len(set(sub)) != len(sub):
+            return None
+        for letter, extent in zip(sub, shape):
+            if dim_sizes.setdefault(letter, extent) != extent:
+                return None
+    if output_sub is None:
+        # Implicit mode: indices appearing exactly once, in alphabetical order.
+        counts: dict[str, int] = {}
+        for sub in input_subs:
+            for letter in sub:
+                counts[letter] = counts.get(letter, 0) + 1
+        output_sub = "".join(sorted(letter for letter, count in counts.items() if count == 1))
+    return input_subs, output_sub, dim_sizes
+
+
+def _optimal_einsum_path(input_subs, output_sub, dim_sizes):
+    """Find the cheapest binary contraction tree by dynamic programming over
+    operand subsets, with cost measured as the loop-nest volume of each pairwise
+    contraction. Returns a nested (lhs, rhs, result_indices) tuple with operand
+    positions at the leaves."""
+    n = len(input_subs)
+    full = frozenset(range(n))
+
+    def result_indices(subset):
+        # Indices a partial contraction must keep: those read by the output or
+        # by any operand outside the subset, in order of first appearance.
+        outside = set(output_sub)
+        for i in full - subset:
+            outside |= set(input_subs[i])
+        kept = []
+        for i in sorted(subset):
+            for letter in input_subs[i]:
+                if letter in outside and letter not in kept:
+                    kept.append(letter)
+        return "".join(kept)
+
+    @lru_cache(maxsize=None)
+    def solve(subset):
+        if len(subset) == 1:
+            (i,) = subset
+            return 0, i, input_subs[i]
+        items = sorted(subset)
+        best = None
+        # Enumerate splits with the smallest operand pinned to the left side,
+        # so each unordered partition is tried once.
+        for r in range(len(items) - 1):
+            for rest in itertools.combinations(items[1:], r):
+                left = frozenset((items[0],) + rest)
+                right = subset - left
+                left_cost, left_tree, left_sub = solve(left)
+                right_cost, right_tree, right_sub = solve(right)
+                pair_cost = 1
+                for letter in set(left_sub) | set(right_sub):
+                    pair_cost *= dim_sizes[letter]
+                cost = left_cost + right_cost + pair_cost
+                if best is None or cost < best[0]:
+                    result_sub = result_indices(subset)
+                    best = (cost, (left_tree, right_tree, result_sub), result_sub)
+        return best
+
+    _, tree, _ = solve(full)
+    return tree
+
+
+def _try_decompose_einsum(bb: BlockBuilder, subscripts: str, fields) -> Expr | None:
+    """Lower a multi-operand einsum as a cost-optimal sequence of pairwise
+    contractions instead of one flat loop nest. Each pairwise step is itself a
+    (batched) matmul-shaped einsum, so it schedules like a matmul. Returns None
+    when the notation or dynamic shapes prevent planning, falling back to the
+    flat lowering."""
+    if len(fields) < 3 or len(fields) > 8:
+        return None
+    shapes = []
+    for field in fields:
+        ty = field.ty
+        if not isinstance(ty, relax.TensorType) or ty.shape is None:
+            return None
+        dims = []
+        for value in ty.shape.values:
+            if not isinstance(value, tirx.IntImm):
+                return None
+            dims.append(int(value))
+        shapes.append(dims)
+    parsed = _parse_einsum_subscripts(str(subscripts), shapes)
+    if parsed is None:
+        return None
+    input_subs, output_sub, dim_sizes = parsed
+    tree = _optimal_einsum_path(input_subs, output_sub, dim_sizes)
+
+    def emit(node):
+        if isinstance(node, int):
+            return fields[node], input_subs[node]
+        lhs, lhs_sub = emit(node[0])
+        rhs, rhs_sub = emit(node[1])
+        step = bb.call_te(
+            topi.einsum,
+            f"{lhs_sub},{rhs_sub}->{node[2]}",
+            lhs,
+            rhs,
+            primfunc_name_hint="einsum",
+        )
+        return bb.emit(step), node[2]
+
+    # The root contraction keeps exactly the output indices; request them in the
+    # output order so no final transpose is needed.
+    lhs, lhs_sub = emit(tree[0])
+    rhs, rhs_sub = emit(tree[1])
+    return bb.call_te(
+        topi.einsum, f"{lhs_sub},{rhs_sub}->{output_sub}", lhs, rhs, primfunc_name_hint="einsum"
+    )
+
+
 @register_legalize("relax.einsum")
 def _einsum(bb: BlockBuilder, call: Call) -> Expr:
     t = call.args[0]
@@ -135,6 +267,10 @@ def _einsum(bb: BlockBuilder, call: Call) -> Expr:
     fields = (
         t.fields if isinstance(t, Tuple) else [bb.emit(TupleGetItem(t, i)) for i in range(n_field)]
     )
+
+    decomposed = _try_decompose_einsum(bb, call.attrs.subscripts, fields)
+    if decomposed is not None:
+        return decomposed
     return bb.call_te(topi.einsum, call.attrs.subscripts, *fields)
 
 
@@ -48,6 +48,28 @@ def _is_singleton_qparam(qparam: te.Tensor) -> bool:
     return True
 
 
+def _qparam_value(qparam, singleton, data, indices, axis):
+    """Index a scale/zero_point param at the given output indices.
+
+    Supports a scalar constant, a singleton tensor, a 1-D per-channel param
+    indexed along `axis`, and a 2-D group-quantization param of shape
+    [channels, num_groups], where the channel dim matches data.shape[axis]
+    and the last non-channel axis of data is split evenly into num_groups
+    groups.
+    """
+    if is_const_scalar(qparam):
+        return qparam
+    if singleton:
+        return qparam[(0,) * len(qparam.shape)]
+    if len(qparam.shape) == 2:
+        group_axis = len(indices) - 1
+        if group_axis == axis % len(indices):
+            group_axis -= 1
+        group_size = data.shape[group_axis] // qparam.shape[1]
+        return qparam[indices[axis], indices[group_axis] // group_size]
+    return qparam[indices[axis]]
+
+
 @register_legalize("relax.quantize")
 def _quantize(bb: BlockBuilder, call: Call) -> Expr:
     """
@@ -66,19 +88,8 @@ def _quantize(bb: BlockBuilder, call: Call) -> Expr:
         zp_singleton = _is_singleton_qparam(zp) if isinstance(zp, te.Tensor) else False
 
         def quantize_compute(*indices):
-            if is_const_scalar(scale):
-                scale_value = scale
-            elif scale_singleton:
-                scale_value = scale[(0,) * len(scale.shape)]
-            else:
-                scale_value = scale[indices[axis]]
-
-            if is_const_scalar(zp):
-                zp_value = zp
-            elif zp_singleton:
-                zp_value = zp[(0,) * len(zp.shape)]
-            else:
-                zp_value = zp[indices[axis]]
+            scale_value = _qparam_value(scale, scale_singleton, data, indices, axis)
+            zp_value = _qparam_value(zp, zp_singleton, data, indices, axis)
             scaled = data[indices] / scale_value
             round_val = (te.round(scaled) if "int" in out_dtype else scaled) + zp_value
             return clip_cast(round_val, out_dtype)
@@ -128,19 +139,8 @@ def _dequantize(bb: BlockBuilder, call: Call) -> Expr:
         zp_singleton = _is_singleton_qparam(zp) if isinstance(zp, te.Tensor) else False
 
         def dequantize_compute(*indices):
-            if is_const_scalar(scale):
-                scale_value = scale
-            elif scale_singleton:
-                scale_value = scale[(0,) * len(scale.shape)]
-            else:
-                scale_value = scale[indices[axis]]
-
-            if is_const_scalar(zp):
-                zp_value = zp
-            elif zp_singleton:
-                zp_value = zp[(0,) * len(zp.shape)]
-            else:
-                zp_value = zp[indices[axis]]
+            scale_value = _qparam_value(scale, scale_singleton, data, indices, axis)
+            zp_value = _qparam_value(zp, zp_singleton, data, indices, axis)
             dtype = (
                 "float32"
                 if data.dtype.matches_code(DataTypeCode.FLOAT, DataTypeCode.BFLOAT)
@@ -33,7 +33,7 @@ import tvm.ir
 from tvm.relax import Expr, Type, Var
 from tvm.relax.dpl import DFPattern
 from tvm.runtime import Object, Tensor
-from tvm.tirx import IndexMap, PrimFunc
+from tvm.tirx import IndexMap, IntImm, PrimFunc
 
 from ..expr import Var
 from . import _ffi_api
@@ -525,8 +525,9 @@ def StaticPlanBlockMemory() -> tvm.ir.transform.Pass:
     annotation. We can optionally annotate the attribute "tir_var_upper_bound"
     to Relax functions. The attribute value is a dict from strings to integers,
     denoting the name of TIR variables to the upper bound values of the TIR vars.
-    Note: The annotated upper bound attribute only applies to TIR vars in the
-    function signature for clarity.
+    The annotated bounds apply to TIR vars in the function signature as well as
+    to same-named symbolic variables defined inside the function body (for
+    example by a match_cast on a data-dependent shape).
 
     For example, we can annotate a Relax function with
     :code:`R.func_attr({"tir_var_upper_bound": {"n": 1024}})`.
@@ -991,6 +992,25 @@ def AttachAttrLayoutFreeBuffers() -> tvm.ir.transform.Pass:
     return _ffi_api.AttachAttrLayoutFreeBuffers()  # type: ignore
 
 
+def FuseDequantizeMatmul() -> tvm.ir.transform.Pass:
+    """Fuse dequantize into the matmul consuming its result.
+
+    This pass groups `matmul(x, dequantize(w, scale, zero_point))` (optionally
+    with a permute_dims between them) into one primitive function, so that
+    after legalization FuseTIR emits a single kernel dequantizing the weight
+    on the fly. The quantized weight stays in its packed layout end-to-end
+    and only the quantized bits are read from memory.
+
+    Note that this pass should be applied before LegalizeOps.
+
+    Returns
+    -------
+    ret : tvm.transform.Pass
+        The registered pass for fusing dequantize into matmul.
+    """
+    return _ffi_api.FuseDequantizeMatmul()  # type: ignore
+
+
 def SplitLayoutRewritePreproc() -> tvm.ir.transform.Pass:
     """Split the TIR layout rewrite into multiple TIR functions.
     This pass is used in the prepack weight after meta_schedule tuning.
@@ -1403,7 +1423,9 @@ def DeadCodeElimination(entry_functions: list[str] | None = None) -> tvm.ir.tran
 
 
 def ToMixedPrecision(
-    out_dtype="float32", fp16_input_names: list[str] | None = None
+    out_dtype="float32",
+    fp16_input_names: list[str] | None = None,
+    policy_override: dict[str, str] | None = None,
 ) -> tvm.ir.transform.Pass:
     """Automatic mixed precision pass. Currently the pass assumes the input module to be fp32
     only, and will automatically cast fp32 to fp16 for certain ops.
@@ -1417,13 +1439,17 @@ def ToMixedPrecision(
     fp16_input_names : List[str]
         The names of function parameters whose dtype should become fp16. The  function signature
         would change accordingly.
+    policy_override : Optional[Dict[str, str]]
+        Per-op overrides of the registered mixed precision policy, mapping an op name to
+        "always", "follow" or "never". Measurement-driven tuning
+        (:py:func:`tvm.relax.transform.tune_mixed_precision`) produces this map per target.
 
     Returns
     -------
     ret : tvm.transform.Pass
         The registered pass for mixed precision.
     """
-    return _ffi_api.ToMixedPrecision(out_dtype, fp16_input_names)  # type: ignore
+    return _ffi_api.ToMixedPrecision(out_dtype, fp16_input_names, policy_override)  # type: ignore
 
 
 def SplitCallTIRByPattern(patterns: list[PrimFunc], fcodegen: Callable) -> tvm.ir.transform.Pass:
@@ -1608,6 +1634,122 @@ def SpecializePrimFuncBasedOnCallSite() -> tvm.ir.transform.Pass:
     return _ffi_api.SpecializePrimFuncBasedOnCallSite()  # type: ignore
 
 
+def ShapeBucketDispatch(buckets: Mapping[str, Sequence[int]]) -> tvm.ir.transform.Pass:
+    """Specialize exposed functions for declared symbolic-shape buckets.
+
+    Every exposed function that uses a bucketed symbolic variable is cloned
+    once per bucket value with the variable bound to that constant, so the
+    clone compiles with fully static shapes. The original function becomes a
+    dispatcher that compares the runtime shape value against the bucket values
+    and calls the matching clone, falling back to the unmodified dynamic
+    version under a ``"<name>_generic"`` global symbol.
+
+    Parameters
+    ----------
+    buckets : Mapping[str, Sequence[int]]
+        Maps a symbolic variable name (e.g. ``"seq_len"``) to the shape values
+        to specialize for.
+
+    Returns
+    -------
+    ret : tvm.ir.transform.Pass
+        The registered pass that builds the dispatch tree.
+    """
+    converted = {
+        name: [IntImm("int64", int(value)) for value in values]
+        for name, values in buckets.items()
+    }
+    return _ffi_api.ShapeBucketDispatch(converted)  # type: ignore
+
+
+def RewriteAttentionKVCache() -> tvm.ir.transform.Pass:
+    """Rewrite stateless attention chains to the paged KV cache runtime.
+
+    Recognizes the QKV-projection / reshape / ``R.nn.attention`` chain that
+    frontends emit for causal self-attention and rewrites it to the
+    ``vm.builtin.attention_kv_cache_attention_with_fused_qkv`` builtin. Each
+    rewritten function gains a trailing ``paged_kv_cache`` object parameter;
+    the caller creates the cache with
+    ``vm.builtin.paged_attention_kv_cache_create`` and brackets invocations
+    with ``vm.builtin.kv_state_begin_forward`` / ``end_forward``. Attention
+    sites are assigned layer ids in program order.
+
+    Returns
+    -------
+    ret : tvm.ir.transform.Pass
+        The registered pass.
+    """
+    return _ffi_api.RewriteAttentionKVCache()  # type: ignore
+
+
+def OverlapDeviceTransfers() -> tvm.ir.transform.Pass:
+    """Overlap cross-device transfers with independent compute.
+
+    Splits each ``R.to_vdevice`` inside a dataflow block into an asynchronous
+    ``vm.builtin.to_device_async`` call at the original binding site and a
+    ``vm.builtin.device_transfer_wait`` call in front of the first binding
+    that consumes the result. Compute issued between the two overlaps with
+    the copy. Only transfers to the ``"global"`` memory scope whose result is
+    consumed within the same dataflow block are rewritten.
+
+    Returns
+    -------
+    ret : tvm.ir.transform.Pass
+        The registered pass.
+    """
+    return _ffi_api.OverlapDeviceTransfers()  # type: ignore
+
+
+def AssignComputeStreams(max_streams: int = 2) -> tvm.ir.transform.Pass:
+    """Assign independent dependency chains to numbered compute streams.
+
+    Colors the bindings of each dataflow block into dependency chains and
+    maps the chains onto ``max_streams`` physical streams, inserting
+    ``vm.builtin.stream_switch`` where consecutive bindings land on different
+    streams and ``vm.builtin.stream_join`` in front of bindings that consume
+    values produced on another stream. Chain 0 keeps the device's default
+    stream, every dataflow output is joined back to it, and purely serial
+    blocks are left untouched. Run before memory planning so the inserted
+    bindings are visible to liveness analysis.
+
+    Parameters
+    ----------
+    max_streams : int
+        Number of physical streams to map chains onto, including the default
+        stream. Values below 2 make the pass a no-op.
+
+    Returns
+    -------
+    ret : tvm.ir.transform.Pass
+        The registered pass.
+    """
+    return _ffi_api.AssignComputeStreams(max_streams)  # type: ignore
+
+
+def AutoBatch(func_names: Sequence[str] | None = None) -> tvm.ir.transform.Pass:
+    """Derive batched variants of per-request entry functions.
+
+    Each selected exposed function is cloned into a ``<name>_batched``
+    variant in which every tensor parameter's unit leading dimension is
+    replaced by one shared symbolic ``batch_size`` and the body is
+    re-derived so the batch dimension propagates through the call graph.
+    The original per-request entry point stays available. Functions without
+    a unit leading dimension to batch are skipped.
+
+    Parameters
+    ----------
+    func_names : Optional[Sequence[str]]
+        Global symbols of the functions to batch. When empty or None, every
+        exposed function is considered.
+
+    Returns
+    -------
+    ret : tvm.ir.transform.Pass
+        The registered pass.
+    """
+    return _ffi_api.AutoBatch([str(name) for name in func_names or []])  # type: ignore
+
+
 def _wrap_class_function_pass(pass_cls, pass_info):
     """Wrap a python class as function pass."""
 
@@ -1646,6 +1788,7 @@ def function_pass(
     name=None,
     required=None,
     traceable=False,
+    function_local=False,
 ) -> Callable | FunctionPass:
     """Decorate a function pass.
 
@@ -1671,6 +1814,10 @@ def function_pass(
     traceable: Boolean
         Boolean variable whether the function pass is traceable
 
+    function_local: Boolean
+        Whether the pass only reads and rewrites the function it is applied
+        to, allowing the executor to process a module's functions in parallel.
+
     Returns
     -------
     create_function_pass : Union[Callable, FunctionPass]
@@ -1744,7 +1891,7 @@ def function_pass(
     def create_function_pass(pass_arg):
         """Internal function that creates a function pass"""
         fname = name if name else pass_arg.__name__
-        info = tvm.transform.PassInfo(opt_level, fname, required, traceable)
+        info = tvm.transform.PassInfo(opt_level, fname, required, traceable, function_local)
         if inspect.isclass(pass_arg):
             return _wrap_class_function_pass(pass_arg, info)
         if not isinstance(pass_arg, types.FunctionType | types.LambdaType):
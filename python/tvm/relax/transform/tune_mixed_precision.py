@@ -0,0 +1,214 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=invalid-name
+"""Measurement-driven policy tuning for the ToMixedPrecision pass."""
+
+import json
+import os
+
+import numpy as np
+
+import tvm
+from tvm.ir.module import IRModule
+
+from ..analysis import post_order_visit
+from .transform import ToMixedPrecision
+
+# TMixedPrecisionPolicy kinds that make an op a tuning candidate.
+_POLICY_NAMES = {0: "always", 1: "follow"}
+
+
+def mixed_precision_candidate_ops(mod: IRModule) -> dict[str, str]:
+    """Collect the ops in `mod` whose registered policy lets ToMixedPrecision cast them.
+
+    Returns a dict mapping each candidate op name to its registered policy name
+    ("always" or "follow").
+    """
+    candidates: dict[str, str] = {}
+
+    def fvisit(expr):
+        if isinstance(expr, tvm.relax.Call) and isinstance(expr.op, tvm.ir.Op):
+            policy = expr.op.get_attr("TMixedPrecisionPolicy")
+            if policy is not None and int(policy) in _POLICY_NAMES:
+                candidates[expr.op.name] = _POLICY_NAMES[int(policy)]
+
+    for _, func in mod.functions_items():
+        if isinstance(func, tvm.relax.Function):
+            post_order_visit(func, fvisit)
+    return candidates
+
+
+def _random_inputs(func: tvm.relax.Function, dev: tvm.runtime.Device) -> list:
+    """Generate one random tensor per parameter of `func`.
+
+    All parameters must be tensors with static shapes and known dtypes.
+    """
+    inputs = []
+    for param in func.params:
+        ty = param.ty
+        if not isinstance(ty, tvm.relax.TensorType) or ty.shape is None or ty.dtype is None:
+            raise ValueError(
+                f"tune_mixed_precision requires static tensor parameters, "
+                f"but parameter {param.name_hint} has type {ty}"
+            )
+        shape = [int(dim) for dim in ty.shape.values]
+        dtype = str(ty.dtype.dtype)
+        if dtype.startswith("float") or dtype.startswith("bfloat"):
+            data = np.random.uniform(-1.0, 1.0, size=shape).astype(dtype)
+        elif dtype.startswith("int") or dtype.startswith("uint"):
+            data = np.random.randint(0, 8, size=shape).astype(dtype)
+        else:
+            raise ValueError(f"Unsupported parameter dtype {dtype}")
+        inputs.append(tvm.runtime.tensor(data, dev))
+    return inputs
+
+
+def _flatten_outputs(out) -> list[np.ndarray]:
+    if isinstance(out, list | tuple | tvm.ir.Array):
+        ret = []
+        for field in out:
+            ret.extend(_flatten_outputs(field))
+        return ret
+    return [out.numpy()]
+
+
+def _max_relative_error(refs: list[np.ndarray], outs: list[np.ndarray]) -> float:
+    err = 0.0
+    for ref, out in zip(refs, outs):
+        scale = float(np.max(np.abs(ref.astype("float64")))) + 1e-30
+        diff = np.abs(out.astype("float64") - ref.astype("float64"))
+        err = max(err, float(np.max(diff)) / scale)
+    return err
+
+
+def _measure(mod, target, dev, inputs, entry_name, number, repeat):
+    """Build `mod`, run it once for outputs, and time the entry function."""
+    exe = tvm.relax.build(mod, target)
+    vm = tvm.runtime.vm.VirtualMachine(exe, dev)
+    outputs = _flatten_outputs(vm[entry_name](*inputs))
+    timer = vm.time_evaluator(entry_name, dev, number=number, repeat=repeat)
+    return outputs, timer(*inputs).mean
+
+
+def load_mixed_precision_decisions(target, cache_file: str) -> dict[str, str] | None:
+    """Load persisted per-op decisions for `target`, or None if not tuned yet."""
+    if not os.path.exists(cache_file):
+        return None
+    with open(cache_file, "r", encoding="utf-8") as f:
+        cache = json.load(f)
+    return cache.get(str(tvm.target.Target(target)))
+
+
+def tune_mixed_precision(
+    mod: IRModule,
+    target,
+    dev: tvm.runtime.Device,
+    *,
+    out_dtype: str = "float32",
+    accuracy_budget: float = 1e-3,
+    entry_name: str = "main",
+    cache_file: str | None = None,
+    number: int = 3,
+    repeat: int = 3,
+) -> dict[str, str]:
+    """Decide per op whether casting to fp16 pays off on `target`.
+
+    Starting from an all-fp32 configuration, each candidate op is enabled in turn and
+    kept only if the measured runtime improves and the outputs on random inputs stay
+    within `accuracy_budget` (maximum elementwise error, relative to the magnitude of
+    the fp32 reference). The resulting decisions are persisted per target in
+    `cache_file` and can be replayed with
+    ``ToMixedPrecision(policy_override=decisions)``.
+
+    Parameters
+    ----------
+    mod : IRModule
+        The fp32 module to tune. Must contain a relax function named `entry_name`
+        whose parameters are tensors with static shapes.
+    target : Union[str, tvm.target.Target]
+        The build target.
+    dev : tvm.runtime.Device
+        The device to measure on. Must match `target`.
+    out_dtype : str
+        The accumulator dtype passed to ToMixedPrecision.
+    accuracy_budget : float
+        The maximum tolerated relative output error against the fp32 reference.
+    entry_name : str
+        The name of the function to measure.
+    cache_file : Optional[str]
+        A JSON file holding decisions keyed by target. Previously persisted decisions
+        for `target` are returned directly; new decisions are appended to it.
+    number, repeat : int
+        Timing parameters forwarded to the VM time evaluator.
+
+    Returns
+    -------
+    decisions : Dict[str, str]
+        A policy_override map for ToMixedPrecision: op name -> "always" / "follow" /
+        "never".
+    """
+    target = tvm.target.Target(target)
+    if cache_file is not None:
+        cached = load_mixed_precision_decisions(target, cache_file)
+        if cached is not None:
+            return cached
+
+    candidates = mixed_precision_candidate_ops(mod)
+    inputs = _random_inputs(mod[entry_name], dev)
+
+    # The all-"never" configuration is the fp32 reference.
+    decisions = {op_name: "never" for op_name in candidates}
+    ref_outputs, best_time = _measure(
+        ToMixedPrecision(out_dtype=out_dtype, policy_override=decisions)(mod),
+        target,
+        dev,
+        inputs,
+        entry_name,
+        number,
+        repeat,
+    )
+
+    for op_name, registered_policy in sorted(candidates.items()):
+        trial = dict(decisions)
+        trial[op_name] = registered_policy
+        try:
+            outputs, trial_time = _measure(
+                ToMixedPrecision(out_dtype=out_dtype, policy_override=trial)(mod),
+                target,
+                dev,
+                inputs,
+                entry_name,
+                number,
+                repeat,
+            )
+        except RuntimeError:
+            # A candidate may fail to build in fp16; keep it in fp32.
+            continue
+        if trial_time < best_time and _max_relative_error(ref_outputs, outputs) <= accuracy_budget:
+            decisions = trial
+            best_time = trial_time
+
+    if cache_file is not None:
+        cache = {}
+        if os.path.exists(cache_file):
+            with open(cache_file, "r", encoding="utf-8") as f:
+                cache = json.load(f)
+        cache[str(target)] = decisions
+        with open(cache_file, "w", encoding="utf-8") as f:
+            json.dump(cache, f, indent=2, sort_keys=True)
+
+    return decisions
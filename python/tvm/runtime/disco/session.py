@@ -481,6 +481,38 @@ class Session(Object):
         func = self._get_cached_method("runtime.disco.gather_to_worker0")
         func(from_array, in_group, to_array)
 
+    def reshard(
+        self,
+        src: DRef,
+        old_num_shards: int,
+        new_num_shards: int,
+        dst: DRef,
+    ) -> None:
+        """Redistribute a dim-0-sharded parameter when the number of shards changes.
+
+        The overlapping row ranges are exchanged between workers via direct
+        worker-to-worker copies (GPU-to-GPU under NCCL), so the tensor-parallel
+        degree can be scaled at runtime without reloading the model from disk.
+
+        Parameters
+        ----------
+        src : DRef
+            The local shard under the old sharding on workers with id below
+            `old_num_shards`, and None on the remaining workers.
+
+        old_num_shards : int
+            The number of shards the parameter is currently divided into.
+
+        new_num_shards : int
+            The number of shards the parameter is redistributed into.
+
+        dst : DRef
+            The buffer for the local shard under the new sharding on workers
+            with id below `new_num_shards`, and None on the remaining workers.
+        """
+        func = self._get_cached_method("runtime.disco.reshard_row_sharded")
+        func(src, old_num_shards, new_num_shards, dst)
+
     def allreduce(
         self,
         src: DRef,
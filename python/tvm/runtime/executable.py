@@ -45,6 +45,21 @@ class Executable:
         """Call the executable."""
         return self.jit().main(*args, **kwargs)
 
+    def used_global_funcs(self) -> list[str]:
+        """List the global functions the executable resolves by name at runtime.
+
+        These are the environment functions (e.g. the ``vm.builtin.*``
+        surface) the compiled bytecode calls. Deployment builds can use the
+        list to link a runtime registering only what the artifact needs, for
+        example together with the ``BUILD_MINIMAL_VM_RUNTIME`` build option.
+
+        Returns
+        -------
+        names : list of str
+            The sorted, de-duplicated function names.
+        """
+        return list(self.mod["used_global_func_names"]())
+
     def jit(
         self,
         *,
@@ -0,0 +1,155 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Deterministic execution tracing for the Relax virtual machine.
+
+Records, for every Call instruction the VM executes, the callee symbol, the
+shapes and dtypes of its tensor arguments, and (at a configurable sampling
+interval) a content hash of its outputs. Two traces of the same workload on
+different artifacts can then be compared to localize the first instruction
+where the executions diverge, instead of bisecting by hand::
+
+    recorder = VMTraceRecorder(vm, hash_every=16)
+    vm["main"](*args)
+    recorder.save("current.jsonl")
+
+    # later, against a baseline trace:
+    python -m tvm.exec.vm_trace_diff baseline.jsonl current.jsonl
+
+The trace is written as JSON lines, one record per call, so long runs can be
+streamed and diffed without loading everything into memory.
+"""
+
+import hashlib
+import json
+
+from . import Tensor
+
+
+def _summarize(value):
+    """Summarize one argument or return value into a JSON-friendly form."""
+    if isinstance(value, Tensor):
+        return {"shape": list(value.shape), "dtype": str(value.dtype)}
+    if isinstance(value, (int, float, str, bool)) or value is None:
+        return value
+    return {"type": type(value).__name__}
+
+
+def _hash_value(value, hasher):
+    """Fold the content of a value into the hasher, syncing tensors to host."""
+    if isinstance(value, Tensor):
+        hasher.update(value.numpy().tobytes())
+    elif isinstance(value, (tuple, list)):
+        for field in value:
+            _hash_value(field, hasher)
+    elif value is not None:
+        hasher.update(repr(value).encode("utf-8"))
+
+
+class VMTraceRecorder:
+    """Record a VM execution trace through the VM instrument hook.
+
+    Attaching the recorder replaces any instrument previously set on the
+    virtual machine. Hashing an output synchronizes it to the host, so use
+    ``hash_every`` to trade divergence-localization granularity for runtime
+    overhead: shapes and dtypes are recorded for every call either way, and
+    the diff tool falls back to them between hashed calls.
+
+    Parameters
+    ----------
+    vm : tvm.runtime.vm.VirtualMachine
+        The virtual machine to record.
+
+    hash_every : int
+        Hash the outputs of every n-th call; 1 hashes everything, 0 disables
+        hashing entirely.
+    """
+
+    def __init__(self, vm, hash_every=1):
+        self._records = []
+        self._hash_every = hash_every
+        self._call_index = 0
+        vm.set_instrument(self._instrument)
+
+    def _instrument(self, func, name, before_run, ret_val, *args):
+        if before_run:
+            return None
+        record = {
+            "index": self._call_index,
+            "name": str(name),
+            "args": [_summarize(arg) for arg in args],
+            "ret": _summarize(ret_val),
+        }
+        if self._hash_every > 0 and self._call_index % self._hash_every == 0:
+            hasher = hashlib.sha256()
+            _hash_value(ret_val, hasher)
+            record["ret_sha256"] = hasher.hexdigest()
+        self._records.append(record)
+        self._call_index += 1
+        return None
+
+    @property
+    def records(self):
+        """The recorded call records, in execution order."""
+        return self._records
+
+    def reset(self):
+        """Drop the recorded trace and restart the call numbering."""
+        self._records = []
+        self._call_index = 0
+
+    def save(self, path):
+        """Write the trace as JSON lines to `path`."""
+        with open(path, "w", encoding="utf-8") as trace_file:
+            for record in self._records:
+                trace_file.write(json.dumps(record) + "\n")
+
+
+def load_trace(path):
+    """Load a JSON-lines trace written by :py:class:`VMTraceRecorder`."""
+    records = []
+    with open(path, encoding="utf-8") as trace_file:
+        for line in trace_file:
+            line = line.strip()
+            if line:
+                records.append(json.loads(line))
+    return records
+
+
+def find_divergence(baseline, current):
+    """Localize the first diverging call between two traces.
+
+    Compares call order, callee symbols, argument shapes and dtypes, and the
+    sampled output hashes. Returns a dict with the diverging call index, the
+    kind of mismatch (``"name"``, ``"args"``, ``"ret"``, ``"ret_sha256"`` or
+    ``"length"``), and both records — or None when the traces agree.
+    """
+    for index, (base, cur) in enumerate(zip(baseline, current)):
+        for field in ("name", "args", "ret"):
+            if base.get(field) != cur.get(field):
+                return {"index": index, "field": field, "baseline": base, "current": cur}
+        if "ret_sha256" in base and "ret_sha256" in cur:
+            if base["ret_sha256"] != cur["ret_sha256"]:
+                return {"index": index, "field": "ret_sha256", "baseline": base, "current": cur}
+    if len(baseline) != len(current):
+        index = min(len(baseline), len(current))
+        return {
+            "index": index,
+            "field": "length",
+            "baseline": baseline[index] if index < len(baseline) else None,
+            "current": current[index] if index < len(current) else None,
+        }
+    return None
@@ -47,6 +47,11 @@ def default_s_tir_pipeline():
             s_tir.transform.LowerMatchBuffer(),
             tirx.transform.StmtSimplify(),
             s_tir.transform.InjectPermutedLayout(),
+            *(
+                [s_tir.transform.AnnotateSoftwarePipeline()]
+                if bool(config.get("tirx.auto_software_pipeline", False))
+                else []
+            ),
             s_tir.transform.AnnotateIrregularLoop(),
             s_tir.transform.InjectSoftwarePipeline(),
             s_tir.transform.TransformMmaBufferLayout(),
@@ -201,6 +201,17 @@ def ManifestSharedMemoryLocalStage():
     return _ffi_api.ManifestSharedMemoryLocalStage()  # type: ignore
 
 
+def AnnotateSoftwarePipeline():
+    """Automatically annotate software pipeline stages for copy/compute loops
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
+    return _ffi_api.AnnotateSoftwarePipeline()  # type: ignore
+
+
 def AnnotateIrregularLoop():
     """Annotate irregular loop mark.
 
@@ -16,13 +16,16 @@
 # under the License.
 """The entry point of TVM parser."""
 
+import hashlib
 import inspect
+import os
 from typing import Any
 
 import tvm
 
 from ....ir.module import IRModule
 from ...ir_builder import IRBuilder
+from ...ir_builder import _ffi_api as _ir_builder_ffi_api
 from . import doc
 from .diagnostics import Source
 from .error import ParserError
@@ -65,6 +68,22 @@ def _default_globals() -> dict[str, Any]:
     }
 
 
+def _parse_cache_enabled() -> bool:
+    """Whether parse results may be served from the process-wide parse cache.
+
+    Opt-in via TVM_SCRIPT_PARSE_CACHE=1. The cache only kicks in for parses
+    that use the default globals: user-supplied extra_vars can change the
+    parse result in ways a source hash cannot capture.
+    """
+    return os.environ.get("TVM_SCRIPT_PARSE_CACHE", "0") == "1"
+
+
+def _parse_cache_key(source: Source, check_well_formed: bool, s_tir: bool) -> str:
+    """The cache key must capture everything the parse output depends on."""
+    digest = hashlib.sha256(source.full_source.encode("utf-8")).hexdigest()
+    return f"wf={int(check_well_formed)};s_tir={int(s_tir)};{digest}"
+
+
 def scan_macro(program: Any | str, extra_vars: dict[str, Any] | None = None) -> Any:
     """Generate the AST, and the source code for __repr__."""
     # The AST will be converted into TIR at the time of expansion.
@@ -97,6 +116,7 @@ def parse(
     func : Any
         The parsed TVMScript program.
     """
+    use_cache = extra_vars is None and _parse_cache_enabled()
     if extra_vars is None:
         extra_vars = _default_globals()
 
@@ -111,6 +131,17 @@ def parse(
                 all_pyfuncs[name] = func
 
     source = Source(program)
+    # Parsed modules holding python callables cannot be shared across parses.
+    use_cache = use_cache and not all_pyfuncs
+    cache_key = None
+    if use_cache:
+        cache_key = _parse_cache_key(source, check_well_formed, s_tir)
+        cached = _ir_builder_ffi_api.ParseCacheGet(cache_key)
+        if cached is not None:
+            # Cached functions are immutable IR and may be shared, but the
+            # module container itself can be mutated by callers, so hand out
+            # a fresh copy on every hit.
+            return cached.clone() if isinstance(cached, IRModule) else cached
     parser = Parser(source, ann)
     with IRBuilder() as builder:
         try:
@@ -145,6 +176,8 @@ def parse(
                 source_ast,
                 err=f"{WELL_FORMED_ERROR_MESSAGE}\n\nTraceback: {err!s}",
             )
+    if use_cache:
+        _ir_builder_ffi_api.ParseCachePut(cache_key, ret)
     return ret
 
 
@@ -211,6 +211,23 @@ def CommonSubexprElim():
     return _ffi_api.CommonSubexprElim()  # type: ignore
 
 
+def CompactIRLayout():
+    """Re-materialize the module's IR nodes in traversal order.
+
+    Rebuilds every node of the module in one burst so that the allocator
+    lays the AST out near-contiguously and subsequent visitor passes access
+    memory roughly sequentially. Structural contents are preserved but node
+    identity is not, so run it at phase boundaries rather than where
+    ``same_as``-based caches are live.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
+    return _ffi_api.CompactIRLayout()  # type: ignore
+
+
 @_ffi.register_object("tirx.transform.StmtSimplifyConfig")
 class StmtSimplifyConfig(_ffi.Object):
     """Config for stmt simplify pass"""
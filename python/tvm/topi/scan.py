@@ -114,7 +114,63 @@ def scanop(
             elif i > axis:
                 axis_mul_after *= value
 
+    # A single scan row leaves the parallel loop over rows empty. When the row is
+    # statically large enough to amortize the extra pass, use a blocked two-phase
+    # scan instead: per-block aggregates in parallel, a serial exclusive scan of
+    # the block sums, then per-block scans seeded with the carried prefix.
+    num_scan_rows = axis_mul_before * axis_mul_after
+    blocked_scan_len = None
+    if isinstance(num_scan_rows, int) and num_scan_rows == 1:
+        try:
+            static_len = utils.get_const_int(cumsum_axis_len)
+        except ValueError:
+            static_len = None
+        if static_len is not None and static_len >= 1 << 14:
+            blocked_scan_len = static_len
+
+    def gen_blocked_ir(data_buf, out_buf):
+        num_blocks = 32
+        block_len = (blocked_scan_len + num_blocks - 1) // num_blocks
+        with IRBuilder() as ib:
+            data_buf = T.buffer_proxy(data_buf)
+            out_buf = T.buffer_proxy(out_buf)
+            block_sum = T.buffer_proxy(T.decl_buffer([num_blocks], dtype, "block_sum"))
+
+            # Phase 1: per-block aggregates, in parallel.
+            with T.parallel(0, num_blocks) as b:
+                acc = T.buffer_proxy(T.decl_buffer([1], dtype, "acc", scope="local"))
+                acc[0] = cast(identity_value, dtype)
+                with T.serial(0, tvm.te.min(block_len, blocked_scan_len - b * block_len)) as k:
+                    acc[0] = binop(acc[0], maybe_cast(data_buf[b * block_len + k]))
+                block_sum[b] = acc[0]
+
+            # Phase 2: exclusive scan of the block aggregates, serially in place.
+            carry = T.buffer_proxy(T.decl_buffer([1], dtype, "carry", scope="local"))
+            cur = T.buffer_proxy(T.decl_buffer([1], dtype, "cur", scope="local"))
+            carry[0] = cast(identity_value, dtype)
+            with T.serial(0, num_blocks) as b:
+                cur[0] = block_sum[b]
+                block_sum[b] = carry[0]
+                carry[0] = binop(carry[0], cur[0])
+
+            # Phase 3: per-block scans seeded with the carried prefix, in parallel.
+            with T.parallel(0, num_blocks) as b:
+                acc = T.buffer_proxy(T.decl_buffer([1], dtype, "acc", scope="local"))
+                acc[0] = block_sum[b]
+                with T.serial(0, tvm.te.min(block_len, blocked_scan_len - b * block_len)) as k:
+                    idx = b * block_len + k
+                    if exclusive:
+                        out_buf[idx] = acc[0]
+                        acc[0] = binop(acc[0], maybe_cast(data_buf[idx]))
+                    else:
+                        acc[0] = binop(acc[0], maybe_cast(data_buf[idx]))
+                        out_buf[idx] = acc[0]
+
+            return ib.get()
+
     def gen_ir(data_buf, out_buf):
+        if blocked_scan_len is not None:
+            return gen_blocked_ir(data_buf, out_buf)
         with IRBuilder() as ib:
             data_buf = T.buffer_proxy(data_buf)
             out_buf = T.buffer_proxy(out_buf)
@@ -307,6 +307,8 @@ TVM_FFI_STATIC_INIT_BLOCK() {
            [](Analyzer analyzer, const PrimExpr& expr) { return analyzer->rewrite_simplify(expr); })
       .def("arith.AnalyzerGetRewriteSimplifyStats",
            [](Analyzer analyzer) { return analyzer->rewrite_simplify.GetStatsCounters(); })
+      .def("arith.AnalyzerGetRewriteSimplifyRuleHits",
+           [](Analyzer analyzer) { return analyzer->rewrite_simplify.GetRuleHitCounters(); })
       .def("arith.AnalyzerResetRewriteSimplifyStats",
            [](Analyzer analyzer) { analyzer->rewrite_simplify.ResetStatsCounters(); })
       .def("arith.AnalyzerCanonicalSimplify",
@@ -373,6 +375,10 @@ TVM_FFI_STATIC_INIT_BLOCK() {
            })
       .def("arith.AnalyzerGetZ3Stats",
            [](Analyzer analyzer) { return analyzer->z3_prover.GetStats(); })
+      .def("arith.AnalyzerGetZ3QueryCounters",
+           [](Analyzer analyzer) { return analyzer->z3_prover.GetQueryCounters(); })
+      .def("arith.AnalyzerResetZ3QueryCounters",
+           [](Analyzer analyzer) { analyzer->z3_prover.ResetQueryCounters(); })
       .def("arith.AnalyzerGetEnabledExtensions",
            [](Analyzer analyzer) {
              return static_cast<std::int64_t>(analyzer->rewrite_simplify.GetEnabledExtensions());
@@ -32,6 +32,7 @@
 #include <algorithm>
 #include <cmath>
 #include <limits>
+#include <vector>
 
 #include "int_operator.h"
 
@@ -121,6 +122,54 @@ inline double GetFoldResultDoubleRepr(float x) {
   return res;
 }
 
+/*!
+ * \brief Make an integer fold result, reusing interned nodes for common small values.
+ *
+ * Constant folding runs on every simplifier step, and its results cluster
+ * heavily around small constants: the 0/1 identity values and typical
+ * shape/stride factors. IR nodes are immutable, so the int32/int64 results in
+ * that range can be shared from tables built once per thread instead of
+ * allocating a short-lived IntImm per fold. The tables are thread-local for
+ * the same reason the PrimType cache is: reference counts on the shared
+ * nodes never contend across threads.
+ *
+ * \param ty The result type.
+ * \param value The folded value, already normalized by the caller via
+ *              GetFoldResultInt64Repr when truncation may apply.
+ * \return The possibly interned IntImm.
+ */
+inline IntImm MakeFoldResultIntImm(PrimType ty, int64_t value) {
+  constexpr int64_t kInternMin = -16;
+  constexpr int64_t kInternMax = 128;
+  if (value >= kInternMin && value < kInternMax && ty.IsScalar()) {
+    auto make_table = [](int bits) {
+      std::vector<IntImm> table;
+      table.reserve(kInternMax - kInternMin);
+      PrimType table_ty = PrimType::Int(bits);
+      for (int64_t v = kInternMin; v < kInternMax; ++v) {
+        table.push_back(IntImm(table_ty, v));
+      }
+      return table;
+    };
+    if (ty.MatchesElementType(DLDataTypeCode::kDLInt, 64)) {
+      thread_local const std::vector<IntImm> table = make_table(64);
+      return table[value - kInternMin];
+    }
+    if (ty.MatchesElementType(DLDataTypeCode::kDLInt, 32)) {
+      thread_local const std::vector<IntImm> table = make_table(32);
+      return table[value - kInternMin];
+    }
+  }
+  return IntImm(ty, value);
+}
+
+/*! \brief Make a boolean fold result, shared between all comparison folds. */
+inline IntImm MakeFoldResultBool(bool value) {
+  thread_local const IntImm true_value = IntImm::Bool(true);
+  thread_local const IntImm false_value = IntImm::Bool(false);
+  return value ? true_value : false_value;
+}
+
 #define TVM_ARITH_CONST_PROPAGATION(BODY)        \
   using tirx::FloatImmNode;                      \
   const IntImmNode* pa = a.as<IntImmNode>();     \
@@ -143,7 +192,7 @@ inline ffi::Optional<PrimExpr> TryConstFold<tirx::Add>(PrimExpr a, PrimExpr b) {
     PrimType result_ty = a.ty();
     if (pa && pb) {
       int64_t res = pa->value + pb->value;
-      return IntImm(result_ty, GetFoldResultInt64Repr(res, result_ty));
+      return MakeFoldResultIntImm(result_ty, GetFoldResultInt64Repr(res, result_ty));
     }
     if (pa && pa->value == 0) return b;
     if (pb && pb->value == 0) return a;
@@ -171,7 +220,7 @@ inline ffi::Optional<PrimExpr> TryConstFold<tirx::Sub>(PrimExpr a, PrimExpr b) {
     PrimType result_ty = a.ty();
     if (pa && pb) {
       int64_t res = pa->value - pb->value;
-      return IntImm(result_ty, GetFoldResultInt64Repr(res, result_ty));
+      return MakeFoldResultIntImm(result_ty, GetFoldResultInt64Repr(res, result_ty));
     }
     if (pb && pb->value == 0) return a;
     if (fa && fb) {
@@ -193,7 +242,7 @@ inline ffi::Optional<PrimExpr> TryConstFold<tirx::Mul>(PrimExpr a, PrimExpr b) {
     PrimType result_ty = a.ty();
     if (pa && pb) {
       int64_t res = pa->value * pb->value;
-      return IntImm(result_ty, GetFoldResultInt64Repr(res, result_ty));
+      return MakeFoldResultIntImm(result_ty, GetFoldResultInt64Repr(res, result_ty));
     }
     if (pa) {
       if (pa->value == 1) return b;
@@ -232,7 +281,7 @@ inline ffi::Optional<PrimExpr> TryConstFold<tirx::Div>(PrimExpr a, PrimExpr b) {
       // NOTE: this will assumes truc div.
       TVM_FFI_ICHECK_NE(pb->value, 0) << "Divide by zero";
       int64_t res = pa->value / pb->value;
-      return IntImm(result_ty, GetFoldResultInt64Repr(res, result_ty));
+      return MakeFoldResultIntImm(result_ty, GetFoldResultInt64Repr(res, result_ty));
     }
     if (pa) {
       if (pa->value == 0) return a;
@@ -266,13 +315,13 @@ inline ffi::Optional<PrimExpr> TryConstFold<tirx::Mod>(PrimExpr a, PrimExpr b) {
     if (pa && pb) {
       TVM_FFI_ICHECK_NE(pb->value, 0) << "Divide by zero";
       int64_t res = pa->value % pb->value;
-      return IntImm(result_ty, GetFoldResultInt64Repr(res, result_ty));
+      return MakeFoldResultIntImm(result_ty, GetFoldResultInt64Repr(res, result_ty));
     }
     if (pa) {
       if (pa->value == 0) return a;
     }
     if (pb) {
-      if (pb->value == 1) return IntImm(result_ty, 0);
+      if (pb->value == 1) return MakeFoldResultIntImm(result_ty, 0);
       TVM_FFI_ICHECK_NE(pb->value, 0) << "Divide by zero";
     }
   });
@@ -286,7 +335,7 @@ inline ffi::Optional<PrimExpr> TryConstFold<tirx::FloorDiv>(PrimExpr a, PrimExpr
     if (pa && pb) {
       TVM_FFI_ICHECK_NE(pb->value, 0) << "Divide by zero";
       int64_t res = arith::floordiv(pa->value, pb->value);
-      return IntImm(result_ty, GetFoldResultInt64Repr(res, result_ty));
+      return MakeFoldResultIntImm(result_ty, GetFoldResultInt64Repr(res, result_ty));
     }
     if (pa) {
       if (pa->value == 0) return a;
@@ -331,20 +380,20 @@ inline ffi::Optional<PrimExpr> TryConstFold<tirx::FloorMod>(PrimExpr a, PrimExpr
     uint64_t lhs = as_uint(ua->value, utype);
     uint64_t rhs = as_uint(ub->value, b.ty());
     TVM_FFI_ICHECK_NE(rhs, 0U) << "Divide by zero";
-    return IntImm(utype, static_cast<int64_t>(lhs % rhs));
+    return MakeFoldResultIntImm(utype, static_cast<int64_t>(lhs % rhs));
   }
   TVM_INDEX_CONST_PROPAGATION({
     PrimType result_ty = a.ty();
     if (pa && pb) {
       TVM_FFI_ICHECK_NE(pb->value, 0) << "Divide by zero";
       int64_t res = arith::floormod(pa->value, pb->value);
-      return IntImm(result_ty, GetFoldResultInt64Repr(res, result_ty));
+      return MakeFoldResultIntImm(result_ty, GetFoldResultInt64Repr(res, result_ty));
     }
     if (pa) {
       if (pa->value == 0) return a;
     }
     if (pb) {
-      if (pb->value == 1) return IntImm(result_ty, 0);
+      if (pb->value == 1) return MakeFoldResultIntImm(result_ty, 0);
       TVM_FFI_ICHECK_NE(pb->value, 0) << "Divide by zero";
     }
   });
@@ -355,7 +404,7 @@ template <>
 inline ffi::Optional<PrimExpr> TryConstFold<tirx::Min>(PrimExpr a, PrimExpr b) {
   TVM_ARITH_CONST_PROPAGATION({
     PrimType result_ty = a.ty();
-    if (pa && pb) return IntImm(result_ty, std::min(pa->value, pb->value));
+    if (pa && pb) return MakeFoldResultIntImm(result_ty, std::min(pa->value, pb->value));
     if (fa && fb) return FloatImm(result_ty, std::min(fa->value, fb->value));
   });
   if (a.same_as(b)) return a;
@@ -366,7 +415,7 @@ template <>
 inline ffi::Optional<PrimExpr> TryConstFold<tirx::Max>(PrimExpr a, PrimExpr b) {
   TVM_ARITH_CONST_PROPAGATION({
     PrimType result_ty = a.ty();
-    if (pa && pb) return IntImm(result_ty, std::max(pa->value, pb->value));
+    if (pa && pb) return MakeFoldResultIntImm(result_ty, std::max(pa->value, pb->value));
     if (fa && fb) return FloatImm(result_ty, std::max(fa->value, fb->value));
   });
   if (a.same_as(b)) return a;
@@ -376,8 +425,8 @@ inline ffi::Optional<PrimExpr> TryConstFold<tirx::Max>(PrimExpr a, PrimExpr b) {
 template <>
 inline ffi::Optional<PrimExpr> TryConstFold<tirx::GT>(PrimExpr a, PrimExpr b) {
   TVM_ARITH_CONST_PROPAGATION({
-    if (pa && pb) return IntImm::Bool(pa->value > pb->value);
-    if (fa && fb) return IntImm::Bool(fa->value > fb->value);
+    if (pa && pb) return MakeFoldResultBool(pa->value > pb->value);
+    if (fa && fb) return MakeFoldResultBool(fa->value > fb->value);
   });
   return std::nullopt;
 }
@@ -385,8 +434,8 @@ inline ffi::Optional<PrimExpr> TryConstFold<tirx::GT>(PrimExpr a, PrimExpr b) {
 template <>
 inline ffi::Optional<PrimExpr> TryConstFold<tirx::GE>(PrimExpr a, PrimExpr b) {
   TVM_ARITH_CONST_PROPAGATION({
-    if (pa && pb) return IntImm::Bool(pa->value >= pb->value);
-    if (fa && fb) return IntImm::Bool(fa->value >= fb->value);
+    if (pa && pb) return MakeFoldResultBool(pa->value >= pb->value);
+    if (fa && fb) return MakeFoldResultBool(fa->value >= fb->value);
   });
   return std::nullopt;
 }
@@ -394,8 +443,8 @@ inline ffi::Optional<PrimExpr> TryConstFold<tirx::GE>(PrimExpr a, PrimExpr b) {
 template <>
 inline ffi::Optional<PrimExpr> TryConstFold<tirx::LT>(PrimExpr a, PrimExpr b) {
   TVM_ARITH_CONST_PROPAGATION({
-    if (pa && pb) return IntImm::Bool(pa->value < pb->value);
-    if (fa && fb) return IntImm::Bool(fa->value < fb->value);
+    if (pa && pb) return MakeFoldResultBool(pa->value < pb->value);
+    if (fa && fb) return MakeFoldResultBool(fa->value < fb->value);
   });
   return std::nullopt;
 }
@@ -403,8 +452,8 @@ inline ffi::Optional<PrimExpr> TryConstFold<tirx::LT>(PrimExpr a, PrimExpr b) {
 template <>
 inline ffi::Optional<PrimExpr> TryConstFold<tirx::LE>(PrimExpr a, PrimExpr b) {
   TVM_ARITH_CONST_PROPAGATION({
-    if (pa && pb) return IntImm::Bool(pa->value <= pb->value);
-    if (fa && fb) return IntImm::Bool(fa->value <= fb->value);
+    if (pa && pb) return MakeFoldResultBool(pa->value <= pb->value);
+    if (fa && fb) return MakeFoldResultBool(fa->value <= fb->value);
   });
   return std::nullopt;
 }
@@ -412,8 +461,8 @@ inline ffi::Optional<PrimExpr> TryConstFold<tirx::LE>(PrimExpr a, PrimExpr b) {
 template <>
 inline ffi::Optional<PrimExpr> TryConstFold<tirx::EQ>(PrimExpr a, PrimExpr b) {
   TVM_ARITH_CONST_PROPAGATION({
-    if (pa && pb) return IntImm::Bool(pa->value == pb->value);
-    if (fa && fb) return IntImm::Bool(fa->value == fb->value);
+    if (pa && pb) return MakeFoldResultBool(pa->value == pb->value);
+    if (fa && fb) return MakeFoldResultBool(fa->value == fb->value);
   });
   return std::nullopt;
 }
@@ -421,8 +470,8 @@ inline ffi::Optional<PrimExpr> TryConstFold<tirx::EQ>(PrimExpr a, PrimExpr b) {
 template <>
 inline ffi::Optional<PrimExpr> TryConstFold<tirx::NE>(PrimExpr a, PrimExpr b) {
   TVM_ARITH_CONST_PROPAGATION({
-    if (pa && pb) return IntImm::Bool(pa->value != pb->value);
-    if (fa && fb) return IntImm::Bool(fa->value != fb->value);
+    if (pa && pb) return MakeFoldResultBool(pa->value != pb->value);
+    if (fa && fb) return MakeFoldResultBool(fa->value != fb->value);
   });
   return std::nullopt;
 }
@@ -453,7 +502,7 @@ template <>
 inline ffi::Optional<PrimExpr> TryConstFold<tirx::Not>(PrimExpr a) {
   const IntImmNode* pa = a.as<IntImmNode>();
   if (pa) {
-    return IntImm::Bool(!(pa->value));
+    return MakeFoldResultBool(!(pa->value));
   }
   return std::nullopt;
 }
@@ -22,6 +22,7 @@
  */
 #include <tvm/arith/analyzer.h>
 #include <tvm/ffi/cast.h>
+#include <tvm/ffi/extra/structural_hash.h>
 #include <tvm/ffi/function.h>
 #include <tvm/ffi/reflection/registry.h>
 #include <tvm/ir/op.h>
@@ -30,6 +31,8 @@
 
 #include <algorithm>
 #include <optional>
+#include <utility>
+#include <vector>
 
 #include "constraint_extract.h"
 #include "int_operator.h"
@@ -130,6 +133,7 @@ class ConstIntBoundAnalyzer::Impl
       }
     }
     var_map_[var] = info;
+    ++binding_epoch_;
   }
 
   Entry VisitExpr_(const LetNode* op) final {
@@ -137,8 +141,10 @@ class ConstIntBoundAnalyzer::Impl
     // if the var has not been binded, update the info.
     if (it == var_map_.end()) {
       var_map_[op->var] = this->VisitExpr(op->value);
+      ++binding_epoch_;
       Entry ret = VisitExpr(op->body);
       var_map_.erase(op->var);
+      ++binding_epoch_;
       return ret;
     } else {
       return VisitExpr(op->body);
@@ -490,9 +496,11 @@ class ConstIntBoundAnalyzer::Impl
     if (info.size() == 0) return nullptr;
     size_t old_size = additional_info_.size();
     additional_info_.insert(additional_info_.end(), info.begin(), info.end());
+    ++binding_epoch_;
     auto frecover = [old_size, this]() {
       if (additional_info_.size() > old_size) {
         additional_info_.resize(old_size);
+        ++binding_epoch_;
       }
     };
     return frecover;
@@ -501,6 +509,39 @@ class ConstIntBoundAnalyzer::Impl
   void CopyFrom(const Impl& other) {
     var_map_ = other.var_map_;
     additional_info_ = other.additional_info_;
+    ++binding_epoch_;
+  }
+
+  /*!
+   * \brief Look up a memoized bound for expr, valid under the current
+   *  binding epoch.
+   * \param expr The queried expression.
+   * \return The memoized entry, or std::nullopt on a miss.
+   */
+  std::optional<Entry> MemoLookup(const PrimExpr& expr) {
+    if (memo_epoch_ != binding_epoch_) {
+      // Bindings or constraints changed since the memo was filled; every
+      // cached bound may be stale, so start a new epoch.
+      memo_.clear();
+      memo_epoch_ = binding_epoch_;
+      return std::nullopt;
+    }
+    auto it = memo_.find(ffi::StructuralHash()(expr));
+    if (it == memo_.end()) return std::nullopt;
+    tirx::ExprDeepEqual equal;
+    for (const auto& [candidate, entry] : it->second) {
+      if (equal(expr, candidate)) return entry;
+    }
+    return std::nullopt;
+  }
+
+  /*! \brief Memoize the bound of expr under the current binding epoch. */
+  void MemoInsert(const PrimExpr& expr, const Entry& entry) {
+    if (memo_epoch_ != binding_epoch_) {
+      memo_.clear();
+      memo_epoch_ = binding_epoch_;
+    }
+    memo_[ffi::StructuralHash()(expr)].emplace_back(expr, entry);
   }
 
  private:
@@ -513,6 +554,13 @@ class ConstIntBoundAnalyzer::Impl
   std::vector<BoundInfo> additional_info_;
   // look up table for memorization
   BoundMapType* bound_{nullptr};
+  // memoized top-level query results, keyed by structural hash with
+  // deep-equality verification; valid while memo_epoch_ == binding_epoch_
+  std::unordered_map<uint64_t, std::vector<std::pair<PrimExpr, Entry>>> memo_;
+  // bumped whenever var_map_ or additional_info_ changes
+  uint64_t binding_epoch_{0};
+  // the epoch the memo was filled under
+  uint64_t memo_epoch_{0};
   // constants: the limit value means umlimited
   // NOTE: kNegInf/kPosInf are used to represent infinity.
   static const constexpr int64_t kNegInf = ConstIntBound::kNegInf;
@@ -836,7 +884,11 @@ class ConstIntBoundAnalyzer::Impl
 };
 
 ConstIntBound ConstIntBoundAnalyzer::operator()(const PrimExpr& expr) const {
+  if (auto cached = impl_->MemoLookup(expr)) {
+    return ConstIntBound(cached->min_value, cached->max_value);
+  }
   Entry ret = impl_->VisitExpr(expr);
+  impl_->MemoInsert(expr, ret);
   return ConstIntBound(ret.min_value, ret.max_value);
 }
 
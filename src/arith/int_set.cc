@@ -48,7 +48,10 @@ using tirx::is_one;
 using tirx::is_zero;
 using tirx::MakeConst;
 
-TVM_FFI_STATIC_INIT_BLOCK() { IntervalSetNode::RegisterReflection(); }
+TVM_FFI_STATIC_INIT_BLOCK() {
+  IntervalSetNode::RegisterReflection();
+  UnionSetNode::RegisterReflection();
+}
 
 PrimExpr SymbolicLimits::pos_inf_ = Var("pos_inf", PrimType::Handle());
 PrimExpr SymbolicLimits::neg_inf_ = Var("neg_inf", PrimType::Handle());
@@ -64,6 +67,13 @@ IntervalSet MakeIntervalSet(PrimExpr min_value, PrimExpr max_value) {
   return IntervalSet(min_value, max_value);
 }
 
+UnionSet::UnionSet(ffi::Array<IntervalSet> segments, IntervalSet hull) {
+  auto node = ffi::make_object<UnionSetNode>();
+  node->segments = std::move(segments);
+  node->hull = std::move(hull);
+  data_ = std::move(node);
+}
+
 TVM_FFI_STATIC_INIT_BLOCK() {
   namespace refl = tvm::ffi::reflection;
   refl::GlobalDef().def("arith.IntervalSet", MakeIntervalSet);
@@ -393,6 +403,9 @@ IntervalSet ToIntervalSet(IntSet set) {
   if (auto node = set.as<IntervalSet>()) {
     return node.value();
   }
+  if (const auto* s_union = set.as<UnionSetNode>()) {
+    return s_union->hull;
+  }
   DLOG(INFO) << "cannot resolve int set " << set;
   return IntervalSet::Everything();
 }
@@ -783,12 +796,20 @@ std::function<void()> IntSetAnalyzer::Impl::EnterConstraint(const PrimExpr& cons
   return frecover;
 }
 
+// Views a set as a single interval: union sets degrade to their convex hull.
+inline const IntervalSetNode* AsIntervalOrHull(const IntSet& set) {
+  if (const auto* s_union = set.as<UnionSetNode>()) {
+    return s_union->hull.get();
+  }
+  return set.as<IntervalSetNode>();
+}
+
 // Quickly adapt to IntSet interface
 // TODO(tqchen): revisit IntSet interface as well.
 Range IntSet::CoverRange(Range max_range) const {
   IntSet temp;
   Analyzer analyzer;
-  const IntervalSetNode* s_int = (*this).as<IntervalSetNode>();
+  const IntervalSetNode* s_int = AsIntervalOrHull(*this);
   TVM_FFI_ICHECK(s_int != nullptr);
   if (s_int->HasUpperBound() && s_int->HasLowerBound()) {
     return Range::FromMinExtent(analyzer->Simplify(s_int->min_value),
@@ -798,34 +819,34 @@ Range IntSet::CoverRange(Range max_range) const {
 }
 
 PrimExpr IntSet::min() const {
-  const IntervalSetNode* s_int = (*this).as<IntervalSetNode>();
+  const IntervalSetNode* s_int = AsIntervalOrHull(*this);
   TVM_FFI_ICHECK(s_int);
   return s_int->min_value;
 }
 
 PrimExpr IntSet::max() const {
-  const IntervalSetNode* s_int = (*this).as<IntervalSetNode>();
+  const IntervalSetNode* s_int = AsIntervalOrHull(*this);
   TVM_FFI_ICHECK(s_int);
   return s_int->max_value;
 }
 
 bool IntSet::IsNothing() const {
-  const IntervalSetNode* s_int = (*this).as<IntervalSetNode>();
+  const IntervalSetNode* s_int = AsIntervalOrHull(*this);
   return (s_int && s_int->IsEmpty());
 }
 
 bool IntSet::IsEverything() const {
-  const IntervalSetNode* s_int = (*this).as<IntervalSetNode>();
+  const IntervalSetNode* s_int = AsIntervalOrHull(*this);
   return (s_int && s_int->IsEverything());
 }
 
 bool IntSet::IsSinglePoint() const {
-  const IntervalSetNode* s_int = (*this).as<IntervalSetNode>();
+  const IntervalSetNode* s_int = AsIntervalOrHull(*this);
   return (s_int && s_int->IsSinglePoint());
 }
 
 bool IntSet::CanProveSinglePoint(const Analyzer& ana) const {
-  const IntervalSetNode* s_int = (*this).as<IntervalSetNode>();
+  const IntervalSetNode* s_int = AsIntervalOrHull(*this);
   if (!s_int) return false;
   if (s_int->IsSinglePoint()) return true;
   return ana->CanProveEqual(s_int->min_value, s_int->max_value);
@@ -833,19 +854,19 @@ bool IntSet::CanProveSinglePoint(const Analyzer& ana) const {
 
 bool IntSet::CanProvePositive() const {
   Analyzer analyzer;
-  const IntervalSetNode* s_int = (*this).as<IntervalSetNode>();
+  const IntervalSetNode* s_int = AsIntervalOrHull(*this);
   return (s_int && is_positive_const(analyzer->Simplify(s_int->min_value)));
 }
 
 bool IntSet::CanProveNegative() const {
   Analyzer analyzer;
-  const IntervalSetNode* s_int = (*this).as<IntervalSetNode>();
+  const IntervalSetNode* s_int = AsIntervalOrHull(*this);
   return (s_int && is_negative_const(analyzer->Simplify(s_int->max_value)));
 }
 
 bool IntSet::CanProveNonPositive() const {
   Analyzer analyzer;
-  if (const auto* s_int = (*this).as<IntervalSetNode>()) {
+  if (const auto* s_int = AsIntervalOrHull(*this)) {
     auto max = analyzer->Simplify(s_int->max_value);
     return is_zero(max) || is_negative_const(max);
   }
@@ -854,7 +875,7 @@ bool IntSet::CanProveNonPositive() const {
 
 bool IntSet::CanProveNonNegative() const {
   Analyzer analyzer;
-  if (const IntervalSetNode* s_int = (*this).as<IntervalSetNode>()) {
+  if (const IntervalSetNode* s_int = AsIntervalOrHull(*this)) {
     auto min = analyzer->Simplify(s_int->min_value);
     return is_zero(min) || is_positive_const(min);
   }
@@ -862,14 +883,14 @@ bool IntSet::CanProveNonNegative() const {
 }
 
 bool IntSet::HasLowerBound() const {
-  if (const IntervalSetNode* s_int = (*this).as<IntervalSetNode>()) {
+  if (const IntervalSetNode* s_int = AsIntervalOrHull(*this)) {
     return s_int->HasLowerBound();
   }
   return false;
 }
 
 bool IntSet::HasUpperBound() const {
-  if (const IntervalSetNode* s_int = (*this).as<IntervalSetNode>()) {
+  if (const IntervalSetNode* s_int = AsIntervalOrHull(*this)) {
     return s_int->HasUpperBound();
   }
   return false;
@@ -887,7 +908,7 @@ SignType IntSet::GetSignType() const {
   }
 }
 PrimExpr IntSet::PointValue() const {
-  const IntervalSetNode* s_int = (*this).as<IntervalSetNode>();
+  const IntervalSetNode* s_int = AsIntervalOrHull(*this);
   TVM_FFI_ICHECK(s_int && s_int->IsSinglePoint());
   return s_int->min_value;
 }
@@ -927,7 +948,7 @@ IntSet IntSet::FromRange(Range r) {
 
 bool IntSet::MatchRange(const Range& b) const {
   const IntSet& a = *this;
-  const IntervalSetNode* a_int = a.as<IntervalSetNode>();
+  const IntervalSetNode* a_int = AsIntervalOrHull(a);
   if (!a_int) return false;
   if (!a_int->HasUpperBound() || !a_int->HasLowerBound()) return false;
   Analyzer ana;
@@ -946,6 +967,62 @@ IntSet Union(const ffi::Array<IntSet>& sets) {
   return IntervalSet(ana->Simplify(x->min_value), ana->Simplify(x->max_value));
 }
 
+IntSet UnionSet::FromSets(AnalyzerObj* analyzer, const ffi::Array<IntSet>& sets) {
+  // Gather the member intervals, flattening nested union sets.  Any
+  // unbounded member defeats the overlap proofs below, so fall back to
+  // the convex hull in that case, matching the behavior of Union.
+  std::vector<IntervalSet> pending;
+  for (const IntSet& set : sets) {
+    if (const auto* s_union = set.as<UnionSetNode>()) {
+      pending.insert(pending.end(), s_union->segments.begin(), s_union->segments.end());
+      continue;
+    }
+    IntervalSet interval = ToIntervalSet(set);
+    if (interval->IsEmpty()) continue;
+    if (!interval->HasLowerBound() || !interval->HasUpperBound()) {
+      return Union(sets);
+    }
+    pending.push_back(interval);
+  }
+  if (pending.empty()) return IntSet::Nothing();
+
+  // Absorb each interval into the first kept segment it provably overlaps
+  // or touches; keep it as a new segment otherwise.  Two intervals overlap
+  // or are adjacent iff neither lies strictly beyond the other.
+  std::vector<IntervalSet> merged;
+  for (const IntervalSet& seg : pending) {
+    bool absorbed = false;
+    for (IntervalSet& kept : merged) {
+      if (analyzer->CanProve(seg->min_value <= kept->max_value + 1) &&
+          analyzer->CanProve(kept->min_value <= seg->max_value + 1)) {
+        kept = IntervalSet(analyzer->Simplify(min(kept->min_value, seg->min_value)),
+                           analyzer->Simplify(max(kept->max_value, seg->max_value)));
+        absorbed = true;
+        break;
+      }
+    }
+    if (!absorbed) merged.push_back(seg);
+    if (merged.size() > kMaxSegments) return Union(sets);
+  }
+  if (merged.size() == 1) return merged[0];
+
+  PrimExpr hull_min = merged[0]->min_value;
+  PrimExpr hull_max = merged[0]->max_value;
+  for (size_t i = 1; i < merged.size(); ++i) {
+    hull_min = min(hull_min, merged[i]->min_value);
+    hull_max = max(hull_max, merged[i]->max_value);
+  }
+  IntervalSet hull(analyzer->Simplify(hull_min), analyzer->Simplify(hull_max));
+  return UnionSet(ffi::Array<IntervalSet>(merged.begin(), merged.end()), hull);
+}
+
+IntSet UnionBounded(const ffi::Array<IntSet>& sets) {
+  if (sets.size() == 0) return IntSet::Nothing();
+  if (sets.size() == 1) return sets[0];
+  Analyzer ana;
+  return UnionSet::FromSets(ana.get(), sets);
+}
+
 ffi::Array<IntSet> UnionRegion(const ffi::Array<ffi::Array<IntSet>>& nd_int_sets) {
   if (nd_int_sets.empty()) {
     return {};
@@ -1104,7 +1181,7 @@ IntSet EvalSet(IntSet s, const std::unordered_map<const VarNode*, IntSet>& dom_m
   Analyzer ana;
   auto dmap = ConvertDomMap(dom_map);
   IntervalSetEvaluator m(ana.get(), dmap);
-  const IntervalSetNode* s_int = s.as<IntervalSetNode>();
+  const IntervalSetNode* s_int = AsIntervalOrHull(s);
   PrimExpr vmax = s_int->HasUpperBound() ? m.Eval(s_int->max_value).max() : s_int->max_value;
   PrimExpr vmin = s_int->HasLowerBound() ? m.Eval(s_int->min_value).min() : s_int->min_value;
   return IntervalSet(vmin, vmax);
@@ -1301,6 +1378,7 @@ TVM_FFI_STATIC_INIT_BLOCK() {
            })
       .def("arith.PosInf", []() { return SymbolicLimits::pos_inf_; })
       .def("arith.NegInf", []() { return SymbolicLimits::neg_inf_; })
+      .def("arith.UnionBounded", UnionBounded)
       .def("arith.UnionLowerBound", UnionLowerBound);
 }
 
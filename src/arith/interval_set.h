@@ -115,6 +115,61 @@ class IntervalSet : public IntSet {
   TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(IntervalSet, IntSet, IntervalSetNode);
 };
 
+/*!
+ * \brief Set represented as a bounded union of disjoint intervals.
+ *
+ * Keeps the member intervals of a union instead of collapsing them to a
+ * single convex hull, so the gaps between strided access segments are not
+ * lost.  The hull is materialized on construction; consumers that only
+ * understand intervals degrade to it gracefully.
+ */
+class UnionSetNode : public IntSetNode {
+ public:
+  /*! \brief The member intervals, pairwise disjoint as far as provable. */
+  ffi::Array<IntervalSet> segments;
+  /*! \brief Convex hull of the segments. */
+  IntervalSet hull;
+
+  static void RegisterReflection() {
+    namespace refl = tvm::ffi::reflection;
+    refl::ObjectDef<UnionSetNode>()
+        .def_ro("segments", &UnionSetNode::segments)
+        .def_ro("hull", &UnionSetNode::hull);
+  }
+
+  TVM_FFI_DECLARE_OBJECT_INFO_FINAL("arith.UnionSet", UnionSetNode, IntSetNode);
+};
+
+/*!
+ * \brief Bounded multi-interval set used for symbolic integer analysis.
+ * \sa UnionSetNode
+ */
+class UnionSet : public IntSet {
+ public:
+  /*! \brief Maximum number of segments kept before falling back to the hull. */
+  static constexpr size_t kMaxSegments = 8;
+  /*!
+   * \brief Make a new instance of union set.
+   * \param segments The member intervals.
+   * \param hull The convex hull of the segments.
+   * \return The created set.
+   */
+  TVM_DLL UnionSet(ffi::Array<IntervalSet> segments, IntervalSet hull);
+  /*!
+   * \brief Union of sets, preserving provably disjoint segments.
+   *
+   * Segments that provably overlap or are adjacent are merged; the rest are
+   * kept as members.  Falls back to the convex hull when any input lacks a
+   * bound or more than kMaxSegments segments remain.
+   * \param analyzer The analyzer used for the overlap proofs.
+   * \param sets The sets to be combined.
+   * \return The result set; an IntervalSet when no gap survives.
+   */
+  TVM_DLL static IntSet FromSets(AnalyzerObj* analyzer, const ffi::Array<IntSet>& sets);
+
+  TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(UnionSet, IntSet, UnionSetNode);
+};
+
 /*!
  * \brief Create union of two IntervalSets.
  * \param analyzer The analyzer for simplification analysis.
@@ -23,6 +23,7 @@
  */
 #include <tvm/arith/analyzer.h>
 #include <tvm/ffi/cast.h>
+#include <tvm/ffi/extra/structural_hash.h>
 #include <tvm/ffi/function.h>
 #include <tvm/ffi/reflection/registry.h>
 #include <tvm/tirx/builtin.h>
@@ -30,9 +31,12 @@
 #include <tvm/tirx/op.h>
 
 #include <limits>
+#include <optional>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
+#include "int_operator.h"
 #include "pattern_match.h"
 
 namespace tvm {
@@ -112,6 +116,7 @@ class ModularSetAnalyzer::Impl : public ExprFunctor<ModularSetAnalyzer::Entry(co
       }
     }
     var_map_[var] = Entry(info->coeff, info->base);
+    ++binding_epoch_;
   }
 
   // Detect useful constraints and use them in the analysis scope.
@@ -187,9 +192,15 @@ class ModularSetAnalyzer::Impl : public ExprFunctor<ModularSetAnalyzer::Entry(co
         // a c x  / c -> a x
         return Entry(std::abs(a.coeff / val), 0);
       }
+      if (round_down) {
+        // Since val divides the coefficient, the term (coeff * x) passes
+        // through the floor exactly, regardless of the sign of the base:
+        // floordiv(coeff * x + base, val) = (coeff / val) * x + floordiv(base, val)
+        return Entry(a.coeff / val, floordiv(a.base, val));
+      }
       // positive division have a clear rounding mode.
       // Only handle case where we clearly know we need to round down.
-      if (a.base > 0 && val > 0 && (round_down || parent_->CanProveGreaterEqual(lhs, 0))) {
+      if (a.base > 0 && val > 0 && parent_->CanProveGreaterEqual(lhs, 0)) {
         return Entry(a.coeff / val, a.base / val);
       }
     }
@@ -234,8 +245,14 @@ class ModularSetAnalyzer::Impl : public ExprFunctor<ModularSetAnalyzer::Entry(co
     Entry a = VisitExpr(lhs);
     TVM_FFI_ICHECK_NE(val, 0);
     int64_t coeff = ZeroAwareGCD(a.coeff, val);
-    if (a.base % coeff == 0 ||
-        (a.base > 0 && (round_down || parent_->CanProveGreaterEqual(lhs, 0)))) {
+    if (round_down) {
+      // floormod(x, val) differs from x by a multiple of val, and coeff
+      // divides val, so the result stays in the congruence class of the
+      // base modulo coeff, regardless of the sign of the base.  The Entry
+      // constructor normalizes the base into [0, coeff).
+      return Entry(coeff, a.base % coeff);
+    }
+    if (a.base % coeff == 0 || (a.base > 0 && parent_->CanProveGreaterEqual(lhs, 0))) {
       return Entry(coeff, a.base % coeff);
     }
     return Everything();
@@ -310,13 +327,55 @@ class ModularSetAnalyzer::Impl : public ExprFunctor<ModularSetAnalyzer::Entry(co
     return Everything();
   }
 
-  void CopyFrom(const Impl& other) { var_map_ = other.var_map_; }
+  void CopyFrom(const Impl& other) {
+    var_map_ = other.var_map_;
+    ++binding_epoch_;
+  }
+
+  /*!
+   * \brief Look up a memoized modular set for expr, valid under the
+   *  current binding epoch.
+   * \param expr The queried expression.
+   * \return The memoized entry, or std::nullopt on a miss.
+   */
+  std::optional<Entry> MemoLookup(const PrimExpr& expr) {
+    if (memo_epoch_ != binding_epoch_) {
+      // Bindings or constraints changed since the memo was filled; every
+      // cached entry may be stale, so start a new epoch.
+      memo_.clear();
+      memo_epoch_ = binding_epoch_;
+      return std::nullopt;
+    }
+    auto it = memo_.find(ffi::StructuralHash()(expr));
+    if (it == memo_.end()) return std::nullopt;
+    tirx::ExprDeepEqual equal;
+    for (const auto& [candidate, entry] : it->second) {
+      if (equal(expr, candidate)) return entry;
+    }
+    return std::nullopt;
+  }
+
+  /*! \brief Memoize the modular set of expr under the current binding epoch. */
+  void MemoInsert(const PrimExpr& expr, const Entry& entry) {
+    if (memo_epoch_ != binding_epoch_) {
+      memo_.clear();
+      memo_epoch_ = binding_epoch_;
+    }
+    memo_[ffi::StructuralHash()(expr)].emplace_back(expr, entry);
+  }
 
  private:
   /*! \brief pointer to parent. */
   AnalyzerObj* parent_{nullptr};
   // internal variable map
   std::unordered_map<Var, Entry> var_map_;
+  // memoized top-level query results, keyed by structural hash with
+  // deep-equality verification; valid while memo_epoch_ == binding_epoch_
+  std::unordered_map<uint64_t, std::vector<std::pair<PrimExpr, Entry>>> memo_;
+  // bumped whenever var_map_ changes
+  uint64_t binding_epoch_{1};
+  // the binding epoch at which memo_ was last filled
+  uint64_t memo_epoch_{0};
   /*!
    * \brief Update var by intersecting entry with var's current set.
    * \param var The variable.
@@ -330,8 +389,12 @@ class ModularSetAnalyzer::Impl : public ExprFunctor<ModularSetAnalyzer::Entry(co
       old = it->second;
     }
     var_map_[var] = Intersect(old, entry);
+    ++binding_epoch_;
     // reover function.
-    return [this, old, var]() { var_map_[var] = old; };
+    return [this, old, var]() {
+      var_map_[var] = old;
+      ++binding_epoch_;
+    };
   }
   /*!
    * \brief Create union of two sets.
@@ -393,7 +456,11 @@ class ModularSetAnalyzer::Impl : public ExprFunctor<ModularSetAnalyzer::Entry(co
 };
 
 ModularSet ModularSetAnalyzer::operator()(const PrimExpr& expr) {
+  if (auto cached = impl_->MemoLookup(expr)) {
+    return ModularSet(cached->coeff, cached->base);
+  }
   Entry ret = impl_->VisitExpr(expr);
+  impl_->MemoInsert(expr, ret);
   return ModularSet(ret.coeff, ret.base);
 }
 
@@ -0,0 +1,139 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file region_overlap.cc
+ * \brief Shared oracle for may-overlap queries between buffer regions.
+ */
+#include "region_overlap.h"
+
+#include <tvm/arith/pattern.h>
+#include <tvm/ffi/extra/structural_equal.h>
+#include <tvm/ffi/extra/structural_hash.h>
+#include <tvm/tirx/op.h>
+#include <tvm/tirx/stmt_functor.h>
+
+#include <algorithm>
+
+#include "presburger_set.h"
+
+namespace tvm {
+namespace arith {
+
+using namespace tirx;
+
+bool RegionOverlapOracle::MayOverlap(const Region& a, const Region& b) {
+  TVM_FFI_ICHECK_EQ(a.size(), b.size())
+      << "RegionOverlapOracle expects regions of the same rank, but got " << a.size() << " vs "
+      << b.size();
+
+  uint64_t hash = ffi::StructuralHash()(a) * 31 + ffi::StructuralHash()(b);
+  auto& entries = cache_[hash];
+  ffi::StructuralEqual equal;
+  for (const auto& [cached_a, cached_b, verdict] : entries) {
+    if (equal(a, cached_a) && equal(b, cached_b)) {
+      return verdict;
+    }
+  }
+  bool verdict = ComputeMayOverlap(a, b);
+  entries.emplace_back(a, b, verdict);
+  return verdict;
+}
+
+bool RegionOverlapOracle::ComputeMayOverlap(const Region& a, const Region& b) {
+  // A single provably-disjoint dimension separates the regions.
+  for (size_t i = 0; i < a.size(); i++) {
+    if (ProvablyDisjointByInterval(a[i], b[i])) {
+      return false;
+    }
+  }
+  // The dimension-wise check treats the regions as bounding boxes, so
+  // it cannot separate regions whose disjointness is only visible
+  // across dimensions, e.g. strided regions with interleaved rows.
+  if (ProvablyEmptyByPresburger(a, b)) {
+    return false;
+  }
+  return true;
+}
+
+bool RegionOverlapOracle::ProvablyDisjointByInterval(const Range& a, const Range& b) {
+  // Empty ranges touch no element and thus never overlap.
+  if (analyzer_->CanProve(a->extent <= 0) || analyzer_->CanProve(b->extent <= 0)) {
+    return true;
+  }
+  return analyzer_->CanProve(a->min + a->extent <= b->min) ||
+         analyzer_->CanProve(b->min + b->extent <= a->min);
+}
+
+bool RegionOverlapOracle::ProvablyEmptyByPresburger(const Region& a, const Region& b) {
+#if defined(TVM_MLIR_VERSION) && TVM_MLIR_VERSION >= 150
+  // Collect the free variables of all bounds, then verify that every
+  // bound is affine in them with constant coefficients.  This is the
+  // fragment the PresburgerSet constructor supports; anything beyond
+  // it stays with the conservative interval verdict.
+  ffi::Array<Var> vars;
+  auto collect_vars = [&vars](const PrimExpr& expr) {
+    PostOrderVisit(expr, [&vars](const ffi::ObjectRef& obj) {
+      if (const VarNode* node = obj.as<VarNode>()) {
+        auto var = ffi::GetRef<Var>(node);
+        if (!std::any_of(vars.begin(), vars.end(),
+                         [&var](const Var& v) { return v.same_as(var); })) {
+          vars.push_back(var);
+        }
+      }
+    });
+  };
+  for (const Region& region : {a, b}) {
+    for (const Range& range : region) {
+      collect_vars(range->min);
+      collect_vars(range->extent);
+    }
+  }
+  auto is_affine = [&vars](const PrimExpr& expr) {
+    ffi::Array<PrimExpr> coeffs = DetectLinearEquation(expr, vars);
+    if (coeffs.empty()) return false;
+    return std::all_of(coeffs.begin(), coeffs.end(),
+                       [](const PrimExpr& coeff) { return as_const_int(coeff) != nullptr; });
+  };
+  for (const Region& region : {a, b}) {
+    for (const Range& range : region) {
+      if (!is_affine(range->min) || !is_affine(range->extent)) {
+        return false;
+      }
+    }
+  }
+
+  // Introduce one point variable per dimension and require it to lie
+  // in both regions; the intersection is empty iff no integer point
+  // satisfies the conjunction for any value of the free variables.
+  PrimExpr constraint = IntImm::Bool(true);
+  for (size_t i = 0; i < a.size(); i++) {
+    Var point("_overlap_i" + std::to_string(i), a[i]->min.ty());
+    constraint = constraint && (a[i]->min <= point) && (point < a[i]->min + a[i]->extent) &&
+                 (b[i]->min <= point) && (point < b[i]->min + b[i]->extent);
+  }
+  PresburgerSet intersection(constraint);
+  return intersection->IsEmpty();
+#else
+  return false;
+#endif
+}
+
+}  // namespace arith
+}  // namespace tvm
@@ -0,0 +1,94 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file region_overlap.h
+ * \brief Shared oracle for may-overlap queries between buffer regions.
+ */
+#ifndef TVM_ARITH_REGION_OVERLAP_H_
+#define TVM_ARITH_REGION_OVERLAP_H_
+
+#include <tvm/arith/analyzer.h>
+#include <tvm/tirx/var.h>
+
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace tvm {
+namespace arith {
+
+/*!
+ * \brief Oracle answering whether two buffer regions may refer to a
+ *  common element.
+ *
+ * Several transforms need may-overlap verdicts between access regions
+ * and tend to re-derive them with ad-hoc interval checks.  This class
+ * centralizes the reasoning: a dimension-wise interval check proves
+ * disjointness when the per-dimension bounds separate, and when MLIR
+ * is available a Presburger emptiness check handles regions whose
+ * separation is only visible across dimensions.  Verdicts are cached
+ * by the structural hash of the region pair, so repeated queries over
+ * the same access regions are answered without re-proving.
+ *
+ * The oracle reasons over the regions as given, with no external
+ * variable bindings, so a cached verdict stays valid for the lifetime
+ * of the oracle and an instance may be shared across passes.
+ */
+class RegionOverlapOracle {
+ public:
+  /*!
+   * \brief Query whether two regions of the same rank may overlap.
+   *
+   * \param a The first region.
+   * \param b The second region.
+   *
+   * \return False only if the regions are provably disjoint.  True
+   *  means the regions overlap or the oracle cannot prove otherwise.
+   */
+  TVM_DLL bool MayOverlap(const tirx::Region& a, const tirx::Region& b);
+
+ private:
+  /*! \brief Compute a verdict on a cache miss */
+  bool ComputeMayOverlap(const tirx::Region& a, const tirx::Region& b);
+
+  /*! \brief Prove that two ranges of one dimension cannot intersect */
+  bool ProvablyDisjointByInterval(const Range& a, const Range& b);
+
+  /*! \brief Prove that the intersection of the regions has no integer point
+   *
+   * Only attempted when every bound is affine with constant
+   * coefficients, which is the fragment the PresburgerSet
+   * constructor supports.  Returns false when MLIR is not enabled.
+   */
+  bool ProvablyEmptyByPresburger(const tirx::Region& a, const tirx::Region& b);
+
+  /*! \brief Analyzer used for the interval disjointness proofs */
+  Analyzer analyzer_;
+
+  /*! \brief Memoized verdicts, keyed by structural hash of the region
+   *  pair with deep-equality verification
+   */
+  std::unordered_map<uint64_t, std::vector<std::tuple<tirx::Region, tirx::Region, bool>>> cache_;
+};
+
+}  // namespace arith
+}  // namespace tvm
+
+#endif  // TVM_ARITH_REGION_OVERLAP_H_
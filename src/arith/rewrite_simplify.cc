@@ -93,33 +93,33 @@ TVM_FFI_STATIC_INIT_BLOCK() { RewriteSimplifierStatsNode::RegisterReflection();
 
 // macro for doing simple rewrite
 #define TVM_TRY_REWRITE(SrcExpr, ResExpr) \
-  RecordAttemptedRewrite();               \
+  RecordAttemptedRewrite(ret);               \
   if ((SrcExpr).Match(ret)) {             \
-    RecordRewrite();                      \
+    RecordRewrite(ret);                      \
     return (ResExpr).Eval();              \
   }
 
 // macro for rewrite + recursively rewrite ResExpr
 #define TVM_TRY_RECURSIVE_REWRITE(SrcExpr, ResExpr) \
-  RecordAttemptedRewrite();                         \
+  RecordAttemptedRewrite(ret);                         \
   if ((SrcExpr).Match(ret)) {                       \
-    RecordRewrite();                                \
+    RecordRewrite(ret);                                \
     return RecursiveRewrite((ResExpr).Eval());      \
   }
 
 // macro rewrite only if CondExor is true after match.
 #define TVM_TRY_REWRITE_IF(SrcExpr, ResExpr, CondExpr)      \
-  RecordAttemptedRewrite();                                 \
+  RecordAttemptedRewrite(ret);                                 \
   if ((SrcExpr).Match(ret, [&]() { return (CondExpr); })) { \
-    RecordRewrite();                                        \
+    RecordRewrite(ret);                                        \
     return (ResExpr).Eval();                                \
   }
 
 // macro rewrite + recursive_rewrite only if CondExor is true after match.
 #define TVM_TRY_RECURSIVE_REWRITE_IF(SrcExpr, ResExpr, CondExpr) \
-  RecordAttemptedRewrite();                                      \
+  RecordAttemptedRewrite(ret);                                      \
   if ((SrcExpr).Match(ret, [&]() { return (CondExpr); })) {      \
-    RecordRewrite();                                             \
+    RecordRewrite(ret);                                             \
     return RecursiveRewrite((ResExpr).Eval());                   \
   }
 
@@ -130,6 +130,20 @@ TVM_FFI_STATIC_INIT_BLOCK() { RewriteSimplifierStatsNode::RegisterReflection();
 // handled by CanonicalSimplifier.
 //
 
+/*!
+ * \brief Whether expr's root node is an instance of any of TNode.
+ *
+ * Used to discriminate rule groups by operand kind: a group whose patterns all
+ * require, say, a Min/Max operand is skipped wholesale when neither operand
+ * has that root, instead of failing every pattern in the group. Skipping a
+ * rule that cannot match is equivalent to trying it and failing, so rule order
+ * and semantics are unchanged.
+ */
+template <typename... TNode>
+inline bool IsAnyInstance(const PrimExpr& expr) {
+  return (expr->IsInstance<TNode>() || ...);
+}
+
 /* Utility for rewriting only boolean portions of an expression
  *
  * Performs a subset of simplifications done by RewriteSimplifier,
@@ -439,94 +453,124 @@ PrimExpr RewriteSimplifier::Impl::VisitExpr_(const AddNode* op) {
   }
 
   if (IsIndexTypedExpr(op)) {
-    // Index rules
-    // cancelation rules
-    TVM_TRY_REWRITE((x - y) + y, x);
-    TVM_TRY_REWRITE(x + (y - x), y);
-
-    TVM_TRY_REWRITE((x - y) + (y - z), x - z);
-    TVM_TRY_REWRITE((x - y) + (z - x), z - y);
-
-    TVM_TRY_REWRITE(min(x, y - z) + z, min(x + z, y));
-    TVM_TRY_REWRITE(min(x - z, y) + z, min(x, y + z));
-    TVM_TRY_REWRITE(max(x, y - z) + z, max(x + z, y));
-    TVM_TRY_REWRITE(max(x - z, y) + z, max(x, y + z));
-
-    TVM_TRY_REWRITE_IF(min(x, y + z * c1) + z * c2, min(x + z * c2, y),
-                       c1.Eval()->value == -c2.Eval()->value);
-    TVM_TRY_REWRITE_IF(max(x, y + z * c1) + z * c2, max(x + z * c2, y),
-                       c1.Eval()->value == -c2.Eval()->value);
-    TVM_TRY_REWRITE_IF(min(y + z * c1, x) + z * c2, min(x + z * c2, y),
-                       c1.Eval()->value == -c2.Eval()->value);
-    TVM_TRY_REWRITE_IF(max(y + z * c1, x) + z * c2, max(x + z * c2, y),
-                       c1.Eval()->value == -c2.Eval()->value);
-
-    TVM_TRY_REWRITE((PMatchesOneOf{
-                        max(x, y) + min(x, y),
-                        min(x, y) + max(x, y),
-                        max(x, y) + min(y, x),
-                        min(x, y) + max(y, x),
-                    }),
-                    x + y);
+    // Index rules. Each group below is guarded by the operand kinds its root
+    // patterns require, so groups that cannot match are skipped wholesale.
+    const bool has_sub_operand = IsAnyInstance<SubNode>(op->a) || IsAnyInstance<SubNode>(op->b);
+    const bool has_divmod_operand =
+        IsAnyInstance<DivNode, ModNode, FloorDivNode, FloorModNode>(op->a) ||
+        IsAnyInstance<DivNode, ModNode, FloorDivNode, FloorModNode>(op->b);
+
+    if (has_sub_operand) {
+      // cancelation rules
+      TVM_TRY_REWRITE((x - y) + y, x);
+      TVM_TRY_REWRITE(x + (y - x), y);
+
+      TVM_TRY_REWRITE((x - y) + (y - z), x - z);
+      TVM_TRY_REWRITE((x - y) + (z - x), z - y);
+    }
 
-    TVM_TRY_REWRITE_IF(min(x, y + c1) + c2, min(x + c2, y), c1.Eval()->value == -c2.Eval()->value);
-    TVM_TRY_REWRITE_IF(min(x + c1, y) + c2, min(x, y + c2), c1.Eval()->value == -c2.Eval()->value);
-    TVM_TRY_REWRITE_IF(max(x, y + c1) + c2, max(x + c2, y), c1.Eval()->value == -c2.Eval()->value);
-    TVM_TRY_REWRITE_IF(max(x + c1, y) + c2, max(x, y + c2), c1.Eval()->value == -c2.Eval()->value);
+    if (IsAnyInstance<MinNode, MaxNode>(op->a)) {
+      TVM_TRY_REWRITE(min(x, y - z) + z, min(x + z, y));
+      TVM_TRY_REWRITE(min(x - z, y) + z, min(x, y + z));
+      TVM_TRY_REWRITE(max(x, y - z) + z, max(x + z, y));
+      TVM_TRY_REWRITE(max(x - z, y) + z, max(x, y + z));
+
+      TVM_TRY_REWRITE_IF(min(x, y + z * c1) + z * c2, min(x + z * c2, y),
+                         c1.Eval()->value == -c2.Eval()->value);
+      TVM_TRY_REWRITE_IF(max(x, y + z * c1) + z * c2, max(x + z * c2, y),
+                         c1.Eval()->value == -c2.Eval()->value);
+      TVM_TRY_REWRITE_IF(min(y + z * c1, x) + z * c2, min(x + z * c2, y),
+                         c1.Eval()->value == -c2.Eval()->value);
+      TVM_TRY_REWRITE_IF(max(y + z * c1, x) + z * c2, max(x + z * c2, y),
+                         c1.Eval()->value == -c2.Eval()->value);
+
+      TVM_TRY_REWRITE((PMatchesOneOf{
+                          max(x, y) + min(x, y),
+                          min(x, y) + max(x, y),
+                          max(x, y) + min(y, x),
+                          min(x, y) + max(y, x),
+                      }),
+                      x + y);
+
+      TVM_TRY_REWRITE_IF(min(x, y + c1) + c2, min(x + c2, y),
+                         c1.Eval()->value == -c2.Eval()->value);
+      TVM_TRY_REWRITE_IF(min(x + c1, y) + c2, min(x, y + c2),
+                         c1.Eval()->value == -c2.Eval()->value);
+      TVM_TRY_REWRITE_IF(max(x, y + c1) + c2, max(x + c2, y),
+                         c1.Eval()->value == -c2.Eval()->value);
+      TVM_TRY_REWRITE_IF(max(x + c1, y) + c2, max(x, y + c2),
+                         c1.Eval()->value == -c2.Eval()->value);
+    }
 
-    // constant folding
-    // NOTE: canonicalization might better at this.
-    TVM_TRY_REWRITE((x + c1) + c2, x + (c1 + c2));
+    if (IsAnyInstance<AddNode>(op->a) && IsAnyInstance<IntImmNode>(op->b)) {
+      // constant folding
+      // NOTE: canonicalization might better at this.
+      TVM_TRY_REWRITE((x + c1) + c2, x + (c1 + c2));
+    }
 
     // mul co-efficient folding
     TVM_TRY_REWRITE(x + x, x * 2);
 
-    TVM_TRY_REWRITE(matches_one_of(x * y + x, y * x + x, x + y * x, x + x * y), (y + 1) * x);
+    if (IsAnyInstance<MulNode>(op->a) || IsAnyInstance<MulNode>(op->b)) {
+      TVM_TRY_REWRITE(matches_one_of(x * y + x, y * x + x, x + y * x, x + x * y), (y + 1) * x);
 
-    TVM_TRY_REWRITE(matches_one_of(x * y + x * z, y * x + x * z, x * y + z * x, y * x + z * x),
-                    (y + z) * x);
-
-    // DivMod rules
-    // truc div
-    TVM_TRY_REWRITE(truncdiv(x, c1) * c1 + truncmod(x, c1), x);
-    // floor div
-    TVM_TRY_REWRITE(
-        matches_one_of(floordiv(x, y) * y + floormod(x, y), y * floordiv(x, y) + floormod(x, y),
-                       floormod(x, y) + floordiv(x, y) * y, floormod(x, y) + y * floordiv(x, y)),
-        x);
-
-    TVM_TRY_REWRITE_IF(floordiv(floormod(x, c2) + c1, c2) + floordiv(x, c2), floordiv(x + c1, c2),
-                       c2.Eval()->value > 0);
-
-    TVM_TRY_RECURSIVE_REWRITE(floordiv(x, 2) + floormod(x, 2), floordiv(x + 1, 2));
+      TVM_TRY_REWRITE(matches_one_of(x * y + x * z, y * x + x * z, x * y + z * x, y * x + z * x),
+                      (y + z) * x);
+    }
 
-    // Simplify (x + 1) % 2 + x % 2 => 1
-    // NOTE: we should avoid simplifying (x + 1) %2 => 1 - x % 2 though
-    // mainly because introducing extra negative signs to expression can harm itertaor
-    // analysis which usually relies on positive itertator co-efficients.
-    TVM_TRY_REWRITE_IF(floormod(x + c1, 2) + floormod(x, 2), OneWithTypeLike(x),
-                       floormod(c1.Eval()->value, 2) == 1);
-    TVM_TRY_REWRITE_IF(floormod(x, 2) + floormod(x + c1, 2), OneWithTypeLike(x),
-                       floormod(c1.Eval()->value, 2) == 1);
+    if (has_divmod_operand) {
+      // DivMod rules
+      // truc div
+      TVM_TRY_REWRITE(truncdiv(x, c1) * c1 + truncmod(x, c1), x);
+      // floor div
+      TVM_TRY_REWRITE(
+          matches_one_of(floordiv(x, y) * y + floormod(x, y), y * floordiv(x, y) + floormod(x, y),
+                         floormod(x, y) + floordiv(x, y) * y, floormod(x, y) + y * floordiv(x, y)),
+          x);
+
+      TVM_TRY_REWRITE_IF(floordiv(floormod(x, c2) + c1, c2) + floordiv(x, c2), floordiv(x + c1, c2),
+                         c2.Eval()->value > 0);
+
+      TVM_TRY_RECURSIVE_REWRITE(floordiv(x, 2) + floormod(x, 2), floordiv(x + 1, 2));
+
+      // Simplify (x + 1) % 2 + x % 2 => 1
+      // NOTE: we should avoid simplifying (x + 1) %2 => 1 - x % 2 though
+      // mainly because introducing extra negative signs to expression can harm itertaor
+      // analysis which usually relies on positive itertator co-efficients.
+      TVM_TRY_REWRITE_IF(floormod(x + c1, 2) + floormod(x, 2), OneWithTypeLike(x),
+                         floormod(c1.Eval()->value, 2) == 1);
+      TVM_TRY_REWRITE_IF(floormod(x, 2) + floormod(x + c1, 2), OneWithTypeLike(x),
+                         floormod(c1.Eval()->value, 2) == 1);
+    }
 
     // canonicalization rule
     // will try rewrite again after canonicalization.
 
-    TVM_TRY_RECURSIVE_REWRITE(matches_one_of(x + (c1 - y), (c1 - y) + x), (x - y) + c1);
-    TVM_TRY_RECURSIVE_REWRITE(matches_one_of((x + c1) + y, x + (c1 + y), x + (y + c1)),
-                              (x + y) + c1);
-    TVM_TRY_RECURSIVE_REWRITE(x + max(y, z), max(y, z) + x);
-    TVM_TRY_RECURSIVE_REWRITE(x + min(y, z), min(y, z) + x);
+    if (has_sub_operand) {
+      TVM_TRY_RECURSIVE_REWRITE(matches_one_of(x + (c1 - y), (c1 - y) + x), (x - y) + c1);
+    }
+    if (IsAnyInstance<AddNode>(op->a) || IsAnyInstance<AddNode>(op->b)) {
+      TVM_TRY_RECURSIVE_REWRITE(matches_one_of((x + c1) + y, x + (c1 + y), x + (y + c1)),
+                                (x + y) + c1);
+    }
+    if (IsAnyInstance<MinNode, MaxNode>(op->b)) {
+      TVM_TRY_RECURSIVE_REWRITE(x + max(y, z), max(y, z) + x);
+      TVM_TRY_RECURSIVE_REWRITE(x + min(y, z), min(y, z) + x);
+    }
 
-    // DivMod rules
-    // truc div
-    TVM_TRY_RECURSIVE_REWRITE(truncmod(y, c1) + x * c1, x * c1 + truncmod(y, c1));
-    // floor div
-    TVM_TRY_RECURSIVE_REWRITE(floormod(y, c1) + x * c1, x * c1 + floormod(y, c1));
+    if (has_divmod_operand) {
+      // DivMod rules
+      // truc div
+      TVM_TRY_RECURSIVE_REWRITE(truncmod(y, c1) + x * c1, x * c1 + truncmod(y, c1));
+      // floor div
+      TVM_TRY_RECURSIVE_REWRITE(floormod(y, c1) + x * c1, x * c1 + floormod(y, c1));
+    }
   }
 
   // condition rules.
-  TVM_TRY_REWRITE(select(x, b1, b2) + select(x, s1, s2), select(x, b1 + s1, b2 + s2));
+  if (IsAnyInstance<SelectNode>(op->a) && IsAnyInstance<SelectNode>(op->b)) {
+    TVM_TRY_REWRITE(select(x, b1, b2) + select(x, s1, s2), select(x, b1 + s1, b2 + s2));
+  }
   // default value
   return ret;
 }
@@ -2489,6 +2533,23 @@ RewriteSimplifier::Extension RewriteSimplifier::GetEnabledExtensions() const {
 
 ffi::ObjectRef RewriteSimplifier::GetStatsCounters() const { return impl_->GetStatsCounters(); }
 
+ffi::Map<ffi::String, ffi::Map<ffi::String, int64_t>> RewriteSimplifier::Impl::GetRuleHitCounters()
+    const {
+  ffi::Map<ffi::String, ffi::Map<ffi::String, int64_t>> result;
+  for (const auto& [type_index, counters] : rule_hits_) {
+    ffi::Map<ffi::String, int64_t> entry;
+    entry.Set("attempted", counters.attempted);
+    entry.Set("performed", counters.performed);
+    result.Set(counters.name, entry);
+  }
+  return result;
+}
+
+ffi::Map<ffi::String, ffi::Map<ffi::String, int64_t>> RewriteSimplifier::GetRuleHitCounters()
+    const {
+  return impl_->GetRuleHitCounters();
+}
+
 void RewriteSimplifier::ResetStatsCounters() { impl_->ResetStatsCounters(); }
 
 void RewriteSimplifier::SetMaximumRewriteSteps(int64_t maximum) {
@@ -131,7 +131,14 @@ class RewriteSimplifier::Impl : public IRMutatorWithAnalyzer {
 
   RewriteSimplifierStats GetStatsCounters() const { return RewriteSimplifierStats(stats_); }
 
-  void ResetStatsCounters() { stats_ = {}; }
+  ffi::Map<ffi::String, ffi::Map<ffi::String, int64_t>> GetRuleHitCounters() const;
+
+  void ResetStatsCounters() {
+    stats_ = {};
+    rule_hits_.clear();
+    cached_category_index_ = -1;
+    cached_category_ = nullptr;
+  }
 
   void SetMaximumRewriteSteps(int64_t maximum) { maximum_rewrite_steps_ = maximum; }
 
@@ -146,9 +153,38 @@ class RewriteSimplifier::Impl : public IRMutatorWithAnalyzer {
   int64_t maximum_rewrite_steps_{0};
   RewriteSimplifierStatsNode stats_;
 
-  void RecordAttemptedRewrite() { stats_.rewrites_attempted++; }
-  void RecordRewrite() {
+  /*! \brief Counters for one rule category (rules grouped by root node kind). */
+  struct RuleCategoryCounters {
+    ffi::String name;
+    int64_t attempted{0};
+    int64_t performed{0};
+  };
+  std::unordered_map<int32_t, RuleCategoryCounters> rule_hits_;
+  // Rule groups try many patterns against the same root node in a row,
+  // so cache the last category to avoid a hash lookup per attempt.
+  int32_t cached_category_index_{-1};
+  RuleCategoryCounters* cached_category_{nullptr};
+
+  RuleCategoryCounters* GetCategoryCounters(const PrimExpr& expr) {
+    int32_t type_index = expr->type_index();
+    if (type_index != cached_category_index_) {
+      auto [it, inserted] = rule_hits_.try_emplace(type_index);
+      if (inserted) {
+        it->second.name = expr->GetTypeKey();
+      }
+      cached_category_ = &it->second;
+      cached_category_index_ = type_index;
+    }
+    return cached_category_;
+  }
+
+  void RecordAttemptedRewrite(const PrimExpr& expr) {
+    stats_.rewrites_attempted++;
+    GetCategoryCounters(expr)->attempted++;
+  }
+  void RecordRewrite(const PrimExpr& expr) {
     stats_.rewrites_performed++;
+    GetCategoryCounters(expr)->performed++;
 
     TVM_FFI_ICHECK(maximum_rewrite_steps_ <= 0 ||
                    stats_.rewrites_performed <= maximum_rewrite_steps_)
@@ -87,6 +87,8 @@ class TransitiveComparisonAnalyzer::Impl {
     prev_bindings_ = other.prev_bindings_;
     knowns_ = other.knowns_;
     scoped_knowns_ = other.scoped_knowns_;
+    edges_by_key_ = other.edges_by_key_;
+    scoped_edges_by_key_ = other.scoped_edges_by_key_;
   }
 
  private:
@@ -205,8 +207,50 @@ class TransitiveComparisonAnalyzer::Impl {
    *
    * \param vec The vector to which the Comparison objects should be
    * appended.
+   *
+   * \param index The adjacency index to be updated alongside `vec`,
+   * either `edges_by_key_` or `scoped_edges_by_key_`.
+   */
+  void AddKnown(const PrimExpr& expr, std::vector<Comparison>* vec,
+                std::unordered_map<Key, std::vector<Comparison>>* index);
+
+  /*! \brief Record a comparison in an adjacency index
+   *
+   * The comparison is appended to the per-key list of both of its
+   * endpoints, so that a later lookup by either endpoint will find it.
+   */
+  static void IndexKnown(const Comparison& cmp,
+                         std::unordered_map<Key, std::vector<Comparison>>* index);
+
+  /*! \brief Remove the most recently indexed copy of a comparison
+   *
+   * Used when rolling back a constraint scope.  Because constraint
+   * scopes are exited in LIFO order, and only `EnterConstraint`
+   * modifies the scoped index, the entries belonging to the scope
+   * being exited are at the back of each per-key list.
    */
-  void AddKnown(const PrimExpr& expr, std::vector<Comparison>* vec);
+  static void RemoveIndexedKnown(const Comparison& cmp,
+                                 std::unordered_map<Key, std::vector<Comparison>>* index);
+
+  /*! \brief Rebuild `edges_by_key_` from `knowns_`
+   *
+   * Used after entries are erased from `knowns_` when a variable is
+   * re-bound with `allow_override`.  Rebinding is rare, so rebuilding
+   * the index is preferred over tracking which entries were dropped.
+   */
+  void RebuildUnscopedIndex();
+
+  /*! \brief Visit every known comparison that involves `key`
+   *
+   * Looks up `key` in both adjacency indices, visiting each
+   * comparison whose LHS or RHS is `key`.  This is the lookup that
+   * replaces a linear scan of `knowns_` and `scoped_knowns_`,
+   * reducing each step of the transitive search from a cost
+   * proportional to the total number of known comparisons to one
+   * proportional to the number involving `key`.
+   */
+  template <typename FVisit>
+  void ForEachComparison(Key key, FVisit visit) const;
 
   /*! Collect known comparisons between LHS and RHS, without propagation
    *
@@ -302,6 +346,24 @@ class TransitiveComparisonAnalyzer::Impl {
    * the condition may no longer be true.
    */
   std::vector<Comparison> scoped_knowns_;
+
+  /*! \brief Adjacency index over `knowns_`, keyed by endpoint
+   *
+   * Each comparison appears in the list of both its LHS and its RHS
+   * key.  Maintained incrementally as knowns are added, so that the
+   * transitive search can expand a node by looking up only the
+   * comparisons involving that node.
+   */
+  std::unordered_map<Key, std::vector<Comparison>> edges_by_key_;
+
+  /*! \brief Adjacency index over `scoped_knowns_`, keyed by endpoint
+   *
+   * Kept separate from `edges_by_key_` so that exiting a constraint
+   * scope can roll back its delta by popping from the back of the
+   * per-key lists, without disturbing entries added by `Bind` while
+   * the scope was active.
+   */
+  std::unordered_map<Key, std::vector<Comparison>> scoped_edges_by_key_;
 };
 
 namespace {
@@ -555,17 +617,64 @@ std::function<void()> TransitiveComparisonAnalyzer::EnterConstraint(const PrimEx
   return impl_->EnterConstraint(constraint);
 }
 
-void TransitiveComparisonAnalyzer::Impl::AddKnown(const PrimExpr& expr,
-                                                  std::vector<Comparison>* vec) {
+void TransitiveComparisonAnalyzer::Impl::AddKnown(
+    const PrimExpr& expr, std::vector<Comparison>* vec,
+    std::unordered_map<Key, std::vector<Comparison>>* index) {
   for (const auto& subexpr : ExtractConstraints(expr, false)) {
     if (tirx::SideEffect(expr) <= tirx::CallEffectKind::kPure) {
       if (auto cmp = FromExpr(subexpr)) {
         vec->push_back(cmp.value());
+        IndexKnown(cmp.value(), index);
       }
     }
   }
 }
 
+void TransitiveComparisonAnalyzer::Impl::IndexKnown(
+    const Comparison& cmp, std::unordered_map<Key, std::vector<Comparison>>* index) {
+  (*index)[cmp.lhs_].push_back(cmp);
+  if (cmp.rhs_ != cmp.lhs_) {
+    (*index)[cmp.rhs_].push_back(cmp);
+  }
+}
+
+void TransitiveComparisonAnalyzer::Impl::RemoveIndexedKnown(
+    const Comparison& cmp, std::unordered_map<Key, std::vector<Comparison>>* index) {
+  auto pop_back = [&](Key key) {
+    auto it = index->find(key);
+    TVM_FFI_ICHECK(it != index->end() && !it->second.empty());
+    TVM_FFI_ICHECK(it->second.back().lhs_ == cmp.lhs_ && it->second.back().rhs_ == cmp.rhs_);
+    it->second.pop_back();
+    if (it->second.empty()) {
+      index->erase(it);
+    }
+  };
+  pop_back(cmp.lhs_);
+  if (cmp.rhs_ != cmp.lhs_) {
+    pop_back(cmp.rhs_);
+  }
+}
+
+void TransitiveComparisonAnalyzer::Impl::RebuildUnscopedIndex() {
+  edges_by_key_.clear();
+  for (const auto& known : knowns_) {
+    IndexKnown(known, &edges_by_key_);
+  }
+}
+
+template <typename FVisit>
+void TransitiveComparisonAnalyzer::Impl::ForEachComparison(Key key, FVisit visit) const {
+  auto visit_index = [&](const std::unordered_map<Key, std::vector<Comparison>>& index) {
+    if (auto it = index.find(key); it != index.end()) {
+      for (const Comparison& cmp : it->second) {
+        visit(cmp);
+      }
+    }
+  };
+  visit_index(edges_by_key_);
+  visit_index(scoped_edges_by_key_);
+}
+
 void TransitiveComparisonAnalyzer::Impl::Bind(const tirx::Var& var, const Range& range,
                                               bool allow_override) {
   auto it = prev_bindings_.find(var);
@@ -580,6 +689,7 @@ void TransitiveComparisonAnalyzer::Impl::Bind(const tirx::Var& var, const Range&
         knowns_.erase(std::remove_if(knowns_.begin(), knowns_.end(),
                                      [&](const auto& known) { return known.lhs_ == key.value(); }),
                       knowns_.end());
+        RebuildUnscopedIndex();
       }
     }
   }
@@ -587,10 +697,10 @@ void TransitiveComparisonAnalyzer::Impl::Bind(const tirx::Var& var, const Range&
   prev_bindings_.Set(var, range);
 
   if (is_const_int(range->extent, 1)) {
-    AddKnown(var == range->min, &knowns_);
+    AddKnown(var == range->min, &knowns_, &edges_by_key_);
   } else {
-    AddKnown(var >= range->min, &knowns_);
-    AddKnown(var < range->min + range->extent, &knowns_);
+    AddKnown(var >= range->min, &knowns_, &edges_by_key_);
+    AddKnown(var < range->min + range->extent, &knowns_, &edges_by_key_);
   }
 }
 
@@ -601,11 +711,16 @@ void TransitiveComparisonAnalyzer::Impl::Bind(const tirx::Var& var, const PrimEx
 
 std::function<void()> TransitiveComparisonAnalyzer::Impl::EnterConstraint(const PrimExpr& expr) {
   size_t old_literal_size = scoped_knowns_.size();
-  AddKnown(expr, &scoped_knowns_);
+  AddKnown(expr, &scoped_knowns_, &scoped_edges_by_key_);
   size_t new_literal_size = scoped_knowns_.size();
 
   auto frecover = [old_literal_size, new_literal_size, this]() {
     TVM_FFI_ICHECK_EQ(scoped_knowns_.size(), new_literal_size);
+    // Scopes are exited in LIFO order, so this scope's entries are at
+    // the back of each per-key list in the scoped adjacency index.
+    for (size_t i = new_literal_size; i > old_literal_size; i--) {
+      RemoveIndexedKnown(scoped_knowns_[i - 1], &scoped_edges_by_key_);
+    }
     scoped_knowns_.erase(scoped_knowns_.begin() + old_literal_size, scoped_knowns_.end());
   };
   return frecover;
@@ -664,12 +779,7 @@ TransitiveComparisonAnalyzer::Impl::CollectDirectComparisons(Key lhs_key, Key rh
     }
   };
 
-  for (const auto& known : knowns_) {
-    append_known(known);
-  }
-  for (const auto& known : scoped_knowns_) {
-    append_known(known);
-  }
+  ForEachComparison(lhs_key, append_known);
 
   return output;
 }
@@ -726,16 +836,11 @@ TransitiveComparisonAnalyzer::Impl::DFSFromLHS(Key lhs_key, Key rhs_key) const {
 
   // Initialize the search based on any known (in)equalities that use
   // the LHS of the comparison.
-  for (const auto& known : knowns_) {
+  ForEachComparison(lhs_key, [&](const Comparison& known) {
     if (auto normalized = known.WithLHS(lhs_key)) {
       declare_known(normalized.value());
     }
-  }
-  for (const auto& known : scoped_knowns_) {
-    if (auto normalized = known.WithLHS(lhs_key)) {
-      declare_known(normalized.value());
-    }
-  }
+  });
 
   // Walk through the space of all comparisons that can be made with
   // LHS.
@@ -799,17 +904,14 @@ TransitiveComparisonAnalyzer::Impl::DFSFromLHS(Key lhs_key, Key rhs_key) const {
     // we must first combine `a<=b` and `b<=c` into `a<=c`.  During
     // this first step, `b` is the "middle" and `c` is the "right".
     // The next step can then combind `a<=c` and `c<=d` into `a<=d`.
-    for (const auto& known : knowns_) {
-      if (auto cmp = known.WithLHS(middle_key)) {
-        attempt_transitive(cmp.value());
-      }
-    }
-
-    for (const auto& known : scoped_knowns_) {
+    //
+    // Only the comparisons involving `middle_key` need to be
+    // considered, which the adjacency index provides directly.
+    ForEachComparison(middle_key, [&](const Comparison& known) {
       if (auto cmp = known.WithLHS(middle_key)) {
         attempt_transitive(cmp.value());
       }
-    }
+    });
 
     // Collect together all new knowns, marking new nodes for visiting
     // as needed.
@@ -243,23 +243,56 @@ class Z3Prover::Impl : ExprFunctor<z3::expr(const PrimExpr&)> {
     return false;
   }
 
+  /// @brief Per-query counters, see Z3Prover::GetQueryCounters.
+  struct QueryCounters {
+    int64_t queries{0};
+    int64_t proved{0};
+    int64_t unknown{0};
+    int64_t skipped{0};
+  };
+  QueryCounters counters_;
+
   /// @brief Check if the expression can be proved
   bool CanProve(const PrimExpr& expr) {
     // Z3 is only a fallback. Any failure (including z3::exception thrown by the
     // solver) must degrade to "cannot prove" instead of escaping to the caller.
     try {
-      if (CheckTrivilBadCases(expr)) return false;
-      if (!IsZ3SupportedExpr(expr.get())) return false;
+      if (CheckTrivilBadCases(expr) || !IsZ3SupportedExpr(expr.get())) {
+        counters_.skipped++;
+        return false;
+      }
+      counters_.queries++;
       z3::expr_vector constr(*ctx);
       constr.push_back(!ConvertBool(expr));
       auto result = solver.check(constr);
       constr.pop_back();
-      return result == z3::unsat;
+      if (result == z3::unsat) {
+        counters_.proved++;
+        return true;
+      }
+      if (result == z3::unknown) {
+        // the time/rlimit budget ran out before a verdict; the caller falls
+        // back to interval reasoning
+        counters_.unknown++;
+      }
+      return false;
     } catch (const z3::exception&) {
+      counters_.unknown++;
       return false;
     }
   }
 
+  ffi::Map<ffi::String, int64_t> GetQueryCounters() const {
+    ffi::Map<ffi::String, int64_t> result;
+    result.Set("queries", counters_.queries);
+    result.Set("proved", counters_.proved);
+    result.Set("unknown", counters_.unknown);
+    result.Set("skipped", counters_.skipped);
+    return result;
+  }
+
+  void ResetQueryCounters() { counters_ = QueryCounters(); }
+
   /// @brief Binded
   /// @brief Bind a variable to a value or a range
   void Bind(const Var& var, const PrimExpr& value, bool allow_override = false) {
@@ -815,6 +848,10 @@ void Z3Prover::SetTimeoutMs(unsigned timeout_ms) { impl_->SetTimeoutMs(timeout_m
 void Z3Prover::SetRLimit(unsigned max_step) { impl_->SetRLimit(max_step); }
 void Z3Prover::CopyFrom(const Z3Prover& other) { impl_->CopyFrom(*other.impl_); }
 ffi::String Z3Prover::GetStats() { return impl_->GetStats(); }
+ffi::Map<ffi::String, int64_t> Z3Prover::GetQueryCounters() const {
+  return impl_->GetQueryCounters();
+}
+void Z3Prover::ResetQueryCounters() { impl_->ResetQueryCounters(); }
 ffi::String Z3Prover::GetModel(const PrimExpr& expr) { return impl_->GetModel(expr); }
 TVM_DLL int64_t Z3Prover::CountSatisfyingValues(const Var& var, int64_t max_count,
                                                 int64_t min_consecutive) {
@@ -863,6 +900,10 @@ TVM_DLL int64_t Z3Prover::CountSatisfyingValues(const Var& var, int64_t max_coun
 
 void Z3Prover::CopyFrom(const Z3Prover& other) {}
 ffi::String Z3Prover::GetStats() { return "; Z3 Prover is disabled."; }
+ffi::Map<ffi::String, int64_t> Z3Prover::GetQueryCounters() const {
+  return ffi::Map<ffi::String, int64_t>();
+}
+void Z3Prover::ResetQueryCounters() {}
 Z3Prover::Z3Prover(AnalyzerObj*) : impl_(nullptr) {}
 TVM_DLL Z3Prover::~Z3Prover() {}
 
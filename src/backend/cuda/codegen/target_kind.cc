@@ -38,17 +38,20 @@ namespace backend {
 namespace cuda {
 
 bool DetectDeviceFlag(Device device, runtime::DeviceAttrKind flag, ffi::Any* val) {
-  using runtime::DeviceAPI;
-  DeviceAPI* api = DeviceAPI::Get(device, true);
-  if (api == nullptr) {
+  const runtime::DeviceCapability& cap = runtime::GetDeviceCapability(device);
+  if (!cap.exist) {
     return false;
   }
-  api->GetAttr(device, runtime::kExist, val);
-  int exists = val->cast<int>();
-  if (!exists) {
-    return false;
+  // Serve snapshot-backed attributes from the cache; targets are constructed
+  // repeatedly during tuning and each live query is a driver round trip.
+  if (flag == runtime::kComputeVersion) {
+    if (cap.compute_version.empty()) {
+      return false;
+    }
+    *val = ffi::String(cap.compute_version);
+    return true;
   }
-  DeviceAPI::Get(device)->GetAttr(device, flag, val);
+  runtime::DeviceAPI::Get(device)->GetAttr(device, flag, val);
   return true;
 }
 
@@ -122,6 +125,10 @@ void RegisterTargetKinds() {
       .add_attr_option<int64_t>("thread_warp_size", refl::DefaultValue(32))
       .add_attr_option<int64_t>("registers_per_block")
       .add_attr_option<int64_t>("l2_cache_size_bytes")
+      // Cap the grid size of split-out kernels; kernels whose grid
+      // exceeds the cap are rewritten into a persistent grid-stride
+      // loop by SplitHostDevice.
+      .add_attr_option<int64_t>("max_persistent_blocks")
       .add_attr_option<int64_t>("max_num_threads",
                                 refl::DefaultValue(1024))  // TODO(@zxybazh): deprecate it
       .set_default_keys({"cuda", "gpu"})
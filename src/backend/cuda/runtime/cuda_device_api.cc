@@ -31,9 +31,11 @@
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/timer.h>
 
+#include <algorithm>
 #include <cstring>
 
 #include "../../../runtime/workspace_pool.h"
+#include "../../../support/env.h"
 
 namespace tvm {
 namespace runtime {
@@ -204,6 +206,37 @@ class CUDADeviceAPI final : public DeviceAPI {
     }
   }
 
+  void* AllocDataSpaceAsync(Device dev, size_t nbytes, size_t alignment, DLDataType type_hint,
+                            TVMStreamHandle stream) final {
+#if CUDART_VERSION >= 11020
+    if (dev.device_type == kDLCUDA) {
+      TVM_FFI_ICHECK_EQ(256 % alignment, 0U) << "CUDA space is aligned at 256 bytes";
+      TVM_FFI_CHECK_CUDA_ERROR(cudaSetDevice(dev.device_id));
+      void* ret;
+      VLOG(1) << "allocating " << nbytes << " bytes stream-ordered on device";
+      TVM_FFI_CHECK_CUDA_ERROR(cudaMallocAsync(&ret, nbytes, static_cast<cudaStream_t>(stream)));
+      return ret;
+    }
+#endif
+    return AllocDataSpace(dev, nbytes, alignment, type_hint);
+  }
+
+  void FreeDataSpaceAsync(Device dev, void* ptr, TVMStreamHandle stream) final {
+#if CUDART_VERSION >= 11020
+    if (dev.device_type == kDLCUDA) {
+      if (std::uncaught_exceptions() && cudaPeekAtLastError() == cudaErrorIllegalAddress) {
+        // see the comment in FreeDataSpace on sticky driver errors.
+        return;
+      }
+      TVM_FFI_CHECK_CUDA_ERROR(cudaSetDevice(dev.device_id));
+      VLOG(1) << "freeing device memory stream-ordered";
+      TVM_FFI_CHECK_CUDA_ERROR(cudaFreeAsync(ptr, static_cast<cudaStream_t>(stream)));
+      return;
+    }
+#endif
+    FreeDataSpace(dev, ptr);
+  }
+
  protected:
   void CopyDataFromTo(const void* from, size_t from_offset, void* to, size_t to_offset, size_t size,
                       Device dev_from, Device dev_to, DLDataType type_hint,
@@ -238,7 +271,12 @@ class CUDADeviceAPI final : public DeviceAPI {
       GPUCopy(from, to, size, cudaMemcpyDeviceToHost, cu_stream);
     } else if (dev_from.device_type == kDLCPU && dev_to.device_type == kDLCUDA) {
       TVM_FFI_CHECK_CUDA_ERROR(cudaSetDevice(dev_to.device_id));
-      GPUCopy(from, to, size, cudaMemcpyHostToDevice, cu_stream);
+      size_t staging_min_bytes = PinnedStagingMinBytes();
+      if (staging_min_bytes != 0 && size >= staging_min_bytes && !IsPinnedHostPtr(from)) {
+        CopyPageableToDeviceStaged(from, to, size, cu_stream);
+      } else {
+        GPUCopy(from, to, size, cudaMemcpyHostToDevice, cu_stream);
+      }
     } else {
       TVM_FFI_THROW(InternalError) << "expect copy from/to GPU or between GPU";
     }
@@ -293,11 +331,77 @@ class CUDADeviceAPI final : public DeviceAPI {
 
  private:
   static WorkspacePool* ThreadLocalWorkspacePool();
+  static WorkspacePool* ThreadLocalPinnedStagingPool();
 
   static void GPUCopy(const void* from, void* to, size_t size, cudaMemcpyKind kind,
                       cudaStream_t stream) {
     TVM_FFI_CHECK_CUDA_ERROR(cudaMemcpyAsync(to, from, size, kind, stream));
   }
+
+  /*! \brief Size of each pinned staging chunk used for pageable H2D copies. */
+  static constexpr size_t kPinnedStagingChunkBytes = size_t{4} << 20;
+
+  // Pageable copies below this size go straight to the driver; bouncing them
+  // through pinned staging only pays off for bulk transfers. Returns 0 when
+  // staging is disabled via TVM_CUDA_PINNED_STAGING_MIN_BYTES=0.
+  static size_t PinnedStagingMinBytes() {
+    static size_t min_bytes = static_cast<size_t>(std::max<int64_t>(
+        support::GetEnv<int64_t>("TVM_CUDA_PINNED_STAGING_MIN_BYTES", int64_t{1} << 20), 0));
+    return min_bytes;
+  }
+
+  static bool IsPinnedHostPtr(const void* ptr) {
+    cudaPointerAttributes attrs;
+    if (cudaPointerGetAttributes(&attrs, ptr) != cudaSuccess) {
+      // Querying a plain malloc pointer can fail on older drivers; clear the
+      // sticky error and treat the memory as pageable.
+      cudaGetLastError();
+      return false;
+    }
+    return attrs.type != cudaMemoryTypeUnregistered;
+  }
+
+  // Copy pageable host memory to the device through pinned staging chunks.
+  // The driver stages such copies through a small internal buffer; using our
+  // own pinned chunks and double buffering lets the host memcpy into one
+  // chunk overlap the DMA out of the other, which roughly doubles the
+  // effective bandwidth for bulk transfers. The copy is synchronous with
+  // respect to the host, matching what cudaMemcpyAsync already guarantees
+  // for pageable sources.
+  void CopyPageableToDeviceStaged(const void* from, void* to, size_t size, cudaStream_t stream) {
+    Device host_dev{kDLCUDAHost, 0};
+    WorkspacePool* pool = ThreadLocalPinnedStagingPool();
+    void* staging[2];
+    staging[0] = pool->AllocWorkspace(host_dev, kPinnedStagingChunkBytes);
+    staging[1] = pool->AllocWorkspace(host_dev, kPinnedStagingChunkBytes);
+    cudaEvent_t done[2];
+    TVM_FFI_CHECK_CUDA_ERROR(cudaEventCreateWithFlags(&done[0], cudaEventDisableTiming));
+    TVM_FFI_CHECK_CUDA_ERROR(cudaEventCreateWithFlags(&done[1], cudaEventDisableTiming));
+    bool in_flight[2] = {false, false};
+    size_t offset = 0;
+    int buf = 0;
+    while (offset < size) {
+      size_t chunk = std::min(size - offset, kPinnedStagingChunkBytes);
+      if (in_flight[buf]) {
+        TVM_FFI_CHECK_CUDA_ERROR(cudaEventSynchronize(done[buf]));
+      }
+      memcpy(staging[buf], static_cast<const char*>(from) + offset, chunk);
+      TVM_FFI_CHECK_CUDA_ERROR(cudaMemcpyAsync(static_cast<char*>(to) + offset, staging[buf],
+                                               chunk, cudaMemcpyHostToDevice, stream));
+      TVM_FFI_CHECK_CUDA_ERROR(cudaEventRecord(done[buf], stream));
+      in_flight[buf] = true;
+      offset += chunk;
+      buf ^= 1;
+    }
+    // The chunks must not be recycled while a DMA out of them is pending.
+    for (int i = 1; i >= 0; --i) {
+      if (in_flight[i]) {
+        TVM_FFI_CHECK_CUDA_ERROR(cudaEventSynchronize(done[i]));
+      }
+      TVM_FFI_CHECK_CUDA_ERROR(cudaEventDestroy(done[i]));
+      pool->FreeWorkspace(host_dev, staging[i]);
+    }
+  }
 };
 
 WorkspacePool* CUDADeviceAPI::ThreadLocalWorkspacePool() {
@@ -305,6 +409,11 @@ WorkspacePool* CUDADeviceAPI::ThreadLocalWorkspacePool() {
   return &pool;
 }
 
+WorkspacePool* CUDADeviceAPI::ThreadLocalPinnedStagingPool() {
+  static thread_local WorkspacePool pool(kDLCUDAHost, CUDADeviceAPI::Global());
+  return &pool;
+}
+
 TVM_FFI_STATIC_INIT_BLOCK() {
   namespace refl = tvm::ffi::reflection;
   refl::GlobalDef()
@@ -328,7 +328,10 @@ ffi::Optional<ffi::Function> CUDAModuleNode::GetFunction(const ffi::String& name
   FunctionInfo info = opt_info.value();
   CUDAWrappedFunc f;
   f.Init(this, sptr_to_self, name, info->arg_types.size(), info->launch_param_tags);
-  return PackFuncVoidAddr(f, info->arg_types, info->arg_extra_tags);
+  // Kernel launches re-pack an argument buffer that is byte-identical from
+  // call to call in fixed-shape serving; the caching wrapper reuses it and
+  // rebuilds only when an argument (e.g. a shape after rebinding) changes.
+  return PackFuncVoidAddrCached(f, info->arg_types, info->arg_extra_tags);
 }
 
 // Construct a CUDAModuleNode from in-memory payload.  When fmt == "cuda" the
@@ -60,20 +60,14 @@ namespace codegen {
 
 namespace {
 
-// calls the device api to get the max threads per block
+// reads the max threads per block from the cached device capability snapshot
 static inline int DetectROCMmaxThreadsPerBlock() {
   Device tvm_dev;
   tvm_dev.device_type = kDLROCM;
   tvm_dev.device_id = 0;
-  tvm::runtime::DeviceAPI* api = tvm::runtime::DeviceAPI::Get(tvm_dev, true);
-  if (api != nullptr) {
-    ffi::Any val;
-    api->GetAttr(tvm_dev, tvm::runtime::kExist, &val);
-    if (val.cast<int>() == 1) {
-      tvm::runtime::DeviceAPI::Get(tvm_dev)->GetAttr(tvm_dev, tvm::runtime::kMaxThreadsPerBlock,
-                                                     &val);
-      return val.cast<int>();
-    }
+  const tvm::runtime::DeviceCapability& cap = tvm::runtime::GetDeviceCapability(tvm_dev);
+  if (cap.exist && cap.max_threads_per_block > 0) {
+    return cap.max_threads_per_block;
   }
   LOG(WARNING) << "Cannot get maximum number of threads for AMD codegen";
   return 256;  // see the discussion at PR #4342 for the choice of default
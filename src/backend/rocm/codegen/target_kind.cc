@@ -48,17 +48,17 @@ std::string ExtractStringWithPrefix(const std::string& str, const std::string& p
 }
 
 bool DetectDeviceFlag(Device device, runtime::DeviceAttrKind flag, ffi::Any* val) {
-  using runtime::DeviceAPI;
-  DeviceAPI* api = DeviceAPI::Get(device, true);
-  if (api == nullptr) {
+  const runtime::DeviceCapability& cap = runtime::GetDeviceCapability(device);
+  if (!cap.exist) {
     return false;
   }
-  api->GetAttr(device, runtime::kExist, val);
-  int exists = val->cast<int>();
-  if (!exists) {
-    return false;
+  // Serve snapshot-backed attributes from the cache; targets are constructed
+  // repeatedly during tuning and each live query is a driver round trip.
+  if (flag == runtime::kApiVersion) {
+    *val = static_cast<int64_t>(cap.api_version);
+    return true;
   }
-  DeviceAPI::Get(device)->GetAttr(device, flag, val);
+  runtime::DeviceAPI::Get(device)->GetAttr(device, flag, val);
   return true;
 }
 
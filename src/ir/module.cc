@@ -34,8 +34,12 @@
 
 #include <algorithm>
 #include <fstream>
+#include <optional>
 #include <sstream>
+#include <string>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
 
 namespace tvm {
 
@@ -203,6 +207,76 @@ IRModule IRModuleNode::ShallowCopy() {
   return IRModule(this->functions, this->source_map, this->attrs, this->global_infos);
 }
 
+IRModuleBatchUpdater::IRModuleBatchUpdater(IRModule mod) : mod_(std::move(mod)) {
+  // Build the name index once; staged operations keep it current so that
+  // per-call lookups never have to consult the module again.
+  name_index_.reserve(mod_->global_var_map_.size());
+  for (const auto& [name, gvar] : mod_->global_var_map_) {
+    name_index_.emplace(std::string(name), gvar);
+  }
+}
+
+void IRModuleBatchUpdater::Update(const GlobalVar& var, BaseFunc func) {
+  auto it = name_index_.find(std::string(var->name_hint));
+  if (it != name_index_.end()) {
+    TVM_FFI_ICHECK_EQ(it->second, var) << "Duplicate global function name " << var;
+  } else {
+    name_index_.emplace(std::string(var->name_hint), var);
+  }
+  removed_.erase(var);
+  updates_[var] = std::move(func);
+}
+
+void IRModuleBatchUpdater::Remove(const GlobalVar& var) {
+  updates_.erase(var);
+  removed_.insert(var);
+  auto it = name_index_.find(std::string(var->name_hint));
+  if (it != name_index_.end() && it->second.same_as(var)) {
+    name_index_.erase(it);
+  }
+}
+
+std::optional<GlobalVar> IRModuleBatchUpdater::GetGlobalVar(const ffi::String& name) const {
+  auto it = name_index_.find(std::string(name));
+  if (it == name_index_.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+void IRModuleBatchUpdater::Commit() {
+  if (updates_.empty() && removed_.empty()) {
+    return;
+  }
+  // Rebuild both maps in one pass over the module. The fresh maps are
+  // uniquely owned, so every Set below mutates in place — the per-call
+  // copy-on-write of the eager Update/Remove path is paid exactly once.
+  ffi::Map<GlobalVar, BaseFunc> functions;
+  ffi::Map<ffi::String, GlobalVar> global_var_map;
+  for (const auto& [gvar, func] : mod_->functions) {
+    if (removed_.count(gvar)) {
+      continue;
+    }
+    auto it = updates_.find(gvar);
+    functions.Set(gvar, it != updates_.end() ? it->second : func);
+    global_var_map.Set(gvar->name_hint, gvar);
+  }
+  // Staged additions: updates whose var is not already in the module.
+  for (const auto& [gvar, func] : updates_) {
+    if (mod_->functions.count(gvar)) {
+      continue;
+    }
+    TVM_FFI_ICHECK(global_var_map.count(gvar->name_hint) == 0)
+        << "Duplicate global function name " << gvar;
+    functions.Set(gvar, func);
+    global_var_map.Set(gvar->name_hint, gvar);
+  }
+  mod_->functions = std::move(functions);
+  mod_->global_var_map_ = std::move(global_var_map);
+  updates_.clear();
+  removed_.clear();
+}
+
 IRModule IRModule::FromExpr(const Expr& expr,
                             const tvm::ffi::Map<GlobalVar, BaseFunc>& global_funcs) {
   auto mod = IRModule(global_funcs);
@@ -31,6 +31,22 @@
 
 namespace tvm {
 
+TVM_REGISTER_PASS_CONFIG_OPTION("ir.enable_span_tracking", bool);
+
+/*!
+ * \brief Whether frontends should record spans and source content.
+ *
+ * Spans only pay off when a diagnostic is rendered, yet they are created for
+ * every node a frontend ingests and carried through every transform.
+ * Production compiles can set "ir.enable_span_tracking" to false to elide
+ * span and source construction at the frontend entry points.
+ */
+static bool SpanTrackingEnabled() {
+  return transform::PassContext::Current()
+      ->GetConfig<bool>("ir.enable_span_tracking", true)
+      .value();
+}
+
 TVM_FFI_STATIC_INIT_BLOCK() {
   namespace refl = tvm::ffi::reflection;
   SourceNameNode::RegisterReflection();
@@ -151,6 +167,11 @@ TVM_FFI_STATIC_INIT_BLOCK() {
   refl::GlobalDef()
       .def("ir.Span",
            [](SourceName source_name, int line, int end_line, int column, int end_column) {
+             // Frontends create a span per parsed node; with tracking
+             // disabled they all collapse to the empty span.
+             if (!SpanTrackingEnabled()) {
+               return Span();
+             }
              return Span(source_name, line, end_line, column, end_column);
            })
       .def("ir.SequentialSpan", [](tvm::ffi::Array<Span> spans) { return SequentialSpan(spans); });
@@ -188,7 +209,14 @@ Source::Source(SourceName src_name, std::string source) {
   auto n = ffi::make_object<SourceNode>();
   n->source_name = std::move(src_name);
   n->source = std::move(source);
+  // The line map is built lazily on first GetLine: most compiles never
+  // render a diagnostic, and eagerly scanning every ingested source is a
+  // measurable slice of frontend time on large modules.
+  data_ = n;
+}
 
+/*! \brief Build the line index of a source on demand. */
+static void BuildLineMap(SourceNode* n) {
   int index = 0;
   int length = 0;
   n->line_map.push_back({index, length});
@@ -210,12 +238,14 @@ Source::Source(SourceName src_name, std::string source) {
     }
   }
   n->line_map.back().second = length;
-
-  data_ = n;
 }
 
 tvm::ffi::String Source::GetLine(int line) {
   VLOG(1) << "Source::GetLine: line=" << line;
+  SourceNode* node = const_cast<SourceNode*>(this->operator->());
+  if (node->line_map.empty()) {
+    BuildLineMap(node);
+  }
   TVM_FFI_ICHECK(line - 1 < static_cast<int64_t>((*this)->line_map.size()))
       << "requested line: " << line << "at index: " << (line - 1)
       << "line_map size: " << (*this)->line_map.size() << "source: " << (*this)->source;
@@ -243,8 +273,12 @@ TVM_FFI_STATIC_INIT_BLOCK() {
   namespace refl = tvm::ffi::reflection;
   refl::GlobalDef().def("SourceMapAdd", [](SourceMap map, ffi::String name, ffi::String content) {
     auto src_name = SourceName::Get(name);
-    Source source(src_name, content);
-    map.Add(source);
+    // With span tracking disabled there is nothing that could resolve into
+    // this source, so do not retain the content either.
+    if (SpanTrackingEnabled()) {
+      Source source(src_name, content);
+      map.Add(source);
+    }
     return src_name;
   });
 }
@@ -461,12 +461,13 @@ class ModulePass : public Pass {
 };
 
 PassInfo::PassInfo(int opt_level, ffi::String name, tvm::ffi::Array<ffi::String> required,
-                   bool traceable) {
+                   bool traceable, bool function_local) {
   auto pass_info = ffi::make_object<PassInfoNode>();
   pass_info->opt_level = opt_level;
   pass_info->name = std::move(name);
   pass_info->required = std::move(required);
   pass_info->traceable = std::move(traceable);
+  pass_info->function_local = function_local;
   data_ = std::move(pass_info);
 }
 
@@ -574,7 +575,9 @@ TVM_FFI_STATIC_INIT_BLOCK() {
   refl::GlobalDef()
       .def("transform.PassInfo",
            [](int opt_level, ffi::String name, tvm::ffi::Array<ffi::String> required,
-              bool traceable) { return PassInfo(opt_level, name, required, traceable); })
+              bool traceable, bool function_local) {
+             return PassInfo(opt_level, name, required, traceable, function_local);
+           })
       .def_packed("transform.Info", [](ffi::PackedArgs args, ffi::Any* ret) {
         Pass pass = args[0].cast<Pass>();
         *ret = pass->Info();
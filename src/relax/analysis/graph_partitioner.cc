@@ -172,6 +172,7 @@ void GraphPartitioner::MergeFromTo(Group* child, Group* parent) {
   // update the number of nodes of the parent group
   parent->num_nodes += child->num_nodes;
   parent->args_num += child->args_num;
+  parent->bytes += child->bytes;
   child->parent = parent;
   // update anchor ref and pattern
   if (child->anchor_ref != nullptr) {
@@ -227,6 +228,27 @@ size_t GraphPartitioner::CountFusedNodesWithNewChild(IndexedForwardGraph::Node*
   return target->FindRoot()->num_nodes + CountNodesUptoSink_(child, dom_parent);
 }
 
+size_t GraphPartitioner::CountBytesUptoSink_(IndexedForwardGraph::Node* src,
+                                             IndexedForwardGraph::Node* sink) {
+  if (src == sink || visited_.count(src)) return 0;
+  visited_.insert(src);
+  Group* gnode = groups_[src->index];
+  TVM_FFI_ICHECK(gnode != nullptr);
+  auto sum = gnode->bytes;
+  for (auto link = src->outputs.head; link != nullptr; link = link->next) {
+    sum += CountBytesUptoSink_(link->value.node, sink);
+  }
+  return sum;
+}
+
+size_t GraphPartitioner::CountFusedBytesWithNewChild(IndexedForwardGraph::Node* child,
+                                                     IndexedForwardGraph::Node* dom_parent) {
+  Group* target = groups_[dom_parent->index];
+  visited_.clear();
+  TVM_FFI_ICHECK(child != dom_parent);
+  return target->FindRoot()->bytes + CountBytesUptoSink_(child, dom_parent);
+}
+
 size_t GraphPartitioner::CountArgs_(IndexedForwardGraph::Node* src,
                                     const IndexedForwardGraph& graph, bool update_postpone) {
   std::unordered_set<Group*> visited_groups;
@@ -287,6 +309,37 @@ size_t GraphPartitioner::CountFusedArgs(const IndexedForwardGraph& graph,
   return args_num;
 }
 
+/*!
+ * \brief Estimate the size, in bytes, of the tensor(s) an expression produces.
+ *
+ * Only statically known shapes and dtypes contribute; anything dynamic is
+ * counted as zero, which keeps the byte-based fusion limit conservative in
+ * the sense that it never refuses a fusion because of unknown sizes.
+ */
+static size_t EstimateOutputBytes(const Type& ty) {
+  if (const auto* tensor_ty = ty.as<TensorTypeNode>()) {
+    if (tensor_ty->IsUnknownDtype()) return 0;
+    auto opt_shape = tensor_ty->GetShape();
+    if (!opt_shape) return 0;
+    DLDataType dtype = tensor_ty->dtype.value()->dtype;
+    size_t num_elements = 1;
+    for (const auto& dim : opt_shape.value()) {
+      const auto* int_dim = dim.as<IntImmNode>();
+      if (!int_dim || int_dim->value < 0) return 0;
+      num_elements *= static_cast<size_t>(int_dim->value);
+    }
+    return num_elements * ((dtype.bits * dtype.lanes + 7) / 8);
+  }
+  if (const auto* tuple_ty = ty.as<TupleTypeNode>()) {
+    size_t sum = 0;
+    for (const auto& field : tuple_ty->fields) {
+      sum += EstimateOutputBytes(field);
+    }
+    return sum;
+  }
+  return 0;
+}
+
 void GraphPartitioner::InitGroups(const IndexedForwardGraph& graph) {
   auto args_counter = [](const tvm::ffi::Object* obj) {
     size_t args_num = 0;
@@ -319,6 +372,9 @@ void GraphPartitioner::InitGroups(const IndexedForwardGraph& graph) {
       group_node->anchor_ref = graph_node->ref;
     }
     group_node->args_num = args_counter(graph_node->ref);
+    if (auto expr = ffi::GetRef<ffi::ObjectRef>(graph_node->ref).as<Expr>()) {
+      group_node->bytes = EstimateOutputBytes(GetType(expr.value()));
+    }
     groups_[nid] = group_node;
   }
 }
@@ -357,6 +413,13 @@ void GraphPartitioner::RunFuse(const IndexedForwardGraph& graph,    //
     // refuse the fusion if too many ops are going to be fused together
     if (CountFusedNodesWithNewChild(graph_node, dom_node->parent->gnode) > max_fuse_depth_)
       continue;
+    // Refuse the fusion if the fused function would produce more tensor bytes
+    // than the configured budget: past that point the traffic saved by fusing
+    // is paid back in register/shared-memory pressure after lowering.
+    if (max_fused_bytes_ > 0 &&
+        CountFusedBytesWithNewChild(graph_node, dom_node->parent->gnode) > max_fused_bytes_) {
+      continue;
+    }
     // Refuse the fusion if too many arguments are going to be in the fused function
     if (max_function_args_ > 0) {
       auto limit = CountArgsLimit_(graph_node);
@@ -166,11 +166,12 @@ class DominatorTree {
 class GraphPartitioner {
  public:
   explicit GraphPartitioner(support::Arena* arena, int opt_level, size_t max_fuse_depth,
-                            size_t max_function_args)
+                            size_t max_function_args, size_t max_fused_bytes = 0)
       : arena_(arena),
         opt_level_(opt_level),
         max_fuse_depth_(max_fuse_depth),
-        max_function_args_(max_function_args) {}
+        max_function_args_(max_function_args),
+        max_fused_bytes_(max_fused_bytes) {}
   /*!
    * \brief Group as a union find data structure.
    */
@@ -194,6 +195,11 @@ class GraphPartitioner {
      * \brief The number of function arguments belonging to this group
      */
     size_t args_num{0};
+    /*!
+     * \brief Estimated bytes of the tensors produced inside this group.
+     *        Dimensions or dtypes that are not statically known contribute zero.
+     */
+    size_t bytes{0};
 
     /*! \brief Optional attributes to annotate the grouped function. */
     ffi::Map<ffi::String, Any> attrs;
@@ -218,6 +224,13 @@ class GraphPartitioner {
   size_t max_fuse_depth_;
   /*! \brief The maximum number of arguments in one fused function */
   size_t max_function_args_;
+  /*!
+   * \brief The budget, in bytes, for the tensors produced inside one fused function.
+   *        Zero disables the byte-based limit. Used to keep the memory-traffic win of
+   *        fusion from turning into register/shared-memory pressure once the grouped
+   *        function is lowered.
+   */
+  size_t max_fused_bytes_;
   /*! \brief The internal groups. */
   std::vector<Group*> groups_;
   /*! \brief internal field used for deduplication */
@@ -269,6 +282,7 @@ class GraphPartitioner {
   void CommitFuse(IndexedForwardGraph::Node* src, IndexedForwardGraph::Node* sink);
 
   size_t CountNodesUptoSink_(IndexedForwardGraph::Node* src, IndexedForwardGraph::Node* sink);
+  size_t CountBytesUptoSink_(IndexedForwardGraph::Node* src, IndexedForwardGraph::Node* sink);
   // Calculate the number of arguments for the node.
   size_t CountArgs_(IndexedForwardGraph::Node* src, const IndexedForwardGraph& graph,
                     bool update_postpone = true);
@@ -290,6 +304,10 @@ class GraphPartitioner {
   // is important for correct calculation.
   size_t CountFusedNodesWithNewChild(IndexedForwardGraph::Node* child,
                                      IndexedForwardGraph::Node* dom_parent);
+  // Estimate the bytes produced inside a fused subgraph if child is additionally
+  // fused, following the same traversal as CountFusedNodesWithNewChild.
+  size_t CountFusedBytesWithNewChild(IndexedForwardGraph::Node* child,
+                                     IndexedForwardGraph::Node* dom_parent);
   // Count the number of arguments in a fused subgraph. This function also takes into account the
   // number of the child's output node argument. It helps to stop fusing before the node when the
   // limit will be exceeded.
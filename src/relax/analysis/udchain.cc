@@ -28,12 +28,17 @@
 #include <tvm/relax/expr.h>
 #include <tvm/relax/expr_functor.h>
 
+#include <algorithm>
 #include <cstddef>
 #include <limits>
+#include <list>
+#include <mutex>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "../../support/env.h"
 #include "../../support/ordered_set.h"
 
 namespace tvm {
@@ -112,13 +117,81 @@ class UDChain : relax::ExprVisitor {
   }
 };
 
+/*!
+ * \brief Bounded LRU cache of use-def results, keyed by object identity.
+ *
+ * Relax IR is immutable, so a result stays valid for as long as the
+ * analyzed object is alive.  The cache holds strong references to its keys,
+ * both to keep entries valid and so that a key cannot be freed and its
+ * address reused while the entry is alive; the capacity bound keeps it from
+ * pinning more than a handful of functions in memory.
+ */
+class VarUsageCache {
+ public:
+  static VarUsageCache* Global() {
+    static VarUsageCache* inst = new VarUsageCache();
+    return inst;
+  }
+
+  bool Lookup(const ffi::ObjectRef& key, VarUsageInfo* result) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = lookup_.find(key.get());
+    if (it == lookup_.end()) {
+      return false;
+    }
+    entries_.splice(entries_.begin(), entries_, it->second);
+    *result = it->second->info;
+    return true;
+  }
+
+  void Insert(const ffi::ObjectRef& key, VarUsageInfo info) {
+    if (capacity_ == 0) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (auto it = lookup_.find(key.get()); it != lookup_.end()) {
+      entries_.splice(entries_.begin(), entries_, it->second);
+      it->second->info = std::move(info);
+      return;
+    }
+    entries_.push_front(Entry{key, std::move(info)});
+    lookup_[key.get()] = entries_.begin();
+    while (entries_.size() > capacity_) {
+      lookup_.erase(entries_.back().key.get());
+      entries_.pop_back();
+    }
+  }
+
+ private:
+  VarUsageCache() {
+    capacity_ = static_cast<size_t>(
+        std::max<int64_t>(support::GetEnv<int64_t>("TVM_RELAX_VAR_USAGE_CACHE_CAPACITY", 16), 0));
+  }
+
+  struct Entry {
+    ffi::ObjectRef key;
+    VarUsageInfo info;
+  };
+
+  // Most recently used entries at the front.
+  std::list<Entry> entries_;
+  std::unordered_map<const ffi::Object*, std::list<Entry>::iterator> lookup_;
+  size_t capacity_;
+  std::mutex mutex_;
+};
+
 std::pair<ffi::Map<Var, ffi::Array<Var>>, ffi::Array<Var>> FunctionUseDef(const Expr& fn) {
   auto usage = UDChain::Collect(fn);
   return {usage.downstream_usage, usage.outputs};
 }
 
 ffi::Map<Var, ffi::Array<Var>> DataflowBlockUseDef(const DataflowBlock& dfb) {
-  auto usage = UDChain::Collect(SeqExpr({dfb}, Tuple(ffi::Array<Expr>())));
+  auto* cache = VarUsageCache::Global();
+  VarUsageInfo usage;
+  if (!cache->Lookup(dfb, &usage)) {
+    usage = UDChain::Collect(SeqExpr({dfb}, Tuple(ffi::Array<Expr>())));
+    cache->Insert(dfb, usage);
+  }
   return usage.downstream_usage;
 }
 
@@ -138,6 +211,20 @@ TVM_FFI_STATIC_INIT_BLOCK() {
 
 VarUsageInfo CollectVarUsage(const Expr& expr) { return UDChain::Collect(expr); }
 
+VarUsageInfo CollectVarUsageCached(const Expr& expr) {
+  auto* cache = VarUsageCache::Global();
+  VarUsageInfo usage;
+  if (!cache->Lookup(expr, &usage)) {
+    usage = UDChain::Collect(expr);
+    cache->Insert(expr, usage);
+  }
+  return usage;
+}
+
+void UpdateVarUsageCache(const Expr& expr, VarUsageInfo info) {
+  VarUsageCache::Global()->Insert(expr, std::move(info));
+}
+
 std::set<const VarNode*> GetUsedVars(const Expr& expr) {
   class UsedVars : public ExprVisitor {
    public:
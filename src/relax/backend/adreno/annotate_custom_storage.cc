@@ -499,7 +499,8 @@ class CollectProducerScopeInfo : public ExprVisitor {
     if (call->op == call_tir_op) {
       out_ty = call->ty_args[0];
     } else {
-      tvm::OpAttrMap<FInferType> op_map_infer_ty = Op::GetAttrMap<FInferType>("FInferType");
+      static const tvm::OpAttrMap<FInferType> op_map_infer_ty =
+          Op::GetAttrMap<FInferType>("FInferType");
 
       auto* op_ptr = call->op.as<OpNode>();
       Op op = ffi::GetRef<Op>(op_ptr);
@@ -21,6 +21,13 @@
 
 #include <tvm/ffi/reflection/registry.h>
 
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
 #include "../../support/utils.h"
 
 namespace tvm {
@@ -31,11 +38,32 @@ static std::vector<FusionPattern>* GetRegistryTable() {
   return &table;
 }
 
+/*!
+ * \brief Index from root operator name to the registered patterns rooted at it.
+ *
+ * Rebuilt lazily after the registry changes. Each bucket stores the position
+ * of the pattern in the registry table so lookups can restore the priority
+ * order (later registrations have higher priority). Patterns whose root
+ * operator cannot be determined statically live in a separate bucket and are
+ * candidates at every call.
+ */
+struct PatternRootOpIndex {
+  std::unordered_map<std::string, std::vector<std::pair<size_t, FusionPattern>>> by_root_op;
+  std::vector<std::pair<size_t, FusionPattern>> unkeyed;
+  bool valid = false;
+};
+
+static PatternRootOpIndex* GetPatternRootOpIndex() {
+  static PatternRootOpIndex index;
+  return &index;
+}
+
 void RegisterPatterns(ffi::Array<FusionPattern> entries) {
   auto* table = GetRegistryTable();
   for (const auto& entry : entries) {
     table->push_back(entry);
   }
+  GetPatternRootOpIndex()->valid = false;
 }
 
 void RemovePatterns(ffi::Array<ffi::String> names) {
@@ -46,6 +74,66 @@ void RemovePatterns(ffi::Array<ffi::String> names) {
       std::remove_if(table->begin(), table->end(),
                      [&](const FusionPattern& entry) { return name_set.count(entry->name) > 0; }),
       table->end());
+  GetPatternRootOpIndex()->valid = false;
+}
+
+ffi::Optional<Op> GetPatternRootOp(const DFPattern& pattern) {
+  DFPattern current = pattern;
+  // Look through wrappers that only constrain the root call further.
+  while (true) {
+    if (const auto* attr = current.as<AttrPatternNode>()) {
+      current = attr->pattern;
+    } else if (const auto* type = current.as<TypePatternNode>()) {
+      current = type->pattern;
+    } else if (const auto* shape = current.as<ShapePatternNode>()) {
+      current = shape->pattern;
+    } else if (const auto* dtype = current.as<DataTypePatternNode>()) {
+      current = dtype->pattern;
+    } else {
+      break;
+    }
+  }
+  if (const auto* call = current.as<CallPatternNode>()) {
+    if (const auto* expr_pat = call->op.as<ExprPatternNode>()) {
+      if (auto opt_op = expr_pat->expr.as<Op>()) {
+        return opt_op.value();
+      }
+    }
+  }
+  return std::nullopt;
+}
+
+ffi::Array<FusionPattern> GetPatternsForRootOp(const ffi::String& op_name) {
+  auto* index = GetPatternRootOpIndex();
+  if (!index->valid) {
+    index->by_root_op.clear();
+    index->unkeyed.clear();
+    auto* table = GetRegistryTable();
+    for (size_t i = 0; i < table->size(); ++i) {
+      const FusionPattern& entry = (*table)[i];
+      if (auto opt_op = GetPatternRootOp(entry->pattern)) {
+        index->by_root_op[std::string(opt_op.value()->name)].emplace_back(i, entry);
+      } else {
+        index->unkeyed.emplace_back(i, entry);
+      }
+    }
+    index->valid = true;
+  }
+
+  std::vector<std::pair<size_t, FusionPattern>> candidates = index->unkeyed;
+  if (auto it = index->by_root_op.find(std::string(op_name)); it != index->by_root_op.end()) {
+    candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+  }
+  // Restore the priority order used by GetPatternsWithPrefix: patterns
+  // registered later come first.
+  std::sort(candidates.begin(), candidates.end(),
+            [](const auto& a, const auto& b) { return a.first > b.first; });
+  ffi::Array<FusionPattern> result;
+  for (const auto& [pos, entry] : candidates) {
+    (void)pos;
+    result.push_back(entry);
+  }
+  return result;
 }
 
 ffi::Array<FusionPattern> GetPatternsWithPrefix(const ffi::String& prefix) {
@@ -75,7 +163,8 @@ TVM_FFI_STATIC_INIT_BLOCK() {
       .def("relax.backend.RegisterPatterns", RegisterPatterns)
       .def("relax.backend.RemovePatterns", RemovePatterns)
       .def("relax.backend.GetPatternsWithPrefix", GetPatternsWithPrefix)
-      .def("relax.backend.GetPattern", GetPattern);
+      .def("relax.backend.GetPattern", GetPattern)
+      .def("relax.backend.GetPatternsForRootOp", GetPatternsForRootOp);
 }
 
 }  // namespace backend
@@ -27,6 +27,7 @@
 #define TVM_RELAX_BACKEND_PATTERN_REGISTRY_H_
 
 #include <tvm/ffi/optional.h>
+#include <tvm/ir/op.h>
 #include <tvm/relax/dataflow_pattern.h>
 #include <tvm/relax/expr.h>
 #include <tvm/relax/transform.h>
@@ -65,6 +66,32 @@ ffi::Array<FusionPattern> GetPatternsWithPrefix(const ffi::String& prefix);
  */
 ffi::Optional<FusionPattern> GetPattern(const ffi::String& name);
 
+/*!
+ * \brief Extract the operator that any match of a pattern must call at its root.
+ *
+ * Wrapper patterns that only constrain the root further (attribute, type,
+ * shape and dtype patterns) are looked through. Patterns whose root is not
+ * pinned to a single operator (e.g. wildcards or alternations) yield
+ * std::nullopt.
+ *
+ * \param pattern The pattern to inspect.
+ * \return The root operator, or std::nullopt when it cannot be determined.
+ */
+ffi::Optional<Op> GetPatternRootOp(const DFPattern& pattern);
+
+/*!
+ * \brief Find registered patterns that can possibly match a call to the given operator.
+ *
+ * The registry keeps an index from root operator to patterns, so the lookup
+ * cost is proportional to the number of candidate patterns at the operator
+ * rather than the total number of registered patterns. Patterns without a
+ * statically known root operator are always included as candidates.
+ *
+ * \param op_name The name of the call's operator.
+ * \return Candidate patterns, ordered by priority from high to low.
+ */
+ffi::Array<FusionPattern> GetPatternsForRootOp(const ffi::String& op_name);
+
 }  // namespace backend
 }  // namespace relax
 }  // namespace tvm
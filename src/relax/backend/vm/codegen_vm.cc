@@ -37,6 +37,7 @@
 #include "../../../runtime/const_loader_module.h"
 #include "../../../target/source/codegen_source_base.h"
 #include "../../transform/utils.h"
+#include "./unchecked_builtin.h"
 
 namespace tvm {
 namespace relax {
@@ -283,7 +284,7 @@ class CodeGenVM : public ExprFunctor<Instruction::Arg(const Expr&)> {
     args.push_back(builder_->ConvertConstant(expr->index));
 
     size_t dst_register = NewRegister();
-    builder_->EmitCall("vm.builtin.tuple_getitem", args, dst_register);
+    builder_->EmitCall(TupleGetItemBuiltinName(expr->tuple), args, dst_register);
 
     return Instruction::Arg::Register(dst_register);
   }
@@ -392,6 +393,10 @@ class CodeGenVM : public ExprFunctor<Instruction::Arg(const Expr&)> {
     builder_->EmitCall(func, args, dst_reg);
   }
   void EmitNormalCall(const Call& call_node, RegName dst_reg) {
+    if (auto unchecked = SelectUncheckedVMBuiltin(call_node->op, call_node->args)) {
+      builder_->EmitCall(unchecked.value(), VisitArray(call_node->args), dst_reg);
+      return;
+    }
     Instruction::Arg func = VisitExpr(call_node->op);
     std::vector<Instruction::Arg> args = VisitArray(call_node->args);
 
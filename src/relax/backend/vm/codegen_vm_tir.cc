@@ -41,6 +41,7 @@
 #include <vector>
 
 #include "../../transform/utils.h"
+#include "./unchecked_builtin.h"
 
 namespace tvm {
 namespace relax {
@@ -333,7 +334,7 @@ class CodeGenVMTIR : public ExprFunctor<ffi::Optional<PrimExpr>(const Expr&)> {
     args.push_back(ConstInt64(expr->index));
 
     int64_t dst_register = NewRegister();
-    this->EmitCallPacked("vm.builtin.tuple_getitem", args, dst_register);
+    this->EmitCallPacked(TupleGetItemBuiltinName(expr->tuple), args, dst_register);
     return RegListGet(dst_register);
   }
 
@@ -466,6 +467,10 @@ class CodeGenVMTIR : public ExprFunctor<ffi::Optional<PrimExpr>(const Expr&)> {
 
   void EmitNormalCall(const Call& call_node, int64_t dst_reg) {
     ffi::Array<PrimExpr> args = VisitArray(call_node->args);
+    if (auto unchecked = SelectUncheckedVMBuiltin(call_node->op, call_node->args)) {
+      this->EmitCallPacked(unchecked.value(), args, dst_reg);
+      return;
+    }
     // A function can be a closure that comes from parent
     // Do call closure to be safe.
     VMFuncInfo::FuncKind kind;
@@ -0,0 +1,89 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*!
+ * \file src/relax/backend/vm/unchecked_builtin.h
+ * \brief Selection of the unchecked trampolines for hot VM builtins.
+ */
+#ifndef TVM_RELAX_BACKEND_VM_UNCHECKED_BUILTIN_H_
+#define TVM_RELAX_BACKEND_VM_UNCHECKED_BUILTIN_H_
+
+#include <tvm/ffi/optional.h>
+#include <tvm/relax/expr.h>
+#include <tvm/relax/type.h>
+
+namespace tvm {
+namespace relax {
+namespace codegen_vm {
+
+/*!
+ * \brief Select the unchecked trampoline for a builtin callee when the static
+ * types of the call arguments already prove its signature.
+ *
+ * The generic `vm.builtin.*` registrations dispatch on the runtime type of
+ * every argument on every call. At call sites whose checked type already pins
+ * down the argument kinds that dispatch is pure decode overhead, so codegen
+ * swaps in the signature-specialized trampoline registered alongside the
+ * generic builtin in `src/runtime/vm/builtin.cc`. Call sites whose arguments
+ * are only known as objects keep the generic builtin, which also remains the
+ * entry point for every direct ffi caller.
+ *
+ * \param op The callee expression.
+ * \param args The call arguments.
+ * \return The trampoline name, or std::nullopt to keep the generic builtin.
+ */
+inline ffi::Optional<ffi::String> SelectUncheckedVMBuiltin(const Expr& op,
+                                                           const ffi::Array<Expr>& args) {
+  const auto* extern_func = op.as<ExternFuncNode>();
+  if (extern_func == nullptr) {
+    return std::nullopt;
+  }
+  const ffi::String& symbol = extern_func->global_symbol;
+  if (symbol == "vm.builtin.shape_of") {
+    if (args.size() == 1 && args[0]->ty.as<TensorTypeNode>()) {
+      return ffi::String("vm.builtin.shape_of.unchecked");
+    }
+  } else if (symbol == "vm.builtin.reshape") {
+    if (args.size() == 2 && args[0]->ty.as<TensorTypeNode>() && args[1]->ty.as<ShapeTypeNode>()) {
+      return ffi::String("vm.builtin.reshape.unchecked");
+    }
+  } else if (symbol == "vm.builtin.tuple_getitem") {
+    if (args.size() == 2 && args[0]->ty.as<TupleTypeNode>()) {
+      return ffi::String("vm.builtin.tuple_getitem.unchecked");
+    }
+  }
+  return std::nullopt;
+}
+
+/*!
+ * \brief The builtin name for a `TupleGetItem` node: the tuple operand is
+ * statically tuple-typed at every well-typed site, so the unchecked
+ * trampoline applies whenever that type is available.
+ * \param tuple The tuple operand.
+ * \return The builtin name to emit.
+ */
+inline const char* TupleGetItemBuiltinName(const Expr& tuple) {
+  return tuple->ty.as<TupleTypeNode>() ? "vm.builtin.tuple_getitem.unchecked"
+                                       : "vm.builtin.tuple_getitem";
+}
+
+}  // namespace codegen_vm
+}  // namespace relax
+}  // namespace tvm
+
+#endif  // TVM_RELAX_BACKEND_VM_UNCHECKED_BUILTIN_H_
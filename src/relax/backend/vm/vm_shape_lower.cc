@@ -56,6 +56,11 @@ struct PrimExprSlot {
   int outstanding_defs = 0;
   /*! \brief Whether we have computed the value. */
   bool value_computed = false;
+  /*!
+   * \brief Whether the value is ever loaded back from the heap.
+   * \note Slots that are never loaded do not need a store in the shape function.
+   */
+  bool used = false;
 };
 
 /*!
@@ -124,6 +129,64 @@ class PrimExprSlotCollector : public ExprVisitor, public TypeVisitor {
   PrimExprSlotMap* slot_map_;
 };
 
+/*!
+ * \brief Marker that flags the slots whose values are loaded back at runtime.
+ *
+ * The collector above allocates a slot for every PrimExpr in the function,
+ * including shape annotations on intermediate bindings. Only match points
+ * (params, match casts, return) and value-position shape expressions ever
+ * load a slot back from the heap; computing the remaining slots would emit
+ * dead stores in the generated shape functions, so we flag the consumed
+ * slots here and skip computing the rest.
+ */
+class PrimExprSlotUsedMarker : public ExprVisitor, public TypeVisitor {
+ public:
+  static void Mark(Function func, PrimExprSlotMap* slot_map) {
+    PrimExprSlotUsedMarker marker;
+    marker.slot_map_ = slot_map;
+    for (auto param : func->params) {
+      marker.VisitType(GetType(param));
+      marker.VisitExpr(param);
+    }
+    marker.VisitExpr(func->body);
+    marker.VisitType(func->ret_ty);
+  }
+
+ private:
+  void VisitPrimExpr(const PrimExpr& expr) final {
+    auto it = slot_map_->find(expr);
+    if (it != slot_map_->end()) {
+      it->second->used = true;
+    }
+  }
+
+  void VisitExprDepTypeField(const Type& ty) final {
+    // Shape annotations on intermediate bindings do not load slots at runtime,
+    // codegen simply carries them through.
+  }
+
+  void VisitBinding_(const MatchCastNode* op) final {
+    // Match cast types are consumed: every expression in the pattern is
+    // either stored to or asserted against the heap.
+    this->VisitType(op->ty);
+    this->VisitExpr(op->value);
+  }
+
+  void VisitExpr_(const FunctionNode* op) final {
+    // Do not recurse into function node as it is self-contained
+  }
+
+  void VisitType_(const FuncTypeNode* op) final {
+    // Do not recurse into function type as it is self-contained
+  }
+
+  void VisitTypeExprField(const PrimExpr& expr) final { VisitPrimExpr(expr); }
+
+  void VisitTypeExprField(const Expr& expr) final { ExprVisitor::VisitExpr(expr); }
+
+  PrimExprSlotMap* slot_map_;
+};
+
 /*!
  * \brief Main logic to transform the shape lowered functions
  *
@@ -193,6 +256,11 @@ class PrimExprSlotCollector : public ExprVisitor, public TypeVisitor {
  *
  * \endcode
  *
+ * Only slots that are loaded back at runtime (match patterns and value-position
+ * shape expressions, flagged by PrimExprSlotUsedMarker) are computed; slots that
+ * exist purely for shape annotations on intermediate bindings are skipped, which
+ * keeps the generated shape functions minimal on the decode fast path.
+ *
  * The current implementation will batch all shape computations at each match point.
  * For example, all the expressions that depend on n, m will be computed in a single
  * shape_func at the function boundary. If there are follow-up match_cast points,
@@ -229,6 +297,7 @@ class VMShapeLowerMutator
     slot_map_.clear();
     current_gvar_ = gvar;
     PrimExprSlotCollector::Collect(func, &slot_vec_, &slot_map_);
+    PrimExprSlotUsedMarker::Mark(func, &slot_map_);
     heap_size_ = IntImm(tvm::PrimType(ShapeDType()), static_cast<int64_t>(slot_vec_.size()));
     VarBinding shape_heap_binding = this->AllocShapeHeapBinding(heap_size_);
     shape_heap_ = shape_heap_binding->var;
@@ -541,7 +610,9 @@ class VMShapeLowerMutator
       for (PrimExprSlot* user : slot->user_slots) {
         TVM_FFI_ICHECK_GT(user->outstanding_defs, 0);
         user->outstanding_defs -= 1;
-        if (user->outstanding_defs == 0) {
+        if (user->outstanding_defs == 0 && user->used) {
+          // Slots that are never loaded back stay uncomputed; the consumer-side
+          // ICHECK on value_computed guards against the marker missing a use.
           to_compute.push_back(user);
         }
       }
@@ -325,7 +325,7 @@ TVM_FFI_STATIC_INIT_BLOCK() {
 }
 
 Expr RemoveAllUnused(Expr expr) {
-  auto var_usage = CollectVarUsage(expr);
+  auto var_usage = CollectVarUsageCached(expr);
 
   // For the purpose of
   support::OrderedSet<Var, ffi::ObjectPtrHash, ffi::ObjectPtrEqual> externally_exposed(
@@ -338,7 +338,42 @@ Expr RemoveAllUnused(Expr expr) {
 
   RemoveUnusedVars remover(var_usage.downstream_usage,
                            ffi::Array<Var>(externally_exposed.begin(), externally_exposed.end()));
-  return remover.VisitExpr(std::move(expr));
+  Expr new_expr = remover.VisitExpr(std::move(expr));
+
+  if (!remover.unused_vars.empty()) {
+    // The rewrite only drops bindings: surviving variables keep their bound
+    // value and lose exactly the removed users.  Derive the usage of the
+    // result from the original analysis so downstream passes querying
+    // CollectVarUsageCached do not need to re-traverse it.
+    // Only variables bound by a VarBinding are actually dropped; unused
+    // function parameters or MatchCast variables stay defined.
+    std::set<Var> removed;
+    for (const auto& var : remover.unused_vars) {
+      if (var_usage.bound_values.count(var)) {
+        removed.insert(var);
+      }
+    }
+    VarUsageInfo derived;
+    for (const auto& [var, value] : var_usage.bound_values) {
+      if (!removed.count(var)) {
+        derived.bound_values.Set(var, value);
+      }
+    }
+    for (const auto& [var, users] : var_usage.downstream_usage) {
+      if (removed.count(var)) continue;
+      ffi::Array<Var> remaining;
+      for (const auto& user : users) {
+        if (!removed.count(user)) {
+          remaining.push_back(user);
+        }
+      }
+      derived.downstream_usage.Set(var, std::move(remaining));
+    }
+    derived.outputs = var_usage.outputs;
+    UpdateVarUsageCache(new_expr, std::move(derived));
+  }
+
+  return new_expr;
 }
 
 TVM_FFI_STATIC_INIT_BLOCK() {
@@ -30,13 +30,96 @@
 #include <tvm/relax/expr_functor.h>
 #include <tvm/relax/transform.h>
 #include <tvm/relax/type_functor.h>
+#include <tvm/ffi/extra/structural_equal.h>
+#include <tvm/ffi/extra/structural_hash.h>
 #include <tvm/runtime/logging.h>
 
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../../runtime/threading_backend.h"
+#include "../../support/utils.h"
+
 namespace tvm {
 namespace relax {
 namespace transform {
 
 TVM_REGISTER_PASS_CONFIG_OPTION("relax.fallback_device_type", IntImm);
+TVM_REGISTER_PASS_CONFIG_OPTION("relax.function_pass_cache", bool);
+
+namespace {
+/*!
+ * \brief Process-wide memo of function-local pass results, keyed by the
+ *  structural hash of the input function, the pass name and the pass context
+ *  configuration, with structural-equality verification on hits.
+ *
+ * Enabled by the "relax.function_pass_cache" PassContext option and consulted
+ * only for function_local passes, whose output depends on nothing but the
+ * input function and the pass configuration. Incremental rebuilds that touch
+ * one function then skip re-lowering every clean function in the module. IR
+ * nodes are immutable once constructed, so sharing a memoized result across
+ * modules is safe.
+ */
+class FunctionPassCache {
+ public:
+  static FunctionPassCache* Global() {
+    static auto* inst = new FunctionPassCache();
+    return inst;
+  }
+
+  static uint64_t Key(const Function& func, const PassInfo& pass_info,
+                      const ffi::Map<ffi::String, Any>& config) {
+    uint64_t key = ffi::StructuralHash()(func);
+    key = support::HashCombine(key, ffi::StructuralHash()(pass_info->name));
+    return support::HashCombine(key, ffi::StructuralHash()(config));
+  }
+
+  std::optional<Function> Lookup(uint64_t key, const Function& func,
+                                 const ffi::Map<ffi::String, Any>& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = memo_.find(key);
+    if (it == memo_.end()) return std::nullopt;
+    // A 64-bit hash can collide; only a structurally equal input function
+    // produced under an equal configuration may be substituted.
+    ffi::StructuralEqual equal;
+    for (const Entry& entry : it->second) {
+      if (equal(func, entry.input) && equal(config, entry.config)) {
+        return entry.result;
+      }
+    }
+    return std::nullopt;
+  }
+
+  void Insert(uint64_t key, Function func, ffi::Map<ffi::String, Any> config, Function result) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Keep the process-wide memo bounded; dropping everything on overflow is
+    // crude but the memo only exists to speed up incremental rebuilds.
+    if (entries_ >= kMaxEntries) {
+      memo_.clear();
+      entries_ = 0;
+    }
+    memo_[key].push_back(Entry{std::move(func), std::move(config), std::move(result)});
+    ++entries_;
+  }
+
+ private:
+  struct Entry {
+    Function input;
+    ffi::Map<ffi::String, Any> config;
+    Function result;
+  };
+
+  static constexpr size_t kMaxEntries = 1024;
+
+  std::mutex mutex_;
+  std::unordered_map<uint64_t, std::vector<Entry>> memo_;
+  size_t entries_ = 0;
+};
+}  // namespace
 
 class FunctionPass;
 
@@ -124,17 +207,70 @@ IRModule FunctionPassNode::operator()(IRModule mod, const PassContext& pass_ctx)
   for (const auto& it : updated_mod->functions) {
     // only picks up relax::Function
     if (auto* n = it.second.as<FunctionNode>()) {
-      Function func = ffi::GetRef<Function>(n);
+      updates.push_back({it.first, ffi::GetRef<Function>(n)});
+    }
+  }
+
+  const bool use_cache =
+      pass_info->function_local &&
+      pass_ctx->GetConfig<bool>("relax.function_pass_cache", false).value();
+  // Pass behavior may depend on any PassContext option, so the configuration
+  // takes part in the cache key alongside the function and the pass name.
+  ffi::Map<ffi::String, Any> cache_config =
+      pass_ctx->config.defined() ? pass_ctx->config : ffi::Map<ffi::String, Any>();
+  auto apply_one = [&](size_t i) {
+    Function func = updates[i].second;
+    uint64_t cache_key = 0;
+    if (use_cache) {
+      cache_key = FunctionPassCache::Key(func, pass_info, cache_config);
+      if (auto cached = FunctionPassCache::Global()->Lookup(cache_key, func, cache_config)) {
+        updates[i].second = cached.value();
+        return;
+      }
+    }
+    Function updated_func = pass_func(func, updated_mod, pass_ctx);
+    if (use_cache) {
+      FunctionPassCache::Global()->Insert(cache_key, std::move(func), cache_config, updated_func);
+    }
+    updates[i].second = std::move(updated_func);
+  };
+
+  if (pass_info->function_local && updates.size() > 1) {
+    // A function-local pass only reads and rewrites the function it is applied
+    // to, so the functions can be processed in parallel. updated_mod is only
+    // read during the map; the rewritten functions are installed afterwards on
+    // the calling thread.
+    std::vector<std::exception_ptr> errors(updates.size());
+    runtime::parallel_for_with_threading_backend(
+        [&](int64_t i) {
+          try {
+            apply_one(static_cast<size_t>(i));
+          } catch (...) {
+            errors[i] = std::current_exception();
+          }
+        },
+        0, static_cast<int64_t>(updates.size()));
+    for (size_t i = 0; i < errors.size(); ++i) {
+      if (errors[i] == nullptr) continue;
+      // Re-raise the first failure on the calling thread, enriched the same
+      // way as in the serial path.
+      try {
+        std::rethrow_exception(errors[i]);
+      } catch (ffi::Error& err) {
+        throw tvm::transform::EnrichPassErrorWithContext(err, updated_mod, pass_info->name,
+                                                         updates[i].first);
+      }
+    }
+  } else {
+    for (size_t i = 0; i < updates.size(); ++i) {
       // Enrich at this leaf executor, rendering the location local to the
       // currently-processed function (the access path is function-rooted).
-      Function updated_func;
       try {
-        updated_func = pass_func(func, updated_mod, pass_ctx);
+        apply_one(i);
       } catch (ffi::Error& err) {
         throw tvm::transform::EnrichPassErrorWithContext(err, updated_mod, pass_info->name,
-                                                         it.first);
+                                                         updates[i].first);
       }
-      updates.push_back({it.first, updated_func});
     }
   }
 
@@ -149,8 +285,8 @@ IRModule FunctionPassNode::operator()(IRModule mod, const PassContext& pass_ctx)
 
 Pass CreateFunctionPass(std::function<Function(Function, IRModule, PassContext)> pass_func,
                         int opt_level, ffi::String name, tvm::ffi::Array<ffi::String> required,
-                        bool traceable) {
-  PassInfo pass_info = PassInfo(opt_level, name, required, traceable);
+                        bool traceable, bool function_local) {
+  PassInfo pass_info = PassInfo(opt_level, name, required, traceable, function_local);
   return FunctionPass(std::move(pass_func), pass_info);
 }
 
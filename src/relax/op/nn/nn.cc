@@ -79,6 +79,7 @@ TVM_REGISTER_OP("relax.nn.leakyrelu")
     .add_argument("data", "Tensor", "The input tensor.")
     .set_attrs_type<LeakyReluAttrs>()
     .set_attr<FInferType>("FInferType", InferTypeUnaryArith</*require_float_dtype=*/true>)
+    .set_attr<bool>("FInplaceEligible", true)
     .set_attr<bool>("FPurity", true);
 
 /* relax.nn.softplus */
@@ -101,6 +102,7 @@ TVM_REGISTER_OP("relax.nn.softplus")
     .add_argument("data", "Tensor", "The input tensor.")
     .set_attrs_type<SoftplusAttrs>()
     .set_attr<FInferType>("FInferType", InferTypeUnaryArith</*require_float_dtype=*/true>)
+    .set_attr<bool>("FInplaceEligible", true)
     .set_attr<bool>("FPurity", true);
 
 /* relax.nn.prelu */
@@ -39,11 +39,15 @@ namespace relax {
  * \param OpName The name of operator to register.
  * \param OpRegName The identifier of the operator in the registry.
  * \param RequireFloatDtype A boolean indicating if the input is required to have float dtype.
+ *
+ * The registered ops are elementwise activations and are marked eligible for
+ * in-place computation (see dataflow_inplace.cc).
  */
 #define RELAX_REGISTER_UNARY_NN_OP_AND_IMPL(OpName, OpRegName, RequireFloatDtype) \
   RELAX_UNARY_OP_INTERFACE(OpName, OpRegName)                                     \
-  RELAX_REGISTER_UNARY_OP(OpRegName).set_attr<FInferType>("FInferType",           \
-                                                          InferTypeUnaryArith<RequireFloatDtype>)
+  RELAX_REGISTER_UNARY_OP(OpRegName)                                              \
+      .set_attr<FInferType>("FInferType", InferTypeUnaryArith<RequireFloatDtype>) \
+      .set_attr<bool>("FInplaceEligible", true)
 
 /*! \brief Rectified linear unit. */
 Expr relu(Expr data);
@@ -53,9 +53,13 @@ namespace relax {
       .set_attr<TMixedPrecisionPolicy>("TMixedPrecisionPolicy", MixedPrecisionPolicyKind::kFollow) \
       .set_attr<bool>("FPurity", true)
 
-#define RELAX_REGISTER_BINARY_BROADCAST_OP_AND_IMPL(OpName)                    \
-  RELAX_REGISTER_BINARY_OP_AND_IMPL(OpName).set_attr<FInferType>("FInferType", \
-                                                                 InferTypeBroadcastArith)
+// Broadcast arith ops keep the dtype of their inputs, so an argument that
+// already has the broadcast shape may hold the result in-place (the planner in
+// dataflow_inplace.cc checks the shape and liveness conditions per argument).
+#define RELAX_REGISTER_BINARY_BROADCAST_OP_AND_IMPL(OpName)                        \
+  RELAX_REGISTER_BINARY_OP_AND_IMPL(OpName)                                        \
+      .set_attr<FInferType>("FInferType", InferTypeBroadcastArith)                 \
+      .set_attr<bool>("FInplaceEligible", true)
 
 #define RELAX_REGISTER_CMP_OP_AND_IMPL(OpName)                                 \
   RELAX_REGISTER_BINARY_OP_AND_IMPL(OpName).set_attr<FInferType>("FInferType", \
@@ -114,6 +114,14 @@ Type InferTypeQuantize(const Call& call, const BlockBuilder& ctx) {
 
   auto check_param_size = [&](const TensorType& param_ty, const TensorType& data_ty,
                               ffi::String param_name) {
+    // 1-D params are per-channel along `axis`; 2-D params of shape
+    // [channels, num_groups] are group-quantization params, with the channel
+    // dim matching the input shape at `axis`.
+    if (param_ty->ndim > 2) {
+      TVM_FFI_VISIT_THROW(ValueError, call)
+          << call->op << ": " << param_name << " param must be at most 2-D, but got "
+          << param_ty->ndim << "-D";
+    }
     const PrimExpr& param_dim = param_ty->GetShape().value()[0];
     const PrimExpr& input_dim = data_ty->GetShape().value()[axis];
     if (!ctx->GetAnalyzer()->CanProveEqual(param_dim, input_dim)) {
@@ -226,6 +234,14 @@ Type InferTypeDequantize(const Call& call, const BlockBuilder& ctx) {
 
   auto check_param_size = [&](const TensorType& param_ty, const TensorType& data_ty,
                               ffi::String param_name) {
+    // 1-D params are per-channel along `axis`; 2-D params of shape
+    // [channels, num_groups] are group-quantization params, with the channel
+    // dim matching the input shape at `axis`.
+    if (param_ty->ndim > 2) {
+      TVM_FFI_VISIT_THROW(ValueError, call)
+          << call->op << ": " << param_name << " param must be at most 2-D, but got "
+          << param_ty->ndim << "-D";
+    }
     const PrimExpr& param_dim = param_ty->GetShape().value()[0];
     const PrimExpr& input_dim = data_ty->GetShape().value()[axis];
     if (!ctx->GetAnalyzer()->CanProveEqual(param_dim, input_dim)) {
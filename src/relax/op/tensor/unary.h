@@ -41,9 +41,12 @@ namespace relax {
   RELAX_UNARY_OP_INTERFACE(OpName, #OpName)      \
   RELAX_REGISTER_UNARY_OP(#OpName)
 
-#define RELAX_REGISTER_UNARY_ARITH_OP_AND_IMPL(OpName, RequireFloatDtype) \
-  RELAX_REGISTER_UNARY_OP_AND_IMPL(OpName).set_attr<FInferType>(          \
-      "FInferType", InferTypeUnaryArith<RequireFloatDtype>)
+// Arith ops are elementwise with the same output shape and dtype as the input,
+// so they may compute the result in-place over the input (see dataflow_inplace.cc).
+#define RELAX_REGISTER_UNARY_ARITH_OP_AND_IMPL(OpName, RequireFloatDtype)         \
+  RELAX_REGISTER_UNARY_OP_AND_IMPL(OpName)                                        \
+      .set_attr<FInferType>("FInferType", InferTypeUnaryArith<RequireFloatDtype>) \
+      .set_attr<bool>("FInplaceEligible", true)
 
 #define RELAX_REGISTER_UNARY_CHECK_OP_AND_IMPL(OpName)           \
   RELAX_REGISTER_UNARY_OP_AND_IMPL(OpName).set_attr<FInferType>( \
@@ -48,7 +48,7 @@ TVM_STATIC_IR_FUNCTOR(IRDocsifier, vtable)
           using tvm::Type;
           using relax::MatchType;
           ffi::Optional<ExprDoc> ann = std::nullopt;
-          if (d->cfg->GetExtraConfig<bool>("relax.show_all_ty", true)) {
+          if (d->relax_show_all_ty) {
             ann = TypeAsAnn(n->var, n_p->Attr("var"), d, n->value);
           }
           ExprDoc rhs = Relax(d, "match_cast")
@@ -84,7 +84,7 @@ inline ffi::Optional<ExprDoc> TypeAsAnn(const relax::Var& v, const AccessPath& v
   if (!v->ty.defined()) {
     return std::nullopt;
   }
-  bool attempt_to_hide_ty = !d->cfg->GetExtraConfig<bool>("relax.show_all_ty", true);
+  bool attempt_to_hide_ty = !d->relax_show_all_ty;
 
   if (rhs.defined()) {
     if (const auto* call = rhs.as<relax::CallNode>()) {
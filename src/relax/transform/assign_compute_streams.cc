@@ -0,0 +1,229 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/relax/transform/assign_compute_streams.cc
+ * \brief Compile-time stream assignment for branch-level parallelism.
+ *
+ * The VM launches every kernel of a function on one stream per device, so
+ * independent subgraphs inside a dataflow block (parallel experts in MoE,
+ * parallel attention heads after a split) serialize even though nothing
+ * orders them. This pass colors the bindings of each dataflow block into
+ * dependency chains and assigns each chain a numbered compute stream:
+ *
+ *  - `vm.builtin.stream_switch` is inserted where consecutive bindings land
+ *    on different streams; it redirects subsequent kernel launches of the
+ *    executing thread to the chain's stream;
+ *  - `vm.builtin.stream_join` is inserted in front of a binding that consumes
+ *    a value produced on another stream; it makes the consumer's stream wait
+ *    on an event recorded on the producer's stream.
+ *
+ * Both builtins take a representative tensor and return it unchanged, so like
+ * the transfer-overlap builtins the synchronization is carried by ordinary
+ * dataflow and survives dead-code elimination without any new VM opcodes.
+ * The first chain keeps the device's default stream, every dataflow output is
+ * joined back to it, and a purely serial block is left untouched. The pass
+ * should run before memory planning so the inserted bindings are visible to
+ * liveness analysis.
+ */
+
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/relax/analysis.h>
+#include <tvm/relax/expr.h>
+#include <tvm/relax/expr_functor.h>
+#include <tvm/relax/transform.h>
+#include <tvm/relax/type.h>
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace tvm {
+namespace relax {
+
+namespace {
+
+class StreamAssignRewriter : public ExprMutator {
+ public:
+  static Function Rewrite(Function func, int max_streams) {
+    StreamAssignRewriter mutator(max_streams);
+    return mutator.VisitExpr(std::move(func)).as_or_throw<Function>();
+  }
+
+ private:
+  explicit StreamAssignRewriter(int max_streams) : max_streams_(max_streams) {}
+
+  /*! \brief Whether the expression carries a tensor the stream builtins can thread. */
+  static bool IsTensor(const Expr& expr) { return GetTypeAs<TensorTypeNode>(expr) != nullptr; }
+
+  BindingBlock VisitBindingBlock_(const DataflowBlockNode* block) final {
+    int n = static_cast<int>(block->bindings.size());
+    // In-block producer index of every bound var.
+    std::unordered_map<Var, int> producer;
+    for (int i = 0; i < n; ++i) {
+      producer[block->bindings[i]->var] = i;
+    }
+
+    // Decompose the block into dependency chains. A binding extends the chain
+    // of a dependency that is still the chain's tail; a binding whose
+    // dependencies have all been extended already starts a new chain, which is
+    // how the parallel branches of a fork each get their own color. Dataflow
+    // outputs are pinned to the default chain so every branch is joined back
+    // before its value escapes the block.
+    std::vector<std::vector<int>> deps(n);
+    std::vector<int> color(n, 0);
+    std::unordered_map<int, int> chain_tail;
+    int num_colors = 0;
+    for (int i = 0; i < n; ++i) {
+      const Binding& binding = block->bindings[i];
+      bool has_tensor_dep = false;
+      for (const Var& var : FreeVars(GetBoundValue(binding))) {
+        auto it = producer.find(var);
+        if (it == producer.end()) continue;
+        deps[i].push_back(it->second);
+        if (IsTensor(var)) has_tensor_dep = true;
+      }
+      int assigned = -1;
+      if (binding->var->IsInstance<DataflowVarNode>()) {
+        for (auto dep = deps[i].rbegin(); dep != deps[i].rend(); ++dep) {
+          auto tail = chain_tail.find(color[*dep]);
+          if (tail != chain_tail.end() && tail->second == *dep) {
+            assigned = color[*dep];
+            break;
+          }
+        }
+        if (assigned == -1) {
+          // A chain root needs an in-block tensor dependency to thread the
+          // stream switch through; bindings reading only parameters and
+          // constants stay on the default stream.
+          assigned = has_tensor_dep ? num_colors++ : 0;
+        }
+      } else {
+        assigned = 0;
+      }
+      color[i] = assigned;
+      chain_tail[assigned] = i;
+    }
+
+    // Map chains onto the physical stream budget; chain 0 keeps the device's
+    // default stream. A block that ends up single-stream is left untouched.
+    auto phys = [this](int c) { return c % max_streams_; };
+    bool multi_stream = false;
+    for (int i = 0; i < n && !multi_stream; ++i) {
+      multi_stream = phys(color[i]) != 0;
+    }
+    if (!multi_stream || max_streams_ < 2) {
+      return ExprMutator::VisitBindingBlock_(block);
+    }
+
+    builder_->BeginDataflowBlock();
+    int cur_stream = 0;
+    // The stream each binding actually runs on: the planned one, unless no
+    // tensor was available to thread the switch through, in which case the
+    // binding stays where it is and its consumers synchronize accordingly.
+    std::vector<int> stream_of(n, 0);
+    // The last tensor emitted on each stream, used as the token of joins
+    // whose triggering operand is not itself a tensor.
+    std::unordered_map<int, Var> last_tensor_on;
+    for (int i = 0; i < n; ++i) {
+      const Binding& binding = block->bindings[i];
+      int dst = phys(color[i]);
+      Var switch_token;
+      if (dst != cur_stream) {
+        switch_token = PickTensorToken(deps[i], block, last_tensor_on[cur_stream]);
+        if (!switch_token.defined()) dst = cur_stream;
+      }
+      stream_of[i] = dst;
+      // Wait on every other stream this binding consumes from. One event per
+      // producer stream is enough: the event is recorded behind all work
+      // issued on it so far.
+      std::unordered_set<int> joined;
+      for (int dep : deps[i]) {
+        int src = stream_of[dep];
+        if (src == dst || !joined.insert(src).second) continue;
+        Var token = IsTensor(block->bindings[dep]->var) ? block->bindings[dep]->var
+                                                        : last_tensor_on[src];
+        if (!token.defined()) continue;
+        EmitStreamBuiltin(builtin_stream_join_, token, {IntImm::Int64(src), IntImm::Int64(dst)},
+                          "_join");
+      }
+      if (dst != cur_stream) {
+        EmitStreamBuiltin(builtin_stream_switch_, switch_token, {IntImm::Int64(dst)},
+                          "_on_stream");
+        cur_stream = dst;
+      }
+      VisitBinding(binding);
+      if (IsTensor(binding->var)) {
+        last_tensor_on[cur_stream] = binding->var;
+      }
+    }
+    return builder_->EndBlock();
+  }
+
+  /*! \brief Pick the tensor that carries a stream switch through dataflow. */
+  Var PickTensorToken(const std::vector<int>& dep_indices, const DataflowBlockNode* block,
+                      const Var& fallback) {
+    for (auto it = dep_indices.rbegin(); it != dep_indices.rend(); ++it) {
+      const Var& var = block->bindings[*it]->var;
+      if (IsTensor(var)) return var;
+    }
+    return fallback;
+  }
+
+  /*! \brief Emit one stream builtin threading `token` and remap its later uses. */
+  void EmitStreamBuiltin(const ExternFunc& builtin, const Var& token,
+                         std::vector<Expr> stream_args, const char* suffix) {
+    Array<Expr> args{builtin, VisitExpr(token)};
+    for (Expr& arg : stream_args) {
+      args.push_back(std::move(arg));
+    }
+    Call call(call_pure_packed_, args, Attrs(), {GetType(token)});
+    Var threaded = builder_->Emit(call, std::string(token->name_hint) + suffix);
+    var_remap_[token->vid] = threaded;
+  }
+
+  const Op& call_pure_packed_ = Op::Get("relax.call_pure_packed");
+  const ExternFunc builtin_stream_switch_{"vm.builtin.stream_switch"};
+  const ExternFunc builtin_stream_join_{"vm.builtin.stream_join"};
+
+  /*! \brief Number of physical streams chains are mapped onto, including stream 0. */
+  int max_streams_;
+};
+
+}  // namespace
+
+namespace transform {
+
+Pass AssignComputeStreams(int max_streams) {
+  auto pass_func = [=](Function func, IRModule mod, PassContext pc) {
+    return StreamAssignRewriter::Rewrite(std::move(func), max_streams);
+  };
+  return CreateFunctionPass(pass_func, 0, "AssignComputeStreams", {});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("relax.transform.AssignComputeStreams", AssignComputeStreams);
+}
+
+}  // namespace transform
+}  // namespace relax
+}  // namespace tvm
@@ -0,0 +1,161 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/relax/transform/auto_batch.cc
+ * \brief Derive batched variants of per-request entry functions.
+ *
+ * Serving models are typically traced for a single request: every tensor
+ * parameter carries a leading dimension of 1 and the runtime loops over
+ * requests in Python, which both serializes the batch and puts the
+ * interpreter on the decode path. This pass clones each selected exposed
+ * function into a `<name>_batched` variant in which every such leading
+ * dimension is replaced by one shared symbolic `batch_size`, and the body
+ * is re-derived so the batch dimension propagates through the call graph.
+ * The runtime can then stack the per-request inputs and make one call per
+ * step, with no Python between requests.
+ *
+ * Ragged dimensions need no handling here: per the KV cache convention,
+ * variable-length sequences are already flattened into a single token axis
+ * and described by the sequence-id / append-length vectors the cache
+ * builtins consume, so only the fixed per-request dimensions are batched.
+ * An operator whose type inference cannot accommodate the symbolic batch
+ * dimension surfaces as a normalization error at pass time rather than a
+ * miscompiled kernel.
+ */
+
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/ir/module.h>
+#include <tvm/relax/block_builder.h>
+#include <tvm/relax/expr.h>
+#include <tvm/relax/expr_functor.h>
+#include <tvm/relax/transform.h>
+#include <tvm/relax/type.h>
+#include <tvm/relax/utils.h>
+#include <tvm/tirx/expr.h>
+
+#include <string>
+#include <unordered_set>
+#include <utility>
+
+namespace tvm {
+namespace relax {
+
+namespace {
+
+/*!
+ * \brief Replace the unit leading dimension of tensor parameters with a
+ * shared symbolic batch size and re-derive the body.
+ */
+class BatchParamMutator : public ExprMutator {
+ public:
+  explicit BatchParamMutator(tirx::Var batch) : batch_(std::move(batch)) {}
+
+  using ExprMutator::VisitExpr_;
+
+  Expr VisitExpr_(const FunctionNode* op) override {
+    auto func = ffi::GetRef<Function>(op);
+    if (visited_outer_func_) {
+      // Only the entry function's parameters are batched; the batch
+      // dimension reaches nested functions through their call sites.
+      return ExprMutator::VisitExpr_(op);
+    }
+    visited_outer_func_ = true;
+
+    auto params = op->params.Map([this](Var param) {
+      const auto* tensor_ty = GetType(param).as<TensorTypeNode>();
+      if (tensor_ty == nullptr) return param;
+      auto opt_shape = tensor_ty->GetShape();
+      if (!opt_shape.defined() || opt_shape.value().empty()) return param;
+      ffi::Array<PrimExpr> shape = opt_shape.value();
+      const auto* leading = shape[0].as<IntImmNode>();
+      if (leading == nullptr || leading->value != 1) return param;
+      shape.Set(0, batch_);
+      auto new_param =
+          WithType(param, TensorType(ShapeExpr(shape), tensor_ty->dtype, tensor_ty->vdevice));
+      var_remap_[param->vid] = new_param;
+      batched_any_ = true;
+      return new_param;
+    });
+
+    if (!params.same_as(func->params)) {
+      func.CopyOnWrite()->params = params;
+    }
+    return ExprMutator::VisitExpr_(func.get());
+  }
+
+  /*! \return Whether any parameter had a unit leading dimension to batch. */
+  bool batched_any() const { return batched_any_; }
+
+ private:
+  tirx::Var batch_;
+  bool visited_outer_func_ = false;
+  bool batched_any_ = false;
+};
+
+IRModule ModuleAutoBatch(IRModule mod, const ffi::Array<ffi::String>& func_names) {
+  std::unordered_set<std::string> targets(func_names.begin(), func_names.end());
+  BlockBuilder builder = BlockBuilder::Create(mod);
+  bool changed = false;
+
+  for (const auto& [gvar, base_func] : mod->functions) {
+    auto opt_func = base_func.as<Function>();
+    if (!opt_func) continue;
+    Function func = opt_func.value();
+    if (func->HasNonzeroAttr(attr::kPrimitive)) continue;
+    auto opt_symbol = func->GetAttr<ffi::String>(tvm::attr::kGlobalSymbol);
+    if (!opt_symbol) continue;
+    std::string base_name = opt_symbol.value();
+    if (!targets.empty() && !targets.count(base_name)) continue;
+
+    // Batch a fresh copy so the original per-request entry point stays
+    // available and the shared batch variable does not alias any other
+    // function's symbolic variables.
+    BatchParamMutator mutator(tirx::Var("batch_size", PrimType::Int(64)));
+    Function batched = mutator(CopyWithNewVars(func)).as_or_throw<Function>();
+    if (!mutator.batched_any()) continue;
+
+    std::string name = base_name + "_batched";
+    batched = WithAttr(batched, tvm::attr::kGlobalSymbol, ffi::String(name));
+    builder->AddFunction(builder->Normalize(batched).as_or_throw<Function>(), name);
+    changed = true;
+  }
+
+  return changed ? builder->GetContextIRModule() : mod;
+}
+
+}  // namespace
+
+namespace transform {
+
+Pass AutoBatch(ffi::Array<ffi::String> func_names) {
+  auto pass_func = [=](IRModule mod, PassContext pc) -> IRModule {
+    return ModuleAutoBatch(std::move(mod), func_names);
+  };
+  return CreateModulePass(pass_func, 0, "AutoBatch", {});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("relax.transform.AutoBatch", AutoBatch);
+}
+
+}  // namespace transform
+}  // namespace relax
+}  // namespace tvm
@@ -30,6 +30,11 @@
 #include <tvm/relax/transform.h>
 #include <tvm/tirx/index_map.h>
 
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
 #include "../op/tensor/manipulate.h"
 #include "infer_layout_utils.h"
 #include "utils.h"
@@ -41,6 +46,222 @@ using tirx::IndexMap;
 using tirx::SLayout;
 using LayoutCb = tvm::relax::transform::LayoutCb;
 
+static bool HasUnknownDimTensor(const NLayout& nlayout) {
+  bool find = false;
+  auto fvisit = [&](const LayoutDecision& layout) {
+    find = find | (NLayoutEqual()(layout, LayoutDecision::InitUnknownDim()));
+  };
+  ForEachLeaf<LayoutDecision>(nlayout, fvisit);
+  return find;
+}
+
+static bool HasUnknownDimTensor(const ffi::Array<Expr>& args, const VarLayoutMap& var_layout_map) {
+  for (const auto& arg : args) {
+    if (IsNestedTensor(arg)) {
+      if (HasUnknownDimTensor(GetNLayout(var_layout_map, arg))) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+static ffi::Optional<InferLayoutOutput> GetInferLayoutInfo(
+    const CallNode* call_node, const ffi::Map<ffi::String, ffi::Array<ffi::String>>& desired_layouts,
+    const LayoutCb& layout_cb, const VarLayoutMap& var_layout_map) {
+  const OpNode* op_node = call_node->op.as<OpNode>();
+  if (op_node == nullptr) return std::nullopt;
+  Op op = ffi::GetRef<Op>(op_node).as_or_throw<Op>();
+  static const auto attr_map = Op::GetAttrMap<FRelaxInferLayout>("FRelaxInferLayout");
+  if (attr_map.count(op) && !HasUnknownDimTensor(call_node->args, var_layout_map)) {
+    // If the op has FRelaxInferLayout, and all the input tensors have known ndim
+    FRelaxInferLayout f = attr_map[op];
+    auto call = ffi::GetRef<Call>(call_node);
+    if (layout_cb != nullptr) {
+      auto custom_layouts = layout_cb(call);
+      return f(call, custom_layouts, var_layout_map);
+    } else {
+      return f(call, desired_layouts, var_layout_map);
+    }
+  } else {
+    // Otherwise, we use the default policy.
+    return std::nullopt;
+  }
+}
+
+/*!
+ * \brief Plans the layout each dataflow var is realized in before rewriting.
+ *
+ * The rewriting pass below works in a single forward pass: every var is materialized in the
+ * layout its producer inferred, and every consumer that expects a different layout inserts its
+ * own conversion. When several consumers disagree with the producer this duplicates transposes,
+ * one per consumer, which is where most of the conversion overhead of vision models comes from.
+ *
+ * The planner replays the same layout propagation without mutating anything, and phrases
+ * realization as a global optimization over the layout-assignment graph: for every dataflow var,
+ * pick the realized layout minimizing the number of materialized conversions, counting one at the
+ * definition if the realized layout differs from the produced one, plus one per consumer that
+ * expects a different layout. With the per-op layouts fixed by the inference functions, the
+ * objective is separable per var, so a vote over the produced and consumer-expected layouts
+ * solves it exactly without an external ILP solver. The rewriter then consults the plan and
+ * converts once at the definition instead of once per consumer.
+ */
+class LayoutPlanner : public ExprVisitor {
+ public:
+  static std::unordered_map<Var, NLayout> Plan(
+      const DataflowBlock& block,
+      const ffi::Map<ffi::String, ffi::Array<ffi::String>>& desired_layouts,
+      const LayoutCb& layout_cb) {
+    LayoutPlanner planner(desired_layouts, layout_cb);
+    planner.VisitBindingBlock(block);
+    return planner.Finalize();
+  }
+
+ private:
+  LayoutPlanner(const ffi::Map<ffi::String, ffi::Array<ffi::String>>& desired_layouts,
+                const LayoutCb& layout_cb)
+      : desired_layouts_(desired_layouts), layout_cb_(layout_cb) {}
+
+  void VisitBinding(const Binding& binding) final {
+    ExprVisitor::VisitBinding(binding);
+    // The layout is default to be initial if not rewritten.
+    if (var_layout_map_.find(binding->var) == var_layout_map_.end()) {
+      var_layout_map_[binding->var] = InitialNLayout(binding->var);
+    }
+  }
+
+  void VisitExpr_(const VarNode* op) final {
+    // A var use outside of inferrable regions is rewritten to the initial layout.
+    RecordWant(ffi::GetRef<Var>(op), InitialNLayout(ffi::GetRef<Var>(op)));
+  }
+
+  void VisitBinding_(const VarBindingNode* binding, const CallNode* call_node) final {
+    ffi::Optional<InferLayoutOutput> res =
+        GetInferLayoutInfo(call_node, desired_layouts_, layout_cb_, var_layout_map_);
+    if (!res.defined() ||
+        (!IsNestedTensor(binding->var) && !binding->var->IsInstance<DataflowVarNode>())) {
+      // Default policy: all args are rewritten to the initial layout.
+      for (const auto& arg : call_node->args) {
+        RecordWant(arg, InitialNLayout(arg));
+      }
+      var_layout_map_[binding->var] = InitialNLayout(binding->var);
+      return;
+    }
+    // Args replaced via new_args do not materialize a conversion.
+    std::unordered_set<int64_t> replaced_args;
+    for (const auto& [i, arg] : res.value()->new_args) {
+      replaced_args.insert(i->value);
+    }
+    ffi::Array<NLayout> input_layouts = res.value()->input_layouts;
+    for (size_t i = 0; i < call_node->args.size() && i < input_layouts.size(); ++i) {
+      if (!replaced_args.count(static_cast<int64_t>(i))) {
+        RecordWant(call_node->args[i], input_layouts[i]);
+      }
+    }
+    if (binding->var->IsInstance<DataflowVarNode>()) {
+      produced_.emplace_back(binding->var, res.value()->output_layouts[0]);
+      var_layout_map_[binding->var] = res.value()->output_layouts[0];
+    } else {
+      // Global var (tensor) bindings are rewritten back to the initial layout.
+      var_layout_map_[binding->var] = InitialNLayout(binding->var);
+    }
+  }
+
+  void VisitBinding_(const VarBindingNode* binding, const TupleNode* val) final {
+    std::vector<NLayout> input_layout;
+    for (const auto& field : val->fields) {
+      if (binding->var->IsInstance<DataflowVarNode>()) {
+        // Dataflow tuples group fields in whatever layout they are realized in and
+        // materialize no conversion, so they express no preference.
+        input_layout.push_back(GetNLayout(var_layout_map_, field));
+      } else {
+        RecordWant(field, InitialNLayout(field));
+        input_layout.push_back(InitialNLayout(field));
+      }
+    }
+    if (IsNestedTensor(binding->var)) {
+      var_layout_map_[binding->var] = input_layout;
+    }
+  }
+
+  void VisitBinding_(const VarBindingNode* binding, const TupleGetItemNode* val) final {
+    NLayout input_layout = binding->var->IsInstance<DataflowVarNode>()
+                               ? GetNLayout(var_layout_map_, val->tuple)
+                               : InitialNLayout(val->tuple);
+    if (!binding->var->IsInstance<DataflowVarNode>()) {
+      RecordWant(val->tuple, input_layout);
+    }
+    var_layout_map_[binding->var] = input_layout.NestedArray()[val->index];
+  }
+
+  void VisitBinding_(const MatchCastNode* binding) final {
+    if (!binding->var->IsInstance<DataflowVarNode>()) {
+      ExprVisitor::VisitBinding_(binding);
+      return;
+    }
+    // A dataflow match cast follows the realized layout of its input.
+    var_layout_map_[binding->var] = GetNLayout(var_layout_map_, binding->value);
+  }
+
+  /*! \brief Record that one consumer expects `expr` to be available in `layout`. */
+  void RecordWant(const Expr& expr, const NLayout& layout) {
+    const auto* var = expr.as<VarNode>();
+    if (var == nullptr || !var->IsInstance<DataflowVarNode>()) return;
+    auto& votes = wants_[ffi::GetRef<Var>(var)];
+    auto it = votes.emplace(LayoutKey(layout), std::make_pair(layout, 0)).first;
+    ++it->second.second;
+  }
+
+  /*! \brief A hashable key for an NLayout, consistent with NLayoutEqual. */
+  static std::string LayoutKey(const NLayout& layout) {
+    std::string key;
+    ForEachLeaf<LayoutDecision>(layout, [&](const LayoutDecision& leaf) {
+      key += leaf.defined() ? leaf.name() : std::string("null");
+      key += ";";
+    });
+    return key;
+  }
+
+  /*! \brief Pick, for every planned var, the realized layout with the most votes. */
+  std::unordered_map<Var, NLayout> Finalize() {
+    std::unordered_map<Var, NLayout> realized;
+    for (const auto& [var, produced_layout] : produced_) {
+      auto it = wants_.find(var);
+      if (it == wants_.end() || HasUnknownDimTensor(produced_layout)) continue;
+      // Realizing in the produced layout saves the conversion at the definition,
+      // so it gets one extra vote and wins all ties.
+      int best_votes = 1;
+      auto produced_it = it->second.find(LayoutKey(produced_layout));
+      if (produced_it != it->second.end()) {
+        best_votes += produced_it->second.second;
+      }
+      NLayout best_layout = produced_layout;
+      bool changed = false;
+      for (const auto& [key, layout_votes] : it->second) {
+        if (layout_votes.second > best_votes &&
+            !NLayoutEqual()(layout_votes.first, produced_layout) &&
+            !HasUnknownDimTensor(layout_votes.first)) {
+          best_votes = layout_votes.second;
+          best_layout = layout_votes.first;
+          changed = true;
+        }
+      }
+      if (changed) {
+        realized[var] = best_layout;
+      }
+    }
+    return realized;
+  }
+
+  std::unordered_map<Var, NLayout> var_layout_map_;
+  /*! \brief The inferred output layout of every planned dataflow var, in binding order. */
+  std::vector<std::pair<Var, NLayout>> produced_;
+  /*! \brief Per var, the vote count of every layout some consumer expects. */
+  std::unordered_map<Var, std::unordered_map<std::string, std::pair<NLayout, int>>> wants_;
+  ffi::Map<ffi::String, ffi::Array<ffi::String>> desired_layouts_;
+  LayoutCb layout_cb_;
+};
+
 /*!
  * \brief Main logic to convert the layout of conv2d. Other ops
  * can adapt to such layout conversion following conv2d accordingly.
@@ -65,6 +286,8 @@ using LayoutCb = tvm::relax::transform::LayoutCb;
  * we collect the current SLayout of each input var, and let the InferLayout function to infer the
  * desired layout of the output. The rewriter will use these info to convert
  * the layout of inputs and attrs of the op call, and note down the new layout of the output.
+ * A planning pass (LayoutPlanner above) runs first and decides which layout each var is
+ * realized in, so that conversions are placed where they cost the least overall.
  *
  * The desired layout of conv2d ops is a map from the name of the op to the desired layout of the
  * desired feature map, weight and output. For example, if we want to convert the layout of conv2d
@@ -81,8 +304,11 @@ using LayoutCb = tvm::relax::transform::LayoutCb;
 class LayoutConvertMutator : public ExprMutator {
  public:
   explicit LayoutConvertMutator(
-      const ffi::Map<ffi::String, ffi::Array<ffi::String>>& desired_layouts, LayoutCb layout_cb)
-      : desired_layouts_(desired_layouts), layout_cb_(layout_cb) {}
+      const ffi::Map<ffi::String, ffi::Array<ffi::String>>& desired_layouts, LayoutCb layout_cb,
+      std::unordered_map<Var, NLayout> realized_layouts = {})
+      : desired_layouts_(desired_layouts),
+        layout_cb_(layout_cb),
+        realized_layouts_(std::move(realized_layouts)) {}
 
  private:
   ffi::Array<int64_t> LayoutToIntegers(const SLayout& layout) {
@@ -180,50 +406,6 @@ class LayoutConvertMutator : public ExprMutator {
 
   Expr VisitExpr_(const VarNode* op) final { return VisitVars_(ffi::GetRef<Var>(op)); }
 
-  bool HasUnknownDimTensor(const NLayout& nlayout) {
-    bool find = false;
-    auto fvisit = [&](const LayoutDecision& layout) {
-      find = find | (NLayoutEqual()(layout, LayoutDecision::InitUnknownDim()));
-    };
-    ForEachLeaf<LayoutDecision>(nlayout, fvisit);
-    return find;
-  }
-
-  bool HasUnknownDimTensor(const ffi::Array<Expr>& args) {
-    for (const auto& arg : args) {
-      if (IsNestedTensor(arg)) {
-        if (HasUnknownDimTensor(GetNLayout(var_layout_map_, arg))) {
-          return true;
-        }
-      }
-    }
-    return false;
-  }
-
-  ffi::Optional<InferLayoutOutput> GetInferLayoutInfo(
-      const CallNode* call_node,
-      const ffi::Map<ffi::String, ffi::Array<ffi::String>>& desired_layouts,
-      const LayoutCb& layout_cb, const VarLayoutMap& var_layout_map) {
-    const OpNode* op_node = call_node->op.as<OpNode>();
-    if (op_node == nullptr) return std::nullopt;
-    Op op = ffi::GetRef<Op>(op_node).as_or_throw<Op>();
-    const auto attr_map = Op::GetAttrMap<FRelaxInferLayout>("FRelaxInferLayout");
-    if (attr_map.count(op) && !HasUnknownDimTensor(call_node->args)) {
-      // If the op has FRelaxInferLayout, and all the input tensors have known ndim
-      FRelaxInferLayout f = attr_map[op];
-      auto call = ffi::GetRef<Call>(call_node);
-      if (layout_cb != nullptr) {
-        auto custom_layouts = layout_cb(call);
-        return f(call, custom_layouts, var_layout_map);
-      } else {
-        return f(call, desired_layouts, var_layout_map);
-      }
-    } else {
-      // Otherwise, we use the default policy.
-      return std::nullopt;
-    }
-  }
-
   void VisitBinding_(const VarBindingNode* binding, const CallNode* call_node) final {
     ffi::Optional<InferLayoutOutput> res =
         GetInferLayoutInfo(call_node, desired_layouts_, layout_cb_, var_layout_map_);
@@ -253,10 +435,20 @@ class LayoutConvertMutator : public ExprMutator {
       new_call->attrs = std::move(res.value()->new_attrs);
       Expr cur_call = builder_->Normalize(Call(new_call));
       if (binding->var->IsInstance<DataflowVarNode>()) {
+        NLayout out_layout = res.value()->output_layouts[0];
+        auto planned = realized_layouts_.find(binding->var);
+        if (planned != realized_layouts_.end() && !NLayoutEqual()(planned->second, out_layout)) {
+          // The planner realizes this var in the layout most of its consumers expect,
+          // converting once at the definition instead of once per consumer.
+          Var new_var = builder_->Emit(cur_call);
+          var_layout_map_[new_var] = out_layout;
+          cur_call = builder_->Normalize(RewriteExpr(new_var, planned->second));
+          out_layout = planned->second;
+        }
         // Dataflow var, we emit the rewritten call.
         ReEmitBinding(binding, cur_call);
         // update the layout map
-        var_layout_map_[binding->var] = res.value()->output_layouts[0];
+        var_layout_map_[binding->var] = out_layout;
       } else {
         // Global var (tensor), we rewrite it to initial layout
         TVM_FFI_ICHECK(IsNestedTensor(binding->var));
@@ -343,12 +535,16 @@ class LayoutConvertMutator : public ExprMutator {
   std::unordered_map<Var, NLayout> var_layout_map_;
   ffi::Map<ffi::String, ffi::Array<ffi::String>> desired_layouts_;
   LayoutCb layout_cb_;
+  /*! \brief The realized layout planned for dataflow vars that should not be
+   * materialized in their inferred output layout. */
+  std::unordered_map<Var, NLayout> realized_layouts_;
 };  // namespace relax
 
 DataflowBlock ConvertLayoutPass(const DataflowBlock& df_block,
                                 ffi::Map<ffi::String, ffi::Array<ffi::String>> desired_layouts,
                                 LayoutCb layout_cb) {
-  LayoutConvertMutator mutator(desired_layouts, layout_cb);
+  auto realized_layouts = LayoutPlanner::Plan(df_block, desired_layouts, layout_cb);
+  LayoutConvertMutator mutator(desired_layouts, layout_cb, std::move(realized_layouts));
   return mutator.VisitBindingBlock(df_block).as_or_throw<DataflowBlock>();
 }
 
@@ -574,11 +574,15 @@ bool InplaceConditionsMet(
   }
 }
 
-// this is obviously not a complete list
-static std::unordered_set<std::string> SUPPORTED_OPS = {"relax.add",      "relax.subtract",
-                                                        "relax.multiply", "relax.divide",
-                                                        "relax.nn.silu",  "relax.nn.relu"};
-bool OpSupportsInplace(const Op& op) { return SUPPORTED_OPS.count(op->name); }
+// Operators declare their eligibility through the FInplaceEligible attribute
+// (set by the elementwise registration macros). The planner still verifies
+// liveness, aliasing, and size/type compatibility for every candidate argument,
+// so the attribute only states that the op's computation pattern permits
+// writing the result over one of its inputs.
+bool OpSupportsInplace(const Op& op) {
+  static const auto inplace_map = Op::GetAttrMap<bool>("FInplaceEligible");
+  return inplace_map.count(op) && inplace_map[op];
+}
 
 /*! \brief Corresponds to a binding where at least one argument meets the conditions to be
  *  made in-place. Contains the binding index and indices of the applicable arguments
@@ -18,6 +18,7 @@
  */
 
 #include <tvm/ffi/cast.h>
+#include <tvm/ffi/container/tensor.h>
 #include <tvm/ffi/extra/module.h>
 #include <tvm/ffi/reflection/registry.h>
 #include <tvm/ir/function.h>
@@ -30,14 +31,62 @@
 #include <tvm/tirx/function.h>
 #include <tvm/tirx/op.h>
 
+#include <algorithm>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "../../support/env.h"
+#include "../../support/utils.h"
+
 namespace tvm {
 namespace relax {
 
+namespace {
+/*!
+ * \brief Process-wide memo of successful constant folds.
+ *
+ * Quantized models repeat the same weight transform many times; the memo lets
+ * every occurrence after the first reuse the already-computed constant. The
+ * key is the combined structural hash of the PrimFunc and the call, which
+ * covers the constant argument data. A result is only published once its
+ * tensors have been fully evaluated.
+ */
+class FoldResultCache {
+ public:
+  static FoldResultCache* Global() {
+    static auto* inst = new FoldResultCache();
+    return inst;
+  }
+
+  std::optional<Expr> Lookup(uint64_t key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = memo_.find(key);
+    if (it == memo_.end()) return std::nullopt;
+    return it->second;
+  }
+
+  void Insert(uint64_t key, Expr result) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    memo_.emplace(key, std::move(result));
+  }
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<uint64_t, Expr> memo_;
+};
+}  // namespace
+
 class ConstantFolder : public ExprMutator {
  public:
   static Function Fold(Function func, IRModule ctx_module) {
     ConstantFolder folder(std::move(ctx_module));
-    func = RemoveAllUnused(folder(func)).as_or_throw<Function>();
+    func = folder(func).as_or_throw<Function>();
+    folder.FlushPendingEvals();
+    func = RemoveAllUnused(func).as_or_throw<Function>();
     return func;
   }
 
@@ -197,39 +246,29 @@ class ConstantFolder : public ExprMutator {
   // Returns std::nullopt on failure.
   ffi::Optional<Expr> ConstEvaluateCallTIR(tirx::PrimFunc tir_func,
                                            ffi::Array<runtime::Tensor> arr_args, ffi::Shape shape,
-                                           DLDataType ret_type) {
+                                           DLDataType ret_type, uint64_t memo_key) {
     // obtain function from the cache.
     ffi::Optional<ffi::Function> func = GetCachedBuild(tir_func);
     if (!func) return std::nullopt;
 
-    // here the vector size has an additional + 1 because we need to put ret_tensor at the end
-    std::vector<AnyView> packed_args(arr_args.size() + 1);
-
     DLDevice cpu_dev = {DLDeviceType::kDLCPU, 0};
     runtime::Tensor ret_tensor = runtime::Tensor::Empty(shape, ret_type, cpu_dev);
 
     // avoid set rvalue ref which get de-allocated later, store args in a vector
-    // where temp_args[i] are lvalue ref that is stable
-    std::vector<runtime::Tensor> temp_args(arr_args.begin(), arr_args.end());
-
-    size_t arg_offset = 0;
-    for (; arg_offset < arr_args.size(); ++arg_offset) {
-      packed_args[arg_offset] = temp_args[arg_offset];
-    }
-    // set return value
-    packed_args[arg_offset++] = ret_tensor;
+    // where packed[i] are lvalue refs that are stable
+    std::vector<runtime::Tensor> packed(arr_args.begin(), arr_args.end());
+    // the output tensor goes at the end
+    packed.push_back(ret_tensor);
 
-    ffi::Any ret;
-    // invoke
-    func.value().CallPacked(ffi::PackedArgs(packed_args.data(), packed_args.size()), &ret);
-    return Constant(ret_tensor);
+    return EnqueueEval(func.value(), std::move(packed), /*num_outputs=*/1, Constant(ret_tensor),
+                       memo_key);
   }
 
   // Try constant evaluate a call_tir with tuple outputs (multiple output tensors).
   // Returns std::nullopt on failure.
   ffi::Optional<Expr> ConstEvaluateCallTIRTuple(tirx::PrimFunc tir_func,
                                                 ffi::Array<runtime::Tensor> arr_args,
-                                                const TupleTypeNode* tuple_ty) {
+                                                const TupleTypeNode* tuple_ty, uint64_t memo_key) {
     ffi::Optional<ffi::Function> func = GetCachedBuild(tir_func);
     if (!func) return std::nullopt;
 
@@ -248,24 +287,91 @@ class ConstantFolder : public ExprMutator {
     }
 
     // Pack input args + all output tensors.
-    std::vector<runtime::Tensor> temp_args(arr_args.begin(), arr_args.end());
-    std::vector<AnyView> packed_args;
-    packed_args.reserve(temp_args.size() + num_outputs);
-    for (const auto& arg : temp_args) {
-      packed_args.push_back(arg);
-    }
-    for (const auto& out_tensor : ret_tensors) {
-      packed_args.push_back(out_tensor);
-    }
-
-    ffi::Any ret;
-    func.value().CallPacked(ffi::PackedArgs(packed_args.data(), packed_args.size()), &ret);
+    std::vector<runtime::Tensor> packed(arr_args.begin(), arr_args.end());
+    packed.insert(packed.end(), ret_tensors.begin(), ret_tensors.end());
 
     ffi::Array<Expr> fields;
     for (size_t i = 0; i < num_outputs; ++i) {
       fields.push_back(Constant(ret_tensors[i]));
     }
-    return Tuple(fields);
+    return EnqueueEval(func.value(), std::move(packed), num_outputs, Tuple(fields), memo_key);
+  }
+
+  /*!
+   * \brief A deferred evaluation of a built TIR function.
+   *
+   * The output tensors have already been handed out as Constants; their data
+   * is filled in when the evaluation runs in FlushPendingEvals.
+   */
+  struct PendingEval {
+    /*! \brief The built function to call. */
+    ffi::Function func;
+    /*! \brief Input tensors followed by output tensors, in packed-call order. */
+    std::vector<runtime::Tensor> packed;
+    /*! \brief How many entries at the end of `packed` are outputs. */
+    size_t num_outputs;
+    /*! \brief The folded expression the outputs were wrapped into. */
+    Expr result;
+    /*! \brief Key under which to publish the result once evaluated. */
+    uint64_t memo_key;
+  };
+
+  /*!
+   * \brief Defer the evaluation of a folded call and return its result expression.
+   *
+   * Deferring keeps allocation and IR rewriting decoupled from kernel
+   * execution; the post-order traversal guarantees producers are enqueued
+   * before their consumers, so flushing in enqueue order is always valid.
+   */
+  Expr EnqueueEval(ffi::Function func, std::vector<runtime::Tensor> packed, size_t num_outputs,
+                   Expr result, uint64_t memo_key) {
+    size_t num_inputs = packed.size() - num_outputs;
+    for (size_t i = num_inputs; i < packed.size(); ++i) {
+      pending_outputs_.insert(packed[i]->data);
+      pending_bytes_ += ffi::GetDataSize(*(packed[i].operator->()));
+    }
+    pending_evals_.push_back(
+        PendingEval{std::move(func), std::move(packed), num_outputs, result, memo_key});
+
+    // Cap the memory held by not-yet-evaluated batches; a cap of zero makes
+    // every fold run immediately, restoring fully eager evaluation.
+    if (pending_bytes_ >= PendingEvalByteCap()) {
+      FlushPendingEvals();
+    }
+    return result;
+  }
+
+  /*!
+   * \brief Evaluate all deferred folds in enqueue order.
+   *
+   * The kernels run on the calling thread: folded PrimFuncs frequently
+   * contain parallel loops of their own, and the thread pool rejects parallel
+   * launches from inside a worker, so dispatching the batch through the pool
+   * would abort. Running here lets each kernel use the pool itself.
+   */
+  void FlushPendingEvals() {
+    for (PendingEval& task : pending_evals_) {
+      std::vector<AnyView> packed_args(task.packed.size());
+      for (size_t j = 0; j < task.packed.size(); ++j) {
+        packed_args[j] = task.packed[j];
+      }
+      ffi::Any ret;
+      task.func.CallPacked(ffi::PackedArgs(packed_args.data(), packed_args.size()), &ret);
+    }
+
+    // Publish the results only now that their tensors hold final data.
+    for (const PendingEval& task : pending_evals_) {
+      FoldResultCache::Global()->Insert(task.memo_key, task.result);
+    }
+    pending_evals_.clear();
+    pending_outputs_.clear();
+    pending_bytes_ = 0;
+  }
+
+  static size_t PendingEvalByteCap() {
+    static size_t cap = static_cast<size_t>(std::max<int64_t>(
+        support::GetEnv<int64_t>("TVM_RELAX_FOLD_BATCH_BYTES", int64_t{64} << 20), 0));
+    return cap;
   }
 
   // Returns the folded expr if the call is successfully folded to constant, otherwise null.
@@ -280,9 +386,17 @@ class ConstantFolder : public ExprMutator {
 
     if (!func || !arr_args) return {};
 
+    // Memoize successful folds across functions. The key covers the PrimFunc
+    // body and the call, including the constant argument data.
+    uint64_t memo_key =
+        support::HashCombine(ffi::StructuralHash()(func.value()), ffi::StructuralHash()(call));
+    if (auto cached = FoldResultCache::Global()->Lookup(memo_key)) {
+      return cached.value();
+    }
+
     // Handle tuple output: ty_args[0] is a TupleType.
     if (const auto* tuple_ty = call->ty_args[0].as<TupleTypeNode>()) {
-      return ConstEvaluateCallTIRTuple(func.value(), arr_args.value(), tuple_ty);
+      return ConstEvaluateCallTIRTuple(func.value(), arr_args.value(), tuple_ty, memo_key);
     }
 
     // Handle single tensor output.
@@ -290,7 +404,7 @@ class ConstantFolder : public ExprMutator {
     if (shape) {
       TensorType ret_ty = call->ty.as_or_throw<TensorType>();
       return ConstEvaluateCallTIR(func.value(), arr_args.value(), shape.value(),
-                                  ret_ty->dtype.value()->dtype)
+                                  ret_ty->dtype.value()->dtype, memo_key)
           .value_or({});
     }
     return {};
@@ -370,6 +484,10 @@ class ConstantFolder : public ExprMutator {
         if (arg->IsInstance<ConstantNode>()) {
           Constant constant = arg.as_or_throw<Constant>();
           runtime::Tensor ndarray = constant->data;
+          // The constant may be the output of a not-yet-evaluated fold.
+          if (pending_outputs_.count(ndarray->data)) {
+            FlushPendingEvals();
+          }
           TVM_FFI_ICHECK_EQ(ndarray->device.device_type, kDLCPU);
           TVM_FFI_ICHECK(ndarray.IsContiguous());
           TVM_FFI_ICHECK_EQ(ndarray->byte_offset, 0);
@@ -419,6 +537,12 @@ class ConstantFolder : public ExprMutator {
   std::unordered_map<tirx::PrimFunc, ffi::Optional<ffi::Function>, ffi::StructuralHash,
                      ffi::StructuralEqual>
       func_build_cache_;
+  // deferred fold evaluations, flushed in enqueue order
+  std::vector<PendingEval> pending_evals_;
+  // data pointers of the not-yet-evaluated output tensors
+  std::unordered_set<const void*> pending_outputs_;
+  // total bytes of pending output tensors
+  size_t pending_bytes_ = 0;
 };
 
 namespace transform {
@@ -0,0 +1,99 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file tvm/relax/transform/fuse_dequantize_matmul.cc
+ * \brief Fuse `dequantize` into the `matmul` consuming its result, so that
+ * the quantized weight is dequantized inside the matmul kernel instead of
+ * being materialized in full precision first.
+ */
+
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/relax/dataflow_matcher.h>
+#include <tvm/relax/expr.h>
+#include <tvm/relax/transform.h>
+
+namespace tvm {
+namespace relax {
+namespace transform {
+
+namespace {
+
+/*!
+ * \brief Only fuse when every matched intermediate (the dequantized weight,
+ * and its transpose when present) has no consumer besides the matched chain.
+ * Otherwise the dequantization would be recomputed once per extra consumer.
+ */
+bool IntermediatesHaveSingleUse(const PatternCheckContext& ctx) {
+  for (const auto& [name, expr] : ctx->annotated_expr) {
+    auto bound_var = ctx->value_to_bound_var.Get(expr);
+    if (!bound_var.has_value()) {
+      return false;
+    }
+    auto usages = ctx->var_usages.Get(bound_var.value());
+    if (!usages.has_value() || usages.value().size() != 1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+FusionPattern DequantizeMatmulPattern() {
+  auto dequantized = IsOp("relax.dequantize")(WildcardPattern(), WildcardPattern(),
+                                              WildcardPattern());
+  auto matmul = IsOp("relax.matmul")(WildcardPattern(), dequantized);
+  return FusionPattern("dequantize_matmul", matmul, {{"dequantized", dequantized}},
+                       ffi::Function::FromTyped(IntermediatesHaveSingleUse), std::nullopt);
+}
+
+FusionPattern DequantizeTransposeMatmulPattern() {
+  auto dequantized = IsOp("relax.dequantize")(WildcardPattern(), WildcardPattern(),
+                                              WildcardPattern());
+  auto transposed = IsOp("relax.permute_dims")(dequantized);
+  auto matmul = IsOp("relax.matmul")(WildcardPattern(), transposed);
+  return FusionPattern("dequantize_transpose_matmul", matmul,
+                       {{"dequantized", dequantized}, {"transposed", transposed}},
+                       ffi::Function::FromTyped(IntermediatesHaveSingleUse), std::nullopt);
+}
+
+}  // namespace
+
+Pass FuseDequantizeMatmul() {
+  // The more specific transposed pattern must be matched before the plain
+  // one, so that the transpose is pulled into the fused group as well.
+  ffi::Array<FusionPattern> patterns = {DequantizeTransposeMatmulPattern(),
+                                        DequantizeMatmulPattern()};
+  // bind_constants=false lifts the quantized weight (and its scales) out of
+  // the grouped function, so the weight remains a parameter of the outer
+  // function and AttachAttrLayoutFreeBuffers can later mark it layout-free
+  // in the fused PrimFunc.
+  auto pass = FuseOpsByPattern(patterns, /*bind_constants=*/false,
+                               /*annotate_codegen=*/false,
+                               /*entry_function_names=*/{});
+  return tvm::transform::Sequential({pass}, "FuseDequantizeMatmul");
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("relax.transform.FuseDequantizeMatmul", FuseDequantizeMatmul);
+}
+
+}  // namespace transform
+}  // namespace relax
+}  // namespace tvm
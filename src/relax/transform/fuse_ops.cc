@@ -36,6 +36,7 @@
 #include <tvm/relax/transform.h>
 #include <tvm/relax/type.h>
 #include <tvm/runtime/logging.h>
+#include <tvm/target/target.h>
 #include <tvm/tirx/analysis.h>
 #include <tvm/tirx/expr_functor.h>
 #include <tvm/tirx/function.h>
@@ -44,6 +45,7 @@
 
 #include "../../support/arena.h"
 #include "../analysis/graph_partitioner.h"
+#include "../backend/pattern_registry.h"
 #include "tvm/relax/expr.h"
 #include "utils.h"
 
@@ -100,6 +102,7 @@ using support::LinkNode;
 constexpr uint32_t kMaxFusedOps = 256;
 
 TVM_REGISTER_PASS_CONFIG_OPTION("relax.FuseOps.max_depth", int64_t);
+TVM_REGISTER_PASS_CONFIG_OPTION("relax.FuseOps.max_fused_bytes", int64_t);
 
 class GraphCreator : public ExprVisitor {
  public:
@@ -1043,15 +1046,17 @@ class OperatorFusor : public ExprMutator {
   bool lift_constants_{true};
 };
 
-IRModule FuseOps(IRModule mod, int opt_level, size_t max_fuse_depth) {
-  support::Arena arena;
+IRModule FuseOps(IRModule mod, int opt_level, size_t max_fuse_depth, size_t max_fused_bytes) {
+  support::WorkspaceArenaScope arena_scope;
+  support::Arena* arena = arena_scope.get();
 
   // Step 1. Create the indexed-forward graph according to the input IRModule.
-  IndexedForwardGraph graph = GraphCreator::Create(mod, &arena);
+  IndexedForwardGraph graph = GraphCreator::Create(mod, arena);
 
   // Step 2. Partition the graph by applying the fusion algorithm.
   std::vector<GraphPartitioner::Group*> groups =
-      GraphPartitioner(&arena, opt_level, max_fuse_depth, /*max_function_args=*/0).Partition(graph);
+      GraphPartitioner(arena, opt_level, max_fuse_depth, /*max_function_args=*/0, max_fused_bytes)
+          .Partition(graph);
 
   // Step 3. Transform the IRModule by fusing the operators in accordance with the graph partition
   // results.
@@ -1092,6 +1097,7 @@ class PatternBasedPartitioner : ExprVisitor {
                           support::Arena* arena, FAttrsGetter attrs_getter)
       : pat_name_(pattern_name),
         pat_(pattern),
+        root_op_(backend::GetPatternRootOp(pattern)),
         annotation_pat_(annotation_patterns),
         check_(check),
         arena_(arena),
@@ -1119,6 +1125,11 @@ class PatternBasedPartitioner : ExprVisitor {
 
   void VisitBinding_(const VarBindingNode* binding, const CallNode* call) final {
     VisitVarDef(binding->var);
+    // A pattern rooted at a specific operator can only match a call to that
+    // operator; skip the full matcher for every other call node.
+    if (root_op_.has_value() && !call->op.same_as(root_op_.value())) {
+      return;
+    }
     if (auto matches_opt = ExtractMatchedExpr(pat_, ffi::GetRef<Call>(call), bindings_)) {
       const auto& context = CreatePatternCheckContext(call, matches_opt.value());
       if (check_ != nullptr && !check_(context)) {
@@ -1239,6 +1250,8 @@ class PatternBasedPartitioner : ExprVisitor {
 
   ffi::String pat_name_;
   DFPattern pat_;
+  /*! \brief The operator the pattern is rooted at, when statically known. */
+  ffi::Optional<Op> root_op_;
   ffi::Map<ffi::String, DFPattern> annotation_pat_;
   FCheckMatch check_;
   support::Arena* arena_;
@@ -1351,7 +1364,7 @@ class CompositeFunctionAnnotator : public ExprMutator {
 IRModule FuseOpsByPattern(const tvm::ffi::Array<transform::FusionPattern>& patterns, IRModule mod,
                           bool bind_constants, bool annotate_codegen,
                           ffi::Array<ffi::String> entry_function_names) {
-  support::Arena arena;
+  support::WorkspaceArenaScope arena_scope;
 
   for (const auto& pattern : patterns) {
     ffi::Array<Function> entry_functions;
@@ -1382,7 +1395,8 @@ IRModule FuseOpsByPattern(const tvm::ffi::Array<transform::FusionPattern>& patte
     for (const auto& func : entry_functions) {
       auto map = PatternBasedPartitioner::Run(
           pattern->name, pattern->pattern, pattern->annotation_patterns,
-          pattern->check.value_or(nullptr), func, &arena, pattern->attrs_getter.value_or(nullptr));
+          pattern->check.value_or(nullptr), func, arena_scope.get(),
+          pattern->attrs_getter.value_or(nullptr));
       for (const auto& [key, value] : map) {
         TVM_FFI_CHECK(!group_map.count(key), ValueError)
             << "IRModule is invalid.  "
@@ -1445,7 +1459,21 @@ Pass FuseOps(int fuse_opt_level) {
       [=](IRModule m, PassContext pc) {
         int opt_level = fuse_opt_level == -1 ? pc->opt_level : fuse_opt_level;
         auto max_fuse_depth = pc->GetConfig<int64_t>("relax.FuseOps.max_depth", kMaxFusedOps);
-        return relax::FuseOps(m, opt_level, static_cast<size_t>(max_fuse_depth.value()));
+        // Byte budget for the tensors produced inside one fused function.
+        // 0 (default) disables the limit; -1 derives the budget from the
+        // current target's shared memory capacity.
+        int64_t max_fused_bytes =
+            pc->GetConfig<int64_t>("relax.FuseOps.max_fused_bytes", int64_t{0}).value();
+        if (max_fused_bytes < 0) {
+          max_fused_bytes = 0;
+          if (Target target = Target::Current(); target.defined()) {
+            if (auto smem = target->GetAttr<int64_t>("max_shared_memory_per_block")) {
+              max_fused_bytes = smem.value();
+            }
+          }
+        }
+        return relax::FuseOps(m, opt_level, static_cast<size_t>(max_fuse_depth.value()),
+                              static_cast<size_t>(max_fused_bytes));
       };
   return CreateModulePass(/*pass_function=*/pass_func,  //
                           /*opt_level=*/0,              //
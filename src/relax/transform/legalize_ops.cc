@@ -290,10 +290,8 @@ class LegalizeMutator : public ExprMutator {
 
       bool is_data_dependent_op = [&]() -> bool {
         if (Op::HasAttrMap("FDataDependent")) {
-          auto op_map = Op::GetAttrMap<bool>("FDataDependent");
-          if (op_map.count(op)) {
-            return op_map[op];
-          }
+          static const auto op_map = Op::GetAttrTable<bool>("FDataDependent");
+          return op_map.get(op, false);
         }
         return false;
       }();
@@ -838,6 +838,13 @@ Pass LiftTransformParams(ffi::Variant<bool, ffi::Array<ffi::String>> shared_tran
         std::string func_name = gvar->name_hint;
         if (ends_with(func_name, "transform_params")) {
           func = WithAttr(func, tvm::attr::kGlobalSymbol, gvar->name_hint);
+          // Frontends emit weight preprocessing once per layer, so the lifted
+          // function typically repeats identical subexpressions (shared scale
+          // computations, repeated reads of the same bundled weight) for every
+          // layer.  Value-number the function so each distinct computation is
+          // performed once and reused, before any further specialization.
+          func = EliminateCommonSubexpr(func).as_or_throw<Function>();
+          func = RemoveAllUnused(std::move(func)).as_or_throw<Function>();
           if (pc->GetConfig<bool>(kLiftTransformConsumeParams).value_or(false)) {
             func = ConsumeBundledParams()(func).as_or_throw<Function>();
           }
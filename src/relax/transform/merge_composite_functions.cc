@@ -403,8 +403,8 @@ class CompositeFunctionAnnotator : public ExprMutator {
 IRModule MergeCompositeFunctions(IRModule mod) {
   auto gvar = mod->GetGlobalVar("main");
   auto func = mod->Lookup(gvar).as_or_throw<Function>();
-  support::Arena arena;
-  auto group_map = CompositeGroupsBuilder(mod, &arena).Run(func);
+  support::WorkspaceArenaScope arena_scope;
+  auto group_map = CompositeGroupsBuilder(mod, arena_scope.get()).Run(func);
   auto new_mod = MakeGroupedFunctions(mod, group_map);
   new_mod = CompositeFunctionAnnotator(mod, new_mod).update();
 
@@ -0,0 +1,145 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/relax/transform/overlap_device_transfers.cc
+ * \brief Overlap cross-device transfers with compute.
+ *
+ * `to_vdevice` lowers to the blocking `vm.builtin.to_device` builtin, so a
+ * pipeline-parallel function stalls on every cross-device transfer even when
+ * independent compute could run in the meantime. This pass splits each
+ * transfer inside a dataflow block into two builtin calls:
+ *
+ *  - `vm.builtin.to_device_async` at the original binding site, which issues
+ *    the copy on a dedicated per-device copy stream and returns immediately;
+ *  - `vm.builtin.device_transfer_wait` in front of the first binding that
+ *    consumes the result, which makes the consumer's compute stream wait on
+ *    the copy (or blocks the host when the data crossed device types).
+ *
+ * The wait takes the transferred tensor and returns it, so the
+ * synchronization is carried by ordinary dataflow and survives dead-code
+ * elimination without any new VM opcodes. Compute issued between the copy and
+ * its first consumer overlaps with the transfer. Only transfers to the
+ * "global" memory scope whose result is consumed within the same dataflow
+ * block are rewritten; the rest keep the synchronous builtin.
+ */
+
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/relax/analysis.h>
+#include <tvm/relax/attrs/op.h>
+#include <tvm/relax/expr.h>
+#include <tvm/relax/expr_functor.h>
+#include <tvm/relax/transform.h>
+#include <tvm/target/target.h>
+
+#include <string>
+#include <unordered_set>
+#include <utility>
+
+namespace tvm {
+namespace relax {
+
+namespace {
+
+class TransferOverlapRewriter : public ExprMutator {
+ public:
+  static Function Rewrite(Function func) {
+    TransferOverlapRewriter mutator;
+    return mutator.VisitExpr(std::move(func)).as_or_throw<Function>();
+  }
+
+ private:
+  BindingBlock VisitBindingBlock_(const DataflowBlockNode* block) final {
+    consumed_in_block_.clear();
+    pending_.clear();
+    for (const Binding& binding : block->bindings) {
+      for (const Var& var : FreeVars(GetBoundValue(binding))) {
+        consumed_in_block_.insert(var);
+      }
+    }
+
+    builder_->BeginDataflowBlock();
+    for (const Binding& binding : block->bindings) {
+      // Synchronize with any in-flight copy this binding consumes, and route
+      // its later uses through the wait result so ordering is kept by
+      // dataflow.
+      for (const Var& var : FreeVars(GetBoundValue(binding))) {
+        if (!pending_.count(var)) continue;
+        Call wait(call_pure_packed_, {builtin_transfer_wait_, VisitExpr(var)}, Attrs(),
+                  {GetType(var)});
+        Var ready = builder_->Emit(wait, std::string(var->name_hint) + "_ready");
+        var_remap_[var->vid] = ready;
+        pending_.erase(var);
+      }
+      VisitBinding(binding);
+    }
+    pending_.clear();
+    return builder_->EndBlock();
+  }
+
+  void VisitBinding_(const VarBindingNode* binding, const CallNode* call_node) final {
+    static const Op& to_vdevice_op = Op::Get("relax.to_vdevice");
+    if (call_node->op.same_as(to_vdevice_op) && binding->var->IsInstance<DataflowVarNode>() &&
+        consumed_in_block_.count(binding->var)) {
+      const auto* attrs = call_node->attrs.as<ToVDeviceAttrs>();
+      VDevice vdev = attrs->dst_vdevice;
+      if (vdev->memory_scope == "global") {
+        auto call = VisitExpr(ffi::GetRef<Expr>(call_node)).as_or_throw<Call>();
+        Call async(call_pure_packed_,
+                   {builtin_to_device_async_, call->args[0],
+                    IntImm::Int64(vdev->target->GetTargetDeviceType()),
+                    IntImm::Int64(vdev->vdevice_id)},
+                   Attrs(), {GetType(binding->var)});
+        ReEmitBinding(binding, builder_->Normalize(async));
+        pending_.insert(binding->var);
+        return;
+      }
+    }
+    ExprMutator::VisitBinding_(binding, call_node);
+  }
+
+  const Op& call_pure_packed_ = Op::Get("relax.call_pure_packed");
+  const ExternFunc builtin_to_device_async_{"vm.builtin.to_device_async"};
+  const ExternFunc builtin_transfer_wait_{"vm.builtin.device_transfer_wait"};
+
+  /*! \brief Variables consumed by some binding of the current dataflow block. */
+  std::unordered_set<Var> consumed_in_block_;
+  /*! \brief Transfer results whose copy has been issued but not yet awaited. */
+  std::unordered_set<Var> pending_;
+};
+
+}  // namespace
+
+namespace transform {
+
+Pass OverlapDeviceTransfers() {
+  auto pass_func = [=](Function func, IRModule mod, PassContext pc) {
+    return TransferOverlapRewriter::Rewrite(std::move(func));
+  };
+  return CreateFunctionPass(pass_func, 0, "OverlapDeviceTransfers", {});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("relax.transform.OverlapDeviceTransfers", OverlapDeviceTransfers);
+}
+
+}  // namespace transform
+}  // namespace relax
+}  // namespace tvm
@@ -86,7 +86,8 @@ Pass RemovePurityChecking() {
   auto pass_func = [=](const Function& f, IRModule mod, PassContext pc) {
     return relax::RemovePurityChecking(f);
   };
-  return CreateFunctionPass(pass_func, 0, "RemovePurityChecking", {});
+  return CreateFunctionPass(pass_func, 0, "RemovePurityChecking", {}, /*traceable=*/false,
+                            /*function_local=*/true);
 }
 
 TVM_FFI_STATIC_INIT_BLOCK() {
@@ -0,0 +1,201 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/relax/transform/rewrite_attention_kv_cache.cc
+ * \brief Rewrite stateless attention chains to the paged KV cache runtime.
+ *
+ * Models imported from frontends express self-attention as three QKV
+ * projections of the hidden state followed by `relax.nn.attention`. This pass
+ * recognizes that chain and rewrites it to
+ * `vm.builtin.attention_kv_cache_attention_with_fused_qkv`, the paged KV
+ * cache builtin from src/runtime/vm/kv_state.cc. The builtin appends the new
+ * keys and values to the cache and attends over the full cached history, and
+ * applies rotary embedding itself according to the cache's RoPE mode, so
+ * neither a separate cache-append step nor an explicit rotary subgraph is
+ * needed in the rewritten IR.
+ *
+ * Each rewritten function gains a trailing `paged_kv_cache` object parameter;
+ * the runtime caller creates the cache with
+ * `vm.builtin.paged_attention_kv_cache_create` and brackets invocations with
+ * the usual `vm.builtin.kv_state_begin_forward` / `end_forward` calls.
+ * Attention sites are assigned layer ids in program order, which must match
+ * the layer layout the cache was created with.
+ */
+
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/relax/attrs/nn.h>
+#include <tvm/relax/dataflow_matcher.h>
+#include <tvm/relax/expr.h>
+#include <tvm/relax/transform.h>
+#include <tvm/relax/type.h>
+
+#include <cmath>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "../op/tensor/manipulate.h"
+
+namespace tvm {
+namespace relax {
+
+namespace {
+
+/*! \brief Per-function rewrite state shared with the pattern rewriter. */
+struct RewriteState {
+  /*! \brief The cache object parameter added to the rewritten function. */
+  Var cache;
+  /*! \brief Number of attention sites rewritten so far; doubles as the next layer id. */
+  int64_t num_layers = 0;
+};
+
+/*! \brief Return the shape of the expression if every dimension is a static int. */
+std::optional<std::vector<int64_t>> StaticShape(const Expr& expr) {
+  const auto* tensor_ty = GetType(expr).as<TensorTypeNode>();
+  if (tensor_ty == nullptr) return std::nullopt;
+  auto shape = tensor_ty->GetShape();
+  if (!shape) return std::nullopt;
+  std::vector<int64_t> dims;
+  for (const PrimExpr& dim : shape.value()) {
+    const auto* imm = dim.as<IntImmNode>();
+    if (imm == nullptr || imm->value < 0) return std::nullopt;
+    dims.push_back(imm->value);
+  }
+  return dims;
+}
+
+std::tuple<DFPattern, ffi::TypedFunction<Expr(Expr, ffi::Map<DFPattern, Expr>)>> CreatePatterns(
+    std::shared_ptr<RewriteState> state) {
+  auto pat_hidden = WildcardPattern();
+
+  auto pat_weight_q = WildcardPattern();
+  auto pat_weight_k = WildcardPattern();
+  auto pat_weight_v = WildcardPattern();
+
+  // Sharing pat_hidden across the three projections requires them to read the
+  // same hidden state.
+  auto pat_proj_q = IsOp("relax.matmul")(pat_hidden, pat_weight_q);
+  auto pat_proj_k = IsOp("relax.matmul")(pat_hidden, pat_weight_k);
+  auto pat_proj_v = IsOp("relax.matmul")(pat_hidden, pat_weight_v);
+
+  // Frontends reshape the flat [batch, seq, heads * head_dim] projection to
+  // the BSHD layout that nn.attention expects.
+  auto pat_q = IsOp("relax.reshape")(pat_proj_q, WildcardPattern());
+  auto pat_k = IsOp("relax.reshape")(pat_proj_k, WildcardPattern());
+  auto pat_v = IsOp("relax.reshape")(pat_proj_v, WildcardPattern());
+
+  auto pat_attn = IsOp("relax.nn.attention")(pat_q, pat_k, pat_v);
+
+  auto rewriter = [=](Expr expr, ffi::Map<DFPattern, Expr> matches) -> Expr {
+    auto call = expr.as_or_throw<Call>();
+    const auto* attrs = call->attrs.as<AttentionAttrs>();
+
+    // The paged cache always attends causally over the cached history, so
+    // only causal sites without sliding windows may be redirected to it.
+    if (attrs == nullptr || !attrs->causal_mask.defined() || attrs->window_size.defined()) {
+      return expr;
+    }
+
+    auto q_shape = StaticShape(matches[pat_q]);
+    auto k_shape = StaticShape(matches[pat_k]);
+    auto v_shape = StaticShape(matches[pat_v]);
+    if (!q_shape || !k_shape || !v_shape) return expr;
+    if (q_shape->size() != 4 || *k_shape != *v_shape || k_shape->size() != 4) return expr;
+
+    int64_t batch = (*q_shape)[0];
+    int64_t seq_len = (*q_shape)[1];
+    int64_t num_qo_heads = (*q_shape)[2];
+    int64_t head_dim = (*q_shape)[3];
+    int64_t num_kv_heads = (*k_shape)[2];
+    if ((*k_shape)[0] != batch || (*k_shape)[1] != seq_len || (*k_shape)[3] != head_dim) {
+      return expr;
+    }
+
+    const auto* q_ty = GetType(matches[pat_q]).as<TensorTypeNode>();
+    const auto* k_ty = GetType(matches[pat_k]).as<TensorTypeNode>();
+    if (q_ty->IsUnknownDtype() || k_ty->IsUnknownDtype() ||
+        !(q_ty->dtype.value()->dtype == k_ty->dtype.value()->dtype)) {
+      return expr;
+    }
+
+    double sm_scale = attrs->scale.defined() ? attrs->scale.value()->value
+                                             : 1.0 / std::sqrt(static_cast<double>(head_dim));
+
+    // The builtin takes the projections fused along the head axis and
+    // flattened to one row per token.
+    Expr qkv = concat(Tuple({matches[pat_proj_q], matches[pat_proj_k], matches[pat_proj_v]}),
+                      /*axis=*/-1);
+    int64_t num_tokens = batch * seq_len;
+    qkv = reshape(qkv, ffi::Array<PrimExpr>{IntImm::Int64(num_tokens),
+                                            IntImm::Int64(num_qo_heads + 2 * num_kv_heads),
+                                            IntImm::Int64(head_dim)});
+
+    TensorType out_ty(ShapeExpr({IntImm::Int64(num_tokens), IntImm::Int64(num_qo_heads),
+                                 IntImm::Int64(head_dim)}),
+                      q_ty->dtype);
+    Tuple builtin_args({state->cache, IntImm::Int64(state->num_layers++),
+                        FloatImm(tvm::PrimType::Float(32), sm_scale), qkv});
+    static const Op& call_dps_packed_op = Op::Get("relax.call_dps_packed");
+    static const ExternFunc builtin_attention(
+        "vm.builtin.attention_kv_cache_attention_with_fused_qkv");
+    Expr attn_out = Call(call_dps_packed_op, {builtin_attention, builtin_args}, Attrs(), {out_ty});
+
+    return reshape(attn_out,
+                   ffi::Array<PrimExpr>{IntImm::Int64(batch), IntImm::Int64(seq_len),
+                                        IntImm::Int64(num_qo_heads), IntImm::Int64(head_dim)});
+  };
+
+  return {pat_attn, rewriter};
+}
+
+Function RewriteFunction(Function func) {
+  auto state = std::make_shared<RewriteState>();
+  state->cache = Var("paged_kv_cache", ObjectType());
+
+  auto [pattern, rewriter] = CreatePatterns(state);
+  Function rewritten = RewriteCall(pattern, rewriter, func);
+  if (state->num_layers == 0) return func;
+
+  ffi::Array<Var> params = rewritten->params;
+  params.push_back(state->cache);
+  return Function(params, rewritten->body, rewritten->ret_ty, rewritten->is_pure,
+                  rewritten->attrs);
+}
+
+}  // namespace
+
+namespace transform {
+
+Pass RewriteAttentionKVCache() {
+  auto pass_func = [=](Function func, IRModule mod, PassContext pc) {
+    return RewriteFunction(std::move(func));
+  };
+  return CreateFunctionPass(pass_func, 0, "RewriteAttentionKVCache", {});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("relax.transform.RewriteAttentionKVCache", RewriteAttentionKVCache);
+}
+
+}  // namespace transform
+}  // namespace relax
+}  // namespace tvm
@@ -0,0 +1,176 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/relax/transform/shape_bucket_dispatch.cc
+ * \brief Specialize entry functions for declared symbolic-shape buckets and
+ *        replace them with a runtime dispatcher.
+ *
+ * For every exposed function that uses a bucketed symbolic variable (e.g.
+ * seq_len in {128, 512, 2048}), the pass clones the function once per bucket
+ * value with the variable bound to that constant, so the clone compiles with
+ * fully static shapes. The original function is replaced by a dispatcher that
+ * compares the runtime shape value against the bucket values and calls the
+ * matching clone, falling back to the unmodified dynamic version. The
+ * comparisons are emitted as PrimExpr conditions; ComputePrimValue lowers
+ * them for the VM later in the build pipeline.
+ */
+
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/ir/module.h>
+#include <tvm/relax/analysis.h>
+#include <tvm/relax/block_builder.h>
+#include <tvm/relax/expr.h>
+#include <tvm/relax/transform.h>
+#include <tvm/relax/utils.h>
+#include <tvm/tirx/expr.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace tvm {
+namespace relax {
+
+namespace {
+
+/*! \brief One symbolic dimension of a function together with its declared bucket values. */
+struct BucketedDim {
+  tirx::Var var;
+  ffi::Array<IntImm> values;
+};
+
+std::vector<BucketedDim> CollectBucketedDims(
+    const Function& func, const ffi::Map<ffi::String, ffi::Array<IntImm>>& buckets) {
+  std::vector<BucketedDim> dims;
+  for (const auto& var : DefinedSymbolicVars(func)) {
+    if (auto values = buckets.Get(var->name_hint)) {
+      dims.push_back(BucketedDim{var, values.value()});
+    }
+  }
+  return dims;
+}
+
+/*! \brief Enumerate the cartesian product of the bucket values of each dimension. */
+std::vector<std::vector<IntImm>> EnumerateCombos(const std::vector<BucketedDim>& dims) {
+  std::vector<std::vector<IntImm>> combos{{}};
+  for (const auto& dim : dims) {
+    std::vector<std::vector<IntImm>> next;
+    for (const auto& prefix : combos) {
+      for (const auto& value : dim.values) {
+        auto combo = prefix;
+        combo.push_back(value);
+        next.push_back(std::move(combo));
+      }
+    }
+    combos = std::move(next);
+  }
+  return combos;
+}
+
+IRModule ModuleShapeBucketDispatch(IRModule mod,
+                                   const ffi::Map<ffi::String, ffi::Array<IntImm>>& buckets) {
+  BlockBuilder builder = BlockBuilder::Create(mod);
+  bool changed = false;
+
+  for (const auto& [gvar, base_func] : mod->functions) {
+    auto opt_func = base_func.as<Function>();
+    if (!opt_func) continue;
+    Function func = opt_func.value();
+    if (func->HasNonzeroAttr(attr::kPrimitive)) continue;
+    // Only exposed functions are dispatched; internal helpers keep their
+    // dynamic form and are reached through the specialized callers.
+    auto opt_symbol = func->GetAttr<ffi::String>(tvm::attr::kGlobalSymbol);
+    if (!opt_symbol) continue;
+
+    std::vector<BucketedDim> dims = CollectBucketedDims(func, buckets);
+    if (dims.empty()) continue;
+    std::string base_name = opt_symbol.value();
+
+    // The fallback keeps the original dynamic body under a new name.
+    Function generic = CopyWithNewVars(func);
+    generic = WithAttr(generic, tvm::attr::kGlobalSymbol, ffi::String(base_name + "_generic"));
+    GlobalVar generic_gvar = builder->AddFunction(generic, base_name + "_generic");
+
+    // One fully static clone per bucket combination.
+    std::vector<std::vector<IntImm>> combos = EnumerateCombos(dims);
+    std::vector<GlobalVar> spec_gvars;
+    for (const auto& combo : combos) {
+      ffi::Map<ffi::Variant<tirx::Var, ffi::String>, PrimExpr> binding;
+      std::string name = base_name;
+      for (size_t i = 0; i < dims.size(); ++i) {
+        // Bind by name: the clone renews its symbolic variables but keeps
+        // their name hints.
+        binding.Set(ffi::String(dims[i].var->name_hint),
+                    IntImm(dims[i].var.ty(), combo[i]->value));
+        name += "_" + std::string(dims[i].var->name_hint) + std::to_string(combo[i]->value);
+      }
+      Function spec = FunctionBindSymbolicVars(CopyWithNewVars(func), binding);
+      spec = WithAttr(spec, tvm::attr::kGlobalSymbol, ffi::String(name));
+      spec_gvars.push_back(builder->AddFunction(spec, name));
+    }
+
+    // Build the dispatcher on a fresh copy so its parameters (and the
+    // symbolic variables their shapes define) do not alias any other
+    // function.
+    Function proto = CopyWithNewVars(func);
+    std::vector<BucketedDim> proto_dims = CollectBucketedDims(proto, buckets);
+    TVM_FFI_ICHECK_EQ(proto_dims.size(), dims.size());
+
+    ffi::Array<Expr> call_args(proto->params.begin(), proto->params.end());
+    Expr body = Call(generic_gvar, call_args);
+    for (size_t i = combos.size(); i != 0; --i) {
+      const auto& combo = combos[i - 1];
+      PrimExpr cond;
+      for (size_t j = 0; j < proto_dims.size(); ++j) {
+        PrimExpr eq =
+            tirx::EQ(proto_dims[j].var, IntImm(proto_dims[j].var.ty(), combo[j]->value));
+        cond = cond.defined() ? PrimExpr(tirx::And(cond, eq)) : eq;
+      }
+      body = If(cond, Call(spec_gvars[i - 1], call_args), body);
+    }
+
+    Function dispatcher(proto->params, body, func->ret_ty, func->is_pure, func->attrs);
+    dispatcher = builder->Normalize(dispatcher).as_or_throw<Function>();
+    builder->UpdateFunction(gvar, dispatcher);
+    changed = true;
+  }
+
+  return changed ? builder->GetContextIRModule() : mod;
+}
+
+}  // namespace
+
+namespace transform {
+
+Pass ShapeBucketDispatch(ffi::Map<ffi::String, ffi::Array<IntImm>> buckets) {
+  auto pass_func = [=](IRModule mod, PassContext pc) -> IRModule {
+    return ModuleShapeBucketDispatch(std::move(mod), buckets);
+  };
+  return CreateModulePass(pass_func, 0, "ShapeBucketDispatch", {});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("relax.transform.ShapeBucketDispatch", ShapeBucketDispatch);
+}
+
+}  // namespace transform
+}  // namespace relax
+}  // namespace tvm
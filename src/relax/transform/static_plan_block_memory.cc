@@ -56,8 +56,11 @@
  * upper bound annotation. To be more specific, we can annotate the attribute
  * "tir_var_upper_bound" to Relax functions. The attribute value is a dict from
  * strings to integers, denoting the name of TIR variables to the upper bound
- * values of the TIR vars. **The annotated upper bound attribute only applies
- * to TIR vars in the function signature for clarity.**
+ * values of the TIR vars. The annotated bounds apply to TIR vars in the
+ * function signature as well as to same-named symbolic variables defined
+ * inside the function body, so tensors whose dynamic dimension is only
+ * introduced by a MatchCast (e.g. a data-dependent batch size) can still be
+ * planned with a static arena of the upper-bounded size.
  *
  * For example, we can annotate a Relax function with
  *   `R.func_attr({"tir_var_upper_bound": {"n": 1024}})`.
@@ -416,8 +419,10 @@ void SetTIRVarRangeConstraints(Function func, arith::AnalyzerObj* ana,
                                ffi::Map<tirx::Var, arith::IntSet>* dom_map) {
   // Use the attribute-annotated TIR var bounds as the TIR var values for
   // memory planning.
-  // NOTE: we only apply the annotated bounds to the TIR variables that
-  // appear in the **function signature**.
+  // The annotated bounds apply to the TIR variables that appear in the
+  // function signature, and to same-named symbolic variables introduced
+  // inside the function body (e.g. by MatchCast on a data-dependent shape).
+  // Bounds of variables derived from them are inferred by the analyzer.
   ffi::Map<ffi::String, IntImm> var_upper_bound_attr_raw =
       func->GetAttr<ffi::Map<ffi::String, IntImm>>("tir_var_upper_bound")
           .value_or(ffi::Map<ffi::String, IntImm>());
@@ -440,8 +445,19 @@ void SetTIRVarRangeConstraints(Function func, arith::AnalyzerObj* ana,
   for (const ffi::String& var_name : non_negative_var_attr_raw) {
     non_negative_var_attr.insert(var_name);
   }
-  ffi::Array<tirx::Var> var_in_signature = TIRVarsInType(GetType(func));
-  for (const tirx::Var& tir_var : var_in_signature) {
+  std::unordered_set<const tirx::VarNode*> dedup;
+  ffi::Array<tirx::Var> bounded_vars;
+  for (const tirx::Var& tir_var : TIRVarsInType(GetType(func))) {
+    if (dedup.insert(tir_var.get()).second) {
+      bounded_vars.push_back(tir_var);
+    }
+  }
+  for (const tirx::Var& tir_var : DefinedSymbolicVars(func)) {
+    if (dedup.insert(tir_var.get()).second) {
+      bounded_vars.push_back(tir_var);
+    }
+  }
+  for (const tirx::Var& tir_var : bounded_vars) {
     auto it_upper = var_upper_bound_attr.find(tir_var->name_hint);
     auto it_lower = var_lower_bound_attr.find(tir_var->name_hint);
 
@@ -29,6 +29,8 @@
 
 #include <array>
 #include <cstdint>
+#include <string>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "../op/nn/convolution.h"
@@ -40,14 +42,53 @@
 namespace tvm {
 namespace relax {
 
-int GetMixedPrecisionInfo(const CallNode* call_node) {
+/*! \brief Per-op-name policy decisions that take precedence over the registered policy. */
+using PolicyOverrideMap = std::unordered_map<std::string, int>;
+
+int GetMixedPrecisionInfo(const CallNode* call_node,
+                          const PolicyOverrideMap* policy_override = nullptr) {
   const OpNode* op_node = call_node->op.as<OpNode>();
   if (op_node == nullptr) {
     return -1;
   }
   Op op = ffi::GetRef<Op>(op_node);
-  auto attr_map = Op::GetAttrMap<TMixedPrecisionPolicy>("TMixedPrecisionPolicy");
-  return attr_map.count(op) ? attr_map[op] : MixedPrecisionPolicyKind::kNever;
+  if (policy_override != nullptr) {
+    auto it = policy_override->find(op->name);
+    if (it != policy_override->end()) {
+      int policy = it->second;
+      if (policy == kAlways) {
+        // Promoting an op needs its FInferMixedPrecision to rewrite the accumulator
+        // dtype; fall back to following the input precision when it is missing.
+        static const auto infer_map = Op::GetAttrMap<FInferMixedPrecision>("FInferMixedPrecision");
+        if (!infer_map.count(op)) policy = kFollow;
+      }
+      return policy;
+    }
+  }
+  // The policy is consulted for every call; use a typed snapshot so lookups
+  // skip both the by-name map fetch and the per-call Any cast.
+  static const auto attr_map = Op::GetAttrTable<TMixedPrecisionPolicy>("TMixedPrecisionPolicy");
+  return attr_map.get(op, MixedPrecisionPolicyKind::kNever);
+}
+
+PolicyOverrideMap ParsePolicyOverride(
+    const ffi::Optional<ffi::Map<ffi::String, ffi::String>>& policy_override) {
+  PolicyOverrideMap parsed;
+  if (!policy_override.has_value()) return parsed;
+  for (const auto& [op_name, policy] : policy_override.value()) {
+    if (policy == "always") {
+      parsed[std::string(op_name)] = kAlways;
+    } else if (policy == "follow") {
+      parsed[std::string(op_name)] = kFollow;
+    } else if (policy == "never") {
+      parsed[std::string(op_name)] = kNever;
+    } else {
+      TVM_FFI_THROW(ValueError) << "Unsupported mixed precision policy \"" << policy
+                                << "\" for op " << op_name
+                                << ", expected one of: always, follow, never";
+    }
+  }
+  return parsed;
 }
 
 /*!
@@ -116,10 +157,12 @@ int GetMixedPrecisionInfo(const CallNode* call_node) {
  */
 class DTypeDecisionCollector : public ExprVisitor {
  public:
-  explicit DTypeDecisionCollector(DLDataType output_dtype) : output_dtype_(output_dtype) {}
+  explicit DTypeDecisionCollector(DLDataType output_dtype, const PolicyOverrideMap* policy_override)
+      : output_dtype_(output_dtype), policy_override_(policy_override) {}
 
-  static VarDTypeMap Collect(Function func, DLDataType output_dtype) {
-    DTypeDecisionCollector collector(output_dtype);
+  static VarDTypeMap Collect(Function func, DLDataType output_dtype,
+                             const PolicyOverrideMap* policy_override) {
+    DTypeDecisionCollector collector(output_dtype, policy_override);
     collector.VisitExpr(func);
     return std::move(collector.only_fp16_map_);
   }
@@ -191,7 +234,7 @@ class DTypeDecisionCollector : public ExprVisitor {
   void VisitExpr_(const VarNode* op) final { VisitVars_(op); }
 
   void VisitBinding_(const VarBindingNode* binding, const CallNode* call_node) final {
-    auto policy = GetMixedPrecisionInfo(call_node);
+    auto policy = GetMixedPrecisionInfo(call_node, policy_override_);
     if (policy == -1) {
       ExprVisitor::VisitBinding_(binding, call_node);
       return;
@@ -266,16 +309,19 @@ class DTypeDecisionCollector : public ExprVisitor {
   DLDataType fp16_ = DLDataType{kDLFloat, 16, 1};
   DLDataType fp32_ = DLDataType{kDLFloat, 32, 1};
   DLDataType output_dtype_;
+  const PolicyOverrideMap* policy_override_;
   VarDTypeMap only_fp16_map_;
 };
 
 class ToMixedPrecisionRewriter : public ExprMutator {
  public:
   explicit ToMixedPrecisionRewriter(const VarDTypeMap* only_fp16_map, DLDataType output_dtype,
-                                    const std::unordered_set<std::string>& fp16_input_names)
+                                    const std::unordered_set<std::string>& fp16_input_names,
+                                    const PolicyOverrideMap* policy_override)
       : only_fp16_map_(only_fp16_map),
         output_dtype_(output_dtype),
-        fp16_input_names_(fp16_input_names) {}
+        fp16_input_names_(fp16_input_names),
+        policy_override_(policy_override) {}
 
  private:
   Var GetRemapped(const Var& var) {
@@ -457,7 +503,7 @@ class ToMixedPrecisionRewriter : public ExprMutator {
       ExprMutator::VisitBinding_(binding, call_node);
       return;
     }
-    auto policy = GetMixedPrecisionInfo(call_node);
+    auto policy = GetMixedPrecisionInfo(call_node, policy_override_);
     if (policy == -1) {
       // not an op call
       ExprMutator::VisitBinding_(binding, call_node);
@@ -483,7 +529,7 @@ class ToMixedPrecisionRewriter : public ExprMutator {
 
     if (policy == kAlways) {
       opt_new_dtype = fp16_;
-      auto attr_map = Op::GetAttrMap<FInferMixedPrecision>("FInferMixedPrecision");
+      static const auto attr_map = Op::GetAttrMap<FInferMixedPrecision>("FInferMixedPrecision");
       TVM_FFI_ICHECK(attr_map.count(op));
       new_call = attr_map[op](new_call, output_dtype_);
     } else if (policy == kFollow) {
@@ -597,27 +643,32 @@ class ToMixedPrecisionRewriter : public ExprMutator {
   DLDataType output_dtype_;
   ffi::Array<Var> params_;
   std::unordered_set<std::string> fp16_input_names_;
+  const PolicyOverrideMap* policy_override_;
 
   const Op& wrap_param_op = Op::Get("relax.wrap_param");
 };
 
 Expr ToMixedPrecision(const Function& f, DLDataType out_dtype,
-                      ffi::Optional<ffi::Array<ffi::String>> fp16_input_names) {
-  VarDTypeMap only_fp16_map = DTypeDecisionCollector::Collect(f, out_dtype);
+                      ffi::Optional<ffi::Array<ffi::String>> fp16_input_names,
+                      ffi::Optional<ffi::Map<ffi::String, ffi::String>> policy_override) {
+  PolicyOverrideMap policy_override_map = ParsePolicyOverride(policy_override);
+  VarDTypeMap only_fp16_map = DTypeDecisionCollector::Collect(f, out_dtype, &policy_override_map);
   std::unordered_set<std::string> fp16_input_names_set;
   if (fp16_input_names) {
     fp16_input_names_set.insert(fp16_input_names.value().begin(), fp16_input_names.value().end());
   }
-  ToMixedPrecisionRewriter mutator(&only_fp16_map, out_dtype, fp16_input_names_set);
+  ToMixedPrecisionRewriter mutator(&only_fp16_map, out_dtype, fp16_input_names_set,
+                                   &policy_override_map);
   return mutator(f);
 }
 
 namespace transform {
 
-Pass ToMixedPrecision(DLDataType out_dtype,
-                      ffi::Optional<ffi::Array<ffi::String>> fp16_input_names) {
+Pass ToMixedPrecision(DLDataType out_dtype, ffi::Optional<ffi::Array<ffi::String>> fp16_input_names,
+                      ffi::Optional<ffi::Map<ffi::String, ffi::String>> policy_override) {
   auto pass_func = [=](Function f, IRModule m, PassContext pc) {
-    return ToMixedPrecision(f, out_dtype, fp16_input_names).as_or_throw<Function>();
+    return ToMixedPrecision(f, out_dtype, fp16_input_names, policy_override)
+        .as_or_throw<Function>();
   };
   return CreateFunctionPass(pass_func, 0, "ToMixedPrecision", {});
 }
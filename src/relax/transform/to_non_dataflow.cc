@@ -58,7 +58,8 @@ Pass ToNonDataflow() {
   auto pass_func = [=](Function f, IRModule m, PassContext pc) {
     return ToNonDataflow(f).as_or_throw<Function>();
   };
-  return CreateFunctionPass(pass_func, 0, "ToNonDataflow", {});
+  return CreateFunctionPass(pass_func, 0, "ToNonDataflow", {}, /*traceable=*/false,
+                            /*function_local=*/true);
 }
 
 TVM_FFI_STATIC_INIT_BLOCK() {
@@ -20,6 +20,8 @@
 /*!
  * \file cpu_device_api.cc
  */
+#include <tvm/ffi/container/shape.h>
+#include <tvm/ffi/container/tensor.h>
 #include <tvm/ffi/error.h>
 #include <tvm/ffi/function.h>
 #include <tvm/ffi/reflection/registry.h>
@@ -27,6 +29,9 @@
 
 #include <cstdlib>
 #include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 #include "workspace_pool.h"
 
@@ -108,7 +113,51 @@ class CPUDeviceAPI final : public DeviceAPI {
     return ptr;
   }
 
+  void* AllocDataSpace(Device dev, int ndim, const int64_t* shape, DLDataType dtype,
+                       ffi::Optional<ffi::String> mem_scope) final {
+    if (mem_scope.has_value() && mem_scope.value() == "global.pinned") {
+      Device pinned_dev;
+      if (DeviceAPI* pinned_api = GetPinnedHostAPI(&pinned_dev)) {
+        DLTensor temp;
+        temp.data = nullptr;
+        temp.device = pinned_dev;
+        temp.ndim = ndim;
+        temp.dtype = dtype;
+        temp.shape = const_cast<int64_t*>(shape);
+        temp.strides = nullptr;
+        temp.byte_offset = 0;
+        size_t nbytes = ffi::GetDataSize(temp);
+        void* ptr = pinned_api->AllocDataSpace(pinned_dev, nbytes, kAllocAlignment, dtype);
+        std::lock_guard<std::mutex> lock(pinned_mutex_);
+        pinned_allocs_[ptr] = pinned_dev;
+        return ptr;
+      }
+      // No accelerator runtime exposes a page-locked allocator in this build;
+      // fall back to pageable memory, which behaves identically except that
+      // device copies go through the driver's internal staging.
+      return DeviceAPI::AllocDataSpace(dev, ndim, shape, dtype, std::nullopt);
+    }
+    return DeviceAPI::AllocDataSpace(dev, ndim, shape, dtype, mem_scope);
+  }
+
+  size_t GetDataSize(const DLTensor& arr, ffi::Optional<ffi::String> mem_scope) final {
+    if (mem_scope.has_value() && mem_scope.value() == "global.pinned") {
+      return DeviceAPI::GetDataSize(arr, std::nullopt);
+    }
+    return DeviceAPI::GetDataSize(arr, mem_scope);
+  }
+
   void FreeDataSpace(Device dev, void* ptr) final {
+    {
+      std::lock_guard<std::mutex> lock(pinned_mutex_);
+      auto it = pinned_allocs_.find(ptr);
+      if (it != pinned_allocs_.end()) {
+        Device pinned_dev = it->second;
+        pinned_allocs_.erase(it);
+        DeviceAPI::Get(pinned_dev)->FreeDataSpace(pinned_dev, ptr);
+        return;
+      }
+    }
 #if _MSC_VER
     _aligned_free(ptr);
 #else
@@ -136,6 +185,24 @@ class CPUDeviceAPI final : public DeviceAPI {
                       TVMStreamHandle stream) final {
     memcpy(static_cast<char*>(to) + to_offset, static_cast<const char*>(from) + from_offset, size);
   }
+
+ private:
+  // Page-locked host memory comes from whichever accelerator runtime is
+  // loaded; probe the ones that register a host-pinned device API.
+  static DeviceAPI* GetPinnedHostAPI(Device* pinned_dev) {
+    for (DLDeviceType device_type : {kDLCUDAHost, kDLROCMHost}) {
+      Device dev{device_type, 0};
+      if (DeviceAPI* api = DeviceAPI::Get(dev, /*allow_missing=*/true)) {
+        *pinned_dev = dev;
+        return api;
+      }
+    }
+    return nullptr;
+  }
+
+  std::mutex pinned_mutex_;
+  // Pinned pointers must be released through the runtime that allocated them.
+  std::unordered_map<void*, Device> pinned_allocs_;
 };
 
 struct CPUWorkspacePool : public WorkspacePool {
@@ -155,12 +222,32 @@ void CPUDeviceAPI::FreeWorkspace(Device dev, void* data) {
   CPUWorkspacePoolThreadLocal()->FreeWorkspace(dev, data);
 }
 
+// The workspace recording/pre-reservation functions act on the calling
+// thread's pool, which is the pool steady-state inference allocates from:
+// record the sizes after a warmup run on the serving thread, persist them
+// with the artifact, and replay them through prealloc at startup.
 TVM_FFI_STATIC_INIT_BLOCK() {
   namespace refl = tvm::ffi::reflection;
-  refl::GlobalDef().def_packed("device_api.cpu", [](ffi::PackedArgs args, ffi::Any* rv) {
-    DeviceAPI* ptr = CPUDeviceAPI::Global();
-    *rv = static_cast<void*>(ptr);
-  });
+  refl::GlobalDef()
+      .def_packed("device_api.cpu",
+                  [](ffi::PackedArgs args, ffi::Any* rv) {
+                    DeviceAPI* ptr = CPUDeviceAPI::Global();
+                    *rv = static_cast<void*>(ptr);
+                  })
+      .def("runtime.cpu_workspace_high_water_bytes",
+           [](int device_id) -> int64_t {
+             return CPUWorkspacePoolThreadLocal()->HighWaterBytes(Device{kDLCPU, device_id});
+           })
+      .def("runtime.cpu_workspace_sizes",
+           [](int device_id) -> ffi::Shape {
+             std::vector<size_t> sizes =
+                 CPUWorkspacePoolThreadLocal()->WorkspaceSizes(Device{kDLCPU, device_id});
+             return ffi::Shape(std::vector<int64_t>(sizes.begin(), sizes.end()));
+           })
+      .def("runtime.cpu_workspace_prealloc", [](int device_id, ffi::Shape sizes) {
+        CPUWorkspacePoolThreadLocal()->PreAllocWorkspace(
+            Device{kDLCPU, device_id}, std::vector<size_t>(sizes.begin(), sizes.end()));
+      });
 }
 }  // namespace runtime
 }  // namespace tvm
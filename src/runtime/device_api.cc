@@ -40,6 +40,7 @@
 #include <sstream>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 #include <variant>
 
 namespace tvm {
@@ -97,6 +98,72 @@ DeviceAPI* DeviceAPI::Get(Device dev, bool allow_missing) {
   return DeviceAPIManager::Get(static_cast<int>(dev.device_type), allow_missing);
 }
 
+/*! \brief Process-wide cache of per-device capability snapshots. */
+class DeviceCapabilityCache {
+ public:
+  static DeviceCapabilityCache* Global() {
+    static DeviceCapabilityCache* inst = new DeviceCapabilityCache();
+    return inst;
+  }
+
+  const DeviceCapability& Get(Device dev) {
+    int64_t key =
+        (static_cast<int64_t>(dev.device_type) << 32) | static_cast<uint32_t>(dev.device_id);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = cache_.find(key);
+    if (it == cache_.end()) {
+      it = cache_.emplace(key, Query(dev)).first;
+    }
+    return it->second;
+  }
+
+ private:
+  static DeviceCapability Query(Device dev) {
+    DeviceCapability cap;
+    DeviceAPI* api = DeviceAPI::Get(dev, true);
+    if (api == nullptr) {
+      return cap;
+    }
+    ffi::Any exist;
+    api->GetAttr(dev, kExist, &exist);
+    cap.exist = exist.cast<bool>();
+    if (!cap.exist) {
+      return cap;
+    }
+    auto query_int = [&](DeviceAttrKind kind) {
+      ffi::Any ret;
+      api->GetAttr(dev, kind, &ret);
+      return ret.try_cast<int64_t>();
+    };
+    auto query_str = [&](DeviceAttrKind kind) {
+      ffi::Any ret;
+      api->GetAttr(dev, kind, &ret);
+      return ret.try_cast<ffi::String>();
+    };
+    auto to_int = [](int64_t value) { return static_cast<int>(value); };
+    if (auto v = query_int(kMaxThreadsPerBlock)) cap.max_threads_per_block = to_int(v.value());
+    if (auto v = query_int(kWarpSize)) cap.warp_size = to_int(v.value());
+    if (auto v = query_int(kMaxSharedMemoryPerBlock))
+      cap.max_shared_memory_per_block = to_int(v.value());
+    if (auto v = query_int(kMultiProcessorCount)) cap.multi_processor_count = to_int(v.value());
+    if (auto v = query_int(kMaxRegistersPerBlock)) cap.max_registers_per_block = to_int(v.value());
+    if (auto v = query_int(kMaxClockRate)) cap.max_clock_rate = to_int(v.value());
+    if (auto v = query_int(kApiVersion)) cap.api_version = to_int(v.value());
+    if (auto v = query_int(kL2CacheSizeBytes)) cap.l2_cache_size_bytes = v.value();
+    if (auto v = query_int(kTotalGlobalMemory)) cap.total_global_memory = v.value();
+    if (auto v = query_str(kDeviceName)) cap.device_name = std::string(v.value());
+    if (auto v = query_str(kComputeVersion)) cap.compute_version = std::string(v.value());
+    return cap;
+  }
+
+  std::mutex mutex_;
+  std::unordered_map<int64_t, DeviceCapability> cache_;
+};
+
+const DeviceCapability& GetDeviceCapability(Device dev) {
+  return DeviceCapabilityCache::Global()->Get(dev);
+}
+
 void* DeviceAPI::AllocWorkspace(Device dev, size_t size, DLDataType type_hint) {
   return AllocDataSpace(dev, size, kTempAllocaAlignment, type_hint);
 }
@@ -160,6 +227,16 @@ void DeviceAPI::CopyDataFromTo(const void* from, size_t from_offset, void* to, s
 
 void DeviceAPI::FreeWorkspace(Device dev, void* ptr) { FreeDataSpace(dev, ptr); }
 
+void* DeviceAPI::AllocDataSpaceAsync(Device dev, size_t nbytes, size_t alignment,
+                                     DLDataType type_hint, TVMStreamHandle stream) {
+  // default: synchronous allocation for backends without stream-ordered pools.
+  return AllocDataSpace(dev, nbytes, alignment, type_hint);
+}
+
+void DeviceAPI::FreeDataSpaceAsync(Device dev, void* ptr, TVMStreamHandle stream) {
+  FreeDataSpace(dev, ptr);
+}
+
 TVMStreamHandle DeviceAPI::CreateStream(Device dev) { return nullptr; }
 
 void DeviceAPI::FreeStream(Device dev, TVMStreamHandle stream) {}
@@ -143,7 +143,7 @@ void CallCublasLt(cublasLtHandle_t hdl, cudaStream_t stream,
                   const DLTensor* bias, const DLTensor* scaleA, const DLTensor* scaleB,
                   const DLTensor* C, bool transa, bool transb, void* workspace_ptr,
                   size_t workspace_size, cublasLtEpilogue_t epilogue,
-                  std::optional<float> dq_scale) {
+                  std::optional<float> dq_scale, CuBlasLtAlgoCache* algo_cache) {
   TVM_FFI_ICHECK(A->dtype == B->dtype);
   // Reversed strides indicates an in-place transpose operation.
   transa = IsInPlaceTransposed(A) ? !transa : transa;
@@ -190,43 +190,9 @@ void CallCublasLt(cublasLtHandle_t hdl, cudaStream_t stream,
     beta = &zero_i32;
   }
 
-  cublasLtMatmulDesc_t op_desc;
   cublasOperation_t op_transa = CUBLASBooleanToTranspose(transa);
   cublasOperation_t op_transb = CUBLASBooleanToTranspose(transb);
 
-  CHECK_CUBLAS_ERROR(cublasLtMatmulDescCreate(&op_desc, compute_type, scale_type));
-  CHECK_CUBLAS_ERROR(cublasLtMatmulDescSetAttribute(op_desc, CUBLASLT_MATMUL_DESC_TRANSA,
-                                                    &op_transb, sizeof(op_transb)));
-  CHECK_CUBLAS_ERROR(cublasLtMatmulDescSetAttribute(op_desc, CUBLASLT_MATMUL_DESC_TRANSB,
-                                                    &op_transa, sizeof(op_transa)));
-
-  if (bias != nullptr) {
-    CHECK_CUBLAS_ERROR(cublasLtMatmulDescSetAttribute(op_desc, CUBLASLT_MATMUL_DESC_BIAS_POINTER,
-                                                      &bias->data, sizeof(float*)));
-  }
-
-#if CUDART_VERSION >= 11080
-  if (scaleA != nullptr) {
-    auto scaleA_data = static_cast<char*>(scaleA->data) + scaleA->byte_offset;
-    CHECK_CUBLAS_ERROR(cublasLtMatmulDescSetAttribute(op_desc, CUBLASLT_MATMUL_DESC_A_SCALE_POINTER,
-                                                      &scaleA_data, sizeof(float*)));
-  }
-  if (scaleB != nullptr) {
-    auto scaleB_data = static_cast<char*>(scaleB->data) + scaleB->byte_offset;
-    CHECK_CUBLAS_ERROR(cublasLtMatmulDescSetAttribute(op_desc, CUBLASLT_MATMUL_DESC_B_SCALE_POINTER,
-                                                      &scaleB_data, sizeof(float*)));
-  }
-#else
-  if (scaleA != nullptr || scaleB != nullptr) {
-    TVM_FFI_THROW(InternalError) << "Scaling pointers are only supported in CUDA 11.8 and above.";
-  }
-#endif
-
-  if (epilogue != CUBLASLT_EPILOGUE_DEFAULT) {
-    CHECK_CUBLAS_ERROR(cublasLtMatmulDescSetAttribute(op_desc, CUBLASLT_MATMUL_DESC_EPILOGUE,
-                                                      &epilogue, sizeof(epilogue)));
-  }
-
   int batch_offset_A = A->ndim - 2;
   int batch_offset_B = B->ndim - 2;
 
@@ -252,13 +218,8 @@ void CallCublasLt(cublasLtHandle_t hdl, cudaStream_t stream,
   int ldb = transa ? N : K;
   int ldc = M;
 
-  cublasLtMatrixLayout_t A_desc, B_desc, C_desc;
-  CHECK_CUBLAS_ERROR(
-      cublasLtMatrixLayoutCreate(&A_desc, ab_type, !transb ? M : K, !transb ? K : M, lda));
-  CHECK_CUBLAS_ERROR(
-      cublasLtMatrixLayoutCreate(&B_desc, ab_type, !transa ? K : N, !transa ? N : K, ldb));
-  CHECK_CUBLAS_ERROR(cublasLtMatrixLayoutCreate(&C_desc, c_type, M, N, ldc));
-
+  int batch_count = 0;
+  int batch_count_C = 0;
   if (use_batched_gemm) {
     auto get_batch_count = [](int64_t* shape, int batch_offset) {
       int64_t count = 1;
@@ -267,54 +228,123 @@ void CallCublasLt(cublasLtHandle_t hdl, cudaStream_t stream,
       }
       return count;
     };
-    auto set_batch = [](cublasLtMatrixLayout_t mat_desc, int batch_count, int64_t batch_stride) {
-      CHECK_CUBLAS_ERROR(cublasLtMatrixLayoutSetAttribute(
-          mat_desc, CUBLASLT_MATRIX_LAYOUT_BATCH_COUNT, &batch_count, sizeof(batch_count)));
-      CHECK_CUBLAS_ERROR(
-          cublasLtMatrixLayoutSetAttribute(mat_desc, CUBLASLT_MATRIX_LAYOUT_STRIDED_BATCH_OFFSET,
-                                           &batch_stride, sizeof(batch_stride)));
-    };
-
     int batch_count_A = get_batch_count(A->shape, batch_offset_A);
     int batch_count_B = get_batch_count(B->shape, batch_offset_B);
-    int batch_count_C = get_batch_count(C->shape, C->ndim - 2);
-    int64_t batch_stride_A = M * K;
-    int64_t batch_stride_B = K * N;
-    int64_t batch_stride_C = M * N;
+    batch_count_C = get_batch_count(C->shape, C->ndim - 2);
 
     // cuBLASLt does not seem to support batched GEMM with one of matrices having
     // one batch (with batch_stride 0).
     TVM_FFI_ICHECK_EQ(batch_count_A, batch_count_B);
+    batch_count = batch_count_A;
+  }
 
-    set_batch(A_desc, batch_count_A, batch_stride_A);
-    set_batch(B_desc, batch_count_B, batch_stride_B);
-    set_batch(C_desc, batch_count_C, batch_stride_C);
+  // Everything that determines the descriptors and the heuristic choice is
+  // captured in the signature; only the data/bias/scale pointers vary
+  // between calls with the same signature, and those are (re)set below.
+  CuBlasLtMatmulSignature sig{static_cast<int>(ab_type),
+                              static_cast<int>(c_type),
+                              static_cast<int>(compute_type),
+                              transa,
+                              transb,
+                              M,
+                              N,
+                              K,
+                              use_batched_gemm ? batch_count : 0,
+                              static_cast<int>(epilogue),
+                              bias != nullptr,
+                              scaleA != nullptr,
+                              scaleB != nullptr};
+  CuBlasLtMatmulPlan* plan = algo_cache == nullptr ? nullptr : algo_cache->Find(sig);
+  CuBlasLtMatmulPlan local_plan;
+  bool fresh_plan = (plan == nullptr);
+  if (fresh_plan) {
+    CHECK_CUBLAS_ERROR(cublasLtMatmulDescCreate(&local_plan.op_desc, compute_type, scale_type));
+    CHECK_CUBLAS_ERROR(cublasLtMatmulDescSetAttribute(
+        local_plan.op_desc, CUBLASLT_MATMUL_DESC_TRANSA, &op_transb, sizeof(op_transb)));
+    CHECK_CUBLAS_ERROR(cublasLtMatmulDescSetAttribute(
+        local_plan.op_desc, CUBLASLT_MATMUL_DESC_TRANSB, &op_transa, sizeof(op_transa)));
+
+    if (epilogue != CUBLASLT_EPILOGUE_DEFAULT) {
+      CHECK_CUBLAS_ERROR(cublasLtMatmulDescSetAttribute(
+          local_plan.op_desc, CUBLASLT_MATMUL_DESC_EPILOGUE, &epilogue, sizeof(epilogue)));
+    }
+
+    CHECK_CUBLAS_ERROR(cublasLtMatrixLayoutCreate(&local_plan.a_desc, ab_type, !transb ? M : K,
+                                                  !transb ? K : M, lda));
+    CHECK_CUBLAS_ERROR(cublasLtMatrixLayoutCreate(&local_plan.b_desc, ab_type, !transa ? K : N,
+                                                  !transa ? N : K, ldb));
+    CHECK_CUBLAS_ERROR(cublasLtMatrixLayoutCreate(&local_plan.c_desc, c_type, M, N, ldc));
+
+    if (use_batched_gemm) {
+      auto set_batch = [](cublasLtMatrixLayout_t mat_desc, int batch_count, int64_t batch_stride) {
+        CHECK_CUBLAS_ERROR(cublasLtMatrixLayoutSetAttribute(
+            mat_desc, CUBLASLT_MATRIX_LAYOUT_BATCH_COUNT, &batch_count, sizeof(batch_count)));
+        CHECK_CUBLAS_ERROR(
+            cublasLtMatrixLayoutSetAttribute(mat_desc, CUBLASLT_MATRIX_LAYOUT_STRIDED_BATCH_OFFSET,
+                                             &batch_stride, sizeof(batch_stride)));
+      };
+      int64_t batch_stride_A = M * K;
+      int64_t batch_stride_B = K * N;
+      int64_t batch_stride_C = M * N;
+      set_batch(local_plan.a_desc, batch_count, batch_stride_A);
+      set_batch(local_plan.b_desc, batch_count, batch_stride_B);
+      set_batch(local_plan.c_desc, batch_count_C, batch_stride_C);
+    }
+
+    cublasLtMatmulPreferenceSetAttribute(matmul_pref_desc, CUBLASLT_MATMUL_PREF_MAX_WORKSPACE_BYTES,
+                                         &workspace_size, sizeof(size_t));
+
+    cublasLtMatmulHeuristicResult_t heuristic_result = {};
+    int returned_result = 0;
+    CHECK_CUBLAS_ERROR(cublasLtMatmulAlgoGetHeuristic(
+        hdl, local_plan.op_desc, local_plan.a_desc, local_plan.b_desc, local_plan.c_desc,
+        local_plan.c_desc, matmul_pref_desc, 1, &heuristic_result, &returned_result));
+    if (returned_result == 0) {
+      CHECK_CUBLAS_ERROR(CUBLAS_STATUS_NOT_SUPPORTED);
+    }
+    local_plan.algo = heuristic_result.algo;
+
+    plan = algo_cache == nullptr ? &local_plan : algo_cache->Insert(sig, local_plan);
   }
 
+  // Per-call pointer attributes. These change between invocations of the
+  // same plan, so they are set on cache hits as well.
+  if (bias != nullptr) {
+    CHECK_CUBLAS_ERROR(cublasLtMatmulDescSetAttribute(
+        plan->op_desc, CUBLASLT_MATMUL_DESC_BIAS_POINTER, &bias->data, sizeof(float*)));
+  }
+
+#if CUDART_VERSION >= 11080
+  if (scaleA != nullptr) {
+    auto scaleA_data = static_cast<char*>(scaleA->data) + scaleA->byte_offset;
+    CHECK_CUBLAS_ERROR(cublasLtMatmulDescSetAttribute(
+        plan->op_desc, CUBLASLT_MATMUL_DESC_A_SCALE_POINTER, &scaleA_data, sizeof(float*)));
+  }
+  if (scaleB != nullptr) {
+    auto scaleB_data = static_cast<char*>(scaleB->data) + scaleB->byte_offset;
+    CHECK_CUBLAS_ERROR(cublasLtMatmulDescSetAttribute(
+        plan->op_desc, CUBLASLT_MATMUL_DESC_B_SCALE_POINTER, &scaleB_data, sizeof(float*)));
+  }
+#else
+  if (scaleA != nullptr || scaleB != nullptr) {
+    TVM_FFI_THROW(InternalError) << "Scaling pointers are only supported in CUDA 11.8 and above.";
+  }
+#endif
+
   auto A_data = static_cast<char*>(A->data) + A->byte_offset;
   auto B_data = static_cast<char*>(B->data) + B->byte_offset;
   auto C_data = static_cast<char*>(C->data) + C->byte_offset;
 
-  cublasLtMatmulPreferenceSetAttribute(matmul_pref_desc, CUBLASLT_MATMUL_PREF_MAX_WORKSPACE_BYTES,
-                                       &workspace_size, sizeof(size_t));
+  CHECK_CUBLAS_ERROR(cublasLtMatmul(hdl, plan->op_desc, alpha, B_data, plan->a_desc, A_data,
+                                    plan->b_desc, beta, C_data, plan->c_desc, C_data, plan->c_desc,
+                                    &plan->algo, workspace_ptr, workspace_size, stream));
 
-  cublasLtMatmulHeuristicResult_t heuristic_result = {};
-  int returned_result = 0;
-  CHECK_CUBLAS_ERROR(cublasLtMatmulAlgoGetHeuristic(hdl, op_desc, A_desc, B_desc, C_desc, C_desc,
-                                                    matmul_pref_desc, 1, &heuristic_result,
-                                                    &returned_result));
-  if (returned_result == 0) {
-    CHECK_CUBLAS_ERROR(CUBLAS_STATUS_NOT_SUPPORTED);
+  if (fresh_plan && algo_cache == nullptr) {
+    cublasLtMatmulDescDestroy(local_plan.op_desc);
+    cublasLtMatrixLayoutDestroy(local_plan.a_desc);
+    cublasLtMatrixLayoutDestroy(local_plan.b_desc);
+    cublasLtMatrixLayoutDestroy(local_plan.c_desc);
   }
-
-  CHECK_CUBLAS_ERROR(cublasLtMatmul(hdl, op_desc, alpha, B_data, A_desc, A_data, B_desc, beta,
-                                    C_data, C_desc, C_data, C_desc, &heuristic_result.algo,
-                                    workspace_ptr, workspace_size, stream));
-
-  cublasLtMatmulDescDestroy(op_desc);
-  cublasLtMatrixLayoutDestroy(A_desc);
-  cublasLtMatrixLayoutDestroy(B_desc);
-  cublasLtMatrixLayoutDestroy(C_desc);
 }
 
 inline void CallLtIgemm(ffi::PackedArgs args, ffi::Any* ret, cublasLtHandle_t hdl,
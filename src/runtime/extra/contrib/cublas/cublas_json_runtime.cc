@@ -146,7 +146,7 @@ class CublasJSONRuntime : public JSONRuntimeBase {
         tvm::contrib::CallCublasLt(entry_ptr->handle, stream, entry_ptr->matmul_pref_desc, a_ptr,
                                    b_ptr, bias_ptr, scaleA_ptr, scaleB_ptr, out_ptr, transa, transb,
                                    entry_ptr->workspace_ptr, entry_ptr->workspace_size, epilogue,
-                                   dq_scale);
+                                   dq_scale, &entry_ptr->algo_cache);
       }
     }
   }
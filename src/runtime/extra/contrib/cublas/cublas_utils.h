@@ -34,7 +34,9 @@
 #if CUDART_VERSION >= 10010
 #include <cublasLt.h>
 #endif  // CUDART_VERSION >= 10010
+#include <functional>
 #include <optional>
+#include <unordered_map>
 
 namespace tvm {
 namespace contrib {
@@ -78,6 +80,95 @@ struct CuBlasThreadEntry {
   static CuBlasThreadEntry* ThreadLocal(DLDevice curr_device);
 };  // CuBlasThreadEntry
 
+/*!
+ * \brief The shape/type/epilogue signature of a cublasLt matmul. Two calls
+ * with the same signature can share descriptors and the heuristic algo
+ * choice; only the data, bias and scale pointers differ between them.
+ */
+struct CuBlasLtMatmulSignature {
+  int ab_type;
+  int c_type;
+  int compute_type;
+  bool transa;
+  bool transb;
+  int m;
+  int n;
+  int k;
+  /*! \brief The strided-batch count, or 0 when the call is not batched. */
+  int batch_count;
+  int epilogue;
+  bool has_bias;
+  bool has_scale_a;
+  bool has_scale_b;
+
+  bool operator==(const CuBlasLtMatmulSignature& other) const {
+    return ab_type == other.ab_type && c_type == other.c_type &&
+           compute_type == other.compute_type && transa == other.transa &&
+           transb == other.transb && m == other.m && n == other.n && k == other.k &&
+           batch_count == other.batch_count && epilogue == other.epilogue &&
+           has_bias == other.has_bias && has_scale_a == other.has_scale_a &&
+           has_scale_b == other.has_scale_b;
+  }
+};
+
+/*! \brief Cached cublasLt descriptors and algo choice for one signature. */
+struct CuBlasLtMatmulPlan {
+  cublasLtMatmulDesc_t op_desc{nullptr};
+  cublasLtMatrixLayout_t a_desc{nullptr};
+  cublasLtMatrixLayout_t b_desc{nullptr};
+  cublasLtMatrixLayout_t c_desc{nullptr};
+  cublasLtMatmulAlgo_t algo;
+};
+
+/*!
+ * \brief Cache of matmul plans keyed by signature. Living on the per-thread
+ * cuBLASLt entry it needs no locking; repeated projections with stable
+ * shapes skip descriptor creation and the heuristic query entirely.
+ */
+class CuBlasLtAlgoCache {
+ public:
+  CuBlasLtMatmulPlan* Find(const CuBlasLtMatmulSignature& sig) {
+    auto it = plans_.find(sig);
+    return it == plans_.end() ? nullptr : &it->second;
+  }
+
+  CuBlasLtMatmulPlan* Insert(const CuBlasLtMatmulSignature& sig, const CuBlasLtMatmulPlan& plan) {
+    return &plans_.emplace(sig, plan).first->second;
+  }
+
+  ~CuBlasLtAlgoCache() {
+    for (auto& kv : plans_) {
+      if (kv.second.op_desc != nullptr) cublasLtMatmulDescDestroy(kv.second.op_desc);
+      if (kv.second.a_desc != nullptr) cublasLtMatrixLayoutDestroy(kv.second.a_desc);
+      if (kv.second.b_desc != nullptr) cublasLtMatrixLayoutDestroy(kv.second.b_desc);
+      if (kv.second.c_desc != nullptr) cublasLtMatrixLayoutDestroy(kv.second.c_desc);
+    }
+  }
+
+ private:
+  struct SignatureHash {
+    size_t operator()(const CuBlasLtMatmulSignature& sig) const {
+      auto combine = [](size_t seed, size_t value) {
+        return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+      };
+      size_t seed = std::hash<int>()(sig.ab_type);
+      seed = combine(seed, static_cast<size_t>(sig.c_type));
+      seed = combine(seed, static_cast<size_t>(sig.compute_type));
+      seed = combine(seed, (static_cast<size_t>(sig.transa) << 1) | sig.transb);
+      seed = combine(seed, static_cast<size_t>(sig.m));
+      seed = combine(seed, static_cast<size_t>(sig.n));
+      seed = combine(seed, static_cast<size_t>(sig.k));
+      seed = combine(seed, static_cast<size_t>(sig.batch_count));
+      seed = combine(seed, static_cast<size_t>(sig.epilogue));
+      seed = combine(seed, (static_cast<size_t>(sig.has_bias) << 2) |
+                               (static_cast<size_t>(sig.has_scale_a) << 1) | sig.has_scale_b);
+      return seed;
+    }
+  };
+
+  std::unordered_map<CuBlasLtMatmulSignature, CuBlasLtMatmulPlan, SignatureHash> plans_;
+};
+
 struct CuBlasLtThreadEntry {
   CuBlasLtThreadEntry();
   ~CuBlasLtThreadEntry();
@@ -88,6 +179,8 @@ struct CuBlasLtThreadEntry {
   // 32MB workspace as suggested by NVIDIA
   // https://docs.nvidia.com/cuda/cublas/index.html#cublassetworkspace.
   static constexpr const size_t workspace_size = 33554432;
+  /*! \brief Matmul plans reused across calls on this thread. */
+  CuBlasLtAlgoCache algo_cache;
 
   static CuBlasLtThreadEntry* ThreadLocal(DLDevice curr_device);
 };  // CuBlasLtThreadEntry
@@ -131,7 +224,8 @@ void CallCublasLt(cublasLtHandle_t hdl, cudaStream_t stream,
                   const DLTensor* bias, const DLTensor* scaleA, const DLTensor* scaleB,
                   const DLTensor* C, bool transa, bool transb, void* workspace_ptr,
                   size_t workspace_size, cublasLtEpilogue_t epilogue = CUBLASLT_EPILOGUE_DEFAULT,
-                  std::optional<float> dq_scale = std::nullopt);
+                  std::optional<float> dq_scale = std::nullopt,
+                  CuBlasLtAlgoCache* algo_cache = nullptr);
 
 }  // namespace contrib
 }  // namespace tvm
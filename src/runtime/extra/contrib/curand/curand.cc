@@ -21,6 +21,8 @@
 #include <tvm/ffi/function.h>
 #include <tvm/ffi/reflection/registry.h>
 #include <tvm/runtime/base.h>
+#include <tvm/runtime/device_api.h>
+#include <tvm/runtime/tensor.h>
 
 #include "./helper_cuda_kernels.h"
 
@@ -118,6 +120,102 @@ TVM_FFI_STATIC_INIT_BLOCK() {
   refl::GlobalDef().def("runtime.contrib.curand.RandomFill", RandomFill);
 }
 
+/*!
+ * \brief Create the persistent per-sequence sampler RNG states.
+ *
+ * The states live in an opaque device byte buffer so they pass through the VM
+ * as an ordinary tensor and survive across decode steps.
+ */
+Tensor SamplerStateCreate(int64_t max_num_seqs, int64_t seed, int device_id) {
+  static DeviceAPI* cuda_api = GetCUDADeviceAPI();
+  TVM_FFI_ICHECK_GT(max_num_seqs, 0) << "The number of sequences should be greater than 0.";
+  Device device{kDLCUDA, device_id};
+  Tensor states = Tensor::Empty({max_num_seqs * static_cast<int64_t>(SamplerStateSize())},
+                                DLDataType{kDLUInt, 8, 1}, device);
+  SamplerInitStates(states->data, max_num_seqs, static_cast<uint64_t>(seed),
+                    cuda_api->GetCurrentStream(device));
+  return states;
+}
+
+/*!
+ * \brief Fused temperature/top-k/top-p sampling from logits.
+ *
+ * A single kernel launch on the current compute stream; the sampled tokens
+ * land in the caller-provided device buffer, so the next decode step can
+ * consume them without any host synchronization.
+ */
+void FusedSampleImpl(const Tensor& logits, const Tensor& states, double temperature, double top_p,
+                     int64_t top_k, const uint32_t* masks, int64_t mask_words,
+                     const int32_t* seq_states, const Tensor& out_tokens) {
+  static DeviceAPI* cuda_api = GetCUDADeviceAPI();
+  TVM_FFI_CHECK(logits->device.device_type == kDLCUDA, ValueError)
+      << "Fused sampling only works on CUDA devices";
+  TVM_FFI_ICHECK(logits.IsContiguous());
+  TVM_FFI_ICHECK((logits.DataType() == DLDataType{kDLFloat, 32, 1}))
+      << "The logits must be float32";
+  TVM_FFI_ICHECK_GE(logits->ndim, 1);
+  int64_t vocab = logits->shape[logits->ndim - 1];
+  int64_t batch = GetTensorSize(const_cast<DLTensor*>(logits.operator->())) / vocab;
+  TVM_FFI_ICHECK((out_tokens.DataType() == DLDataType{kDLInt, 32, 1}))
+      << "The token buffer must be int32";
+  TVM_FFI_ICHECK_GE(GetTensorSize(const_cast<DLTensor*>(out_tokens.operator->())), batch)
+      << "The token buffer is smaller than the batch";
+  TVM_FFI_ICHECK_GE(GetTensorSize(const_cast<DLTensor*>(states.operator->())),
+                    batch * static_cast<int64_t>(SamplerStateSize()))
+      << "The sampler state buffer holds fewer sequences than the batch";
+  FusedSampleFromLogits(static_cast<const float*>(logits->data), batch, vocab,
+                        static_cast<float>(temperature), static_cast<float>(top_p), top_k,
+                        states->data, masks, mask_words, seq_states,
+                        static_cast<int32_t*>(out_tokens->data),
+                        cuda_api->GetCurrentStream(logits->device));
+}
+
+void FusedSampleFromLogitsPacked(Tensor logits, Tensor states, double temperature, double top_p,
+                                 int64_t top_k, Tensor out_tokens) {
+  FusedSampleImpl(logits, states, temperature, top_p, top_k, /*masks=*/nullptr, /*mask_words=*/0,
+                  /*seq_states=*/nullptr, out_tokens);
+}
+
+/*!
+ * \brief Fused sampling with a grammar vocabulary mask applied in the kernel.
+ *
+ * Each sequence reads its own row of the compiled token-mask table, selected
+ * by the per-sequence automaton state; disallowed tokens are excluded before
+ * the softmax, so no separate mask-application launch is needed.
+ */
+void FusedSampleFromLogitsMasked(Tensor logits, Tensor states, double temperature, double top_p,
+                                 int64_t top_k, Tensor masks, Tensor seq_states,
+                                 Tensor out_tokens) {
+  TVM_FFI_ICHECK(masks.IsContiguous());
+  TVM_FFI_ICHECK((masks.DataType() == DLDataType{kDLUInt, 32, 1}))
+      << "The mask table must be uint32";
+  TVM_FFI_ICHECK_EQ(masks->ndim, 2) << "The mask table must be [num_states, num_words]";
+  TVM_FFI_CHECK(masks->device.device_type == kDLCUDA, ValueError)
+      << "The mask table must live on the CUDA device";
+  int64_t vocab = logits->shape[logits->ndim - 1];
+  int64_t batch = GetTensorSize(const_cast<DLTensor*>(logits.operator->())) / vocab;
+  int64_t mask_words = masks->shape[1];
+  TVM_FFI_ICHECK_GE(mask_words * 32, vocab)
+      << "The mask rows cover " << mask_words * 32 << " tokens but the vocabulary has " << vocab;
+  TVM_FFI_ICHECK((seq_states.DataType() == DLDataType{kDLInt, 32, 1}))
+      << "The automaton states must be int32";
+  TVM_FFI_CHECK(seq_states->device.device_type == kDLCUDA, ValueError)
+      << "The automaton states must live on the CUDA device";
+  TVM_FFI_ICHECK_GE(GetTensorSize(const_cast<DLTensor*>(seq_states.operator->())), batch)
+      << "The automaton state buffer is smaller than the batch";
+  FusedSampleImpl(logits, states, temperature, top_p, top_k,
+                  static_cast<const uint32_t*>(masks->data), mask_words,
+                  static_cast<const int32_t*>(seq_states->data), out_tokens);
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef()
+      .def("vm.builtin.sampler_state_create", SamplerStateCreate)
+      .def("vm.builtin.fused_sample_from_logits", FusedSampleFromLogitsPacked)
+      .def("vm.builtin.fused_sample_from_logits_masked", FusedSampleFromLogitsMasked);
+}
+
 }  // namespace curand
 }  // namespace runtime
 }  // namespace tvm
@@ -17,6 +17,8 @@
  * under the License.
  */
 #include <cuda_fp16.h>
+#include <curand_kernel.h>
+#include <math_constants.h>
 
 #include "./helper_cuda_kernels.h"
 
@@ -37,6 +39,225 @@ void ConvertFp32toFp16(const void* _src, void* _dst, int64_t num) {
   KernelFp32ToFp16<<<(num + 255) / 256, 256>>>(src, dst, num);
 }
 
+// The Philox state is cheap to initialize and small enough to keep one per
+// sequence in a persistent device buffer across decode steps.
+using SamplerState = curandStatePhilox4_32_10_t;
+
+constexpr int kSampleBlockSize = 256;
+
+size_t SamplerStateSize() { return sizeof(SamplerState); }
+
+__global__ void KernelSamplerInit(SamplerState* states, int64_t num_seqs, uint64_t seed) {
+  int64_t idx = blockDim.x * blockIdx.x + threadIdx.x;
+  if (idx < num_seqs) {
+    curand_init(seed, idx, 0, &states[idx]);
+  }
+}
+
+void SamplerInitStates(void* states, int64_t num_seqs, uint64_t seed, void* stream) {
+  KernelSamplerInit<<<(num_seqs + kSampleBlockSize - 1) / kSampleBlockSize, kSampleBlockSize, 0,
+                      static_cast<cudaStream_t>(stream)>>>(static_cast<SamplerState*>(states),
+                                                           num_seqs, seed);
+}
+
+__device__ __forceinline__ float BlockReduceMax(float val, float* shared) {
+  int tid = threadIdx.x;
+  shared[tid] = val;
+  __syncthreads();
+  for (int offset = kSampleBlockSize / 2; offset > 0; offset >>= 1) {
+    if (tid < offset) shared[tid] = fmaxf(shared[tid], shared[tid + offset]);
+    __syncthreads();
+  }
+  float result = shared[0];
+  __syncthreads();
+  return result;
+}
+
+__device__ __forceinline__ float BlockReduceSum(float val, float* shared) {
+  int tid = threadIdx.x;
+  shared[tid] = val;
+  __syncthreads();
+  for (int offset = kSampleBlockSize / 2; offset > 0; offset >>= 1) {
+    if (tid < offset) shared[tid] += shared[tid + offset];
+    __syncthreads();
+  }
+  float result = shared[0];
+  __syncthreads();
+  return result;
+}
+
+// Whether the grammar bitmask row allows token i; a null row allows everything.
+__device__ __forceinline__ bool TokenAllowed(const uint32_t* __restrict__ mask_row, int64_t i) {
+  return mask_row == nullptr || ((mask_row[i >> 5] >> (i & 31)) & 1u);
+}
+
+/*!
+ * \brief One block per sequence: softmax, top-k/top-p filtering and sampling.
+ *
+ * Instead of sorting the vocabulary, the top-k and top-p filters are realized
+ * as probability thresholds found by binary search over block-wide
+ * count/mass reductions, and the token is drawn by an inverse-CDF scan over
+ * the filtered distribution. Everything runs in one launch and the result
+ * stays on device.
+ *
+ * When a grammar mask table is given, disallowed tokens read as -inf logits,
+ * so they drop out of the softmax and every later pass for free; the mask row
+ * is picked per sequence from the on-device automaton states.
+ */
+__global__ void KernelFusedSample(const float* __restrict__ logits, int64_t vocab,
+                                  float temperature, float top_p, int64_t top_k,
+                                  SamplerState* states, const uint32_t* __restrict__ masks,
+                                  int64_t mask_words, const int32_t* __restrict__ seq_states,
+                                  int32_t* __restrict__ out_tokens) {
+  __shared__ float shared[kSampleBlockSize];
+  __shared__ int chosen;
+  __shared__ int last_kept;
+  __shared__ float u_shared;
+  __shared__ float running_shared;
+
+  const float* row = logits + static_cast<int64_t>(blockIdx.x) * vocab;
+  const uint32_t* mask_row =
+      masks == nullptr ? nullptr : masks + static_cast<int64_t>(seq_states[blockIdx.x]) * mask_words;
+  int tid = threadIdx.x;
+
+  float local_max = -CUDART_INF_F;
+  int local_arg = 0;
+  for (int64_t i = tid; i < vocab; i += kSampleBlockSize) {
+    float v = TokenAllowed(mask_row, i) ? row[i] : -CUDART_INF_F;
+    if (v > local_max) {
+      local_max = v;
+      local_arg = static_cast<int>(i);
+    }
+  }
+  float max_logit = BlockReduceMax(local_max, shared);
+
+  if (temperature < 1e-6f) {
+    // Greedy decoding: the smallest index attaining the maximum.
+    if (tid == 0) chosen = static_cast<int>(vocab);
+    __syncthreads();
+    if (local_max == max_logit) atomicMin(&chosen, local_arg);
+    __syncthreads();
+    if (tid == 0) out_tokens[blockIdx.x] = chosen;
+    return;
+  }
+
+  float inv_temp = 1.0f / temperature;
+  float local_sum = 0.0f;
+  for (int64_t i = tid; i < vocab; i += kSampleBlockSize) {
+    if (!TokenAllowed(mask_row, i)) continue;
+    local_sum += __expf((row[i] - max_logit) * inv_temp);
+  }
+  float inv_z = 1.0f / BlockReduceSum(local_sum, shared);
+
+  // Probability thresholds equivalent to the top-k and top-p filters. Both
+  // predicates are monotone in the threshold, so 32 bisection steps pin them
+  // down to float precision; ties at the boundary are kept or dropped
+  // together, which is the usual fuzziness of threshold-based filtering.
+  float tau = 0.0f;
+  if (top_k > 0 && top_k < vocab) {
+    float lo = 0.0f, hi = 1.0f;
+    for (int iter = 0; iter < 32; ++iter) {
+      float mid = 0.5f * (lo + hi);
+      float local_cnt = 0.0f;
+      for (int64_t i = tid; i < vocab; i += kSampleBlockSize) {
+        if (!TokenAllowed(mask_row, i)) continue;
+        float p = __expf((row[i] - max_logit) * inv_temp) * inv_z;
+        if (p >= mid) local_cnt += 1.0f;
+      }
+      float cnt = BlockReduceSum(local_cnt, shared);
+      if (cnt <= static_cast<float>(top_k)) {
+        hi = mid;
+      } else {
+        lo = mid;
+      }
+    }
+    tau = hi;
+  }
+  if (top_p < 1.0f) {
+    float lo = 0.0f, hi = 1.0f;
+    for (int iter = 0; iter < 32; ++iter) {
+      float mid = 0.5f * (lo + hi);
+      float local_mass = 0.0f;
+      for (int64_t i = tid; i < vocab; i += kSampleBlockSize) {
+        if (!TokenAllowed(mask_row, i)) continue;
+        float p = __expf((row[i] - max_logit) * inv_temp) * inv_z;
+        if (p >= mid) local_mass += p;
+      }
+      float mass = BlockReduceSum(local_mass, shared);
+      if (mass >= top_p) {
+        lo = mid;
+      } else {
+        hi = mid;
+      }
+    }
+    tau = fmaxf(tau, lo);
+  }
+
+  float local_mass = 0.0f;
+  for (int64_t i = tid; i < vocab; i += kSampleBlockSize) {
+    if (!TokenAllowed(mask_row, i)) continue;
+    float p = __expf((row[i] - max_logit) * inv_temp) * inv_z;
+    if (p >= tau) local_mass += p;
+  }
+  float filtered_mass = BlockReduceSum(local_mass, shared);
+
+  if (tid == 0) {
+    SamplerState state = states[blockIdx.x];
+    u_shared = curand_uniform(&state) * filtered_mass;
+    states[blockIdx.x] = state;
+    chosen = static_cast<int>(vocab);
+    last_kept = -1;
+    running_shared = 0.0f;
+  }
+  __syncthreads();
+  float u = u_shared;
+
+  // Inverse-CDF selection over the filtered distribution, one block-sized
+  // chunk at a time with an inclusive prefix scan per chunk.
+  for (int64_t base = 0; base < vocab; base += kSampleBlockSize) {
+    int64_t i = base + tid;
+    float p = 0.0f;
+    if (i < vocab && TokenAllowed(mask_row, i)) {
+      p = __expf((row[i] - max_logit) * inv_temp) * inv_z;
+      if (p < tau) p = 0.0f;
+    }
+    shared[tid] = p;
+    __syncthreads();
+    for (int offset = 1; offset < kSampleBlockSize; offset <<= 1) {
+      float v = tid >= offset ? shared[tid - offset] : 0.0f;
+      __syncthreads();
+      shared[tid] += v;
+      __syncthreads();
+    }
+    float inclusive = shared[tid];
+    float chunk_total = shared[kSampleBlockSize - 1];
+    float running = running_shared;
+    if (p > 0.0f) {
+      atomicMax(&last_kept, static_cast<int>(i));
+      if (running + inclusive > u) atomicMin(&chosen, static_cast<int>(i));
+    }
+    __syncthreads();
+    if (tid == 0) running_shared += chunk_total;
+    __syncthreads();
+    if (chosen < static_cast<int>(vocab)) break;
+  }
+
+  if (tid == 0) {
+    // Rounding in the scan can leave u unreached; fall back to the last
+    // token that passed the filter.
+    out_tokens[blockIdx.x] = chosen < static_cast<int>(vocab) ? chosen : last_kept;
+  }
+}
+
+void FusedSampleFromLogits(const float* logits, int64_t batch, int64_t vocab, float temperature,
+                           float top_p, int64_t top_k, void* states, const uint32_t* masks,
+                           int64_t mask_words, const int32_t* seq_states, int32_t* out_tokens,
+                           void* stream) {
+  KernelFusedSample<<<batch, kSampleBlockSize, 0, static_cast<cudaStream_t>(stream)>>>(
+      logits, vocab, temperature, top_p, top_k, static_cast<SamplerState*>(states), masks,
+      mask_words, seq_states, out_tokens);
+}
+
 }  // namespace curand
 }  // namespace runtime
 }  // namespace tvm
@@ -22,6 +22,8 @@
 #include <curand.h>
 #include <tvm/ffi/function.h>
 
+#include <cstdint>
+
 namespace tvm {
 namespace runtime {
 namespace curand {
@@ -34,6 +36,49 @@ namespace curand {
  */
 void ConvertFp32toFp16(const void* src, void* dst, int64_t num);
 
+/*!
+ * \brief The size in bytes of one per-sequence sampler RNG state.
+ * \note The state type lives in curand_kernel.h and is opaque to the host side.
+ */
+size_t SamplerStateSize();
+
+/*!
+ * \brief Seed the per-sequence sampler RNG states.
+ * \param states The state buffer of num_seqs * SamplerStateSize() bytes on device.
+ * \param num_seqs The number of sequences.
+ * \param seed The seed; each sequence gets an independent subsequence.
+ * \param stream The CUDA stream to launch on.
+ */
+void SamplerInitStates(void* states, int64_t num_seqs, uint64_t seed, void* stream);
+
+/*!
+ * \brief Fused temperature/top-k/top-p sampling from a batch of logits.
+ *
+ * One kernel per call: softmax normalization, top-k and top-p filtering via a
+ * probability-threshold search, and inverse-CDF sampling with the persistent
+ * per-sequence RNG states. Tokens are written to a device buffer, so no host
+ * synchronization is involved.
+ *
+ * \param logits The [batch, vocab] FP32 logits on device.
+ * \param batch The number of sequences.
+ * \param vocab The vocabulary size.
+ * \param temperature The softmax temperature; below 1e-6 samples greedily.
+ * \param top_p The nucleus mass to keep; >= 1 disables the filter.
+ * \param top_k The number of top tokens to keep; <= 0 or >= vocab disables it.
+ * \param states The RNG states of the leading batch sequences.
+ * \param masks The [num_states, mask_words] uint32 grammar vocabulary bitmasks
+ *        on device, or nullptr when decoding is unconstrained.
+ * \param mask_words The number of uint32 words per mask row.
+ * \param seq_states The [batch] int32 automaton state of each sequence on
+ *        device; only read when masks is non-null.
+ * \param out_tokens The [batch] int32 device buffer receiving the tokens.
+ * \param stream The CUDA stream to launch on.
+ */
+void FusedSampleFromLogits(const float* logits, int64_t batch, int64_t vocab, float temperature,
+                           float top_p, int64_t top_k, void* states, const uint32_t* masks,
+                           int64_t mask_words, const int32_t* seq_states, int32_t* out_tokens,
+                           void* stream);
+
 }  // namespace curand
 }  // namespace runtime
 }  // namespace tvm
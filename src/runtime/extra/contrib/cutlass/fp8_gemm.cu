@@ -24,6 +24,9 @@
 #include <tvm/ffi/reflection/registry.h>
 #include <tvm/runtime/tensor.h>
 
+#include <mutex>
+#include <unordered_map>
+
 #include "../cublas/cublas_utils.h"
 #include "gemm_runner.cuh"
 
@@ -35,9 +38,86 @@ struct KernelTraitsM64 {
   using ClusterShape = Shape<_1, _8, _1>;
 };
 
+struct KernelTraitsM128 {
+  using KernelSchedule = cutlass::gemm::KernelTmaWarpSpecializedPingpongFP8FastAccum;
+  using TileShape = Shape<_128, _64, _128>;
+  using ClusterShape = Shape<_2, _1, _1>;
+};
+
+struct KernelTraitsM256 {
+  using KernelSchedule = cutlass::gemm::KernelTmaWarpSpecializedCooperativeFP8FastAccum;
+  using TileShape = Shape<_128, _128, _128>;
+  using ClusterShape = Shape<_1, _2, _1>;
+};
+
 namespace tvm {
 namespace runtime {
 
+namespace {
+
+/*!
+ * \brief Round m up to a power-of-two bucket so the sweeping batch sizes of
+ * decode share one profiled winner per (bucket, n, k) shape.
+ */
+int64_t BucketM(int64_t m) {
+  int64_t bucket = 16;
+  while (bucket < m) {
+    bucket *= 2;
+  }
+  return bucket;
+}
+
+/*!
+ * \brief Time one candidate on `stream` with CUDA events. Returns FLT_MAX
+ * when the candidate cannot run the shape, so it loses the selection.
+ * Profiling synchronizes, but only on the first encounter of a shape bucket.
+ */
+template <typename F>
+float TimeCandidate(F&& run, cudaStream_t stream) {
+  cudaEvent_t start, stop;
+  TVM_FFI_CHECK_CUDA_ERROR(cudaEventCreate(&start));
+  TVM_FFI_CHECK_CUDA_ERROR(cudaEventCreate(&stop));
+  float elapsed_ms = FLT_MAX;
+  try {
+    constexpr int kProfileIters = 3;
+    // The untimed run warms up and surfaces can_implement failures.
+    run();
+    TVM_FFI_CHECK_CUDA_ERROR(cudaEventRecord(start, stream));
+    for (int i = 0; i < kProfileIters; ++i) {
+      run();
+    }
+    TVM_FFI_CHECK_CUDA_ERROR(cudaEventRecord(stop, stream));
+    TVM_FFI_CHECK_CUDA_ERROR(cudaEventSynchronize(stop));
+    TVM_FFI_CHECK_CUDA_ERROR(cudaEventElapsedTime(&elapsed_ms, start, stop));
+  } catch (const std::exception& err) {
+    elapsed_ms = FLT_MAX;
+  }
+  cudaEventDestroy(start);
+  cudaEventDestroy(stop);
+  return elapsed_ms;
+}
+
+struct GemmShapeKey {
+  int64_t m_bucket;
+  int64_t n;
+  int64_t k;
+
+  bool operator==(const GemmShapeKey& other) const {
+    return m_bucket == other.m_bucket && n == other.n && k == other.k;
+  }
+};
+
+struct GemmShapeKeyHash {
+  size_t operator()(const GemmShapeKey& key) const {
+    size_t seed = std::hash<int64_t>()(key.m_bucket);
+    seed ^= std::hash<int64_t>()(key.n) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    seed ^= std::hash<int64_t>()(key.k) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    return seed;
+  }
+};
+
+}  // namespace
+
 template <typename ElementA, typename ElementB, typename ElementC>
 void tvm_cutlass_fp8_gemm(Tensor x, Tensor weight, Tensor workspace, Tensor alpha, Tensor out) {
   // Workspace is used for storing device-side gemm arguments and cutlass internal workspace.
@@ -61,20 +141,72 @@ void tvm_cutlass_fp8_gemm(Tensor x, Tensor weight, Tensor workspace, Tensor alph
       << "Only col-major weight is supported now.";
   int64_t k = x->shape[x->ndim - 1];
   const float* beta = nullptr;
-  if (m <= 64) {
-    cutlass_gemm<KernelTraitsM64>(
+
+  auto run_cutlass = [&](auto traits) {
+    cutlass_gemm<decltype(traits)>(
         static_cast<ElementA*>(x->data), static_cast<ElementB*>(weight->data),
         static_cast<uint8_t*>(workspace->data), workspace->shape[0], m, n, k,
         static_cast<float*>(alpha->data), beta, static_cast<ElementC*>(out->data), stream);
-  } else {
+  };
+  auto run_cublas = [&]() {
     tvm::contrib::CuBlasLtThreadEntry* cublas_entry =
         tvm::contrib::CuBlasLtThreadEntry::ThreadLocal(x->device);
     tvm::contrib::CallCublasLt(cublas_entry->handle, stream, cublas_entry->matmul_pref_desc,
                                x.operator->(), weight.operator->(), nullptr, alpha.operator->(),
                                nullptr, out.operator->(), /*transa=*/false, /*transb=*/true,
                                cublas_entry->workspace_ptr, cublas_entry->workspace_size,
-                               CUBLASLT_EPILOGUE_DEFAULT, std::nullopt);
+                               CUBLASLT_EPILOGUE_DEFAULT, std::nullopt,
+                               &cublas_entry->algo_cache);
+  };
+  auto run_candidate = [&](int candidate) {
+    switch (candidate) {
+      case 0:
+        run_cutlass(KernelTraitsM64{});
+        break;
+      case 1:
+        run_cutlass(KernelTraitsM128{});
+        break;
+      case 2:
+        run_cutlass(KernelTraitsM256{});
+        break;
+      default:
+        run_cublas();
+        break;
+    }
+  };
+  constexpr int kNumCandidates = 4;
+
+  // Profile-based tile selection: decode sweeps m while n and k stay fixed,
+  // so instead of one fixed tile per pattern the first call of each shape
+  // bucket times every compiled tile configuration (and the cuBLASLt path)
+  // and persists the winner; later calls dispatch straight to it. The table
+  // is per element-type instantiation since these are distinct kernels.
+  static std::mutex winners_mutex;
+  static std::unordered_map<GemmShapeKey, int, GemmShapeKeyHash> winners;
+
+  GemmShapeKey shape_key{BucketM(m), n, k};
+  int selected = -1;
+  {
+    std::lock_guard<std::mutex> lock(winners_mutex);
+    auto it = winners.find(shape_key);
+    if (it != winners.end()) {
+      selected = it->second;
+    }
+  }
+  if (selected < 0) {
+    float best_ms = FLT_MAX;
+    selected = kNumCandidates - 1;  // fall back to cuBLASLt when nothing times
+    for (int candidate = 0; candidate < kNumCandidates; ++candidate) {
+      float ms = TimeCandidate([&]() { run_candidate(candidate); }, stream);
+      if (ms < best_ms) {
+        best_ms = ms;
+        selected = candidate;
+      }
+    }
+    std::lock_guard<std::mutex> lock(winners_mutex);
+    winners.emplace(shape_key, selected);
   }
+  run_candidate(selected);
 }
 
 TVM_FFI_STATIC_INIT_BLOCK() {
@@ -16,6 +16,8 @@
  * specific language governing permissions and limitations
  * under the License.
  */
+#include <cuda_bf16.h>
+#include <cuda_fp16.h>
 #include <nvshmem.h>
 #include <nvshmemx.h>
 #include <tvm/ffi/extra/c_env_api.h>
@@ -123,6 +125,86 @@ void transfer_to_peers_all_gather(Tensor semaphore, Tensor A, Tensor ag_out, TVM
     }
   }
 }
+constexpr int kMaxAllReducePeers = 8;
+
+struct AllReducePeerPtrs {
+  void* ptrs[kMaxAllReducePeers];
+};
+
+template <typename T>
+__global__ void reduce_from_peers_kernel(AllReducePeerPtrs peers, T* dst, int64_t numel,
+                                         int world_size) {
+  int64_t idx = static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+  int64_t stride = static_cast<int64_t>(gridDim.x) * blockDim.x;
+  for (int64_t i = idx; i < numel; i += stride) {
+    float acc = 0.f;
+    for (int r = 0; r < world_size; ++r) {
+      acc += static_cast<float>(static_cast<const T*>(peers.ptrs[r])[i]);
+    }
+    dst[i] = static_cast<T>(acc);
+  }
+}
+
+// All-reduce epilogue for tensor-parallel GEMMs. The GEMM kernel writes its
+// partial output straight into the symmetric gemm_out buffer and counts
+// finished tiles into tile_semaphore[my_rank]. Once the count completes, the
+// rank announces itself in every peer's ready_flags[my_rank], waits for all
+// peers and reduces their symmetric outputs into dst in a single pass over
+// NVLink — no staging buffer and no extra global-memory round trip. The
+// caller zeroes (or rotates) tile_semaphore and ready_flags between layers.
+void allreduce_gemm_epilogue(Tensor tile_semaphore, Tensor ready_flags, Tensor gemm_out, Tensor dst,
+                             TVMStreamHandle stream, int32_t num_tiles, int32_t WORLD_SIZE) {
+  DiscoWorker* worker = ThreadLocalDiscoWorker::Get()->worker;
+  TVM_FFI_ICHECK(worker != nullptr)
+      << "NVSHMEM all-reduce epilogue failed: worker is not initialized";
+  TVM_FFI_ICHECK_LE(WORLD_SIZE, kMaxAllReducePeers);
+  int my_rank = worker->worker_id;
+
+  cuStreamWaitValue64Wrapper(stream, get_pointer(tile_semaphore, ffi::Shape{my_rank}), num_tiles);
+  for (int r = 0; r < WORLD_SIZE; ++r) {
+    if (r != my_rank) {
+      cuStreamWriteValue64Wrapper(stream, get_pointer(ready_flags, ffi::Shape{my_rank}), 1, r);
+    }
+  }
+  for (int r = 0; r < WORLD_SIZE; ++r) {
+    if (r != my_rank) {
+      cuStreamWaitValue64Wrapper(stream, get_pointer(ready_flags, ffi::Shape{r}), 1);
+    }
+  }
+
+  void* local = static_cast<char*>(gemm_out->data) + gemm_out->byte_offset;
+  AllReducePeerPtrs peers;
+  for (int r = 0; r < WORLD_SIZE; ++r) {
+    peers.ptrs[r] = r == my_rank ? local : nvshmem_ptr(local, r);
+    TVM_FFI_ICHECK(peers.ptrs[r] != nullptr)
+        << "NVSHMEM peer " << r << " is not P2P accessible for the all-reduce epilogue";
+  }
+
+  int64_t numel = 1;
+  for (int i = 0; i < gemm_out->ndim; ++i) {
+    numel *= gemm_out->shape[i];
+  }
+  constexpr int kThreads = 256;
+  int64_t max_blocks = (numel + kThreads - 1) / kThreads;
+  int blocks = static_cast<int>(max_blocks < 1024 ? max_blocks : 1024);
+  cudaStream_t strm = static_cast<cudaStream_t>(stream);
+  void* dst_ptr = static_cast<char*>(dst->data) + dst->byte_offset;
+
+  DLDataType dtype = gemm_out->dtype;
+  if (dtype.code == kDLFloat && dtype.bits == 16) {
+    reduce_from_peers_kernel<__half>
+        <<<blocks, kThreads, 0, strm>>>(peers, static_cast<__half*>(dst_ptr), numel, WORLD_SIZE);
+  } else if (dtype.code == kDLBfloat && dtype.bits == 16) {
+    reduce_from_peers_kernel<__nv_bfloat16><<<blocks, kThreads, 0, strm>>>(
+        peers, static_cast<__nv_bfloat16*>(dst_ptr), numel, WORLD_SIZE);
+  } else if (dtype.code == kDLFloat && dtype.bits == 32) {
+    reduce_from_peers_kernel<float>
+        <<<blocks, kThreads, 0, strm>>>(peers, static_cast<float*>(dst_ptr), numel, WORLD_SIZE);
+  } else {
+    TVM_FFI_ICHECK(false) << "Unsupported dtype for the all-reduce epilogue";
+  }
+}
+
 TVM_FFI_STATIC_INIT_BLOCK() {
   namespace refl = tvm::ffi::reflection;
   refl::GlobalDef()
@@ -132,6 +214,7 @@ TVM_FFI_STATIC_INIT_BLOCK() {
       .def("runtime.disco.stream_sync", stream_sync)
       .def("runtime.disco.transfer_to_peers_reduce_scatter", transfer_to_peers_reduce_scatter)
       .def("runtime.disco.transfer_to_peers_all_gather", transfer_to_peers_all_gather)
+      .def("runtime.disco.allreduce_gemm_epilogue", allreduce_gemm_epilogue)
       .def("runtime.disco.set_streaming_policy",
            [](TVMStreamHandle stream, Tensor ptr, size_t size) {
              set_streaming_policy(stream, ptr->data, size);
@@ -0,0 +1,487 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file Radix sort, batched segmented sort and segmented top-k for
+ * fixed-width keys on CPU. The comparison sorts in sort.cc spend most of
+ * their time in the comparator for small keys; the routines here use
+ * byte-wise LSD radix passes instead and amortize the dispatch over many
+ * segments per call, parallelized with the TVM threading backend.
+ */
+
+#include <dlpack/dlpack.h>
+#include <tvm/ffi/container/tensor.h>
+#include <tvm/ffi/dtype.h>
+#include <tvm/ffi/error.h>
+#include <tvm/ffi/function.h>
+#include <tvm/ffi/reflection/registry.h>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "../../../threading_backend.h"
+
+namespace tvm {
+namespace contrib {
+
+/*!
+ * \brief Map a fixed-width key to an unsigned integer whose natural order
+ * matches the key's order, so all key types share one radix kernel.
+ */
+template <typename DataType>
+struct RadixTraits;
+
+template <>
+struct RadixTraits<uint8_t> {
+  using Bits = uint8_t;
+  static Bits ToBits(uint8_t value) { return value; }
+  static uint8_t FromBits(Bits bits) { return bits; }
+};
+
+template <>
+struct RadixTraits<int8_t> {
+  using Bits = uint8_t;
+  static Bits ToBits(int8_t value) { return static_cast<uint8_t>(value) ^ 0x80u; }
+  static int8_t FromBits(Bits bits) { return static_cast<int8_t>(bits ^ 0x80u); }
+};
+
+template <>
+struct RadixTraits<int32_t> {
+  using Bits = uint32_t;
+  static Bits ToBits(int32_t value) { return static_cast<uint32_t>(value) ^ 0x80000000u; }
+  static int32_t FromBits(Bits bits) { return static_cast<int32_t>(bits ^ 0x80000000u); }
+};
+
+template <>
+struct RadixTraits<int64_t> {
+  using Bits = uint64_t;
+  static Bits ToBits(int64_t value) {
+    return static_cast<uint64_t>(value) ^ 0x8000000000000000ull;
+  }
+  static int64_t FromBits(Bits bits) { return static_cast<int64_t>(bits ^ 0x8000000000000000ull); }
+};
+
+template <>
+struct RadixTraits<float> {
+  using Bits = uint32_t;
+  static Bits ToBits(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+  }
+  static float FromBits(Bits bits) {
+    bits = (bits & 0x80000000u) ? (bits ^ 0x80000000u) : ~bits;
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+};
+
+template <>
+struct RadixTraits<double> {
+  using Bits = uint64_t;
+  static Bits ToBits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x8000000000000000ull) ? ~bits : (bits | 0x8000000000000000ull);
+  }
+  static double FromBits(Bits bits) {
+    bits = (bits & 0x8000000000000000ull) ? (bits ^ 0x8000000000000000ull) : ~bits;
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+};
+
+/*!
+ * \brief The raw bits of a float16 value. The IEEE sign-flip trick used for
+ * float/double applies to any IEEE format, so half keys sort through their
+ * bit pattern without converting to float.
+ */
+struct Float16Bits {
+  uint16_t bits;
+};
+
+template <>
+struct RadixTraits<Float16Bits> {
+  using Bits = uint16_t;
+  static Bits ToBits(Float16Bits value) {
+    return (value.bits & 0x8000u) ? static_cast<uint16_t>(~value.bits)
+                                  : static_cast<uint16_t>(value.bits | 0x8000u);
+  }
+  static Float16Bits FromBits(Bits bits) {
+    bits = (bits & 0x8000u) ? static_cast<uint16_t>(bits ^ 0x8000u) : static_cast<uint16_t>(~bits);
+    return Float16Bits{bits};
+  }
+};
+
+// Comparisons on half keys go through the same order-preserving bit mapping,
+// so segmented top-k shares the comparator path with the other key types.
+inline bool operator==(Float16Bits lhs, Float16Bits rhs) {
+  return RadixTraits<Float16Bits>::ToBits(lhs) == RadixTraits<Float16Bits>::ToBits(rhs);
+}
+inline bool operator<(Float16Bits lhs, Float16Bits rhs) {
+  return RadixTraits<Float16Bits>::ToBits(lhs) < RadixTraits<Float16Bits>::ToBits(rhs);
+}
+inline bool operator>(Float16Bits lhs, Float16Bits rhs) {
+  return RadixTraits<Float16Bits>::ToBits(lhs) > RadixTraits<Float16Bits>::ToBits(rhs);
+}
+
+/*!
+ * \brief LSD radix sort of unsigned keys with one 8-bit pass per key byte.
+ * Passes where all keys share the same byte are skipped, so partially
+ * uniform data (e.g. small scores in a wide type) sorts in fewer passes.
+ * The tight count/scatter loops carry no comparator and vectorize well.
+ */
+template <typename UIntType>
+void RadixSortBits(UIntType* keys, UIntType* temp, int64_t n) {
+  constexpr int kNumPasses = static_cast<int>(sizeof(UIntType));
+  int64_t counts[256];
+  UIntType* src = keys;
+  UIntType* dst = temp;
+  for (int pass = 0; pass < kNumPasses; ++pass) {
+    const int shift = pass * 8;
+    std::fill(counts, counts + 256, 0);
+    for (int64_t i = 0; i < n; ++i) {
+      ++counts[(src[i] >> shift) & 0xff];
+    }
+    if (counts[(src[0] >> shift) & 0xff] == n) {
+      continue;
+    }
+    int64_t total = 0;
+    for (int byte = 0; byte < 256; ++byte) {
+      int64_t count = counts[byte];
+      counts[byte] = total;
+      total += count;
+    }
+    for (int64_t i = 0; i < n; ++i) {
+      dst[counts[(src[i] >> shift) & 0xff]++] = src[i];
+    }
+    std::swap(src, dst);
+  }
+  if (src != keys) {
+    std::copy(src, src + n, keys);
+  }
+}
+
+/*!
+ * \brief Sort one contiguous run of keys from `in` into `out`.
+ * \note Only the values are sorted; radix passes over bare keys stay in the
+ * vector units, which is where the speedup over pair-based std::sort comes
+ * from.
+ */
+template <typename DataType>
+void RadixSortRun(const DataType* in, DataType* out, int64_t n, bool is_ascend,
+                  std::vector<typename RadixTraits<DataType>::Bits>* key_buf,
+                  std::vector<typename RadixTraits<DataType>::Bits>* temp_buf) {
+  using Bits = typename RadixTraits<DataType>::Bits;
+  if (n <= 0) {
+    return;
+  }
+  key_buf->resize(n);
+  temp_buf->resize(n);
+  Bits* keys = key_buf->data();
+  for (int64_t i = 0; i < n; ++i) {
+    keys[i] = RadixTraits<DataType>::ToBits(in[i]);
+  }
+  RadixSortBits(keys, temp_buf->data(), n);
+  if (is_ascend) {
+    for (int64_t i = 0; i < n; ++i) {
+      out[i] = RadixTraits<DataType>::FromBits(keys[i]);
+    }
+  } else {
+    for (int64_t i = 0; i < n; ++i) {
+      out[i] = RadixTraits<DataType>::FromBits(keys[n - 1 - i]);
+    }
+  }
+}
+
+/*! \brief Radix sort every row of a [num_rows, row_len] view in parallel. */
+template <typename DataType>
+void RadixSortRows(DLTensor* input, DLTensor* output, int64_t num_rows, int64_t row_len,
+                   bool is_ascend) {
+  const DataType* in_ptr = static_cast<const DataType*>(input->data);
+  DataType* out_ptr = static_cast<DataType*>(output->data);
+  runtime::parallel_for_with_threading_backend(
+      [=](int64_t row) {
+        thread_local std::vector<typename RadixTraits<DataType>::Bits> key_buf;
+        thread_local std::vector<typename RadixTraits<DataType>::Bits> temp_buf;
+        RadixSortRun(in_ptr + row * row_len, out_ptr + row * row_len, row_len, is_ascend, &key_buf,
+                     &temp_buf);
+      },
+      0, num_rows);
+}
+
+/*!
+ * \brief Radix sort many variable-length segments of a flat buffer with one
+ * call. Segments are independent and distributed over the threading backend.
+ */
+template <typename DataType, typename OffsetType>
+void SegmentedSort(DLTensor* input, DLTensor* segment_offsets, DLTensor* output,
+                   int64_t num_segments, bool is_ascend) {
+  const DataType* in_ptr = static_cast<const DataType*>(input->data);
+  const OffsetType* offsets = static_cast<const OffsetType*>(segment_offsets->data);
+  DataType* out_ptr = static_cast<DataType*>(output->data);
+  runtime::parallel_for_with_threading_backend(
+      [=](int64_t seg) {
+        thread_local std::vector<typename RadixTraits<DataType>::Bits> key_buf;
+        thread_local std::vector<typename RadixTraits<DataType>::Bits> temp_buf;
+        int64_t begin = static_cast<int64_t>(offsets[seg]);
+        int64_t end = static_cast<int64_t>(offsets[seg + 1]);
+        RadixSortRun(in_ptr + begin, out_ptr + begin, end - begin, is_ascend, &key_buf, &temp_buf);
+      },
+      0, num_segments);
+}
+
+/*!
+ * \brief Select the top-k entries of every segment without sorting the full
+ * segment: nth_element partitions in linear time, then only the k selected
+ * entries are sorted. Indices are relative to the segment start. Segments
+ * shorter than k fill only their first `segment length` output slots.
+ */
+template <typename DataType, typename OffsetType, typename IndicesType>
+void SegmentedTopK(DLTensor* input, DLTensor* segment_offsets, DLTensor* out_values,
+                   DLTensor* out_indices, int64_t num_segments, int64_t k, bool is_ascend) {
+  const DataType* in_ptr = static_cast<const DataType*>(input->data);
+  const OffsetType* offsets = static_cast<const OffsetType*>(segment_offsets->data);
+  DataType* values_ptr =
+      (out_values == nullptr) ? nullptr : static_cast<DataType*>(out_values->data);
+  IndicesType* indices_ptr =
+      (out_indices == nullptr) ? nullptr : static_cast<IndicesType*>(out_indices->data);
+  runtime::parallel_for_with_threading_backend(
+      [=](int64_t seg) {
+        thread_local std::vector<std::pair<DataType, int64_t>> entries;
+        int64_t begin = static_cast<int64_t>(offsets[seg]);
+        int64_t end = static_cast<int64_t>(offsets[seg + 1]);
+        int64_t n = end - begin;
+        if (n <= 0) {
+          return;
+        }
+        entries.resize(n);
+        for (int64_t i = 0; i < n; ++i) {
+          entries[i] = {in_ptr[begin + i], i};
+        }
+        auto compare = [is_ascend](const std::pair<DataType, int64_t>& lhs,
+                                   const std::pair<DataType, int64_t>& rhs) {
+          if (lhs.first == rhs.first) {
+            return lhs.second < rhs.second;
+          }
+          return is_ascend ? lhs.first < rhs.first : lhs.first > rhs.first;
+        };
+        int64_t num_selected = std::min(k, n);
+        if (num_selected < n) {
+          std::nth_element(entries.begin(), entries.begin() + num_selected, entries.end(), compare);
+        }
+        std::sort(entries.begin(), entries.begin() + num_selected, compare);
+        int64_t dst_base = seg * k;
+        for (int64_t i = 0; i < num_selected; ++i) {
+          if (values_ptr != nullptr) {
+            values_ptr[dst_base + i] = entries[i].first;
+          }
+          if (indices_ptr != nullptr) {
+            indices_ptr[dst_base + i] = static_cast<IndicesType>(entries[i].second);
+          }
+        }
+      },
+      0, num_segments);
+}
+
+/*!
+ * \brief Invoke `kernel<DataType>(kernel_args...)` for the fixed-width key
+ * dtype of `dtype_str`, so every entry point shares one dispatch table.
+ */
+template <template <typename> class Kernel, typename... Args>
+void DispatchKeyDType(const std::string& dtype_str, Args&&... args) {
+  if (dtype_str == "float32") {
+    Kernel<float>::Run(std::forward<Args>(args)...);
+  } else if (dtype_str == "float64") {
+    Kernel<double>::Run(std::forward<Args>(args)...);
+  } else if (dtype_str == "float16") {
+    Kernel<Float16Bits>::Run(std::forward<Args>(args)...);
+  } else if (dtype_str == "int32") {
+    Kernel<int32_t>::Run(std::forward<Args>(args)...);
+  } else if (dtype_str == "int64") {
+    Kernel<int64_t>::Run(std::forward<Args>(args)...);
+  } else if (dtype_str == "uint8") {
+    Kernel<uint8_t>::Run(std::forward<Args>(args)...);
+  } else if (dtype_str == "int8") {
+    Kernel<int8_t>::Run(std::forward<Args>(args)...);
+  } else {
+    TVM_FFI_THROW(InternalError) << "Unsupported key dtype for radix sort: " << dtype_str;
+  }
+}
+
+template <typename DataType>
+struct RadixSortKernel {
+  static void Run(DLTensor* input, DLTensor* output, int64_t num_rows, int64_t row_len,
+                  bool is_ascend) {
+    RadixSortRows<DataType>(input, output, num_rows, row_len, is_ascend);
+  }
+};
+
+template <typename DataType>
+struct SegmentedSortKernel {
+  static void Run(DLTensor* input, DLTensor* segment_offsets, DLTensor* output,
+                  int64_t num_segments, bool is_ascend) {
+    if (ffi::DLDataTypeToString(segment_offsets->dtype) == "int32") {
+      SegmentedSort<DataType, int32_t>(input, segment_offsets, output, num_segments, is_ascend);
+    } else {
+      SegmentedSort<DataType, int64_t>(input, segment_offsets, output, num_segments, is_ascend);
+    }
+  }
+};
+
+// Radix sort along the last axis of a contiguous tensor.
+// The input is treated as [num_rows, row_len] with row_len the size of the
+// last axis; every row is sorted independently.
+void RegisterRadixSort() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def_packed(
+      "tvm.contrib.sort.radix_sort", [](ffi::PackedArgs args, ffi::Any* ret) {
+        auto input = args[0].cast<DLTensor*>();
+        auto output = args[1].cast<DLTensor*>();
+        bool is_ascend = args[2].cast<bool>();
+
+        TVM_FFI_ICHECK_GE(input->ndim, 1) << "radix_sort expects at least one axis";
+        int64_t row_len = input->shape[input->ndim - 1];
+        int64_t num_rows = 1;
+        for (int i = 0; i < input->ndim - 1; ++i) {
+          num_rows *= input->shape[i];
+        }
+
+        auto data_dtype = ffi::DLDataTypeToString(input->dtype);
+        auto out_dtype = ffi::DLDataTypeToString(output->dtype);
+        TVM_FFI_ICHECK_EQ(data_dtype, out_dtype);
+
+        DispatchKeyDType<RadixSortKernel>(data_dtype, input, output, num_rows, row_len, is_ascend);
+      });
+}
+
+// Segmented sort: sort many segments of a flat 1-D buffer with one call.
+// segment_offsets holds num_segments + 1 monotone offsets (int32 or int64);
+// segment i spans [offsets[i], offsets[i + 1]) of the input.
+void RegisterSegmentedSort() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def_packed(
+      "tvm.contrib.sort.segmented_sort", [](ffi::PackedArgs args, ffi::Any* ret) {
+        auto input = args[0].cast<DLTensor*>();
+        auto segment_offsets = args[1].cast<DLTensor*>();
+        auto output = args[2].cast<DLTensor*>();
+        bool is_ascend = args[3].cast<bool>();
+
+        TVM_FFI_ICHECK_EQ(segment_offsets->ndim, 1)
+            << "segment_offsets must be a 1-D tensor of num_segments + 1 offsets";
+        int64_t num_segments = segment_offsets->shape[0] - 1;
+        TVM_FFI_ICHECK_GE(num_segments, 0) << "segment_offsets must hold at least one offset";
+
+        auto offsets_dtype = ffi::DLDataTypeToString(segment_offsets->dtype);
+        TVM_FFI_ICHECK(offsets_dtype == "int32" || offsets_dtype == "int64")
+            << "Unsupported segment offsets dtype: " << offsets_dtype;
+
+        auto data_dtype = ffi::DLDataTypeToString(input->dtype);
+        auto out_dtype = ffi::DLDataTypeToString(output->dtype);
+        TVM_FFI_ICHECK_EQ(data_dtype, out_dtype);
+
+        DispatchKeyDType<SegmentedSortKernel>(data_dtype, input, segment_offsets, output,
+                                              num_segments, is_ascend);
+      });
+}
+
+template <typename DataType, typename OffsetType>
+void SegmentedTopKDispatchIndices(DLTensor* input, DLTensor* segment_offsets,
+                                  DLTensor* out_values, DLTensor* out_indices,
+                                  int64_t num_segments, int64_t k, bool is_ascend) {
+  auto indices_dtype =
+      (out_indices == nullptr) ? "int64" : ffi::DLDataTypeToString(out_indices->dtype);
+  if (indices_dtype == "int32") {
+    SegmentedTopK<DataType, OffsetType, int32_t>(input, segment_offsets, out_values, out_indices,
+                                                 num_segments, k, is_ascend);
+  } else if (indices_dtype == "int64") {
+    SegmentedTopK<DataType, OffsetType, int64_t>(input, segment_offsets, out_values, out_indices,
+                                                 num_segments, k, is_ascend);
+  } else {
+    TVM_FFI_THROW(InternalError) << "Unsupported output indices dtype: " << indices_dtype;
+  }
+}
+
+template <typename DataType>
+struct SegmentedTopKKernel {
+  static void Run(DLTensor* input, DLTensor* segment_offsets, DLTensor* out_values,
+                  DLTensor* out_indices, int64_t num_segments, int64_t k, bool is_ascend) {
+    if (ffi::DLDataTypeToString(segment_offsets->dtype) == "int32") {
+      SegmentedTopKDispatchIndices<DataType, int32_t>(input, segment_offsets, out_values,
+                                                      out_indices, num_segments, k, is_ascend);
+    } else {
+      SegmentedTopKDispatchIndices<DataType, int64_t>(input, segment_offsets, out_values,
+                                                      out_indices, num_segments, k, is_ascend);
+    }
+  }
+};
+
+// Segmented top-k: select the k smallest (is_ascend) or largest entries of
+// every segment without sorting the segments. Outputs have row stride k and
+// indices are relative to their segment start. ret_type follows
+// tvm.contrib.sort.topk: "both", "values" or "indices".
+void RegisterSegmentedTopK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def_packed(
+      "tvm.contrib.sort.segmented_topk", [](ffi::PackedArgs args, ffi::Any* ret) {
+        auto input = args[0].cast<DLTensor*>();
+        auto segment_offsets = args[1].cast<DLTensor*>();
+        DLTensor* values_out = nullptr;
+        DLTensor* indices_out = nullptr;
+        int64_t k = args[args.size() - 3].cast<int64_t>();
+        std::string ret_type = args[args.size() - 2].cast<std::string>();
+        bool is_ascend = args[args.size() - 1].cast<bool>();
+        if (ret_type == "both") {
+          values_out = args[2].cast<DLTensor*>();
+          indices_out = args[3].cast<DLTensor*>();
+        } else if (ret_type == "values") {
+          values_out = args[2].cast<DLTensor*>();
+        } else if (ret_type == "indices") {
+          indices_out = args[2].cast<DLTensor*>();
+        } else {
+          TVM_FFI_THROW(InternalError) << "Unsupported ret type: " << ret_type;
+        }
+
+        TVM_FFI_ICHECK_EQ(segment_offsets->ndim, 1)
+            << "segment_offsets must be a 1-D tensor of num_segments + 1 offsets";
+        int64_t num_segments = segment_offsets->shape[0] - 1;
+        TVM_FFI_ICHECK_GE(num_segments, 0) << "segment_offsets must hold at least one offset";
+        TVM_FFI_ICHECK_GT(k, 0) << "k must be positive";
+
+        auto offsets_dtype = ffi::DLDataTypeToString(segment_offsets->dtype);
+        TVM_FFI_ICHECK(offsets_dtype == "int32" || offsets_dtype == "int64")
+            << "Unsupported segment offsets dtype: " << offsets_dtype;
+
+        auto data_dtype = ffi::DLDataTypeToString(input->dtype);
+        DispatchKeyDType<SegmentedTopKKernel>(data_dtype, input, segment_offsets, values_out,
+                                              indices_out, num_segments, k, is_ascend);
+      });
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  RegisterRadixSort();
+  RegisterSegmentedSort();
+  RegisterSegmentedTopK();
+}
+
+}  // namespace contrib
+}  // namespace tvm
@@ -25,7 +25,9 @@
 #include <tvm/runtime/disco/session.h>
 #include <tvm/runtime/vm/vm.h>
 
+#include <algorithm>
 #include <sstream>
+#include <vector>
 
 #include "./utils.h"
 
@@ -120,6 +122,74 @@ void RecvFromWorker(Tensor buffer, int sender_id) {
 
 int WorkerId() { return DiscoWorker::ThreadLocal()->worker_id; }
 
+void ReshardRowSharded(ffi::Optional<Tensor> send, int64_t old_num_shards,
+                       int64_t new_num_shards, ffi::Optional<Tensor> recv) {
+  TVM_FFI_CHECK(old_num_shards > 0 && new_num_shards > 0, ValueError)
+      << "Shard counts must be positive, but got old_num_shards = " << old_num_shards
+      << ", new_num_shards = " << new_num_shards;
+  int worker_id = WorkerId();
+  bool is_src = worker_id < old_num_shards;
+  bool is_dst = worker_id < new_num_shards;
+  TVM_FFI_CHECK(!is_src || send.has_value(), ValueError)
+      << "Worker " << worker_id << " holds a shard under the old sharding of " << old_num_shards
+      << " shards and must provide the send buffer";
+  TVM_FFI_CHECK(!is_dst || recv.has_value(), ValueError)
+      << "Worker " << worker_id << " holds a shard under the new sharding of " << new_num_shards
+      << " shards and must provide the recv buffer";
+  if (!is_src && !is_dst) {
+    // This worker neither owns a shard now nor will own one. Nothing to exchange.
+    return;
+  }
+  // Derive the full (unsharded) number of rows and the per-row layout from whichever
+  // buffer this worker holds, and cross-check when it holds both.
+  const Tensor& ref = is_src ? send.value() : recv.value();
+  DLDataType dtype = ref->dtype;
+  int64_t row_elems = 1;
+  for (int i = 1; i < ref->ndim; ++i) {
+    row_elems *= ref->shape[i];
+  }
+  std::vector<int64_t> row_shape(ref->shape + 1, ref->shape + ref->ndim);
+  int64_t total_rows =
+      is_src ? send.value()->shape[0] * old_num_shards : recv.value()->shape[0] * new_num_shards;
+  TVM_FFI_CHECK(total_rows % old_num_shards == 0 && total_rows % new_num_shards == 0, ValueError)
+      << "The total number of rows (" << total_rows << ") must be divisible by both "
+      << old_num_shards << " and " << new_num_shards;
+  int64_t old_rows = total_rows / old_num_shards;
+  int64_t new_rows = total_rows / new_num_shards;
+  if (is_src && is_dst) {
+    TVM_FFI_CHECK_EQ(recv.value()->shape[0], new_rows, ValueError)
+        << "The recv buffer rows do not match the new sharding";
+    TVM_FFI_CHECK(send.value()->dtype == recv.value()->dtype, ValueError)
+        << "The send and recv buffers must have the same dtype";
+  }
+  int64_t row_nbytes = row_elems * ((dtype.bits * dtype.lanes + 7) / 8);
+  auto make_view = [&](const Tensor& buffer, int64_t row_begin, int64_t num_rows) {
+    std::vector<int64_t> shape{num_rows};
+    shape.insert(shape.end(), row_shape.begin(), row_shape.end());
+    return buffer.CreateView(ffi::Shape(shape), dtype, row_begin * row_nbytes);
+  };
+  // All workers traverse the (src, dst) pairs in the same order, so every peer-to-peer
+  // send is matched by its recv without deadlock.
+  for (int64_t src = 0; src < old_num_shards; ++src) {
+    int64_t src_begin = src * old_rows;
+    for (int64_t dst = 0; dst < new_num_shards; ++dst) {
+      int64_t begin = std::max(src_begin, dst * new_rows);
+      int64_t end = std::min(src_begin + old_rows, (dst + 1) * new_rows);
+      if (begin >= end) {
+        continue;
+      }
+      if (worker_id == src && worker_id == dst) {
+        make_view(recv.value(), begin - dst * new_rows, end - begin)
+            .CopyFrom(make_view(send.value(), begin - src_begin, end - begin));
+      } else if (worker_id == src) {
+        SendToWorker(make_view(send.value(), begin - src_begin, end - begin), dst);
+      } else if (worker_id == dst) {
+        RecvFromWorker(make_view(recv.value(), begin - dst * new_rows, end - begin), src);
+      }
+    }
+  }
+}
+
 void SyncWorker() {
   if (DiscoWorker::ThreadLocal()->ccl != "") {
     GetCCLFunc("sync_worker")();
@@ -159,6 +229,7 @@ TVM_FFI_STATIC_INIT_BLOCK() {
       .def("runtime.disco.recv_from_prev_group", RecvFromPrevGroup)
       .def("runtime.disco.send_to_worker", SendToWorker)
       .def("runtime.disco.recv_from_worker", RecvFromWorker)
+      .def("runtime.disco.reshard_row_sharded", ReshardRowSharded)
       .def("runtime.disco.worker_id", []() -> ffi::Shape { return ffi::Shape({WorkerId()}); })
       .def("runtime.disco.worker_rank", []() -> int64_t { return WorkerId(); })
       .def("runtime.disco.world_size",
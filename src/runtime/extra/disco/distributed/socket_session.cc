@@ -84,6 +84,9 @@ class SocketSessionObj : public BcastSessionObj {
     for (int i = 0; i + 1 < num_nodes; ++i) {
       SockAddr addr;
       remote_sockets_.push_back(socket_.Accept(&addr));
+      // Control messages are small and latency sensitive; do not let Nagle
+      // hold them back.
+      remote_sockets_.back().SetNoDelay(true);
       remote_channels_.emplace_back(std::make_unique<DiscoSocketChannel>(remote_sockets_.back()));
       packed_args[3] = i + 1;
       // Send metadata to each remote node:
@@ -221,6 +224,7 @@ class RemoteSocketSession {
       TVM_FFI_THROW(InternalError) << "Failed to connect to server " << server_addr.AsString()
                                    << ", errno = " << Socket::GetLastErrorCode();
     }
+    socket_.SetNoDelay(true);
     channel_ = std::make_unique<DiscoSocketChannel>(socket_);
     ffi::PackedArgs metadata = channel_->Recv();
     TVM_FFI_ICHECK_EQ(metadata.size(), 4);
@@ -24,12 +24,22 @@
 #include <tvm/runtime/disco/builtin.h>
 #include <tvm/runtime/vm/tensor_cache_support.h>
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <numeric>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
+#include "../../../support/env.h"
 #include "../../file_utils.h"
 #include "./utils.h"
 
@@ -100,6 +110,141 @@ std::unordered_map<std::string, ShardInfo> LoadShardInfoFromStr(const std::strin
   return result;
 }
 
+/*!
+ * \brief A background thread pool that reads shard files into memory ahead of
+ * the consumer, overlapping disk reads of upcoming files with the shard
+ * functions and device copies of the current one.
+ *
+ * The loader announces the order in which it will consume files through
+ * `BeginPlan` and then claims each file with `Take`, which blocks until the
+ * read completes and releases the host memory once claimed. At most `depth`
+ * files are in flight or cached at any time, so peak host memory stays
+ * bounded by `depth` shard files. Files taken outside the announced plan are
+ * read on the spot without look-ahead.
+ */
+class ShardFilePrefetcher {
+ public:
+  ShardFilePrefetcher() {
+    depth_ = std::max(support::GetEnv<int>("TVM_DISCO_LOADER_PREFETCH_DEPTH", 4), 1);
+    threads_.reserve(depth_);
+    for (int i = 0; i < depth_; ++i) {
+      threads_.emplace_back([this] { this->ReadLoop(); });
+    }
+  }
+
+  ~ShardFilePrefetcher() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      shutdown_ = true;
+    }
+    pending_cv_.notify_all();
+    for (std::thread& thread : threads_) {
+      thread.join();
+    }
+  }
+
+  /*! \brief Announce the order in which files will be taken next. */
+  void BeginPlan(std::vector<std::string> file_order) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    file_order_ = std::move(file_order);
+    next_schedule_pos_ = 0;
+    FillWindowLocked();
+  }
+
+  /*!
+   * \brief Block until `path` is fully read, claim its contents and advance
+   * the prefetch window.
+   */
+  std::string Take(const std::string& path) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!entries_.count(path)) {
+      // The file is not part of the announced plan: read it on the spot.
+      entries_.emplace(path, Entry());
+      pending_.push_front(path);
+      pending_cv_.notify_one();
+    }
+    Entry& entry = entries_.at(path);
+    done_cv_.wait(lock, [&entry] { return entry.ready; });
+    if (entry.error) {
+      std::exception_ptr error = entry.error;
+      entries_.erase(path);
+      std::rethrow_exception(error);
+    }
+    std::string data = std::move(entry.data);
+    entries_.erase(path);
+    FillWindowLocked();
+    return data;
+  }
+
+ private:
+  struct Entry {
+    std::string data;
+    std::exception_ptr error = nullptr;
+    bool ready = false;
+  };
+
+  /*! \brief Schedule planned files until `depth_` of them are outstanding. */
+  void FillWindowLocked() {
+    while (next_schedule_pos_ < file_order_.size() &&
+           entries_.size() < static_cast<size_t>(depth_)) {
+      const std::string& path = file_order_[next_schedule_pos_++];
+      if (entries_.count(path)) {
+        continue;
+      }
+      entries_.emplace(path, Entry());
+      pending_.push_back(path);
+      pending_cv_.notify_one();
+    }
+  }
+
+  void ReadLoop() {
+    while (true) {
+      std::string path;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        pending_cv_.wait(lock, [this] { return shutdown_ || !pending_.empty(); });
+        if (shutdown_) {
+          return;
+        }
+        path = pending_.front();
+        pending_.pop_front();
+      }
+      std::string data;
+      std::exception_ptr error = nullptr;
+      try {
+        LoadBinaryFromFile(path, &data);
+      } catch (...) {
+        error = std::current_exception();
+      }
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(path);
+        if (it != entries_.end()) {
+          it->second.data = std::move(data);
+          it->second.error = error;
+          it->second.ready = true;
+        }
+      }
+      done_cv_.notify_all();
+    }
+  }
+
+  /*! \brief The number of reader threads and the bound on outstanding files. */
+  int depth_;
+  std::mutex mutex_;
+  std::condition_variable pending_cv_;
+  std::condition_variable done_cv_;
+  std::vector<std::thread> threads_;
+  /*! \brief The planned file order; `next_schedule_pos_` indexes into it. */
+  std::vector<std::string> file_order_;
+  size_t next_schedule_pos_ = 0;
+  /*! \brief Paths queued for the reader threads. */
+  std::deque<std::string> pending_;
+  /*! \brief Scheduled files that have not been taken yet. */
+  std::unordered_map<std::string, Entry> entries_;
+  bool shutdown_ = false;
+};
+
 /*! \brief An object that helps to load parameters in shards. */
 class ShardLoaderObj : public ffi::Object {
  public:
@@ -145,6 +290,8 @@ class ShardLoaderObj : public ffi::Object {
   mutable const FileRecord* current_file_;
   /*! \brief The context of the current file to be loaded from */
   mutable std::string current_file_stream_;
+  /*! \brief The background reader overlapping file reads with device copies */
+  mutable ShardFilePrefetcher prefetcher_;
 
  private:
   /*! \brief Load the i-th parameter without post-processing
@@ -158,6 +305,9 @@ class ShardLoaderObj : public ffi::Object {
    * \returns The full tensor at the specified index
    */
   Tensor LoadDirect(int weight_index) const;
+
+  /*! \brief Collect the deduplicated file access order of the given parameters */
+  std::vector<std::string> FileOrderForParams(const std::vector<int>& indices) const;
 };
 
 ffi::ObjectRef ShardLoaderObj::Create(const std::string& path_to_metadata,
@@ -237,7 +387,7 @@ Tensor ShardLoaderObj::LoadParamOnWorker0(int weight_index) const {
     if (file != current_file_) {
       current_file_ = file;
       std::string file_name = GetSiblingPath(this->metadata_.path, file->data_path);
-      LoadBinaryFromFile(file_name, &this->current_file_stream_);
+      this->current_file_stream_ = prefetcher_.Take(file_name);
     }
     return param->Load(device, &this->current_file_stream_);
   };
@@ -284,11 +434,23 @@ Tensor ShardLoaderObj::LoadDirect(int weight_index) const {
   if (file != current_file_) {
     current_file_ = file;
     std::string file_name = GetSiblingPath(this->metadata_.path, file->data_path);
-    LoadBinaryFromFile(file_name, &this->current_file_stream_);
+    this->current_file_stream_ = prefetcher_.Take(file_name);
   }
   return param->Load(device, &this->current_file_stream_);
 }
 
+std::vector<std::string> ShardLoaderObj::FileOrderForParams(const std::vector<int>& indices) const {
+  std::vector<std::string> file_order;
+  std::unordered_set<const FileRecord*> seen;
+  for (int index : indices) {
+    const FileRecord* file = param_info_.at(index).file;
+    if (seen.insert(file).second) {
+      file_order.push_back(GetSiblingPath(this->metadata_.path, file->data_path));
+    }
+  }
+  return file_order;
+}
+
 Tensor ShardLoaderObj::Load(int weight_index) const {
   DiscoWorker* worker = DiscoWorker::ThreadLocal();
   int worker_id = worker->worker_id;
@@ -331,13 +493,22 @@ Tensor ShardLoaderObj::Load(int weight_index) const {
 
 ffi::Array<Tensor> ShardLoaderObj::LoadAll() const {
   int n = static_cast<int>(param_info_.size());
-  ffi::Array<Tensor> shards;
-  shards.reserve(n);
+  std::vector<int> indices;
+  indices.reserve(n);
   for (int i = 0; i < n; ++i) {
     std::string param_name = "param_" + std::to_string(i);
     TVM_FFI_ICHECK(this->param_name_to_index_.count(param_name));
-    int shard_id = this->param_name_to_index_.at(param_name);
-    shards.push_back(this->Load(shard_id));
+    indices.push_back(this->param_name_to_index_.at(param_name));
+  }
+  if (DiscoWorker::ThreadLocal()->worker_id == 0) {
+    // Only worker 0 reads files in this mode; start streaming them in ahead
+    // of the broadcasts and scatters below.
+    prefetcher_.BeginPlan(FileOrderForParams(indices));
+  }
+  ffi::Array<Tensor> shards;
+  shards.reserve(n);
+  for (int index : indices) {
+    shards.push_back(this->Load(index));
   }
   return shards;
 }
@@ -374,8 +545,8 @@ ffi::Array<Tensor> ShardLoaderObj::LoadAllPresharded() const {
   size_t num_workers = static_cast<size_t>(worker->num_workers);
   size_t num_params = param_info_.size() / num_workers;
 
-  ffi::Array<Tensor> params;
-  params.reserve(num_params);
+  std::vector<int> indices;
+  indices.reserve(num_params);
   for (size_t i_param = 0; i_param < num_params; ++i_param) {
     std::string param_name = static_cast<const std::stringstream&>(
                                  std::stringstream() << "param_" << i_param << "_shard-"
@@ -385,7 +556,14 @@ ffi::Array<Tensor> ShardLoaderObj::LoadAllPresharded() const {
     auto it = param_name_to_index_.find(param_name);
     TVM_FFI_ICHECK(it != param_name_to_index_.end())
         << "Parameter " << param_name << " was not found in the parameter set";
-    int param_id = this->param_name_to_index_.at(param_name);
+    indices.push_back(it->second);
+  }
+  // Each worker reads only its own shard files; announce them so they stream
+  // in while the previous file's parameters are copied to the device.
+  prefetcher_.BeginPlan(FileOrderForParams(indices));
+  ffi::Array<Tensor> params;
+  params.reserve(num_params);
+  for (int param_id : indices) {
     params.push_back(this->LoadDirect(param_id));
   }
   return params;
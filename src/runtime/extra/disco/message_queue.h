@@ -19,9 +19,16 @@
 #ifndef TVM_RUNTIME_DISCO_MESSAGE_QUEUE_H_
 #define TVM_RUNTIME_DISCO_MESSAGE_QUEUE_H_
 
+#include <tvm/runtime/logging.h>
 #include <tvm/support/io.h>
 
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "./protocol.h"
@@ -29,12 +36,42 @@
 namespace tvm {
 namespace runtime {
 
+/*!
+ * \brief A message queue over a byte stream.
+ *
+ * Messages are serialized by the caller of `Send` and put on the wire by a
+ * dedicated writer thread. Messages at or above kBulkMessageThresholdBytes
+ * travel as a sequence of bounded chunks, so that with
+ * `TVM_DISCO_PRIORITY_LANES=1` small control messages enqueued behind a bulk
+ * transfer (e.g. a weight broadcast) can overtake its remaining chunks and
+ * reach the worker within one chunk's worth of wire time. The receiver
+ * reassembles chunked messages and hands over whichever message completes
+ * first, so the lane policy is purely a sender-side decision. By default the
+ * wire order is the `Send` order: disco commands are executed in arrival
+ * order, so overtaking is only sound when the interleaved commands are
+ * independent, which the deployment has to opt into.
+ */
 class DiscoStreamMessageQueue : private support::Stream,
                                 private DiscoProtocol<DiscoStreamMessageQueue> {
  public:
-  explicit DiscoStreamMessageQueue(support::Stream* stream) : stream_(stream) {}
+  explicit DiscoStreamMessageQueue(support::Stream* stream)
+      : stream_(stream), writer_([this] { this->WriterLoop(); }) {}
 
-  ~DiscoStreamMessageQueue() = default;
+  /*! \brief Destructor that flushes all pending messages and joins the writer. */
+  ~DiscoStreamMessageQueue() {
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      shutdown_ = true;
+    }
+    data_available_.notify_one();
+    if (writer_.joinable()) {
+      writer_.join();
+    }
+  }
+
+  // Re-exposed for single-host channels whose peers share the filesystem, so
+  // that large host tensors bypass the stream. See `DiscoProtocol`.
+  using DiscoProtocol<DiscoStreamMessageQueue>::EnableShmTensorTransfer;
 
   void Send(const ffi::PackedArgs& args) {
     // TODO(tqchen): use native convention that do not need ABI translation.
@@ -60,38 +97,169 @@ class DiscoStreamMessageQueue : private support::Stream,
   }
 
  protected:
+  /*! \brief The kind of a wire frame; one message is one kWhole frame or a
+   * run of kBulkChunk frames closed by a kBulkLast frame. */
+  enum class FrameKind : uint8_t {
+    kWhole = 0,
+    kBulkChunk = 1,
+    kBulkLast = 2,
+  };
+
+  /*! \brief Messages at or above this size travel as chunked bulk frames. */
+  static constexpr size_t kBulkMessageThresholdBytes = 1 << 20;
+  /*! \brief The payload cap of one bulk frame; bounds how long a control
+   * message waits behind the chunk currently on the wire. */
+  static constexpr size_t kBulkChunkBytes = 1 << 20;
+  /*! \brief The cap on queued-but-unsent bytes; `Send` blocks beyond it. */
+  static constexpr size_t kMaxOutgoingBytes = 64 << 20;
+
+  /*! \brief A serialized message waiting for the writer thread. */
+  struct OutgoingMessage {
+    std::string data;
+    /*! \brief The next unsent byte; starts past the legacy length prefix. */
+    size_t offset = sizeof(uint64_t);
+    bool bulk = false;
+  };
+
+  /*! \brief Whether control messages may overtake queued bulk chunks. */
+  static bool PriorityLanesEnabled() {
+    static const bool enabled = []() {
+      const char* val = getenv("TVM_DISCO_PRIORITY_LANES");
+      return val != nullptr && atoi(val) != 0;
+    }();
+    return enabled;
+  }
+
   void CommitSendAndNotifyEnqueue() {
-    stream_->Write(write_buffer_.data(), write_buffer_.size());
+    OutgoingMessage msg;
+    msg.data = std::move(write_buffer_);
+    msg.bulk = msg.data.size() - sizeof(uint64_t) >= kBulkMessageThresholdBytes;
     write_buffer_.clear();
+    {
+      std::unique_lock<std::mutex> lock{mutex_};
+      space_available_.wait(
+          lock, [this] { return queued_bytes_ < kMaxOutgoingBytes || writer_broken_; });
+      queued_bytes_ += msg.data.size();
+      queue_.push_back(std::move(msg));
+    }
+    data_available_.notify_one();
+  }
+
+  /*! \brief The writer thread: sends one frame per iteration, preferring the
+   * earliest control message over queued bulk chunks when lanes are enabled. */
+  void WriterLoop() {
+    while (true) {
+      std::unique_lock<std::mutex> lock{mutex_};
+      data_available_.wait(lock, [this] { return !queue_.empty() || shutdown_; });
+      if (queue_.empty()) {
+        break;
+      }
+      size_t index = 0;
+      if (PriorityLanesEnabled() && queue_.front().bulk) {
+        for (size_t i = 1; i < queue_.size(); ++i) {
+          if (!queue_[i].bulk) {
+            index = i;
+            break;
+          }
+        }
+      }
+      OutgoingMessage& msg = queue_[index];
+      FrameKind kind;
+      size_t payload_nbytes;
+      if (!msg.bulk) {
+        kind = FrameKind::kWhole;
+        payload_nbytes = msg.data.size() - msg.offset;
+      } else {
+        payload_nbytes = std::min(msg.data.size() - msg.offset, kBulkChunkBytes);
+        kind = msg.offset + payload_nbytes == msg.data.size() ? FrameKind::kBulkLast
+                                                              : FrameKind::kBulkChunk;
+      }
+      // Frames reference the queued message in place; the stream write happens
+      // outside the lock so `Send` is never blocked on the wire.
+      msg.offset += payload_nbytes;
+      bool msg_done = msg.offset == msg.data.size();
+      std::string done_data;
+      if (msg_done) {
+        // Move the finished message out before erasing its queue slot; the
+        // payload pointer must reference the moved-to string, as short
+        // strings live inline in the element the erase destroys.
+        done_data = std::move(msg.data);
+        queue_.erase(queue_.begin() + index);
+        queued_bytes_ -= done_data.size();
+      }
+      const char* payload = (msg_done ? done_data.data() + done_data.size()
+                                      : msg.data.data() + msg.offset) -
+                            payload_nbytes;
+      lock.unlock();
+      if (msg_done) {
+        space_available_.notify_one();
+      }
+      try {
+        uint64_t frame_nbytes = 1 + payload_nbytes;
+        char header[sizeof(frame_nbytes) + 1];
+        std::memcpy(header, &frame_nbytes, sizeof(frame_nbytes));
+        header[sizeof(frame_nbytes)] = static_cast<char>(kind);
+        stream_->Write(header, sizeof(header));
+        stream_->Write(payload, payload_nbytes);
+      } catch (const std::exception& err) {
+        // The peer observes the dropped stream as an implicit shutdown; fail
+        // the queue rather than letting the exception tear down the process.
+        LOG(WARNING) << "Disco message queue writer failed: " << err.what();
+        std::lock_guard<std::mutex> guard{mutex_};
+        writer_broken_ = true;
+        queue_.clear();
+        queued_bytes_ = 0;
+        space_available_.notify_all();
+        break;
+      }
+    }
   }
 
   /* \brief Read next packet and reset unpacker
    *
-   * Read the next packet into `read_buffer_`, releasing all arena
-   * allocations performed by the unpacker and resetting the unpacker
-   * to its initial state.
+   * Read frames until a full message is available in `read_buffer_`,
+   * releasing all arena allocations performed by the unpacker and resetting
+   * the unpacker to its initial state. Chunked bulk frames accumulate in
+   * `bulk_buffer_`; control messages interleaved between them complete, and
+   * are therefore delivered, first.
    *
    * \return A boolean value.  If true, this packet should be treated
    *    equivalently to a `DiscoAction::kShutdown` event.  If false,
    *    this packet should be unpacked.
    */
   bool DequeueNextPacket() {
-    uint64_t packet_nbytes = 0;
-    int read_size = stream_->Read(&packet_nbytes, sizeof(packet_nbytes));
-    if (read_size == 0) {
-      // Special case, connection dropped between packets.  Treat as a
-      // request to shutdown.
-      return true;
+    while (true) {
+      uint64_t frame_nbytes = 0;
+      int read_size = stream_->Read(&frame_nbytes, sizeof(frame_nbytes));
+      if (read_size == 0) {
+        // Special case, connection dropped between packets.  Treat as a
+        // request to shutdown.
+        return true;
+      }
+      TVM_FFI_ICHECK_EQ(read_size, sizeof(frame_nbytes))
+          << "Stream closed without proper shutdown. Please make sure to explicitly call "
+             "`Session::Shutdown`";
+      FrameKind kind = FrameKind::kWhole;
+      TVM_FFI_ICHECK_EQ(stream_->Read(&kind, sizeof(kind)), sizeof(kind))
+          << "Stream closed without proper shutdown. Please make sure to explicitly call "
+             "`Session::Shutdown`";
+      size_t payload_nbytes = frame_nbytes - sizeof(kind);
+      std::string& buffer = kind == FrameKind::kWhole ? read_buffer_ : bulk_buffer_;
+      size_t cur_size = kind == FrameKind::kWhole ? 0 : buffer.size();
+      buffer.resize(cur_size + payload_nbytes);
+      read_size = stream_->Read(buffer.data() + cur_size, payload_nbytes);
+      TVM_FFI_ICHECK_EQ(read_size, payload_nbytes)
+          << "Stream closed without proper shutdown. Please make sure to explicitly call "
+             "`Session::Shutdown`";
+      if (kind == FrameKind::kWhole) {
+        break;
+      }
+      if (kind == FrameKind::kBulkLast) {
+        read_buffer_ = std::move(bulk_buffer_);
+        bulk_buffer_.clear();
+        break;
+      }
     }
-
-    TVM_FFI_ICHECK_EQ(read_size, sizeof(packet_nbytes))
-        << "Stream closed without proper shutdown. Please make sure to explicitly call "
-           "`Session::Shutdown`";
-    read_buffer_.resize(packet_nbytes);
-    read_size = stream_->Read(read_buffer_.data(), packet_nbytes);
-    TVM_FFI_ICHECK_EQ(read_size, packet_nbytes)
-        << "Stream closed without proper shutdown. Please make sure to explicitly call "
-           "`Session::Shutdown`";
     read_offset_ = 0;
     this->RecycleAll();
     RPCCode code = RPCCode::kReturn;
@@ -123,8 +291,19 @@ class DiscoStreamMessageQueue : private support::Stream,
   // The read/write buffer will only be accessed by the producer thread.
   std::string write_buffer_;
   std::string read_buffer_;
+  /*! \brief Reassembly buffer for the bulk frames of the message in flight. */
+  std::string bulk_buffer_;
   size_t read_offset_ = 0;
   support::Stream* stream_;
+
+  std::mutex mutex_;
+  std::condition_variable data_available_;
+  std::condition_variable space_available_;
+  std::deque<OutgoingMessage> queue_;
+  size_t queued_bytes_ = 0;
+  bool shutdown_ = false;
+  bool writer_broken_ = false;
+  std::thread writer_;
 };
 
 }  // namespace runtime
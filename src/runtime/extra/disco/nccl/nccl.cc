@@ -20,6 +20,7 @@
 #include <tvm/ffi/reflection/registry.h>
 #include <tvm/runtime/logging.h>
 
+#include <cstdlib>
 #include <cstring>
 #include <mutex>
 #include <sstream>
@@ -115,32 +116,101 @@ void InitCCLPerWorker(ffi::Shape device_ids, std::string unique_id_bytes) {
     NCCL_CALL(ncclCommSplit(ctx->global_comm, worker->worker_id / group_size,
                             worker->worker_id % group_size, &ctx->group_comm, NULL));
   }
+  // Hierarchical communicators for multi-node sessions. `device_ids` holds
+  // one device per local worker, so its length is the node size, and
+  // `worker_id - local_worker_id` is the same for exactly the workers that
+  // share a node: splitting on it yields the node-local communicator, which
+  // NCCL routes over NVLink/PCIe. Splitting on the local rank instead links
+  // the i-th worker of every node over the network fabric.
+  int num_workers_per_node = static_cast<int>(device_ids.size());
+  if (worker->num_workers > num_workers_per_node) {
+    TVM_FFI_ICHECK_EQ(worker->num_workers % num_workers_per_node, 0)
+        << "The number of workers must be divisible by the node size, but got "
+        << worker->num_workers << " workers and " << num_workers_per_node << " devices per node.";
+    int node_base = worker->worker_id - worker->local_worker_id;
+    NCCL_CALL(ncclCommSplit(ctx->global_comm, node_base, worker->local_worker_id, &ctx->node_comm,
+                            NULL));
+    NCCL_CALL(ncclCommSplit(ctx->global_comm, worker->local_worker_id, worker->worker_id,
+                            &ctx->cross_comm, NULL));
+    ctx->node_size = num_workers_per_node;
+    ctx->num_nodes = worker->num_workers / num_workers_per_node;
+  }
+}
+
+// The minimum message size for the hierarchical all-reduce. Below it the
+// three-stage pipeline pays more in launch latency than it saves in
+// inter-node bandwidth.
+constexpr int64_t kHierarchicalAllReduceMinBytes = 1 << 20;
+
+// Whether an all-reduce of `numel` elements can take the hierarchical path:
+// intra-node reduce-scatter, inter-node all-reduce, intra-node all-gather.
+// A flat ring crosses the network once per node-neighbor hop; the hierarchy
+// sends only 1/node_size of the data per node pair, with every local rank
+// driving its own NIC.
+bool UseHierarchicalAllReduce(CCLThreadLocalContext* ctx, bool in_group, int64_t numel,
+                              DLDataType dtype) {
+  static const bool enabled = []() {
+    const char* val = getenv("TVM_DISCO_HIERARCHICAL_ALLREDUCE");
+    return val == nullptr || atoi(val) != 0;
+  }();
+  if (!enabled || ctx->cross_comm == nullptr) {
+    return false;
+  }
+  // Worker groups partition workers across node boundaries, so the group
+  // communicator only matches the hierarchy when there is a single group.
+  if (in_group && ctx->worker->num_groups != 1) {
+    return false;
+  }
+  if (numel % ctx->node_size != 0) {
+    return false;
+  }
+  return numel * ((dtype.bits * dtype.lanes + 7) / 8) >= kHierarchicalAllReduceMinBytes;
 }
 
 void AllReduce(Tensor send, ReduceKind reduce_kind, bool in_group, Tensor recv) {
   CCLThreadLocalContext* ctx = CCLThreadLocalContext::Get();
   ffi::Shape shape = send.Shape();
   int64_t numel = shape->Product();
-  deviceStream_t stream = ctx->GetDefaultStream();
+  deviceStream_t stream = ctx->GetCollectiveStream();
   DLDataType dtype = send->dtype;
   if (dtype == DLDataType{kDLFloat8_e4m3fn, 8, 1} || dtype == DLDataType{kDLFloat8_e5m2, 8, 1}) {
     TVM_FFI_THROW(InternalError)
         << "Float8 data type cannot be allreduced, as nccl does not support this data type.";
   }
-  NCCL_CALL(ncclAllReduce(send->data, recv->data, numel,
-                          /*datatype=*/AsNCCLDataType(dtype),
-                          /*op=*/AsNCCLRedOp(reduce_kind),
-                          in_group ? ctx->group_comm : ctx->global_comm, stream));
+  if (UseHierarchicalAllReduce(ctx, in_group, numel, dtype)) {
+    // Stage this rank's chunk at its gather offset in `recv`, so the final
+    // all-gather runs in place; when send == recv the reduce-scatter also
+    // matches NCCL's documented in-place layout.
+    int64_t chunk_numel = numel / ctx->node_size;
+    int64_t chunk_bytes = chunk_numel * ((dtype.bits * dtype.lanes + 7) / 8);
+    void* chunk =
+        static_cast<uint8_t*>(recv->data) + ctx->worker->local_worker_id * chunk_bytes;
+    ncclDataType_t nccl_dtype = AsNCCLDataType(dtype);
+    ncclRedOp_t nccl_op = AsNCCLRedOp(reduce_kind);
+    NCCL_CALL(
+        ncclReduceScatter(send->data, chunk, chunk_numel, nccl_dtype, nccl_op, ctx->node_comm,
+                          stream));
+    NCCL_CALL(
+        ncclAllReduce(chunk, chunk, chunk_numel, nccl_dtype, nccl_op, ctx->cross_comm, stream));
+    NCCL_CALL(ncclAllGather(chunk, recv->data, chunk_numel, nccl_dtype, ctx->node_comm, stream));
+  } else {
+    NCCL_CALL(ncclAllReduce(send->data, recv->data, numel,
+                            /*datatype=*/AsNCCLDataType(dtype),
+                            /*op=*/AsNCCLRedOp(reduce_kind),
+                            in_group ? ctx->group_comm : ctx->global_comm, stream));
+  }
+  ctx->MarkCollectiveLaunched();
 }
 
 void AllGather(Tensor send, bool in_group, Tensor recv) {
   CCLThreadLocalContext* ctx = CCLThreadLocalContext::Get();
   ffi::Shape shape = send.Shape();
   int64_t numel = shape->Product();
-  deviceStream_t stream = ctx->GetDefaultStream();
+  deviceStream_t stream = ctx->GetCollectiveStream();
   NCCL_CALL(ncclAllGather(send->data, recv->data, numel,
                           /*datatype=*/AsNCCLDataType(send->dtype),
                           in_group ? ctx->group_comm : ctx->global_comm, stream));
+  ctx->MarkCollectiveLaunched();
 }
 
 void BroadcastFromWorker0(ffi::Optional<Tensor> send, bool in_group, Tensor recv) {
@@ -329,10 +399,23 @@ void RecvFromWorker(Tensor buffer, int sender_id) {
 void SyncWorker() {
   CCLThreadLocalContext* ctx = CCLThreadLocalContext::Get();
   TVM_FFI_ICHECK(ctx->worker != nullptr);
+  // Order the compute stream after any collective still running on the
+  // dedicated comm stream before synchronizing.
+  ctx->WaitCommStream();
   deviceStream_t stream = ctx->GetDefaultStream();
   StreamSynchronize(stream);
 }
 
+void SetCommOverlap(bool enable) {
+  CCLThreadLocalContext* ctx = CCLThreadLocalContext::Get();
+  ctx->SetCommOverlap(enable);
+}
+
+void CommStreamWait() {
+  CCLThreadLocalContext* ctx = CCLThreadLocalContext::Get();
+  ctx->WaitCommStream();
+}
+
 TVM_FFI_STATIC_INIT_BLOCK() {
   namespace refl = tvm::ffi::reflection;
   refl::GlobalDef()
@@ -355,6 +438,8 @@ TVM_FFI_STATIC_INIT_BLOCK() {
       .def("runtime.disco." TVM_DISCO_CCL_NAME ".send_to_worker", SendToWorker)
       .def("runtime.disco." TVM_DISCO_CCL_NAME ".recv_from_worker", RecvFromWorker)
       .def("runtime.disco." TVM_DISCO_CCL_NAME ".sync_worker", SyncWorker)
+      .def("runtime.disco." TVM_DISCO_CCL_NAME ".set_comm_overlap", SetCommOverlap)
+      .def("runtime.disco." TVM_DISCO_CCL_NAME ".comm_stream_wait", CommStreamWait)
       .def("runtime.disco." TVM_DISCO_CCL_NAME ".test_send_to_next_group_recv_from_prev_group",
            [](Tensor buffer) {
              CCLThreadLocalContext* ctx = CCLThreadLocalContext::Get();
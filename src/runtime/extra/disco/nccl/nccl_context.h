@@ -72,6 +72,18 @@ inline void StreamDestroy(deviceStream_t stream) {
   TVM_FFI_CHECK_CUDA_ERROR(cudaStreamDestroy(stream));
 }
 
+using deviceEvent_t = cudaEvent_t;
+inline void EventCreate(deviceEvent_t* event) {
+  TVM_FFI_CHECK_CUDA_ERROR(cudaEventCreateWithFlags(event, cudaEventDisableTiming));
+}
+inline void EventDestroy(deviceEvent_t event) { TVM_FFI_CHECK_CUDA_ERROR(cudaEventDestroy(event)); }
+inline void EventRecord(deviceEvent_t event, deviceStream_t stream) {
+  TVM_FFI_CHECK_CUDA_ERROR(cudaEventRecord(event, stream));
+}
+inline void StreamWaitEvent(deviceStream_t stream, deviceEvent_t event) {
+  TVM_FFI_CHECK_CUDA_ERROR(cudaStreamWaitEvent(stream, event, 0));
+}
+
 #else
 
 #define TVM_DISCO_DEVICE_NAME "rocm"
@@ -84,6 +96,18 @@ inline void StreamSynchronize(deviceStream_t stream) { ROCM_CALL(hipStreamSynchr
 inline void StreamCreate(deviceStream_t* stream) { ROCM_CALL(hipStreamCreate(stream)); }
 inline void StreamDestroy(deviceStream_t stream) { ROCM_CALL(hipStreamDestroy(stream)); }
 
+using deviceEvent_t = hipEvent_t;
+inline void EventCreate(deviceEvent_t* event) {
+  ROCM_CALL(hipEventCreateWithFlags(event, hipEventDisableTiming));
+}
+inline void EventDestroy(deviceEvent_t event) { ROCM_CALL(hipEventDestroy(event)); }
+inline void EventRecord(deviceEvent_t event, deviceStream_t stream) {
+  ROCM_CALL(hipEventRecord(event, stream));
+}
+inline void StreamWaitEvent(deviceStream_t stream, deviceEvent_t event) {
+  ROCM_CALL(hipStreamWaitEvent(stream, event, 0));
+}
+
 #endif
 
 /*! \brief Convert DLPack dtype to ncclDataType. */
@@ -131,10 +155,54 @@ struct CCLThreadLocalContext {
   deviceStream_t default_stream = nullptr;
   ncclComm_t global_comm = nullptr;
   ncclComm_t group_comm = nullptr;
+  /*!
+   * \brief Communicator over the workers of this node, set only for
+   * multi-node sessions. NCCL routes it over the intra-node interconnect
+   * (NVLink/PCIe), so it carries the reduce-scatter/all-gather stages of the
+   * hierarchical all-reduce.
+   */
+  ncclComm_t node_comm = nullptr;
+  /*!
+   * \brief Communicator connecting the workers with the same local rank on
+   * every node, set only for multi-node sessions. It carries the inter-node
+   * all-reduce stage over the network fabric, with all local ranks driving
+   * their NICs in parallel.
+   */
+  ncclComm_t cross_comm = nullptr;
+  /*! \brief The number of workers on each node. */
+  int node_size = 1;
+  /*! \brief The number of nodes in the session. */
+  int num_nodes = 1;
+  /*!
+   * \brief The dedicated stream for collectives when communication overlap
+   * is enabled, so that independent compute on the default stream can run
+   * concurrently with collectives. Event-based dependencies keep ordering:
+   * the comm stream waits for the compute stream at collective launch, and
+   * the compute stream waits for the comm stream at WaitCommStream.
+   */
+  deviceStream_t comm_stream = nullptr;
+  /*! \brief The event ordering the comm stream after the compute stream. */
+  deviceEvent_t comm_launch_event = nullptr;
+  /*! \brief The event ordering the compute stream after the comm stream. */
+  deviceEvent_t comm_done_event = nullptr;
+  /*! \brief Whether collectives run on the dedicated comm stream. */
+  bool comm_overlap_enabled = false;
+  /*! \brief Whether a collective on the comm stream has not been waited for. */
+  bool comm_result_pending = false;
 
   ~CCLThreadLocalContext() { Clear(); }
 
   void Clear() {
+    if (node_comm) {
+      NCCL_CALL(ncclCommDestroy(node_comm));
+      node_comm = nullptr;
+    }
+    if (cross_comm) {
+      NCCL_CALL(ncclCommDestroy(cross_comm));
+      cross_comm = nullptr;
+    }
+    node_size = 1;
+    num_nodes = 1;
     if (group_comm) {
       NCCL_CALL(ncclCommDestroy(group_comm));
       if (global_comm == group_comm) {
@@ -146,6 +214,20 @@ struct CCLThreadLocalContext {
       NCCL_CALL(ncclCommDestroy(global_comm));
       global_comm = nullptr;
     }
+    if (comm_stream) {
+      StreamDestroy(comm_stream);
+      comm_stream = nullptr;
+    }
+    if (comm_launch_event) {
+      EventDestroy(comm_launch_event);
+      comm_launch_event = nullptr;
+    }
+    if (comm_done_event) {
+      EventDestroy(comm_done_event);
+      comm_done_event = nullptr;
+    }
+    comm_overlap_enabled = false;
+    comm_result_pending = false;
     if (default_stream) {
       StreamDestroy(default_stream);
       default_stream = nullptr;
@@ -160,6 +242,52 @@ struct CCLThreadLocalContext {
     return stream == nullptr ? default_stream : stream;
   }
 
+  /*!
+   * \brief Toggle collective/compute overlap. The comm stream and ordering
+   * events are created lazily on the first enable.
+   */
+  void SetCommOverlap(bool enable) {
+    if (enable && comm_stream == nullptr) {
+      StreamCreate(&comm_stream);
+      EventCreate(&comm_launch_event);
+      EventCreate(&comm_done_event);
+    }
+    if (!enable) {
+      WaitCommStream();
+    }
+    comm_overlap_enabled = enable;
+  }
+
+  /*!
+   * \brief Get the stream to launch a collective on: the dedicated comm
+   * stream ordered after the compute stream when overlap is enabled, and
+   * the default stream otherwise.
+   */
+  deviceStream_t GetCollectiveStream() {
+    if (!comm_overlap_enabled) {
+      return GetDefaultStream();
+    }
+    EventRecord(comm_launch_event, GetDefaultStream());
+    StreamWaitEvent(comm_stream, comm_launch_event);
+    return comm_stream;
+  }
+
+  /*! \brief Mark a collective launched on the comm stream. */
+  void MarkCollectiveLaunched() {
+    if (comm_overlap_enabled) {
+      EventRecord(comm_done_event, comm_stream);
+      comm_result_pending = true;
+    }
+  }
+
+  /*! \brief Order the compute stream after all launched collectives. */
+  void WaitCommStream() {
+    if (comm_result_pending) {
+      StreamWaitEvent(GetDefaultStream(), comm_done_event);
+      comm_result_pending = false;
+    }
+  }
+
   static CCLThreadLocalContext* Get();
 };
 
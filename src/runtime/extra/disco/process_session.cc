@@ -26,6 +26,7 @@
 #include <utility>
 #include <vector>
 
+#include "../../../support/env.h"
 #include "../../../support/pipe.h"
 #include "../../rpc/minrpc/rpc_reference.h"
 #include "./bcast_session.h"
@@ -36,13 +37,29 @@
 namespace tvm {
 namespace runtime {
 
+/*!
+ * \brief The minimum size in bytes for host tensors to transfer between
+ * processes through shared memory instead of being serialized into the pipe.
+ * Overridable with the `TVM_DISCO_SHM_TENSOR_THRESHOLD` environment variable;
+ * non-positive values disable the shared-memory path.
+ */
+static int64_t DiscoShmTensorThresholdBytes() {
+  static int64_t threshold =
+      support::GetEnv<int64_t>("TVM_DISCO_SHM_TENSOR_THRESHOLD", int64_t(1) << 20);
+  return threshold;
+}
+
 class DiscoProcessChannel final : public DiscoChannel {
  public:
   DiscoProcessChannel(int64_t controler_to_worker_fd, int64_t worker_to_controler_fd)
       : controller_to_worker_pipe_(controler_to_worker_fd),
         worker_to_controller_pipe_(worker_to_controler_fd),
         controler_to_worker_(&controller_to_worker_pipe_),
-        worker_to_controler_(&worker_to_controller_pipe_) {}
+        worker_to_controler_(&worker_to_controller_pipe_) {
+    int64_t shm_threshold = DiscoShmTensorThresholdBytes();
+    controler_to_worker_.EnableShmTensorTransfer(shm_threshold);
+    worker_to_controler_.EnableShmTensorTransfer(shm_threshold);
+  }
 
   DiscoProcessChannel(DiscoProcessChannel&& other) = delete;
   DiscoProcessChannel(const DiscoProcessChannel& other) = delete;
@@ -36,6 +36,7 @@
 #include "../../../support/base64.h"
 #include "../../../support/bytes_io.h"
 #include "../../rpc/minrpc/rpc_reference.h"
+#include "./shm_tensor.h"
 
 namespace tvm {
 namespace runtime {
@@ -56,6 +57,58 @@ struct DiscoProtocol {
     this->arena_.RecycleAll();
   }
 
+  /*!
+   * \brief Enable the shared-memory fast path: host tensors of at least
+   * `threshold_bytes` bytes transfer through POSIX shared memory segments
+   * instead of being serialized into the packet. Only valid when both peers
+   * of the channel run on the same machine.
+   * \param threshold_bytes The minimum tensor size in bytes; non-positive
+   *        values disable the fast path.
+   */
+  void EnableShmTensorTransfer(int64_t threshold_bytes) {
+    if (DiscoShmTensor::Available()) {
+      shm_tensor_threshold_bytes_ = threshold_bytes;
+    }
+  }
+
+  /*!
+   * \brief Return the wrapped tensor if `value` holds a contiguous host
+   * tensor large enough for the shared-memory fast path.
+   */
+  inline ffi::Optional<Tensor> ShmEligibleTensor(const AnyView* value) const;
+
+  /*!
+   * \brief Number of bytes value occupies in LEB128 varint encoding.
+   *
+   * Type tags, sizes and shape dims in this protocol are varint-encoded:
+   * control messages are dominated by small integers, so they take one or
+   * two bytes each on the wire instead of four or eight.
+   */
+  static uint64_t VarUIntProtocolBytes(uint64_t value) {
+    uint64_t nbytes = 1;
+    while (value >= 0x80) {
+      value >>= 7;
+      ++nbytes;
+    }
+    return nbytes;
+  }
+
+  /*! \brief Map a signed value onto the varint-friendly zigzag encoding. */
+  static uint64_t ZigZagEncode(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+  }
+
+  /*! \brief Inverse of ZigZagEncode. */
+  static int64_t ZigZagDecode(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+  }
+
+  /*! \brief Write an unsigned integer in LEB128 varint encoding. */
+  inline void WriteVarUInt(uint64_t value);
+
+  /*! \brief Read an unsigned integer in LEB128 varint encoding. */
+  inline uint64_t ReadVarUInt();
+
   /*! \brief Get the length of the object being serialized. Used by RPCReference. */
   inline uint64_t GetFFIAnyProtocolBytes(const TVMFFIAny* obj);
 
@@ -86,6 +139,8 @@ struct DiscoProtocol {
 
   support::Arena arena_;
   std::vector<Any> any_arena_;
+  /*! \brief The minimum tensor size for shared memory transfer; 0 disables it. */
+  int64_t shm_tensor_threshold_bytes_ = 0;
   friend struct RPCReference;
 };
 
@@ -116,29 +171,96 @@ struct DiscoDebugObject : public ffi::Object {
   inline std::string SaveToStr() const;
   /*! \brief Deserialize the debug object from string */
   static inline ffi::ObjectPtr<DiscoDebugObject> LoadFromStr(std::string json_str);
-  /*! \brief Get the size of the debug object in bytes */
-  inline uint64_t GetFFIAnyProtocolBytes() const {
-    return sizeof(uint64_t) + this->SaveToStr().size();
-  }
   TVM_FFI_DECLARE_OBJECT_INFO_FINAL("runtime.disco.DiscoDebugObject", DiscoDebugObject, SessionObj);
 };
 
+template <class SubClassType>
+inline ffi::Optional<Tensor> DiscoProtocol<SubClassType>::ShmEligibleTensor(
+    const AnyView* value) const {
+  if (shm_tensor_threshold_bytes_ <= 0) {
+    return std::nullopt;
+  }
+  const auto opt_debug_obj = value->as<DiscoDebugObject>();
+  if (!opt_debug_obj) {
+    return std::nullopt;
+  }
+  auto opt_tensor = (*opt_debug_obj).data.as<Tensor>();
+  if (!opt_tensor) {
+    return std::nullopt;
+  }
+  Tensor tensor = opt_tensor.value();
+  int device_type = tensor->device.device_type;
+  if (device_type != kDLCPU && device_type != kDLCUDAHost && device_type != kDLROCMHost) {
+    return std::nullopt;
+  }
+  if (!ffi::IsContiguous(*tensor.operator->())) {
+    return std::nullopt;
+  }
+  if (static_cast<int64_t>(ffi::GetDataSize(*tensor.operator->())) < shm_tensor_threshold_bytes_) {
+    return std::nullopt;
+  }
+  return tensor;
+}
+
+template <class SubClassType>
+inline void DiscoProtocol<SubClassType>::WriteVarUInt(uint64_t value) {
+  SubClassType* self = static_cast<SubClassType*>(this);
+  while (value >= 0x80) {
+    self->template Write<uint8_t>(static_cast<uint8_t>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  self->template Write<uint8_t>(static_cast<uint8_t>(value));
+}
+
+template <class SubClassType>
+inline uint64_t DiscoProtocol<SubClassType>::ReadVarUInt() {
+  SubClassType* self = static_cast<SubClassType*>(this);
+  uint64_t value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    uint8_t byte = 0;
+    self->template Read<uint8_t>(&byte);
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return value;
+    }
+  }
+  TVM_FFI_THROW(ValueError) << "Malformed varint in Disco message";
+  return 0;
+}
+
 template <class SubClassType>
 inline uint64_t DiscoProtocol<SubClassType>::GetFFIAnyProtocolBytes(const TVMFFIAny* value) {
   const AnyView* any_view_ptr = reinterpret_cast<const AnyView*>(value);
-  if (any_view_ptr->as<DRefObj>()) {
-    return sizeof(uint32_t) + sizeof(int64_t);
+  if (const auto* ref = any_view_ptr->as<DRefObj>()) {
+    return VarUIntProtocolBytes(kRuntimeDiscoDRef) +
+           VarUIntProtocolBytes(ZigZagEncode(ref->reg_id));
   } else if (const auto opt_str = any_view_ptr->as<ffi::String>()) {
     uint64_t size = (*opt_str).size();
-    return sizeof(uint32_t) + sizeof(uint64_t) + size * sizeof(char);
+    return VarUIntProtocolBytes(ffi::TypeIndex::kTVMFFIStr) + VarUIntProtocolBytes(size) +
+           size * sizeof(char);
   } else if (const auto opt_bytes = any_view_ptr->as<ffi::Bytes>()) {
     uint64_t size = (*opt_bytes).size();
-    return sizeof(uint32_t) + sizeof(uint64_t) + size * sizeof(char);
+    return VarUIntProtocolBytes(ffi::TypeIndex::kTVMFFIBytes) + VarUIntProtocolBytes(size) +
+           size * sizeof(char);
   } else if (const auto opt_shape = any_view_ptr->as<ffi::Shape>()) {
-    uint64_t ndim = (*opt_shape).size();
-    return sizeof(uint32_t) + sizeof(uint64_t) + ndim * sizeof(ffi::ShapeObj::index_type);
+    uint64_t nbytes = VarUIntProtocolBytes(ffi::TypeIndex::kTVMFFIShape) +
+                      VarUIntProtocolBytes((*opt_shape).size());
+    for (ffi::ShapeObj::index_type dim : *opt_shape) {
+      nbytes += VarUIntProtocolBytes(ZigZagEncode(dim));
+    }
+    return nbytes;
+  } else if (const auto opt_tensor = this->ShmEligibleTensor(any_view_ptr)) {
+    const Tensor& tensor = *opt_tensor;
+    uint64_t nbytes = VarUIntProtocolBytes(ffi::TypeIndex::kTVMFFITensor) +
+                      DiscoShmTensor::kSegmentNameLen + VarUIntProtocolBytes(tensor->ndim) +
+                      sizeof(DLDataType);
+    for (int i = 0; i < tensor->ndim; ++i) {
+      nbytes += VarUIntProtocolBytes(ZigZagEncode(tensor->shape[i]));
+    }
+    return nbytes;
   } else if (const auto opt_debug_obj = any_view_ptr->as<DiscoDebugObject>()) {
-    return sizeof(uint32_t) + (*opt_debug_obj).GetFFIAnyProtocolBytes();
+    uint64_t size = (*opt_debug_obj).SaveToStr().size();
+    return VarUIntProtocolBytes(0) + VarUIntProtocolBytes(size) + size;
   } else {
     TVM_FFI_THROW(ValueError) << "Object type is not supported in Disco calling convention: "
                               << any_view_ptr->GetTypeKey()
@@ -151,25 +273,36 @@ inline void DiscoProtocol<SubClassType>::WriteFFIAny(const TVMFFIAny* value) {
   SubClassType* self = static_cast<SubClassType*>(this);
   const AnyView* any_view_ptr = reinterpret_cast<const AnyView*>(value);
   if (const auto* ref = any_view_ptr->as<DRefObj>()) {
-    int64_t reg_id = ref->reg_id;
-    self->template Write<uint32_t>(kRuntimeDiscoDRef);
-    self->template Write<int64_t>(reg_id);
+    WriteVarUInt(kRuntimeDiscoDRef);
+    WriteVarUInt(ZigZagEncode(ref->reg_id));
   } else if (const auto opt_str = any_view_ptr->as<ffi::String>()) {
-    self->template Write<uint32_t>(ffi::TypeIndex::kTVMFFIStr);
-    self->template Write<uint64_t>((*opt_str).size());
+    WriteVarUInt(ffi::TypeIndex::kTVMFFIStr);
+    WriteVarUInt((*opt_str).size());
     self->template WriteArray<char>((*opt_str).data(), (*opt_str).size());
   } else if (const auto opt_bytes = any_view_ptr->as<ffi::Bytes>()) {
-    self->template Write<uint32_t>(ffi::TypeIndex::kTVMFFIBytes);
-    self->template Write<uint64_t>((*opt_bytes).size());
+    WriteVarUInt(ffi::TypeIndex::kTVMFFIBytes);
+    WriteVarUInt((*opt_bytes).size());
     self->template WriteArray<char>((*opt_bytes).data(), (*opt_bytes).size());
   } else if (const auto opt_shape = any_view_ptr->as<ffi::Shape>()) {
-    self->template Write<uint32_t>(ffi::TypeIndex::kTVMFFIShape);
-    self->template Write<uint64_t>((*opt_shape).size());
-    self->template WriteArray<ffi::ShapeObj::index_type>((*opt_shape).data(), (*opt_shape).size());
+    WriteVarUInt(ffi::TypeIndex::kTVMFFIShape);
+    WriteVarUInt((*opt_shape).size());
+    for (ffi::ShapeObj::index_type dim : *opt_shape) {
+      WriteVarUInt(ZigZagEncode(dim));
+    }
+  } else if (const auto opt_tensor = this->ShmEligibleTensor(any_view_ptr)) {
+    Tensor tensor = opt_tensor.value();
+    std::string name = DiscoShmTensor::Export(tensor);
+    WriteVarUInt(ffi::TypeIndex::kTVMFFITensor);
+    self->template WriteArray<char>(name.data(), name.size());
+    WriteVarUInt(tensor->ndim);
+    for (int i = 0; i < tensor->ndim; ++i) {
+      WriteVarUInt(ZigZagEncode(tensor->shape[i]));
+    }
+    self->template Write<DLDataType>(tensor->dtype);
   } else if (const auto opt_debug_obj = any_view_ptr->as<DiscoDebugObject>()) {
-    self->template Write<uint32_t>(0);
+    WriteVarUInt(0);
     std::string str = (*opt_debug_obj).SaveToStr();
-    self->template Write<uint64_t>(str.size());
+    WriteVarUInt(str.size());
     self->template WriteArray<char>(str.data(), str.size());
   } else {
     TVM_FFI_THROW(ValueError) << "Object type is not supported in Disco calling convention: "
@@ -182,40 +315,48 @@ template <class SubClassType>
 inline void DiscoProtocol<SubClassType>::ReadFFIAny(TVMFFIAny* out) {
   SubClassType* self = static_cast<SubClassType*>(this);
   ffi::Any result{nullptr};
-  uint32_t type_index;
-  self->template Read<uint32_t>(&type_index);
+  uint64_t type_index = ReadVarUInt();
   if (type_index == kRuntimeDiscoDRef) {
     ffi::ObjectPtr<DRefObj> dref = ffi::make_object<DRefObj>();
-    self->template Read<int64_t>(&dref->reg_id);
+    dref->reg_id = ZigZagDecode(ReadVarUInt());
     dref->session = Session{nullptr};
     result = ffi::ObjectRef(std::move(dref));
   } else if (type_index == ffi::TypeIndex::kTVMFFIStr) {
-    uint64_t size = 0;
-    self->template Read<uint64_t>(&size);
+    uint64_t size = ReadVarUInt();
     std::string data(size, '\0');
     self->template ReadArray<char>(data.data(), size);
     result = ffi::String(std::move(data));
   } else if (type_index == ffi::TypeIndex::kTVMFFIBytes) {
-    uint64_t size = 0;
-    self->template Read<uint64_t>(&size);
+    uint64_t size = ReadVarUInt();
     std::string data(size, '\0');
     self->template ReadArray<char>(data.data(), size);
     result = ffi::Bytes(std::move(data));
   } else if (type_index == ffi::TypeIndex::kTVMFFIShape) {
-    uint64_t ndim = 0;
-    self->template Read<uint64_t>(&ndim);
+    uint64_t ndim = ReadVarUInt();
     std::vector<ffi::ShapeObj::index_type> data(ndim);
-    self->template ReadArray<ffi::ShapeObj::index_type>(data.data(), ndim);
+    for (uint64_t i = 0; i < ndim; ++i) {
+      data[i] = ZigZagDecode(ReadVarUInt());
+    }
     result = ffi::Shape(std::move(data));
+  } else if (type_index == ffi::TypeIndex::kTVMFFITensor) {
+    std::string name(DiscoShmTensor::kSegmentNameLen, '\0');
+    self->template ReadArray<char>(name.data(), name.size());
+    uint64_t ndim = ReadVarUInt();
+    std::vector<int64_t> shape(ndim);
+    for (uint64_t i = 0; i < ndim; ++i) {
+      shape[i] = ZigZagDecode(ReadVarUInt());
+    }
+    DLDataType dtype;
+    self->template Read<DLDataType>(&dtype);
+    result = DiscoShmTensor::Import(name, ffi::Shape(std::move(shape)), dtype);
   } else if (type_index == 0) {
-    uint64_t size = 0;
-    self->template Read<uint64_t>(&size);
+    uint64_t size = ReadVarUInt();
     std::string data(size, '\0');
     self->template ReadArray<char>(data.data(), size);
     result = DiscoDebugObject::LoadFromStr(std::move(data))->data.cast<ffi::ObjectRef>();
   } else {
     TVM_FFI_THROW(ValueError) << "Object type is not supported in Disco calling convention: "
-                              << ffi::Object::TypeIndex2Key(type_index)
+                              << ffi::Object::TypeIndex2Key(static_cast<int32_t>(type_index))
                               << " (type_index = " << type_index << ")";
   }
   *reinterpret_cast<ffi::AnyView*>(out) = result;
@@ -227,12 +368,14 @@ inline std::string DiscoDebugObject::SaveToStr() const {
     Tensor array = opt_nd.value();
     std::string result;
     {
+      // The string travels inside a length-prefixed binary packet, so the
+      // tensor is serialized raw; base64 would only add 33% of volume plus
+      // an encode/decode pass. Control bit '1' (base64) is still accepted
+      // on load for messages produced by older senders.
       support::BytesOutStream mstrm(&result);
-      support::Base64OutStream b64strm(&mstrm);
-      runtime::SaveDLTensor(&b64strm, array.operator->());
-      b64strm.Finish();
+      runtime::SaveDLTensor(&mstrm, array.operator->());
     }
-    result.push_back('1');
+    result.push_back('2');
     return result;
   } else if (auto opt_obj = this->data.as<ffi::ObjectRef>()) {
     ffi::ObjectRef obj = opt_obj.value();
@@ -259,6 +402,11 @@ inline ffi::ObjectPtr<DiscoDebugObject> DiscoDebugObject::LoadFromStr(std::strin
     runtime::Tensor array;
     TVM_FFI_ICHECK(array.Load(&b64strm));
     result->data = std::move(array);
+  } else if (control_bit == '2') {
+    support::BytesInStream mstrm(json_str);
+    runtime::Tensor array;
+    TVM_FFI_ICHECK(array.Load(&mstrm));
+    result->data = std::move(array);
   } else {
     TVM_FFI_THROW(ValueError) << "Unsupported control bit: " << control_bit
                               << ". Full string: " << json_str;
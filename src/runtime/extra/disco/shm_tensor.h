@@ -0,0 +1,165 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file shm_tensor.h
+ * \brief Shared-memory transfer of host tensors between Disco processes.
+ *
+ * Large host tensors sent over a single-host process channel do not need to
+ * be serialized into the pipe packet. The sender copies the tensor into a
+ * freshly created POSIX shared memory segment and only ships the segment name
+ * in the packet; the receiver maps the segment, unlinks the name so the
+ * kernel reclaims the segment once the last mapping goes away, and aliases
+ * the mapping as a zero-copy Tensor whose destructor unmaps it.
+ */
+#ifndef TVM_RUNTIME_DISCO_SHM_TENSOR_H_
+#define TVM_RUNTIME_DISCO_SHM_TENSOR_H_
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <tvm/runtime/tensor.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+
+namespace tvm {
+namespace runtime {
+
+/*! \brief Bulk transfer of host tensors through POSIX shared memory. */
+class DiscoShmTensor {
+ public:
+  /*!
+   * \brief The fixed length of generated segment names. Keeping the length
+   * constant lets the protocol compute packet sizes before the segment is
+   * actually created.
+   */
+  static constexpr size_t kSegmentNameLen = 36;
+
+  /*! \return Whether shared memory transfer is supported on this platform. */
+  static bool Available() {
+#ifndef _WIN32
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  /*!
+   * \brief Copy a host tensor into a new uniquely named shared memory segment.
+   * \param tensor The contiguous host tensor to export.
+   * \return The name of the created segment, of length `kSegmentNameLen`.
+   */
+  static std::string Export(const Tensor& tensor) {
+#ifndef _WIN32
+    static std::atomic<uint64_t> counter{0};
+    size_t nbytes = ffi::GetDataSize(*tensor.operator->());
+    char name[kSegmentNameLen + 1];
+    int fd = -1;
+    while (fd < 0) {
+      uint64_t seq = counter.fetch_add(1, std::memory_order_relaxed);
+      snprintf(name, sizeof(name), "/tvm_disco_%08x_%016" PRIx64, static_cast<unsigned>(getpid()),
+               seq);
+      fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+      if (fd < 0 && errno != EEXIST) {
+        TVM_FFI_THROW(InternalError)
+            << "Cannot create shared memory segment \"" << name << "\": " << strerror(errno);
+      }
+    }
+    if (ftruncate(fd, nbytes) != 0) {
+      close(fd);
+      shm_unlink(name);
+      TVM_FFI_THROW(InternalError)
+          << "Cannot resize shared memory segment \"" << name << "\": " << strerror(errno);
+    }
+    void* data = mmap(nullptr, nbytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+      shm_unlink(name);
+      TVM_FFI_THROW(InternalError)
+          << "Cannot map shared memory segment \"" << name << "\": " << strerror(errno);
+    }
+    std::memcpy(data, static_cast<char*>(tensor->data) + tensor->byte_offset, nbytes);
+    munmap(data, nbytes);
+    return std::string(name, kSegmentNameLen);
+#else
+    TVM_FFI_THROW(InternalError) << "Shared memory tensor transfer is unsupported on this platform";
+    throw;
+#endif
+  }
+
+  /*!
+   * \brief Map an exported segment as a zero-copy host tensor and unlink it.
+   * \param name The segment name produced by `Export` on the sending side.
+   * \param shape The shape of the tensor.
+   * \param dtype The data type of the tensor.
+   * \return The tensor aliasing the mapping; its destructor unmaps it.
+   */
+  static Tensor Import(const std::string& name, ffi::Shape shape, DLDataType dtype) {
+#ifndef _WIN32
+    class ShmAlloc {
+     public:
+      ShmAlloc(void* data, size_t size) : data_(data), size_(size) {}
+      void AllocData(DLTensor* tensor) { tensor->data = data_; }
+      void FreeData(DLTensor* tensor) { munmap(data_, size_); }
+
+     private:
+      void* data_;
+      size_t size_;
+    };
+
+    int64_t numel = 1;
+    for (int64_t dim : shape) {
+      numel *= dim;
+    }
+    size_t nbytes = ffi::GetDataSize(numel, dtype);
+    int fd = shm_open(name.c_str(), O_RDWR, 0600);
+    if (fd < 0) {
+      TVM_FFI_THROW(InternalError)
+          << "Cannot open shared memory segment \"" << name << "\": " << strerror(errno);
+    }
+    void* data = mmap(nullptr, nbytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    // The kernel keeps the segment alive until the last mapping goes away.
+    shm_unlink(name.c_str());
+    if (data == MAP_FAILED) {
+      TVM_FFI_THROW(InternalError)
+          << "Cannot map shared memory segment \"" << name << "\": " << strerror(errno);
+    }
+    return Tensor::FromNDAlloc(ShmAlloc(data, nbytes), std::move(shape), dtype,
+                               DLDevice{kDLCPU, 0});
+#else
+    TVM_FFI_THROW(InternalError) << "Shared memory tensor transfer is unsupported on this platform";
+    throw;
+#endif
+  }
+};
+
+}  // namespace runtime
+}  // namespace tvm
+
+#endif  // TVM_RUNTIME_DISCO_SHM_TENSOR_H_
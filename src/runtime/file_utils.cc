@@ -26,13 +26,16 @@
 #include <tvm/ffi/extra/json.h>
 #include <tvm/ffi/function.h>
 #include <tvm/ffi/reflection/registry.h>
+#include <tvm/runtime/device_api.h>
 #include <tvm/support/io.h>
 
+#include <algorithm>
 #include <fstream>
 #include <utility>
 #include <vector>
 
 #include "../support/bytes_io.h"
+#include "../support/env.h"
 
 namespace tvm {
 namespace runtime {
@@ -175,6 +178,105 @@ ffi::Map<ffi::String, Tensor> LoadParams(support::Stream* strm) {
   return params;
 }
 
+ffi::Map<ffi::String, Tensor> LoadParamsFromFileToDevice(const std::string& file_name,
+                                                         Device device) {
+  tvm::runtime::SimpleBinaryFileStream strm(file_name, "rb");
+  ffi::Map<ffi::String, Tensor> params;
+  uint64_t header, reserved;
+  TVM_FFI_ICHECK(strm.Read(&header)) << "Invalid parameters file format";
+  TVM_FFI_ICHECK(header == kTVMTensorListMagic) << "Invalid parameters file format";
+  TVM_FFI_ICHECK(strm.Read(&reserved)) << "Invalid parameters file format";
+
+  std::vector<std::string> names;
+  TVM_FFI_ICHECK(strm.Read(&names)) << "Invalid parameters file format";
+  uint64_t sz;
+  strm.Read(&sz);
+  TVM_FFI_ICHECK(static_cast<size_t>(sz) == names.size()) << "Invalid parameters file format";
+
+  // Each parameter streams through two bounded pinned staging buffers: while
+  // one chunk is being copied to the device, the next chunk is read from the
+  // file into the other buffer. Copies for the two buffers go on separate
+  // streams so that reusing a buffer only waits for its own copy.
+  int64_t chunk_nbytes =
+      std::max<int64_t>(support::GetEnv<int64_t>("TVM_PARAM_STREAM_CHUNK_BYTES", 64 << 20), 1);
+  DeviceAPI* device_api = device.device_type == kDLCPU ? nullptr : DeviceAPI::Get(device);
+  Device host_device = GetPreferredHostDevice(device);
+  Tensor staging[2];
+  TVMStreamHandle streams[2] = {nullptr, nullptr};
+  if (device_api != nullptr) {
+    staging[0] = Tensor::Empty({chunk_nbytes}, DLDataType{kDLUInt, 8, 1}, host_device);
+    staging[1] = Tensor::Empty({chunk_nbytes}, DLDataType{kDLUInt, 8, 1}, host_device);
+    streams[0] = device_api->CreateStream(device);
+    streams[1] = device_api->CreateStream(device);
+  }
+
+  for (size_t i = 0; i < static_cast<size_t>(sz); ++i) {
+    if (!TVM_FFI_IO_NO_ENDIAN_SWAP || device_api == nullptr) {
+      // Byte swapping needs the whole array on host; CPU targets are read in
+      // place. Both take the regular non-streaming path.
+      Tensor temp;
+      temp.Load(&strm);
+      params.Set(names[i], device_api == nullptr ? temp : temp.CopyTo(device));
+      continue;
+    }
+    uint64_t tensor_header, tensor_reserved;
+    TVM_FFI_ICHECK(strm.Read(&tensor_header)) << "Invalid DLTensor file format";
+    TVM_FFI_ICHECK(strm.Read(&tensor_reserved)) << "Invalid DLTensor file format";
+    TVM_FFI_ICHECK(tensor_header == kTVMTensorMagic) << "Invalid DLTensor file format";
+    Device stored_dev;
+    int ndim;
+    DLDataType dtype;
+    TVM_FFI_ICHECK(strm.Read(&stored_dev)) << "Invalid DLTensor file format";
+    TVM_FFI_ICHECK(strm.Read(&ndim)) << "Invalid DLTensor file format";
+    TVM_FFI_ICHECK(strm.Read(&dtype)) << "Invalid DLTensor file format";
+    TVM_FFI_ICHECK_EQ(stored_dev.device_type, kDLCPU)
+        << "Invalid DLTensor device: can only save as CPU tensor";
+    std::vector<int64_t> shape(ndim);
+    if (ndim != 0) {
+      TVM_FFI_ICHECK(strm.ReadArray(&shape[0], ndim)) << "Invalid DLTensor file format";
+    }
+    int64_t num_elems = 1;
+    for (int j = 0; j < ndim; ++j) {
+      num_elems *= shape[j];
+    }
+    int64_t data_byte_size;
+    TVM_FFI_ICHECK(strm.Read(&data_byte_size)) << "Invalid DLTensor file format";
+    TVM_FFI_ICHECK(data_byte_size == num_elems * ((dtype.bits + 7) / 8))
+        << "Invalid DLTensor file format";
+
+    Tensor dst = Tensor::Empty(ffi::Shape(shape), dtype, device);
+    int64_t num_chunks = 0;
+    for (int64_t offset = 0; offset < data_byte_size; offset += chunk_nbytes, ++num_chunks) {
+      int64_t this_chunk = std::min(chunk_nbytes, data_byte_size - offset);
+      const Tensor& buffer = staging[num_chunks % 2];
+      TVMStreamHandle stream = streams[num_chunks % 2];
+      if (num_chunks >= 2) {
+        // Wait until the copy that last used this buffer has drained.
+        device_api->StreamSync(device, stream);
+      }
+      TVM_FFI_ICHECK_EQ(strm.Read(buffer->data, this_chunk), static_cast<size_t>(this_chunk))
+          << "Invalid DLTensor file format";
+      DLTensor src_view = *buffer.operator->();
+      src_view.ndim = 1;
+      src_view.shape = &this_chunk;
+      DLTensor dst_view = *dst.operator->();
+      dst_view.ndim = 1;
+      dst_view.shape = &this_chunk;
+      dst_view.dtype = DLDataType{kDLUInt, 8, 1};
+      dst_view.byte_offset = dst->byte_offset + offset;
+      Tensor::CopyFromTo(&src_view, &dst_view, stream);
+    }
+    params.Set(names[i], dst);
+  }
+  if (device_api != nullptr) {
+    device_api->StreamSync(device, streams[0]);
+    device_api->StreamSync(device, streams[1]);
+    device_api->FreeStream(device, streams[0]);
+    device_api->FreeStream(device, streams[1]);
+  }
+  return params;
+}
+
 void SaveParams(support::Stream* strm, const ffi::Map<ffi::String, Tensor>& params) {
   std::vector<std::string> names;
   std::vector<const DLTensor*> arrays;
@@ -227,6 +329,11 @@ TVM_FFI_STATIC_INIT_BLOCK() {
              tvm::runtime::SimpleBinaryFileStream strm(path, "rb");
              return LoadParams(&strm);
            })
+      .def("runtime.LoadParamsFromFileToDevice",
+           [](const ffi::String& path, int device_type, int device_id) {
+             return LoadParamsFromFileToDevice(
+                 path, Device{static_cast<DLDeviceType>(device_type), device_id});
+           })
       // Registry: "runtime.LoadMetaDataFromJSON" — parse a tvm_meta.json
       // string into Map<String, FunctionInfo>.  Used by Python callers that
       // build FunctionInfo maps in-memory (e.g. tirx external_kernel) without
@@ -116,6 +116,17 @@ ffi::Map<ffi::String, Tensor> LoadParams(const std::string& param_blob);
  * \return Map of parameter name to parameter value.
  */
 ffi::Map<ffi::String, Tensor> LoadParams(support::Stream* strm);
+/*!
+ * \brief Load parameters from a file directly onto a device, streaming the
+ * data through bounded pinned staging buffers instead of materializing each
+ * parameter on the host first. Peak host memory is two staging chunks
+ * regardless of the model size.
+ * \param file_name Path of the parameter file.
+ * \param device The device to place the parameters on.
+ * \return Map of parameter name to parameter value.
+ */
+ffi::Map<ffi::String, Tensor> LoadParamsFromFileToDevice(const std::string& file_name,
+                                                         Device device);
 /*!
  * \brief Serialize parameters to a byte array.
  * \param params Parameters to save.
@@ -0,0 +1,89 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/runtime/memory/async_allocator.h
+ * \brief Stream-ordered allocator.
+ *
+ * Allocations and frees are ordered on the device's current stream through
+ * DeviceAPI::AllocDataSpaceAsync, so they overlap with compute instead of
+ * synchronizing the device. On CUDA this maps onto cudaMallocAsync and the
+ * driver's stream-ordered memory pool, which also takes over the buffer
+ * recycling that PooledAllocator would otherwise do on the host side.
+ */
+#ifndef TVM_RUNTIME_MEMORY_ASYNC_ALLOCATOR_H_
+#define TVM_RUNTIME_MEMORY_ASYNC_ALLOCATOR_H_
+
+#include <tvm/runtime/device_api.h>
+#include <tvm/runtime/logging.h>
+#include <tvm/runtime/memory/memory_manager.h>
+
+#include <atomic>
+#include <string>
+
+namespace tvm {
+namespace runtime {
+namespace memory {
+
+class AsyncAllocator final : public Allocator {
+ public:
+  explicit AsyncAllocator() : Allocator(kAsync), used_memory_(0) {}
+
+  Buffer Alloc(Device dev, size_t nbytes, size_t alignment, DLDataType type_hint) final {
+    Buffer buf;
+    buf.device = dev;
+    buf.size = nbytes;
+    buf.alloc_type = kAsync;
+    DeviceAPI* api = DeviceAPI::Get(dev);
+    buf.data = api->AllocDataSpaceAsync(dev, nbytes, alignment, type_hint,
+                                        api->GetCurrentStream(dev));
+    used_memory_.fetch_add(nbytes, std::memory_order_relaxed);
+    DLOG(INFO) << "allocate " << nbytes << " B, used memory " << used_memory_ << " B";
+    if (AllocationTracer::Enabled()) AllocationTracer::RecordAlloc(buf);
+    return buf;
+  }
+
+  Buffer Alloc(Device dev, ffi::Shape shape, DLDataType type_hint,
+               const std::string& mem_scope) final {
+    if (AllowMemoryScope(mem_scope)) {
+      return Allocator::Alloc(dev, shape, type_hint, mem_scope);
+    }
+    TVM_FFI_THROW(InternalError) << "This alloc should be implemented";
+    return {};
+  }
+
+  void Free(const Buffer& buffer) final {
+    if (AllocationTracer::Enabled()) AllocationTracer::RecordFree(buffer);
+    DeviceAPI* api = DeviceAPI::Get(buffer.device);
+    api->FreeDataSpaceAsync(buffer.device, buffer.data, api->GetCurrentStream(buffer.device));
+    used_memory_.fetch_sub(buffer.size, std::memory_order_relaxed);
+    DLOG(INFO) << "free " << buffer.size << " B, used memory " << used_memory_ << " B";
+  }
+
+  size_t UsedMemory() const final { return used_memory_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<size_t> used_memory_;
+};
+
+}  // namespace memory
+}  // namespace runtime
+}  // namespace tvm
+
+#endif  // TVM_RUNTIME_MEMORY_ASYNC_ALLOCATOR_H_
@@ -27,9 +27,15 @@
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/memory/memory_manager.h>
 
+#include <algorithm>
+#include <chrono>
 #include <memory>
+#include <sstream>
 #include <utility>
+#include <vector>
 
+#include "../../support/ring_buffer.h"
+#include "async_allocator.h"
 #include "naive_allocator.h"
 #include "pooled_allocator.h"
 
@@ -126,6 +132,175 @@ Tensor StorageObj::AllocTensor(int64_t offset, ffi::Shape shape, DLDataType dtyp
                              this->buffer.device, offset);
 }
 
+//-----------------------------------------------------------
+// Allocation tracing.
+//-----------------------------------------------------------
+std::atomic<bool> AllocationTracer::enabled_{false};
+
+namespace {
+
+/*! \brief A fixed-size allocation trace event stored in the ring. */
+struct AllocTraceRecord {
+  /*! \brief Size in bytes; positive for an Alloc, negative for a Free. */
+  int64_t byte_delta;
+  /*! \brief Monotonic timestamp in nanoseconds. */
+  int64_t timestamp_ns;
+  /*! \brief Index into the tag table of the tracer. */
+  uint32_t tag_id;
+  /*! \brief The dlpack device type of the buffer. */
+  int32_t device_type;
+  /*! \brief The device id of the buffer. */
+  int32_t device_id;
+};
+
+/*! \brief Byte usage accounted to one tag. */
+struct TagStats {
+  /*! \brief Bytes currently held by allocations made under the tag. */
+  int64_t current_bytes = 0;
+  /*! \brief The high-water mark of current_bytes. */
+  int64_t peak_bytes = 0;
+};
+
+/*! \brief The attribution tag of the calling thread, see SetCurrentTag. */
+thread_local std::string current_trace_tag;
+
+struct AllocationTracerState {
+  std::mutex mu;
+  /*! \brief The bounded event ring; oldest records are dropped when full. */
+  support::RingBuffer ring;
+  /*! \brief Retention limit of the ring in bytes. */
+  size_t max_ring_bytes = 0;
+  /*! \brief Tag names indexed by tag id; id 0 is the unattributed tag. */
+  std::vector<std::string> tags;
+  /*! \brief Interning table from tag name to tag id. */
+  std::unordered_map<std::string, uint32_t> tag_ids;
+  /*! \brief Per-tag live bytes and high-water marks, indexed by tag id. */
+  std::vector<TagStats> stats;
+  /*!
+   * \brief Live buffers keyed by data pointer, so a free is attributed to
+   * the tag that allocated the buffer rather than the tag that happened to
+   * be active when the last reference was dropped.
+   */
+  std::unordered_map<const void*, std::pair<uint32_t, int64_t>> live;
+
+  static AllocationTracerState* Global() {
+    // NOTE: explicitly use new to avoid exit-time destruction of global state
+    // Global state will be recycled by OS as the process exits.
+    static auto* inst = new AllocationTracerState();
+    return inst;
+  }
+
+  uint32_t GetTagId(const std::string& tag) {
+    auto it = tag_ids.find(tag);
+    if (it != tag_ids.end()) return it->second;
+    uint32_t id = static_cast<uint32_t>(tags.size());
+    tags.push_back(tag);
+    stats.emplace_back();
+    tag_ids.emplace(tag, id);
+    return id;
+  }
+
+  void Append(const AllocTraceRecord& record) {
+    while (ring.bytes_available() + sizeof(record) > max_ring_bytes) {
+      AllocTraceRecord dropped;
+      ring.Read(&dropped, sizeof(dropped));
+    }
+    ring.Write(&record, sizeof(record));
+  }
+};
+
+int64_t TraceNowNanos() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+}  // namespace
+
+void AllocationTracer::Start(int64_t max_records) {
+  TVM_FFI_CHECK(max_records > 0, ValueError)
+      << "max_records must be positive, but got " << max_records;
+  AllocationTracerState* state = AllocationTracerState::Global();
+  std::lock_guard<std::mutex> lock(state->mu);
+  if (state->ring.bytes_available() > 0) {
+    std::vector<char> scratch(state->ring.bytes_available());
+    state->ring.Read(scratch.data(), scratch.size());
+  }
+  state->max_ring_bytes = sizeof(AllocTraceRecord) * static_cast<size_t>(max_records);
+  state->tags.clear();
+  state->tag_ids.clear();
+  state->stats.clear();
+  state->live.clear();
+  state->GetTagId("");
+  enabled_.store(true, std::memory_order_relaxed);
+}
+
+void AllocationTracer::Stop() { enabled_.store(false, std::memory_order_relaxed); }
+
+void AllocationTracer::SetCurrentTag(const std::string& tag) { current_trace_tag = tag; }
+
+void AllocationTracer::RecordAlloc(const Buffer& buffer) {
+  AllocationTracerState* state = AllocationTracerState::Global();
+  std::lock_guard<std::mutex> lock(state->mu);
+  // Re-check under the lock so a concurrent Stop/Start cannot interleave.
+  if (!Enabled()) return;
+  uint32_t tag_id = state->GetTagId(current_trace_tag);
+  int64_t nbytes = static_cast<int64_t>(buffer.size);
+  state->live[buffer.data] = {tag_id, nbytes};
+  TagStats& stats = state->stats[tag_id];
+  stats.current_bytes += nbytes;
+  stats.peak_bytes = std::max(stats.peak_bytes, stats.current_bytes);
+  state->Append({nbytes, TraceNowNanos(), tag_id, static_cast<int32_t>(buffer.device.device_type),
+                 buffer.device.device_id});
+}
+
+void AllocationTracer::RecordFree(const Buffer& buffer) {
+  AllocationTracerState* state = AllocationTracerState::Global();
+  std::lock_guard<std::mutex> lock(state->mu);
+  if (!Enabled()) return;
+  uint32_t tag_id = 0;
+  auto it = state->live.find(buffer.data);
+  if (it != state->live.end()) {
+    // Buffers allocated before Start have no live entry; leave them on the
+    // unattributed tag and do not skew its live byte count negative.
+    tag_id = it->second.first;
+    state->stats[tag_id].current_bytes -= it->second.second;
+    state->live.erase(it);
+  }
+  state->Append({-static_cast<int64_t>(buffer.size), TraceNowNanos(), tag_id,
+                 static_cast<int32_t>(buffer.device.device_type), buffer.device.device_id});
+}
+
+std::string AllocationTracer::Dump() {
+  AllocationTracerState* state = AllocationTracerState::Global();
+  std::lock_guard<std::mutex> lock(state->mu);
+  std::vector<AllocTraceRecord> records(state->ring.bytes_available() /
+                                        sizeof(AllocTraceRecord));
+  if (!records.empty()) {
+    state->ring.Read(records.data(), records.size() * sizeof(AllocTraceRecord));
+  }
+  std::ostringstream os;
+  os << "{\"tags\":[";
+  for (size_t i = 0; i < state->tags.size(); ++i) {
+    if (i != 0) os << ",";
+    os << "{\"name\":\"" << state->tags[i] << "\","
+       << "\"current_bytes\":" << state->stats[i].current_bytes << ","
+       << "\"peak_bytes\":" << state->stats[i].peak_bytes << "}";
+  }
+  os << "],\"events\":[";
+  for (size_t i = 0; i < records.size(); ++i) {
+    const AllocTraceRecord& record = records[i];
+    if (i != 0) os << ",";
+    os << "{\"tag\":" << record.tag_id << ","
+       << "\"bytes\":" << record.byte_delta << ","
+       << "\"device_type\":" << record.device_type << ","
+       << "\"device_id\":" << record.device_id << ","
+       << "\"timestamp_ns\":" << record.timestamp_ns << "}";
+  }
+  os << "]}";
+  return os.str();
+}
+
 MemoryManager* MemoryManager::Global() {
   // NOTE: explicitly use new to avoid exit-time destruction of global state
   // Global state will be recycled by OS as the process exits.
@@ -167,6 +342,11 @@ Allocator* GetDeviceSpecificAllocator(Device dev, AllocatorType type) {
         allocator = new PooledAllocator();
         break;
       }
+      case kAsync: {
+        VLOG(1) << "New async allocator for " << dev;
+        allocator = new AsyncAllocator();
+        break;
+      }
       default:
         TVM_FFI_THROW(InternalError) << "Unknown allocator type: " << type;
     }
@@ -270,7 +450,11 @@ void Allocator::Clear() {
 
 TVM_FFI_STATIC_INIT_BLOCK() {
   namespace refl = tvm::ffi::reflection;
-  refl::GlobalDef().def("vm.builtin.memory_manager.clear", MemoryManager::Clear);
+  refl::GlobalDef()
+      .def("vm.builtin.memory_manager.clear", MemoryManager::Clear)
+      .def("vm.builtin.memory_tracer.start", AllocationTracer::Start)
+      .def("vm.builtin.memory_tracer.stop", AllocationTracer::Stop)
+      .def("vm.builtin.memory_tracer.dump", AllocationTracer::Dump);
 }
 
 }  // namespace memory
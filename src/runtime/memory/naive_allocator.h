@@ -46,6 +46,7 @@ class NaiveAllocator final : public Allocator {
     buf.data = DeviceAPI::Get(dev)->AllocDataSpace(dev, nbytes, alignment, type_hint);
     used_memory_.fetch_add(nbytes, std::memory_order_relaxed);
     DLOG(INFO) << "allocate " << nbytes << " B, used memory " << used_memory_ << " B";
+    if (AllocationTracer::Enabled()) AllocationTracer::RecordAlloc(buf);
     return buf;
   }
 
@@ -72,10 +73,12 @@ class NaiveAllocator final : public Allocator {
     used_memory_.fetch_add(nbytes, std::memory_order_relaxed);
     DLOG(INFO) << "allocate " << nbytes << " B, used memory " << used_memory_ << " B";
     buf.alloc_type = kNaive;
+    if (AllocationTracer::Enabled()) AllocationTracer::RecordAlloc(buf);
     return buf;
   }
 
   void Free(const Buffer& buffer) override {
+    if (AllocationTracer::Enabled()) AllocationTracer::RecordFree(buffer);
     DeviceAPI::Get(buffer.device)->FreeDataSpace(buffer.device, buffer.data);
     used_memory_.fetch_sub(buffer.size, std::memory_order_relaxed);
     DLOG(INFO) << "free " << buffer.size << " B, used memory " << used_memory_ << " B";
@@ -27,7 +27,9 @@
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/memory/memory_manager.h>
 
+#include <algorithm>
 #include <atomic>
+#include <map>
 #include <mutex>
 #include <string>
 #include <unordered_map>
@@ -37,9 +39,24 @@ namespace tvm {
 namespace runtime {
 namespace memory {
 
+/*!
+ * \brief A pooling device allocator with size-class and best-fit tiers.
+ *
+ * There is deliberately no incremental defragmentation or epoch mechanism:
+ * pooled buffers are only returned to the device wholesale, either through
+ * Clear() or when an allocation failure triggers ReleaseAll(). Workloads
+ * whose footprint shifts over time should Clear() between phases.
+ */
 class PooledAllocator : public Allocator {
  public:
   static constexpr size_t kDefaultPageSize = 4096;
+  /*!
+   * \brief Largest request served by the size-class tier.
+   *
+   * Requests above the threshold go through the best-fit large pool, so a few
+   * huge buffers do not multiply into many close-but-distinct free lists.
+   */
+  static constexpr size_t kSizeClassThreshold = size_t(64) << 20;
 
   explicit PooledAllocator(size_t page_size = kDefaultPageSize)
       : Allocator(kPooled), page_size_(page_size), used_memory_(0) {}
@@ -48,13 +65,26 @@ class PooledAllocator : public Allocator {
 
   Buffer Alloc(Device dev, size_t nbytes, size_t alignment, DLDataType type_hint) override {
     std::lock_guard<std::recursive_mutex> lock(mu_);
-    size_t size = ((nbytes + page_size_ - 1) / page_size_) * page_size_;
-    auto&& it = memory_pool_.find(size);
-    if (it != memory_pool_.end() && !it->second.empty()) {
-      auto&& pool = it->second;
-      auto ret = pool.back();
-      pool.pop_back();
-      return ret;
+    size_t size = RoundToSizeClass(std::max(nbytes, size_t(1)));
+    if (size <= kSizeClassThreshold) {
+      auto&& it = size_class_pool_.find(size);
+      if (it != size_class_pool_.end() && !it->second.empty()) {
+        auto&& pool = it->second;
+        auto ret = pool.back();
+        pool.pop_back();
+        if (AllocationTracer::Enabled()) AllocationTracer::RecordAlloc(ret);
+        return ret;
+      }
+    } else {
+      // Best-fit over the large pool: take the smallest free buffer that
+      // covers the request, with bounded internal waste.
+      auto it = large_pool_.lower_bound(size);
+      if (it != large_pool_.end() && it->first <= size + size / 4) {
+        auto ret = it->second;
+        large_pool_.erase(it);
+        if (AllocationTracer::Enabled()) AllocationTracer::RecordAlloc(ret);
+        return ret;
+      }
     }
     Buffer buf;
     buf.device = dev;
@@ -71,6 +101,7 @@ class PooledAllocator : public Allocator {
 
     used_memory_.fetch_add(size, std::memory_order_relaxed);
     VLOG(1) << "allocate " << size << " B, used memory " << used_memory_ << " B";
+    if (AllocationTracer::Enabled()) AllocationTracer::RecordAlloc(buf);
     return buf;
   }
 
@@ -84,11 +115,15 @@ class PooledAllocator : public Allocator {
   }
 
   void Free(const Buffer& buffer) override {
+    // From the op's perspective reclaiming into the pool is the free; the
+    // eventual DeviceFreeDataSpace in ReleaseAll is pool-internal.
+    if (AllocationTracer::Enabled()) AllocationTracer::RecordFree(buffer);
     std::lock_guard<std::recursive_mutex> lock(mu_);
-    if (memory_pool_.find(buffer.size) == memory_pool_.end()) {
-      memory_pool_.emplace(buffer.size, std::vector<Buffer>{});
+    if (buffer.size <= kSizeClassThreshold) {
+      size_class_pool_[buffer.size].push_back(buffer);
+    } else {
+      large_pool_.emplace(buffer.size, buffer);
     }
-    memory_pool_.at(buffer.size).push_back(buffer);
     VLOG(1) << "reclaim buffer " << buffer.size;
   }
 
@@ -108,21 +143,46 @@ class PooledAllocator : public Allocator {
 
   virtual void ReleaseAll() {
     std::lock_guard<std::recursive_mutex> lock(mu_);
-    for (auto const& it : memory_pool_) {
+    for (auto const& it : size_class_pool_) {
       auto const& pool = it.second;
       for (auto const& buf : pool) {
         DeviceFreeDataSpace(buf.device, buf.data);
       }
     }
-    memory_pool_.clear();
+    size_class_pool_.clear();
+    for (auto const& it : large_pool_) {
+      DeviceFreeDataSpace(it.second.device, it.second.data);
+    }
+    large_pool_.clear();
     used_memory_ = 0;
     VLOG(1) << "release all buffers";
   }
 
+  /*!
+   * \brief Round a request up to its size class.
+   *
+   * Classes follow the jemalloc scheme of four classes per power-of-two
+   * group, so rounding wastes at most 25% of the request instead of
+   * collapsing every variable-shape request onto distinct page multiples.
+   * Requests above kSizeClassThreshold are only rounded to page granularity
+   * and are served by the best-fit large pool.
+   */
+  size_t RoundToSizeClass(size_t size) const {
+    if (size > kSizeClassThreshold) {
+      return ((size + page_size_ - 1) / page_size_) * page_size_;
+    }
+    size_t quantum = page_size_;
+    while (quantum * 8 < size) quantum *= 2;
+    return ((size + quantum - 1) / quantum) * quantum;
+  }
+
  protected:
   size_t page_size_;
   std::atomic<size_t> used_memory_;
-  std::unordered_map<size_t, std::vector<Buffer>> memory_pool_;
+  /*! \brief Free lists of the size-class tier, keyed by the class byte size. */
+  std::unordered_map<size_t, std::vector<Buffer>> size_class_pool_;
+  /*! \brief Free buffers above kSizeClassThreshold, ordered for best-fit lookup. */
+  std::multimap<size_t, Buffer> large_pool_;
   std::recursive_mutex mu_;
 };
 
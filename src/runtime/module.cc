@@ -27,10 +27,14 @@
 #include <tvm/runtime/c_backend_api.h>
 #include <tvm/runtime/device_api.h>
 
+#include <cstdlib>
 #include <cstring>
+#include <limits>
+#include <string>
 #include <unordered_set>
 
 #include "file_utils.h"
+#include "threading_backend.h"
 
 namespace tvm {
 namespace runtime {
@@ -68,6 +72,58 @@ bool RuntimeEnabled(const ffi::String& target_str) {
   return tvm::ffi::Function::GetGlobal(f_name).has_value();
 }
 
+/*!
+ * \brief Select among cache-blocking variants of a compiled function.
+ *
+ * Multi-versioned kernels are compiled as several PrimFuncs that differ only
+ * in their blocking, each named with a "__cache_<bytes>" suffix giving the
+ * per-core working-set footprint the blocking was tuned for.  At module init
+ * the caller passes the variant symbols; the variant with the largest
+ * footprint that still fits the detected cache of the requested level is
+ * bound, so one artifact adapts to the cache topology it runs on.  Names
+ * without the suffix are treated as a baseline with zero footprint, and when
+ * the platform does not expose its cache topology the baseline (or the
+ * smallest variant) is chosen.
+ */
+ffi::Function SelectCacheBlockingVariant(ffi::Module mod, ffi::Array<ffi::String> variants,
+                                         int cache_level) {
+  static constexpr const char* kFootprintTag = "__cache_";
+  int64_t cache_size = threading::DataCacheSize(cache_level);
+  ffi::Optional<ffi::Function> best;
+  int64_t best_footprint = -1;
+  ffi::Optional<ffi::Function> smallest;
+  int64_t smallest_footprint = std::numeric_limits<int64_t>::max();
+  for (const ffi::String& name : variants) {
+    ffi::Optional<ffi::Function> func = mod->GetFunction(name, true);
+    if (!func.has_value()) {
+      continue;
+    }
+    std::string symbol = name;
+    size_t pos = symbol.rfind(kFootprintTag);
+    int64_t footprint = 0;
+    if (pos != std::string::npos) {
+      footprint = std::strtoll(symbol.c_str() + pos + std::strlen(kFootprintTag), nullptr, 10);
+    }
+    if (footprint < smallest_footprint) {
+      smallest_footprint = footprint;
+      smallest = func;
+    }
+    if (footprint <= std::max<int64_t>(cache_size, 0) && footprint > best_footprint) {
+      best_footprint = footprint;
+      best = func;
+    }
+  }
+  // When every variant overflows the detected cache, the smallest one
+  // thrashes the least.
+  if (!best.has_value()) {
+    best = smallest;
+  }
+  if (!best.has_value()) {
+    TVM_FFI_THROW(ValueError) << "None of the candidate variants could be resolved in the module";
+  }
+  return best.value();
+}
+
 #define TVM_INIT_CONTEXT_FUNC(FuncName) \
   TVM_FFI_CHECK_SAFE_CALL(              \
       TVMFFIEnvModRegisterContextSymbol("__" #FuncName, reinterpret_cast<void*>(FuncName)))
@@ -84,7 +140,9 @@ TVM_FFI_STATIC_INIT_BLOCK() {
   TVM_INIT_CONTEXT_FUNC(TVMBackendParallelLaunch);
   TVM_INIT_CONTEXT_FUNC(TVMBackendParallelBarrier);
 
-  refl::GlobalDef().def("runtime.RuntimeEnabled", RuntimeEnabled);
+  refl::GlobalDef()
+      .def("runtime.RuntimeEnabled", RuntimeEnabled)
+      .def("runtime.SelectCacheBlockingVariant", SelectCacheBlockingVariant);
 }
 
 #undef TVM_INIT_CONTEXT_FUNC
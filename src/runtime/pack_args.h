@@ -35,6 +35,8 @@
 #include <tvm/runtime/base.h>
 
 #include <cstring>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 #include "metadata.h"
@@ -74,6 +76,28 @@ union ArgUnion64 {
 template <typename F>
 inline ffi::Function PackFuncVoidAddr(F f, const ffi::Array<DLDataType>& arg_types,
                                       const ffi::Array<ArgExtraTags>& arg_extra_tags = {});
+/*!
+ * \brief Create a packed function from void addr types, memoizing the packed
+ *  argument buffer across calls.
+ *
+ * Serving workloads invoke the same kernel with a byte-identical argument
+ * list on every call; repacking it each time is pure per-launch overhead.
+ * The wrapper keeps the previous raw arguments and the packed address array
+ * in stable storage: a call whose arguments compare equal reuses the buffer
+ * outright, and any change (for example a shape argument after rebinding)
+ * rebuilds it.  The cache is guarded by a mutex, so the wrapped function
+ * stays safe to call from multiple threads.
+ *
+ * \param f with signiture (ffi::PackedArgs args, ffi::Any* rv, void* void_args)
+ * \param arg_types The arguments type information.
+ * \param arg_extra_tags extra tags for the arguments
+ * \tparam F the function type
+ *
+ * \return The wrapped packed function.
+ */
+template <typename F>
+inline ffi::Function PackFuncVoidAddrCached(F f, const ffi::Array<DLDataType>& arg_types,
+                                            const ffi::Array<ArgExtraTags>& arg_extra_tags = {});
 /*!
  * \brief Create a packed function that from function only packs buffer arguments.
  *
@@ -200,6 +224,68 @@ inline ffi::Function PackFuncVoidAddr_(F f, const std::vector<ArgConvertCode>& c
   return ffi::Function(ret);
 }
 
+template <typename F>
+inline ffi::Function PackFuncVoidAddrCached_(F f, const std::vector<ArgConvertCode>& codes) {
+  // Stable storage shared by all invocations of the returned function.  The
+  // by-address entries of addr point into stable_args/holder rather than the
+  // caller's argument stack, so the packed buffer stays valid across calls.
+  struct Cache {
+    std::mutex mutex;
+    bool valid{false};
+    std::vector<TVMFFIAny> prev_args;
+    std::vector<TVMFFIAny> stable_args;
+    std::vector<ArgUnion32> holder;
+    std::vector<void*> addr;
+  };
+  int num_args = static_cast<int>(codes.size());
+  auto cache = std::make_shared<Cache>();
+  cache->prev_args.resize(num_args);
+  cache->stable_args.resize(num_args);
+  cache->holder.resize(num_args);
+  cache->addr.resize(num_args);
+  auto ret = [f, codes, num_args, cache](ffi::PackedArgs args, ffi::Any* ret) {
+    const TVMFFIAny* raw_args = reinterpret_cast<const TVMFFIAny*>(args.data());
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    if (!cache->valid ||
+        std::memcmp(cache->prev_args.data(), raw_args, num_args * sizeof(TVMFFIAny)) != 0) {
+      std::memcpy(cache->prev_args.data(), raw_args, num_args * sizeof(TVMFFIAny));
+      for (int i = 0; i < num_args; ++i) {
+        switch (codes[i]) {
+          case INT64_TO_INT64:
+          case FLOAT64_TO_FLOAT64:
+          case HANDLE_TO_HANDLE: {
+            cache->stable_args[i] = raw_args[i];
+            cache->addr[i] = (void*)&(cache->stable_args[i].v_ptr);  // NOLINT(*)
+            break;
+          }
+          case INT64_TO_INT32: {
+            cache->holder[i].v_int32 = static_cast<int32_t>(raw_args[i].v_int64);
+            cache->addr[i] = &(cache->holder[i]);
+            break;
+          }
+          case INT64_TO_UINT32: {
+            cache->holder[i].v_uint32 = static_cast<uint32_t>(raw_args[i].v_int64);
+            cache->addr[i] = &(cache->holder[i]);
+            break;
+          }
+          case FLOAT64_TO_FLOAT32: {
+            cache->holder[i].v_float32 = static_cast<float>(raw_args[i].v_float64);
+            cache->addr[i] = &(cache->holder[i]);
+            break;
+          }
+          case HANDLE_TO_TENSORMAP: {
+            cache->addr[i] = raw_args[i].v_ptr;
+            break;
+          }
+        }
+      }
+      cache->valid = true;
+    }
+    f(args, ret, cache->addr.data());
+  };
+  return ffi::Function(ret);
+}
+
 template <int N, typename F>
 inline ffi::Function PackFuncNonBufferArg_(F f, int base,
                                            const std::vector<ArgConvertCode>& codes) {
@@ -330,6 +416,20 @@ inline ffi::Function PackFuncVoidAddr(F f, const ffi::Array<DLDataType>& arg_typ
   }
 }
 
+template <typename F>
+inline ffi::Function PackFuncVoidAddrCached(F f, const ffi::Array<DLDataType>& arg_types,
+                                            const ffi::Array<ArgExtraTags>& arg_extra_tags) {
+  std::vector<detail::ArgConvertCode> codes(arg_types.size());
+  for (size_t i = 0; i < arg_types.size(); ++i) {
+    if (arg_extra_tags.size() > i && arg_extra_tags[i] == ArgExtraTags::kTensorMap) {
+      codes[i] = detail::HANDLE_TO_TENSORMAP;
+    } else {
+      codes[i] = detail::GetArgConvertCode(arg_types[i]);
+    }
+  }
+  return detail::PackFuncVoidAddrCached_(f, codes);
+}
+
 inline size_t NumBufferArgs(const ffi::Array<DLDataType>& arg_types) {
   size_t base = arg_types.size();
   for (size_t i = 0; i < arg_types.size(); ++i) {
@@ -40,11 +40,23 @@
 #include "../../support/arena.h"
 #include "rpc_reference.h"
 
+/*!
+ * \brief Size in bytes of the fixed arena used by details::StaticPageAllocator.
+ *
+ *  The arena is recycled between packets, so it only needs to hold the peak
+ *  working set of a single request (read buffer plus decoded arguments).
+ */
+#ifndef TVM_MINRPC_STATIC_ARENA_BYTES
+#define TVM_MINRPC_STATIC_ARENA_BYTES (16 << 10)
+#endif
+
 namespace tvm {
 namespace runtime {
 namespace details {
 template <typename TIOHandler>
 class PageAllocator;
+template <typename TIOHandler>
+class StaticPageAllocator;
 }  // namespace details
 /*!
  * \brief A minimum RPC server that only depends on the tvm C runtime..
@@ -56,6 +68,11 @@ class PageAllocator;
  *         - PosixWrite, PosixRead, Close: posix style, read, write, close API.
  *         - MessageStart(num_bytes), MessageDone(): framing APIs.
  *         - Exit: exit with status code.
+ * \tparam Allocator The page allocator backing the per-packet arena.
+ *         Defaults to details::PageAllocator, which mallocs pages on demand.
+ *         Bare-metal deployments can instantiate the server with
+ *         details::StaticPageAllocator instead to serve every request out of
+ *         a fixed buffer with no heap allocation in steady state.
  */
 template <typename TIOHandler, template <typename> class Allocator = details::PageAllocator>
 class MinRPCServer {
@@ -193,6 +210,52 @@ class PageAllocator {
  private:
   TIOHandler* io_;
 };
+
+/*!
+ * \brief Allocator that carves arena pages out of a fixed in-object buffer.
+ *
+ *  Pages are handed out bump-pointer style from a buffer whose size is set at
+ *  compile time via TVM_MINRPC_STATIC_ARENA_BYTES, and the arena's per-packet
+ *  RecycleAll keeps reusing the same pages, so after the first request the
+ *  server performs no allocation at all. A request whose working set exceeds
+ *  the buffer exits with kAllocError, just like the malloc path on OOM.
+ */
+template <typename TIOHandler>
+class StaticPageAllocator {
+ public:
+  using ArenaPageHeader = tvm::support::ArenaPageHeader;
+
+  explicit StaticPageAllocator(TIOHandler* io) : io_(io) {}
+
+  ArenaPageHeader* allocate(size_t min_size) {
+    size_t npages = ((min_size + kPageSize - 1) / kPageSize);
+    size_t nbytes = npages * kPageSize;
+
+    if (used_ + nbytes > sizeof(buffer_)) {
+      io_->Exit(static_cast<int>(RPCServerStatus::kAllocError));
+    }
+
+    ArenaPageHeader* header = reinterpret_cast<ArenaPageHeader*>(buffer_ + used_);
+    used_ += nbytes;
+    header->size = nbytes;
+    header->offset = sizeof(ArenaPageHeader);
+    return header;
+  }
+
+  // The storage is part of the allocator; FreeAll on shutdown has nothing
+  // to release. Recycled pages are reused through the arena's free list.
+  void deallocate(ArenaPageHeader* page) {}
+
+  static const constexpr int kPageSize = 2 << 10;
+  static const constexpr int kPageAlign = 8;
+
+ private:
+  TIOHandler* io_;
+  /*! \brief bytes of buffer_ already carved into pages. */
+  size_t used_{0};
+  /*! \brief backing storage for all pages. */
+  alignas(kPageAlign) char buffer_[TVM_MINRPC_STATIC_ARENA_BYTES];
+};
 }  // namespace details
 
 }  // namespace runtime
@@ -0,0 +1,264 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file rpc_async_server.cc
+ * \brief Single-threaded multi-connection RPC server based on epoll.
+ *
+ *  The blocking socket server spends one thread per connection; a tracker
+ *  host serving hundreds of tuning sessions burns most of its cores in
+ *  blocked reads. This server instead drives every connection through
+ *  RPCEndpoint::ServerAsyncIOEventHandler from a single epoll loop, so one
+ *  thread multiplexes all sessions. Linux only; other platforms keep using
+ *  rpc.ServerLoop.
+ */
+#if defined(__linux__)
+
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#include <tvm/ffi/function.h>
+#include <tvm/ffi/reflection/registry.h>
+
+#include <cerrno>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../../support/socket.h"
+#include "rpc_channel.h"
+#include "rpc_endpoint.h"
+
+namespace tvm {
+namespace runtime {
+
+/*!
+ * \brief Event loop serving many RPC sessions from one thread.
+ *
+ *  Connection sockets are non-blocking; bytes the endpoint produces faster
+ *  than the kernel accepts are parked in a per-connection output buffer and
+ *  flushed when epoll reports the socket writable, so one slow client never
+ *  stalls the loop.
+ */
+class AsyncRPCServer {
+ public:
+  AsyncRPCServer(const std::string& host, int port, std::string key) : key_(std::move(key)) {
+    support::SockAddr addr(host.c_str(), port);
+    listen_sock_.Create(addr.ss_family());
+    listen_sock_.Bind(addr);
+    listen_sock_.Listen(128);
+    epfd_ = epoll_create1(0);
+    TVM_FFI_ICHECK_NE(epfd_, -1) << "AsyncRPCServer: epoll_create1 failed";
+    epoll_event ev;
+    ev.events = EPOLLIN;
+    ev.data.fd = listen_sock_.sockfd;
+    TVM_FFI_ICHECK_NE(epoll_ctl(epfd_, EPOLL_CTL_ADD, listen_sock_.sockfd, &ev), -1)
+        << "AsyncRPCServer: epoll_ctl failed";
+  }
+
+  ~AsyncRPCServer() {
+    for (auto& kv : connections_) {
+      kv.second->sock.Close();
+    }
+    close(epfd_);
+    listen_sock_.Close();
+  }
+
+  /*! \brief Serve connections until the process exits. */
+  void Run() {
+    std::vector<epoll_event> events(128);
+    while (true) {
+      int num_events = epoll_wait(epfd_, events.data(), static_cast<int>(events.size()), -1);
+      if (num_events == -1) {
+        if (errno == EINTR) continue;
+        support::Socket::Error("epoll_wait");
+      }
+      for (int i = 0; i < num_events; ++i) {
+        if (events[i].data.fd == listen_sock_.sockfd) {
+          this->HandleAccept();
+          continue;
+        }
+        auto it = connections_.find(events[i].data.fd);
+        if (it == connections_.end()) continue;
+        Connection* conn = it->second.get();
+        if ((events[i].events & (EPOLLHUP | EPOLLERR)) != 0) {
+          this->CloseConnection(conn);
+        } else if ((events[i].events & EPOLLOUT) != 0) {
+          this->HandleWritable(conn);
+        } else if ((events[i].events & EPOLLIN) != 0) {
+          this->HandleReadable(conn);
+        }
+      }
+    }
+  }
+
+ private:
+  struct Connection {
+    support::TCPSocket sock;
+    std::shared_ptr<RPCEndpoint> endpoint;
+    /*! \brief Bytes produced by the endpoint, not yet accepted by the kernel. */
+    std::string out_buffer;
+    /*! \brief Whether EPOLLOUT is currently registered for this socket. */
+    bool want_write{false};
+    /*! \brief Set on a hard send error; closed once the endpoint unwinds. */
+    bool broken{false};
+  };
+
+  void HandleAccept() {
+    // The listen socket stays blocking; level-triggered epoll reports it
+    // again when further connections are pending, so accept one per event.
+    support::TCPSocket sock = listen_sock_.Accept();
+    // The handshake is a handful of bytes; run it blocking before handing
+    // the socket to the event loop.
+    int code;
+    if (sock.RecvAll(&code, sizeof(code)) != sizeof(code) || code != kRPCMagic) {
+      sock.Close();
+      return;
+    }
+    int keylen;
+    if (sock.RecvAll(&keylen, sizeof(keylen)) != sizeof(keylen)) {
+      sock.Close();
+      return;
+    }
+    std::string remote_key;
+    if (keylen != 0) {
+      remote_key.resize(keylen);
+      if (sock.RecvAll(&remote_key[0], keylen) != keylen) {
+        sock.Close();
+        return;
+      }
+    }
+    std::string server_key = "server:" + key_;
+    keylen = static_cast<int>(server_key.length());
+    sock.SendAll(&code, sizeof(code));
+    sock.SendAll(&keylen, sizeof(keylen));
+    sock.SendAll(server_key.c_str(), keylen);
+    sock.SetNonBlock(true);
+
+    auto conn = std::make_unique<Connection>();
+    Connection* raw = conn.get();
+    raw->sock = sock;
+    // The endpoint writes through this callback; the event loop owns the
+    // socket, so sends are buffered and flushed as the kernel allows.
+    auto fsend = ffi::Function::FromTyped([this, raw](TVMFFIByteArray* bytes) -> int64_t {
+      raw->out_buffer.append(bytes->data, bytes->size);
+      this->TryFlush(raw);
+      return static_cast<int64_t>(bytes->size);
+    });
+    static ffi::Function frecv([](ffi::PackedArgs args, ffi::Any* rv) {
+      TVM_FFI_THROW(InternalError) << "Do not allow explicit receive";
+    });
+    raw->endpoint = RPCEndpoint::Create(std::make_unique<CallbackChannel>(fsend, frecv),
+                                        "AsyncRPCServer", remote_key);
+    epoll_event ev;
+    ev.events = EPOLLIN;
+    ev.data.fd = sock.sockfd;
+    if (epoll_ctl(epfd_, EPOLL_CTL_ADD, sock.sockfd, &ev) == -1) {
+      sock.Close();
+      return;
+    }
+    connections_[sock.sockfd] = std::move(conn);
+  }
+
+  void HandleReadable(Connection* conn) {
+    char buffer[kReadChunkBytes];
+    ssize_t nread = conn->sock.Recv(buffer, sizeof(buffer));
+    if (nread == -1) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) return;
+      this->CloseConnection(conn);
+      return;
+    }
+    if (nread == 0) {
+      this->CloseConnection(conn);
+      return;
+    }
+    int status = conn->endpoint->ServerAsyncIOEventHandler(std::string(buffer, nread), 3);
+    while (status == 2 && !conn->broken) {
+      status = conn->endpoint->ServerAsyncIOEventHandler("", 2);
+    }
+    if (status == 0 || conn->broken) {
+      this->CloseConnection(conn);
+    }
+  }
+
+  void HandleWritable(Connection* conn) {
+    this->TryFlush(conn);
+    if (conn->broken) {
+      this->CloseConnection(conn);
+    }
+  }
+
+  // Flush as much buffered output as the kernel accepts. May be called from
+  // inside the endpoint's handler, so hard errors only mark the connection
+  // broken; the event loop closes it after the handler unwinds.
+  void TryFlush(Connection* conn) {
+    while (!conn->out_buffer.empty()) {
+      ssize_t nsent = conn->sock.Send(conn->out_buffer.data(), conn->out_buffer.size());
+      if (nsent == -1) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+        conn->broken = true;
+        conn->out_buffer.clear();
+        return;
+      }
+      conn->out_buffer.erase(0, nsent);
+    }
+    this->UpdateWriteInterest(conn, !conn->out_buffer.empty());
+  }
+
+  void UpdateWriteInterest(Connection* conn, bool want_write) {
+    if (conn->want_write == want_write) return;
+    conn->want_write = want_write;
+    epoll_event ev;
+    ev.events = EPOLLIN | (want_write ? EPOLLOUT : 0);
+    ev.data.fd = conn->sock.sockfd;
+    epoll_ctl(epfd_, EPOLL_CTL_MOD, conn->sock.sockfd, &ev);
+  }
+
+  void CloseConnection(Connection* conn) {
+    int fd = conn->sock.sockfd;
+    epoll_ctl(epfd_, EPOLL_CTL_DEL, fd, nullptr);
+    conn->sock.Close();
+    connections_.erase(fd);
+  }
+
+  static constexpr size_t kReadChunkBytes = 64 << 10;
+
+  /*! \brief The key reported back to connecting clients. */
+  std::string key_;
+  support::TCPSocket listen_sock_{support::TCPSocket::SockType(-1)};
+  int epfd_{-1};
+  std::unordered_map<int, std::unique_ptr<Connection>> connections_;
+};
+
+void AsyncServerLoop(std::string host, int port, std::string key) {
+  AsyncRPCServer server(host, port, key);
+  server.Run();
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("rpc.AsyncServerLoop", AsyncServerLoop);
+}
+
+}  // namespace runtime
+}  // namespace tvm
+
+#endif  // defined(__linux__)
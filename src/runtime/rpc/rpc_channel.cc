@@ -24,6 +24,8 @@
 
 #include <tvm/ffi/error.h>
 
+#include <algorithm>
+#include <cstring>
 #include <string>
 
 namespace tvm {
@@ -51,5 +53,145 @@ size_t CallbackChannel::Recv(void* data, size_t size) {
   return bytes.size();
 }
 
+// Wire format of one frame: the header is followed by nbytes of payload when
+// nbytes > 0. A negative nbytes carries no payload and instead grants -nbytes
+// bytes of send credit for the stream.
+struct MuxFrameHeader {
+  uint32_t stream_id;
+  int32_t nbytes;
+};
+
+/*! \brief Channel view of a single stream, routing through the multiplexer. */
+class MuxStreamChannel final : public RPCChannel {
+ public:
+  MuxStreamChannel(std::shared_ptr<ChannelMultiplexer> mux, uint32_t stream_id)
+      : mux_(std::move(mux)), stream_id_(stream_id) {}
+
+  size_t Send(const void* data, size_t size) final {
+    return mux_->StreamSend(stream_id_, data, size);
+  }
+
+  size_t Recv(void* data, size_t size) final {
+    return mux_->StreamRecv(stream_id_, data, size);
+  }
+
+ private:
+  std::shared_ptr<ChannelMultiplexer> mux_;
+  uint32_t stream_id_;
+};
+
+std::unique_ptr<RPCChannel> ChannelMultiplexer::OpenStream(uint32_t stream_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // Make sure the entry exists before the peer's frames start arriving.
+  streams_[stream_id];
+  return std::make_unique<MuxStreamChannel>(shared_from_this(), stream_id);
+}
+
+void ChannelMultiplexer::SendAllUnderlying(const void* data, size_t size) {
+  const char* buf = static_cast<const char*>(data);
+  while (size != 0) {
+    size_t n = underlying_->Send(buf, size);
+    if (n == 0) {
+      TVM_FFI_THROW(InternalError) << "ChannelMultiplexer: connection closed during send";
+    }
+    buf += n;
+    size -= n;
+  }
+}
+
+void ChannelMultiplexer::RecvAllUnderlying(void* data, size_t size) {
+  char* buf = static_cast<char*>(data);
+  while (size != 0) {
+    size_t n = underlying_->Recv(buf, size);
+    if (n == 0) {
+      TVM_FFI_THROW(InternalError) << "ChannelMultiplexer: connection closed during recv";
+    }
+    buf += n;
+    size -= n;
+  }
+}
+
+void ChannelMultiplexer::SendFrame(uint32_t stream_id, int32_t nbytes, const void* data) {
+  std::lock_guard<std::mutex> lock(send_mutex_);
+  MuxFrameHeader header{stream_id, nbytes};
+  SendAllUnderlying(&header, sizeof(header));
+  if (nbytes > 0) {
+    SendAllUnderlying(data, static_cast<size_t>(nbytes));
+  }
+}
+
+void ChannelMultiplexer::PumpOneFrame(std::unique_lock<std::mutex>& lock) {
+  if (pumping_) {
+    // Another thread is already blocked on the underlying channel; wait for
+    // the frame it delivers.
+    cv_.wait(lock);
+    return;
+  }
+  pumping_ = true;
+  lock.unlock();
+  MuxFrameHeader header;
+  std::string payload;
+  RecvAllUnderlying(&header, sizeof(header));
+  if (header.nbytes > 0) {
+    payload.resize(static_cast<size_t>(header.nbytes));
+    RecvAllUnderlying(&payload[0], payload.size());
+  }
+  lock.lock();
+  Stream& stream = streams_[header.stream_id];
+  if (header.nbytes >= 0) {
+    stream.recv_buffer.append(payload);
+  } else {
+    stream.send_window += static_cast<size_t>(-static_cast<int64_t>(header.nbytes));
+  }
+  pumping_ = false;
+  cv_.notify_all();
+}
+
+size_t ChannelMultiplexer::StreamSend(uint32_t stream_id, const void* data, size_t size) {
+  const char* buf = static_cast<const char*>(data);
+  size_t total = 0;
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (total < size) {
+    Stream& stream = streams_[stream_id];
+    if (stream.send_window == 0) {
+      // The window refills through frames from the peer, so a blocked sender
+      // must keep draining the channel itself.
+      PumpOneFrame(lock);
+      continue;
+    }
+    size_t chunk = std::min({size - total, stream.send_window, kMaxFrameBytes});
+    stream.send_window -= chunk;
+    // Release the locks between chunks so other streams' frames interleave.
+    lock.unlock();
+    SendFrame(stream_id, static_cast<int32_t>(chunk), buf + total);
+    total += chunk;
+    lock.lock();
+  }
+  return total;
+}
+
+size_t ChannelMultiplexer::StreamRecv(uint32_t stream_id, void* data, size_t size) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  Stream& stream = streams_[stream_id];
+  while (stream.recv_buffer.empty()) {
+    PumpOneFrame(lock);
+  }
+  size_t n = std::min(size, stream.recv_buffer.size());
+  std::memcpy(data, stream.recv_buffer.data(), n);
+  stream.recv_buffer.erase(0, n);
+  stream.consumed += n;
+  // Return credit in batches to keep window updates off the fast path.
+  size_t grant = 0;
+  if (stream.consumed >= kInitialWindowBytes / 2) {
+    grant = stream.consumed;
+    stream.consumed = 0;
+  }
+  lock.unlock();
+  if (grant != 0) {
+    SendFrame(stream_id, -static_cast<int32_t>(grant), nullptr);
+  }
+  return n;
+}
+
 }  // namespace runtime
 }  // namespace tvm
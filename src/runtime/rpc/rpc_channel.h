@@ -26,6 +26,12 @@
 
 #include <tvm/ffi/function.h>
 
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <utility>
 
 namespace tvm {
@@ -94,6 +100,73 @@ class CallbackChannel final : public RPCChannel {
   ffi::Function frecv_;
 };
 
+/*!
+ * \brief Shares one underlying channel between several logical streams.
+ *
+ *  Each frame on the wire carries a stream id and a payload length, so
+ *  independent endpoints can talk over a single connection. Every stream has
+ *  its own flow-control window: a sender blocks once its window is exhausted
+ *  and the receiver grants credit back as the application consumes data.
+ *  Large transfers are chunked to kMaxFrameBytes, so a bulk copy on one
+ *  stream cannot head-of-line block control messages on another.
+ *
+ *  Both peers must wrap their connection in a multiplexer and agree on the
+ *  stream ids. The multiplexer must be owned by a std::shared_ptr; the
+ *  channels returned by OpenStream keep it alive.
+ */
+class ChannelMultiplexer : public std::enable_shared_from_this<ChannelMultiplexer> {
+ public:
+  /*!
+   * \brief Constructor.
+   * \param underlying The connection the streams share.
+   */
+  explicit ChannelMultiplexer(std::unique_ptr<RPCChannel> underlying)
+      : underlying_(std::move(underlying)) {}
+
+  /*!
+   * \brief Open a logical stream over the shared connection.
+   * \param stream_id The stream identifier; both sides use the same id for
+   *        the same logical stream.
+   * \return A channel that sends and receives only this stream's frames.
+   */
+  std::unique_ptr<RPCChannel> OpenStream(uint32_t stream_id);
+
+ private:
+  friend class MuxStreamChannel;
+  /*! \brief Per-stream bookkeeping. */
+  struct Stream {
+    /*! \brief Bytes received but not yet consumed by the application. */
+    std::string recv_buffer;
+    /*! \brief Send credit left before the peer must grant more. */
+    size_t send_window{kInitialWindowBytes};
+    /*! \brief Bytes consumed since the last window update we granted. */
+    size_t consumed{0};
+  };
+  size_t StreamSend(uint32_t stream_id, const void* data, size_t size);
+  size_t StreamRecv(uint32_t stream_id, void* data, size_t size);
+  /*! \brief Read one frame from the underlying channel and apply it. */
+  void PumpOneFrame(std::unique_lock<std::mutex>& lock);
+  void SendFrame(uint32_t stream_id, int32_t nbytes, const void* data);
+  void SendAllUnderlying(const void* data, size_t size);
+  void RecvAllUnderlying(void* data, size_t size);
+
+  /*! \brief Initial (and maximum) per-stream flow-control window. */
+  static constexpr size_t kInitialWindowBytes = 1 << 20;
+  /*! \brief Largest payload carried by a single frame. */
+  static constexpr size_t kMaxFrameBytes = 64 << 10;
+
+  /*! \brief The shared connection. */
+  std::unique_ptr<RPCChannel> underlying_;
+  /*! \brief Serializes writes so frames are never interleaved. */
+  std::mutex send_mutex_;
+  /*! \brief Guards the stream table; cv signals new data or credit. */
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  /*! \brief Whether some thread is currently reading a frame. */
+  bool pumping_{false};
+  std::unordered_map<uint32_t, Stream> streams_;
+};
+
 }  // namespace runtime
 }  // namespace tvm
 #endif  // TVM_RUNTIME_RPC_RPC_CHANNEL_H_
@@ -47,6 +47,12 @@
 namespace tvm {
 namespace runtime {
 
+/*!
+ * \brief Payload size above which remote-copy bodies are sent directly from
+ *  the source buffer instead of being staged through the writer ring buffer.
+ */
+constexpr uint64_t kDirectTransferThreshold = 64 << 10;
+
 /*!
  * Event-driven state-machine based handlers for RPCEndpoint.
  *
@@ -916,6 +922,32 @@ void RPCEndpoint::CallFunc(RPCSession::PackedFuncHandle h, ffi::PackedArgs args,
   TVM_FFI_ICHECK(code == RPCCode::kReturn) << "code=" << RPCCodeToString(code);
 }
 
+void RPCEndpoint::CallFuncPipelined(const std::vector<RPCSession::PipelinedCall>& calls) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  // Queue every request packet in the write buffer before waiting on any
+  // reply; the first HandleUntilReturnEvent flushes them back to back, so the
+  // batch costs a single round trip on a latency-bound channel.
+  for (const RPCSession::PipelinedCall& call : calls) {
+    handler_->ValidateArguments(call.args);
+    RPCCode code = RPCCode::kCallFunc;
+    uint64_t handle = reinterpret_cast<uint64_t>(call.func);
+
+    uint64_t packet_nbytes =
+        sizeof(code) + sizeof(handle) +
+        handler_->PackedSeqGetNumBytes(call.args.data(), call.args.size(), true);
+
+    handler_->Write(packet_nbytes);
+    handler_->Write(code);
+    handler_->Write(handle);
+    handler_->SendPackedSeq(call.args.data(), call.args.size(), true);
+  }
+  for (const RPCSession::PipelinedCall& call : calls) {
+    RPCCode code = HandleUntilReturnEvent(true, call.encode_return);
+    TVM_FFI_ICHECK(code == RPCCode::kReturn) << "code=" << RPCCodeToString(code);
+  }
+}
+
 void RPCEndpoint::CopyToRemote(void* from_bytes, DLTensor* to, uint64_t nbytes) {
   std::lock_guard<std::mutex> lock(mutex_);
   RPCCode code = RPCCode::kCopyToRemote;
@@ -932,7 +964,24 @@ void RPCEndpoint::CopyToRemote(void* from_bytes, DLTensor* to, uint64_t nbytes)
   handler_->Write(code);
   RPCReference::SendDLTensor(handler_, to);
   handler_->Write(nbytes);
-  handler_->WriteArray(reinterpret_cast<char*>(from_bytes), nbytes);
+  if (nbytes >= kDirectTransferThreshold) {
+    // Large payloads skip the ring-buffer staging copy: flush the queued
+    // packet header, then stream the body straight from the source buffer.
+    while (writer_.bytes_available() != 0) {
+      writer_.ReadWithCallback(
+          [this](const void* data, size_t size) { return channel_->Send(data, size); },
+          writer_.bytes_available());
+    }
+    const char* data = reinterpret_cast<const char*>(from_bytes);
+    uint64_t remaining = nbytes;
+    while (remaining != 0) {
+      size_t n = channel_->Send(data, remaining);
+      data += n;
+      remaining -= n;
+    }
+  } else {
+    handler_->WriteArray(reinterpret_cast<char*>(from_bytes), nbytes);
+  }
   TVM_FFI_ICHECK(HandleUntilReturnEvent(true, [](ffi::PackedArgs) {}) == RPCCode::kReturn);
 }
 
@@ -1126,6 +1175,10 @@ class RPCClientSession : public RPCSession, public DeviceAPI {
     endpoint_->CallFunc(func, args, fencode_return);
   }
 
+  void CallFuncPipelined(const std::vector<PipelinedCall>& calls) final {
+    endpoint_->CallFuncPipelined(calls);
+  }
+
   void CopyToRemote(void* local_from_bytes, DLTensor* remote_to, uint64_t nbytes) final {
     RPCCode code = RPCCode::kCopyToRemote;
     uint64_t overhead = RemoteCopyCalculatePacketOverheadSize(remote_to, code, nbytes);
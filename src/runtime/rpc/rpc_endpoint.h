@@ -137,6 +137,16 @@ class RPCEndpoint {
    */
   void CallFunc(RPCSession::PackedFuncHandle handle, ffi::PackedArgs args,
                 RPCSession::FEncodeReturn encode_return);
+  /*!
+   * \brief Call several remote functions in one pipelined round trip.
+   *
+   * All request packets are queued before waiting for any reply. The channel
+   * is ordered and the server answers requests sequentially, so replies are
+   * correlated with requests by position.
+   *
+   * \param calls The batch of calls.
+   */
+  void CallFuncPipelined(const std::vector<RPCSession::PipelinedCall>& calls);
   /*!
    * \brief Copy bytes into remote array content.
    * \param from The source host data.
@@ -31,6 +31,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "minrpc/rpc_reference.h"
 
@@ -133,6 +134,33 @@ class RPCSession {
   virtual void CallFunc(PackedFuncHandle func, ffi::PackedArgs args,
                         const FEncodeReturn& fencode_return) = 0;
 
+  /*! \brief One call of a pipelined batch issued through CallFuncPipelined. */
+  struct PipelinedCall {
+    /*! \brief The function handle. */
+    PackedFuncHandle func;
+    /*! \brief The input packed arguments. */
+    ffi::PackedArgs args;
+    /*! \brief The function to set the return value of this call. */
+    FEncodeReturn encode_return;
+  };
+
+  /*!
+   * \brief Issue several independent calls in one pipelined round trip.
+   *
+   * Each entry follows the CallFunc convention. Sessions backed by a
+   * latency-bound channel override this to queue all the request packets
+   * before waiting for any reply, so N independent calls cost one round trip
+   * instead of N. The default implementation simply calls CallFunc in order.
+   *
+   * \param calls The batch of calls; the encode_return callbacks are invoked
+   *              in the order of the entries.
+   */
+  virtual void CallFuncPipelined(const std::vector<PipelinedCall>& calls) {
+    for (const PipelinedCall& call : calls) {
+      this->CallFunc(call.func, call.args, call.encode_return);
+    }
+  }
+
   /*!
    * \brief Copy bytes into remote array content.
    * \param local_from_bytes The source host data.
@@ -73,15 +73,15 @@ std::shared_ptr<RPCEndpoint> RPCConnect(std::string url, int port, std::string k
   support::SockAddr addr(url.c_str(), port);
   sock.Create(addr.ss_family());
   TVM_FFI_ICHECK(sock.Connect(addr)) << "Connect to " << addr.AsString() << " failed";
+  // RPC messages are small and latency sensitive; do not let Nagle hold them.
+  sock.SetNoDelay(true);
   // hand shake
   std::ostringstream os;
   int code = kRPCMagic;
   int keylen = static_cast<int>(key.length());
-  TVM_FFI_ICHECK_EQ(sock.SendAll(&code, sizeof(code)), sizeof(code));
-  TVM_FFI_ICHECK_EQ(sock.SendAll(&keylen, sizeof(keylen)), sizeof(keylen));
-  if (keylen != 0) {
-    TVM_FFI_ICHECK_EQ(sock.SendAll(key.c_str(), keylen), keylen);
-  }
+  support::TCPSocket::ConstBuffer handshake[] = {
+      {&code, sizeof(code)}, {&keylen, sizeof(keylen)}, {key.c_str(), key.length()}};
+  TVM_FFI_ICHECK_EQ(sock.SendAllVec(handshake, 3), sizeof(code) + sizeof(keylen) + key.length());
   TVM_FFI_ICHECK_EQ(sock.RecvAll(&code, sizeof(code)), sizeof(code));
   if (code == kRPCMagic + 2) {
     sock.Close();
@@ -118,6 +118,7 @@ ffi::Module RPCClientConnect(std::string url, int port, std::string key, bool en
 // TVM_RUNTIME_DLL needed for MSVC
 TVM_RUNTIME_DLL void RPCServerLoop(int sockfd) {
   support::TCPSocket sock(static_cast<support::TCPSocket::SockType>(sockfd));
+  sock.SetNoDelay(true);
   RPCEndpoint::Create(std::make_unique<SockChannel>(sock), "SockServerLoop", "")->ServerLoop();
 }
 
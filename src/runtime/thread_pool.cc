@@ -41,8 +41,20 @@
 #include <sstream>
 #include <string>
 #include <thread>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define TVM_THREAD_POOL_PERF_EVENTS_AVAILABLE 1
+#else
+#define TVM_THREAD_POOL_PERF_EVENTS_AVAILABLE 0
+#endif
+
 #include "../support/utils.h"
 const constexpr int kL1CacheBytes = 64;
 
@@ -60,11 +72,172 @@ uint32_t GetSpinCount() {
   return atoi(val);
 }
 
+bool GetWorkStealing() {
+  const char* val = getenv("TVM_THREAD_POOL_WORK_STEALING");
+  return val && atoi(val) != 0;
+}
+
 }  // namespace
 
 // stride in the page, fit to cache line.
 constexpr int kSyncStride = 64 / sizeof(std::atomic<int>);
 
+/*!
+ * \brief Per-task hardware counter sampling for the thread pool workers.
+ *
+ * Enabled by TVM_THREAD_POOL_PERF_EVENTS=1. Each worker opens one perf event
+ * group scoped to its own thread (cycles, LLC misses, backend-stalled cycles)
+ * the first time it runs a sampled task, and reads the group around every
+ * task it executes. The deltas are aggregated per attribution tag -- the
+ * symbol of the kernel that launched the parallel region, set by the caller
+ * through threading::SetTaskAttributionTag -- so the dump attributes CPU
+ * behavior to parallel-for lambdas without external ptrace tooling.
+ *
+ * Mirrors memory::AllocationTracer: the hooks stay compiled in, and when
+ * sampling is disabled the only cost per task is one relaxed atomic load.
+ * On platforms without perf events the sampler reports no data.
+ */
+class TaskPerfSampler {
+ public:
+  /*! \brief Whether sampling is active; task sites guard Record calls with this. */
+  static bool Enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+  /*! \brief The attribution tag of tasks launched by the calling thread. */
+  static std::string& CurrentTag() {
+    static thread_local std::string tag = "unknown";
+    return tag;
+  }
+
+  /*! \brief One perf event group scoped to the owning thread. */
+  class ThreadCounters {
+   public:
+#if TVM_THREAD_POOL_PERF_EVENTS_AVAILABLE
+    ~ThreadCounters() {
+      for (int fd : fds_) {
+        if (fd != -1) close(fd);
+      }
+    }
+    /*!
+     * \brief Read the current counter values of the calling thread.
+     * \param values Filled with cycles, LLC misses and backend-stalled cycles.
+     * \return Whether the counters could be opened and read.
+     */
+    bool Read(uint64_t values[3]) {
+      if (!Open()) return false;
+      // PERF_FORMAT_GROUP layout: the number of counters, then one value per
+      // counter in the order they joined the group.
+      uint64_t buffer[4] = {0};
+      if (read(fds_[0], buffer, sizeof(buffer)) < 0) return false;
+      int pos = 1;
+      for (int i = 0; i < 3; ++i) {
+        values[i] = fds_[i] == -1 ? 0 : buffer[pos++];
+      }
+      return true;
+    }
+
+   private:
+    bool Open() {
+      if (fds_[0] != -1) return true;
+      if (failed_) return false;
+      // Cycles lead the group; the other counters are best-effort since not
+      // every PMU (or container policy) exposes them.
+      fds_[0] = OpenCounter(PERF_COUNT_HW_CPU_CYCLES, -1);
+      if (fds_[0] == -1) {
+        failed_ = true;
+        return false;
+      }
+      fds_[1] = OpenCounter(PERF_COUNT_HW_CACHE_MISSES, fds_[0]);
+      fds_[2] = OpenCounter(PERF_COUNT_HW_STALLED_CYCLES_BACKEND, fds_[0]);
+      ioctl(fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+      ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+      return true;
+    }
+
+    static int OpenCounter(uint64_t config, int group_fd) {
+      perf_event_attr attr;
+      std::memset(&attr, 0, sizeof(attr));
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.size = sizeof(attr);
+      attr.config = config;
+      attr.disabled = group_fd == -1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format = PERF_FORMAT_GROUP;
+      return static_cast<int>(
+          syscall(SYS_perf_event_open, &attr, /*pid=*/0, /*cpu=*/-1, group_fd, /*flags=*/0));
+    }
+
+    int fds_[3] = {-1, -1, -1};
+    bool failed_ = false;
+#else
+    bool Read(uint64_t values[3]) { return false; }
+#endif
+  };
+
+  /*! \brief The perf event group of the calling thread. */
+  static ThreadCounters& ThreadLocalCounters() {
+    static thread_local ThreadCounters counters;
+    return counters;
+  }
+
+  /*! \brief Aggregate the counter deltas of one finished task under its tag. */
+  static void RecordTask(const std::string& tag, const uint64_t begin[3], const uint64_t end[3]) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Totals& totals = totals_[tag];
+    totals.cycles += end[0] - begin[0];
+    totals.cache_misses += end[1] - begin[1];
+    totals.stalled_backend += end[2] - begin[2];
+    ++totals.tasks;
+  }
+
+  /*! \brief Enable sampling, discarding previously aggregated totals. */
+  static void Start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    totals_.clear();
+    enabled_.store(true, std::memory_order_relaxed);
+  }
+
+  /*! \brief Disable sampling, keeping the aggregated totals for Dump. */
+  static void Stop() { enabled_.store(false, std::memory_order_relaxed); }
+
+  /*! \brief Render the per-tag totals as JSON. */
+  static std::string Dump() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ostringstream os;
+    os << "{";
+    bool first = true;
+    for (const auto& [tag, totals] : totals_) {
+      if (!first) os << ", ";
+      first = false;
+      os << "\"" << tag << "\": {\"cycles\": " << totals.cycles
+         << ", \"cache_misses\": " << totals.cache_misses
+         << ", \"stalled_backend\": " << totals.stalled_backend
+         << ", \"tasks\": " << totals.tasks << "}";
+    }
+    os << "}";
+    return os.str();
+  }
+
+ private:
+  struct Totals {
+    uint64_t cycles = 0;
+    uint64_t cache_misses = 0;
+    uint64_t stalled_backend = 0;
+    uint64_t tasks = 0;
+  };
+
+  static std::atomic<bool> enabled_;
+  static std::mutex mutex_;
+  static std::unordered_map<std::string, Totals> totals_;
+};
+
+std::atomic<bool> TaskPerfSampler::enabled_{[]() {
+  const char* val = getenv("TVM_THREAD_POOL_PERF_EVENTS");
+  return val != nullptr && atoi(val) != 0;
+}()};
+std::mutex TaskPerfSampler::mutex_;
+std::unordered_map<std::string, TaskPerfSampler::Totals> TaskPerfSampler::totals_;
+
 /*!
  * \brief Thread local main environment.
  */
@@ -132,6 +305,8 @@ class ParallelLauncher {
   void* cdata;
   // Local env
   TVMParallelGroupEnv env;
+  // Attribution tag of the current job for per-task counter sampling.
+  std::string task_tag;
   // Whether this thread is worker of the pool.
   // used to prevent recursive launch.
   bool is_worker{false};
@@ -147,7 +322,13 @@ class ParallelLauncher {
   std::vector<ffi::Optional<tvm::ffi::Error>> par_errors_;
 };
 
-/*! \brief Lock-free single-producer-single-consumer queue for each thread */
+/*!
+ * \brief Lock-free single-producer-single-consumer queue for each thread.
+ *
+ * When constructed with allow_steal, idle workers may additionally dequeue
+ * through TrySteal; the owner's dequeue then takes the internal mutex as well
+ * so claimed slots stay consistent between owner and thieves.
+ */
 class SpscTaskQueue {
  public:
   /*! \brief The task entry */
@@ -156,7 +337,8 @@ class SpscTaskQueue {
     int32_t task_id;
   };
 
-  SpscTaskQueue() : buffer_(new Task[kRingSize]), head_(0), tail_(0) {}
+  explicit SpscTaskQueue(bool allow_steal = false)
+      : buffer_(new Task[kRingSize]), head_(0), tail_(0), allow_steal_(allow_steal) {}
 
   ~SpscTaskQueue() { delete[] buffer_; }
 
@@ -194,12 +376,35 @@ class SpscTaskQueue {
     if (exit_now_.load(std::memory_order_relaxed)) {
       return false;
     }
-    const uint32_t head = head_.load(std::memory_order_relaxed);
-    // sanity check if the queue is empty
-    TVM_FFI_ICHECK(tail_.load(std::memory_order_acquire) != head);
-    *output = buffer_[head];
-    head_.store((head + 1) % kRingSize, std::memory_order_release);
-    return true;
+    if (allow_steal_) {
+      // serialize the dequeue against thieves.
+      std::lock_guard<std::mutex> lock(mutex_);
+      return Dequeue(output);
+    }
+    return Dequeue(output);
+  }
+
+  /*!
+   * \brief Steal a pending task from this queue without being its owner.
+   *
+   * A task is claimed by moving pending_ down with a compare-and-swap that
+   * only fires while pending_ > 0, so a sleeping owner (pending_ == -1) and
+   * an owner that already claimed the last task (pending_ == 0) are never
+   * raced with.
+   *
+   * \param output The pointer to the task to be dequeued.
+   * \return Whether a task was stolen.
+   */
+  bool TrySteal(Task* output) {
+    if (!allow_steal_) return false;
+    int8_t p = pending_.load(std::memory_order_acquire);
+    while (p > 0) {
+      if (pending_.compare_exchange_weak(p, p - 1, std::memory_order_acq_rel)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return Dequeue(output);
+      }
+    }
+    return false;
   }
 
   /*!
@@ -230,6 +435,20 @@ class SpscTaskQueue {
     return false;
   }
 
+  /*!
+   * \brief Dequeue the task at the queue head; the caller must have claimed it.
+   * \param output The pointer to the task to be dequeued.
+   * \return Always true; claimed slots are guaranteed to be present.
+   */
+  bool Dequeue(Task* output) {
+    const uint32_t head = head_.load(std::memory_order_relaxed);
+    // sanity check if the queue is empty
+    TVM_FFI_ICHECK(tail_.load(std::memory_order_acquire) != head);
+    *output = buffer_[head];
+    head_.store((head + 1) % kRingSize, std::memory_order_release);
+    return true;
+  }
+
   // the cache line paddings are used for avoid false sharing between atomic variables
   typedef char cache_line_pad_t[kL1CacheBytes];
   cache_line_pad_t pad0_;
@@ -254,6 +473,8 @@ class SpscTaskQueue {
   cache_line_pad_t pad4_;
   // signal for exit now
   std::atomic<bool> exit_now_{false};
+  // whether idle workers may dequeue through TrySteal
+  const bool allow_steal_{false};
 
   // internal mutex
   std::mutex mutex_;
@@ -264,7 +485,9 @@ class SpscTaskQueue {
 // The thread pool
 class ThreadPool {
  public:
-  ThreadPool() : num_workers_(tvm::runtime::threading::MaxConcurrency()) {
+  ThreadPool()
+      : num_workers_(tvm::runtime::threading::MaxConcurrency()),
+        work_stealing_(GetWorkStealing()) {
     const char* exclude_worker0 = getenv("TVM_EXCLUDE_WORKER0");
     if (exclude_worker0 && atoi(exclude_worker0) == 0) {
       exclude_worker0_ = false;
@@ -302,6 +525,9 @@ class ThreadPool {
           << " workers=" << num_workers_used_ << " request=" << num_task;
     }
     launcher->Init(flambda, cdata, num_task, need_sync != 0);
+    if (TaskPerfSampler::Enabled()) {
+      launcher->task_tag = TaskPerfSampler::CurrentTag();
+    }
     SpscTaskQueue::Task tsk;
     tsk.launcher = launcher;
     // if worker0 is taken by the main, queues_[0] is abandoned
@@ -311,12 +537,19 @@ class ThreadPool {
     }
     // use the main thread to run task 0
     if (exclude_worker0_) {
+      uint64_t counters_begin[3];
+      bool sample = TaskPerfSampler::Enabled() &&
+                    TaskPerfSampler::ThreadLocalCounters().Read(counters_begin);
       TVMParallelGroupEnv* penv = &(tsk.launcher->env);
       if ((*tsk.launcher->flambda)(0, penv, cdata) == 0) {
         tsk.launcher->SignalJobFinish();
       } else {
         tsk.launcher->SignalJobError(tsk.task_id);
       }
+      uint64_t counters_end[3];
+      if (sample && TaskPerfSampler::ThreadLocalCounters().Read(counters_end)) {
+        TaskPerfSampler::RecordTask(launcher->task_tag, counters_begin, counters_end);
+      }
     }
     int res = launcher->WaitForJobs();
     return res;
@@ -344,7 +577,7 @@ class ThreadPool {
   void Init() {
     for (int i = 0; i < num_workers_; ++i) {
       // The SpscTaskQueue only hosts ONE item at a time
-      queues_.emplace_back(std::make_unique<SpscTaskQueue>());
+      queues_.emplace_back(std::make_unique<SpscTaskQueue>(work_stealing_));
     }
     threads_ = std::make_unique<tvm::runtime::threading::ThreadGroup>(
         num_workers_, [this](int worker_id) { this->RunWorker(worker_id); },
@@ -361,22 +594,57 @@ class ThreadPool {
     // the global first use of the ThreadPool.
     // TODO(tulloch): should we make this configurable via standard APIs?
     static size_t spin_count = GetSpinCount();
+    // seed per-worker so thieves do not all hammer the same victim
+    uint32_t steal_seed = static_cast<uint32_t>(worker_id) * 2654435761u + 1u;
     while (queue->Pop(&task, spin_count)) {
       TVM_FFI_ICHECK(task.launcher != nullptr);
-      TVMParallelGroupEnv* penv = &(task.launcher->env);
-      void* cdata = task.launcher->cdata;
-      if ((*task.launcher->flambda)(task.task_id, penv, cdata) == 0) {
-        task.launcher->SignalJobFinish();
-      } else {
-        task.launcher->SignalJobError(task.task_id);
+      RunTask(task);
+      if (work_stealing_) {
+        // keep draining tasks that slower workers have not started yet,
+        // visiting victims in a randomized order.
+        bool stolen = true;
+        while (stolen) {
+          stolen = false;
+          steal_seed = steal_seed * 1664525u + 1013904223u;
+          for (int i = 0; i < num_workers_; ++i) {
+            int victim = (i + steal_seed) % num_workers_;
+            if (victim == worker_id) continue;
+            if (queues_[victim]->TrySteal(&task)) {
+              RunTask(task);
+              stolen = true;
+              break;
+            }
+          }
+        }
       }
     }
   }
+
+  // Run one task and signal its completion.
+  void RunTask(const SpscTaskQueue::Task& task) {
+    uint64_t counters_begin[3];
+    bool sample = TaskPerfSampler::Enabled() &&
+                  TaskPerfSampler::ThreadLocalCounters().Read(counters_begin);
+    TVMParallelGroupEnv* penv = &(task.launcher->env);
+    void* cdata = task.launcher->cdata;
+    if ((*task.launcher->flambda)(task.task_id, penv, cdata) == 0) {
+      task.launcher->SignalJobFinish();
+    } else {
+      task.launcher->SignalJobError(task.task_id);
+    }
+    uint64_t counters_end[3];
+    if (sample && TaskPerfSampler::ThreadLocalCounters().Read(counters_end)) {
+      TaskPerfSampler::RecordTask(task.launcher->task_tag, counters_begin, counters_end);
+    }
+  }
   int num_workers_;
   // number of workers used (can be restricted with affinity pref)
   int num_workers_used_;
   // if or not to exclude worker 0 and use main to run task 0
   bool exclude_worker0_{true};
+  // whether idle workers steal unstarted tasks from their peers
+  // (TVM_THREAD_POOL_WORK_STEALING)
+  bool work_stealing_{false};
   std::vector<std::unique_ptr<SpscTaskQueue>> queues_;
   std::unique_ptr<tvm::runtime::threading::ThreadGroup> threads_;
 };
@@ -404,7 +672,10 @@ TVM_FFI_STATIC_INIT_BLOCK() {
                     }
                     threading::Configure(mode, nthreads, cpus);
                   })
-      .def("runtime.NumThreads", []() -> int32_t { return threading::NumThreads(); });
+      .def("runtime.NumThreads", []() -> int32_t { return threading::NumThreads(); })
+      .def("runtime.threading.StartTaskPerfCounters", TaskPerfSampler::Start)
+      .def("runtime.threading.StopTaskPerfCounters", TaskPerfSampler::Stop)
+      .def("runtime.threading.DumpTaskPerfCounters", TaskPerfSampler::Dump);
 }
 
 namespace threading {
@@ -460,6 +731,13 @@ static void ConfigureOMP(tvm::runtime::threading::ThreadGroup::AffinityMode mode
 #endif
 
 void ResetThreadPool() { tvm::runtime::ThreadPool::ThreadLocal()->Reset(); }
+
+bool TaskPerfCountersEnabled() { return tvm::runtime::TaskPerfSampler::Enabled(); }
+
+void SetTaskAttributionTag(std::string tag) {
+  tvm::runtime::TaskPerfSampler::CurrentTag() = std::move(tag);
+}
+
 /*!
  * \brief configure the CPU id affinity
  * \param mode The preferred CPU type (1 = big, -1 = little, -2 = kSpecifyOneCorePerThread,
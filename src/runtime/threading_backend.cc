@@ -177,6 +177,25 @@ class ThreadGroup::Impl {
         num_workers_used = cpus.size();
         sorted_order_ = cpus;
         break;
+      case kNumaLocal: {
+        InitNumaTopology();
+        std::vector<unsigned int> node_cpus = NodeLocalCpus();
+        if (!node_cpus.empty()) {
+          // keep the frequency-sorted order, restricted to the local node.
+          std::vector<unsigned int> order;
+          for (unsigned int core_id : sorted_order_) {
+            if (std::find(node_cpus.begin(), node_cpus.end(), core_id) != node_cpus.end()) {
+              order.push_back(core_id);
+            }
+          }
+          sorted_order_ = order;
+          num_workers_used = static_cast<int>(order.size());
+        } else {
+          LOG(WARNING) << "NUMA topology unavailable, falling back to all cores.";
+          num_workers_used = threading::MaxConcurrency();
+        }
+        break;
+      }
       default:
         // use default
         num_workers_used = threading::MaxConcurrency();
@@ -235,6 +254,7 @@ class ThreadGroup::Impl {
           break;
         case kLittle:
         case kBig:
+        case kNumaLocal:
         case kSpecifyOneCorePerThread:
           for (unsigned i = 0; i < threads_.size(); ++i) {
             bool reverse = mode == kLittle;
@@ -275,6 +295,9 @@ class ThreadGroup::Impl {
     switch (mode) {
       case kSpecifyOneCorePerThread:
       case kSpecifyThreadShareAllCore:
+      // after a kNumaLocal Configure, sorted_order_ already only holds the
+      // cores of the local node.
+      case kNumaLocal:
         for (size_t i = 0; i < sorted_order_.size(); ++i) {
           ids.push_back(sorted_order_[i]);
         }
@@ -350,6 +373,51 @@ class ThreadGroup::Impl {
     }
   }
 
+  // Learn the NUMA topology from sysfs. Populates numa_nodes_ with the cpu
+  // list of each node; leaves it empty on systems without the information.
+  void InitNumaTopology() {
+    if (!numa_nodes_.empty()) return;
+#if defined(__linux__)
+    for (unsigned int node = 0;; ++node) {
+      std::ostringstream filepath;
+      filepath << "/sys/devices/system/node/node" << node << "/cpulist";
+      std::ifstream ifs(filepath.str());
+      if (ifs.fail()) break;
+      std::string cpulist;
+      if (!(ifs >> cpulist)) break;
+      // cpulist is a comma-separated list of ids and ranges, e.g. "0-15,32-47"
+      std::vector<unsigned int> cpus;
+      std::istringstream iss(cpulist);
+      std::string item;
+      while (std::getline(iss, item, ',')) {
+        size_t dash = item.find('-');
+        unsigned int begin = std::stoul(item.substr(0, dash));
+        unsigned int end = dash == std::string::npos ? begin : std::stoul(item.substr(dash + 1));
+        for (unsigned int cpu = begin; cpu <= end; ++cpu) {
+          cpus.push_back(cpu);
+        }
+      }
+      numa_nodes_.push_back(cpus);
+    }
+#endif
+  }
+
+  // The cpus of the NUMA node the calling thread currently runs on,
+  // or an empty list if the topology is unknown.
+  std::vector<unsigned int> NodeLocalCpus() const {
+#if defined(__linux__)
+    int cpu = sched_getcpu();
+    if (cpu >= 0) {
+      for (const std::vector<unsigned int>& cpus : numa_nodes_) {
+        if (std::find(cpus.begin(), cpus.end(), static_cast<unsigned int>(cpu)) != cpus.end()) {
+          return cpus;
+        }
+      }
+    }
+#endif
+    return {};
+  }
+
   int num_workers_;
 #if defined(__hexagon__)
   std::vector<QuRTThread> threads_;
@@ -357,6 +425,8 @@ class ThreadGroup::Impl {
   std::vector<std::thread> threads_;
 #endif
   std::vector<unsigned int> sorted_order_;
+  // cpus of each NUMA node, filled lazily by InitNumaTopology
+  std::vector<std::vector<unsigned int>> numa_nodes_;
   int big_count_ = 0;
   int little_count_ = 0;
 };
@@ -437,15 +507,57 @@ int MaxConcurrency() {
   return std::max(max_concurrency, 1);
 }
 
+int64_t DataCacheSize(int level) {
+#if defined(__linux__) || defined(__ANDROID__)
+  // The topology is read from the perspective of cpu0; heterogeneous systems
+  // may have per-cluster capacities, but one representative value is what the
+  // cache-blocking variant selection needs.
+  for (int index = 0;; ++index) {
+    std::ostringstream dir;
+    dir << "/sys/devices/system/cpu/cpu0/cache/index" << index;
+    std::ifstream level_file(dir.str() + "/level");
+    if (level_file.fail()) {
+      break;
+    }
+    int cache_level = 0;
+    if (!(level_file >> cache_level) || cache_level != level) {
+      continue;
+    }
+    std::string type;
+    std::ifstream type_file(dir.str() + "/type");
+    if (!(type_file >> type) || (type != "Data" && type != "Unified")) {
+      continue;
+    }
+    // The size file reports a value with a K or M suffix, e.g. "1024K".
+    int64_t size = 0;
+    char suffix = '\0';
+    std::ifstream size_file(dir.str() + "/size");
+    if (!(size_file >> size) || size <= 0) {
+      continue;
+    }
+    size_file >> suffix;
+    if (suffix == 'K') {
+      size <<= 10;
+    } else if (suffix == 'M') {
+      size <<= 20;
+    }
+    return size;
+  }
+#endif
+  return -1;
+}
+
 // This global function can be used by disco runtime to bind processes
 // to CPUs.
 TVM_FFI_STATIC_INIT_BLOCK() {
   namespace refl = tvm::ffi::reflection;
-  refl::GlobalDef().def(
-      "tvm.runtime.threading.set_current_thread_affinity", [](ffi::Shape cpu_ids) {
-        SetThreadAffinity(CURRENT_THREAD_HANDLE,
-                          std::vector<unsigned int>{cpu_ids.begin(), cpu_ids.end()});
-      });
+  refl::GlobalDef()
+      .def("tvm.runtime.threading.set_current_thread_affinity",
+           [](ffi::Shape cpu_ids) {
+             SetThreadAffinity(CURRENT_THREAD_HANDLE,
+                               std::vector<unsigned int>{cpu_ids.begin(), cpu_ids.end()});
+           })
+      .def("tvm.runtime.threading.data_cache_size", DataCacheSize);
 }
 
 }  // namespace threading
@@ -29,6 +29,8 @@
 #include <algorithm>
 #include <functional>
 #include <memory>
+#include <string>
+#include <thread>
 #include <vector>
 
 #if defined(__linux__) || defined(__ANDROID__)
@@ -92,6 +94,9 @@ class ThreadGroup {
     kSpecifyOneCorePerThread = -2,
     /*All threads will get the same core group affinity.*/
     kSpecifyThreadShareAllCore = -3,
+    /*Restrict the workers to the NUMA node of the calling thread, one core per
+     * thread. Workspace memory then stays node-local through first touch.*/
+    kNumaLocal = -4,
   };
   /*!
    * \brief configure the CPU id affinity
@@ -117,6 +122,13 @@ class ThreadGroup {
  * \brief Platform-agnostic no-op.
  */
 TVM_RUNTIME_DLL void YieldThread();
+/*!
+ * \brief Bind a thread to the given set of logical cpus.
+ * \param thread The native thread handle; pass 0 to bind the calling thread.
+ * \param ids The logical cpu ids the thread may run on.
+ */
+TVM_RUNTIME_DLL void SetThreadAffinity(std::thread::native_handle_type thread,
+                                       const std::vector<unsigned int>& ids);
 /*!
  * \return the maximum number of effective workers for this system.
  */
@@ -133,10 +145,22 @@ TVM_RUNTIME_DLL void SetMaxConcurrency(int value);
  */
 TVM_RUNTIME_DLL void ResetThreadPool();
 
+/*!
+ * \brief Whether per-task hardware counter sampling of the thread pool is
+ * active (TVM_THREAD_POOL_PERF_EVENTS).
+ */
+TVM_RUNTIME_DLL bool TaskPerfCountersEnabled();
+
+/*!
+ * \brief Set the attribution tag of parallel tasks launched by the calling
+ * thread, typically the symbol of the kernel about to run.
+ */
+TVM_RUNTIME_DLL void SetTaskAttributionTag(std::string tag);
+
 /*!
  * \brief Configuring the CPU affinity mode for the working threads.
  * \param mode The preferred CPU type (1 = big, -1 = little, -2 = kSpecifyOneCorePerThread,
- *  -3 = kSpecifyThreadShareAllCore).
+ *  -3 = kSpecifyThreadShareAllCore, -4 = kNumaLocal).
  * \param nthreads The number of threads to use (0 = use all).
  * \param cpus A list of CPUs is used to set the 'cpu affinity' for the worker threads.
  */
@@ -149,6 +173,14 @@ TVM_RUNTIME_DLL void Configure(tvm::runtime::threading::ThreadGroup::AffinityMod
  */
 TVM_RUNTIME_DLL int32_t NumThreads();
 
+/*!
+ * \brief Query the data cache capacity of the host CPU as seen by one core.
+ * \param level The cache level (e.g. 2 for L2, 3 for L3).
+ * \returns The capacity in bytes, or -1 when the level is not present or the
+ *  platform does not expose its cache topology.
+ */
+TVM_RUNTIME_DLL int64_t DataCacheSize(int level);
+
 }  // namespace threading
 
 /*!
@@ -29,11 +29,19 @@
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/timer.h>
 
+#include <atomic>
 #include <chrono>
+#include <fstream>
+#include <iomanip>
 #include <mutex>
 #include <set>
 #include <sstream>
+#include <string>
 #include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "../support/env.h"
 
 namespace tvm {
 namespace runtime {
@@ -108,6 +116,210 @@ Timer Timer::Start(Device dev) {
   }
 }
 
+namespace {
+
+/*! \brief One recorded span. Fixed size so the ring never allocates while recording. */
+struct TraceSpanRecord {
+  int64_t begin_ns;
+  int64_t end_ns;
+  int32_t device_type;
+  int32_t device_id;
+  uint32_t name_index;
+  uint32_t thread_id;
+};
+
+/*!
+ * \brief Global recorder of timestamped spans, flushed to Chrome trace format.
+ *
+ * Writers claim slots with a single fetch_add on the cursor and never take a
+ * lock, so recording from the VM dispatch loop or from kernel launch paths is
+ * cheap enough to leave enabled in production. The ring has fixed capacity and
+ * overwrites the oldest spans when it wraps; flushing emits whatever is still
+ * resident. Span names are interned once under a mutex (with a thread-local
+ * cache in front), so steady-state recording only touches the ring.
+ */
+class DeviceTraceRecorder {
+ public:
+  static DeviceTraceRecorder* Global() {
+    // NOTE: explicitly use new to avoid exit-time destruction of global state
+    static auto* inst = new DeviceTraceRecorder();
+    return inst;
+  }
+
+  bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+  /*!
+   * \brief Start recording. \p capacity <= 0 picks TVM_TRACE_RING_CAPACITY
+   * (default 65536 spans). Must not race with active writers; call it before
+   * the traced workload starts.
+   */
+  void Enable(int64_t capacity) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (capacity <= 0) {
+      capacity = support::GetEnv<int64_t>("TVM_TRACE_RING_CAPACITY", int64_t{1} << 16);
+    }
+    TVM_FFI_CHECK(capacity > 0, ValueError)
+        << "Trace ring capacity must be positive, but got " << capacity;
+    ring_.assign(static_cast<size_t>(capacity), TraceSpanRecord{});
+    cursor_.store(0, std::memory_order_relaxed);
+    enabled_.store(true, std::memory_order_release);
+  }
+
+  void Disable() { enabled_.store(false, std::memory_order_release); }
+
+  void Record(const std::string& name, Device dev, int64_t begin_ns, int64_t end_ns) {
+    uint32_t name_index = InternName(name);
+    uint64_t slot = cursor_.fetch_add(1, std::memory_order_relaxed);
+    TraceSpanRecord& rec = ring_[slot % ring_.size()];
+    rec.begin_ns = begin_ns;
+    rec.end_ns = end_ns;
+    rec.device_type = static_cast<int32_t>(dev.device_type);
+    rec.device_id = dev.device_id;
+    rec.name_index = name_index;
+    rec.thread_id = ThreadId();
+  }
+
+  /*!
+   * \brief Serialize the resident spans to a Chrome trace JSON string.
+   *
+   * Recording is paused while serializing and resumed afterwards; spans
+   * written concurrently with the pause may be dropped, which is acceptable
+   * for a sampling-style production tracer.
+   */
+  std::string DumpChromeTrace() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    bool was_enabled = enabled_.exchange(false, std::memory_order_acq_rel);
+    std::vector<std::string> names;
+    {
+      std::lock_guard<std::mutex> name_lock(name_mutex_);
+      names = names_;
+    }
+    uint64_t end = cursor_.load(std::memory_order_acquire);
+    uint64_t count = ring_.empty() ? 0 : std::min<uint64_t>(end, ring_.size());
+    std::ostringstream os;
+    os << std::fixed << std::setprecision(3);
+    os << "{\"traceEvents\":[";
+    bool first = true;
+    // One Chrome trace "process" per device, named after it.
+    std::set<std::pair<int32_t, int32_t>> seen_devices;
+    for (uint64_t i = end - count; i < end; ++i) {
+      const TraceSpanRecord& rec = ring_[i % ring_.size()];
+      if (rec.end_ns < rec.begin_ns || rec.begin_ns <= 0 || rec.name_index >= names.size()) {
+        // slot was mid-write when recording stopped
+        continue;
+      }
+      if (seen_devices.emplace(rec.device_type, rec.device_id).second) {
+        if (!first) os << ",";
+        first = false;
+        os << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << DevicePid(rec) << ","
+           << "\"args\":{\"name\":\"" << DLDeviceType2Str(rec.device_type) << ":" << rec.device_id
+           << "\"}}";
+      }
+      if (!first) os << ",";
+      first = false;
+      os << "{\"name\":\"" << EscapeJSONString(names[rec.name_index]) << "\","
+         << "\"cat\":\"tvm\",\"ph\":\"X\",\"pid\":" << DevicePid(rec)
+         << ",\"tid\":" << rec.thread_id << ",\"ts\":" << rec.begin_ns / 1e3
+         << ",\"dur\":" << (rec.end_ns - rec.begin_ns) / 1e3 << "}";
+    }
+    os << "]}";
+    if (was_enabled) {
+      enabled_.store(true, std::memory_order_release);
+    }
+    return os.str();
+  }
+
+ private:
+  DeviceTraceRecorder() = default;
+
+  static int64_t DevicePid(const TraceSpanRecord& rec) {
+    // fold (device_type, device_id) into one Chrome trace process id
+    return static_cast<int64_t>(rec.device_type) * 1000 + rec.device_id;
+  }
+
+  static std::string EscapeJSONString(const std::string& s) {
+    std::ostringstream os;
+    for (char c : s) {
+      if (c == '"' || c == '\\') {
+        os << '\\' << c;
+      } else if (static_cast<unsigned char>(c) < 0x20) {
+        os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c);
+      } else {
+        os << c;
+      }
+    }
+    return os.str();
+  }
+
+  static uint32_t ThreadId() {
+    static std::atomic<uint32_t> next_id{0};
+    static thread_local uint32_t id = next_id.fetch_add(1, std::memory_order_relaxed);
+    return id;
+  }
+
+  uint32_t InternName(const std::string& name) {
+    static thread_local std::unordered_map<std::string, uint32_t> local_cache;
+    auto it = local_cache.find(name);
+    if (it != local_cache.end()) return it->second;
+    uint32_t index;
+    {
+      std::lock_guard<std::mutex> lock(name_mutex_);
+      auto [global_it, inserted] = name_index_.try_emplace(name, static_cast<uint32_t>(names_.size()));
+      if (inserted) names_.push_back(name);
+      index = global_it->second;
+    }
+    local_cache.emplace(name, index);
+    return index;
+  }
+
+  std::atomic<bool> enabled_{false};
+  std::atomic<uint64_t> cursor_{0};
+  std::vector<TraceSpanRecord> ring_;
+  // guards Enable/Disable/Dump; never taken by Record
+  std::mutex mutex_;
+  std::mutex name_mutex_;
+  std::vector<std::string> names_;
+  std::unordered_map<std::string, uint32_t> name_index_;
+};
+
+}  // namespace
+
+bool DeviceTraceEnabled() { return DeviceTraceRecorder::Global()->enabled(); }
+
+void DeviceTraceRecordSpan(const std::string& name, Device dev, int64_t begin_ns, int64_t end_ns) {
+  DeviceTraceRecorder* recorder = DeviceTraceRecorder::Global();
+  if (recorder->enabled()) {
+    recorder->Record(name, dev, begin_ns, end_ns);
+  }
+}
+
+int64_t DeviceTraceNowNanos() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef()
+      .def("runtime.trace.Enable",
+           [](int64_t capacity) { DeviceTraceRecorder::Global()->Enable(capacity); })
+      .def("runtime.trace.Disable", []() { DeviceTraceRecorder::Global()->Disable(); })
+      .def("runtime.trace.RecordSpan",
+           [](const ffi::String& name, Device dev, int64_t begin_ns, int64_t end_ns) {
+             DeviceTraceRecordSpan(name, dev, begin_ns, end_ns);
+           })
+      .def("runtime.trace.NowNanos", []() { return DeviceTraceNowNanos(); })
+      .def("runtime.trace.DumpChromeTrace",
+           []() -> ffi::String { return DeviceTraceRecorder::Global()->DumpChromeTrace(); })
+      .def("runtime.trace.SaveChromeTrace", [](const ffi::String& path) {
+        std::string trace = DeviceTraceRecorder::Global()->DumpChromeTrace();
+        std::ofstream out(std::string(path), std::ios::binary);
+        TVM_FFI_CHECK(out.is_open(), ValueError) << "Cannot open trace file " << path;
+        out << trace;
+      });
+}
+
 ffi::Function WrapTimeEvaluator(ffi::Function pf, Device dev, int number, int repeat,
                                 int min_repeat_ms, int limit_zero_time_iterations,
                                 int cooldown_interval_ms, int repeats_to_cooldown,
@@ -21,15 +21,162 @@
 
 #include "attn_backend.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
 namespace tvm {
 namespace runtime {
 namespace vm {
 
+const char* AttnBackendKindToString(AttnBackendKind kind) {
+  switch (kind) {
+    case AttnBackendKind::kTIR:
+      return "tirx";
+    case AttnBackendKind::kFlashInfer:
+      return "flashinfer";
+  }
+  TVM_FFI_THROW(InternalError) << "Cannot reach here";
+  throw;
+}
+
+AttnBackendTuningTable* AttnBackendTuningTable::Global() {
+  static AttnBackendTuningTable table;
+  return &table;
+}
+
+AttnBackendTuningTable::AttnBackendTuningTable() {
+  const char* path = std::getenv("TVM_ATTN_BACKEND_TUNING_CACHE");
+  if (path == nullptr || path[0] == '\0') {
+    return;
+  }
+  path_ = path;
+  std::ifstream file(path_);
+  std::string key;
+  std::string backend_name;
+  while (file >> key >> backend_name) {
+    if (backend_name == "tirx") {
+      winners_[key] = AttnBackendKind::kTIR;
+    } else if (backend_name == "flashinfer") {
+      winners_[key] = AttnBackendKind::kFlashInfer;
+    }
+  }
+}
+
+std::string AttnBackendTuningTable::DeviceKey(Device device) {
+  const DeviceCapability& cap = GetDeviceCapability(device);
+  std::string name = cap.device_name.empty() ? "unknown" : cap.device_name;
+  std::ostringstream os;
+  os << static_cast<int>(device.device_type) << ":" << name;
+  std::string key = os.str();
+  // The table file is whitespace-separated, so device names cannot carry spaces.
+  for (char& c : key) {
+    if (c == ' ' || c == '|') {
+      c = '-';
+    }
+  }
+  return key;
+}
+
+bool AttnBackendTuningTable::Lookup(const std::string& key, AttnBackendKind* kind) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = winners_.find(key);
+  if (it == winners_.end()) {
+    return false;
+  }
+  *kind = it->second;
+  return true;
+}
+
+void AttnBackendTuningTable::Update(const std::string& key, AttnBackendKind kind) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  winners_[key] = kind;
+  if (path_.empty()) {
+    return;
+  }
+  std::ofstream file(path_, std::ios::trunc);
+  if (!file.good()) {
+    LOG(WARNING) << "Cannot write the attention backend tuning cache to \"" << path_ << "\".";
+    return;
+  }
+  for (const auto& [entry_key, entry_kind] : winners_) {
+    file << entry_key << " " << AttnBackendKindToString(entry_kind) << "\n";
+  }
+}
+
+void AttnBackendAutoTuner::RunSelected(const char* op, int64_t shape_size, Device device,
+                                       TVMStreamHandle stream,
+                                       const std::function<void(int)>& run) {
+  int num_candidates = static_cast<int>(candidate_kinds_.size());
+  // The shape bucket is the rounded-up power of two of the query token count.
+  int bucket = 0;
+  while ((int64_t(1) << bucket) < shape_size) {
+    ++bucket;
+  }
+  std::string bucket_key = std::string(op) + ":" + std::to_string(bucket);
+  BucketState& state = buckets_[bucket_key];
+  if (state.elapsed_sum.empty()) {
+    state.elapsed_sum.resize(num_candidates, 0.0);
+    // Consult the persistent table before measuring anything.
+    std::string table_key =
+        AttnBackendTuningTable::DeviceKey(device) + "|" + role_ + "|" + bucket_key;
+    AttnBackendKind cached_kind;
+    if (AttnBackendTuningTable::Global()->Lookup(table_key, &cached_kind)) {
+      for (int i = 0; i < num_candidates; ++i) {
+        if (candidate_kinds_[i] == cached_kind) {
+          state.winner = i;
+          break;
+        }
+      }
+    }
+  }
+  if (state.winner != -1) {
+    run(state.winner);
+    return;
+  }
+
+  // Run every candidate back to back. The first round warms the kernels up
+  // and is not timed; the following rounds accumulate CPU-side elapsed time
+  // around stream synchronizations.
+  DeviceAPI* device_api = DeviceAPI::Get(device);
+  for (int i = 0; i < num_candidates; ++i) {
+    device_api->StreamSync(device, stream);
+    auto tbegin = std::chrono::high_resolution_clock::now();
+    run(i);
+    device_api->StreamSync(device, stream);
+    auto tend = std::chrono::high_resolution_clock::now();
+    if (state.num_rounds > 0) {
+      state.elapsed_sum[i] += std::chrono::duration<double>(tend - tbegin).count();
+    }
+  }
+  if (++state.num_rounds > kNumMeasureRounds) {
+    state.winner = static_cast<int>(std::min_element(state.elapsed_sum.begin(),
+                                                     state.elapsed_sum.end()) -
+                                    state.elapsed_sum.begin());
+    std::string table_key =
+        AttnBackendTuningTable::DeviceKey(device) + "|" + role_ + "|" + bucket_key;
+    AttnBackendTuningTable::Global()->Update(table_key, candidate_kinds_[state.winner]);
+  }
+}
+
 std::unique_ptr<PagedPrefillFunc> ConvertPagedPrefillFunc(ffi::Array<ffi::Any> args,
                                                           AttnKind attn_kind) {
   if (args.empty()) {
     return nullptr;
   }
+  if (args[0].as<ffi::Array<ffi::Any>>()) {
+    // A nested array of backend tuples denotes multiple candidate backends,
+    // auto-selected by on-device microbenchmark.
+    std::vector<std::unique_ptr<PagedPrefillFunc>> candidates;
+    candidates.reserve(args.size());
+    for (const ffi::Any& candidate_args : args) {
+      candidates.push_back(
+          ConvertPagedPrefillFunc(candidate_args.cast<ffi::Array<ffi::Any>>(), attn_kind));
+    }
+    return std::make_unique<AutoSelectPagedPrefillFunc>(std::move(candidates));
+  }
   ffi::String backend_name = args[0].cast<ffi::String>();
   if (backend_name == "tirx") {
     TVM_FFI_ICHECK_EQ(args.size(), 2);
@@ -84,6 +231,17 @@ std::unique_ptr<PagedDecodeFunc> ConvertPagedDecodeFunc(ffi::Array<ffi::Any> arg
   if (args.empty()) {
     return nullptr;
   }
+  if (args[0].as<ffi::Array<ffi::Any>>()) {
+    // A nested array of backend tuples denotes multiple candidate backends,
+    // auto-selected by on-device microbenchmark.
+    std::vector<std::unique_ptr<PagedDecodeFunc>> candidates;
+    candidates.reserve(args.size());
+    for (const ffi::Any& candidate_args : args) {
+      candidates.push_back(
+          ConvertPagedDecodeFunc(candidate_args.cast<ffi::Array<ffi::Any>>(), attn_kind));
+    }
+    return std::make_unique<AutoSelectPagedDecodeFunc>(std::move(candidates));
+  }
   ffi::String backend_name = args[0].cast<ffi::String>();
   if (backend_name == "tirx") {
     TVM_FFI_ICHECK_EQ(args.size(), 2);
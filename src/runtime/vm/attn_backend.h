@@ -32,8 +32,12 @@
 #include <tvm/runtime/device_api.h>
 #include <tvm/runtime/logging.h>
 
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <tuple>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -49,6 +53,83 @@ enum class AttnBackendKind : int {
   kFlashInfer = 1,
 };
 
+/*! \brief Convert the attention backend kind to the backend name. */
+const char* AttnBackendKindToString(AttnBackendKind kind);
+
+/*!
+ * \brief The table caching the measured best attention backend per
+ * (device, function role, shape bucket).
+ * The table is persisted to the file given by environment variable
+ * "TVM_ATTN_BACKEND_TUNING_CACHE" when it is set, so that processes on the
+ * same machine only pay the microbenchmark cost once. Without the
+ * environment variable the table lives in memory only.
+ */
+class AttnBackendTuningTable {
+ public:
+  /*! \brief Get the process-wide tuning table. */
+  static AttnBackendTuningTable* Global();
+  /*! \brief Build the table key component identifying the given device. */
+  static std::string DeviceKey(Device device);
+  /*!
+   * \brief Look up the cached winner backend of the given key.
+   * \return Whether the key has a cached winner, which is written to \p kind.
+   */
+  bool Lookup(const std::string& key, AttnBackendKind* kind);
+  /*! \brief Record the winner backend of the given key and persist the table. */
+  void Update(const std::string& key, AttnBackendKind kind);
+
+ private:
+  AttnBackendTuningTable();
+
+  std::mutex mutex_;
+  std::string path_;
+  std::unordered_map<std::string, AttnBackendKind> winners_;
+};
+
+/*!
+ * \brief The one-shot on-device microbenchmark state of a backend selector.
+ * For each shape bucket (rounded-up power of two of the number of query
+ * tokens), the first few invocations run every candidate backend back to
+ * back with stream synchronization and CPU-side timing. Afterwards the
+ * fastest candidate is fixed as the bucket winner and recorded in the
+ * AttnBackendTuningTable, and all later invocations dispatch to it directly.
+ */
+class AttnBackendAutoTuner {
+ public:
+  explicit AttnBackendAutoTuner(std::string role, std::vector<AttnBackendKind> candidate_kinds)
+      : role_(std::move(role)), candidate_kinds_(std::move(candidate_kinds)) {}
+
+  /*!
+   * \brief Run the selected candidate, measuring all candidates first when
+   * the winner of the shape bucket is still undecided.
+   * \param op The operator tag (e.g. "mha") distinguishing bucket spaces.
+   * \param shape_size The bucketing size, i.e. the number of query tokens.
+   * \param device The device the attention kernels run on.
+   * \param stream The stream the attention kernels are launched on.
+   * \param run The callback invoking the candidate of the given index.
+   */
+  void RunSelected(const char* op, int64_t shape_size, Device device, TVMStreamHandle stream,
+                   const std::function<void(int)>& run);
+
+ private:
+  /*! \brief The number of timed rounds per bucket, after one warm-up round. */
+  static constexpr int kNumMeasureRounds = 4;
+
+  /*! \brief The measurement state of one shape bucket. */
+  struct BucketState {
+    /*! \brief The accumulated elapsed seconds of each candidate. */
+    std::vector<double> elapsed_sum;
+    /*! \brief The number of finished rounds, including the warm-up round. */
+    int num_rounds = 0;
+    /*! \brief The decided winner candidate index, or -1 if undecided. */
+    int winner = -1;
+  };
+
+  std::string role_;
+  std::vector<AttnBackendKind> candidate_kinds_;
+  std::unordered_map<std::string, BucketState> buckets_;
+};
+
 /*!
  * \brief Return a zero-copy alias of \p t whose `byte_offset` is folded into the
  * data pointer, so the resulting tensor has `byte_offset == 0`.
@@ -194,6 +275,44 @@ class AttnBackendFunc {
   AttnBackendKind backend_kind;
 };
 
+/*!
+ * \brief The signature hash of a FlashInfer plan invocation. Two BeginForward
+ * calls with equal signatures (head configuration, dtypes, workspace buffers
+ * and per-request lengths) produce bit-identical plans in the same workspace
+ * buffers, so the later call can skip the plan function entirely and keep the
+ * plan data already resident in the device workspace. Under steady-state
+ * batching the page-table shape repeats across steps, making this the common
+ * case.
+ * \note Per-request lengths are hashed in order: the plan partitions work by
+ * request position, so the multiset of lengths alone is not a safe key.
+ */
+class FlashInferPlanSignature {
+ public:
+  void Add(uint64_t value) {
+    hash_ ^= value + 0x9e3779b97f4a7c15ULL + (hash_ << 6) + (hash_ >> 2);
+  }
+
+  void AddDataType(DLDataType dtype) {
+    Add((static_cast<uint64_t>(dtype.code) << 16) | (static_cast<uint64_t>(dtype.bits) << 8) |
+        dtype.lanes);
+  }
+
+  /*! \brief Fold in the buffer identity, as plan data lives in the buffer. */
+  void AddBufferIdentity(const Tensor& tensor) {
+    Add(reinterpret_cast<uint64_t>(tensor->data));
+  }
+
+  /*!
+   * \brief The signature hash value. Nonzero-seeded so that a real signature
+   * virtually never equals the 0 used for "no plan cached"; a collision with
+   * 0 only costs one redundant plan.
+   */
+  uint64_t Value() const { return hash_; }
+
+ private:
+  uint64_t hash_ = 0x2545f4914f6cdd1dULL;
+};
+
 /*! \brief The paged prefill attention function base class. */
 class PagedPrefillFunc : public AttnBackendFunc {
  public:
@@ -223,6 +342,14 @@ class PagedPrefillFunc : public AttnBackendFunc {
                             int64_t v_head_dim, bool causal, TVMStreamHandle copy_stream) {
     // Do nothing. Subclasses can override to customize behavior.
   }
+
+  /*!
+   * \brief Drop the cached plan of the given depth, used when another
+   * function has since planned into the shared workspace buffers.
+   */
+  virtual void ResetPlanCache(int depth) {
+    // Do nothing. Subclasses caching plans can override to customize behavior.
+  }
 };
 
 /*! \brief The TIR-based paged prefill attention function class. */
@@ -306,6 +433,33 @@ class FlashInferPagedPrefillFunc : public PagedPrefillFunc {
                     int64_t batch_size, int64_t total_qo_len, int64_t page_size,
                     int64_t num_qo_heads, int64_t num_kv_heads, int64_t qk_head_dim,
                     int64_t v_head_dim, bool causal, TVMStreamHandle copy_stream) final {
+    // Skip planning when the signature matches the plan already resident in
+    // these workspace buffers at this depth.
+    FlashInferPlanSignature sig;
+    sig.AddBufferIdentity(float_workspace_buffer);
+    sig.AddBufferIdentity(int_workspace_buffer);
+    sig.Add(static_cast<uint64_t>(batch_size));
+    sig.Add(static_cast<uint64_t>(total_qo_len));
+    sig.Add(static_cast<uint64_t>(page_size));
+    sig.Add(static_cast<uint64_t>(num_qo_heads));
+    sig.Add(static_cast<uint64_t>(num_kv_heads));
+    sig.Add(static_cast<uint64_t>(qk_head_dim));
+    sig.Add(static_cast<uint64_t>(v_head_dim));
+    sig.Add(static_cast<uint64_t>(causal));
+    for (int i = 0; i < static_cast<int>(batch_size) + 1; ++i) {
+      sig.Add(static_cast<uint64_t>((*qo_indptr)[i]));
+      sig.Add(static_cast<uint64_t>((*page_indptr)[i]));
+    }
+    for (int i = 0; i < static_cast<int>(batch_size); ++i) {
+      sig.Add(static_cast<uint64_t>((*last_page_len)[i]));
+    }
+    if (plan_signatures_.size() <= static_cast<size_t>(depth)) {
+      plan_signatures_.resize(depth + 1, 0);
+    }
+    if (plan_signatures_[depth] == sig.Value()) {
+      return;
+    }
+
     // FlashInfer expects kv_len as an (int32) tensor rather than a shape tuple.
     HostMemoryVector kv_len_arr(batch_size, DLDataType{kDLInt, 32, 1},
                                 qo_indptr->as_tensor()->device);
@@ -345,11 +499,20 @@ class FlashInferPagedPrefillFunc : public PagedPrefillFunc {
     cached_buffers_[depth] =
         std::make_tuple(float_workspace_buffer, int_workspace_buffer,
                         page_locked_int_workspace_buffer, std::move(plan_info_vec));
+    plan_signatures_[depth] = sig.Value();
+  }
+
+  void ResetPlanCache(int depth) final {
+    if (static_cast<size_t>(depth) < plan_signatures_.size()) {
+      plan_signatures_[depth] = 0;
+    }
   }
 
  private:
   ffi::Function plan_func_;
   std::vector<std::tuple<Tensor, Tensor, Tensor, ffi::Array<int64_t>>> cached_buffers_;
+  /*! \brief The signature of the plan resident in the buffers at each depth. */
+  std::vector<uint64_t> plan_signatures_;
   // MLA-only: the compressed-kv and key-positional-embedding head dims, used to
   // split q/pages in the run. Set during BeginForward for the kMLA attn kind.
   int64_t mla_head_dim_ckv_ = -1;
@@ -436,6 +599,25 @@ class FlashInferRaggedPrefillFunc : public RaggedPrefillFunc {
       v_head_dim = v_head_dim_override_;
       num_kv_heads = num_qo_heads;
     }
+    // Skip planning when the signature matches the plan already resident in
+    // these workspace buffers.
+    FlashInferPlanSignature sig;
+    sig.AddBufferIdentity(float_workspace_buffer);
+    sig.AddBufferIdentity(int_workspace_buffer);
+    sig.Add(static_cast<uint64_t>(batch_size));
+    sig.Add(static_cast<uint64_t>(total_qo_len));
+    sig.Add(static_cast<uint64_t>(num_qo_heads));
+    sig.Add(static_cast<uint64_t>(num_kv_heads));
+    sig.Add(static_cast<uint64_t>(qk_head_dim));
+    sig.Add(static_cast<uint64_t>(v_head_dim));
+    sig.Add(static_cast<uint64_t>(causal));
+    for (int i = 0; i < static_cast<int>(batch_size) + 1; ++i) {
+      sig.Add(static_cast<uint64_t>((*qo_indptr)[i]));
+      sig.Add(static_cast<uint64_t>((*kv_indptr)[i]));
+    }
+    if (plan_signature_ == sig.Value()) {
+      return;
+    }
     // FlashInfer expects kv_len as an (int32) tensor rather than a shape tuple.
     HostMemoryVector kv_len_arr(batch_size, DLDataType{kDLInt, 32, 1},
                                 qo_indptr->as_tensor()->device);
@@ -454,6 +636,7 @@ class FlashInferRaggedPrefillFunc : public RaggedPrefillFunc {
                    /*window_left=*/-1, /*fixed_split_size=*/-1, /*disable_split_kv=*/false,
                    /*num_colocated_ctas=*/0)
             .cast<ffi::Array<int64_t>>();
+    plan_signature_ = sig.Value();
   }
 
  private:
@@ -462,6 +645,8 @@ class FlashInferRaggedPrefillFunc : public RaggedPrefillFunc {
   Tensor int_workspace_buffer_;
   Tensor page_locked_int_workspace_buffer_;
   ffi::Array<int64_t> plan_info_vec_;
+  /*! \brief The signature of the plan resident in the workspace buffers. */
+  uint64_t plan_signature_ = 0;
   // MLA self-attention head dims supplied via the backend spec; -1 means use the
   // dims passed by the caller (the regular MHA case).
   int64_t qk_head_dim_override_ = -1;
@@ -496,6 +681,14 @@ class PagedDecodeFunc : public AttnBackendFunc {
                             TVMStreamHandle copy_stream) {
     // Do nothing. Subclasses can override to customize behavior.
   }
+
+  /*!
+   * \brief Drop the cached plan of the given depth, used when another
+   * function has since planned into the shared workspace buffers.
+   */
+  virtual void ResetPlanCache(int depth) {
+    // Do nothing. Subclasses caching plans can override to customize behavior.
+  }
 };
 
 /*! \brief The TIR-based paged decode attention function class. */
@@ -551,6 +744,31 @@ class FlashInferPagedDecodeFunc : public PagedDecodeFunc {
                     int64_t num_kv_heads, int64_t qk_head_dim, int64_t v_head_dim,
                     RoPEMode rope_mode, DLDataType q_dtype, DLDataType kv_dtype,
                     TVMStreamHandle copy_stream) final {
+    // Decode re-plans every step, yet under steady-state batching the
+    // per-request page counts only change when a sequence crosses a page
+    // boundary. Skip planning when the signature matches the plan already
+    // resident in these workspace buffers at this depth.
+    FlashInferPlanSignature sig;
+    sig.AddBufferIdentity(float_workspace_buffer);
+    sig.AddBufferIdentity(int_workspace_buffer);
+    sig.Add(static_cast<uint64_t>(batch_size));
+    sig.Add(static_cast<uint64_t>(page_size));
+    sig.Add(static_cast<uint64_t>(num_qo_heads));
+    sig.Add(static_cast<uint64_t>(num_kv_heads));
+    sig.Add(static_cast<uint64_t>(qk_head_dim));
+    sig.Add(static_cast<uint64_t>(v_head_dim));
+    sig.AddDataType(q_dtype);
+    sig.AddDataType(kv_dtype);
+    for (int i = 0; i < static_cast<int>(batch_size) + 1; ++i) {
+      sig.Add(static_cast<uint64_t>((*page_indptr)[i]));
+    }
+    if (plan_signatures_.size() <= static_cast<size_t>(depth)) {
+      plan_signatures_.resize(depth + 1, 0);
+    }
+    if (plan_signatures_[depth] == sig.Value()) {
+      return;
+    }
+
     // Todo(tvm-team): enable cuda graph
     // FlashInfer's decode plan takes empty q/kv tensors (used only for dtype
     // dispatch) instead of dtype scalars, adds a logits_soft_cap argument, and
@@ -571,11 +789,168 @@ class FlashInferPagedDecodeFunc : public PagedDecodeFunc {
     cached_buffers_[depth] =
         std::make_tuple(float_workspace_buffer, int_workspace_buffer,
                         page_locked_int_workspace_buffer, std::move(plan_info_vec));
+    plan_signatures_[depth] = sig.Value();
+  }
+
+  void ResetPlanCache(int depth) final {
+    if (static_cast<size_t>(depth) < plan_signatures_.size()) {
+      plan_signatures_[depth] = 0;
+    }
   }
 
  private:
   ffi::Function plan_func_;
   std::vector<std::tuple<Tensor, Tensor, Tensor, ffi::Array<int64_t>>> cached_buffers_;
+  /*! \brief The signature of the plan resident in the buffers at each depth. */
+  std::vector<uint64_t> plan_signatures_;
+};
+
+/*!
+ * \brief Collect the backend kinds of the given candidate functions.
+ * \note Used by the auto-select wrappers below.
+ */
+template <typename FuncObj>
+inline std::vector<AttnBackendKind> CandidateBackendKinds(
+    const std::vector<std::unique_ptr<FuncObj>>& candidates) {
+  std::vector<AttnBackendKind> kinds;
+  kinds.reserve(candidates.size());
+  for (const std::unique_ptr<FuncObj>& candidate : candidates) {
+    kinds.push_back(candidate->backend_kind);
+  }
+  return kinds;
+}
+
+/*!
+ * \brief Report the combined backend kind of the given candidate functions:
+ * FlashInfer when any candidate is FlashInfer-based, so that the KV cache
+ * runs the kernel "begin forward" planning required by that candidate.
+ */
+template <typename FuncObj>
+inline AttnBackendKind CombinedBackendKind(const std::vector<std::unique_ptr<FuncObj>>& candidates) {
+  for (const std::unique_ptr<FuncObj>& candidate : candidates) {
+    if (candidate->backend_kind == AttnBackendKind::kFlashInfer) {
+      return AttnBackendKind::kFlashInfer;
+    }
+  }
+  return AttnBackendKind::kTIR;
+}
+
+/*!
+ * \brief A paged prefill function wrapping multiple candidate backends,
+ * selecting the fastest one per shape bucket via a one-shot on-device
+ * microbenchmark (see AttnBackendAutoTuner).
+ */
+class AutoSelectPagedPrefillFunc : public PagedPrefillFunc {
+ public:
+  explicit AutoSelectPagedPrefillFunc(std::vector<std::unique_ptr<PagedPrefillFunc>> candidates)
+      : PagedPrefillFunc(ffi::Function(), candidates[0]->attn_kind,
+                         CombinedBackendKind(candidates)),
+        tuner_("paged_prefill", CandidateBackendKinds(candidates)),
+        candidates_(std::move(candidates)) {}
+
+  void MHA(int depth, Tensor q, Tensor qo_indptr, Tensor pages, Tensor page_indptr,
+           Tensor page_indices, Tensor length_info, Tensor q_rope_position,
+           Tensor k_rope_pos_offset, bool causal, RoPEMode rope_mode, double rotary_scale,
+           double rotary_theta, double sm_scale, Tensor attn_output, Tensor attn_lse,
+           TVMStreamHandle compute_stream) final {
+    tuner_.RunSelected("mha", q->shape[0], q->device, compute_stream, [&](int i) {
+      candidates_[i]->MHA(depth, q, qo_indptr, pages, page_indptr, page_indices, length_info,
+                          q_rope_position, k_rope_pos_offset, causal, rope_mode, rotary_scale,
+                          rotary_theta, sm_scale, attn_output, attn_lse, compute_stream);
+    });
+  }
+
+  void MLA(int depth, Tensor q, Tensor qo_indptr, Tensor pages, Tensor page_indptr,
+           Tensor page_indices, Tensor length_info, bool causal, double sm_scale,
+           Tensor attn_output, Tensor attn_lse, TVMStreamHandle compute_stream) final {
+    tuner_.RunSelected("mla", q->shape[0], q->device, compute_stream, [&](int i) {
+      candidates_[i]->MLA(depth, q, qo_indptr, pages, page_indptr, page_indices, length_info,
+                          causal, sm_scale, attn_output, attn_lse, compute_stream);
+    });
+  }
+
+  void BeginForward(int depth, Tensor float_workspace_buffer, Tensor int_workspace_buffer,
+                    Tensor page_locked_int_workspace_buffer, HostMemoryVector* qo_indptr,
+                    HostMemoryVector* page_indptr, HostMemoryVector* last_page_len,
+                    int64_t batch_size, int64_t total_qo_len, int64_t page_size,
+                    int64_t num_qo_heads, int64_t num_kv_heads, int64_t qk_head_dim,
+                    int64_t v_head_dim, bool causal, TVMStreamHandle copy_stream) final {
+    // Every candidate may be dispatched to, so all of them plan.
+    for (const std::unique_ptr<PagedPrefillFunc>& candidate : candidates_) {
+      candidate->BeginForward(depth, float_workspace_buffer, int_workspace_buffer,
+                              page_locked_int_workspace_buffer, qo_indptr, page_indptr,
+                              last_page_len, batch_size, total_qo_len, page_size, num_qo_heads,
+                              num_kv_heads, qk_head_dim, v_head_dim, causal, copy_stream);
+    }
+  }
+
+  void ResetPlanCache(int depth) final {
+    for (const std::unique_ptr<PagedPrefillFunc>& candidate : candidates_) {
+      candidate->ResetPlanCache(depth);
+    }
+  }
+
+ private:
+  AttnBackendAutoTuner tuner_;
+  std::vector<std::unique_ptr<PagedPrefillFunc>> candidates_;
+};
+
+/*!
+ * \brief A paged decode function wrapping multiple candidate backends,
+ * selecting the fastest one per shape bucket via a one-shot on-device
+ * microbenchmark (see AttnBackendAutoTuner).
+ */
+class AutoSelectPagedDecodeFunc : public PagedDecodeFunc {
+ public:
+  explicit AutoSelectPagedDecodeFunc(std::vector<std::unique_ptr<PagedDecodeFunc>> candidates)
+      : PagedDecodeFunc(ffi::Function(), candidates[0]->attn_kind, CombinedBackendKind(candidates)),
+        tuner_("paged_decode", CandidateBackendKinds(candidates)),
+        candidates_(std::move(candidates)) {}
+
+  void MHA(int depth, Tensor q, Tensor pages, Tensor page_indptr, Tensor page_indices,
+           Tensor length_info, Tensor k_rope_pos_offset, Tensor q_rope_position, RoPEMode rope_mode,
+           double rotary_scale, double rotary_theta, double sm_scale, Tensor attn_output,
+           Tensor attn_lse, TVMStreamHandle compute_stream) final {
+    tuner_.RunSelected("mha", q->shape[0], q->device, compute_stream, [&](int i) {
+      candidates_[i]->MHA(depth, q, pages, page_indptr, page_indices, length_info,
+                          k_rope_pos_offset, q_rope_position, rope_mode, rotary_scale, rotary_theta,
+                          sm_scale, attn_output, attn_lse, compute_stream);
+    });
+  }
+
+  void MLA(int depth, Tensor q, Tensor pages, Tensor page_indptr, Tensor page_indices,
+           Tensor length_info, double sm_scale, Tensor attn_output, Tensor attn_lse,
+           TVMStreamHandle compute_stream) final {
+    tuner_.RunSelected("mla", q->shape[0], q->device, compute_stream, [&](int i) {
+      candidates_[i]->MLA(depth, q, pages, page_indptr, page_indices, length_info, sm_scale,
+                          attn_output, attn_lse, compute_stream);
+    });
+  }
+
+  void BeginForward(int depth, Tensor float_workspace_buffer, Tensor int_workspace_buffer,
+                    Tensor page_locked_int_workspace_buffer, HostMemoryVector* page_indptr,
+                    int64_t batch_size, int64_t page_size, int64_t num_qo_heads,
+                    int64_t num_kv_heads, int64_t qk_head_dim, int64_t v_head_dim,
+                    RoPEMode rope_mode, DLDataType q_dtype, DLDataType kv_dtype,
+                    TVMStreamHandle copy_stream) final {
+    // Every candidate may be dispatched to, so all of them plan.
+    for (const std::unique_ptr<PagedDecodeFunc>& candidate : candidates_) {
+      candidate->BeginForward(depth, float_workspace_buffer, int_workspace_buffer,
+                              page_locked_int_workspace_buffer, page_indptr, batch_size, page_size,
+                              num_qo_heads, num_kv_heads, qk_head_dim, v_head_dim, rope_mode,
+                              q_dtype, kv_dtype, copy_stream);
+    }
+  }
+
+  void ResetPlanCache(int depth) final {
+    for (const std::unique_ptr<PagedDecodeFunc>& candidate : candidates_) {
+      candidate->ResetPlanCache(depth);
+    }
+  }
+
+ private:
+  AttnBackendAutoTuner tuner_;
+  std::vector<std::unique_ptr<PagedDecodeFunc>> candidates_;
 };
 
 /*! \brief The paged prefill with tree mask attention function base class. */
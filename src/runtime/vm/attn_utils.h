@@ -39,6 +39,8 @@
 #include "../../backend/opencl/runtime/opencl_common.h"
 #endif
 
+#include "kv_state.h"
+
 namespace tvm {
 namespace runtime {
 namespace vm {
@@ -360,14 +362,22 @@ class HostMemoryVector {
   explicit HostMemoryVector(int64_t reserved_size, DLDataType dtype, Device device)
       : reserved_size_(reserved_size) {
     TVM_FFI_ICHECK((dtype == DLDataType{kDLInt, 32, 1}));
-    data_ = Tensor::Empty({reserved_size}, dtype, device);
+    data_ = AuxBufferPool::Global()->Alloc({reserved_size}, dtype, device);
+  }
+
+  ~HostMemoryVector() {
+    // Return the pinned buffer to the pool so that the next cache instance
+    // skips the host allocation.
+    if (data_.defined()) {
+      AuxBufferPool::Global()->Recycle(std::move(data_));
+    }
   }
 
   void push_back(int32_t value) {
     TVM_FFI_ICHECK_LE(current_size_, reserved_size_);
     if (current_size_ == reserved_size_) {
       reserved_size_ *= 2;
-      Tensor new_data = Tensor::Empty({reserved_size_}, data_->dtype, data_->device);
+      Tensor new_data = AuxBufferPool::Global()->Alloc({reserved_size_}, data_->dtype, data_->device);
       std::memcpy(new_data->data, data_->data, current_size_ * (((data_->dtype).bits + 7) / 8));
       data_ = new_data;
     }
@@ -381,7 +391,7 @@ class HostMemoryVector {
       while (current_size_ + num_new_elements > reserved_size_) {
         reserved_size_ *= 2;
       }
-      Tensor new_data = Tensor::Empty({reserved_size_}, data_->dtype, data_->device);
+      Tensor new_data = AuxBufferPool::Global()->Alloc({reserved_size_}, data_->dtype, data_->device);
       std::memcpy(new_data->data, data_->data, current_size_ * (((data_->dtype).bits + 7) / 8));
       data_ = new_data;
     }
@@ -827,7 +837,8 @@ class CachedPagedKVCacheAuxDataManager : public PagedKVCacheAuxDataManager {
     merged_attn_aux_data_host_ =
         HostMemoryVector(attn_aux_data_cache_size, dtype_aux, preferred_host_device);
     // - Initialize the device auxiliary data buffer.
-    merged_attn_aux_data_device_ = Tensor::Empty({attn_aux_data_cache_size}, dtype_aux, device);
+    merged_attn_aux_data_device_ =
+        AuxBufferPool::Global()->Alloc({attn_aux_data_cache_size}, dtype_aux, device);
 
     // - Calculate cache size of all the compact KV auxiliary arrays in
     // local cache and the large on-device array.
@@ -837,7 +848,12 @@ class CachedPagedKVCacheAuxDataManager : public PagedKVCacheAuxDataManager {
     merged_compact_kv_aux_data_host_ =
         HostMemoryVector(compact_kv_aux_data_cache_size, dtype_aux, preferred_host_device);
     merged_compact_kv_aux_data_device_ =
-        Tensor::Empty({compact_kv_aux_data_cache_size}, dtype_aux, device);
+        AuxBufferPool::Global()->Alloc({compact_kv_aux_data_cache_size}, dtype_aux, device);
+  }
+
+  ~CachedPagedKVCacheAuxDataManager() {
+    AuxBufferPool::Global()->Recycle(std::move(merged_attn_aux_data_device_));
+    AuxBufferPool::Global()->Recycle(std::move(merged_compact_kv_aux_data_device_));
   }
 
   void ResetAttnAuxDataCopy() final { attn_aux_data_copy_offset_ = 0; }
@@ -34,7 +34,14 @@
 #include <tvm/runtime/vm/bytecode.h>
 #include <tvm/runtime/vm/vm.h>
 
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
 
 namespace tvm {
 namespace runtime {
@@ -545,6 +552,12 @@ TVM_FFI_STATIC_INIT_BLOCK() {
            [](ffi::Any any, ffi::Shape new_shape) {
              if (auto opt_tensor = any.try_cast<Tensor>()) {
                Tensor data = opt_tensor.value();
+               // A same-shape reshape is an identity view over the same buffer, so the
+               // tensor can be returned as-is without a new view container.
+               if (static_cast<size_t>(data->ndim) == new_shape.size() &&
+                   std::equal(new_shape.begin(), new_shape.end(), data->shape)) {
+                 return data;
+               }
                return data.CreateView(new_shape, data->dtype);
              } else if (auto opt_dltensor = any.try_cast<DLTensor*>()) {
                DLTensor* ptr = opt_dltensor.value();
@@ -574,6 +587,178 @@ TVM_FFI_STATIC_INIT_BLOCK() {
       });
 }
 
+//-------------------------------------
+//  Asynchronous device transfer.
+//-------------------------------------
+
+/*!
+ * \brief Table of per-device copy streams and in-flight transfers used by the
+ * asynchronous transfer builtins.
+ *
+ * Copies issued by `vm.builtin.to_device_async` run on a dedicated copy stream
+ * of the device performing the transfer, so that kernels issued afterwards on
+ * the compute stream overlap with the copy. The destination tensor is tracked
+ * as in flight until `vm.builtin.device_transfer_wait` synchronizes the
+ * consumer with the copy stream.
+ */
+class TransferStreamTable {
+ public:
+  static TransferStreamTable* Global() {
+    static TransferStreamTable* inst = new TransferStreamTable();
+    return inst;
+  }
+
+  TVMStreamHandle GetCopyStream(Device dev) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto key = std::make_pair(static_cast<int>(dev.device_type), dev.device_id);
+    auto it = streams_.find(key);
+    if (it != streams_.end()) {
+      return it->second;
+    }
+    TVMStreamHandle stream = DeviceAPI::Get(dev)->CreateStream(dev);
+    streams_[key] = stream;
+    return stream;
+  }
+
+  void MarkInFlight(const void* data, Device stream_device) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    in_flight_[data] = stream_device;
+  }
+
+  std::optional<Device> TakeInFlight(const void* data) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = in_flight_.find(data);
+    if (it == in_flight_.end()) {
+      return std::nullopt;
+    }
+    Device dev = it->second;
+    in_flight_.erase(it);
+    return dev;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::map<std::pair<int, int>, TVMStreamHandle> streams_;
+  std::unordered_map<const void*, Device> in_flight_;
+};
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef()
+      .def("vm.builtin.to_device_async",
+           [](Tensor data, int dev_type, int dev_id) -> Tensor {
+             Device dst_device = {(DLDeviceType)dev_type, dev_id};
+             // Pick the device that actually performs the copy, mirroring
+             // Tensor::CopyFromTo. A pure host-to-host copy has no stream to
+             // overlap with and stays synchronous.
+             Device stream_device =
+                 data->device.device_type != kDLCPU ? data->device : dst_device;
+             if (stream_device.device_type == kDLCPU) {
+               return data.CopyTo(dst_device);
+             }
+             DeviceAPI* api = DeviceAPI::Get(stream_device);
+             TVMStreamHandle copy_stream =
+                 TransferStreamTable::Global()->GetCopyStream(stream_device);
+             // The copy may only read its source once the producer on the
+             // compute stream has finished writing it.
+             api->SyncStreamFromTo(stream_device, api->GetCurrentStream(stream_device),
+                                   copy_stream);
+             Tensor result = Tensor::Empty(data.Shape(), data->dtype, dst_device);
+             Tensor::CopyFromTo(data.operator->(), const_cast<DLTensor*>(result.operator->()),
+                                copy_stream);
+             TransferStreamTable::Global()->MarkInFlight(result->data, stream_device);
+             return result;
+           })
+      .def("vm.builtin.device_transfer_wait", [](Tensor data) -> Tensor {
+        auto in_flight = TransferStreamTable::Global()->TakeInFlight(data->data);
+        if (!in_flight.has_value()) {
+          return data;
+        }
+        Device stream_device = in_flight.value();
+        DeviceAPI* api = DeviceAPI::Get(stream_device);
+        TVMStreamHandle copy_stream = TransferStreamTable::Global()->GetCopyStream(stream_device);
+        if (data->device.device_type == stream_device.device_type) {
+          // The consumer runs on the same device type, so an event wait on the
+          // compute stream is enough and the host does not block.
+          api->SyncStreamFromTo(stream_device, copy_stream, api->GetCurrentStream(stream_device));
+        } else {
+          // The data was copied to another device type (e.g. back to the
+          // host); block until the copy has landed.
+          api->StreamSync(stream_device, copy_stream);
+        }
+        return data;
+      });
+}
+
+//-------------------------------------
+//  Multi-stream compute dispatch.
+//-------------------------------------
+
+/*!
+ * \brief Pool of numbered per-device compute streams used by the stream
+ * assignment builtins emitted by AssignComputeStreams.
+ *
+ * Index 0 stands for the device's default stream and is never created; higher
+ * indices are created lazily on first use and live for the process lifetime,
+ * like the copy streams above.
+ */
+class ComputeStreamPool {
+ public:
+  static ComputeStreamPool* Global() {
+    static ComputeStreamPool* inst = new ComputeStreamPool();
+    return inst;
+  }
+
+  TVMStreamHandle GetStream(Device dev, int64_t index) {
+    if (index == 0) {
+      return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto key = std::make_tuple(static_cast<int>(dev.device_type), dev.device_id, index);
+    auto it = streams_.find(key);
+    if (it != streams_.end()) {
+      return it->second;
+    }
+    TVMStreamHandle stream = DeviceAPI::Get(dev)->CreateStream(dev);
+    streams_[key] = stream;
+    return stream;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::map<std::tuple<int, int, int64_t>, TVMStreamHandle> streams_;
+};
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef()
+      .def("vm.builtin.stream_switch",
+           [](Tensor data, int64_t index) -> Tensor {
+             Device dev = data->device;
+             // Host-resident chains have nothing to overlap: kernel launch
+             // streams only exist on devices.
+             if (dev.device_type == kDLCPU) {
+               return data;
+             }
+             DeviceAPI::Get(dev)->SetStream(dev,
+                                            ComputeStreamPool::Global()->GetStream(dev, index));
+             return data;
+           })
+      .def("vm.builtin.stream_join",
+           [](Tensor data, int64_t src_index, int64_t dst_index) -> Tensor {
+             Device dev = data->device;
+             if (dev.device_type == kDLCPU || src_index == dst_index) {
+               return data;
+             }
+             // Event join: work issued on dst after this call waits for the
+             // work issued on src so far, without blocking the host.
+             DeviceAPI::Get(dev)->SyncStreamFromTo(
+                 dev, ComputeStreamPool::Global()->GetStream(dev, src_index),
+                 ComputeStreamPool::Global()->GetStream(dev, dst_index));
+             return data;
+           });
+}
+
 /*!
  * \brief Load the scalar value in cond and return the result value.
  * \param cond The condition
@@ -731,6 +916,91 @@ TVM_FFI_STATIC_INIT_BLOCK() {
       });
 }
 
+//-------------------------------------
+//  Unchecked builtin trampolines.
+//-------------------------------------
+/*!
+ * \brief Read one call argument of a statically-proven type from its ffi slot.
+ *
+ * The generic builtin registrations above go through the full ffi argument
+ * translation, which dispatches on the runtime type of every argument on
+ * every call. The trampolines below are generated from the C++ signature at
+ * compile time instead: POD arguments are read straight out of the raw
+ * `TVMFFIAny` payload, and object arguments are handed to the builtin as raw
+ * pointers, so no reference count is touched for the duration of the call;
+ * the register holding the argument keeps it alive. The codegen only selects
+ * a trampoline at call sites whose checked type already proves the argument
+ * kinds (see `SelectUncheckedVMBuiltin`), and the single ICHECK left on
+ * object arguments turns a wrong selection into a clean error instead of
+ * undefined behavior.
+ */
+template <typename T>
+inline T UncheckedArg(const ffi::AnyView& view) {
+  if constexpr (std::is_same_v<T, int64_t>) {
+    return reinterpret_cast<const TVMFFIAny*>(&view)->v_int64;
+  } else if constexpr (std::is_same_v<T, double>) {
+    return reinterpret_cast<const TVMFFIAny*>(&view)->v_float64;
+  } else {
+    static_assert(std::is_pointer_v<T>, "unsupported trampoline argument type");
+    using TObj = std::remove_const_t<std::remove_pointer_t<T>>;
+    const TObj* ptr = view.as<TObj>();
+    TVM_FFI_ICHECK(ptr != nullptr) << "Unchecked builtin trampoline called with a "
+                                   << view.GetTypeKey() << " argument";
+    return ptr;
+  }
+}
+
+/*! \brief The packed trampoline for a builtin with the signature R(Args...). */
+template <typename R, typename... Args>
+class UncheckedTrampoline {
+ public:
+  explicit UncheckedTrampoline(R (*func)(Args...)) : func_(func) {}
+
+  void operator()(ffi::PackedArgs args, ffi::Any* rv) const {
+    TVM_FFI_ICHECK_EQ(args.size(), static_cast<int>(sizeof...(Args)));
+    Apply(args, rv, std::index_sequence_for<Args...>{});
+  }
+
+ private:
+  template <size_t... I>
+  void Apply(ffi::PackedArgs args, ffi::Any* rv, std::index_sequence<I...>) const {
+    *rv = func_(UncheckedArg<Args>(args[I])...);
+  }
+
+  R (*func_)(Args...);
+};
+
+/*! \brief `vm.builtin.shape_of` specialized to a tensor argument. */
+ffi::Shape UncheckedShapeOf(const ffi::TensorObj* tensor) {
+  const DLTensor* dl_tensor = tensor;
+  return ffi::Shape(dl_tensor->shape, dl_tensor->shape + dl_tensor->ndim);
+}
+
+/*! \brief `vm.builtin.reshape` specialized to tensor and shape arguments. */
+Tensor UncheckedReshape(const ffi::TensorObj* tensor, const ffi::ShapeObj* shape_obj) {
+  Tensor data = ffi::GetRef<Tensor>(tensor);
+  ffi::Shape new_shape = ffi::GetRef<ffi::Shape>(shape_obj);
+  // A same-shape reshape is an identity view over the same buffer, so the
+  // tensor can be returned as-is without a new view container.
+  if (static_cast<size_t>(data->ndim) == new_shape.size() &&
+      std::equal(new_shape.begin(), new_shape.end(), data->shape)) {
+    return data;
+  }
+  return data.CreateView(new_shape, data->dtype);
+}
+
+/*! \brief `vm.builtin.tuple_getitem` specialized to a tuple argument. */
+ffi::Any UncheckedTupleGetItem(const ffi::ArrayObj* arr, int64_t index) { return arr->at(index); }
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef()
+      .def_packed("vm.builtin.shape_of.unchecked", UncheckedTrampoline(&UncheckedShapeOf))
+      .def_packed("vm.builtin.reshape.unchecked", UncheckedTrampoline(&UncheckedReshape))
+      .def_packed("vm.builtin.tuple_getitem.unchecked",
+                  UncheckedTrampoline(&UncheckedTupleGetItem));
+}
+
 }  // namespace vm
 }  // namespace runtime
 }  // namespace tvm
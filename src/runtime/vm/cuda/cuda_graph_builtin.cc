@@ -200,6 +200,67 @@ class CUDAGraphExtensionNode : public VMExtensionNode {
     return states;
   }
 
+  /*!
+   * \brief Launch the whole-function CUDA graph of the given key if it has been
+   * cached, otherwise invoke the closure in capture mode and cache the graph.
+   *
+   * Unlike RunOrCapture, which captures compiler-outlined regions, this entry
+   * records one entire VM function invocation (e.g. a full decode step) as a
+   * single graph. Replays re-run the captured kernels on the captured buffers,
+   * so the caller must pass the same argument tensors on every invocation with
+   * the given key and refill them before each call, and the closure must not
+   * perform shape- or data-dependent host-side work that varies between calls
+   * sharing a key. Every varying shape (e.g. the padded batch size bucket)
+   * must be part of \p shape_key.
+   *
+   * \param vm The virtual machine.
+   * \param func The closure to run or capture.
+   * \param call_args The arguments of the closure.
+   * \param name The name identifying the closure in the capture cache.
+   * \param shape_key The shape bucket the capture is specialized on.
+   * \return The return value of the closure, which stays the same captured
+   * objects across replays of one key.
+   */
+  ffi::ObjectRef RunOrCaptureWholeFunc(VirtualMachine* vm, const ffi::ObjectRef& func,
+                                       ffi::PackedArgs call_args, const ffi::String& name,
+                                       const ffi::Shape& shape_key) {
+    std::string entry_key = std::string(name);
+    for (int64_t dim : shape_key) {
+      entry_key += ":" + std::to_string(dim);
+    }
+    if (auto it = whole_func_capture_cache_.find(entry_key);
+        it != whole_func_capture_cache_.end()) {
+      // Launch CUDA graph
+      const auto& [states, exec] = it->second;
+      int device_id;
+      TVM_FFI_CHECK_CUDA_ERROR(cudaGetDevice(&device_id));
+      TVM_FFI_CHECK_CUDA_ERROR(
+          cudaGraphLaunch(exec, static_cast<cudaStream_t>(TVMFFIEnvGetStream(kDLCUDA, device_id))));
+      return states;
+    }
+
+    ffi::Any func_rv;
+    // Run the function without CUDA graph. This is a warm up step to do necessary initialization
+    // of the CUDA module such as loading module data, setting kernel attributes.
+    vm->InvokeClosurePacked(func, call_args, &func_rv);
+
+    // Run the function in capture mode
+    cudaGraph_t graph;
+    {
+      CUDACaptureStream capture_stream(&graph);
+      vm->InvokeClosurePacked(func, call_args, &func_rv);
+    }
+
+    CUDAGraphCapturedState entry;
+    entry.states = func_rv.cast<ffi::ObjectRef>();
+    TVM_FFI_CHECK_CUDA_ERROR(cudaGraphInstantiate(&entry.exec, graph, NULL, NULL, 0));
+    TVM_FFI_CHECK_CUDA_ERROR(cudaGraphDestroy(graph));
+
+    ffi::ObjectRef states = entry.states;
+    whole_func_capture_cache_[entry_key] = std::move(entry);
+    return states;
+  }
+
   /*!
    * \brief Get the cached allocation from the cache or run the allocation function.
    * \param vm The virtual machine.
@@ -236,6 +297,11 @@ class CUDAGraphExtensionNode : public VMExtensionNode {
    * The value is the cached allocations, which is a tuple of storages.
    */
   std::unordered_map<int64_t, ffi::ObjectRef> alloc_cache_;
+  /*!
+   * \brief The cache of whole-function captures. The key is the closure name
+   * concatenated with the shape bucket the capture is specialized on.
+   */
+  std::unordered_map<std::string, CUDAGraphCapturedState> whole_func_capture_cache_;
 };
 
 /*! Managed reference to CUDAGraphExtensionNode */
@@ -267,6 +333,17 @@ TVM_FFI_STATIC_INIT_BLOCK() {
                     *rv = extension->RunOrCapture(vm, capture_func, func_args, entry_index,
                                                   shape_expr);
                   })
+      .def_packed("vm.builtin.cuda_graph.run_or_capture_whole_func",
+                  [](ffi::PackedArgs args, ffi::Any* rv) {
+                    TVM_FFI_ICHECK_GE(args.size(), 4);
+                    VirtualMachine* vm = VirtualMachine::GetContextPtr(args[0]);
+                    auto extension = vm->GetOrCreateExtension<CUDAGraphExtension>();
+                    auto func = args[1].cast<ffi::ObjectRef>();
+                    ffi::String name = args[2].cast<ffi::String>();
+                    ffi::Shape shape_key = args[3].cast<ffi::Shape>();
+                    *rv = extension->RunOrCaptureWholeFunc(vm, func, args.Slice(4), name,
+                                                           shape_key);
+                  })
       .def_packed("vm.builtin.cuda_graph.get_cached_alloc", [](ffi::PackedArgs args, ffi::Any* rv) {
         TVM_FFI_ICHECK_EQ(args.size(), 3);
         VirtualMachine* vm = VirtualMachine::GetContextPtr(args[0]);
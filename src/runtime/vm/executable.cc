@@ -28,10 +28,16 @@
 #include <tvm/runtime/vm/vm.h>
 #include <tvm/support/io.h>
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <functional>
 #include <sstream>
+#include <string>
+#include <vector>
 
 #include "../../support/bytes_io.h"
+#include "../../support/mmap_file.h"
 #include "../file_utils.h"
 #include "./module_utils.h"
 
@@ -42,6 +48,8 @@ namespace vm {
 /*! \brief The magic number for the serialized VM bytecode file  */
 constexpr uint64_t kTVMVMBytecodeMagic = 0xD225DE2F4214151D;
 constexpr uint64_t kTVMVMBytecodeMagicV2 = 0xD225DE2F4214151E;
+/*! \brief V3 stores the code section with variable-width instruction words. */
+constexpr uint64_t kTVMVMBytecodeMagicV3 = 0xD225DE2F4214151F;
 
 #define STREAM_CHECK(val, section)                                                  \
   TVM_FFI_ICHECK(val) << "Invalid VM file format in the " << section << " section." \
@@ -58,6 +66,7 @@ ffi::Optional<ffi::Function> VMExecutable::GetFunction(const ffi::String& _name)
   TVM_MODULE_VTABLE_ENTRY("as_python", &VMExecutable::AsPython);
   TVM_MODULE_VTABLE_ENTRY("vm_load_executable", &VMExecutable::VMLoadExecutable);
   TVM_MODULE_VTABLE_ENTRY("has_function", &VMExecutable::HasFunction);
+  TVM_MODULE_VTABLE_ENTRY("used_global_func_names", &VMExecutable::UsedGlobalFuncNames);
   return std::nullopt;
 }
 
@@ -160,7 +169,7 @@ Instruction VMExecutable::GetInstruction(Index i) const {
 }
 
 void SaveHeader(support::Stream* strm) {
-  uint64_t header = kTVMVMBytecodeMagicV2;
+  uint64_t header = kTVMVMBytecodeMagicV3;
   strm->Write(header);
   std::string version = VM_VERSION;
   strm->Write(version);
@@ -170,7 +179,9 @@ uint64_t LoadHeader(support::Stream* strm) {
   // Check header.
   uint64_t header;
   STREAM_CHECK(strm->Read(&header), "header");
-  STREAM_CHECK((header == kTVMVMBytecodeMagic) || (header == kTVMVMBytecodeMagicV2), "header");
+  STREAM_CHECK((header == kTVMVMBytecodeMagic) || (header == kTVMVMBytecodeMagicV2) ||
+                   (header == kTVMVMBytecodeMagicV3),
+               "header");
 
   // Check version.
   std::string version;
@@ -202,6 +213,25 @@ ffi::Bytes VMExecutable::SaveToBytes() const {
   return ffi::Bytes(std::move(result));
 }
 
+ffi::Bytes VMExecutable::SaveToBytesLegacy() const {
+  std::string result;
+  support::BytesOutStream strm(&result);
+
+  uint64_t header = kTVMVMBytecodeMagicV2;
+  strm.Write(header);
+  std::string version = VM_VERSION;
+  strm.Write(version);
+
+  SaveGlobalSection(&strm);
+  SaveMemoryScopeSection(&strm);
+  SaveConstantSection(&strm);
+  // The V2 code section stored the fixed-width words directly.
+  strm.Write(instr_offset);
+  strm.Write(instr_data);
+
+  return ffi::Bytes(std::move(result));
+}
+
 void VMExecutable::WriteToFile(const ffi::String& file_name, const ffi::String& format) const {
   runtime::SaveBinaryToFile(file_name, VMExecutable::SaveToBytes());
 }
@@ -217,7 +247,7 @@ ffi::Module VMExecutable::LoadFromBytes(const ffi::Bytes& bytes) {
   // Global section.
   exec->LoadGlobalSection(&strm);
 
-  if (kTVMVMBytecodeMagicV2 == header_magic) {
+  if (header_magic != kTVMVMBytecodeMagic) {
     // Memory Scopes
     exec->LoadMemoryScopeSection(&strm);
   }
@@ -226,12 +256,140 @@ ffi::Module VMExecutable::LoadFromBytes(const ffi::Bytes& bytes) {
   exec->LoadConstantSection(&strm);
 
   // Code section.
-  exec->LoadCodeSection(&strm);
+  exec->LoadCodeSection(&strm, header_magic);
 
   return ffi::Module(exec);
 }
 
+/*!
+ * \brief Load one Tensor constant from a mapped executable.
+ *
+ * When the payload is suitably aligned the returned Tensor aliases the mapped
+ * pages zero-copy, with the mapping kept alive through the tensor deleter;
+ * otherwise the payload is copied as in Tensor::Load.
+ */
+Tensor LoadTensorMapped(support::BytesInStream* strm,
+                        const std::shared_ptr<support::MMapFile>& mapping) {
+  uint64_t header, reserved;
+  STREAM_CHECK(strm->Read(&header), "constant");
+  STREAM_CHECK(strm->Read(&reserved), "constant");
+  STREAM_CHECK(header == kTVMTensorMagic, "constant");
+  Device dev;
+  int ndim;
+  DLDataType dtype;
+  STREAM_CHECK(strm->Read(&dev), "constant");
+  STREAM_CHECK(strm->Read(&ndim), "constant");
+  STREAM_CHECK(strm->Read(&dtype), "constant");
+  STREAM_CHECK(dev.device_type == kDLCPU, "constant");
+  std::vector<int64_t> shape(ndim);
+  if (ndim != 0) {
+    STREAM_CHECK(strm->ReadArray(shape.data(), ndim), "constant");
+  }
+  int64_t data_byte_size;
+  STREAM_CHECK(strm->Read(&data_byte_size), "constant");
+
+  int elem_bytes = (dtype.bits * dtype.lanes + 7) / 8;
+  char* payload = mapping->data() + strm->Tell();
+  if (TVM_FFI_IO_NO_ENDIAN_SWAP &&
+      reinterpret_cast<uintptr_t>(payload) % std::max(elem_bytes, 1) == 0) {
+    auto* holder = new std::shared_ptr<support::MMapFile>(mapping);
+    auto* managed = new DLManagedTensor();
+    managed->manager_ctx = holder;
+    managed->deleter = [](DLManagedTensor* self) {
+      delete[] self->dl_tensor.shape;
+      delete static_cast<std::shared_ptr<support::MMapFile>*>(self->manager_ctx);
+      delete self;
+    };
+    DLTensor& dl = managed->dl_tensor;
+    dl.data = payload;
+    dl.device = dev;
+    dl.ndim = ndim;
+    dl.dtype = dtype;
+    dl.shape = new int64_t[ndim];
+    std::copy(shape.begin(), shape.end(), dl.shape);
+    dl.strides = nullptr;
+    dl.byte_offset = 0;
+    strm->Seek(strm->Tell() + data_byte_size);
+    return tvm::ffi::Tensor::FromDLPack(managed, /*require_alignment=*/0,
+                                        /*require_contiguous=*/true);
+  }
+  // misaligned or endian-swapping build: fall back to a copying load.
+  Tensor ret = Tensor::Empty(ffi::Shape(shape), dtype, dev);
+  STREAM_CHECK(strm->Read(ret->data, data_byte_size) == static_cast<size_t>(data_byte_size) ||
+                   data_byte_size == 0,
+               "constant");
+  if (!TVM_FFI_IO_NO_ENDIAN_SWAP) {
+    int64_t num_elems = data_byte_size / std::max(elem_bytes, 1);
+    ffi::ByteSwap(ret->data, elem_bytes, num_elems);
+  }
+  return ret;
+}
+
+/*!
+ * \brief Constant-section loader for the mapped path.
+ *
+ * The wire format matches LoadConstantSection; only Tensor entries are handled
+ * differently, so large parameters alias the mapping instead of being copied.
+ */
+void LoadConstantSectionMapped(VMExecutable* exec, support::BytesInStream* strm,
+                               const std::shared_ptr<support::MMapFile>& mapping) {
+  uint64_t sz;
+  STREAM_CHECK(strm->Read(&sz, sizeof(sz)), "constant");
+  size_t size = static_cast<size_t>(sz);
+  for (size_t i = 0; i < size; i++) {
+    int constant_type;
+    STREAM_CHECK(strm->Read(&constant_type, sizeof(constant_type)), "constant");
+    if (constant_type == ffi::TypeIndex::kTVMFFITensor) {
+      exec->constants.push_back(LoadTensorMapped(strm, mapping));
+    } else if (constant_type == ffi::TypeIndex::kTVMFFIShape) {
+      uint64_t size;
+      strm->Read(&size);
+      std::vector<ffi::Shape::index_type> data(size);
+      strm->ReadArray(data.data(), size);
+      exec->constants.push_back(ffi::Any(ffi::Shape(data)));
+    } else if (constant_type == ffi::TypeIndex::kTVMFFIDataType) {
+      DLDataType dtype;
+      strm->Read(&dtype);
+      exec->constants.push_back(ffi::Any(dtype));
+    } else if (constant_type == ffi::TypeIndex::kTVMFFIStr) {
+      uint64_t size;
+      strm->Read(&size);
+      std::vector<char> data(size);
+      STREAM_CHECK(strm->ReadArray(reinterpret_cast<uint8_t*>(data.data()), size),
+                   "constant string");
+      exec->constants.push_back(ffi::Any(ffi::String(std::string(data.begin(), data.end()))));
+    } else if (constant_type == ffi::TypeIndex::kTVMFFIInt) {
+      int64_t value;
+      strm->Read(&value);
+      exec->constants.push_back(ffi::Any(value));
+    } else if (constant_type == ffi::TypeIndex::kTVMFFIFloat) {
+      double value;
+      strm->Read(&value);
+      exec->constants.push_back(ffi::Any(value));
+    } else {
+      TVM_FFI_THROW(InternalError)
+          << "Constant pool can only contain Tensor and DLDataType, but got "
+          << ffi::TypeIndexToTypeKey(constant_type) << " when loading the VM constant pool.";
+    }
+  }
+}
+
 ffi::Module VMExecutable::LoadFromFile(const ffi::String& file_name) {
+  // Prefer a read-only mapping of the executable: Tensor constants then alias
+  // the mapped pages zero-copy, are lazily paged in on first touch, and their
+  // clean pages are shared across processes through the page cache.
+  if (auto mapping = support::MMapFile::Open(file_name)) {
+    support::BytesInStream strm(mapping->data(), mapping->size());
+    ffi::ObjectPtr<VMExecutable> exec = ffi::make_object<VMExecutable>();
+    uint64_t header_magic = LoadHeader(&strm);
+    exec->LoadGlobalSection(&strm);
+    if (header_magic != kTVMVMBytecodeMagic) {
+      exec->LoadMemoryScopeSection(&strm);
+    }
+    LoadConstantSectionMapped(exec.get(), &strm, mapping);
+    exec->LoadCodeSection(&strm, header_magic);
+    return ffi::Module(exec);
+  }
   std::string data;
   runtime::LoadBinaryFromFile(file_name, &data);
   return VMExecutable::LoadFromBytes(ffi::Bytes(data));
@@ -312,9 +470,60 @@ void VMExecutable::SaveConstantSection(support::Stream* strm) const {
   }
 }
 
+// The V3 code section stores instruction words as variable-width integers:
+// a word is rotated left by eight bits, so the kind tag that argument words
+// keep in their top byte lands in the low bits, then zigzag-encoded. Small
+// tagged operands, plain small values and sign-extended negative offsets all
+// become one- or two-byte varints, while a fixed-width word costs eight.
+void WriteInstrVarInt(support::Stream* strm, uint64_t value) {
+  while (value >= 0x80) {
+    uint8_t byte = static_cast<uint8_t>(value) | 0x80;
+    strm->Write(&byte, 1);
+    value >>= 7;
+  }
+  uint8_t byte = static_cast<uint8_t>(value);
+  strm->Write(&byte, 1);
+}
+
+bool ReadInstrVarInt(support::Stream* strm, uint64_t* out) {
+  uint64_t value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    uint8_t byte;
+    if (strm->Read(&byte, 1) != 1) return false;
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      *out = value;
+      return true;
+    }
+  }
+  return false;
+}
+
+uint64_t EncodeInstrWord(ExecWord word) {
+  uint64_t raw = static_cast<uint64_t>(word);
+  int64_t rotated = static_cast<int64_t>((raw << 8) | (raw >> 56));
+  return (static_cast<uint64_t>(rotated) << 1) ^ static_cast<uint64_t>(rotated >> 63);
+}
+
+ExecWord DecodeInstrWord(uint64_t encoded) {
+  uint64_t rotated = (encoded >> 1) ^ (~(encoded & 1) + 1);
+  return static_cast<ExecWord>((rotated >> 8) | (rotated << 56));
+}
+
 void VMExecutable::SaveCodeSection(support::Stream* strm) const {
-  strm->Write(instr_offset);
-  strm->Write(instr_data);
+  uint64_t num_offsets = instr_offset.size();
+  strm->Write(num_offsets);
+  // Offsets are monotone; deltas are small.
+  Index prev = 0;
+  for (Index offset : instr_offset) {
+    WriteInstrVarInt(strm, static_cast<uint64_t>(offset - prev));
+    prev = offset;
+  }
+  uint64_t num_words = instr_data.size();
+  strm->Write(num_words);
+  for (ExecWord word : instr_data) {
+    WriteInstrVarInt(strm, EncodeInstrWord(word));
+  }
 }
 
 void VMExecutable::LoadGlobalSection(support::Stream* strm) {
@@ -401,9 +610,32 @@ void VMExecutable::LoadConstantSection(support::Stream* strm) {
   }
 }
 
-void VMExecutable::LoadCodeSection(support::Stream* strm) {
-  STREAM_CHECK(strm->Read(&(this->instr_offset)), "instr offset");
-  STREAM_CHECK(strm->Read(&(this->instr_data)), "instr data");
+void VMExecutable::LoadCodeSection(support::Stream* strm, uint64_t header_magic) {
+  if (header_magic != kTVMVMBytecodeMagicV3) {
+    STREAM_CHECK(strm->Read(&(this->instr_offset)), "instr offset");
+    STREAM_CHECK(strm->Read(&(this->instr_data)), "instr data");
+    return;
+  }
+  // Decode the compact stream once into the fixed-width in-memory form, so
+  // dispatch never pays for the variable-width encoding.
+  uint64_t num_offsets;
+  STREAM_CHECK(strm->Read(&num_offsets), "instr offset");
+  this->instr_offset.resize(num_offsets);
+  Index prev = 0;
+  for (uint64_t i = 0; i < num_offsets; ++i) {
+    uint64_t delta;
+    STREAM_CHECK(ReadInstrVarInt(strm, &delta), "instr offset");
+    prev += static_cast<Index>(delta);
+    this->instr_offset[i] = prev;
+  }
+  uint64_t num_words;
+  STREAM_CHECK(strm->Read(&num_words), "instr data");
+  this->instr_data.resize(num_words);
+  for (uint64_t i = 0; i < num_words; ++i) {
+    uint64_t encoded;
+    STREAM_CHECK(ReadInstrVarInt(strm, &encoded), "instr data");
+    this->instr_data[i] = DecodeInstrWord(encoded);
+  }
 }
 
 template <typename T>
@@ -430,14 +662,196 @@ std::string RegNameToStr(RegName reg) {
   return "%" + std::to_string(reg);
 }
 
+/*!
+ * \brief Pick the dispatch mode for a freshly loaded VM.
+ *
+ * TVM_VM_DISPATCH_MODE=direct_threaded selects the computed-goto interpreter
+ * loop without rebuilding callers; any other value (or none) keeps the switch
+ * loop. Builds without computed-goto support silently fall back to the switch
+ * loop inside the VM itself.
+ */
+static VMDispatchMode DefaultDispatchMode() {
+  if (const char* val = std::getenv("TVM_VM_DISPATCH_MODE")) {
+    if (std::strcmp(val, "direct_threaded") == 0) {
+      return VMDispatchMode::kDirectThreaded;
+    }
+  }
+  return VMDispatchMode::kSwitch;
+}
+
 ffi::Module VMExecutable::VMLoadExecutable() const {
-  ffi::ObjectPtr<VirtualMachine> vm = VirtualMachine::Create();
+  ffi::ObjectPtr<VirtualMachine> vm = VirtualMachine::Create(DefaultDispatchMode());
   vm->LoadExecutable(ffi::GetObjectPtr<VMExecutable>(const_cast<VMExecutable*>(this)));
   return ffi::Module(vm);
 }
 
 bool VMExecutable::HasFunction(const ffi::String& name) const { return func_map.count(name); }
 
+ffi::Array<ffi::String> VMExecutable::UsedGlobalFuncNames() const {
+  std::vector<std::string> names;
+  for (const VMFuncInfo& info : func_table) {
+    if (info.kind == VMFuncInfo::FuncKind::kPackedFunc) {
+      names.push_back(info.name);
+    }
+  }
+  std::sort(names.begin(), names.end());
+  names.erase(std::unique(names.begin(), names.end()), names.end());
+  ffi::Array<ffi::String> result;
+  for (const std::string& name : names) {
+    result.push_back(ffi::String(name));
+  }
+  return result;
+}
+
+namespace {
+
+/*! \brief Whether two constant-pool entries hold the same value. */
+bool ConstantPoolEntryEqual(const ffi::Any& lhs, const ffi::Any& rhs) {
+  if (auto lhs_nd = lhs.as<Tensor>()) {
+    auto rhs_nd = rhs.as<Tensor>();
+    if (!rhs_nd.has_value()) return false;
+    const Tensor& a = lhs_nd.value();
+    const Tensor& b = rhs_nd.value();
+    if (a.same_as(b)) return true;
+    if (!(a->dtype == b->dtype) || a->ndim != b->ndim) return false;
+    for (int i = 0; i < a->ndim; ++i) {
+      if (a->shape[i] != b->shape[i]) return false;
+    }
+    // Only compare bytes when both sides are plain host tensors; device-resident
+    // constants are conservatively treated as distinct.
+    if (a->device.device_type != kDLCPU || b->device.device_type != kDLCPU ||
+        !a.IsContiguous() || !b.IsContiguous()) {
+      return false;
+    }
+    size_t nbytes = ffi::GetDataSize(*(a.operator->()));
+    return std::memcmp(static_cast<const char*>(a->data) + a->byte_offset,
+                       static_cast<const char*>(b->data) + b->byte_offset, nbytes) == 0;
+  } else if (auto lhs_shape = lhs.as<ffi::Shape>()) {
+    auto rhs_shape = rhs.as<ffi::Shape>();
+    if (!rhs_shape.has_value() || lhs_shape.value().size() != rhs_shape.value().size()) {
+      return false;
+    }
+    for (size_t i = 0; i < lhs_shape.value().size(); ++i) {
+      if (lhs_shape.value()[i] != rhs_shape.value()[i]) return false;
+    }
+    return true;
+  } else if (auto lhs_str = lhs.as<ffi::String>()) {
+    auto rhs_str = rhs.as<ffi::String>();
+    return rhs_str.has_value() && lhs_str.value() == rhs_str.value();
+  } else if (auto lhs_int = lhs.as<int64_t>()) {
+    auto rhs_int = rhs.as<int64_t>();
+    return rhs_int.has_value() && lhs_int.value() == rhs_int.value();
+  } else if (auto lhs_float = lhs.as<double>()) {
+    auto rhs_float = rhs.as<double>();
+    return rhs_float.has_value() && lhs_float.value() == rhs_float.value();
+  } else if (auto lhs_dtype = lhs.as<DLDataType>()) {
+    auto rhs_dtype = rhs.as<DLDataType>();
+    return rhs_dtype.has_value() && lhs_dtype.value() == rhs_dtype.value();
+  }
+  return false;
+}
+
+}  // namespace
+
+ffi::Module VMExecutable::Link(ffi::Module lhs_mod, ffi::Module rhs_mod, ffi::String rhs_prefix) {
+  const auto* lhs = lhs_mod.as<VMExecutable>();
+  const auto* rhs = rhs_mod.as<VMExecutable>();
+  TVM_FFI_CHECK(lhs != nullptr && rhs != nullptr, TypeError)
+      << "ExecutableLink expects two relax.VMExecutable modules";
+  ffi::ObjectPtr<VMExecutable> linked = ffi::make_object<VMExecutable>();
+  linked->func_table = lhs->func_table;
+  linked->func_map = lhs->func_map;
+  linked->constants = lhs->constants;
+  linked->memory_scopes = lhs->memory_scopes;
+  linked->instr_offset = lhs->instr_offset;
+  linked->instr_data = lhs->instr_data;
+
+  auto scope_of = [](const std::unordered_map<Index, std::string>& scopes, Index i) {
+    auto it = scopes.find(i);
+    return it != scopes.end() ? it->second : std::string();
+  };
+  // Merge the constant pool, reusing entries whose value (and memory scope)
+  // already exist, so constants shared by the two modules are stored once.
+  std::vector<Index> const_remap(rhs->constants.size());
+  for (size_t i = 0; i < rhs->constants.size(); ++i) {
+    Index merged_index = -1;
+    for (size_t j = 0; j < linked->constants.size(); ++j) {
+      if (scope_of(rhs->memory_scopes, i) == scope_of(linked->memory_scopes, j) &&
+          ConstantPoolEntryEqual(rhs->constants[i], linked->constants[j])) {
+        merged_index = static_cast<Index>(j);
+        break;
+      }
+    }
+    if (merged_index == -1) {
+      merged_index = static_cast<Index>(linked->constants.size());
+      linked->constants.push_back(rhs->constants[i]);
+      std::string scope = scope_of(rhs->memory_scopes, i);
+      if (!scope.empty()) {
+        linked->memory_scopes[merged_index] = scope;
+      }
+    }
+    const_remap[i] = merged_index;
+  }
+
+  // Merge the function tables. Packed-function and VMTIR entries are resolved by
+  // name in the environment, so entries with the same name unify; VM functions are
+  // entry points and get the prefix to stay distinct.
+  Index instr_base = static_cast<Index>(lhs->instr_offset.size());
+  std::vector<Index> func_remap(rhs->func_table.size());
+  for (size_t i = 0; i < rhs->func_table.size(); ++i) {
+    VMFuncInfo info = rhs->func_table[i];
+    if (info.kind == VMFuncInfo::FuncKind::kVMFunc) {
+      info.name = std::string(rhs_prefix) + info.name;
+      info.start_instr += instr_base;
+      info.end_instr += instr_base;
+    }
+    auto it = linked->func_map.find(info.name);
+    if (it != linked->func_map.end()) {
+      TVM_FFI_CHECK(info.kind != VMFuncInfo::FuncKind::kVMFunc &&
+                        linked->func_table[it->second].kind == info.kind,
+                    ValueError)
+          << "Duplicate function `" << info.name << "` while linking executables";
+      func_remap[i] = it->second;
+      continue;
+    }
+    func_remap[i] = static_cast<Index>(linked->func_table.size());
+    linked->func_map[info.name] = func_remap[i];
+    linked->func_table.push_back(std::move(info));
+  }
+
+  // Append the bytecode of rhs, rewriting the constant and function indices.
+  Index word_base = static_cast<Index>(lhs->instr_data.size());
+  for (Index offset : rhs->instr_offset) {
+    linked->instr_offset.push_back(offset + word_base);
+  }
+  linked->instr_data.insert(linked->instr_data.end(), rhs->instr_data.begin(),
+                            rhs->instr_data.end());
+  for (Index offset : rhs->instr_offset) {
+    ExecWord* words = linked->instr_data.data() + word_base + offset;
+    if (static_cast<Opcode>(words[0]) != Opcode::Call) continue;
+    words[2] = func_remap[words[2]];
+    Index num_args = words[3];
+    for (Index a = 0; a < num_args; ++a) {
+      Instruction::Arg arg = Instruction::Arg::FromData(words[4 + a]);
+      if (arg.kind() == Instruction::ArgKind::kConstIdx) {
+        words[4 + a] = Instruction::Arg::ConstIdx(const_remap[arg.value()]).data();
+      } else if (arg.kind() == Instruction::ArgKind::kFuncIdx) {
+        words[4 + a] = Instruction::Arg::FuncIdx(func_remap[arg.value()]).data();
+      }
+    }
+  }
+
+  // Carry over the imported libraries of both sides so kernel lookups keep working.
+  ffi::Module linked_mod(linked);
+  for (const ffi::Any& import : lhs_mod->imports()) {
+    linked_mod->ImportModule(import.cast<ffi::Module>());
+  }
+  for (const ffi::Any& import : rhs_mod->imports()) {
+    linked_mod->ImportModule(import.cast<ffi::Module>());
+  }
+  return linked_mod;
+}
+
 ffi::String VMExecutable::AsText() const {
   auto get_func_name = [&](Index index) -> std::string {
     if (static_cast<size_t>(index) < func_table.size()) {
@@ -597,7 +1011,25 @@ ffi::String VMExecutable::AsPython() const {
 
 TVM_FFI_STATIC_INIT_BLOCK() {
   namespace refl = tvm::ffi::reflection;
-  refl::GlobalDef().def("relax.ExecutableLoadFromFile", VMExecutable::LoadFromFile);
+  refl::GlobalDef()
+      .def("relax.ExecutableLoadFromFile", VMExecutable::LoadFromFile)
+      .def("relax.ExecutableLink", VMExecutable::Link)
+      // Testing hooks exercising the bytecode serialization formats.
+      .def("relax.testing.ExecutableSaveToBytes",
+           [](ffi::Module mod) {
+             const auto* exec = mod.as<VMExecutable>();
+             TVM_FFI_CHECK(exec != nullptr, TypeError)
+                 << "ExecutableSaveToBytes expects a relax.VMExecutable module";
+             return exec->SaveToBytes();
+           })
+      .def("relax.testing.ExecutableSaveToBytesLegacy",
+           [](ffi::Module mod) {
+             const auto* exec = mod.as<VMExecutable>();
+             TVM_FFI_CHECK(exec != nullptr, TypeError)
+                 << "ExecutableSaveToBytesLegacy expects a relax.VMExecutable module";
+             return exec->SaveToBytesLegacy();
+           })
+      .def("relax.testing.ExecutableLoadFromBytes", VMExecutable::LoadFromBytes);
 }
 
 }  // namespace vm
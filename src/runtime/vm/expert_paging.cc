@@ -0,0 +1,283 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*!
+ * \file src/runtime/vm/expert_paging.cc
+ * \brief Paging of mixture-of-experts weights between host and device memory.
+ *
+ * MoE checkpoints do not fit in device memory once the expert count grows,
+ * but each token only activates a few experts per layer. The paging manager
+ * keeps the full expert weights in host memory and maintains a bounded cache
+ * of resident experts on device:
+ *
+ *  - `vm.builtin.expert_paging_prefetch` takes the expert ids selected by the
+ *    router — typically of the *next* layer, so the upload overlaps with the
+ *    current layer's compute — and issues asynchronous host-to-device copies
+ *    on a dedicated copy stream for the experts that are not resident;
+ *  - `vm.builtin.expert_paging_get` returns the device weights of one expert,
+ *    making the compute stream wait on the copy stream with an event when
+ *    uploads are still in flight. A miss is handled the same way, so even the
+ *    unprefetched path never blocks the host.
+ *
+ * Eviction combines recency with usage frequency: the resident expert with
+ * the fewest (periodically decayed) uses goes first, ties broken by the
+ * least-recently-used one, which keeps hot shared experts resident across
+ * bursts of cold ones. Device buffers come from the pooled allocator, so an
+ * evicted expert's memory is recycled for the next upload instead of being
+ * returned to the driver.
+ */
+#include <tvm/ffi/container/array.h>
+#include <tvm/ffi/function.h>
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/runtime/device_api.h>
+#include <tvm/runtime/memory/memory_manager.h>
+#include <tvm/runtime/tensor.h>
+
+#include <utility>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+namespace vm {
+
+using memory::Allocator;
+using memory::AllocatorType;
+using memory::MemoryManager;
+
+/*! \brief Manager of host-resident expert weights with a bounded device cache. */
+class ExpertPagingObj : public ffi::Object {
+ public:
+  ExpertPagingObj(int64_t num_layers, int64_t num_experts, int64_t num_device_slots, Device device)
+      : num_layers_(num_layers),
+        num_experts_(num_experts),
+        num_device_slots_(num_device_slots),
+        device_(device),
+        entries_(num_layers * num_experts) {
+    allocator_ = MemoryManager::GetOrCreateAllocator(device, AllocatorType::kPooled);
+    copy_stream_ = DeviceAPI::Get(device)->CreateStream(device);
+  }
+
+  ~ExpertPagingObj() {
+    if (copy_stream_ != nullptr) {
+      DeviceAPI::Get(device_)->FreeStream(device_, copy_stream_);
+    }
+  }
+
+  /*! \brief Register the host-memory weights of one expert. */
+  void Register(int64_t layer, int64_t expert, ffi::Array<Tensor> host_weights) {
+    ExpertEntry& entry = EntryAt(layer, expert);
+    TVM_FFI_CHECK(entry.host.empty(), ValueError)
+        << "Expert (" << layer << ", " << expert << ") is already registered";
+    TVM_FFI_CHECK(!host_weights.empty(), ValueError) << "Expert weights must not be empty";
+    for (const Tensor& weight : host_weights) {
+      TVM_FFI_CHECK(weight->device.device_type == kDLCPU, ValueError)
+          << "Expert weights must live in host memory";
+    }
+    entry.host = std::move(host_weights);
+  }
+
+  /*!
+   * \brief Upload the experts the router selected, without blocking the host.
+   *
+   * The ids tensor may live on device; it is small, so reading it back
+   * synchronously is cheap relative to the uploads it triggers.
+   */
+  void Prefetch(int64_t layer, Tensor expert_ids) {
+    for (int64_t expert : ReadExpertIds(expert_ids)) {
+      EnsureResident(layer, expert);
+    }
+  }
+
+  /*! \brief Get the device-resident weights of one expert. */
+  ffi::Array<Tensor> Get(int64_t layer, int64_t expert) {
+    ExpertEntry& entry = EnsureResident(layer, expert);
+    if (copies_in_flight_) {
+      // One event covers every upload issued on the copy stream so far.
+      DeviceAPI* api = DeviceAPI::Get(device_);
+      api->SyncStreamFromTo(device_, copy_stream_, api->GetCurrentStream(device_));
+      copies_in_flight_ = false;
+    }
+    return entry.device;
+  }
+
+  static constexpr const bool _type_mutable = true;
+  TVM_FFI_DECLARE_OBJECT_INFO("relax.vm.ExpertPaging", ExpertPagingObj, ffi::Object);
+
+ private:
+  struct ExpertEntry {
+    /*! \brief The host copy of the weights; always present once registered. */
+    ffi::Array<Tensor> host;
+    /*! \brief The device copy; empty while the expert is paged out. */
+    ffi::Array<Tensor> device;
+    /*! \brief Decayed use count driving frequency-aware eviction. */
+    int64_t uses = 0;
+    /*! \brief Logical timestamp of the last use, for the recency tie-break. */
+    int64_t last_use = 0;
+  };
+
+  ExpertEntry& EntryAt(int64_t layer, int64_t expert) {
+    TVM_FFI_CHECK(layer >= 0 && layer < num_layers_ && expert >= 0 && expert < num_experts_,
+                  ValueError)
+        << "Expert (" << layer << ", " << expert << ") is out of range for " << num_layers_
+        << " layers with " << num_experts_ << " experts";
+    return entries_[layer * num_experts_ + expert];
+  }
+
+  /*! \brief Make the expert device-resident, issuing its upload if needed. */
+  ExpertEntry& EnsureResident(int64_t layer, int64_t expert) {
+    ExpertEntry& entry = EntryAt(layer, expert);
+    TVM_FFI_CHECK(!entry.host.empty(), ValueError)
+        << "Expert (" << layer << ", " << expert << ") has not been registered";
+    Touch(&entry);
+    if (!entry.device.empty()) {
+      return entry;
+    }
+    while (static_cast<int64_t>(resident_.size()) >= num_device_slots_) {
+      EvictOne();
+    }
+    DeviceAPI* api = DeviceAPI::Get(device_);
+    // The pooled allocator may hand back a buffer an evicted expert's kernels
+    // still read from the queue, so the upload waits for the compute stream.
+    api->SyncStreamFromTo(device_, api->GetCurrentStream(device_), copy_stream_);
+    std::vector<Tensor> device_weights;
+    device_weights.reserve(entry.host.size());
+    for (const Tensor& weight : entry.host) {
+      Tensor on_device = allocator_->Empty(weight.Shape(), weight->dtype, device_);
+      Tensor::CopyFromTo(weight.operator->(), const_cast<DLTensor*>(on_device.operator->()),
+                         copy_stream_);
+      device_weights.push_back(std::move(on_device));
+    }
+    entry.device = ffi::Array<Tensor>(device_weights.begin(), device_weights.end());
+    copies_in_flight_ = true;
+    resident_.push_back(&entry - entries_.data());
+    return entry;
+  }
+
+  /*! \brief Evict the resident expert with the lowest (uses, last_use) score. */
+  void EvictOne() {
+    TVM_FFI_ICHECK(!resident_.empty()) << "The device cache holds no expert to evict";
+    size_t victim_pos = 0;
+    for (size_t i = 1; i < resident_.size(); ++i) {
+      const ExpertEntry& candidate = entries_[resident_[i]];
+      const ExpertEntry& victim = entries_[resident_[victim_pos]];
+      if (candidate.uses < victim.uses ||
+          (candidate.uses == victim.uses && candidate.last_use < victim.last_use)) {
+        victim_pos = i;
+      }
+    }
+    // Dropping the tensors returns their buffers to the pooled allocator.
+    entries_[resident_[victim_pos]].device = ffi::Array<Tensor>();
+    resident_.erase(resident_.begin() + victim_pos);
+  }
+
+  /*! \brief Account one use, periodically decaying counts so old traffic fades. */
+  void Touch(ExpertEntry* entry) {
+    entry->last_use = ++clock_;
+    ++entry->uses;
+    if (clock_ % kDecayPeriod == 0) {
+      for (ExpertEntry& e : entries_) {
+        e.uses >>= 1;
+      }
+    }
+  }
+
+  /*! \brief Read the router's expert ids, copying them back when on device. */
+  std::vector<int64_t> ReadExpertIds(Tensor expert_ids) {
+    Tensor host_ids = expert_ids;
+    if (expert_ids->device.device_type != kDLCPU) {
+      host_ids = Tensor::Empty(expert_ids.Shape(), expert_ids->dtype, Device{kDLCPU, 0});
+      host_ids.CopyFrom(expert_ids);
+      DeviceAPI::Get(expert_ids->device)->StreamSync(expert_ids->device, nullptr);
+    }
+    const DLTensor* tensor = host_ids.operator->();
+    TVM_FFI_CHECK(tensor->dtype.code == kDLInt && tensor->dtype.lanes == 1 &&
+                      (tensor->dtype.bits == 32 || tensor->dtype.bits == 64),
+                  ValueError)
+        << "Expert ids must be an int32 or int64 tensor";
+    int64_t numel = 1;
+    for (int i = 0; i < tensor->ndim; ++i) {
+      numel *= tensor->shape[i];
+    }
+    const char* data = static_cast<const char*>(tensor->data) + tensor->byte_offset;
+    std::vector<int64_t> result;
+    result.reserve(numel);
+    for (int64_t i = 0; i < numel; ++i) {
+      result.push_back(tensor->dtype.bits == 32
+                           ? static_cast<int64_t>(reinterpret_cast<const int32_t*>(data)[i])
+                           : reinterpret_cast<const int64_t*>(data)[i]);
+    }
+    return result;
+  }
+
+  /*! \brief Number of use accounts between halvings of the use counters. */
+  static constexpr int64_t kDecayPeriod = 1024;
+
+  int64_t num_layers_;
+  int64_t num_experts_;
+  /*! \brief Maximum number of experts resident on device at once. */
+  int64_t num_device_slots_;
+  Device device_;
+  /*! \brief Pooled allocator device buffers are drawn from and recycled to. */
+  Allocator* allocator_;
+  /*! \brief Dedicated stream the uploads run on. */
+  TVMStreamHandle copy_stream_;
+  /*! \brief Whether uploads have been issued since the last compute-stream join. */
+  bool copies_in_flight_ = false;
+  /*! \brief Per-expert state, indexed by layer * num_experts_ + expert. */
+  std::vector<ExpertEntry> entries_;
+  /*! \brief Indices into entries_ of the currently resident experts. */
+  std::vector<size_t> resident_;
+  /*! \brief Logical clock advanced on every use. */
+  int64_t clock_ = 0;
+};
+
+class ExpertPaging : public ffi::ObjectRef {
+ public:
+  TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(ExpertPaging, ffi::ObjectRef, ExpertPagingObj);
+};
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef()
+      .def("vm.builtin.expert_paging_create",
+           [](int64_t num_layers, int64_t num_experts, int64_t num_device_slots, int device_type,
+              int device_id) {
+             TVM_FFI_ICHECK_GT(num_layers, 0) << "The number of layers should be greater than 0.";
+             TVM_FFI_ICHECK_GT(num_experts, 0) << "The number of experts should be greater than 0.";
+             TVM_FFI_ICHECK_GT(num_device_slots, 0)
+                 << "The number of device slots should be greater than 0.";
+             Device device{static_cast<DLDeviceType>(device_type), device_id};
+             return ExpertPaging(ffi::make_object<ExpertPagingObj>(num_layers, num_experts,
+                                                                   num_device_slots, device));
+           })
+      .def("vm.builtin.expert_paging_register",
+           [](ExpertPaging paging, int64_t layer, int64_t expert, ffi::Array<Tensor> host_weights) {
+             paging->Register(layer, expert, std::move(host_weights));
+           })
+      .def("vm.builtin.expert_paging_prefetch",
+           [](ExpertPaging paging, int64_t layer, Tensor expert_ids) {
+             paging->Prefetch(layer, std::move(expert_ids));
+           })
+      .def("vm.builtin.expert_paging_get", [](ExpertPaging paging, int64_t layer, int64_t expert) {
+        return paging->Get(layer, expert);
+      });
+}
+
+}  // namespace vm
+}  // namespace runtime
+}  // namespace tvm
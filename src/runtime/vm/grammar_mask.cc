@@ -0,0 +1,138 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*!
+ * \file src/runtime/vm/grammar_mask.cc
+ * \brief Vocabulary-mask evaluation for grammar-constrained decoding.
+ *
+ * Constrained decoding (e.g. JSON mode) compiles the grammar ahead of time
+ * into a token-mask automaton: a per-state bitmask over the vocabulary packed
+ * into uint32 words, plus a dense state-transition table. The per-step work
+ * is then a table lookup and a bitmask sweep, which these builtins perform
+ * natively instead of in Python:
+ *
+ *  - `vm.builtin.grammar_apply_token_mask` writes -inf into the logits of
+ *    disallowed tokens. The sweep is word-at-a-time with early outs for
+ *    all-ones and all-zeros words, so the common mostly-allowed and
+ *    mostly-forbidden states touch little memory and the inner loop
+ *    vectorizes.
+ *  - `vm.builtin.grammar_advance` steps the automaton with a sampled token.
+ *
+ * The mask is also fused directly into the samplers: the host sampler gains
+ * `vm.builtin.sample_top_p_from_logits_masked` in lm_support.cc, and the
+ * device sampler accepts per-sequence automaton states in the fused curand
+ * builtin, so no separate mask-application launch is needed on either path.
+ */
+#include <tvm/ffi/function.h>
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/runtime/tensor.h>
+
+#include <cstdint>
+#include <limits>
+
+namespace tvm {
+namespace runtime {
+namespace vm {
+
+/*! \brief Validate a [num_states, num_words] uint32 mask table and return one row. */
+const uint32_t* GrammarMaskRow(const Tensor& masks, int64_t state, int64_t vocab) {
+  TVM_FFI_ICHECK(masks.IsContiguous());
+  TVM_FFI_ICHECK((masks.DataType() == DLDataType{kDLUInt, 32, 1}))
+      << "The mask table must be uint32";
+  TVM_FFI_ICHECK_EQ(masks->ndim, 2) << "The mask table must be [num_states, num_words]";
+  TVM_FFI_ICHECK(masks->device.device_type == kDLCPU) << "The mask table must live in host memory";
+  TVM_FFI_ICHECK(state >= 0 && state < masks->shape[0])
+      << "Automaton state " << state << " is out of range for " << masks->shape[0] << " states";
+  int64_t num_words = masks->shape[1];
+  TVM_FFI_ICHECK_GE(num_words * 32, vocab)
+      << "The mask rows cover " << num_words * 32 << " tokens but the vocabulary has " << vocab;
+  return static_cast<const uint32_t*>(masks->data) + state * num_words;
+}
+
+/*!
+ * \brief Write -inf into the logits of tokens the automaton state forbids.
+ * \param logits The [..., vocab] float32 logits in host memory, updated in place.
+ * \param masks The [num_states, num_words] uint32 bitmask table.
+ * \param state The current automaton state.
+ */
+void GrammarApplyTokenMask(Tensor logits, Tensor masks, int64_t state) {
+  TVM_FFI_ICHECK(logits.IsContiguous());
+  TVM_FFI_ICHECK((logits.DataType() == DLDataType{kDLFloat, 32, 1}))
+      << "The logits must be float32";
+  TVM_FFI_ICHECK(logits->device.device_type == kDLCPU)
+      << "The masked logits must live in host memory";
+  for (int i = 0; i < logits->ndim - 1; ++i) {
+    TVM_FFI_ICHECK_EQ(logits->shape[i], 1) << "The leading dimensions of logits must be 1";
+  }
+  int64_t vocab = logits->shape[logits->ndim - 1];
+  const uint32_t* mask = GrammarMaskRow(masks, state, vocab);
+  float* data = static_cast<float*>(logits->data);
+  constexpr float neg_inf = -std::numeric_limits<float>::infinity();
+  for (int64_t word = 0; word * 32 < vocab; ++word) {
+    uint32_t bits = mask[word];
+    if (bits == 0xffffffffu) continue;
+    int64_t base = word * 32;
+    int64_t lanes = vocab - base < 32 ? vocab - base : 32;
+    if (bits == 0u) {
+      for (int64_t lane = 0; lane < lanes; ++lane) {
+        data[base + lane] = neg_inf;
+      }
+      continue;
+    }
+    for (int64_t lane = 0; lane < lanes; ++lane) {
+      if (!((bits >> lane) & 1u)) {
+        data[base + lane] = neg_inf;
+      }
+    }
+  }
+}
+
+/*!
+ * \brief Step the automaton with a sampled token.
+ * \param transitions The [num_states, vocab] int32 transition table in host memory.
+ * \param state The current automaton state.
+ * \param token The sampled token.
+ * \return The next automaton state.
+ */
+int64_t GrammarAdvance(Tensor transitions, int64_t state, int64_t token) {
+  TVM_FFI_ICHECK(transitions.IsContiguous());
+  TVM_FFI_ICHECK((transitions.DataType() == DLDataType{kDLInt, 32, 1}))
+      << "The transition table must be int32";
+  TVM_FFI_ICHECK_EQ(transitions->ndim, 2)
+      << "The transition table must be [num_states, vocab]";
+  TVM_FFI_ICHECK(transitions->device.device_type == kDLCPU)
+      << "The transition table must live in host memory";
+  TVM_FFI_ICHECK(state >= 0 && state < transitions->shape[0])
+      << "Automaton state " << state << " is out of range for " << transitions->shape[0]
+      << " states";
+  TVM_FFI_ICHECK(token >= 0 && token < transitions->shape[1])
+      << "Token " << token << " is out of range for vocabulary size " << transitions->shape[1];
+  const int32_t* row = static_cast<const int32_t*>(transitions->data) + state * transitions->shape[1];
+  return row[token];
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef()
+      .def("vm.builtin.grammar_apply_token_mask", GrammarApplyTokenMask)
+      .def("vm.builtin.grammar_advance", GrammarAdvance);
+}
+
+}  // namespace vm
+}  // namespace runtime
+}  // namespace tvm
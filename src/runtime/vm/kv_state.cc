@@ -63,8 +63,37 @@ TVM_FFI_STATIC_INIT_BLOCK() {
       .def_method("vm.builtin.kv_cache_disagg_mark_send", &AttentionKVCacheObj::DisaggMarkSend)
       .def_method("vm.builtin.attention_kv_cache_enable_sliding_window_for_seq",
                   &AttentionKVCacheObj::EnableSlidingWindowForSeq)
+      .def("vm.builtin.attention_kv_cache_add_sequence_with_sliding_window",
+           [](AttentionKVCache kv_cache, int64_t seq_id, int32_t sliding_window_size,
+              int32_t attn_sink_size) {
+             // Setting the policy at add time makes the whole lifetime of the
+             // sequence window-bounded, so per-sequence policies can be mixed
+             // in one cache without a separate enable step.
+             kv_cache->AddSequence(seq_id);
+             kv_cache->EnableSlidingWindowForSeq(seq_id, sliding_window_size, attn_sink_size);
+           })
+      .def_method("vm.builtin.attention_kv_cache_commit_sequence_tokens",
+                  &AttentionKVCacheObj::CommitSequenceTokens)
+      .def_method("vm.builtin.attention_kv_cache_add_sequence_with_prefix_match",
+                  &AttentionKVCacheObj::AddSequenceWithPrefixMatch)
+      .def_method("vm.builtin.attention_kv_cache_plan_prefill_chunks",
+                  &AttentionKVCacheObj::PlanPrefillChunks)
+      .def_method("vm.builtin.attention_kv_cache_get_prefill_chunk_costs",
+                  &AttentionKVCacheObj::GetPrefillChunkCosts)
+      .def_method("vm.builtin.attention_kv_cache_enable_host_offload",
+                  &AttentionKVCacheObj::EnableHostOffload)
+      .def_method("vm.builtin.attention_kv_cache_offload_sequence_to_host",
+                  &AttentionKVCacheObj::OffloadSequenceToHost)
+      .def_method("vm.builtin.attention_kv_cache_enable_vtcm_working_set",
+                  &AttentionKVCacheObj::EnableVTCMWorkingSet)
+      .def_method("vm.builtin.attention_kv_cache_get_vtcm_pages",
+                  &AttentionKVCacheObj::GetVTCMPages)
+      .def_method("vm.builtin.attention_kv_cache_get_vtcm_page_map",
+                  &AttentionKVCacheObj::GetVTCMPageMap)
       .def_method("vm.builtin.attention_kv_cache_commit_accepted_token_tree_nodes",
                   &AttentionKVCacheObj::CommitAcceptedTokenTreeNodes)
+      .def_method("vm.builtin.attention_kv_cache_commit_accepted_tokens",
+                  &AttentionKVCacheObj::CommitAcceptedTokens)
       .def_method("vm.builtin.attention_kv_cache_empty", &AttentionKVCacheObj::Empty)
       .def_method("vm.builtin.attention_kv_cache_get_num_available_pages",
                   &AttentionKVCacheObj::GetNumAvailablePages)
@@ -121,6 +150,60 @@ TVM_FFI_STATIC_INIT_BLOCK() {
       .def_method("vm.builtin.rnn_state_debug_get", &RNNStateObj::DebugGet);
 }
 
+// Auxiliary buffer pool
+
+AuxBufferPool* AuxBufferPool::Global() {
+  static AuxBufferPool* pool = new AuxBufferPool();
+  return pool;
+}
+
+Tensor AuxBufferPool::Alloc(ffi::Shape shape, DLDataType dtype, Device device) {
+  int64_t nbytes = (dtype.bits * dtype.lanes + 7) / 8;
+  for (int64_t dim : shape) {
+    nbytes *= dim;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = free_buffers_.find({static_cast<int>(device.device_type), device.device_id, nbytes});
+    if (it != free_buffers_.end() && !it->second.empty()) {
+      Tensor buffer = std::move(it->second.back());
+      it->second.pop_back();
+      pooled_bytes_[{static_cast<int>(device.device_type), device.device_id}] -= nbytes;
+      return buffer.CreateView(shape, dtype);
+    }
+  }
+  return Tensor::Empty(shape, dtype, device);
+}
+
+void AuxBufferPool::Recycle(Tensor buffer) {
+  if (!buffer.defined()) {
+    return;
+  }
+  int64_t nbytes = static_cast<int64_t>(ffi::GetDataSize(*(buffer.operator->())));
+  Device device = buffer->device;
+  std::lock_guard<std::mutex> lock(mutex_);
+  int64_t& device_pooled_bytes = pooled_bytes_[{static_cast<int>(device.device_type), device.device_id}];
+  if (device_pooled_bytes + nbytes > kMaxPoolBytesPerDevice) {
+    // Dropping the buffer frees it right away instead of growing the pool
+    // beyond the cap.
+    return;
+  }
+  device_pooled_bytes += nbytes;
+  free_buffers_[{static_cast<int>(device.device_type), device.device_id, nbytes}].push_back(std::move(buffer));
+}
+
+void AuxBufferPool::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  free_buffers_.clear();
+  pooled_bytes_.clear();
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("vm.builtin.kv_state_clear_aux_buffer_pool",
+                        []() { AuxBufferPool::Global()->Clear(); });
+}
+
 }  // namespace vm
 }  // namespace runtime
 }  // namespace tvm
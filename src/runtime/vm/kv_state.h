@@ -26,6 +26,13 @@
 #include <tvm/runtime/device_api.h>
 #include <tvm/runtime/tensor.h>
 
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <utility>
+#include <vector>
+
 namespace tvm {
 namespace runtime {
 namespace vm {
@@ -147,6 +154,130 @@ class AttentionKVCacheObj : public KVStateObj {
   virtual void EnableSlidingWindowForSeq(int64_t seq_id, int32_t sliding_window_size,
                                          int32_t attn_sink_size) = 0;
 
+  /*!
+   * \brief Commit the token values of a sequence for prefix matching.
+   * The tokens are appended to the sequence's committed token record,
+   * which must not grow beyond the current sequence length. The default
+   * implementation is a no-op for KV cache implementations that do not
+   * support prefix reuse.
+   * \param seq_id The id of the sequence to commit tokens for.
+   * \param tokens The committed token values.
+   */
+  virtual void CommitSequenceTokens(int64_t seq_id, const ffi::Shape& tokens) {}
+
+  /*!
+   * \brief Add a new sequence, transparently reusing the KV data of the
+   * longest page-aligned token prefix that is shared with any sequence
+   * whose tokens were committed via CommitSequenceTokens.
+   * The default implementation adds the sequence without prefix reuse.
+   * \param seq_id The id of the new sequence to be added.
+   * \param tokens The token values of the new sequence.
+   * \return The number of prefix tokens whose KV data is reused. The
+   * caller only needs to prefill the tokens after the returned position.
+   */
+  virtual int64_t AddSequenceWithPrefixMatch(int64_t seq_id, const ffi::Shape& tokens) {
+    AddSequence(seq_id);
+    return 0;
+  }
+
+  /*!
+   * \brief Plan the per-round append lengths for a chunked prefill of the
+   * given number of tokens. Prefilling a sequence may be split across
+   * multiple BeginForward/EndForward rounds: each round appends one chunk,
+   * and the queries of a chunk attend to all previously appended KV data
+   * plus causally to the chunk itself, so the result is identical to a
+   * single-round prefill. The scheduler can run decode batches between the
+   * chunks to keep decode latency flat under long prefills.
+   * \param seq_id The id of the sequence to prefill.
+   * \param append_length The total number of tokens to prefill.
+   * \param max_chunk_tokens The maximum number of tokens per chunk.
+   * \return The chunk lengths, summing up to append_length.
+   */
+  virtual ffi::Shape PlanPrefillChunks(int64_t seq_id, int64_t append_length,
+                                       int64_t max_chunk_tokens) {
+    TVM_FFI_CHECK(append_length > 0, ValueError)
+        << "The prefill length must be positive, got " << append_length;
+    TVM_FFI_CHECK(max_chunk_tokens > 0, ValueError)
+        << "The maximum chunk size must be positive, got " << max_chunk_tokens;
+    std::vector<int64_t> chunk_lengths;
+    for (int64_t remaining = append_length; remaining > 0; remaining -= max_chunk_tokens) {
+      chunk_lengths.push_back(std::min(remaining, max_chunk_tokens));
+    }
+    return ffi::Shape(chunk_lengths);
+  }
+
+  /*!
+   * \brief Get the estimated attention cost of each chunk of a planned
+   * chunked prefill, so the scheduler can decide how many decode batches
+   * to interleave between the chunks. The costs are in attended
+   * query/key token pairs, proportional to the attention FLOPs of the
+   * chunk. The default implementation, for KV cache implementations that
+   * do not track per-sequence context lengths, only accounts for the
+   * causal in-chunk pairs.
+   * \param seq_id The id of the sequence to prefill.
+   * \param chunk_lengths The planned chunk lengths.
+   * \return The estimated cost of each chunk.
+   */
+  virtual ffi::Shape GetPrefillChunkCosts(int64_t seq_id, const ffi::Shape& chunk_lengths) {
+    std::vector<int64_t> costs;
+    costs.reserve(chunk_lengths.size());
+    for (int64_t length : chunk_lengths) {
+      costs.push_back(length * (length + 1) / 2);
+    }
+    return ffi::Shape(costs);
+  }
+
+  /*!
+   * \brief Enable the host offload tier of the KV cache with the given
+   * number of host pages. Error will be thrown when the KV cache does not
+   * support host offload.
+   * \param num_host_pages The number of pages to allocate in host memory.
+   */
+  virtual void EnableHostOffload(int64_t num_host_pages) {
+    TVM_FFI_THROW(InternalError) << "The KV cache does not support host offload.";
+  }
+
+  /*!
+   * \brief Offload the KV data of the given sequence to the host tier,
+   * releasing its device pages for other sequences. The offloaded KV data
+   * is automatically prefetched back to device when the sequence appears
+   * in a later BeginForward batch. The default implementation offloads
+   * nothing for KV cache implementations without a host tier.
+   * \param seq_id The id of the sequence to offload.
+   * \return The number of device pages released by the offload.
+   */
+  virtual int64_t OffloadSequenceToHost(int64_t seq_id) { return 0; }
+
+  /*!
+   * \brief Enable the VTCM working-set tier of the KV cache with the given
+   * number of VTCM pages. Full pages of forwarding sequences are staged
+   * into VTCM by async DMA at each BeginForward, so attention kernels
+   * compiled to probe the VTCM tier read the hot KV data from VTCM.
+   * Error will be thrown when the KV cache does not support a VTCM tier.
+   * \param num_vtcm_pages The number of pages to allocate in VTCM.
+   */
+  virtual void EnableVTCMWorkingSet(int64_t num_vtcm_pages) {
+    TVM_FFI_THROW(InternalError) << "The KV cache does not support a VTCM working set.";
+  }
+
+  /*!
+   * \brief Get the VTCM-resident pages of the given layer, sharing the
+   * per-page layout of the device pages of the layer.
+   * \param layer_id The layer whose VTCM pages to return.
+   */
+  virtual Tensor GetVTCMPages(int64_t layer_id) {
+    TVM_FFI_THROW(InternalError) << "The KV cache does not support a VTCM working set.";
+  }
+
+  /*!
+   * \brief Get the map from device page id to the VTCM slot staging the
+   * page, with -1 for pages that are not staged. The map is refreshed at
+   * each BeginForward.
+   */
+  virtual Tensor GetVTCMPageMap() {
+    TVM_FFI_THROW(InternalError) << "The KV cache does not support a VTCM working set.";
+  }
+
   /*!
    * \brief Committed the accepted token tree nodes to KV cache.
    * The commit will update the KV cache, by compacting the KV data and discard
@@ -158,6 +289,19 @@ class AttentionKVCacheObj : public KVStateObj {
   virtual void CommitAcceptedTokenTreeNodes(const ffi::Shape& seq_ids,
                                             const ffi::Shape& leaf_indices) = 0;
 
+  /*!
+   * \brief Commit the accepted tokens of the latest round of forward for
+   * chain-style speculative decoding, rolling back the KV data of the
+   * rejected tokens of all sequences in one batch.
+   * For each sequence, the tokens appended in the latest forward round
+   * beyond the accepted length are popped.
+   * \param seq_ids The ids of the sequences to commit, which are required
+   * to be the sequences of the latest round of forward in the same order.
+   * \param accepted_lens The number of accepted tokens of each sequence.
+   */
+  virtual void CommitAcceptedTokens(const ffi::Shape& seq_ids,
+                                    const ffi::Shape& accepted_lens) = 0;
+
   /*! \brief Prepare for the disaggregation KV data receive for the specified sequence and length.*/
   virtual ffi::Shape DisaggPrepareRecv(int64_t seq_id, int length) = 0;
 
@@ -346,6 +490,58 @@ class RNNState : public KVState {
   TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(RNNState, KVState, RNNStateObj);
 };
 
+/*!
+ * \brief A process-wide pool recycling the auxiliary buffers of KV state
+ * implementations across cache instances.
+ *
+ * The KV cache and the RNN state allocate a fixed set of auxiliary buffers
+ * per instance: pinned host vectors for attention metadata and device
+ * scratch tensors. Under model-swap serving the caches are churned
+ * frequently, and re-running cudaHostAlloc/cudaFreeHost (and their device
+ * counterparts) for every swap costs seconds. The pool keeps released
+ * buffers keyed by device and byte size so that the next cache instance
+ * with the same configuration reuses them directly.
+ *
+ * A buffer must only be recycled when no view of it can still be read or
+ * written, which holds when a cache instance releases its buffers at
+ * destruction time.
+ */
+class AuxBufferPool {
+ public:
+  /*! \brief Get the process-wide pool. */
+  static AuxBufferPool* Global();
+
+  /*!
+   * \brief Allocate a buffer, reusing a pooled one of the same byte size
+   * on the same device when available.
+   * \param shape The shape of the buffer.
+   * \param dtype The data type of the buffer.
+   * \param device The device to allocate the buffer on.
+   * \return The allocated buffer.
+   */
+  Tensor Alloc(ffi::Shape shape, DLDataType dtype, Device device);
+
+  /*!
+   * \brief Return a buffer to the pool for later reuse. The buffer is
+   * dropped instead when pooling it would exceed the per-device byte cap.
+   * \param buffer The buffer to recycle.
+   */
+  void Recycle(Tensor buffer);
+
+  /*! \brief Release all pooled buffers. */
+  void Clear();
+
+ private:
+  /*! \brief The cap of pooled bytes per device. */
+  static constexpr int64_t kMaxPoolBytesPerDevice = 256 << 20;
+
+  std::mutex mutex_;
+  /*! \brief Free buffers keyed by (device_type, device_id, nbytes). */
+  std::map<std::tuple<int, int, int64_t>, std::vector<Tensor>> free_buffers_;
+  /*! \brief The number of pooled bytes keyed by (device_type, device_id). */
+  std::map<std::pair<int, int>, int64_t> pooled_bytes_;
+};
+
 }  // namespace vm
 }  // namespace runtime
 }  // namespace tvm
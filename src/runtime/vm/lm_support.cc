@@ -45,7 +45,12 @@
 #include <tvm/runtime/tensor.h>
 #include <tvm/runtime/vm/vm.h>
 
+#include <atomic>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
 
 namespace tvm {
 namespace runtime {
@@ -426,26 +431,92 @@ TVM_FFI_STATIC_INIT_BLOCK() {
   refl::GlobalDef().def("vm.builtin.sample_top_p_from_logits", SampleTopPFromLogits);
 }
 
-int SampleTopPFromProb(Tensor prob, double top_p, double uniform_sample) {
-  TVM_FFI_ICHECK(prob.IsContiguous());
-  TVM_FFI_ICHECK((prob.DataType() == DLDataType{kDLFloat, 32, 1}));
+// defined in grammar_mask.cc
+const uint32_t* GrammarMaskRow(const Tensor& masks, int64_t state, int64_t vocab);
 
-  if (prob->device.device_type != kDLCPU) {
-    prob = prob.CopyTo(DLDevice{kDLCPU, 0});
+// Grammar-constrained variant of SampleTopPFromLogits: the vocabulary mask of
+// the automaton state is fused into candidate collection, so forbidden tokens
+// never enter the sort and no separate mask-application sweep is needed.
+int SampleTopPFromLogitsMasked(Tensor logits, Tensor masks, int64_t state, double temperature,
+                               double top_p, double uniform_sample) {
+  TVM_FFI_ICHECK(logits.IsContiguous());
+  TVM_FFI_ICHECK((logits.DataType() == DLDataType{kDLFloat, 32, 1}));
+
+  if (logits->device.device_type != kDLCPU) {
+    logits = logits.CopyTo(DLDevice{kDLCPU, 0});
   }
 
-  TVM_FFI_ICHECK(prob->device.device_type == kDLCPU);
+  TVM_FFI_ICHECK(logits->device.device_type == kDLCPU);
 
-  for (int i = 0; i < prob->ndim - 1; ++i) {
-    TVM_FFI_ICHECK_EQ(prob->shape[i], 1) << "The leading dimensions of logits must be 1";
+  for (int i = 0; i < logits->ndim - 1; ++i) {
+    TVM_FFI_ICHECK_EQ(logits->shape[i], 1) << "The leading dimensions of logits must be 1";
+  }
+
+  int64_t vocab = logits->shape[logits->ndim - 1];
+  const uint32_t* mask = GrammarMaskRow(masks, state, vocab);
+  const float* plogits = static_cast<float*>(logits->data);
+
+  std::vector<std::pair<float, int>> data;
+  data.reserve(128);
+  for (int64_t i = 0; i < vocab; ++i) {
+    if ((mask[i >> 5] >> (i & 31)) & 1u) {
+      data.emplace_back(std::make_pair(plogits[i], static_cast<int>(i)));
+    }
   }
+  TVM_FFI_CHECK(!data.empty(), ValueError)
+      << "Automaton state " << state << " forbids every token in the vocabulary";
 
+  auto fcmp = [](const std::pair<float, int>& lhs, const std::pair<float, int>& rhs) {
+    return lhs.first > rhs.first;
+  };
+  // sort by logits from largest to smallest
+  std::sort(data.begin(), data.end(), fcmp);
+
+  // argmax
+  if (temperature < 1e-6f) {
+    return data[0].second;
+  }
+
+  // compute expf scaled by temp over the allowed tokens only
+  float sum = 0.0f, logit_scale = 1.0f / temperature;
+  float max_value = data[0].first;
+  for (auto it = data.begin(); it != data.end(); ++it) {
+    it->first = expf((it->first - max_value) * logit_scale);
+    sum += it->first;
+  }
+
+  // do a cumsum in order of data
+  float cum_sum_prob = 0.0f;
+  float top_p_sum = 0.0f;
+  for (auto it = data.begin(); it != data.end(); ++it) {
+    float prob = it->first / sum;
+    if (cum_sum_prob < top_p) {
+      top_p_sum += prob;
+    }
+    cum_sum_prob += prob;
+    it->first = cum_sum_prob;
+  }
+  // pick a number based on random in (0, 1)
+  for (auto it = data.begin(); it != data.end(); ++it) {
+    if (uniform_sample < it->first / top_p_sum) {
+      return it->second;
+    }
+  }
+  TVM_FFI_ICHECK_LE(uniform_sample, data[0].first);
+  return data[0].second;
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("vm.builtin.sample_top_p_from_logits_masked", SampleTopPFromLogitsMasked);
+}
+
+int64_t SampleTopPFromProbImpl(const float* p_prob, int64_t ndata, double top_p,
+                               double uniform_sample) {
   // Key observation: when we are doing top_p sampling
   // usually we only need to preserve some of the elements with
   // high probablities before we do sort
   std::vector<std::pair<float, int>> data;
-  int64_t ndata = prob->shape[prob->ndim - 1];
-  const float* p_prob = static_cast<float*>(prob->data);
 
   auto sample_top_p_with_filter = [&](float cuttoff) -> int64_t {
     data.clear();
@@ -520,6 +591,24 @@ int SampleTopPFromProb(Tensor prob, double top_p, double uniform_sample) {
   return sampled_index;
 }
 
+int SampleTopPFromProb(Tensor prob, double top_p, double uniform_sample) {
+  TVM_FFI_ICHECK(prob.IsContiguous());
+  TVM_FFI_ICHECK((prob.DataType() == DLDataType{kDLFloat, 32, 1}));
+
+  if (prob->device.device_type != kDLCPU) {
+    prob = prob.CopyTo(DLDevice{kDLCPU, 0});
+  }
+
+  TVM_FFI_ICHECK(prob->device.device_type == kDLCPU);
+
+  for (int i = 0; i < prob->ndim - 1; ++i) {
+    TVM_FFI_ICHECK_EQ(prob->shape[i], 1) << "The leading dimensions of logits must be 1";
+  }
+
+  return SampleTopPFromProbImpl(static_cast<float*>(prob->data), prob->shape[prob->ndim - 1],
+                                top_p, uniform_sample);
+}
+
 TVM_FFI_STATIC_INIT_BLOCK() {
   namespace refl = tvm::ffi::reflection;
   refl::GlobalDef().def("vm.builtin.sample_top_p_from_prob", SampleTopPFromProb);
@@ -662,6 +751,355 @@ TVM_FFI_STATIC_INIT_BLOCK() {
   refl::GlobalDef().def("vm.builtin.apply_softmax_with_temperature", ApplySoftmaxWithTemperature);
 }
 
+/*!
+ * \brief Gather rows of a batched tensor into a compacted tensor.
+ *
+ * With continuous batching the rows of interest change every step as
+ * sequences join and leave. The gather runs as device-to-device copies on
+ * the default stream, so compacting logits of the surviving sequences does
+ * not synchronize with the host.
+ *
+ * \param src The source tensor of shape (num_rows, ...), on any device.
+ * \param row_indices The rows to gather, int32 on CPU.
+ * \return A tensor of shape (row_indices.size, ...) on the device of `src`.
+ */
+Tensor GatherRows(Tensor src, Tensor row_indices) {
+  TVM_FFI_ICHECK(src.IsContiguous());
+  TVM_FFI_ICHECK(row_indices.IsContiguous());
+  TVM_FFI_ICHECK_GE(src->ndim, 1);
+  TVM_FFI_ICHECK((row_indices.DataType() == DLDataType{kDLInt, 32, 1}))
+      << "row indices must be int32!";
+  TVM_FFI_ICHECK(row_indices->device.device_type == kDLCPU) << "row_indices device must be CPU!";
+
+  int64_t num_rows = 1;
+  for (int i = 0; i < row_indices->ndim; ++i) {
+    num_rows *= row_indices->shape[i];
+  }
+  std::vector<int64_t> dst_shape(src->shape, src->shape + src->ndim);
+  dst_shape[0] = num_rows;
+  Tensor dst = Tensor::Empty(ffi::Shape(dst_shape), src->dtype, src->device);
+
+  int64_t row_elems = 1;
+  for (int i = 1; i < src->ndim; ++i) {
+    row_elems *= src->shape[i];
+  }
+  int64_t row_nbytes = row_elems * ((src->dtype.bits * src->dtype.lanes + 7) / 8);
+  std::vector<int64_t> row_shape(src->shape, src->shape + src->ndim);
+  row_shape[0] = 1;
+
+  const int32_t* indices = static_cast<int32_t*>(row_indices->data);
+  for (int64_t i = 0; i < num_rows; ++i) {
+    int32_t row = indices[i];
+    TVM_FFI_ICHECK(row >= 0 && row < src->shape[0])
+        << "Row index " << row << " is out of range [0, " << src->shape[0] << ")";
+    DLTensor src_view = *src.operator->();
+    src_view.shape = row_shape.data();
+    src_view.byte_offset = src->byte_offset + row * row_nbytes;
+    DLTensor dst_view = *dst.operator->();
+    dst_view.shape = row_shape.data();
+    dst_view.byte_offset = dst->byte_offset + i * row_nbytes;
+    Tensor::CopyFromTo(&src_view, &dst_view);
+  }
+  return dst;
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("vm.builtin.gather_rows", GatherRows);
+}
+
+/*!
+ * \brief Sample one token per sequence from a batch of logits with
+ * per-sequence temperature and top_p, fused into a single call.
+ *
+ * This is the continuous-batching counterpart of
+ * `vm.builtin.sample_top_p_from_logits`: one crossing of the FFI boundary
+ * covers the whole dynamic batch instead of one call per sequence.
+ * A temperature below 1e-6 degenerates to argmax for that sequence.
+ *
+ * \param logits The logits of shape (batch_size, vocab_size), float32 on CPU.
+ * \param temperature The per-sequence temperature, float32 on CPU.
+ * \param top_p The per-sequence top_p, float32 on CPU.
+ * \param uniform_samples The per-sequence uniform random numbers in (0, 1),
+ *        float32 on CPU.
+ * \return The sampled token ids, int64 of shape (batch_size, 1) on CPU.
+ */
+Tensor BatchSampleTopPFromLogits(Tensor logits, Tensor temperature, Tensor top_p,
+                                 Tensor uniform_samples) {
+  TVM_FFI_ICHECK(logits.IsContiguous());
+  TVM_FFI_ICHECK(temperature.IsContiguous());
+  TVM_FFI_ICHECK(top_p.IsContiguous());
+  TVM_FFI_ICHECK(uniform_samples.IsContiguous());
+  TVM_FFI_ICHECK((logits.DataType() == DLDataType{kDLFloat, 32, 1}))
+      << "Logits data type is not float32!";
+  TVM_FFI_ICHECK((temperature.DataType() == DLDataType{kDLFloat, 32, 1}));
+  TVM_FFI_ICHECK((top_p.DataType() == DLDataType{kDLFloat, 32, 1}));
+  TVM_FFI_ICHECK((uniform_samples.DataType() == DLDataType{kDLFloat, 32, 1}));
+  TVM_FFI_ICHECK(logits->device.device_type == kDLCPU) << "logits device must be CPU!";
+  TVM_FFI_ICHECK(temperature->device.device_type == kDLCPU) << "temperature device must be CPU!";
+  TVM_FFI_ICHECK(top_p->device.device_type == kDLCPU) << "top_p device must be CPU!";
+  TVM_FFI_ICHECK(uniform_samples->device.device_type == kDLCPU)
+      << "uniform_samples device must be CPU!";
+  TVM_FFI_ICHECK_EQ(logits->ndim, 2) << "logits must be of shape (batch_size, vocab_size)";
+
+  int64_t batch_size = logits->shape[0];
+  int64_t vocab_size = logits->shape[1];
+  TVM_FFI_ICHECK_EQ(temperature->shape[0], batch_size);
+  TVM_FFI_ICHECK_EQ(top_p->shape[0], batch_size);
+  TVM_FFI_ICHECK_EQ(uniform_samples->shape[0], batch_size);
+
+  const float* p_logits = static_cast<float*>(logits->data);
+  const float* p_temperature = static_cast<float*>(temperature->data);
+  const float* p_top_p = static_cast<float*>(top_p->data);
+  const float* p_uniform = static_cast<float*>(uniform_samples->data);
+  Tensor result = Tensor::Empty({batch_size, 1}, DLDataType{kDLInt, 64, 1}, logits->device);
+  int64_t* p_result = static_cast<int64_t*>(result->data);
+
+  std::vector<float> prob(vocab_size);
+  for (int64_t i = 0; i < batch_size; ++i) {
+    const float* row = p_logits + i * vocab_size;
+    if (p_temperature[i] < 1e-6f) {
+      p_result[i] = std::max_element(row, row + vocab_size) - row;
+      continue;
+    }
+    // Softmax with temperature, streamed in one pass over the row.
+    float inv_temp = 1.0f / p_temperature[i];
+    float m = std::numeric_limits<float>::min();
+    double d = 0.0f;
+    for (int64_t j = 0; j < vocab_size; ++j) {
+      float x = row[j] * inv_temp;
+      float m_prev = m;
+      m = std::max(m, x);
+      d = d * std::exp(m_prev - m) + std::exp(x - m);
+    }
+    for (int64_t j = 0; j < vocab_size; ++j) {
+      prob[j] = std::exp(row[j] * inv_temp - m) / d;
+    }
+    p_result[i] = SampleTopPFromProbImpl(prob.data(), vocab_size, p_top_p[i], p_uniform[i]);
+  }
+  return result;
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("vm.builtin.batch_sample_top_p_from_logits", BatchSampleTopPFromLogits);
+}
+
+/*!
+ * \brief In-process handshake between a draft and a target model running in one
+ * virtual machine (see VMExecutable::Link).
+ *
+ * The draft side submits a batch of proposed tokens together with their proposal
+ * probabilities; the target side picks the batch up for verification and reports
+ * back how many tokens were accepted. Both sides run on the VM thread and share
+ * the device stream, so the tensors are handed over by reference without any
+ * copy or inter-process communication.
+ */
+class SpeculativeHandshakeObj : public ffi::Object {
+ public:
+  /*! \brief The proposed draft tokens, of shape (num_draft_tokens,). */
+  Tensor draft_tokens;
+  /*! \brief The proposal probabilities, of shape (num_draft_tokens, vocab_size). */
+  Tensor draft_probs;
+  /*! \brief The number of accepted tokens of the last verified batch, or -1. */
+  int64_t num_accepted = -1;
+  /*! \brief Whether a submitted batch is waiting for verification. */
+  bool has_pending_draft = false;
+
+  void SubmitDraft(Tensor tokens, Tensor probs) {
+    TVM_FFI_CHECK(!has_pending_draft, ValueError)
+        << "The previous draft batch has not been verified yet";
+    TVM_FFI_ICHECK_EQ(tokens->ndim, 1) << "draft tokens must be of shape (num_draft_tokens,)";
+    TVM_FFI_ICHECK_EQ(probs->ndim, 2)
+        << "draft probs must be of shape (num_draft_tokens, vocab_size)";
+    TVM_FFI_ICHECK_EQ(tokens->shape[0], probs->shape[0])
+        << "draft tokens and probs must agree on the number of draft tokens";
+    draft_tokens = std::move(tokens);
+    draft_probs = std::move(probs);
+    has_pending_draft = true;
+  }
+
+  Tensor GetDraftTokens() const {
+    TVM_FFI_CHECK(has_pending_draft, ValueError) << "No draft batch has been submitted";
+    return draft_tokens;
+  }
+
+  Tensor GetDraftProbs() const {
+    TVM_FFI_CHECK(has_pending_draft, ValueError) << "No draft batch has been submitted";
+    return draft_probs;
+  }
+
+  void CommitAccepted(int64_t accepted) {
+    TVM_FFI_CHECK(has_pending_draft, ValueError) << "No draft batch to verify";
+    TVM_FFI_CHECK(0 <= accepted && accepted <= draft_tokens->shape[0], ValueError)
+        << "The number of accepted tokens (" << accepted << ") is out of range [0, "
+        << draft_tokens->shape[0] << "]";
+    num_accepted = accepted;
+    has_pending_draft = false;
+    draft_tokens = Tensor();
+    draft_probs = Tensor();
+  }
+
+  int64_t GetNumAccepted() const {
+    TVM_FFI_CHECK(num_accepted >= 0, ValueError) << "No draft batch has been verified yet";
+    return num_accepted;
+  }
+
+  static constexpr const bool _type_mutable = true;
+  TVM_FFI_DECLARE_OBJECT_INFO_FINAL("relax.vm.SpeculativeHandshake", SpeculativeHandshakeObj,
+                                    ffi::Object);
+};
+
+/*! \brief reference to the speculative handshake. */
+class SpeculativeHandshake : public ffi::ObjectRef {
+ public:
+  static SpeculativeHandshake Create() {
+    return SpeculativeHandshake(ffi::make_object<SpeculativeHandshakeObj>());
+  }
+
+  TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(SpeculativeHandshake, ffi::ObjectRef,
+                                             SpeculativeHandshakeObj);
+};
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef()
+      .def("vm.builtin.speculative_handshake_create", SpeculativeHandshake::Create)
+      .def_method("vm.builtin.speculative_submit_draft", &SpeculativeHandshakeObj::SubmitDraft)
+      .def_method("vm.builtin.speculative_get_draft_tokens",
+                  &SpeculativeHandshakeObj::GetDraftTokens)
+      .def_method("vm.builtin.speculative_get_draft_probs",
+                  &SpeculativeHandshakeObj::GetDraftProbs)
+      .def_method("vm.builtin.speculative_commit_accepted",
+                  &SpeculativeHandshakeObj::CommitAccepted)
+      .def_method("vm.builtin.speculative_get_num_accepted",
+                  &SpeculativeHandshakeObj::GetNumAccepted);
+}
+
+/*!
+ * \brief Streaming token ingestion ring between a tokenizer thread and the VM.
+ *
+ * A fixed ring of staging slots, each backed by a page-locked host buffer (the
+ * "global.pinned" memory scope) and a matching preallocated device buffer.
+ * The tokenizer thread pushes raw token-id spans into the next free host slot;
+ * the VM pops a slot, which issues one host-to-device copy into the slot's
+ * device buffer and returns a view of it sized to the span. Neither side
+ * allocates per request, and both entry points are plain FFI calls, so a
+ * foreign thread can push without holding the Python interpreter lock.
+ *
+ * Synchronization follows support::SpscRingBuffer: one producer thread and one
+ * consumer thread coordinate through monotonically increasing head/tail
+ * positions, so no lock is taken on either path. The tensor returned by a pop
+ * aliases the slot's device buffer and remains valid until that slot is popped
+ * again, i.e. for `num_slots` further pops.
+ */
+class TokenIngestRingObj : public ffi::Object {
+ public:
+  TokenIngestRingObj(int64_t num_slots, int64_t max_tokens_per_slot, Device device) {
+    TVM_FFI_CHECK(num_slots > 0, ValueError) << "The number of slots must be positive";
+    TVM_FFI_CHECK(max_tokens_per_slot > 0, ValueError)
+        << "The number of tokens per slot must be positive";
+    DLDataType dtype{kDLInt, 32, 1};
+    Device host{kDLCPU, 0};
+    for (int64_t i = 0; i < num_slots; ++i) {
+      host_slots_.push_back(
+          Tensor::Empty(ffi::Shape({max_tokens_per_slot}), dtype, host, "global.pinned"));
+      device_slots_.push_back(Tensor::Empty(ffi::Shape({max_tokens_per_slot}), dtype, device));
+    }
+    lengths_.resize(num_slots, 0);
+    max_tokens_per_slot_ = max_tokens_per_slot;
+  }
+
+  /*!
+   * \brief Stage a span of token ids. Producer side only, non-blocking.
+   * \param tokens The token ids, a 1-D int32 host tensor (e.g. a DLPack view
+   *        of the tokenizer output).
+   * \return Whether a free slot was available.
+   */
+  bool Push(Tensor tokens) {
+    TVM_FFI_ICHECK_EQ(tokens->ndim, 1) << "tokens must be a 1-D span of token ids";
+    TVM_FFI_ICHECK(tokens->dtype.code == kDLInt && tokens->dtype.bits == 32 &&
+                   tokens->dtype.lanes == 1)
+        << "tokens must be int32";
+    TVM_FFI_ICHECK_EQ(tokens->device.device_type, kDLCPU) << "tokens must reside on the host";
+    TVM_FFI_ICHECK(tokens.IsContiguous()) << "tokens must be contiguous";
+    int64_t num_tokens = tokens->shape[0];
+    TVM_FFI_CHECK(num_tokens <= max_tokens_per_slot_, ValueError)
+        << "The span of " << num_tokens << " token ids exceeds the slot capacity of "
+        << max_tokens_per_slot_;
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) == host_slots_.size()) {
+      return false;
+    }
+    size_t slot = static_cast<size_t>(tail % host_slots_.size());
+    const void* src = static_cast<const char*>(tokens->data) + tokens->byte_offset;
+    std::memcpy(host_slots_[slot]->data, src, num_tokens * sizeof(int32_t));
+    lengths_[slot] = num_tokens;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /*! \return Whether a staged span is ready to pop. Consumer side only. */
+  bool CanPop() const {
+    return head_.load(std::memory_order_relaxed) != tail_.load(std::memory_order_acquire);
+  }
+
+  /*!
+   * \brief Take the oldest staged span to the device. Consumer side only.
+   * \return A device tensor of shape (num_tokens,) aliasing the slot's device
+   *         buffer; valid until the slot is popped again.
+   */
+  Tensor Pop() {
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    TVM_FFI_CHECK(head != tail_.load(std::memory_order_acquire), ValueError)
+        << "The token ingest ring is empty";
+    size_t slot = static_cast<size_t>(head % host_slots_.size());
+    int64_t num_tokens = lengths_[slot];
+    DLDataType dtype{kDLInt, 32, 1};
+    Tensor device_view = device_slots_[slot].CreateView(ffi::Shape({num_tokens}), dtype, 0);
+    device_view.CopyFrom(host_slots_[slot].CreateView(ffi::Shape({num_tokens}), dtype, 0));
+    head_.store(head + 1, std::memory_order_release);
+    return device_view;
+  }
+
+  static constexpr const bool _type_mutable = true;
+  TVM_FFI_DECLARE_OBJECT_INFO_FINAL("relax.vm.TokenIngestRing", TokenIngestRingObj, ffi::Object);
+
+ private:
+  /*! \brief Page-locked host staging buffers, one per slot. */
+  std::vector<Tensor> host_slots_;
+  /*! \brief Preallocated device buffers, one per slot. */
+  std::vector<Tensor> device_slots_;
+  /*! \brief Number of staged tokens of each slot, written before the tail is released. */
+  std::vector<int64_t> lengths_;
+  /*! \brief Capacity of each slot in tokens. */
+  int64_t max_tokens_per_slot_ = 0;
+  /*! \brief Consumer position, monotonically increasing. */
+  std::atomic<uint64_t> head_{0};
+  /*! \brief Producer position, monotonically increasing. */
+  std::atomic<uint64_t> tail_{0};
+};
+
+/*! \brief reference to the token ingest ring. */
+class TokenIngestRing : public ffi::ObjectRef {
+ public:
+  static TokenIngestRing Create(int64_t num_slots, int64_t max_tokens_per_slot, Device device) {
+    return TokenIngestRing(
+        ffi::make_object<TokenIngestRingObj>(num_slots, max_tokens_per_slot, device));
+  }
+
+  TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(TokenIngestRing, ffi::ObjectRef, TokenIngestRingObj);
+};
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef()
+      .def("vm.builtin.token_ingest_ring_create", TokenIngestRing::Create)
+      .def_method("vm.builtin.token_ingest_push", &TokenIngestRingObj::Push)
+      .def_method("vm.builtin.token_ingest_can_pop", &TokenIngestRingObj::CanPop)
+      .def_method("vm.builtin.token_ingest_pop", &TokenIngestRingObj::Pop);
+}
+
 }  // namespace vm
 }  // namespace runtime
 }  // namespace tvm
@@ -31,11 +31,13 @@
 #include <tvm/support/cuda/nvtx.h>
 
 #include <algorithm>
+#include <list>
 #include <numeric>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "../../support/utils.h"
 #include "attn_backend.h"
 #include "attn_utils.h"
 #include "kv_state.h"
@@ -52,6 +54,35 @@ namespace vm {
 // runtime API function calls
 //-------------------------------------------
 
+/*!
+ * \brief Point a cached view at the given shape over the source tensor, reusing the
+ * previously created view when it still matches.
+ *
+ * Steady-state decode requests the same view shapes on every forward step, so reuse
+ * removes the per-step view container allocations and refcount traffic. Reuse is safe
+ * without re-validation because a matching view was validated against the same backing
+ * tensor when it was created.
+ */
+void UpdateCachedView(Tensor* cached_view, const Tensor& source, ffi::Shape shape,
+                      DLDataType dtype) {
+  const Tensor& cached = *cached_view;
+  bool reusable = cached.defined() && cached->data == source->data &&
+                  cached->byte_offset == source->byte_offset && cached->dtype.code == dtype.code &&
+                  cached->dtype.bits == dtype.bits && cached->dtype.lanes == dtype.lanes &&
+                  static_cast<size_t>(cached->ndim) == shape.size();
+  if (reusable) {
+    for (int i = 0; i < cached->ndim; ++i) {
+      if (cached->shape[i] != shape[i]) {
+        reusable = false;
+        break;
+      }
+    }
+  }
+  if (!reusable) {
+    *cached_view = source.CreateView(shape, dtype);
+  }
+}
+
 /*!
  * \brief The paged KV cache for attention.
  * - It supports managing the K/V data of **multiple sequences**.
@@ -71,6 +102,13 @@ namespace vm {
  *   - step 3. use `EndForward` to mark the end of forwarding this round.
  *     After calling `EndForward`, it is required to call `BeginForward`
  *     before calling any `Attention`.
+ * - A long prefill does not need to be a single round: the append length
+ * of a sequence in `BeginForward` may be any partial length, and the
+ * queries of the round attend to the previously appended KV data plus
+ * causally to the round's own tokens, so splitting a prefill into chunks
+ * across rounds computes the same result. `PlanPrefillChunks` and
+ * `GetPrefillChunkCosts` give the scheduler the chunk plan and per-chunk
+ * cost hints for interleaving decode rounds between the chunks.
  */
 class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
  private:
@@ -117,6 +155,12 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
 
   /*! \brief The KV cache dtype. */
   const DLDataType kv_dtype_;
+  /*!
+   * \brief The dtype the KV pages are stored in. It equals kv_dtype_ unless
+   * quantized KV storage (fp8/int8) is enabled, in which case the compiled
+   * append/attention kernels quantize on write and dequantize on read.
+   */
+  const DLDataType kv_storage_dtype_;
   /*! \brief We fix int32 to be the index dtype of auxiliary data. */
   const DLDataType dtype_aux_ = DLDataType{kDLInt, 32, 1};
 
@@ -145,6 +189,90 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
   /*! \brief The list of free available blocks (in their indices). */
   std::vector<int32_t> free_block_idx_;
 
+  /********************* Prefix Matching Structures *********************/
+
+  /*! \brief The seed of the rolling hash over committed token pages. */
+  static constexpr uint64_t kPrefixHashSeed = 0x9e3779b97f4a7c15ULL;
+  /*! \brief The committed token record of a sequence for prefix matching. */
+  struct CommittedTokenLog {
+    /*! \brief The committed tokens of the sequence, starting from position 0. */
+    std::vector<int32_t> tokens;
+    /*! \brief The rolling hash of the token prefix at each full page boundary. */
+    std::vector<uint64_t> page_hashes;
+  };
+  /*! \brief The committed token log of each sequence. */
+  std::unordered_map<int64_t, CommittedTokenLog> seq_token_log_;
+  /*!
+   * \brief Index from the rolling hash of a page-aligned token prefix to the
+   * (seq_id, num_pages) pair that most recently committed that prefix.
+   * Entries can go stale when sequences are removed or popped; they are
+   * verified against the actual token logs at match time.
+   */
+  std::unordered_map<uint64_t, std::pair<int64_t, int32_t>> prefix_index_;
+
+  /********************* Host Offload Tier *********************/
+
+  /*!
+   * \brief The KV data of the host offload tier, with one Tensor per layer.
+   * Each Tensor shares the per-page layout of the corresponding device
+   * Tensor in `pages_`, with `num_host_pages_` pages, and resides in pinned
+   * host memory when available. The tier is allocated lazily by
+   * `EnableHostOffload`.
+   */
+  std::vector<Tensor> host_pages_;
+  /*! \brief The number of pages in the host tier, or 0 when offload is not enabled. */
+  int64_t num_host_pages_ = 0;
+  /*! \brief The list of ids of free host pages. */
+  std::vector<int32_t> free_host_page_ids_;
+  /*!
+   * \brief The mapping from the index of an offloaded block to the host
+   * page ids holding its KV data. The host page ids are parallel to the
+   * block's device `page_ids` before offload, which are released while
+   * the block stays offloaded.
+   */
+  std::unordered_map<int32_t, std::vector<int32_t>> block_host_page_ids_;
+
+  /********************* VTCM Working-Set Tier *********************/
+
+  /*!
+   * \brief The KV data of the VTCM working-set tier, with one Tensor per
+   * layer. Each Tensor shares the per-page layout of the corresponding
+   * device Tensor in `pages_`, with `num_vtcm_pages_` pages, and resides
+   * in VTCM. The tier is allocated lazily by `EnableVTCMWorkingSet`.
+   *
+   * The tier is a read-only cache of full pages: appends keep writing
+   * through to the DDR pages, and staged copies are refreshed by DMA at
+   * BeginForward, so evicting a slot never needs a copy back.
+   */
+  std::vector<Tensor> vtcm_pages_;
+  /*! \brief The number of pages in the VTCM tier, or 0 when it is not enabled. */
+  int64_t num_vtcm_pages_ = 0;
+  /*! \brief The list of ids of free VTCM slots. */
+  std::vector<int32_t> free_vtcm_slot_ids_;
+  /*! \brief The staged device page ids, most recently used at the front. */
+  std::list<int32_t> vtcm_lru_;
+  /*! \brief The VTCM slot staging a device page, with its LRU position. */
+  struct VTCMSlot {
+    int32_t slot_id;
+    std::list<int32_t>::iterator lru_it;
+  };
+  /*! \brief The mapping from staged device page ids to their VTCM slots. */
+  std::unordered_map<int32_t, VTCMSlot> page_vtcm_slot_;
+  /*! \brief Host copy of the page-id-to-VTCM-slot map, -1 for unstaged pages. */
+  Tensor vtcm_page_map_host_;
+  /*! \brief Device copy of the page-id-to-VTCM-slot map for attention kernels. */
+  Tensor vtcm_page_map_device_;
+  /*! \brief Whether the device page map is behind the host one. */
+  bool vtcm_page_map_dirty_ = false;
+  /*! \brief The number of DMA copies issued and not yet waited for. */
+  int vtcm_inflight_dma_ = 0;
+  /*! \brief The source and destination of the last issued DMA copy. */
+  Tensor vtcm_last_dma_src_;
+  Tensor vtcm_last_dma_dst_;
+  /*! \brief The hexagon user-DMA copy and wait functions. */
+  ffi::Function f_vtcm_dma_copy_;
+  ffi::Function f_vtcm_dma_wait_;
+
   /*********** Current Batch Info & Auxiliary Arrays on Device ***********/
   //-------------------------------------------
   // The following fields are auxiliary arrays on device.
@@ -173,6 +301,14 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
   bool append_before_attn_;
   /*! \brief Whether to use decode kernel for each depth. (see GetChunkedBlockIds) */
   std::vector<bool> use_decode_kernel_;
+  /*!
+   * \brief The kernel choice the last plan of each depth was made with:
+   * 1 decode, 0 prefill, -1 not planned yet. The prefill and decode functions
+   * share the per-depth attention workspace, so when the choice flips, the
+   * plan the now-active function may still have cached for the workspace must
+   * be dropped (see MHAKernelBeginForward).
+   */
+  std::vector<int> last_planned_use_decode_kernel_;
   /*! \brief Whether the attention request is a decode request, set in BeginForwardFunction. */
   bool is_decode_request_;
   /*! \brief The KV transfer recver disco group's PE offset in this forward.
@@ -242,6 +378,9 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
   Tensor kv_transfer_page_to_page_local_position_map_view_;
   Tensor kv_transfer_page_to_page_remote_position_map_view_;
   Tensor kv_transfer_page_to_page_recver_id_view_;
+  Tensor temp_attn_q_view_;
+  Tensor temp_attn_k_view_;
+  Tensor temp_attn_v_view_;
   Tensor temp_attn_output_view_;
   Tensor temp_attn_lse_view_;
   Tensor merged_attn_lse_view_;
@@ -293,7 +432,8 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
       int64_t num_total_pages, int64_t prefill_chunk_size, bool support_sliding_window,
       RoPEMode rope_mode, double rotary_scale, double rotary_theta,
       ffi::Optional<Tensor> rope_ext_factors, bool enable_kv_transfer, DLDataType dtype,
-      Device device, ffi::Optional<ffi::Function> f_transpose_append_mha,
+      DLDataType kv_storage_dtype, Device device,
+      ffi::Optional<ffi::Function> f_transpose_append_mha,
       ffi::Optional<ffi::Function> f_transpose_append_mla, ffi::Function f_compact_copy,
       std::unique_ptr<RaggedPrefillFunc> f_attention_prefill_ragged,
       std::unique_ptr<PagedPrefillFunc> f_attention_prefill,
@@ -327,6 +467,7 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
         rotary_theta_(rotary_theta),
         rope_ext_factors_(std::move(rope_ext_factors)),
         kv_dtype_(dtype),
+        kv_storage_dtype_(kv_storage_dtype),
         reserved_num_seqs_(reserved_num_seqs),
         f_transpose_append_mha_(std::move(f_transpose_append_mha)),
         f_transpose_append_mla_(std::move(f_transpose_append_mla)),
@@ -351,6 +492,10 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
       TVM_FFI_ICHECK(!enable_kv_transfer) << "KV transfer not supported yet for MLA";
     }
 
+    if (!(kv_storage_dtype_ == kv_dtype_)) {
+      TVM_FFI_ICHECK(!enable_kv_transfer) << "KV transfer does not support quantized KV storage.";
+    }
+
     pages_.reserve(num_layers);
     if (enable_kv_transfer) {
       // For now, KV transfer only supports MHA.
@@ -387,7 +532,7 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
         ffi::Shape kv_cache_shape =
             GetKVCacheShape(attn_kinds_[layer_id_begin_offset_ + i], num_total_pages,
                             reserved_num_seqs, num_kv_heads, page_size, qk_head_dim, v_head_dim);
-        pages_.push_back(Tensor::Empty(kv_cache_shape, dtype, device));
+        pages_.push_back(Tensor::Empty(kv_cache_shape, kv_storage_dtype, device));
       }
     }
 
@@ -449,9 +594,9 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
 
     for (int d = 0; d < kPagedKVCacheMaxBlockDepth; ++d) {
       if (NeedKernelBeginForward()) {
-        temp_int_attn_workspace_.push_back(
-            Tensor::Empty({kIntAttnWorkspaceByte}, DLDataType{kDLUInt, 8, 1}, device));
-        temp_int_pinned_attn_workspace_.push_back(Tensor::Empty(
+        temp_int_attn_workspace_.push_back(AuxBufferPool::Global()->Alloc(
+            {kIntAttnWorkspaceByte}, DLDataType{kDLUInt, 8, 1}, device));
+        temp_int_pinned_attn_workspace_.push_back(AuxBufferPool::Global()->Alloc(
             {kIntAttnWorkspaceByte}, DLDataType{kDLUInt, 8, 1}, GetPreferredHostDevice(device)));
       }
       qo_indptr_on_depths_view_.push_back(Tensor());
@@ -466,15 +611,16 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
       tree_attn_mask_view_.push_back(Tensor());
       tree_attn_mn_indptr_view_.push_back(Tensor());
       is_chain_on_depths_.push_back(true);
+      last_planned_use_decode_kernel_.push_back(-1);
     }
     // Additional workspace for the "prefill with ragged kv" kernel.
     if (NeedKernelBeginForward()) {
-      temp_int_attn_workspace_.push_back(
-          Tensor::Empty({kIntAttnWorkspaceByte}, DLDataType{kDLUInt, 8, 1}, device));
-      temp_int_pinned_attn_workspace_.push_back(Tensor::Empty(
+      temp_int_attn_workspace_.push_back(AuxBufferPool::Global()->Alloc(
+          {kIntAttnWorkspaceByte}, DLDataType{kDLUInt, 8, 1}, device));
+      temp_int_pinned_attn_workspace_.push_back(AuxBufferPool::Global()->Alloc(
           {kIntAttnWorkspaceByte}, DLDataType{kDLUInt, 8, 1}, GetPreferredHostDevice(device)));
-      temp_float_attn_workspace_ =
-          Tensor::Empty({kFloatAttnWorkspaceByte}, DLDataType{kDLUInt, 8, 1}, device);
+      temp_float_attn_workspace_ = AuxBufferPool::Global()->Alloc(
+          {kFloatAttnWorkspaceByte}, DLDataType{kDLUInt, 8, 1}, device);
     }
 
     if (std::find(attn_kinds_.begin(), attn_kinds_.end(), AttnKind::kMHA) != attn_kinds_.end()) {
@@ -527,6 +673,17 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
   }
 
   ~PagedAttentionKVCacheObj() {
+    // Return the attention workspaces to the pool so that the next cache
+    // instance skips the device and pinned-host allocations.
+    for (Tensor& workspace : temp_int_attn_workspace_) {
+      AuxBufferPool::Global()->Recycle(std::move(workspace));
+    }
+    for (Tensor& workspace : temp_int_pinned_attn_workspace_) {
+      AuxBufferPool::Global()->Recycle(std::move(workspace));
+    }
+    if (temp_float_attn_workspace_.defined()) {
+      AuxBufferPool::Global()->Recycle(std::move(temp_float_attn_workspace_));
+    }
     // Free the copy stream if defined.
     if (copy_stream_ != nullptr) {
       DeviceAPI::Get(device_)->FreeStream(device_, copy_stream_);
@@ -545,6 +702,13 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
     }
     global_block_pool_.clear();
     free_block_idx_.clear();
+    seq_token_log_.clear();
+    prefix_index_.clear();
+    block_host_page_ids_.clear();
+    free_host_page_ids_.clear();
+    for (int64_t page_id = num_host_pages_ - 1; page_id >= 0; --page_id) {
+      free_host_page_ids_.push_back(page_id);
+    }
     dirty_aux_data_device_ = false;
   }
 
@@ -570,6 +734,14 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
       for (int32_t page_id : global_block_pool_[block_idx].page_ids) {
         free_page_ids_.push_back(page_id);
       }
+      // - Free the host pages of the block if it was offloaded.
+      auto host_it = block_host_page_ids_.find(block_idx);
+      if (host_it != block_host_page_ids_.end()) {
+        for (int32_t host_page_id : host_it->second) {
+          free_host_page_ids_.push_back(host_page_id);
+        }
+        block_host_page_ids_.erase(host_it);
+      }
       free_block_idx_.push_back(block_idx);
       block_idx = global_block_pool_[block_idx].parent_idx;
     }
@@ -579,6 +751,9 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
       --global_block_pool_[block_idx].external_ref_cnt;
     }
     seq_map_.erase(it);
+    // The entries of the removed sequence in the prefix index become stale
+    // and are invalidated lazily at match time.
+    seq_token_log_.erase(seq_id);
     dirty_aux_data_device_ = true;
   }
 
@@ -600,6 +775,12 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
       fork_pos = parent_it->second.seq_length;
     }
 
+    // Bring any offloaded blocks of the parent back to device, since the
+    // fork may split blocks and copy pages partially.
+    if (!block_host_page_ids_.empty()) {
+      PrefetchSequenceFromHost(&parent_it->second);
+    }
+
     if (parent_it->second.sliding_window_size != -1) {
       // If forked sequence has been enabled sliding window, check the forked position is within
       // sliding window sink size.
@@ -694,9 +875,390 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
     }
     // Create the child sequence with the child block.
     seq_map_.insert({child_seq_id, Sequence(&global_block_pool_, child_block_idx)});
+    // The child shares the parent's committed tokens up to the fork position.
+    auto parent_log_it = seq_token_log_.find(parent_seq_id);
+    if (parent_log_it != seq_token_log_.end()) {
+      CommittedTokenLog child_log;
+      size_t num_tokens =
+          std::min(parent_log_it->second.tokens.size(), static_cast<size_t>(fork_pos));
+      child_log.tokens.assign(parent_log_it->second.tokens.begin(),
+                              parent_log_it->second.tokens.begin() + num_tokens);
+      child_log.page_hashes.assign(
+          parent_log_it->second.page_hashes.begin(),
+          parent_log_it->second.page_hashes.begin() + num_tokens / page_size_);
+      seq_token_log_[child_seq_id] = std::move(child_log);
+    }
     dirty_aux_data_device_ = true;
   }
 
+  void CommitSequenceTokens(int64_t seq_id, const ffi::Shape& tokens) final {
+    auto it = seq_map_.find(seq_id);
+    TVM_FFI_ICHECK(it != seq_map_.end())
+        << "The sequence \"" << seq_id << "\" cannot be found in KV cache.";
+    CommittedTokenLog& log = seq_token_log_[seq_id];
+    log.tokens.reserve(log.tokens.size() + tokens.size());
+    for (int64_t token : tokens) {
+      log.tokens.push_back(static_cast<int32_t>(token));
+    }
+    TVM_FFI_ICHECK_LE(static_cast<int64_t>(log.tokens.size()), it->second.seq_length)
+        << "The committed tokens of sequence \"" << seq_id
+        << "\" exceed the current sequence length " << it->second.seq_length << ".";
+    IndexFullTokenPages(seq_id, &log);
+  }
+
+  int64_t AddSequenceWithPrefixMatch(int64_t seq_id, const ffi::Shape& tokens) final {
+    // Prefix reuse relies on forking at arbitrary page boundaries, which
+    // sliding window attention does not permit beyond the attention sink.
+    if (support_sliding_window_ || support_layer_sliding_window_) {
+      AddSequence(seq_id);
+      return 0;
+    }
+    int64_t num_full_pages = static_cast<int64_t>(tokens.size()) / page_size_;
+    int64_t matched_pages = 0;
+    int64_t matched_seq_id = -1;
+    uint64_t hash = kPrefixHashSeed;
+    for (int64_t page_idx = 0; page_idx < num_full_pages; ++page_idx) {
+      for (int64_t i = page_idx * page_size_; i < (page_idx + 1) * page_size_; ++i) {
+        hash = support::HashCombine(hash, static_cast<uint64_t>(static_cast<uint32_t>(tokens[i])));
+      }
+      auto index_it = prefix_index_.find(hash);
+      if (index_it == prefix_index_.end()) {
+        // Since the hashes of longer prefixes extend this rolling hash chain,
+        // no indexed sequence can share a longer prefix either.
+        break;
+      }
+      int64_t candidate_seq_id = index_it->second.first;
+      int64_t candidate_pages = index_it->second.second;
+      auto log_it = seq_token_log_.find(candidate_seq_id);
+      auto seq_it = seq_map_.find(candidate_seq_id);
+      // Verify against the actual token log to rule out stale index entries
+      // and hash collisions.
+      if (log_it == seq_token_log_.end() || seq_it == seq_map_.end() ||
+          candidate_pages != page_idx + 1 ||
+          static_cast<int64_t>(log_it->second.tokens.size()) < candidate_pages * page_size_ ||
+          seq_it->second.sliding_window_size != -1 ||
+          !std::equal(log_it->second.tokens.begin(),
+                      log_it->second.tokens.begin() + candidate_pages * page_size_,
+                      tokens.begin())) {
+        prefix_index_.erase(index_it);
+        break;
+      }
+      matched_pages = candidate_pages;
+      matched_seq_id = candidate_seq_id;
+    }
+    if (matched_pages == 0) {
+      AddSequence(seq_id);
+      return 0;
+    }
+    int64_t matched_len = matched_pages * page_size_;
+    // Fork from the matched sequence so the shared prefix pages are reused.
+    // ForkSequence also copies the matched token prefix into the new
+    // sequence's token log.
+    ForkSequence(matched_seq_id, seq_id, matched_len);
+    return matched_len;
+  }
+
+  /*!
+   * \brief Index the complete token pages of the given log that have not
+   * been indexed yet into the prefix index.
+   */
+  void IndexFullTokenPages(int64_t seq_id, CommittedTokenLog* log) {
+    size_t num_full_pages = log->tokens.size() / page_size_;
+    while (log->page_hashes.size() < num_full_pages) {
+      size_t page_idx = log->page_hashes.size();
+      uint64_t hash = page_idx == 0 ? kPrefixHashSeed : log->page_hashes.back();
+      for (size_t i = page_idx * page_size_; i < (page_idx + 1) * page_size_; ++i) {
+        hash = support::HashCombine(
+            hash, static_cast<uint64_t>(static_cast<uint32_t>(log->tokens[i])));
+      }
+      log->page_hashes.push_back(hash);
+      prefix_index_[hash] = {seq_id, static_cast<int32_t>(page_idx + 1)};
+    }
+  }
+
+  void EnableHostOffload(int64_t num_host_pages) final {
+    TVM_FFI_ICHECK_GT(num_host_pages, 0)
+        << "The number of host pages " << num_host_pages << " should be positive.";
+    TVM_FFI_ICHECK_EQ(num_host_pages_, 0) << "Host offload has already been enabled.";
+    TVM_FFI_ICHECK(!support_sliding_window_ && !support_layer_sliding_window_)
+        << "Host offload does not support sliding window.";
+    Device host_device = GetPreferredHostDevice(device_);
+    host_pages_.reserve(num_layers_);
+    for (int64_t layer_id = 0; layer_id < num_layers_; ++layer_id) {
+      ffi::Shape device_shape = pages_[layer_id].Shape();
+      std::vector<int64_t> host_shape{device_shape.begin(), device_shape.end()};
+      host_shape[0] = num_host_pages;
+      host_pages_.push_back(
+          Tensor::Empty(ffi::Shape(host_shape), pages_[layer_id]->dtype, host_device));
+    }
+    num_host_pages_ = num_host_pages;
+    free_host_page_ids_.reserve(num_host_pages);
+    for (int64_t page_id = num_host_pages - 1; page_id >= 0; --page_id) {
+      free_host_page_ids_.push_back(page_id);
+    }
+  }
+
+  int64_t OffloadSequenceToHost(int64_t seq_id) final {
+    TVM_FFI_ICHECK_GT(num_host_pages_, 0)
+        << "Host offload is not enabled. Please call EnableHostOffload first.";
+    auto it = seq_map_.find(seq_id);
+    TVM_FFI_ICHECK(it != seq_map_.end())
+        << "The sequence \"" << seq_id << "\" cannot be found in KV cache.";
+    TVM_FFI_ICHECK(it->second.accepted_indices_committed)
+        << "The sequence's token tree computed in the last round of forward has not been "
+           "committed with accepted nodes.";
+
+    int64_t num_offloaded_pages = 0;
+    int32_t block_idx = it->second.last_block_idx;
+    while (block_idx != -1) {
+      Block& block = global_block_pool_[block_idx];
+      // Blocks shared with other sequences stay on device, since their
+      // pages may be read by the forked sequences at any time. Blocks
+      // that are already offloaded need no further processing.
+      if (block.external_ref_cnt == 1 && !block.page_ids.empty() &&
+          !block_host_page_ids_.count(block_idx)) {
+        TVM_FFI_ICHECK_LE(block.page_ids.size(), free_host_page_ids_.size())
+            << "The host tier has no free pages to offload the sequence.";
+        std::vector<int32_t> host_page_ids;
+        host_page_ids.reserve(block.page_ids.size());
+        for (int32_t page_id : block.page_ids) {
+          int32_t host_page_id = free_host_page_ids_.back();
+          free_host_page_ids_.pop_back();
+          CopyPageBetweenTiers(page_id, host_page_id, /*device_to_host=*/true);
+          free_page_ids_.push_back(page_id);
+          host_page_ids.push_back(host_page_id);
+        }
+        num_offloaded_pages += static_cast<int64_t>(block.page_ids.size());
+        block.page_ids.clear();
+        block_host_page_ids_[block_idx] = std::move(host_page_ids);
+      }
+      block_idx = block.parent_idx;
+    }
+    if (num_offloaded_pages > 0 && copy_stream_ != compute_stream_) {
+      // The released device pages may be reused by kernels on the compute
+      // stream, so the compute stream has to wait until the offload copies
+      // on the copy stream finish.
+      DeviceAPI::Get(device_)->SyncStreamFromTo(device_, copy_stream_, compute_stream_);
+    }
+    return num_offloaded_pages;
+  }
+
+  /*!
+   * \brief Bring all offloaded blocks of the given sequence back to the
+   * device tier. The copies are issued on the copy stream, and the compute
+   * stream is guaranteed to wait for them by the auxiliary data
+   * synchronization of the next attention round.
+   */
+  void PrefetchSequenceFromHost(Sequence* seq) {
+    int32_t block_idx = seq->last_block_idx;
+    while (block_idx != -1) {
+      Block& block = global_block_pool_[block_idx];
+      auto it = block_host_page_ids_.find(block_idx);
+      if (it != block_host_page_ids_.end()) {
+        TVM_FFI_ICHECK(block.page_ids.empty());
+        TVM_FFI_ICHECK_LE(it->second.size(), free_page_ids_.size())
+            << "The KV cache has no free pages to prefetch the offloaded sequence back.";
+        block.page_ids.reserve(it->second.size());
+        for (int32_t host_page_id : it->second) {
+          int32_t page_id = GetFreePage();
+          CopyPageBetweenTiers(page_id, host_page_id, /*device_to_host=*/false);
+          free_host_page_ids_.push_back(host_page_id);
+          block.page_ids.push_back(page_id);
+        }
+        block_host_page_ids_.erase(it);
+        dirty_aux_data_device_ = true;
+      }
+      block_idx = block.parent_idx;
+    }
+  }
+
+  /*!
+   * \brief Copy one page of all layers between the device tier and the
+   * host tier on the copy stream.
+   */
+  void CopyPageBetweenTiers(int32_t device_page_id, int32_t host_page_id, bool device_to_host) {
+    for (int64_t layer_id = 0; layer_id < num_layers_; ++layer_id) {
+      const Tensor& device_pages = pages_[layer_id];
+      const Tensor& host_pages = host_pages_[layer_id];
+      int64_t page_elems = 1;
+      for (int d = 1; d < device_pages->ndim; ++d) {
+        page_elems *= device_pages->shape[d];
+      }
+      int64_t elem_byte_size = (device_pages->dtype.bits * device_pages->dtype.lanes + 7) / 8;
+      std::vector<int64_t> copy_shape{page_elems};
+      DLTensor device_view;
+      device_view.data = device_pages->data;
+      device_view.device = device_;
+      device_view.ndim = 1;
+      device_view.dtype = device_pages->dtype;
+      device_view.shape = copy_shape.data();
+      device_view.strides = nullptr;
+      device_view.byte_offset =
+          device_pages->byte_offset + device_page_id * page_elems * elem_byte_size;
+
+      DLTensor host_view = device_view;
+      host_view.data = host_pages->data;
+      host_view.device = host_pages->device;
+      host_view.byte_offset =
+          host_pages->byte_offset + host_page_id * page_elems * elem_byte_size;
+      if (device_to_host) {
+        Tensor::CopyFromTo(&device_view, &host_view, copy_stream_);
+      } else {
+        Tensor::CopyFromTo(&host_view, &device_view, copy_stream_);
+      }
+    }
+  }
+
+  void EnableVTCMWorkingSet(int64_t num_vtcm_pages) final {
+    TVM_FFI_ICHECK_GT(num_vtcm_pages, 0)
+        << "The number of VTCM pages " << num_vtcm_pages << " should be positive.";
+    TVM_FFI_ICHECK_EQ(num_vtcm_pages_, 0) << "The VTCM working set has already been enabled.";
+    TVM_FFI_CHECK(device_.device_type == kDLHexagon, ValueError)
+        << "The VTCM working set is only supported on Hexagon devices.";
+    TVM_FFI_ICHECK(!support_sliding_window_ && !support_layer_sliding_window_)
+        << "The VTCM working set does not support sliding window.";
+    auto f_dma_copy = ffi::Function::GetGlobal("vm.builtin.hexagon.dma_copy");
+    auto f_dma_wait = ffi::Function::GetGlobal("vm.builtin.hexagon.dma_wait");
+    TVM_FFI_ICHECK(f_dma_copy.has_value() && f_dma_wait.has_value())
+        << "The hexagon DMA builtins are not available in this runtime build.";
+    f_vtcm_dma_copy_ = *f_dma_copy;
+    f_vtcm_dma_wait_ = *f_dma_wait;
+    vtcm_pages_.reserve(num_layers_);
+    for (int64_t layer_id = 0; layer_id < num_layers_; ++layer_id) {
+      ffi::Shape device_shape = pages_[layer_id].Shape();
+      std::vector<int64_t> vtcm_shape{device_shape.begin(), device_shape.end()};
+      vtcm_shape[0] = num_vtcm_pages;
+      vtcm_pages_.push_back(Tensor::Empty(ffi::Shape(vtcm_shape), pages_[layer_id]->dtype, device_,
+                                          ffi::String("global.vtcm")));
+    }
+    num_vtcm_pages_ = num_vtcm_pages;
+    free_vtcm_slot_ids_.reserve(num_vtcm_pages);
+    for (int64_t slot_id = num_vtcm_pages - 1; slot_id >= 0; --slot_id) {
+      free_vtcm_slot_ids_.push_back(static_cast<int32_t>(slot_id));
+    }
+    Device preferred_host_device = GetPreferredHostDevice(device_);
+    vtcm_page_map_host_ =
+        Tensor::Empty({num_total_pages_}, DLDataType{kDLInt, 32, 1}, preferred_host_device);
+    vtcm_page_map_device_ =
+        Tensor::Empty({num_total_pages_}, DLDataType{kDLInt, 32, 1}, device_);
+    int32_t* map_data = static_cast<int32_t*>(vtcm_page_map_host_->data);
+    std::fill(map_data, map_data + num_total_pages_, -1);
+    vtcm_page_map_dirty_ = true;
+  }
+
+  Tensor GetVTCMPages(int64_t layer_id) final {
+    TVM_FFI_ICHECK_GT(num_vtcm_pages_, 0)
+        << "The VTCM working set is not enabled. Please call EnableVTCMWorkingSet first.";
+    TVM_FFI_ICHECK(layer_id >= 0 && layer_id < num_layers_)
+        << "Invalid layer id " << layer_id << " for the VTCM working set.";
+    return vtcm_pages_[layer_id];
+  }
+
+  Tensor GetVTCMPageMap() final {
+    TVM_FFI_ICHECK_GT(num_vtcm_pages_, 0)
+        << "The VTCM working set is not enabled. Please call EnableVTCMWorkingSet first.";
+    return vtcm_page_map_device_;
+  }
+
+  /*!
+   * \brief Stage the full pages of the given sequence into the VTCM tier,
+   * evicting the least recently used staged pages when the tier is full.
+   * Only full pages are staged: the partial tail page keeps receiving
+   * appends during the round, so it is always read from DDR.
+   */
+  void StageSequenceToVTCM(const Sequence* seq) {
+    int32_t block_idx = seq->last_block_idx;
+    while (block_idx != -1) {
+      const Block& block = global_block_pool_[block_idx];
+      int64_t num_full_pages = std::min(static_cast<int64_t>(block.seq_length / page_size_),
+                                        static_cast<int64_t>(block.page_ids.size()));
+      for (int64_t i = 0; i < num_full_pages; ++i) {
+        TouchVTCMPage(block.page_ids[i]);
+      }
+      block_idx = block.parent_idx;
+    }
+  }
+
+  /*! \brief Stage one device page into the VTCM tier, or refresh its LRU position. */
+  void TouchVTCMPage(int32_t page_id) {
+    auto it = page_vtcm_slot_.find(page_id);
+    if (it != page_vtcm_slot_.end()) {
+      // Full pages are immutable until popped, and pops invalidate their
+      // staged copies, so a staged page only needs its recency refreshed.
+      vtcm_lru_.splice(vtcm_lru_.begin(), vtcm_lru_, it->second.lru_it);
+      return;
+    }
+    int32_t slot_id;
+    if (!free_vtcm_slot_ids_.empty()) {
+      slot_id = free_vtcm_slot_ids_.back();
+      free_vtcm_slot_ids_.pop_back();
+    } else {
+      // DDR stays authoritative, so eviction releases the slot without a
+      // copy back.
+      int32_t victim_page_id = vtcm_lru_.back();
+      vtcm_lru_.pop_back();
+      auto victim_it = page_vtcm_slot_.find(victim_page_id);
+      slot_id = victim_it->second.slot_id;
+      page_vtcm_slot_.erase(victim_it);
+      static_cast<int32_t*>(vtcm_page_map_host_->data)[victim_page_id] = -1;
+    }
+    vtcm_lru_.push_front(page_id);
+    page_vtcm_slot_.emplace(page_id, VTCMSlot{slot_id, vtcm_lru_.begin()});
+    static_cast<int32_t*>(vtcm_page_map_host_->data)[page_id] = slot_id;
+    for (int64_t layer_id = 0; layer_id < num_layers_; ++layer_id) {
+      const Tensor& device_pages = pages_[layer_id];
+      ffi::Shape device_shape = device_pages.Shape();
+      std::vector<int64_t> page_shape{device_shape.begin(), device_shape.end()};
+      page_shape[0] = 1;
+      int64_t page_elems = 1;
+      for (size_t d = 1; d < page_shape.size(); ++d) {
+        page_elems *= page_shape[d];
+      }
+      int64_t elem_byte_size = (device_pages->dtype.bits * device_pages->dtype.lanes + 7) / 8;
+      Tensor src_view = device_pages.CreateView(ffi::Shape(page_shape), device_pages->dtype,
+                                                page_id * page_elems * elem_byte_size);
+      Tensor dst_view = vtcm_pages_[layer_id].CreateView(
+          ffi::Shape(page_shape), device_pages->dtype, slot_id * page_elems * elem_byte_size);
+      f_vtcm_dma_copy_(nullptr, src_view, dst_view, /*queue_id=*/0, /*bypass_cache=*/false);
+      vtcm_last_dma_src_ = src_view;
+      vtcm_last_dma_dst_ = dst_view;
+      ++vtcm_inflight_dma_;
+    }
+    vtcm_page_map_dirty_ = true;
+  }
+
+  /*!
+   * \brief Wait for the staging DMA copies issued in this round and push
+   * the refreshed page map to device on the copy stream.
+   */
+  void FinishVTCMStaging() {
+    if (vtcm_inflight_dma_ > 0) {
+      f_vtcm_dma_wait_(nullptr, /*queue_id=*/0, /*inflight_dma=*/0, /*bypass_cache=*/false,
+                       vtcm_last_dma_src_, vtcm_last_dma_dst_);
+      vtcm_inflight_dma_ = 0;
+    }
+    if (vtcm_page_map_dirty_) {
+      DLTensor host_view = *vtcm_page_map_host_.operator->();
+      DLTensor device_view = *vtcm_page_map_device_.operator->();
+      Tensor::CopyFromTo(&host_view, &device_view, copy_stream_);
+      vtcm_page_map_dirty_ = false;
+      dirty_aux_data_device_ = true;
+    }
+  }
+
+  /*! \brief Drop the staged copy of a device page when its content is invalidated. */
+  void InvalidateVTCMPage(int32_t page_id) {
+    auto it = page_vtcm_slot_.find(page_id);
+    if (it == page_vtcm_slot_.end()) {
+      return;
+    }
+    free_vtcm_slot_ids_.push_back(it->second.slot_id);
+    vtcm_lru_.erase(it->second.lru_it);
+    page_vtcm_slot_.erase(it);
+    static_cast<int32_t*>(vtcm_page_map_host_->data)[page_id] = -1;
+    vtcm_page_map_dirty_ = true;
+  }
+
   void CopySinglePage(int32_t src_page_id, int32_t tgt_page_id, int64_t copy_length) {
     if (copy_stream_ != compute_stream_) {
       // Set the copy stream for copy.
@@ -777,6 +1339,17 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
     // introduce more sink. Therefore, we update the given attn sink size.
     it->second.last_block_attn_sink_size = std::max(attn_sink_size - prefix_length, 0);
     it->second.sliding_window_size = sliding_window_size;
+
+    // When the sequence is already longer than the window (e.g. the policy
+    // is set after a long prefill), slide right away instead of waiting for
+    // the next append, so the fully evicted pages feed the free list
+    // immediately. Blocks referenced by forked children cannot slide; they
+    // are handled by the regular append path as before.
+    if (support_sliding_window_ && it->second.seq_length > sliding_window_size &&
+        global_block_pool_[it->second.last_block_idx].external_ref_cnt == 1) {
+      SlideWindowForSequence(&it->second);
+      dirty_aux_data_device_ = true;
+    }
   }
 
   void PopN(int64_t seq_id, int32_t n) final {
@@ -792,6 +1365,23 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
       return;
     }
 
+    // Bring any offloaded blocks back to device before popping, since
+    // popping releases device pages of the sequence directly.
+    if (!block_host_page_ids_.empty()) {
+      PrefetchSequenceFromHost(&it->second);
+    }
+
+    // Take the token log out so that the fork/remove dance below does not
+    // drop it, and truncate it to the new sequence length.
+    auto log_node = seq_token_log_.extract(seq_id);
+    if (!log_node.empty()) {
+      CommittedTokenLog& log = log_node.mapped();
+      size_t new_length =
+          std::min(log.tokens.size(), static_cast<size_t>(it->second.seq_length - n));
+      log.tokens.resize(new_length);
+      log.page_hashes.resize(new_length / page_size_);
+    }
+
     int32_t block_idx = it->second.last_block_idx;
     // The block should have at least one reference, which comes from the sequence.
     TVM_FFI_ICHECK_GE(global_block_pool_[block_idx].external_ref_cnt, 1);
@@ -818,6 +1408,12 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
         }
         it->second.seq_length -= n;
         global_block_pool_[block_idx].seq_length -= n;
+        if (num_vtcm_pages_ > 0 && !global_block_pool_[block_idx].page_ids.empty() &&
+            global_block_pool_[block_idx].seq_length % page_size_ != 0) {
+          // The pop turned the tail page partial; it will be refilled with
+          // different tokens, so its staged copy goes stale.
+          InvalidateVTCMPage(global_block_pool_[block_idx].page_ids.back());
+        }
         n = 0;
         break;
       }
@@ -835,6 +1431,11 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
       auto it = seq_map_.find(temp_seq_id);
       seq_map_.insert({seq_id, it->second});
       seq_map_.erase(temp_seq_id);
+      // Drop the partial log that forking under the temporary id created.
+      seq_token_log_.erase(temp_seq_id);
+    }
+    if (!log_node.empty()) {
+      seq_token_log_.insert(std::move(log_node));
     }
 
     dirty_aux_data_device_ = true;
@@ -858,6 +1459,24 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
     return total_seq_len;
   }
 
+  ffi::Shape GetPrefillChunkCosts(int64_t seq_id, const ffi::Shape& chunk_lengths) final {
+    auto it = seq_map_.find(seq_id);
+    TVM_FFI_ICHECK(it != seq_map_.end())
+        << "The sequence \"" << seq_id << "\" cannot be found in KV cache.";
+    // Each query token of a chunk attends to all KV data appended before it,
+    // so the cost of a chunk grows with the context accumulated by the
+    // earlier chunks. This is what makes the later chunks of a long prefill
+    // more expensive and worth fewer interleaved decode batches.
+    std::vector<int64_t> costs;
+    costs.reserve(chunk_lengths.size());
+    int64_t context_length = it->second.seq_length;
+    for (int64_t length : chunk_lengths) {
+      costs.push_back(length * context_length + length * (length + 1) / 2);
+      context_length += length;
+    }
+    return ffi::Shape(costs);
+  }
+
   /************** Attention **************/
 
   void BeginForward(const ffi::Shape& seq_ids, const ffi::Shape& append_lengths,
@@ -886,6 +1505,15 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
       auto it = seq_map_.find(seq_ids[i]);
       TVM_FFI_ICHECK(it != seq_map_.end())
           << "The sequence \"" << seq_ids[i] << "\" cannot be found in KV cache.";
+      if (!block_host_page_ids_.empty()) {
+        // Prefetch the offloaded blocks of the sequence back to device.
+        PrefetchSequenceFromHost(&it->second);
+      }
+      if (num_vtcm_pages_ > 0) {
+        // Stage the full pages of the sequence into VTCM before the
+        // sequence length is extended by this round's append.
+        StageSequenceToVTCM(&it->second);
+      }
       sequences.push_back(&it->second);
       last_block_length_before_append.push_back(
           global_block_pool_[it->second.last_block_idx].seq_length);
@@ -901,6 +1529,10 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
       }
     }
 
+    if (num_vtcm_pages_ > 0) {
+      FinishVTCMStaging();
+    }
+
     auto [block_ids_on_depths, trailing_blocks] =
         GetBlockIdsOnDepth(sequences, global_block_pool_, cur_batch_size_);
     num_depths_ =
@@ -1325,12 +1957,15 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
     // The auxiliary data structure on device must have been synchronized.
     TVM_FFI_ICHECK(!dirty_aux_data_device_);
 
-    Tensor q_data = temp_attn_q_device_.CreateView({total_seq_length, num_qo_heads_, qk_head_dim_},
-                                                   qkv_data->dtype);
-    Tensor k_data = temp_attn_k_device_.CreateView({total_seq_length, num_kv_heads_, qk_head_dim_},
-                                                   qkv_data->dtype);
-    Tensor v_data = temp_attn_v_device_.CreateView({total_seq_length, num_kv_heads_, qk_head_dim_},
-                                                   qkv_data->dtype);
+    UpdateCachedView(&temp_attn_q_view_, temp_attn_q_device_,
+                     {total_seq_length, num_qo_heads_, qk_head_dim_}, qkv_data->dtype);
+    UpdateCachedView(&temp_attn_k_view_, temp_attn_k_device_,
+                     {total_seq_length, num_kv_heads_, qk_head_dim_}, qkv_data->dtype);
+    UpdateCachedView(&temp_attn_v_view_, temp_attn_v_device_,
+                     {total_seq_length, num_kv_heads_, qk_head_dim_}, qkv_data->dtype);
+    Tensor q_data = temp_attn_q_view_;
+    Tensor k_data = temp_attn_k_view_;
+    Tensor v_data = temp_attn_v_view_;
 
     Tensor qkv_data_view = qkv_data;
     Tensor o_data_view = o_data;
@@ -1606,6 +2241,36 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
     }
   }
 
+  void CommitAcceptedTokens(const ffi::Shape& seq_ids, const ffi::Shape& accepted_lens) final {
+    TVM_FFI_ICHECK_EQ(seq_ids.size(), accepted_lens.size())
+        << "The given seq_ids and accepted_lens have different size.";
+    TVM_FFI_ICHECK_EQ(static_cast<int64_t>(seq_ids.size()), cur_batch_size_)
+        << "The given seq_ids do not cover the sequences of the latest round of forward.";
+    int num_seq_to_commit = seq_ids.size();
+    for (int i = 0; i < num_seq_to_commit; ++i) {
+      TVM_FFI_ICHECK_EQ(seq_ids[i], cur_seq_ids_[i])
+          << "The given seq_ids mismatch the sequences of the latest round of forward.";
+      auto it = seq_map_.find(seq_ids[i]);
+      TVM_FFI_ICHECK(it != seq_map_.end())
+          << "The sequence \"" << seq_ids[i] << "\" cannot be found in KV cache.";
+      TVM_FFI_ICHECK(it->second.accepted_indices_committed)
+          << "The sequence \"" << seq_ids[i]
+          << "\" was forwarded with a token tree. Please use CommitAcceptedTokenTreeNodes "
+             "to commit the accepted tokens.";
+      TVM_FFI_ICHECK_GE(accepted_lens[i], 0)
+          << "The accepted length " << accepted_lens[i] << " cannot be negative.";
+      TVM_FFI_ICHECK_LE(accepted_lens[i], cur_append_lengths_[i])
+          << "The accepted length " << accepted_lens[i] << " exceeds the append length "
+          << cur_append_lengths_[i] << " of the sequence \"" << seq_ids[i] << "\".";
+    }
+    // Note: Function "PopN" only changes the page table structure and does not
+    //       change the KV cache data, so committing the whole batch boils down
+    //       to a single pass of host-side page table updates.
+    for (int i = 0; i < num_seq_to_commit; ++i) {
+      PopN(seq_ids[i], cur_append_lengths_[i] - accepted_lens[i]);
+    }
+  }
+
   Tensor GetQueryPositions() final {
     // Sync the copy stream and the compute stream.
     ComputeStreamWaitForCopyStream();
@@ -1620,6 +2285,14 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
         << "PageAttentionKVCache requires the `f_debug_get_kv` to be explicitly passed in when "
            "initialization. Please construct the KV cache with `f_debug_get_kv`.";
 
+    if (!block_host_page_ids_.empty()) {
+      // The debug getter reads pages directly, so bring any offloaded
+      // blocks back and wait for the prefetch copies to finish.
+      PrefetchSequenceFromHost(&seq_map_.at(seq_id));
+      if (copy_stream_ != compute_stream_) {
+        DeviceAPI::Get(device_)->SyncStreamFromTo(device_, copy_stream_, compute_stream_);
+      }
+    }
     const Sequence& seq = seq_map_.at(seq_id);
     TVM_FFI_ICHECK_GE(start_pos, 0)
         << "DebugGetKV does not accept negative start_pos " << start_pos;
@@ -1672,6 +2345,14 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
         << "PageAttentionKVCache requires the `f_debug_get_kv` to be explicitly passed in when "
            "initialization. Please construct the KV cache with `f_debug_get_kv`.";
 
+    if (!block_host_page_ids_.empty()) {
+      // The debug getter reads pages directly, so bring any offloaded
+      // blocks back and wait for the prefetch copies to finish.
+      PrefetchSequenceFromHost(&seq_map_.at(seq_id));
+      if (copy_stream_ != compute_stream_) {
+        DeviceAPI::Get(device_)->SyncStreamFromTo(device_, copy_stream_, compute_stream_);
+      }
+    }
     const Sequence& seq = seq_map_.at(seq_id);
     TVM_FFI_ICHECK_GE(start_pos, 0)
         << "DebugGetKV does not accept negative start_pos " << start_pos;
@@ -1727,6 +2408,10 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
     TVM_FFI_ICHECK(!free_page_ids_.empty()) << "The KV cache is full. No page can be allocated.";
     int32_t page_id = free_page_ids_.back();
     free_page_ids_.pop_back();
+    if (num_vtcm_pages_ > 0) {
+      // The reused page will hold new content; its staged copy goes stale.
+      InvalidateVTCMPage(page_id);
+    }
     return page_id;
   }
 
@@ -2044,6 +2729,22 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
       }
       TVM_FFI_ICHECK(!support_sliding_window_ || !support_layer_sliding_window_)
           << "Kernel BeginForward doesn't support sliding window.";
+      // A kernel-choice flip means the shared workspace of this depth now
+      // holds the other function's plan, so the now-active function must not
+      // reuse a plan it cached earlier for the same workspace.
+      if (last_planned_use_decode_kernel_[d] != -1 &&
+          last_planned_use_decode_kernel_[d] != static_cast<int>(use_decode_kernel_[d])) {
+        if (use_decode_kernel_[d]) {
+          if (f_attention_decode_ != nullptr) {
+            f_attention_decode_->ResetPlanCache(d);
+          }
+        } else {
+          if (f_attention_prefill_ != nullptr) {
+            f_attention_prefill_->ResetPlanCache(d);
+          }
+        }
+      }
+      last_planned_use_decode_kernel_[d] = static_cast<int>(use_decode_kernel_[d]);
       if (use_decode_kernel_[d]) {
         if (f_attention_decode_ != nullptr &&
             f_attention_decode_->backend_kind == AttnBackendKind::kFlashInfer) {
@@ -2458,12 +3159,13 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
       }
     }
     // 16. Create view for temporary arrays for attention computation.
-    temp_attn_output_view_ = temp_attn_output_device_.CreateView(
-        {total_append_length, num_qo_heads_, v_head_dim_}, temp_attn_output_device_->dtype);
-    temp_attn_lse_view_ = temp_attn_lse_device_.CreateView({total_append_length, num_qo_heads_},
-                                                           temp_attn_lse_device_->dtype);
-    merged_attn_lse_view_ = merged_attn_lse_device_.CreateView({total_append_length, num_qo_heads_},
-                                                               merged_attn_lse_device_->dtype);
+    UpdateCachedView(&temp_attn_output_view_, temp_attn_output_device_,
+                     {total_append_length, num_qo_heads_, v_head_dim_},
+                     temp_attn_output_device_->dtype);
+    UpdateCachedView(&temp_attn_lse_view_, temp_attn_lse_device_,
+                     {total_append_length, num_qo_heads_}, temp_attn_lse_device_->dtype);
+    UpdateCachedView(&merged_attn_lse_view_, merged_attn_lse_device_,
+                     {total_append_length, num_qo_heads_}, merged_attn_lse_device_->dtype);
 
     // - Commit the copy.
     aux_data_manager_->CommitAttnAuxDataCopy();
@@ -2481,7 +3183,7 @@ TVM_FFI_STATIC_INIT_BLOCK() {
   refl::GlobalDef().def_packed(
       "vm.builtin.paged_attention_kv_cache_create", [](ffi::PackedArgs args, ffi::Any* rv) {
         // Todo: cuda graph arg
-        TVM_FFI_ICHECK(args.size() == 28 || args.size() == 29)
+        TVM_FFI_ICHECK(args.size() >= 28 && args.size() <= 30)
             << "Invalid number of KV cache constructor args: " << args.size();
         ffi::Shape cache_config = args[0].cast<ffi::Shape>();
         ffi::Shape layer_indptr_tuple = args[1].cast<ffi::Shape>();
@@ -2544,6 +3246,16 @@ TVM_FFI_STATIC_INIT_BLOCK() {
         f_transpose_append_mla = f_convert_optional_packed_func(14);
         TVM_FFI_ICHECK(!f_merge_inplace.empty()) << "Merge inplace function is not defined.";
 
+        // An optional trailing string selects a quantized page storage dtype
+        // (e.g. "float8_e4m3fn" or "int8"), in which case the compiled
+        // kernels quantize on append and dequantize inside attention.
+        DLDataType kv_storage_dtype = init->dtype;
+        if (args.size() > 28) {
+          if (auto opt_str = args[args.size() - 1].as<ffi::String>()) {
+            kv_storage_dtype = ffi::StringToDLDataType(opt_str.value());
+          }
+        }
+
         std::vector<AttnKind> attn_kinds_vec;
         attn_kinds_vec.reserve(attn_kinds.size());
         for (int64_t attn_kind : attn_kinds) {
@@ -2568,7 +3280,7 @@ TVM_FFI_STATIC_INIT_BLOCK() {
             num_kv_heads, qk_head_dim, v_head_dim, attn_kinds_vec, reserved_num_seqs,
             num_total_pages, prefill_chunk_size, support_sliding_window, RoPEMode(rope_mode),
             rotary_scale, rotary_theta, std::move(rope_ext_factors), enable_kv_transfer,  //
-            init->dtype, init->device,                                                    //
+            init->dtype, kv_storage_dtype, init->device,                                  //
             std::move(f_transpose_append_mha), std::move(f_transpose_append_mla),
             std::move(f_compact_copy), std::move(f_attention_prefill_ragged),
             std::move(f_attention_prefill), std::move(f_attention_decode),
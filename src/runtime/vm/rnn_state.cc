@@ -24,6 +24,7 @@
 #include <tvm/ffi/reflection/registry.h>
 
 #include <cstdint>
+#include <utility>
 #include <vector>
 
 #include "kv_state.h"
@@ -187,13 +188,20 @@ class RNNStateImpObj : public RNNStateObj {
 
     TVM_FFI_ICHECK_GT(max_history_, 0) << "At least 1 history slot to store the current state";
 
-    // Allocate the auxiliary arrays on device.
-    seq_slot_ids_device_ = Tensor::Empty({reserved_num_seqs}, dtype_aux_, device);
-    history_slot_ids_device_ = Tensor::Empty({reserved_num_seqs}, dtype_aux_, device);
+    // Allocate the auxiliary arrays on device, reusing pooled buffers of
+    // previous cache instances when available.
+    seq_slot_ids_device_ = AuxBufferPool::Global()->Alloc({reserved_num_seqs}, dtype_aux_, device);
+    history_slot_ids_device_ =
+        AuxBufferPool::Global()->Alloc({reserved_num_seqs}, dtype_aux_, device);
 
     Clear();
   }
 
+  ~RNNStateImpObj() {
+    AuxBufferPool::Global()->Recycle(std::move(seq_slot_ids_device_));
+    AuxBufferPool::Global()->Recycle(std::move(history_slot_ids_device_));
+  }
+
   /*! \brief Reset the KV cache. */
   void Clear() final {
     seq_map_.clear();
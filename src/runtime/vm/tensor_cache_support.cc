@@ -40,7 +40,12 @@
 #include <tvm/runtime/tensor.h>
 #include <tvm/runtime/vm/tensor_cache_support.h>
 
+#include <cstdint>
+#include <list>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "../../support/utils.h"
@@ -286,6 +291,143 @@ TVM_FFI_STATIC_INIT_BLOCK() {
       .def("vm.builtin.tensor_cache.load", TensorCache::Load);
 }
 
+/*!
+ * \brief Size-bounded LRU cache that memoizes deterministic subgraph outputs
+ *  across requests, keyed by a content hash of the subgraph input.
+ *
+ *  Serving workloads recompute the same deterministic prefixes over and over:
+ *  embedding lookups of hot tokens, vision-encoder outputs for repeated
+ *  images. A graph declares a cacheable boundary by hashing the boundary
+ *  input with `memo_hash`, probing with `memo_lookup`, and on a miss
+ *  inserting the computed output with `memo_insert`. Cached tensors stay
+ *  resident on the device they were computed on, so a hit costs no transfer.
+ *
+ *  Insert stores a private copy of the value; the VM memory planner may
+ *  reuse the producer's buffer for later allocations, and the cache must not
+ *  observe that. Lookup returns the cached tensor itself and callers must
+ *  treat it as read-only.
+ */
+class TensorMemoCache {
+ public:
+  static TensorMemoCache* Global() {
+    static TensorMemoCache* inst = new TensorMemoCache();
+    return inst;
+  }
+
+  /*!
+   * \brief Compute a content hash of a tensor over its bytes, shape and dtype.
+   * \param arr The tensor to hash; device tensors are staged through the host.
+   * \return The hash, stable across platforms.
+   */
+  static int64_t Hash(Tensor arr) {
+    size_t nbytes = ffi::GetDataSize(*(arr.operator->()));
+    const char* data = nullptr;
+    std::vector<char> host_bytes;
+    if (arr->device.device_type == kDLCPU) {
+      data = static_cast<const char*>(arr->data) + arr->byte_offset;
+    } else {
+      host_bytes.resize(nbytes);
+      arr.CopyToBytes(host_bytes.data(), nbytes);
+      data = host_bytes.data();
+    }
+    // FNV-1a over the raw bytes, then fold in dtype and shape so tensors
+    // with identical bytes but different views do not collide.
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < nbytes; ++i) {
+      hash = (hash ^ static_cast<uint8_t>(data[i])) * 1099511628211ULL;
+    }
+    hash = support::HashCombine(hash, static_cast<uint64_t>(arr->dtype.code));
+    hash = support::HashCombine(hash, static_cast<uint64_t>(arr->dtype.bits));
+    hash = support::HashCombine(hash, static_cast<uint64_t>(arr->dtype.lanes));
+    hash = support::HashCombine(hash, static_cast<uint64_t>(arr->ndim));
+    for (int i = 0; i < arr->ndim; ++i) {
+      hash = support::HashCombine(hash, static_cast<uint64_t>(arr->shape[i]));
+    }
+    return static_cast<int64_t>(hash);
+  }
+
+  static ffi::Optional<Tensor> Lookup(int64_t key) {
+    TensorMemoCache* cache = Global();
+    std::lock_guard<std::mutex> lock(cache->mutex_);
+    auto it = cache->entries_.find(key);
+    if (it == cache->entries_.end()) return std::nullopt;
+    cache->lru_.splice(cache->lru_.begin(), cache->lru_, it->second.lru_it);
+    return it->second.value;
+  }
+
+  static void Insert(int64_t key, Tensor value) {
+    TensorMemoCache* cache = Global();
+    size_t nbytes = ffi::GetDataSize(*(value.operator->()));
+    std::lock_guard<std::mutex> lock(cache->mutex_);
+    // A value larger than the whole cache would only thrash it; skip.
+    if (nbytes > cache->capacity_bytes_) return;
+    auto it = cache->entries_.find(key);
+    if (it != cache->entries_.end()) {
+      cache->lru_.splice(cache->lru_.begin(), cache->lru_, it->second.lru_it);
+      return;
+    }
+    Tensor copy = Tensor::Empty(value.Shape(), value->dtype, value->device);
+    copy.CopyFrom(value);
+    DeviceAPI::Get(copy->device)->StreamSync(copy->device, nullptr);
+    while (cache->total_bytes_ + nbytes > cache->capacity_bytes_) {
+      int64_t victim = cache->lru_.back();
+      cache->lru_.pop_back();
+      auto victim_it = cache->entries_.find(victim);
+      cache->total_bytes_ -= victim_it->second.nbytes;
+      cache->entries_.erase(victim_it);
+    }
+    cache->lru_.push_front(key);
+    cache->entries_.emplace(key, Entry{std::move(copy), nbytes, cache->lru_.begin()});
+    cache->total_bytes_ += nbytes;
+  }
+
+  static void SetCapacity(int64_t capacity_bytes) {
+    TVM_FFI_CHECK_GE(capacity_bytes, 0, ValueError) << "Capacity must be non-negative";
+    TensorMemoCache* cache = Global();
+    std::lock_guard<std::mutex> lock(cache->mutex_);
+    cache->capacity_bytes_ = static_cast<size_t>(capacity_bytes);
+    while (cache->total_bytes_ > cache->capacity_bytes_) {
+      int64_t victim = cache->lru_.back();
+      cache->lru_.pop_back();
+      auto victim_it = cache->entries_.find(victim);
+      cache->total_bytes_ -= victim_it->second.nbytes;
+      cache->entries_.erase(victim_it);
+    }
+  }
+
+  static void Clear() {
+    TensorMemoCache* cache = Global();
+    std::lock_guard<std::mutex> lock(cache->mutex_);
+    cache->entries_.clear();
+    cache->lru_.clear();
+    cache->total_bytes_ = 0;
+  }
+
+ private:
+  struct Entry {
+    Tensor value;
+    size_t nbytes;
+    std::list<int64_t>::iterator lru_it;
+  };
+
+  std::mutex mutex_;
+  /*! \brief Keys ordered by recency, most recently used at the front. */
+  std::list<int64_t> lru_;
+  std::unordered_map<int64_t, Entry> entries_;
+  size_t total_bytes_{0};
+  size_t capacity_bytes_{static_cast<size_t>(256) << 20};
+};
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef()
+      .def("vm.builtin.tensor_cache.memo_hash", TensorMemoCache::Hash)
+      .def("vm.builtin.tensor_cache.memo_lookup", TensorMemoCache::Lookup)
+      .def("vm.builtin.tensor_cache.memo_insert", TensorMemoCache::Insert)
+      .def("vm.builtin.tensor_cache.memo_set_capacity", TensorMemoCache::SetCapacity)
+      .def("vm.builtin.tensor_cache.memo_clear", TensorMemoCache::Clear);
+}
+
 // This param module node can be useful to get param dict in RPC mode
 // when the remote already have loaded parameters from file.
 class ParamModuleNode : public ffi::ModuleObj {
@@ -24,19 +24,57 @@
 #include <tvm/ffi/cast.h>
 #include <tvm/ffi/container/tensor.h>
 #include <tvm/ffi/function.h>
+#include <tvm/runtime/device_api.h>
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/memory/memory_manager.h>
+#include <tvm/runtime/timer.h>
 #include <tvm/runtime/vm/vm.h>
 #include <tvm/support/cuda/nvtx.h>
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
 #include <thread>
+#include <unordered_set>
 
+#include "../threading_backend.h"
 #include "./module_utils.h"
 
+// Computed-goto dispatch requires the labels-as-values extension,
+// which is available on gcc/clang but not MSVC.
+#if defined(__GNUC__) || defined(__clang__)
+#define TVM_VM_USE_COMPUTED_GOTO 1
+#else
+#define TVM_VM_USE_COMPUTED_GOTO 0
+#endif
+
 namespace tvm {
 namespace runtime {
 namespace vm {
 
+/*!
+ * \brief Frozen per-executable function resolution results.
+ *
+ * Resolution only depends on the executable and its imports, so the table is
+ * built by the first VM instance that loads the executable and shared by all
+ * later ones. Closures over per-VM state (bytecode and VM-TIR entries) are
+ * still created per instance, but creating them from resolved functions is a
+ * handful of allocations rather than name-based lookups across all imports.
+ */
+struct VMLinkTable {
+  /*! \brief Resolved kPackedFunc entries, indexed like the function table. */
+  std::vector<ffi::Function> packed_funcs;
+  /*! \brief Resolved __vmtir__ entries for kVMTIRFunc functions. */
+  std::vector<ffi::Function> tir_funcs;
+};
+
 //---------------------------------------------
 // VM Closure object
 //---------------------------------------------
@@ -161,6 +199,20 @@ using RegType = ffi::Any;
  * from a function call.
  */
 struct VMFrame {
+  /*!
+   * \brief Cached argument vector of a call site, resolved on first execution.
+   *
+   * Immediate, constant and function operands are stable for the lifetime of
+   * the frame, so they are materialized once per function entry; only the
+   * register operands recorded in reg_slots are refreshed per invocation.
+   */
+  struct CallArgCache {
+    /*! \brief The argument vector with non-register operands pre-resolved. */
+    std::vector<ffi::AnyView> args;
+    /*! \brief Pairs of (position in args, register name) to refresh per call. */
+    std::vector<std::pair<int, RegName>> reg_slots;
+  };
+
   /*! \brief The return program counter. */
   Index return_pc;
   /*! \brief Statically allocated space for objects */
@@ -169,6 +221,8 @@ struct VMFrame {
   RegName caller_return_register;
   /*! \brief Temporary argument tcode stack for packed func call. */
   std::vector<ffi::AnyView> call_args;
+  /*! \brief Per call-site argument cache keyed by instruction index. */
+  std::unordered_map<Index, CallArgCache> call_arg_cache;
 
   VMFrame(Index pc, Index register_file_size)
       : return_pc(pc), register_file(register_file_size), caller_return_register(0) {}
@@ -176,6 +230,7 @@ struct VMFrame {
   void Clear() {
     this->caller_return_register = 0;
     this->call_args.clear();
+    this->call_arg_cache.clear();
     for (RegType& reg : register_file) {
       reg = nullptr;
     }
@@ -184,11 +239,51 @@ struct VMFrame {
   void ResetForRecycle(Index pc, Index register_file_size) {
     this->return_pc = pc;
     this->register_file.resize(register_file_size);
+    this->call_arg_cache.clear();
   }
 };
 
+/*!
+ * \brief The mutable state of one bytecode invocation.
+ *
+ * Everything the dispatch loop mutates lives here: the call stack, the
+ * recycled frames, the program counter and the return register. The VM keeps
+ * one context per calling thread, so concurrent invocations on a shared
+ * VirtualMachine instance interpret independently while sharing the
+ * executable, the constant pool and the function pool, which stay immutable
+ * after Init.
+ */
+struct VMInvocationContext {
+  /*!
+   * \brief The current stack of call frames.
+   * \note: Use unique ptr to avoid re-allocation and copy when frames get resized.
+   */
+  std::vector<std::unique_ptr<VMFrame>> frames;
+  /*! \brief A free list of frames, recycled without locking since the context is per thread. */
+  std::vector<std::unique_ptr<VMFrame>> frame_free_list;
+  /*! \brief The virtual machine PC. */
+  Index pc{0};
+  /*! \brief The special return register. */
+  RegType return_value;
+};
+
 class VirtualMachineImpl : public VirtualMachine {
  public:
+  explicit VirtualMachineImpl(VMDispatchMode dispatch_mode = VMDispatchMode::kSwitch)
+      : vm_id_(NextVMId()), dispatch_mode_(dispatch_mode) {}
+
+  ~VirtualMachineImpl() {
+    if (const_prefetch_thread_.joinable()) {
+      {
+        std::lock_guard<std::mutex> lock(const_prefetch_mutex_);
+        const_prefetch_stop_ = true;
+      }
+      const_prefetch_cv_.notify_all();
+      const_prefetch_thread_.join();
+    }
+  }
+
+
   //---------------------------------------------------
   // Public facing functions overloading
   //---------------------------------------------------
@@ -210,6 +305,21 @@ class VirtualMachineImpl : public VirtualMachine {
   void _InvokeClosure(ffi::PackedArgs args, ffi::Any* rv);
   void _InvokeClosureStateful(std::string func_name);
   void _SetInstrument(ffi::PackedArgs args, ffi::Any* rv);
+  void _ProfileStart() {
+    std::lock_guard<std::mutex> lock(profile_mutex_);
+    profile_stats_.clear();
+    profiling_ = true;
+  }
+  void _ProfileStop() { profiling_ = false; }
+  std::string _ProfileReport();
+  void _WarmupCaptureStart() {
+    std::lock_guard<std::mutex> lock(warmup_mutex_);
+    warmup_records_.clear();
+    warmup_seen_.clear();
+    warmup_capturing_ = true;
+  }
+  void _WarmupCaptureSave(std::string path);
+  void _WarmupReplay(std::string path);
   void _GetOutputArity(ffi::PackedArgs args, ffi::Any* rv);
   void _GetOutput(ffi::PackedArgs args, ffi::Any* rv);
   void _SetInputWithoutParamModule(ffi::PackedArgs args, ffi::Any* rv);
@@ -224,6 +334,12 @@ class VirtualMachineImpl : public VirtualMachine {
   TVM_MODULE_VTABLE_ENTRY_PACKED("invoke_closure", &VirtualMachineImpl::_InvokeClosure);
   TVM_MODULE_VTABLE_ENTRY("invoke_stateful", &VirtualMachineImpl::_InvokeClosureStateful);
   TVM_MODULE_VTABLE_ENTRY_PACKED("set_instrument", &VirtualMachineImpl::_SetInstrument);
+  TVM_MODULE_VTABLE_ENTRY("profile_start", &VirtualMachineImpl::_ProfileStart);
+  TVM_MODULE_VTABLE_ENTRY("profile_stop", &VirtualMachineImpl::_ProfileStop);
+  TVM_MODULE_VTABLE_ENTRY("profile_report", &VirtualMachineImpl::_ProfileReport);
+  TVM_MODULE_VTABLE_ENTRY("warmup_capture_start", &VirtualMachineImpl::_WarmupCaptureStart);
+  TVM_MODULE_VTABLE_ENTRY("warmup_capture_save", &VirtualMachineImpl::_WarmupCaptureSave);
+  TVM_MODULE_VTABLE_ENTRY("warmup_replay", &VirtualMachineImpl::_WarmupReplay);
   TVM_MODULE_VTABLE_ENTRY_PACKED("get_output_arity", &VirtualMachineImpl::_GetOutputArity);
   TVM_MODULE_VTABLE_ENTRY_PACKED("get_output", &VirtualMachineImpl::_GetOutput);
   TVM_MODULE_VTABLE_ENTRY_PACKED("set_input", &VirtualMachineImpl::_SetInputWithoutParamModule);
@@ -307,33 +423,107 @@ class VirtualMachineImpl : public VirtualMachine {
    * \return The result function, can return ffi::Function(nullptr) if nothing is found.
    */
   ffi::Optional<ffi::Function> GetFuncFromImports(const ffi::String& name) {
+    // Walking 50+ imported libraries per lookup is costly at init, especially for
+    // repeated misses on optional symbols, so results (including misses) are memoized.
+    // The cache is reset when a new executable is loaded.
+    auto it = import_lookup_cache_.find(name);
+    if (it != import_lookup_cache_.end()) {
+      return it->second;
+    }
+    ffi::Optional<ffi::Function> result = std::nullopt;
     for (auto& lib : this->imports_) {
       if (auto opt_func = lib.cast<ffi::Module>()->GetFunction(name, true)) {
-        return *opt_func;
+        result = *opt_func;
+        break;
       }
     }
-    return std::nullopt;
+    import_lookup_cache_.emplace(name, result);
+    return result;
   }
   /*!
    * \brief Initialize function pool.
    */
   void InitFuncPool();
+  /*!
+   * \brief Return the executable's shared link table, building it on first use.
+   */
+  std::shared_ptr<VMLinkTable> GetOrBuildLinkTable();
+  /*!
+   * \brief Start uploading the tensor constants to device in the order of
+   * their first use in the bytecode, overlapping the uploads with whatever
+   * runs before and during the first inference.
+   */
+  void StartConstantPrefetch();
+  /*! \brief The loop of the background constant prefetch worker. */
+  void ConstantPrefetchLoop();
+  /*!
+   * \brief Block until the given constant has been uploaded, bumping it to
+   * the front of the prefetch queue so the worker uploads it next.
+   * \param idx The index of the constant in the constant pool.
+   */
+  void WaitForConstant(Index idx);
+  /*!
+   * \brief Read a constant from the constant pool, waiting for its
+   * background upload when it is not ready yet.
+   * \param idx The index of the constant in the constant pool.
+   * \return The constant value.
+   */
+  TVM_FFI_INLINE const RegType& GetConstant(Index idx) {
+    if (const_prefetch_active_ && !const_ready_[idx].load(std::memory_order_acquire)) {
+      WaitForConstant(idx);
+    }
+    return const_pool_[idx];
+  }
+  /*!
+   * \brief Block until every constant has been uploaded. Needed before
+   * handing the raw constant pool to code that indexes it directly.
+   */
+  void EnsureAllConstantsReady() {
+    if (!const_prefetch_active_) return;
+    for (size_t i = 0; i < const_pool_.size(); ++i) {
+      GetConstant(static_cast<Index>(i));
+    }
+  }
+
+  /*!
+   * \brief Return the calling thread's invocation context, creating it on first use.
+   *
+   * Contexts are keyed per (thread, VM instance) so one VM can serve
+   * concurrent invocations from many threads, each with its own call stack
+   * and frame free list, while frame recycling stays lock-free.
+   *
+   * The map is keyed by the process-unique vm_id_ rather than the VM address:
+   * an address can be recycled by a later VM, which would then inherit the
+   * dead VM's call stack. Contexts of destroyed VMs linger until their thread
+   * exits, but they are small once the invocation has unwound and can never
+   * be picked up by another instance.
+   */
+  VMInvocationContext* GetInvocationContext() {
+    static thread_local std::unordered_map<uint64_t, VMInvocationContext> tls_contexts;
+    return &tls_contexts[vm_id_];
+  }
+
+  /*! \brief Allocate a process-unique id for an instance; ids are never reused. */
+  static uint64_t NextVMId() {
+    static std::atomic<uint64_t> next_id{0};
+    return next_id.fetch_add(1, std::memory_order_relaxed);
+  }
 
   /*!
    * \brief A RAII wrapper that pushes and pops VM frames.
    */
   class FrameGuard {
    public:
-    VirtualMachineImpl* vm;
-    explicit FrameGuard(VirtualMachineImpl* vm, std::unique_ptr<VMFrame> frame) : vm(vm) {
-      vm->frames_.emplace_back(std::move(frame));
+    VMInvocationContext* ctx;
+    explicit FrameGuard(VMInvocationContext* ctx, std::unique_ptr<VMFrame> frame) : ctx(ctx) {
+      ctx->frames.emplace_back(std::move(frame));
     }
     ~FrameGuard() {
-      TVM_FFI_ICHECK_GT(vm->frames_.size(), 0);
-      vm->pc_ = vm->frames_.back()->return_pc;
-      vm->frames_.back()->Clear();
-      vm->frame_free_list_.emplace_back(std::move(vm->frames_.back()));
-      vm->frames_.pop_back();
+      TVM_FFI_ICHECK_GT(ctx->frames.size(), 0);
+      ctx->pc = ctx->frames.back()->return_pc;
+      ctx->frames.back()->Clear();
+      ctx->frame_free_list.emplace_back(std::move(ctx->frames.back()));
+      ctx->frames.pop_back();
     }
   };
   //-------------------------------------------------
@@ -341,20 +531,21 @@ class VirtualMachineImpl : public VirtualMachine {
   //-------------------------------------------------
   /*!
    * \brief Push a call frame onto the call stack.
+   * \param ctx The invocation context owning the call stack.
    * \param ret_pc The program counter to return to.
    * \param vm_func The function to be pushed to the call stack.
    * \return A RAII wrapper that pops the frame when going out of scope.
    */
-  FrameGuard PushFrame(Index ret_pc, const VMFuncInfo& vm_func) {
+  FrameGuard PushFrame(VMInvocationContext* ctx, Index ret_pc, const VMFuncInfo& vm_func) {
     std::unique_ptr<VMFrame> new_frame;
-    if (!frame_free_list_.empty()) {
-      new_frame = std::move(frame_free_list_.back());
-      frame_free_list_.pop_back();
+    if (!ctx->frame_free_list.empty()) {
+      new_frame = std::move(ctx->frame_free_list.back());
+      ctx->frame_free_list.pop_back();
       new_frame->ResetForRecycle(ret_pc, vm_func.register_file_size);
     } else {
       new_frame = std::make_unique<VMFrame>(ret_pc, vm_func.register_file_size);
     }
-    return FrameGuard(this, std::move(new_frame));
+    return FrameGuard(ctx, std::move(new_frame));
   }
   /*!
    * \brief Write to a VM register.
@@ -390,13 +581,36 @@ class VirtualMachineImpl : public VirtualMachine {
   }
   /*!
    * \brief Run call instruction.
+   * \param ctx The invocation context.
    * \param curr_frame The current frame.
    * \param inst The call instruction.
    */
-  virtual void RunInstrCall(VMFrame* curr_frame, Instruction inst);
+  virtual void RunInstrCall(VMInvocationContext* ctx, VMFrame* curr_frame, Instruction inst);
+
+  /*!
+   * \brief Invoke one call instruction with profiling and span tracing applied.
+   *
+   * Used by RunInstrCall when either the hierarchical profiler or the device
+   * trace recorder is active; the plain dispatch path bypasses it entirely.
+   * \param func_idx Index of the callee in the function pool.
+   * \param args The resolved call arguments.
+   * \param ret The return value slot.
+   */
+  void InvokeTracedCall(Index func_idx, ffi::PackedArgs args, ffi::Any* ret);
 
   /*! \brief Run VM dispatch loop. */
-  void RunLoop();
+  void RunLoop(VMInvocationContext* ctx);
+
+  /*! \brief Run VM dispatch loop via a switch over Opcode. */
+  void RunLoopSwitch(VMInvocationContext* ctx);
+
+#if TVM_VM_USE_COMPUTED_GOTO
+  /*!
+   * \brief Run VM dispatch loop via computed goto, with the program counter
+   *        and register file base cached in locals across instructions.
+   */
+  void RunLoopDirectThreaded(VMInvocationContext* ctx);
+#endif
 
   /*!
    * \brief Retrieve the name of the function identified by the given index.
@@ -427,6 +641,32 @@ class VirtualMachineImpl : public VirtualMachine {
    * \brief Function pool to cache functions in func_table
    */
   std::vector<ffi::Any> func_pool_;
+  /*!
+   * \brief Memoized import lookups keyed by symbol name, misses included
+   */
+  std::unordered_map<std::string, ffi::Optional<ffi::Function>> import_lookup_cache_;
+  /*! \brief The executable's shared link table, see VMLinkTable. */
+  std::shared_ptr<VMLinkTable> link_table_;
+  //--------------------------------------------------------
+  // Background constant prefetch.
+  //--------------------------------------------------------
+  /*!
+   * \brief Whether tensor constants are uploaded by the background
+   * prefetcher instead of eagerly in Init.
+   */
+  bool const_prefetch_active_ = false;
+  /*! \brief Per-constant flags set once the device copy has completed. */
+  std::unique_ptr<std::atomic<bool>[]> const_ready_;
+  /*! \brief Protects the prefetch queue and the stop flag. */
+  std::mutex const_prefetch_mutex_;
+  /*! \brief Signals finished uploads and priority bumps. */
+  std::condition_variable const_prefetch_cv_;
+  /*! \brief Constant indices pending upload; the next upload is at the front. */
+  std::deque<Index> const_prefetch_queue_;
+  /*! \brief Set to stop the prefetcher before all uploads have finished. */
+  bool const_prefetch_stop_ = false;
+  /*! \brief The background prefetch worker. */
+  std::thread const_prefetch_thread_;
   //--------------------------------------------------------
   // Executor interface support
   //--------------------------------------------------------
@@ -439,27 +679,110 @@ class VirtualMachineImpl : public VirtualMachine {
   //------------------------------------------------------------
   // VM Instruction execution.
   //------------------------------------------------------------
+  // NOTE: the call stack, frame free list, PC and return register live in the
+  // per-thread VMInvocationContext (see GetInvocationContext), keeping
+  // bytecode invocation reentrant on a shared VM instance.
+
+  /*! \brief Process-unique id of this instance, keying per-thread contexts. */
+  const uint64_t vm_id_;
+  /*! \brief The bytecode dispatch strategy of the interpreter loop. */
+  VMDispatchMode dispatch_mode_{VMDispatchMode::kSwitch};
+  /*!\ brief instrument function. */
+  ffi::Function instrument_ = nullptr;
+  /*! \brief Per-callee metrics accumulated while profiling is enabled. */
+  struct ProfileEntry {
+    /*! \brief Number of times the function was called. */
+    int64_t calls = 0;
+    /*! \brief Accumulated device time measured with device-event timers. */
+    int64_t device_ns = 0;
+    /*! \brief Accumulated size of tensor operands, an upper bound on bytes moved. */
+    int64_t bytes_moved = 0;
+  };
+  /*! \brief Whether per-call hierarchical profiling is enabled. */
+  bool profiling_ = false;
+  /*! \brief Protects profile_stats_, the one accumulator shared across invocations. */
+  std::mutex profile_mutex_;
+  /*! \brief Profile accumulator keyed by function pool index. */
+  std::unordered_map<Index, ProfileEntry> profile_stats_;
+  //--------------------------------------------------------
+  // Warmup capture and replay.
+  //--------------------------------------------------------
+  /*! \brief Whether closure invocations are being recorded for warmup replay. */
+  bool warmup_capturing_ = false;
+  /*! \brief Protects warmup_records_ and warmup_seen_. */
+  std::mutex warmup_mutex_;
+  /*! \brief Deduplicated (function, argument signature) records in first-seen order. */
+  std::vector<std::string> warmup_records_;
+  /*! \brief Serialized records captured so far, for deduplication. */
+  std::unordered_set<std::string> warmup_seen_;
+
+  /*! \brief Record one closure invocation while warmup capture is active. */
+  void RecordWarmupInvocation(const ffi::String& func_name, ffi::PackedArgs args);
   /*!
-   * \brief The current stack of call frames.
-   * \note: Use unique ptr to avoid re-allocation and copy when frames_ get resized.
-   */
-  std::vector<std::unique_ptr<VMFrame>> frames_;
-  /*!
-   * \brief A free list of frame
+   * \brief Serialize the argument signature of a call: tensors as device,
+   * dtype and shape, shapes and scalars by value.
+   * \return std::nullopt when an argument cannot be synthesized at replay
+   * time, in which case the invocation is not recorded.
    */
-  std::vector<std::unique_ptr<VMFrame>> frame_free_list_;
+  std::optional<std::string> SerializeWarmupArgs(ffi::PackedArgs args);
+  /*! \brief Rebuild one argument from its serialized signature token. */
+  RegType SynthesizeWarmupArg(const std::string& token);
 
-  /*! \brief The virtual machine PC. */
-  Index pc_{0};
-  /*! \brief The special return register. */
-  RegType return_value_;
-  /*!\ brief instrument function. */
-  ffi::Function instrument_ = nullptr;
+  /*! \brief Sum the sizes of all tensor operands of a call. */
+  static int64_t EstimateBytesMoved(ffi::PackedArgs args, const ffi::Any& ret) {
+    int64_t bytes = 0;
+    for (int i = 0; i < args.size(); ++i) {
+      if (auto opt_tensor = args[i].as<Tensor>()) {
+        bytes += static_cast<int64_t>(ffi::GetDataSize(*(opt_tensor.value().operator->())));
+      }
+    }
+    if (auto opt_tensor = ret.as<Tensor>()) {
+      bytes += static_cast<int64_t>(ffi::GetDataSize(*(opt_tensor.value().operator->())));
+    }
+    return bytes;
+  }
 };
 
 void VirtualMachineImpl::LoadExecutable(ffi::ObjectPtr<VMExecutable> exec) {
   this->exec_ = exec;
   this->imports_ = exec->imports();
+  this->import_lookup_cache_.clear();
+  this->link_table_ = GetOrBuildLinkTable();
+}
+
+std::shared_ptr<VMLinkTable> VirtualMachineImpl::GetOrBuildLinkTable() {
+  static std::mutex link_mutex;
+  std::lock_guard<std::mutex> lock(link_mutex);
+  if (exec_->link_table != nullptr) {
+    return exec_->link_table;
+  }
+  auto table = std::make_shared<VMLinkTable>();
+  size_t num_funcs = exec_->func_table.size();
+  table->packed_funcs.resize(num_funcs);
+  table->tir_funcs.resize(num_funcs);
+  for (size_t func_index = 0; func_index < num_funcs; ++func_index) {
+    const VMFuncInfo& info = exec_->func_table[func_index];
+    if (info.kind == VMFuncInfo::FuncKind::kPackedFunc) {
+      // only look through imports first
+      ffi::Optional<ffi::Function> func = GetFuncFromImports(info.name);
+      if (!func.has_value()) {
+        const auto p_func = tvm::ffi::Function::GetGlobal(info.name);
+        if (p_func.has_value()) func = *p_func;
+      }
+      TVM_FFI_ICHECK(func.has_value())
+          << "Error: Cannot find ffi::Function " << info.name
+          << " in either Relax VM kernel library, or in TVM runtime ffi::Function registry, or in "
+             "global Relax functions of the VM executable";
+      table->packed_funcs[func_index] = *func;
+    } else if (info.kind == VMFuncInfo::FuncKind::kVMTIRFunc) {
+      ffi::Optional<ffi::Function> tir_func = GetFuncFromImports("__vmtir__" + info.name);
+      TVM_FFI_ICHECK(tir_func.has_value())
+          << "Cannot find underlying compiled tirx function of VMTIRFunc " << info.name;
+      table->tir_funcs[func_index] = *tir_func;
+    }
+  }
+  exec_->link_table = table;
+  return table;
 }
 
 void VirtualMachineImpl::Init(const std::vector<Device>& devices,
@@ -473,20 +796,106 @@ void VirtualMachineImpl::Init(const std::vector<Device>& devices,
     this->devices.push_back(devices[i]);
     this->allocators.push_back(alloc);
   }
-  // Setup constant sections.
-  this->const_pool_.reserve(exec_->constants.size());
-  for (size_t i = 0; i < exec_->constants.size(); ++i) {
-    if (auto opt_nd = exec_->constants[i].as<Tensor>()) {
-      this->const_pool_.push_back(
-          ConvertRegToDevice(opt_nd.value(), devices[0], allocators[0], exec_->memory_scopes[i]));
-    } else {
-      this->const_pool_.push_back(exec_->constants[i]);
+  // Setup constant sections. On device targets the tensor uploads are
+  // handed to a background prefetcher, so the first inference overlaps
+  // with the remaining uploads instead of waiting for all of them. On CPU
+  // the conversion is cheap and stays eager.
+  if (devices[0].device_type != kDLCPU && !exec_->constants.empty()) {
+    this->StartConstantPrefetch();
+  } else {
+    this->const_pool_.reserve(exec_->constants.size());
+    for (size_t i = 0; i < exec_->constants.size(); ++i) {
+      if (auto opt_nd = exec_->constants[i].as<Tensor>()) {
+        this->const_pool_.push_back(
+            ConvertRegToDevice(opt_nd.value(), devices[0], allocators[0], exec_->memory_scopes[i]));
+      } else {
+        this->const_pool_.push_back(exec_->constants[i]);
+      }
     }
   }
   // Setup function sections.
   this->InitFuncPool();
 }
 
+void VirtualMachineImpl::StartConstantPrefetch() {
+  size_t num_constants = exec_->constants.size();
+  this->const_pool_.resize(num_constants);
+  const_ready_ = std::make_unique<std::atomic<bool>[]>(num_constants);
+  for (size_t i = 0; i < num_constants; ++i) {
+    if (exec_->constants[i].as<Tensor>()) {
+      const_ready_[i].store(false, std::memory_order_relaxed);
+    } else {
+      // Non-tensor constants need no device upload.
+      this->const_pool_[i] = exec_->constants[i];
+      const_ready_[i].store(true, std::memory_order_relaxed);
+    }
+  }
+  // Predict the use order as the order of first appearance in the bytecode,
+  // so the first inference is likely to find its constants already resident.
+  std::vector<bool> queued(num_constants, false);
+  Index num_instr = static_cast<Index>(exec_->instr_offset.size());
+  for (Index i = 0; i < num_instr; ++i) {
+    Instruction instr = exec_->GetInstruction(i);
+    if (instr.op != Opcode::Call) continue;
+    for (Index arg_index = 0; arg_index < instr.num_args; ++arg_index) {
+      Instruction::Arg arg = instr.args[arg_index];
+      if (arg.kind() != Instruction::ArgKind::kConstIdx) continue;
+      Index const_index = arg.value();
+      if (!queued[const_index] && !const_ready_[const_index].load(std::memory_order_relaxed)) {
+        queued[const_index] = true;
+        const_prefetch_queue_.push_back(const_index);
+      }
+    }
+  }
+  // Constants only referenced through the raw pool handle, e.g. by VMTIR
+  // functions, never appear as call arguments; upload them last.
+  for (size_t i = 0; i < num_constants; ++i) {
+    if (!queued[i] && !const_ready_[i].load(std::memory_order_relaxed)) {
+      const_prefetch_queue_.push_back(static_cast<Index>(i));
+    }
+  }
+  const_prefetch_active_ = true;
+  const_prefetch_thread_ = std::thread([this]() { this->ConstantPrefetchLoop(); });
+}
+
+void VirtualMachineImpl::ConstantPrefetchLoop() {
+  while (true) {
+    Index idx;
+    {
+      std::unique_lock<std::mutex> lock(const_prefetch_mutex_);
+      // Drop entries that became ready after being bumped to the front.
+      while (!const_prefetch_queue_.empty() &&
+             const_ready_[const_prefetch_queue_.front()].load(std::memory_order_relaxed)) {
+        const_prefetch_queue_.pop_front();
+      }
+      if (const_prefetch_stop_ || const_prefetch_queue_.empty()) break;
+      idx = const_prefetch_queue_.front();
+      const_prefetch_queue_.pop_front();
+    }
+    auto opt_nd = exec_->constants[idx].as<Tensor>();
+    TVM_FFI_ICHECK(opt_nd.has_value());
+    auto scope_it = exec_->memory_scopes.find(idx);
+    std::string mem_scope = scope_it != exec_->memory_scopes.end() ? scope_it->second : "";
+    RegType converted = ConvertRegToDevice(opt_nd.value(), devices[0], allocators[0], mem_scope);
+    // Make sure the copy has retired before a reader touches the constant
+    // from the compute stream.
+    DeviceAPI::Get(devices[0])->StreamSync(devices[0], nullptr);
+    const_pool_[idx] = std::move(converted);
+    const_ready_[idx].store(true, std::memory_order_release);
+    const_prefetch_cv_.notify_all();
+  }
+}
+
+void VirtualMachineImpl::WaitForConstant(Index idx) {
+  std::unique_lock<std::mutex> lock(const_prefetch_mutex_);
+  if (const_ready_[idx].load(std::memory_order_acquire)) return;
+  // Bump the constant to the front so the worker uploads it next.
+  const_prefetch_queue_.push_front(idx);
+  const_prefetch_cv_.notify_all();
+  const_prefetch_cv_.wait(
+      lock, [&] { return const_ready_[idx].load(std::memory_order_acquire); });
+}
+
 VMFuncInfo VirtualMachineImpl::LookupVMFuncInfo(const std::string& func_name) {
   TVM_FFI_ICHECK(exec_) << "The executable is not created yet.";
   auto it = this->exec_->func_map.find(func_name);
@@ -547,6 +956,9 @@ void VirtualMachineImpl::InvokeClosurePacked(const ffi::ObjectRef& closure_or_pa
   // do first cast to VirtualMachine* then to void*
   packed_args[0] = static_cast<void*>(static_cast<VirtualMachine*>(this));
   std::copy(args.data(), args.data() + args.size(), packed_args.begin() + 1);
+  if (warmup_capturing_) {
+    this->RecordWarmupInvocation(clo->func_name, args);
+  }
   {
     support::NVTXScopedRange scope("RelaxVM: " + clo->func_name);
     clo->impl.CallPacked(ffi::PackedArgs(packed_args.data(), packed_args.size()), rv);
@@ -628,8 +1040,8 @@ ffi::Optional<VMClosure> VirtualMachineImpl::GetClosureInternal(const ffi::Strin
   } else {
     TVM_FFI_ICHECK(finfo.kind == VMFuncInfo::FuncKind::kVMTIRFunc)
         << "Cannot support closure with function kind " << static_cast<int>(finfo.kind);
-    ffi::Optional<ffi::Function> tir_func = GetFuncFromImports("__vmtir__" + finfo.name);
-    TVM_FFI_ICHECK(tir_func.has_value())
+    ffi::Function tir_func = link_table_->tir_funcs[gf_idx];
+    TVM_FFI_ICHECK(tir_func != nullptr)
         << "Cannot find underlying compiled tirx function of VMTIRFunc " << finfo.name;
     auto impl = ffi::Function([this, finfo, tir_func](ffi::PackedArgs args, ffi::Any* rv) {
       // Per convention, ctx ptr is a VirtualMachine*
@@ -643,10 +1055,13 @@ ffi::Optional<VMClosure> VirtualMachineImpl::GetClosureInternal(const ffi::Strin
         reg_file[i] = args[i + 1];
       }
       void* reg_anylist_handle = reg_file.data();
+      // The TIR function indexes the raw constant pool directly, so every
+      // constant must be resident before it runs.
+      this->EnsureAllConstantsReady();
       void* const_anylist_handle = this->const_pool_.data();
       void* func_anylist_handle = this->func_pool_.data();
-      (*tir_func)(static_cast<void*>(ctx_ptr), reg_anylist_handle, const_anylist_handle,
-                  func_anylist_handle);
+      tir_func(static_cast<void*>(ctx_ptr), reg_anylist_handle, const_anylist_handle,
+               func_anylist_handle);
       // Return value always stored after inputs.
       *rv = reg_file[finfo.num_args];
     });
@@ -661,11 +1076,12 @@ RegType VirtualMachineImpl::InvokeBytecode(Index gf_idx, const std::vector<RegTy
   const VMFuncInfo& gfunc = exec_->func_table[gf_idx];
   TVM_FFI_ICHECK(gfunc.kind == VMFuncInfo::FuncKind::kVMFunc);
 
+  VMInvocationContext* ctx = GetInvocationContext();
   // Get the curr instr which might be a potential caller.
-  Instruction curr_instr = exec_->GetInstruction(pc_);
-  auto guard = PushFrame(this->pc_, gfunc);
+  Instruction curr_instr = exec_->GetInstruction(ctx->pc);
+  auto guard = PushFrame(ctx, ctx->pc, gfunc);
   // Get new frame and set the caller info.
-  VMFrame* curr_frame = frames_.back().get();
+  VMFrame* curr_frame = ctx->frames.back().get();
   if (curr_instr.op == Opcode::Call) {
     curr_frame->caller_return_register = curr_instr.dst;
   }
@@ -689,32 +1105,23 @@ RegType VirtualMachineImpl::InvokeBytecode(Index gf_idx, const std::vector<RegTy
       }()
       << ", but " << args.size() << " arguments were provided.";
   for (size_t i = 0; i < args.size(); ++i) {
-    WriteRegister(frames_.back().get(), i, args[i]);
+    WriteRegister(curr_frame, i, args[i]);
   }
   // set program counter
-  pc_ = gfunc.start_instr;
-  RunLoop();
-  return return_value_;
+  ctx->pc = gfunc.start_instr;
+  RunLoop(ctx);
+  return ctx->return_value;
 }
 
 void VirtualMachineImpl::InitFuncPool() {
   func_pool_.resize(exec_->func_table.size());
 
+  // All name resolution happened when the shared link table was built, so
+  // populating the pool is only closure creation over resolved functions.
   for (size_t func_index = 0; func_index < exec_->func_table.size(); ++func_index) {
     const VMFuncInfo& info = exec_->func_table[func_index];
     if (info.kind == VMFuncInfo::FuncKind::kPackedFunc) {
-      // only look through imports first
-      ffi::Optional<ffi::Function> func = GetFuncFromImports(info.name);
-      if (!func.has_value()) {
-        const auto p_func = tvm::ffi::Function::GetGlobal(info.name);
-        if (p_func.has_value()) func = *p_func;
-      }
-      TVM_FFI_ICHECK(func.has_value())
-          << "Error: Cannot find ffi::Function " << info.name
-          << " in either Relax VM kernel library, or in TVM runtime ffi::Function registry, or in "
-             "global Relax functions of the VM executable";
-      func_pool_[func_index] = *func;
-
+      func_pool_[func_index] = link_table_->packed_funcs[func_index];
     } else {
       TVM_FFI_ICHECK(info.kind == VMFuncInfo::FuncKind::kVMFunc ||
                      info.kind == VMFuncInfo::FuncKind::kVMTIRFunc);
@@ -724,9 +1131,77 @@ void VirtualMachineImpl::InitFuncPool() {
   }
 }
 
-void VirtualMachineImpl::RunInstrCall(VMFrame* curr_frame, Instruction instr) {
-  DLOG(INFO) << "\n  pc = " << pc_ << ", execute: " << GetFuncName(instr.func_idx);
-  int args_begin_offset = instrument_ != nullptr ? 4 : 0;
+void VirtualMachineImpl::RunInstrCall(VMInvocationContext* ctx, VMFrame* curr_frame,
+                                      Instruction instr) {
+  DLOG(INFO) << "\n  pc = " << ctx->pc << ", execute: " << GetFuncName(instr.func_idx);
+  // Attribute device allocations made by the callee to its function name,
+  // so an allocation trace dump points back at the responsible op.
+  if (memory::AllocationTracer::Enabled()) {
+    memory::AllocationTracer::SetCurrentTag(GetFuncName(instr.func_idx));
+  }
+  // Likewise attribute thread pool hardware counter samples to the callee.
+  if (threading::TaskPerfCountersEnabled()) {
+    threading::SetTaskAttributionTag(GetFuncName(instr.func_idx));
+  }
+  // Fast path: without an instrument we can reuse the per call-site argument
+  // cache of the frame and only refresh register operands.
+  if (instrument_ == nullptr) {
+    auto it = curr_frame->call_arg_cache.find(ctx->pc);
+    if (it == curr_frame->call_arg_cache.end()) {
+      VMFrame::CallArgCache entry;
+      entry.args.resize(instr.num_args);
+      for (Index i = 0; i < instr.num_args; ++i) {
+        Instruction::Arg arg = instr.args[i];
+        switch (arg.kind()) {
+          case Instruction::ArgKind::kRegister: {
+            entry.reg_slots.emplace_back(i, arg.value());
+            break;
+          }
+          case Instruction::ArgKind::kImmediate: {
+            entry.args[i] = arg.value();
+            break;
+          }
+          case Instruction::ArgKind::kConstIdx: {
+            entry.args[i] = this->GetConstant(arg.value());
+            break;
+          }
+          case Instruction::ArgKind::kFuncIdx: {
+            TVM_FFI_ICHECK_LT(static_cast<size_t>(arg.value()), this->func_pool_.size());
+            entry.args[i] = this->func_pool_[arg.value()];
+            break;
+          }
+          default: {
+            TVM_FFI_THROW(ValueError) << "Unknown argument kind: " << int(arg.kind());
+          }
+        }
+      }
+      it = curr_frame->call_arg_cache.emplace(ctx->pc, std::move(entry)).first;
+    }
+    VMFrame::CallArgCache& cached = it->second;
+    for (const auto& [pos, reg] : cached.reg_slots) {
+      cached.args[pos] = ReadRegister(curr_frame, reg);
+    }
+    ffi::Any ret;
+    TVM_FFI_ICHECK_LT(static_cast<size_t>(instr.func_idx), this->func_pool_.size());
+    if (profiling_ || DeviceTraceEnabled()) {
+      this->InvokeTracedCall(instr.func_idx, ffi::PackedArgs(cached.args.data(), instr.num_args),
+                             &ret);
+    } else {
+      this->InvokeClosurePacked(func_pool_[instr.func_idx].cast<ffi::ObjectRef>(),
+                                ffi::PackedArgs(cached.args.data(), instr.num_args), &ret);
+    }
+    // save the return value to the register
+    // saving to special register is a NOP
+    if (instr.dst < Instruction::kBeginSpecialReg) {
+      WriteRegister(curr_frame, instr.dst, ret);
+    }
+    // increment pc
+    ctx->pc++;
+    return;
+  }
+  // Instrumented path: rebuild the argument vector per invocation since the
+  // instrument callback may observe and rewrite it.
+  int args_begin_offset = 4;
   // Use the call arg stack from the current frame to increase reuse
   // and avoid re-allocation
   curr_frame->call_args.resize(args_begin_offset + instr.num_args);
@@ -748,7 +1223,7 @@ void VirtualMachineImpl::RunInstrCall(VMFrame* curr_frame, Instruction instr) {
         break;
       }
       case Instruction::ArgKind::kConstIdx: {
-        call_args[arg_index] = this->const_pool_[arg.value()];
+        call_args[arg_index] = this->GetConstant(arg.value());
         break;
       }
       case Instruction::ArgKind::kFuncIdx: {
@@ -766,9 +1241,7 @@ void VirtualMachineImpl::RunInstrCall(VMFrame* curr_frame, Instruction instr) {
 
   TVM_FFI_ICHECK_LT(static_cast<size_t>(instr.func_idx), this->func_pool_.size());
 
-  if (instrument_ == nullptr) {
-    this->InvokeClosurePacked(func_pool_[instr.func_idx].cast<ffi::ObjectRef>(), args, &ret);
-  } else {
+  {
     // insert light-weight instrument callback
     call_args[0] = func_pool_[instr.func_idx];
     call_args[1] = GetFuncName(instr.func_idx);
@@ -792,7 +1265,7 @@ void VirtualMachineImpl::RunInstrCall(VMFrame* curr_frame, Instruction instr) {
       ret_kind = opt_int.value();
     }
     if (ret_kind != static_cast<int>(VMInstrumentReturnKind::kSkipRun)) {
-      this->InvokeClosurePacked(func_pool_[instr.func_idx].cast<ffi::ObjectRef>(), args, &ret);
+      this->InvokeTracedCall(instr.func_idx, args, &ret);
       call_args[2] = false;
       call_args[3] = ret;
       instrument_.CallPacked(call_args.data(), call_args.size(), &rv);
@@ -805,48 +1278,303 @@ void VirtualMachineImpl::RunInstrCall(VMFrame* curr_frame, Instruction instr) {
     WriteRegister(curr_frame, instr.dst, ret);
   }
   // increment pc
-  pc_++;
+  ctx->pc++;
+}
+
+void VirtualMachineImpl::InvokeTracedCall(Index func_idx, ffi::PackedArgs args, ffi::Any* ret) {
+  Device dev = devices.empty() ? Device{kDLCPU, 0} : devices[0];
+  bool trace_spans = DeviceTraceEnabled();
+  int64_t begin_ns = trace_spans ? DeviceTraceNowNanos() : 0;
+  Timer timer{nullptr};
+  if (profiling_) {
+    // Device-specific timers are event based (e.g. cudaEvent), so the
+    // measured interval covers the launched kernels rather than just the
+    // dispatch overhead on the host.
+    timer = Timer::Start(dev);
+  }
+  this->InvokeClosurePacked(func_pool_[func_idx].cast<ffi::ObjectRef>(), args, ret);
+  if (timer.defined()) {
+    timer->Stop();
+    // SyncAndGetElapsedNanos waits for the device, trading pipelining for
+    // per-call accuracy while profiling is on.
+    int64_t device_ns = timer->SyncAndGetElapsedNanos();
+    int64_t bytes_moved = EstimateBytesMoved(args, *ret);
+    std::lock_guard<std::mutex> lock(profile_mutex_);
+    ProfileEntry& entry = profile_stats_[func_idx];
+    entry.calls += 1;
+    entry.device_ns += device_ns;
+    entry.bytes_moved += bytes_moved;
+  }
+  if (trace_spans) {
+    DeviceTraceRecordSpan(GetFuncName(func_idx), dev, begin_ns, DeviceTraceNowNanos());
+  }
+}
+
+std::string VirtualMachineImpl::_ProfileReport() {
+  // order by accumulated device time, heaviest first
+  std::vector<std::pair<Index, ProfileEntry>> entries;
+  {
+    std::lock_guard<std::mutex> lock(profile_mutex_);
+    entries.assign(profile_stats_.begin(), profile_stats_.end());
+  }
+  std::sort(entries.begin(), entries.end(),
+            [](const auto& a, const auto& b) { return a.second.device_ns > b.second.device_ns; });
+  Device dev = devices.empty() ? Device{kDLCPU, 0} : devices[0];
+  std::ostringstream os;
+  os << std::fixed << std::setprecision(3);
+  os << "{\"device\":\"" << DLDeviceType2Str(dev.device_type) << ":" << dev.device_id << "\","
+     << "\"entries\":[";
+  for (size_t i = 0; i < entries.size(); ++i) {
+    const ProfileEntry& entry = entries[i].second;
+    double seconds = entry.device_ns / 1e9;
+    // Achieved bandwidth is the roofline annotation: functions whose value
+    // approaches the device's peak bandwidth are memory bound.
+    double gbytes_per_sec = seconds > 0 ? entry.bytes_moved / seconds / 1e9 : 0.0;
+    if (i != 0) os << ",";
+    os << "{\"name\":\"" << GetFuncName(entries[i].first) << "\","
+       << "\"calls\":" << entry.calls << ","
+       << "\"device_ms\":" << entry.device_ns / 1e6 << ","
+       << "\"bytes_moved\":" << entry.bytes_moved << ","
+       << "\"gbytes_per_sec\":" << gbytes_per_sec << "}";
+  }
+  os << "]}";
+  return os.str();
+}
+
+//------------------------------------------
+// Warmup capture and replay
+//------------------------------------------
+/*! \brief Split one line of the warmup file into delimiter-separated fields. */
+static std::vector<std::string> SplitWarmupFields(const std::string& line, char delim) {
+  std::vector<std::string> fields;
+  std::istringstream is(line);
+  std::string field;
+  while (std::getline(is, field, delim)) {
+    fields.push_back(field);
+  }
+  return fields;
+}
+
+std::optional<std::string> VirtualMachineImpl::SerializeWarmupArgs(ffi::PackedArgs args) {
+  std::ostringstream os;
+  os << std::setprecision(17);
+  for (int i = 0; i < args.size(); ++i) {
+    if (i != 0) os << '\t';
+    if (auto opt_tensor = args[i].as<Tensor>()) {
+      Tensor tensor = opt_tensor.value();
+      os << "T:" << static_cast<int>(tensor->device.device_type) << ":"
+         << tensor->device.device_id << ":" << ffi::DLDataTypeToString(tensor->dtype) << ":";
+      ffi::Shape shape = tensor.Shape();
+      for (size_t j = 0; j < shape.size(); ++j) {
+        if (j != 0) os << 'x';
+        os << shape[j];
+      }
+    } else if (auto* shape_obj = args[i].as<ffi::Shape::ContainerType>()) {
+      os << "S:";
+      for (uint64_t j = 0; j < shape_obj->size; ++j) {
+        if (j != 0) os << 'x';
+        os << shape_obj->data[j];
+      }
+    } else {
+      switch (args[i].type_index()) {
+        case ffi::TypeIndex::kTVMFFINone:
+          os << 'n';
+          break;
+        case ffi::TypeIndex::kTVMFFIBool:
+          os << "b:" << (args[i].cast<bool>() ? 1 : 0);
+          break;
+        case ffi::TypeIndex::kTVMFFIInt:
+          os << "i:" << args[i].cast<int64_t>();
+          break;
+        case ffi::TypeIndex::kTVMFFIFloat:
+          os << "f:" << args[i].cast<double>();
+          break;
+        default:
+          // Opaque objects (closures, modules, KV caches, ...) cannot be
+          // synthesized at replay time, so the whole invocation is dropped.
+          return std::nullopt;
+      }
+    }
+  }
+  return os.str();
+}
+
+void VirtualMachineImpl::RecordWarmupInvocation(const ffi::String& func_name,
+                                                ffi::PackedArgs args) {
+  std::optional<std::string> sig = SerializeWarmupArgs(args);
+  if (!sig.has_value()) return;
+  std::string record = std::string(func_name);
+  if (!sig->empty()) {
+    record += '\t';
+    record += *sig;
+  }
+  std::lock_guard<std::mutex> lock(warmup_mutex_);
+  if (!warmup_capturing_) return;
+  if (warmup_seen_.insert(record).second) {
+    warmup_records_.push_back(std::move(record));
+  }
+}
+
+void VirtualMachineImpl::_WarmupCaptureSave(std::string path) {
+  std::lock_guard<std::mutex> lock(warmup_mutex_);
+  warmup_capturing_ = false;
+  std::ofstream file(path, std::ios::trunc);
+  TVM_FFI_CHECK(file.good(), ValueError) << "Cannot write the warmup file to \"" << path << "\".";
+  for (const std::string& record : warmup_records_) {
+    file << "call\t" << record << "\n";
+  }
+  // Pooled allocators retain every page they have ever handed out, so the
+  // amount in use after the canary run is the pool's high-water mark.
+  for (size_t i = 0; i < devices.size(); ++i) {
+    file << "mem\t" << static_cast<int>(devices[i].device_type) << "\t" << devices[i].device_id
+         << "\t" << allocators[i]->UsedMemory() << "\n";
+  }
+  warmup_records_.clear();
+  warmup_seen_.clear();
+}
+
+RegType VirtualMachineImpl::SynthesizeWarmupArg(const std::string& token) {
+  RegType ret;
+  if (token == "n") return ret;
+  TVM_FFI_CHECK(token.size() >= 2 && token[1] == ':', ValueError)
+      << "Malformed warmup record token: " << token;
+  std::string payload = token.substr(2);
+  switch (token[0]) {
+    case 'i':
+      ret = static_cast<int64_t>(std::stoll(payload));
+      break;
+    case 'b':
+      ret = (payload != "0");
+      break;
+    case 'f':
+      ret = std::stod(payload);
+      break;
+    case 'S': {
+      std::vector<int64_t> dims;
+      for (const std::string& dim : SplitWarmupFields(payload, 'x')) {
+        dims.push_back(std::stoll(dim));
+      }
+      ret = ffi::Shape(dims);
+      break;
+    }
+    case 'T': {
+      std::vector<std::string> parts = SplitWarmupFields(payload, ':');
+      TVM_FFI_CHECK(parts.size() >= 3, ValueError)
+          << "Malformed warmup record token: " << token;
+      Device dev{static_cast<DLDeviceType>(std::stoi(parts[0])), std::stoi(parts[1])};
+      // Fall back to the primary device when the capture run used a device
+      // this VM was not initialized with.
+      size_t dev_index = 0;
+      for (size_t i = 0; i < devices.size(); ++i) {
+        if (devices[i].device_type == dev.device_type && devices[i].device_id == dev.device_id) {
+          dev_index = i;
+          break;
+        }
+      }
+      std::vector<int64_t> dims;
+      if (parts.size() >= 4 && !parts[3].empty()) {
+        for (const std::string& dim : SplitWarmupFields(parts[3], 'x')) {
+          dims.push_back(std::stoll(dim));
+        }
+      }
+      ret = allocators[dev_index]->Empty(ffi::Shape(dims), ffi::StringToDLDataType(parts[2]),
+                                         devices[dev_index]);
+      break;
+    }
+    default:
+      TVM_FFI_THROW(ValueError) << "Malformed warmup record token: " << token;
+  }
+  return ret;
+}
+
+void VirtualMachineImpl::_WarmupReplay(std::string path) {
+  std::ifstream file(path);
+  TVM_FFI_CHECK(file.good(), ValueError) << "Cannot read the warmup file \"" << path << "\".";
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.empty()) continue;
+    std::vector<std::string> fields = SplitWarmupFields(line, '\t');
+    if (fields[0] == "call" && fields.size() >= 2) {
+      // Functions missing from this executable are skipped: the file may come
+      // from a canary run of a superset deployment.
+      auto opt_clo = this->GetClosureInternal(fields[1], /*allow_missing=*/true);
+      if (!opt_clo.has_value()) continue;
+      std::vector<RegType> call_args;
+      call_args.reserve(fields.size() - 2);
+      for (size_t i = 2; i < fields.size(); ++i) {
+        call_args.push_back(SynthesizeWarmupArg(fields[i]));
+      }
+      this->InvokeClosureInternal(opt_clo.value(), call_args);
+    } else if (fields[0] == "mem" && fields.size() == 4) {
+      Device dev{static_cast<DLDeviceType>(std::stoi(fields[1])), std::stoi(fields[2])};
+      size_t target = static_cast<size_t>(std::stoull(fields[3]));
+      for (size_t i = 0; i < devices.size(); ++i) {
+        if (devices[i].device_type != dev.device_type || devices[i].device_id != dev.device_id) {
+          continue;
+        }
+        size_t used = allocators[i]->UsedMemory();
+        if (target > used) {
+          // Grow the pool to the captured high-water mark so early traffic
+          // never pays for a fresh device allocation.
+          memory::Buffer reserve =
+              allocators[i]->Alloc(devices[i], target - used, kAllocAlignment, {kDLUInt, 8, 1});
+          allocators[i]->Free(reserve);
+        }
+        break;
+      }
+    }
+  }
+}
+
+void VirtualMachineImpl::RunLoop(VMInvocationContext* ctx) {
+#if TVM_VM_USE_COMPUTED_GOTO
+  if (dispatch_mode_ == VMDispatchMode::kDirectThreaded) {
+    RunLoopDirectThreaded(ctx);
+    return;
+  }
+#endif
+  RunLoopSwitch(ctx);
 }
 
-void VirtualMachineImpl::RunLoop() {
-  VMFrame* curr_frame = frames_.back().get();
+void VirtualMachineImpl::RunLoopSwitch(VMInvocationContext* ctx) {
+  VMFrame* curr_frame = ctx->frames.back().get();
 
   while (true) {
-    TVM_FFI_ICHECK_LT(static_cast<size_t>(pc_), exec_->instr_offset.size())
+    TVM_FFI_ICHECK_LT(static_cast<size_t>(ctx->pc), exec_->instr_offset.size())
         << "run into invalid section";
-    Instruction instr = exec_->GetInstruction(pc_);
+    Instruction instr = exec_->GetInstruction(ctx->pc);
     switch (instr.op) {
       case Opcode::Call: {
-        this->RunInstrCall(curr_frame, instr);
+        this->RunInstrCall(ctx, curr_frame, instr);
         break;
       }
       case Opcode::Ret: {
         // If we have hit the point from which we started
         // running, we should return to the caller breaking
         // the dispatch loop.
-        return_value_ = ReadRegister(curr_frame, instr.result);
+        ctx->return_value = ReadRegister(curr_frame, instr.result);
         RegName caller_return_register = curr_frame->caller_return_register;
-        if (frames_.size() <= 1) {
+        if (ctx->frames.size() <= 1) {
           // directly return if no other frame in the call stack.
         } else {
           // return from a local call.
           // Update the current frame to be the parent frame.
-          VMFrame* parent_frame = frames_.end()[-2].get();
-          WriteRegister(parent_frame, caller_return_register, return_value_);
+          VMFrame* parent_frame = ctx->frames.end()[-2].get();
+          WriteRegister(parent_frame, caller_return_register, ctx->return_value);
         }
         return;
       }
       case Opcode::Goto: {
-        pc_ += instr.pc_offset;
+        ctx->pc += instr.pc_offset;
         break;
       }
       case Opcode::If: {
         int64_t cond_val = ReadRegister(curr_frame, instr.cond).cast<int64_t>();
         if (cond_val != 0) {
-          pc_++;
+          ctx->pc++;
         } else {
           TVM_FFI_ICHECK_GT(instr.false_offset, 1);
-          pc_ += instr.false_offset;
+          ctx->pc += instr.false_offset;
         }
         break;
       }
@@ -854,8 +1582,77 @@ void VirtualMachineImpl::RunLoop() {
   }
 }
 
-ffi::ObjectPtr<VirtualMachine> VirtualMachine::Create() {
-  return ffi::make_object<VirtualMachineImpl>();
+#if TVM_VM_USE_COMPUTED_GOTO
+void VirtualMachineImpl::RunLoopDirectThreaded(VMInvocationContext* ctx) {
+  // Jump table indexed by the integer value of Opcode; slot 0 is unused.
+  static const void* kDispatchTable[] = {nullptr, &&handle_call, &&handle_ret, &&handle_goto,
+                                         &&handle_if};
+  // Cache hot state in locals: the current frame, the base of its register
+  // file and the program counter. ctx->pc is synced back around Call since
+  // the callee may re-enter the interpreter through InvokeBytecode.
+  VMFrame* curr_frame = ctx->frames.back().get();
+  RegType* reg_file = curr_frame->register_file.data();
+  Index pc = ctx->pc;
+  Instruction instr;
+
+#define TVM_VM_DISPATCH()                                                                \
+  do {                                                                                   \
+    TVM_FFI_ICHECK_LT(static_cast<size_t>(pc), exec_->instr_offset.size())               \
+        << "run into invalid section";                                                   \
+    instr = exec_->GetInstruction(pc);                                                   \
+    goto* kDispatchTable[static_cast<int>(instr.op)];                                    \
+  } while (0)
+
+  TVM_VM_DISPATCH();
+
+handle_call : {
+  ctx->pc = pc;
+  this->RunInstrCall(ctx, curr_frame, instr);
+  pc = ctx->pc;
+  TVM_VM_DISPATCH();
+}
+
+handle_ret : {
+  ctx->return_value = instr.result < Instruction::kBeginSpecialReg
+                          ? reg_file[instr.result]
+                          : ReadRegister(curr_frame, instr.result);
+  RegName caller_return_register = curr_frame->caller_return_register;
+  ctx->pc = pc;
+  if (ctx->frames.size() <= 1) {
+    // directly return if no other frame in the call stack.
+  } else {
+    // return from a local call.
+    // Update the current frame to be the parent frame.
+    VMFrame* parent_frame = ctx->frames.end()[-2].get();
+    WriteRegister(parent_frame, caller_return_register, ctx->return_value);
+  }
+  return;
+}
+
+handle_goto : {
+  pc += instr.pc_offset;
+  TVM_VM_DISPATCH();
+}
+
+handle_if : {
+  int64_t cond_val = (instr.cond < Instruction::kBeginSpecialReg
+                          ? reg_file[instr.cond]
+                          : ReadRegister(curr_frame, instr.cond))
+                         .cast<int64_t>();
+  if (cond_val != 0) {
+    pc++;
+  } else {
+    TVM_FFI_ICHECK_GT(instr.false_offset, 1);
+    pc += instr.false_offset;
+  }
+  TVM_VM_DISPATCH();
+}
+#undef TVM_VM_DISPATCH
+}
+#endif  // TVM_VM_USE_COMPUTED_GOTO
+
+ffi::ObjectPtr<VirtualMachine> VirtualMachine::Create(VMDispatchMode dispatch_mode) {
+  return ffi::make_object<VirtualMachineImpl>(dispatch_mode);
 }
 
 //--------------------------------------------------------------------
@@ -23,6 +23,7 @@
  */
 #include "workspace_pool.h"
 
+#include <algorithm>
 #include <memory>
 
 namespace tvm {
@@ -82,6 +83,8 @@ class WorkspacePool::Pool {
       }
     }
     allocated_.push_back(e);
+    in_use_bytes_ += e.size;
+    high_water_bytes_ = std::max(high_water_bytes_, in_use_bytes_);
     return e.data;
   }
   // free resource back to pool
@@ -99,6 +102,7 @@ class WorkspacePool::Pool {
       e = allocated_[index];
       allocated_.erase(allocated_.begin() + index);
     }
+    in_use_bytes_ -= e.size;
     if (free_list_.back().size < e.size) {
       free_list_.push_back(e);
     } else if (free_list_.size() == 2) {
@@ -120,6 +124,38 @@ class WorkspacePool::Pool {
     }
     free_list_.clear();
   }
+  // peak concurrently-allocated bytes
+  uint64_t HighWaterBytes() const { return high_water_bytes_; }
+  // the sizes of all pages the pool holds, free and allocated
+  std::vector<size_t> Sizes() const {
+    std::vector<size_t> sizes;
+    for (size_t i = 1; i < free_list_.size(); ++i) {
+      sizes.push_back(free_list_[i].size);
+    }
+    for (size_t i = 1; i < allocated_.size(); ++i) {
+      sizes.push_back(allocated_[i].size);
+    }
+    return sizes;
+  }
+  // pre-allocate pages of the given sizes into the free list
+  void PreAlloc(Device dev, DeviceAPI* device, const std::vector<size_t>& sizes) {
+    DLDataType type;
+    type.code = kDLUInt;
+    type.bits = 8;
+    type.lanes = 1;
+    for (size_t nbytes : sizes) {
+      nbytes = (nbytes + (kWorkspacePageSize - 1)) / kWorkspacePageSize * kWorkspacePageSize;
+      if (nbytes == 0) continue;
+      Entry e;
+      e.data = device->AllocDataSpace(dev, nbytes, kTempAllocaAlignment, type);
+      e.size = nbytes;
+      free_list_.push_back(e);
+    }
+    // restore the small-to-big order Alloc's best-fit scan relies on;
+    // the safe-guard header stays at index 0.
+    std::sort(free_list_.begin() + 1, free_list_.end(),
+              [](const Entry& a, const Entry& b) { return a.size < b.size; });
+  }
 
  private:
   /*! \brief a single entry in the pool */
@@ -131,6 +167,10 @@ class WorkspacePool::Pool {
   std::vector<Entry> free_list_;
   /*! \brief List of allocated items */
   std::vector<Entry> allocated_;
+  /*! \brief The number of currently allocated bytes */
+  uint64_t in_use_bytes_ = 0;
+  /*! \brief The peak number of concurrently allocated bytes */
+  uint64_t high_water_bytes_ = 0;
 };
 
 WorkspacePool::WorkspacePool(DLDeviceType device_type, DeviceAPI* device)
@@ -164,5 +204,29 @@ void WorkspacePool::FreeWorkspace(Device dev, void* ptr) {
   array_[dev.device_id]->Free(ptr);
 }
 
+uint64_t WorkspacePool::HighWaterBytes(Device dev) const {
+  if (static_cast<size_t>(dev.device_id) >= array_.size() || array_[dev.device_id] == nullptr) {
+    return 0;
+  }
+  return array_[dev.device_id]->HighWaterBytes();
+}
+
+std::vector<size_t> WorkspacePool::WorkspaceSizes(Device dev) const {
+  if (static_cast<size_t>(dev.device_id) >= array_.size() || array_[dev.device_id] == nullptr) {
+    return {};
+  }
+  return array_[dev.device_id]->Sizes();
+}
+
+void WorkspacePool::PreAllocWorkspace(Device dev, const std::vector<size_t>& sizes) {
+  if (static_cast<size_t>(dev.device_id) >= array_.size()) {
+    array_.resize(dev.device_id + 1, nullptr);
+  }
+  if (array_[dev.device_id] == nullptr) {
+    array_[dev.device_id] = new Pool();
+  }
+  array_[dev.device_id]->PreAlloc(dev, device_, sizes);
+}
+
 }  // namespace runtime
 }  // namespace tvm
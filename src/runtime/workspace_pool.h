@@ -26,6 +26,7 @@
 
 #include <tvm/runtime/device_api.h>
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -65,6 +66,28 @@ class TVM_RUNTIME_DLL WorkspacePool {
    * \param ptr The pointer to be freed.
    */
   void FreeWorkspace(Device dev, void* ptr);
+  /*!
+   * \brief The peak number of concurrently allocated workspace bytes on dev.
+   * \param dev The device to query.
+   */
+  uint64_t HighWaterBytes(Device dev) const;
+  /*!
+   * \brief The sizes of all pages currently held for dev.
+   *
+   * Since pages only ever grow, this is the high-water footprint the pool
+   * reached, e.g. over a warmup run; replaying it through PreAllocWorkspace
+   * in a fresh process removes allocation from the runs that follow.
+   *
+   * \param dev The device to query.
+   */
+  std::vector<size_t> WorkspaceSizes(Device dev) const;
+  /*!
+   * \brief Pre-allocate pages of the given sizes into the pool of dev,
+   * typically a footprint previously recorded by WorkspaceSizes.
+   * \param dev The device to reserve on.
+   * \param sizes The page sizes in bytes.
+   */
+  void PreAllocWorkspace(Device dev, const std::vector<size_t>& sizes);
 
  private:
   class Pool;
@@ -0,0 +1,285 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include <tvm/ffi/reflection/registry.h>
+
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../utils.h"
+
+namespace tvm {
+namespace s_tir {
+namespace meta_schedule {
+
+/**************** JSON field accessors ****************/
+
+ffi::Map<ffi::String, Any> JSONAsDict(const Any& json, const char* what) {
+  auto opt = json.try_cast<ffi::Map<ffi::String, Any>>();
+  TVM_FFI_CHECK(opt, ValueError) << "Expect " << what << " to be a JSON object, but gets: "
+                                 << json.GetTypeKey();
+  return *std::move(opt);
+}
+
+Any JSONDictAt(const ffi::Map<ffi::String, Any>& dict, const char* key) {
+  ffi::Optional<Any> value = dict.Get(key);
+  TVM_FFI_CHECK(value, ValueError) << "Missing field in the model file: " << key;
+  return *std::move(value);
+}
+
+double JSONAsDouble(const Any& json, const char* what) {
+  // Numbers in model files may appear as floats, as integers, or - for xgboost
+  // learner params such as `base_score` - as decimal strings like "5E-1".
+  if (auto opt = json.try_cast<double>()) {
+    return *opt;
+  }
+  if (auto opt = json.try_cast<int64_t>()) {
+    return static_cast<double>(*opt);
+  }
+  if (auto opt = json.as<ffi::String>()) {
+    return std::stod((*opt).operator std::string());
+  }
+  TVM_FFI_THROW(ValueError) << "Expect " << what << " to be a number, but gets: "
+                            << json.GetTypeKey();
+  throw;
+}
+
+int64_t JSONAsInt(const Any& json, const char* what) {
+  if (auto opt = json.try_cast<int64_t>()) {
+    return *opt;
+  }
+  if (auto opt = json.try_cast<bool>()) {
+    return *opt ? 1 : 0;
+  }
+  TVM_FFI_THROW(ValueError) << "Expect " << what << " to be an integer, but gets: "
+                            << json.GetTypeKey();
+  throw;
+}
+
+/**************** Tree ensemble ****************/
+
+/*!
+ * \brief A single regression tree in flattened array form, following the xgboost
+ * JSON model layout: node `i` is a leaf iff `left[i] < 0`, in which case its
+ * output value is stored in `split_cond[i]`.
+ */
+struct RegressionTree {
+  /*! \brief The left child of each node; -1 for leaves */
+  std::vector<int> left;
+  /*! \brief The right child of each node; -1 for leaves */
+  std::vector<int> right;
+  /*! \brief The feature index each node splits on */
+  std::vector<int> split_index;
+  /*! \brief The split threshold of each inner node, or the value of each leaf */
+  std::vector<double> split_cond;
+  /*! \brief Whether a missing feature value follows the left child */
+  std::vector<uint8_t> default_left;
+
+  /*! \brief Evaluate the tree on one feature row. */
+  double Predict(const double* row, int num_cols) const {
+    int i = 0;
+    while (left[i] >= 0) {
+      int fid = split_index[i];
+      // Features beyond the row length are treated as missing, so models trained
+      // with a different trailing-feature configuration degrade instead of crash.
+      double value = fid < num_cols ? row[fid] : std::numeric_limits<double>::quiet_NaN();
+      if (std::isnan(value)) {
+        i = default_left[i] ? left[i] : right[i];
+      } else {
+        i = value < split_cond[i] ? left[i] : right[i];
+      }
+    }
+    return split_cond[i];
+  }
+};
+
+RegressionTree ParseRegressionTree(const Any& json) {
+  ffi::Map<ffi::String, Any> dict = JSONAsDict(json, "a tree");
+  auto as_int_vec = [&dict](const char* key) -> std::vector<int> {
+    ffi::Array<Any> arr = JSONDictAt(dict, key).cast<ffi::Array<Any>>();
+    std::vector<int> result;
+    result.reserve(arr.size());
+    for (const Any& elem : arr) {
+      result.push_back(static_cast<int>(JSONAsInt(elem, key)));
+    }
+    return result;
+  };
+  auto as_double_vec = [&dict](const char* key) -> std::vector<double> {
+    ffi::Array<Any> arr = JSONDictAt(dict, key).cast<ffi::Array<Any>>();
+    std::vector<double> result;
+    result.reserve(arr.size());
+    for (const Any& elem : arr) {
+      result.push_back(JSONAsDouble(elem, key));
+    }
+    return result;
+  };
+  RegressionTree tree;
+  tree.left = as_int_vec("left_children");
+  tree.right = as_int_vec("right_children");
+  tree.split_index = as_int_vec("split_indices");
+  tree.split_cond = as_double_vec("split_conditions");
+  {
+    std::vector<int> default_left = as_int_vec("default_left");
+    tree.default_left.assign(default_left.begin(), default_left.end());
+  }
+  size_t n = tree.left.size();
+  TVM_FFI_CHECK(n > 0 && tree.right.size() == n && tree.split_index.size() == n &&
+                    tree.split_cond.size() == n && tree.default_left.size() == n,
+                ValueError)
+      << "Malformed tree in the model file: the node arrays have inconsistent lengths";
+  return tree;
+}
+
+/*!
+ * \brief Parse an xgboost JSON model (the format written by `save_model("*.json")`)
+ * into flattened trees and the global bias.
+ */
+void ParseXGBoostModel(const Any& json, std::vector<RegressionTree>* trees, double* base_score) {
+  ffi::Map<ffi::String, Any> learner =
+      JSONAsDict(JSONDictAt(JSONAsDict(json, "the model file"), "learner"), "learner");
+  *base_score = JSONAsDouble(
+      JSONDictAt(JSONAsDict(JSONDictAt(learner, "learner_model_param"), "learner_model_param"),
+                 "base_score"),
+      "base_score");
+  ffi::Map<ffi::String, Any> booster =
+      JSONAsDict(JSONDictAt(learner, "gradient_booster"), "gradient_booster");
+  ffi::Optional<Any> model = booster.Get("model");
+  TVM_FFI_CHECK(model && JSONAsDict(*model, "model").Get("trees"), ValueError)
+      << "Only tree boosters are supported, but the model file has no `trees` field";
+  ffi::Array<Any> json_trees =
+      JSONDictAt(JSONAsDict(*model, "model"), "trees").cast<ffi::Array<Any>>();
+  trees->clear();
+  trees->reserve(json_trees.size());
+  for (const Any& json_tree : json_trees) {
+    trees->push_back(ParseRegressionTree(json_tree));
+  }
+}
+
+/*!
+ * \brief A cost model that runs gradient-boosted-tree inference natively in-process.
+ *
+ * The model is trained offline (e.g. by the Python-side XGB cost model over features
+ * produced by the same extractor) and loaded from an xgboost JSON model file. Prediction
+ * featurizes the candidates, evaluates every per-store feature row through the tree
+ * ensemble in parallel, and sums the per-row margins of each candidate, so the search
+ * loop never crosses into Python.
+ */
+class TreeEnsembleCostModelNode : public CostModelNode {
+ public:
+  /*! \brief The extractor used to featurize measure candidates */
+  FeatureExtractor extractor{nullptr};
+
+  void Load(const ffi::String& path) final {
+    std::ifstream is(path);
+    TVM_FFI_CHECK(is.good(), ValueError) << "Cannot open the model file: " << path;
+    std::ostringstream ss;
+    ss << is.rdbuf();
+    std::string raw_model = ss.str();
+    std::vector<RegressionTree> trees;
+    double base_score = 0.0;
+    ParseXGBoostModel(JSONLoads(raw_model), &trees, &base_score);
+    this->trees_ = std::move(trees);
+    this->base_score_ = base_score;
+    this->raw_model_ = std::move(raw_model);
+  }
+
+  void Save(const ffi::String& path) final {
+    TVM_FFI_CHECK(!raw_model_.empty(), ValueError)
+        << "Cannot save the tree-ensemble cost model: no model has been loaded";
+    std::ofstream os(path);
+    TVM_FFI_CHECK(os.good(), ValueError) << "Cannot open the file to write: " << path;
+    os << raw_model_;
+  }
+
+  void Update(const TuneContext& context, const ffi::Array<MeasureCandidate>& candidates,
+              const ffi::Array<RunnerResult>& results) final {
+    // Training happens offline; this model only serves inference. The measured results
+    // are recorded by the database anyway, so an offline retrain loses nothing.
+  }
+
+  std::vector<double> Predict(const TuneContext& context,
+                              const ffi::Array<MeasureCandidate>& candidates) final {
+    TVM_FFI_CHECK(!trees_.empty(), ValueError)
+        << "The tree-ensemble cost model must be loaded before prediction";
+    ffi::Array<runtime::Tensor> features = extractor->ExtractFrom(context, candidates);
+    int num_candidates = candidates.size();
+    std::vector<double> result(num_candidates, 0.0);
+    auto f = [this, &features, &result](int, int task_id) -> void {
+      const runtime::Tensor& feature = features[task_id];
+      TVM_FFI_ICHECK_EQ(feature->ndim, 2);
+      TVM_FFI_ICHECK(feature->dtype.code == kDLFloat && feature->dtype.bits == 64);
+      int num_rows = feature->shape[0];
+      int num_cols = feature->shape[1];
+      const double* data = static_cast<const double*>(feature->data);
+      // Pack-sum: the score of a candidate is the sum of the per-row margins,
+      // mirroring how the trainer groups per-store rows by candidate.
+      double score = 0.0;
+      for (int i = 0; i < num_rows; ++i) {
+        const double* row = data + i * num_cols;
+        double margin = this->base_score_;
+        for (const RegressionTree& tree : this->trees_) {
+          margin += tree.Predict(row, num_cols);
+        }
+        score += margin;
+      }
+      result[task_id] = score;
+    };
+    support::parallel_for_dynamic(0, num_candidates, context->num_threads, f);
+    return result;
+  }
+
+  static void RegisterReflection() {
+    namespace refl = tvm::ffi::reflection;
+    refl::ObjectDef<TreeEnsembleCostModelNode>()
+        .def_ro("extractor", &TreeEnsembleCostModelNode::extractor);
+  }
+
+  TVM_FFI_DECLARE_OBJECT_INFO_FINAL("s_tir.meta_schedule.TreeEnsembleCostModel",
+                                    TreeEnsembleCostModelNode, CostModelNode);
+
+ private:
+  /*! \brief The flattened trees of the ensemble */
+  std::vector<RegressionTree> trees_;
+  /*! \brief The global bias added to every per-row margin */
+  double base_score_ = 0.0;
+  /*! \brief The raw text of the loaded model file, kept so Save can round-trip it */
+  std::string raw_model_;
+};
+
+CostModel CostModel::TreeEnsemble(FeatureExtractor extractor, ffi::Optional<ffi::String> path) {
+  ffi::ObjectPtr<TreeEnsembleCostModelNode> n = ffi::make_object<TreeEnsembleCostModelNode>();
+  n->extractor = std::move(extractor);
+  if (path.has_value()) {
+    n->Load(path.value());
+  }
+  return CostModel(n);
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  TreeEnsembleCostModelNode::RegisterReflection();
+  refl::GlobalDef().def("s_tir.meta_schedule.CostModelTreeEnsemble", CostModel::TreeEnsemble);
+}
+
+}  // namespace meta_schedule
+}  // namespace s_tir
+}  // namespace tvm
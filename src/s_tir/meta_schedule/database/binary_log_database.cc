@@ -0,0 +1,574 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include <tvm/ffi/reflection/registry.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../../../support/mmap_file.h"
+#include "../module_equality.h"
+#include "../utils.h"
+
+namespace tvm {
+namespace s_tir {
+namespace meta_schedule {
+
+/*! \brief Magic number at the head of the binary record log ("TVMMSLOG"). */
+constexpr uint64_t kBinaryLogMagic = 0x54564D4D534C4F47;
+/*! \brief Magic number at the head of the hash index file ("TVMMSIDX"). */
+constexpr uint64_t kBinaryLogIndexMagic = 0x54564D4D53494458;
+/*! \brief Version of the binary record log format. */
+constexpr uint32_t kBinaryLogVersion = 1;
+
+/*! \brief The kinds of entries stored in the binary record log. */
+enum LogEntryKind : uint32_t {
+  kWorkloadEntry = 1,
+  kTuningRecordEntry = 2,
+};
+
+/*! \brief The fixed-size header at the beginning of the binary record log. */
+struct LogFileHeader {
+  uint64_t magic;
+  uint32_t version;
+  uint32_t reserved;
+};
+static_assert(sizeof(LogFileHeader) == 16, "LogFileHeader must not have padding");
+
+/*! \brief The fixed-size header preceding each entry payload in the log. */
+struct LogEntryHeader {
+  /*! \brief The kind of the entry, one of LogEntryKind. */
+  uint32_t kind;
+  uint32_t reserved;
+  /*! \brief The number of payload bytes following this header. */
+  uint64_t payload_bytes;
+  /*!
+   * \brief For workload entries, the structural hash of the workload.
+   * For tuning record entries, the byte offset of the workload entry the record belongs to.
+   */
+  uint64_t key;
+  /*!
+   * \brief For tuning record entries, the mean run seconds of the record, or
+   * SortTuningRecordByMeanRunSecs::kMaxMeanTime when the record is invalid.
+   * Unused for workload entries. Storing it here lets the index pick the best
+   * record per workload from headers alone, without parsing any payload.
+   */
+  double mean_run_secs;
+};
+static_assert(sizeof(LogEntryHeader) == 32, "LogEntryHeader must not have padding");
+
+/*! \brief The fixed-size header at the beginning of the hash index file. */
+struct IndexFileHeader {
+  uint64_t magic;
+  /*! \brief The prefix of the record log, in bytes, that the index covers. */
+  uint64_t log_bytes;
+  /*! \brief The number of tuning record entries in the covered prefix. */
+  uint64_t num_records;
+  /*! \brief The number of slots in the hash table. Always a power of two. */
+  uint64_t num_slots;
+};
+static_assert(sizeof(IndexFileHeader) == 32, "IndexFileHeader must not have padding");
+
+/*! \brief One open-addressing slot of the hash index, keyed by structural hash. */
+struct IndexSlot {
+  /*! \brief The structural hash of the workload. */
+  uint64_t shash;
+  /*! \brief The byte offset of the workload entry in the log. Zero marks an empty slot. */
+  uint64_t workload_offset;
+  /*! \brief The byte offset of the best valid record of the workload, or zero if none. */
+  uint64_t best_record_offset;
+  /*! \brief The mean run seconds of the best valid record. */
+  double best_mean_run_secs;
+};
+static_assert(sizeof(IndexSlot) == 32, "IndexSlot must not have padding");
+
+/*!
+ * \brief A database backed by an append-only binary record log and a hash index
+ * keyed by workload structural hash.
+ *
+ * Workloads and tuning records are appended to a single log file as
+ * length-prefixed JSON payloads; the per-entry headers carry the structural hash
+ * and the mean run seconds, so the log can be scanned without parsing any JSON.
+ * A sidecar index file (`<path>.idx`) maps each structural hash to the offsets
+ * of the workload entry and its best valid record; the index is memory-mapped on
+ * open and refreshed whenever the log has grown past what the index covers.
+ * Queries for the best record therefore parse exactly two payloads — the
+ * matching workload and its best record — instead of materializing the full
+ * database.
+ */
+class BinaryLogDatabaseNode : public DatabaseNode {
+ public:
+  explicit BinaryLogDatabaseNode(ffi::String mod_eq_name = "structural")
+      : DatabaseNode(mod_eq_name) {}
+
+  /*! \brief The path to the binary record log. */
+  ffi::String path_log;
+
+  static void RegisterReflection() {
+    namespace refl = tvm::ffi::reflection;
+    refl::ObjectDef<BinaryLogDatabaseNode>().def_ro("path_log", &BinaryLogDatabaseNode::path_log);
+  }
+  TVM_FFI_DECLARE_OBJECT_INFO_FINAL("s_tir.meta_schedule.BinaryLogDatabase", BinaryLogDatabaseNode,
+                                    DatabaseNode);
+
+ public:
+  bool HasWorkload(const IRModule& mod) { return FindWorkload(mod).workload_offset != 0; }
+
+  Workload CommitWorkload(const IRModule& mod) {
+    WorkloadLookup lookup = FindWorkload(mod);
+    if (lookup.workload_offset != 0) {
+      return DecodeWorkloadAt(lookup.workload_offset);
+    }
+    Workload workload(mod, GetModuleEquality().Hash(mod));
+    uint64_t offset = AppendEntry(kWorkloadEntry, workload->shash, /*mean_run_secs=*/0.0,
+                                  JSONDumps(workload->AsJSON()));
+    tail_workloads_.emplace(workload->shash, offset);
+    decoded_workloads_.emplace(offset, workload);
+    return workload;
+  }
+
+  void CommitTuningRecord(const TuningRecord& record) {
+    WorkloadLookup lookup = FindWorkload(record->workload->mod);
+    TVM_FFI_CHECK(lookup.workload_offset != 0, ValueError)
+        << "The workload of the tuning record has not been committed to the database";
+    double mean = record->IsValid()
+                      ? SortTuningRecordByMeanRunSecs::Mean(record->run_secs.value_or({}))
+                      : SortTuningRecordByMeanRunSecs::kMaxMeanTime;
+    uint64_t offset =
+        AppendEntry(kTuningRecordEntry, lookup.workload_offset, mean, JSONDumps(record->AsJSON()));
+    ++num_records_;
+    if (mean < SortTuningRecordByMeanRunSecs::kMaxMeanTime) {
+      WorkloadState& state = tail_states_[lookup.workload_offset];
+      if (mean < state.best_mean_run_secs) {
+        state.best_record_offset = offset;
+        state.best_mean_run_secs = mean;
+      }
+    }
+  }
+
+  ffi::Optional<TuningRecord> QueryTuningRecord(const IRModule& mod, const Target& target,
+                                                const ffi::String& workload_name) {
+    WorkloadLookup lookup = FindWorkload(mod);
+    if (lookup.workload_offset == 0 || lookup.best_record_offset == 0) {
+      return std::nullopt;
+    }
+    return DecodeRecordAt(lookup.best_record_offset, DecodeWorkloadAt(lookup.workload_offset));
+  }
+
+  ffi::Array<TuningRecord> GetTopK(const Workload& workload, int top_k) {
+    TVM_FFI_CHECK_GE(top_k, 0, ValueError) << "top_k must be non-negative";
+    if (top_k == 0) {
+      return {};
+    }
+    WorkloadLookup lookup = FindWorkload(workload->mod);
+    if (lookup.workload_offset == 0) {
+      return {};
+    }
+    if (top_k == 1) {
+      // The common case: the best record is served straight from the index.
+      if (lookup.best_record_offset == 0) {
+        return {};
+      }
+      return {DecodeRecordAt(lookup.best_record_offset, DecodeWorkloadAt(lookup.workload_offset))};
+    }
+    // The general case scans the entry headers of the whole log, then parses
+    // only the records that belong to the queried workload.
+    std::vector<std::pair<double, uint64_t>> candidates;
+    ScanEntries(sizeof(LogFileHeader), log_bytes_,
+                [&](uint64_t offset, const LogEntryHeader& header) {
+                  if (header.kind == kTuningRecordEntry && header.key == lookup.workload_offset &&
+                      header.mean_run_secs < SortTuningRecordByMeanRunSecs::kMaxMeanTime) {
+                    candidates.emplace_back(header.mean_run_secs, offset);
+                  }
+                });
+    std::sort(candidates.begin(), candidates.end());
+    if (candidates.size() > static_cast<size_t>(top_k)) {
+      candidates.resize(top_k);
+    }
+    Workload stored_workload = DecodeWorkloadAt(lookup.workload_offset);
+    ffi::Array<TuningRecord> results;
+    results.reserve(candidates.size());
+    for (const auto& [mean, offset] : candidates) {
+      results.push_back(DecodeRecordAt(offset, stored_workload));
+    }
+    return results;
+  }
+
+  ffi::Array<TuningRecord> GetAllTuningRecords() {
+    std::vector<TuningRecord> records;
+    records.reserve(num_records_);
+    ScanEntries(sizeof(LogFileHeader), log_bytes_,
+                [&](uint64_t offset, const LogEntryHeader& header) {
+                  if (header.kind == kTuningRecordEntry) {
+                    records.push_back(DecodeRecordAt(offset, DecodeWorkloadAt(header.key)));
+                  }
+                });
+    std::stable_sort(records.begin(), records.end(), SortTuningRecordByMeanRunSecs());
+    ffi::Array<TuningRecord> results;
+    results.reserve(records.size());
+    for (const TuningRecord& record : records) {
+      results.push_back(record);
+    }
+    return results;
+  }
+
+  int64_t Size() { return num_records_; }
+
+ private:
+  friend class Database;
+
+  /*! \brief The best record tracked for a workload beyond what the on-disk index covers. */
+  struct WorkloadState {
+    uint64_t best_record_offset = 0;
+    double best_mean_run_secs = SortTuningRecordByMeanRunSecs::kMaxMeanTime;
+  };
+
+  /*! \brief The result of looking up a workload, merged across the index and the tail. */
+  struct WorkloadLookup {
+    /*! \brief The byte offset of the workload entry, or zero if not found. */
+    uint64_t workload_offset = 0;
+    /*! \brief The byte offset of the best valid record, or zero if none. */
+    uint64_t best_record_offset = 0;
+    double best_mean_run_secs = SortTuningRecordByMeanRunSecs::kMaxMeanTime;
+  };
+
+  /*! \brief Open the record log, creating it when allowed, and validate its header. */
+  void OpenLog(bool allow_missing) {
+    std::ifstream is(std::string(path_log), std::ios::binary);
+    if (is.good()) {
+      LogFileHeader header;
+      is.read(reinterpret_cast<char*>(&header), sizeof(header));
+      TVM_FFI_CHECK(is.good() && header.magic == kBinaryLogMagic, ValueError)
+          << "Not a binary record log: " << path_log;
+      TVM_FFI_CHECK(header.version == kBinaryLogVersion, ValueError)
+          << "Unsupported binary record log version " << header.version << " in file: " << path_log;
+      is.seekg(0, std::ios::end);
+      log_bytes_ = static_cast<uint64_t>(is.tellg());
+      return;
+    }
+    TVM_FFI_CHECK(allow_missing, ValueError) << "File doesn't exist: " << path_log;
+    std::ofstream os(std::string(path_log), std::ios::binary);
+    TVM_FFI_CHECK(os.good(), ValueError) << "Cannot create new file: " << path_log;
+    LogFileHeader header{kBinaryLogMagic, kBinaryLogVersion, 0};
+    os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    TVM_FFI_CHECK(os.good(), ValueError) << "Cannot write to file: " << path_log;
+    log_bytes_ = sizeof(LogFileHeader);
+  }
+
+  /*! \brief Memory-map the index file if it exists and is consistent with the log. */
+  void LoadIndex() {
+    std::shared_ptr<support::MMapFile> mmap = support::MMapFile::Open(path_index_);
+    if (mmap == nullptr || mmap->size() < sizeof(IndexFileHeader)) {
+      return;
+    }
+    const IndexFileHeader* header = reinterpret_cast<const IndexFileHeader*>(mmap->data());
+    // A stale or foreign index is simply ignored; the log remains the source of
+    // truth and the index is rebuilt from it.
+    if (header->magic != kBinaryLogIndexMagic || header->log_bytes > log_bytes_ ||
+        header->num_slots == 0 || (header->num_slots & (header->num_slots - 1)) != 0 ||
+        mmap->size() != sizeof(IndexFileHeader) + header->num_slots * sizeof(IndexSlot)) {
+      return;
+    }
+    index_ = std::move(mmap);
+    num_records_ = header->num_records;
+  }
+
+  /*!
+   * \brief Visit the headers of all entries in `[begin, end)`, seeking over payloads.
+   * \param begin The byte offset of the first entry to visit.
+   * \param end The byte offset one past the last entry to visit.
+   * \param visit Callback invoked with the byte offset and header of each entry.
+   */
+  template <typename FVisit>
+  void ScanEntries(uint64_t begin, uint64_t end, FVisit visit) const {
+    std::ifstream is(std::string(path_log), std::ios::binary);
+    TVM_FFI_CHECK(is.good(), ValueError) << "Cannot open the file to read: " << path_log;
+    uint64_t offset = begin;
+    while (offset < end) {
+      is.seekg(offset);
+      LogEntryHeader header;
+      is.read(reinterpret_cast<char*>(&header), sizeof(header));
+      TVM_FFI_CHECK(is.good() && offset + sizeof(header) + header.payload_bytes <= end, ValueError)
+          << "Truncated entry at offset " << offset << " of file: " << path_log;
+      visit(offset, header);
+      offset += sizeof(header) + header.payload_bytes;
+    }
+  }
+
+  /*!
+   * \brief Register the entries the on-disk index does not cover.
+   * \param begin The byte offset where the uncovered tail of the log starts.
+   */
+  void ScanTail(uint64_t begin) {
+    ScanEntries(begin, log_bytes_, [&](uint64_t offset, const LogEntryHeader& header) {
+      if (header.kind == kWorkloadEntry) {
+        tail_workloads_.emplace(header.key, offset);
+      } else if (header.kind == kTuningRecordEntry) {
+        ++num_records_;
+        if (header.mean_run_secs < SortTuningRecordByMeanRunSecs::kMaxMeanTime) {
+          WorkloadState& state = tail_states_[header.key];
+          if (header.mean_run_secs < state.best_mean_run_secs) {
+            state.best_record_offset = offset;
+            state.best_mean_run_secs = header.mean_run_secs;
+          }
+        }
+      } else {
+        TVM_FFI_THROW(ValueError) << "Unknown entry kind " << header.kind << " at offset " << offset
+                                  << " of file: " << path_log;
+      }
+    });
+  }
+
+  /*! \brief Rewrite the index file to cover the whole log and re-map it. */
+  void WriteIndex() {
+    // Merge the slots of the old index with the workloads and records scanned
+    // from the tail of the log.
+    std::unordered_map<uint64_t, IndexSlot> states;
+    if (index_ != nullptr) {
+      const IndexFileHeader* header = reinterpret_cast<const IndexFileHeader*>(index_->data());
+      const IndexSlot* slots =
+          reinterpret_cast<const IndexSlot*>(index_->data() + sizeof(IndexFileHeader));
+      for (uint64_t i = 0; i < header->num_slots; ++i) {
+        if (slots[i].workload_offset != 0) {
+          states.emplace(slots[i].workload_offset, slots[i]);
+        }
+      }
+    }
+    for (const auto& [shash, offset] : tail_workloads_) {
+      states.emplace(offset, IndexSlot{shash, offset, /*best_record_offset=*/0,
+                                       SortTuningRecordByMeanRunSecs::kMaxMeanTime});
+    }
+    for (const auto& [offset, state] : tail_states_) {
+      auto it = states.find(offset);
+      TVM_FFI_ICHECK(it != states.end())
+          << "Tuning record refers to an unknown workload entry at offset " << offset;
+      if (state.best_mean_run_secs < it->second.best_mean_run_secs) {
+        it->second.best_record_offset = state.best_record_offset;
+        it->second.best_mean_run_secs = state.best_mean_run_secs;
+      }
+    }
+    uint64_t num_slots = 16;
+    while (num_slots < states.size() * 2) {
+      num_slots <<= 1;
+    }
+    std::vector<IndexSlot> slots(num_slots, IndexSlot{0, 0, 0, 0.0});
+    uint64_t mask = num_slots - 1;
+    for (const auto& [offset, state] : states) {
+      uint64_t i = state.shash & mask;
+      while (slots[i].workload_offset != 0) {
+        i = (i + 1) & mask;
+      }
+      slots[i] = state;
+    }
+    // Write to a temporary file and rename, so a concurrent reader never maps a
+    // half-written index.
+    std::string path_tmp = path_index_ + ".tmp";
+    {
+      std::ofstream os(path_tmp, std::ios::binary);
+      if (!os.good()) {
+        LOG(WARNING) << "Cannot write the database index file: " << path_index_;
+        return;
+      }
+      IndexFileHeader header{kBinaryLogIndexMagic, log_bytes_, static_cast<uint64_t>(num_records_),
+                             num_slots};
+      os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+      os.write(reinterpret_cast<const char*>(slots.data()), slots.size() * sizeof(IndexSlot));
+      if (!os.good()) {
+        LOG(WARNING) << "Cannot write the database index file: " << path_index_;
+        return;
+      }
+    }
+    if (std::rename(path_tmp.c_str(), path_index_.c_str()) != 0) {
+      LOG(WARNING) << "Cannot replace the database index file: " << path_index_;
+      return;
+    }
+    if (std::shared_ptr<support::MMapFile> mmap = support::MMapFile::Open(path_index_)) {
+      index_ = std::move(mmap);
+      tail_workloads_.clear();
+      tail_states_.clear();
+    }
+  }
+
+  /*!
+   * \brief Look up the workload entry matching the given module.
+   *
+   * The structural hash narrows the search to a handful of candidate offsets;
+   * only those candidates are parsed and compared structurally, so a hash
+   * collision can never produce a wrong hit. The returned best record already
+   * merges the on-disk index with records committed since it was written.
+   */
+  WorkloadLookup FindWorkload(const IRModule& mod) {
+    uint64_t shash = GetModuleEquality().Hash(mod);
+    WorkloadLookup result;
+    if (index_ != nullptr) {
+      const IndexFileHeader* header = reinterpret_cast<const IndexFileHeader*>(index_->data());
+      const IndexSlot* slots =
+          reinterpret_cast<const IndexSlot*>(index_->data() + sizeof(IndexFileHeader));
+      uint64_t mask = header->num_slots - 1;
+      for (uint64_t i = shash & mask, probes = 0; probes < header->num_slots;
+           ++probes, i = (i + 1) & mask) {
+        const IndexSlot& slot = slots[i];
+        if (slot.workload_offset == 0) {
+          break;
+        }
+        if (slot.shash != shash) {
+          continue;
+        }
+        Workload candidate = DecodeWorkloadAt(slot.workload_offset);
+        if (GetModuleEquality().Equal(candidate->mod, mod)) {
+          result.workload_offset = slot.workload_offset;
+          result.best_record_offset = slot.best_record_offset;
+          result.best_mean_run_secs = slot.best_mean_run_secs;
+          break;
+        }
+      }
+    }
+    if (result.workload_offset == 0) {
+      auto range = tail_workloads_.equal_range(shash);
+      for (auto it = range.first; it != range.second; ++it) {
+        Workload candidate = DecodeWorkloadAt(it->second);
+        if (GetModuleEquality().Equal(candidate->mod, mod)) {
+          result.workload_offset = it->second;
+          break;
+        }
+      }
+    }
+    if (result.workload_offset != 0) {
+      auto it = tail_states_.find(result.workload_offset);
+      if (it != tail_states_.end() &&
+          it->second.best_mean_run_secs < result.best_mean_run_secs) {
+        result.best_record_offset = it->second.best_record_offset;
+        result.best_mean_run_secs = it->second.best_mean_run_secs;
+      }
+    }
+    return result;
+  }
+
+  /*! \brief Read the header and payload of the entry at the given byte offset. */
+  std::string ReadPayloadAt(uint64_t offset, LogEntryHeader* header) const {
+    std::ifstream is(std::string(path_log), std::ios::binary);
+    TVM_FFI_CHECK(is.good(), ValueError) << "Cannot open the file to read: " << path_log;
+    is.seekg(offset);
+    is.read(reinterpret_cast<char*>(header), sizeof(*header));
+    TVM_FFI_CHECK(is.good(), ValueError)
+        << "Truncated entry at offset " << offset << " of file: " << path_log;
+    std::string payload(header->payload_bytes, '\0');
+    is.read(payload.data(), payload.size());
+    TVM_FFI_CHECK(is.good(), ValueError)
+        << "Truncated entry at offset " << offset << " of file: " << path_log;
+    return payload;
+  }
+
+  /*! \brief Parse the workload entry at the given byte offset, with caching. */
+  Workload DecodeWorkloadAt(uint64_t offset) {
+    auto cached = decoded_workloads_.find(offset);
+    if (cached != decoded_workloads_.end()) {
+      return cached->second;
+    }
+    LogEntryHeader header;
+    std::string payload = ReadPayloadAt(offset, &header);
+    TVM_FFI_CHECK_EQ(header.kind, static_cast<uint32_t>(kWorkloadEntry), ValueError)
+        << "Expected a workload entry at offset " << offset << " of file: " << path_log;
+    Workload workload = Workload::FromJSON(JSONLoads(payload).cast<ffi::ObjectRef>());
+    auto recalc_hash = GetModuleEquality().Hash(workload->mod);
+    // Todo(tvm-team): re-enable the shash check when we get environment
+    // independent structural hash values.
+    if (recalc_hash != workload->shash) {
+      ffi::ObjectPtr<WorkloadNode> wkl = ffi::make_object<WorkloadNode>(*workload.get());
+      wkl->shash = recalc_hash;
+      workload = Workload(wkl);
+    }
+    decoded_workloads_.emplace(offset, workload);
+    return workload;
+  }
+
+  /*! \brief Parse the tuning record entry at the given byte offset. */
+  TuningRecord DecodeRecordAt(uint64_t offset, const Workload& workload) const {
+    LogEntryHeader header;
+    std::string payload = ReadPayloadAt(offset, &header);
+    TVM_FFI_CHECK_EQ(header.kind, static_cast<uint32_t>(kTuningRecordEntry), ValueError)
+        << "Expected a tuning record entry at offset " << offset << " of file: " << path_log;
+    return TuningRecord::FromJSON(JSONLoads(payload).cast<ffi::ObjectRef>(), workload);
+  }
+
+  /*! \brief Append an entry to the log and return its byte offset. */
+  uint64_t AppendEntry(LogEntryKind kind, uint64_t key, double mean_run_secs,
+                       const std::string& payload) {
+    std::ofstream os(std::string(path_log), std::ios::binary | std::ios::app);
+    TVM_FFI_CHECK(os.good(), ValueError) << "Cannot open the file to write: " << path_log;
+    LogEntryHeader header{static_cast<uint32_t>(kind), 0, payload.size(), key, mean_run_secs};
+    os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    os.write(payload.data(), payload.size());
+    TVM_FFI_CHECK(os.good(), ValueError) << "Cannot write to file: " << path_log;
+    uint64_t offset = log_bytes_;
+    log_bytes_ += sizeof(header) + payload.size();
+    return offset;
+  }
+
+  /*! \brief The path to the index file, `path_log` + ".idx". */
+  std::string path_index_;
+  /*! \brief The mapped index file; nullptr when absent or unsupported. */
+  std::shared_ptr<support::MMapFile> index_;
+  /*! \brief Workloads appended after the index was written: shash -> workload offset. */
+  std::unordered_multimap<uint64_t, uint64_t> tail_workloads_;
+  /*! \brief Best records appended after the index was written, per workload offset. */
+  std::unordered_map<uint64_t, WorkloadState> tail_states_;
+  /*! \brief Workloads parsed so far, keyed by their offset in the log. */
+  std::unordered_map<uint64_t, Workload> decoded_workloads_;
+  /*! \brief The current size of the log file in bytes. */
+  uint64_t log_bytes_ = 0;
+  /*! \brief The total number of tuning records in the log. */
+  int64_t num_records_ = 0;
+};
+
+Database Database::BinaryLogDatabase(ffi::String path_log, bool allow_missing,
+                                     ffi::String mod_eq_name) {
+  ffi::ObjectPtr<BinaryLogDatabaseNode> n = ffi::make_object<BinaryLogDatabaseNode>(mod_eq_name);
+  n->path_log = path_log;
+  n->path_index_ = std::string(path_log) + ".idx";
+  n->OpenLog(allow_missing);
+  n->LoadIndex();
+  uint64_t covered = sizeof(LogFileHeader);
+  if (n->index_ != nullptr) {
+    covered = reinterpret_cast<const IndexFileHeader*>(n->index_->data())->log_bytes;
+  }
+  n->ScanTail(covered);
+  // Refresh the index whenever the log has outgrown it, so the next open only
+  // pays for the mmap instead of a scan.
+  if (covered < n->log_bytes_) {
+    n->WriteIndex();
+  }
+  return Database(n);
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() { BinaryLogDatabaseNode::RegisterReflection(); }
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("s_tir.meta_schedule.DatabaseBinaryLogDatabase",
+                        Database::BinaryLogDatabase);
+}
+
+}  // namespace meta_schedule
+}  // namespace s_tir
+}  // namespace tvm
@@ -22,6 +22,7 @@
 #include <tvm/tirx/transform.h>
 
 #include <cmath>
+#include <cstring>
 #include <memory>
 #include <numeric>
 #include <string>
@@ -1395,6 +1396,9 @@ class PerStoreFeatureNode : public FeatureExtractorNode {
     for (int i = 0; i < n_features; ++i) {
       const s_tir::Feature& feature = features[i];
       std::vector<double>& result = (*results)[i];
+      // The result rows may be reused thread-local buffers; clearing keeps
+      // their capacity so repeated extraction does not reallocate.
+      result.clear();
       result.reserve(feature_vector_length);
       feature.group1->Export(&result);
       feature.group2->Export(&result, this->buffers_per_store);
@@ -1416,7 +1420,7 @@ class PerStoreFeatureNode : public FeatureExtractorNode {
     }
     auto f = [this, is_gpu, &feature_group6, &candidates, &results](int, int task_id) -> void {
       const auto& candidate = candidates[task_id];
-      std::vector<std::vector<double>> features;
+      static thread_local std::vector<std::vector<double>> features;
       ExtractSingle(DeepCopyIRModule(candidate->sch->mod()), is_gpu, &features);
       if (extract_workload) {
         for (auto& feature : features) {
@@ -1428,6 +1432,76 @@ class PerStoreFeatureNode : public FeatureExtractorNode {
     support::parallel_for_dynamic(0, candidates.size(), tune_context->num_threads, f);
     return results;
   }
+
+  /*!
+   * \brief Extract features of all candidates into one contiguous matrix.
+   *
+   * Unlike `ExtractFrom`, which allocates one tensor per candidate, this
+   * path emits the per-store rows of all candidates back to back, so the
+   * cost model can consume a single matrix without stacking.
+   *
+   * \param tune_context The tuning context.
+   * \param candidates The measure candidates to extract features from.
+   * \return A pair of tensors: a (total_rows, feature_vector_length) float64
+   *  matrix of all rows, and an int64 row pointer of length
+   *  num_candidates + 1, where candidate i owns rows
+   *  [row_ptr[i], row_ptr[i + 1]).
+   */
+  ffi::Array<runtime::Tensor> ExtractFromBatched(const TuneContext& tune_context,
+                                                 const ffi::Array<MeasureCandidate>& candidates) {
+    auto& target_keys = tune_context->target.value()->keys;
+    bool is_gpu = std::find(target_keys.begin(), target_keys.end(), "gpu") != target_keys.end();
+    int num_candidates = candidates.size();
+    std::unique_ptr<s_tir::group6::Feature> feature_group6 = nullptr;
+    if (extract_workload) {
+      feature_group6 = std::make_unique<s_tir::group6::Feature>(tune_context->mod.value());
+    }
+    // Phase 1: extract into one flat buffer per candidate, reusing a
+    // thread-local scratch for the per-store rows.
+    std::vector<std::vector<double>> flattened(num_candidates);
+    auto extract = [this, is_gpu, &feature_group6, &candidates, &flattened](int,
+                                                                            int task_id) -> void {
+      const auto& candidate = candidates[task_id];
+      static thread_local std::vector<std::vector<double>> features;
+      ExtractSingle(DeepCopyIRModule(candidate->sch->mod()), is_gpu, &features);
+      if (extract_workload) {
+        for (auto& feature : features) {
+          feature_group6->Export(&feature);
+        }
+      }
+      std::vector<double>& flat = flattened[task_id];
+      flat.reserve(features.size() * this->feature_vector_length);
+      for (const std::vector<double>& feature : features) {
+        TVM_FFI_ICHECK_EQ(static_cast<int>(feature.size()), this->feature_vector_length);
+        flat.insert(flat.end(), feature.begin(), feature.end());
+      }
+    };
+    support::parallel_for_dynamic(0, num_candidates, tune_context->num_threads, extract);
+    // Phase 2: compute the row ranges and gather everything into one matrix.
+    runtime::Tensor row_ptr = runtime::Tensor::Empty(
+        /*shape=*/{num_candidates + 1},
+        /*dtype=*/DLDataType{kDLInt, 64, 1},
+        /*ctx=*/DLDevice{kDLCPU, 0});
+    int64_t* p_row_ptr = static_cast<int64_t*>(row_ptr->data);
+    int64_t total_rows = 0;
+    p_row_ptr[0] = 0;
+    for (int i = 0; i < num_candidates; ++i) {
+      total_rows += static_cast<int64_t>(flattened[i].size()) / this->feature_vector_length;
+      p_row_ptr[i + 1] = total_rows;
+    }
+    runtime::Tensor features_matrix = runtime::Tensor::Empty(
+        /*shape=*/{total_rows, this->feature_vector_length},
+        /*dtype=*/DLDataType{kDLFloat, 64, 1},
+        /*ctx=*/DLDevice{kDLCPU, 0});
+    double* p_features = static_cast<double*>(features_matrix->data);
+    auto gather = [this, &flattened, p_row_ptr, p_features](int, int task_id) -> void {
+      const std::vector<double>& flat = flattened[task_id];
+      std::memcpy(p_features + p_row_ptr[task_id] * this->feature_vector_length, flat.data(),
+                  flat.size() * sizeof(double));
+    };
+    support::parallel_for_dynamic(0, num_candidates, tune_context->num_threads, gather);
+    return {features_matrix, row_ptr};
+  }
   TVM_FFI_DECLARE_OBJECT_INFO_FINAL("s_tir.meta_schedule.PerStoreFeature", PerStoreFeatureNode,
                                     FeatureExtractorNode);
 };
@@ -1455,8 +1529,11 @@ TVM_FFI_STATIC_INIT_BLOCK() { PerStoreFeatureNode::RegisterReflection(); }
 
 TVM_FFI_STATIC_INIT_BLOCK() {
   namespace refl = tvm::ffi::reflection;
-  refl::GlobalDef().def("s_tir.meta_schedule.FeatureExtractorPerStoreFeature",
-                        FeatureExtractor::PerStoreFeature);
+  refl::GlobalDef()
+      .def("s_tir.meta_schedule.FeatureExtractorPerStoreFeature",
+           FeatureExtractor::PerStoreFeature)
+      .def_method("s_tir.meta_schedule.FeatureExtractorPerStoreFeatureExtractFromBatched",
+                  &PerStoreFeatureNode::ExtractFromBatched);
 }
 
 }  // namespace meta_schedule
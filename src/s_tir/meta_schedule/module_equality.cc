@@ -24,30 +24,110 @@
 #include <tvm/ir/module.h>
 #include <tvm/tirx/analysis.h>
 
+#include <list>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
 
 namespace tvm {
 namespace s_tir {
 namespace meta_schedule {
 
+/*!
+ * \brief Identity-keyed memo table for structural hashes.
+ *
+ * Database lookups hash the same workload modules over and over, and every
+ * hash re-traverses the whole module. Since IR objects are immutable, the
+ * structural hash of an object can be memoized by its address; the memo holds
+ * a strong reference to each key so the address cannot be freed and reused by
+ * a different object. Cached hashes also give equality two fast paths: two
+ * references to the same object are equal without a traversal, and objects
+ * whose cached hashes differ cannot be equal.
+ *
+ * The memo is bounded; once full, the oldest entries are dropped first.
+ */
+class StructuralHashMemo {
+ public:
+  explicit StructuralHashMemo(bool skip_tensor_content)
+      : skip_tensor_content_(skip_tensor_content) {}
+
+  size_t Hash(const ffi::ObjectRef& obj) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (auto it = lookup_.find(obj.get()); it != lookup_.end()) {
+        return it->second->hash;
+      }
+    }
+    size_t hash = tvm::ffi::StructuralHash::Hash(obj, /*map_free_vars=*/false,
+                                                 skip_tensor_content_);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!lookup_.count(obj.get())) {
+      entries_.push_front(Entry{obj, hash});
+      lookup_[obj.get()] = entries_.begin();
+      while (entries_.size() > kCapacity) {
+        lookup_.erase(entries_.back().key.get());
+        entries_.pop_back();
+      }
+    }
+    return hash;
+  }
+
+  /*! \brief Return the cached hash, without computing it on a miss. */
+  std::optional<size_t> TryGetHash(const ffi::ObjectRef& obj) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (auto it = lookup_.find(obj.get()); it != lookup_.end()) {
+      return it->second->hash;
+    }
+    return std::nullopt;
+  }
+
+  bool Equal(const ffi::ObjectRef& lhs, const ffi::ObjectRef& rhs) {
+    if (lhs.same_as(rhs)) {
+      return true;
+    }
+    auto lhs_hash = TryGetHash(lhs);
+    auto rhs_hash = TryGetHash(rhs);
+    if (lhs_hash && rhs_hash && lhs_hash.value() != rhs_hash.value()) {
+      return false;
+    }
+    return tvm::ffi::StructuralEqual::Equal(lhs, rhs, /*map_free_vars=*/false,
+                                            skip_tensor_content_);
+  }
+
+ private:
+  struct Entry {
+    ffi::ObjectRef key;
+    size_t hash;
+  };
+
+  static constexpr size_t kCapacity = 1024;
+
+  bool skip_tensor_content_;
+  std::mutex mutex_;
+  std::list<Entry> entries_;  // newest at front
+  std::unordered_map<const ffi::Object*, std::list<Entry>::iterator> lookup_;
+};
+
 class ModuleEqualityStructural : public ModuleEquality {
  public:
-  size_t Hash(IRModule mod) const { return ffi::StructuralHash()(mod); }
-  bool Equal(IRModule lhs, IRModule rhs) const { return ffi::StructuralEqual()(lhs, rhs); }
+  size_t Hash(IRModule mod) const { return memo_.Hash(mod); }
+  bool Equal(IRModule lhs, IRModule rhs) const { return memo_.Equal(lhs, rhs); }
   ffi::String GetName() const { return "structural"; }
+
+ private:
+  mutable StructuralHashMemo memo_{/*skip_tensor_content=*/false};
 };
 
 class ModuleEqualityIgnoreTensor : public ModuleEquality {
  public:
-  size_t Hash(IRModule mod) const {
-    return tvm::ffi::StructuralHash::Hash(mod, /*map_free_vars=*/false,
-                                          /*skip_tensor_content=*/true);
-  }
-  bool Equal(IRModule lhs, IRModule rhs) const {
-    return tvm::ffi::StructuralEqual::Equal(lhs, rhs, /*map_free_vars=*/false,
-                                            /*skip_tensor_content=*/true);
-  }
+  size_t Hash(IRModule mod) const { return memo_.Hash(mod); }
+  bool Equal(IRModule lhs, IRModule rhs) const { return memo_.Equal(lhs, rhs); }
   ffi::String GetName() const { return "ignore-tensor"; }
+
+ private:
+  mutable StructuralHashMemo memo_{/*skip_tensor_content=*/true};
 };
 
 // The Tensor-ignoring variant of structural equal / hash is used for the module equality
@@ -56,24 +136,24 @@ class ModuleEqualityAnchorBlock : public ModuleEquality {
   size_t Hash(IRModule mod) const {
     auto anchor_block = tirx::FindAnchorBlock(mod);
     if (anchor_block) {
-      return ffi::StructuralHash::Hash(ffi::GetRef<tirx::SBlock>(anchor_block),
-                                       /*map_free_vars=*/false,
-                                       /*skip_tensor_content=*/true);
+      return memo_.Hash(ffi::GetRef<tirx::SBlock>(anchor_block));
     }
-    return ModuleEqualityIgnoreTensor().Hash(mod);
+    return fallback_.Hash(mod);
   }
   bool Equal(IRModule lhs, IRModule rhs) const {
     auto anchor_block_lhs = tirx::FindAnchorBlock(lhs);
     auto anchor_block_rhs = tirx::FindAnchorBlock(rhs);
     if (anchor_block_lhs && anchor_block_rhs) {
-      return tvm::ffi::StructuralEqual::Equal(ffi::GetRef<tirx::SBlock>(anchor_block_lhs),
-                                              ffi::GetRef<tirx::SBlock>(anchor_block_rhs),
-                                              /*map_free_vars=*/false,
-                                              /*skip_tensor_content=*/true);
+      return memo_.Equal(ffi::GetRef<tirx::SBlock>(anchor_block_lhs),
+                         ffi::GetRef<tirx::SBlock>(anchor_block_rhs));
     }
-    return ModuleEqualityIgnoreTensor().Equal(lhs, rhs);
+    return fallback_.Equal(lhs, rhs);
   }
   ffi::String GetName() const { return "anchor-block"; }
+
+  mutable StructuralHashMemo memo_{/*skip_tensor_content=*/true};
+  // Keeping the fallback as a member lets its memo persist across calls.
+  ModuleEqualityIgnoreTensor fallback_;
 };
 
 std::unique_ptr<ModuleEquality> ModuleEquality::Create(const std::string& mod_eq_name) {
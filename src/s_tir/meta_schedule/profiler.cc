@@ -37,6 +37,14 @@ ffi::Map<ffi::String, FloatImm> ProfilerNode::Get() const {
   return ret;
 }
 
+ffi::Map<ffi::String, IntImm> ProfilerNode::GetCounters() const {
+  ffi::Map<ffi::String, IntImm> ret;
+  for (const auto& kv : counters) {
+    ret.Set(kv.first, IntImm::Int64(kv.second));
+  }
+  return ret;
+}
+
 ffi::String ProfilerNode::Table() const {
   TVM_FFI_CHECK(!stats_sec.empty(), ValueError)
       << "The stats are empty. Please run the profiler first.";
@@ -95,6 +103,12 @@ ffi::Function ProfilerTimedScope(ffi::String name) {
 
 ScopedTimer Profiler::TimedScope(ffi::String name) { return ScopedTimer(ProfilerTimedScope(name)); }
 
+void Profiler::IncCounter(const ffi::String& name, int64_t delta) {
+  if (ffi::Optional<Profiler> opt_profiler = Profiler::Current()) {
+    (*opt_profiler)->counters[name] += delta;
+  }
+}
+
 /**************** Context Manager ****************/
 
 std::vector<Profiler>* ThreadLocalProfilers() {
@@ -134,8 +148,10 @@ TVM_FFI_STATIC_INIT_BLOCK() {
       .def_method("s_tir.meta_schedule.ProfilerExitWithScope", &Profiler::ExitWithScope)
       .def("s_tir.meta_schedule.ProfilerCurrent", Profiler::Current)
       .def_method("s_tir.meta_schedule.ProfilerGet", &ProfilerNode::Get)
+      .def_method("s_tir.meta_schedule.ProfilerGetCounters", &ProfilerNode::GetCounters)
       .def_method("s_tir.meta_schedule.ProfilerTable", &ProfilerNode::Table)
-      .def("s_tir.meta_schedule.ProfilerTimedScope", ProfilerTimedScope);
+      .def("s_tir.meta_schedule.ProfilerTimedScope", ProfilerTimedScope)
+      .def("s_tir.meta_schedule.ProfilerIncCounter", Profiler::IncCounter);
 }
 
 }  // namespace meta_schedule
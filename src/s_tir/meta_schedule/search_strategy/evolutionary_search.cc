@@ -20,6 +20,7 @@
 #include <tvm/ffi/cast.h>
 #include <tvm/ffi/reflection/registry.h>
 
+#include <atomic>
 #include <mutex>
 
 #include "../module_equality.h"
@@ -210,8 +211,84 @@ struct ConcurrentBitmask {
   }
 };
 
+/*!
+ * \brief A concurrent Bloom filter over trace fingerprints.
+ *
+ * The filter persists across search rounds, so a candidate whose normalized trace was already
+ * proposed in any earlier round is rejected before it reaches post-processing, the cost model or
+ * the builder. A false positive only drops a fresh candidate and never corrupts the search, so
+ * the filter can stay compact.
+ */
+class TraceBloomFilter {
+ public:
+  /*! \brief The number of bits derived from each fingerprint. */
+  static constexpr const int kNumHashes = 3;
+
+  /*!
+   * \brief Constructor
+   * \param num_bits The size of the filter in bits, rounded up to a power of two.
+   */
+  explicit TraceBloomFilter(size_t num_bits) {
+    size_t n = 64;
+    while (n < num_bits) {
+      n <<= 1;
+    }
+    mask_ = n - 1;
+    words_ = std::vector<std::atomic<uint64_t>>(n / 64);
+  }
+
+  /*!
+   * \brief Query and mark the given fingerprint if not seen before.
+   * \param fingerprint The fingerprint of the normalized trace.
+   * \return Whether the fingerprint has not been seen before.
+   */
+  bool QueryAndMark(uint64_t fingerprint) {
+    constexpr uint64_t one = 1;
+    uint64_t h = fingerprint;
+    bool unseen = false;
+    for (int i = 0; i < kNumHashes; ++i) {
+      // splitmix64 to derive independent probe positions from the fingerprint
+      h += 0x9E3779B97F4A7C15;
+      uint64_t z = h;
+      z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+      z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+      z = z ^ (z >> 31);
+      uint64_t bit = z & mask_;
+      uint64_t old = words_[bit / 64].fetch_or(one << (bit % 64), std::memory_order_relaxed);
+      if (!(old & (one << (bit % 64)))) {
+        unseen = true;
+      }
+    }
+    if (!unseen) {
+      num_rejected_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return unseen;
+  }
+
+  /*! \return The total number of fingerprints rejected as duplicates. */
+  int64_t NumRejected() const { return num_rejected_.load(std::memory_order_relaxed); }
+
+ private:
+  /*! \brief The bitmask to map a probe position into the filter. */
+  uint64_t mask_;
+  /*! \brief The bits of the filter. */
+  std::vector<std::atomic<uint64_t>> words_;
+  /*! \brief The number of fingerprints rejected as duplicates. */
+  std::atomic<int64_t> num_rejected_{0};
+};
+
 /**************** Util Functions ****************/
 
+/*!
+ * \brief Compute the fingerprint of a trace, invariant to dead instructions and postprocessing.
+ * \param trace The trace to fingerprint.
+ * \return The fingerprint of the normalized trace, including its decisions.
+ */
+uint64_t TraceFingerprint(const s_tir::Trace& trace) {
+  return std::hash<std::string>()(
+      JSONDumps(trace->Simplified(/*remove_postproc=*/true)->AsJSON(/*remove_postproc=*/true)));
+}
+
 /*!
  * \brief Assemble measure candidates from the given candidate traces.
  * \param traces The picked candidate traces.
@@ -281,6 +358,12 @@ class EvolutionarySearchNode : public SearchStrategyNode {
     CostModel cost_model_{ffi::UnsafeInit()};
     /*! \brief The token registered for the given workload in database. */
     Workload token_{ffi::UnsafeInit()};
+    /*!
+     * \brief The fingerprints of all traces proposed so far, kept across rounds so that
+     * semantically identical mutants are not post-processed, scored or built twice.
+     * 8M bits = 1 MB; the false positive rate stays negligible for realistic trial counts.
+     */
+    TraceBloomFilter trace_filter_{size_t(1) << 23};
 
     explicit State(EvolutionarySearchNode* self, int max_trials, int num_trials_per_iter,
                    ffi::Array<Schedule> design_space_schedules, Database database,
@@ -498,6 +581,8 @@ std::vector<Schedule> EvolutionarySearchNode::State::PickBestFromDatabase(int nu
     Schedule& result = results.at(trace_id);
     TVM_FFI_ICHECK(!result.defined());
     if (ffi::Optional<Schedule> sch = pp.Apply(mod, trace, rand_state)) {
+      // Mark the measured traces so the mutation loop does not re-propose them.
+      this->trace_filter_.QueryAndMark(TraceFingerprint(sch.value()->trace().value()));
       result = sch.value();
     }
   };
@@ -536,7 +621,10 @@ std::vector<Schedule> EvolutionarySearchNode::State::SampleInitPopulation(int nu
       int design_space_index = s_tir::SampleInt(rand_state, 0, design_spaces.size());
       s_tir::Trace trace(design_spaces[design_space_index]->insts, {});
       if (ffi::Optional<Schedule> sch = pp.Apply(mod, trace, rand_state)) {
-        result = sch.value();
+        // Drop samples whose normalized trace was already proposed in an earlier round.
+        if (this->trace_filter_.QueryAndMark(TraceFingerprint(sch.value()->trace().value()))) {
+          result = sch.value();
+        }
       }
     };
     support::parallel_for_dynamic(0, num, self->ctx_->num_threads, f_proc_unmeasured);
@@ -621,6 +709,12 @@ std::vector<Schedule> EvolutionarySearchNode::State::EvolveWithCostModel(
             // Decision: mutate
             Mutator mutator = opt_mutator.value();
             if (ffi::Optional<s_tir::Trace> new_trace = mutator->Apply(trace, rand_state)) {
+              if (!this->trace_filter_.QueryAndMark(TraceFingerprint(new_trace.value()))) {
+                // Semantically identical to a candidate proposed before; retry with
+                // another sample or mutator before spending post-processing and
+                // cost-model time on it.
+                continue;
+              }
               if (ffi::Optional<Schedule> sch = pp.Apply(mod, new_trace.value(), rand_state)) {
                 // note that sch's trace is different from new_trace
                 // because it contains post-processing information
@@ -642,8 +736,10 @@ std::vector<Schedule> EvolutionarySearchNode::State::EvolveWithCostModel(
                                     f_find_candidate);
 
       population.swap(next_population);
-      TVM_PY_LOG(INFO, self->ctx_->logger) << "Evolve iter #" << iter << " done. Summary:\n"
-                                           << pp.SummarizeFailures();
+      TVM_PY_LOG(INFO, self->ctx_->logger)
+          << "Evolve iter #" << iter << " done. Duplicates rejected so far: "
+          << this->trace_filter_.NumRejected() << ". Summary:\n"
+          << pp.SummarizeFailures();
     }
   }
   // Return the best states from the heap, sorting from higher score to lower ones
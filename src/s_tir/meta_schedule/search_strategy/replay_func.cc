@@ -18,6 +18,10 @@
  */
 #include <tvm/ffi/reflection/registry.h>
 
+#include <mutex>
+#include <numeric>
+#include <vector>
+
 #include "../utils.h"
 
 namespace tvm {
@@ -58,6 +62,8 @@ class ReplayFuncNode : public SearchStrategyNode {
   TRandState rand_state_ = -1;
   /*! \brief The IRModule to be scheduled from TuneContext. */
   ffi::Optional<IRModule> mod_ = std::nullopt;
+  /*! \brief The number of threads to be used. */
+  int num_threads_ = -1;
   /*! \brief The space generator from TuneContext. */
   ffi::Optional<SpaceGenerator> space_generator_ = std::nullopt;
   /*! \brief The state of the search strategy. */
@@ -82,6 +88,7 @@ class ReplayFuncNode : public SearchStrategyNode {
     }
     this->rand_state_ = ForkSeed(&ctx->rand_state);
     this->mod_ = ctx->mod;
+    this->num_threads_ = ctx->num_threads;
     this->space_generator_ = ctx->space_generator;
     this->state_.reset();
   }
@@ -129,28 +136,60 @@ ReplayFuncNode::State::GenerateMeasureCandidates() {
     return std::nullopt;
   }
   ed = std::min(ed, max_trials);
-  ffi::Array<MeasureCandidate> result;
+  int num_slots = ed - st;
   IRModule mod = self->mod_.value();
   ffi::Array<Postproc> postprocs = self->space_generator_.value()->postprocs.value_or({});
-  for (int i = st; i < ed; i++) {
-    for (;;) {
+  ffi::Array<ffi::Optional<MeasureCandidate>> per_slot_result(num_slots, std::nullopt);
+  std::vector<int> unfilled(num_slots);
+  std::iota(unfilled.begin(), unfilled.end(), 0);
+  while (!unfilled.empty()) {
+    // Phase 1: pick one fresh schedule per unfilled slot. Design space generation mutates
+    // the space generator's random state and may call user-defined schedule rules, so it
+    // stays on this thread.
+    std::vector<s_tir::Schedule> picks;
+    picks.reserve(unfilled.size());
+    for (size_t i = 0; i < unfilled.size(); ++i) {
       ffi::Array<s_tir::Schedule> schs = self->space_generator_.value()->GenerateDesignSpace(mod);
       int design_space_index = s_tir::SampleInt(&self->rand_state_, 0, schs.size());
-      s_tir::Schedule sch = schs[design_space_index];
-      sch->EnterPostproc();
+      picks.push_back(schs[design_space_index]);
+    }
+    // Phase 2: postprocessors are pure per candidate, so the batch is verified on the
+    // thread pool, bailing out of a candidate on its first disqualifying postproc.
+    // Failed slots are collected and retried with fresh schedules in the next round.
+    std::vector<int> retry;
+    std::mutex retry_mutex;
+    auto f_worker = [this, &postprocs, &per_slot_result, &unfilled, &picks, &retry,
+                     &retry_mutex](int, int task_id) -> void {
+      const s_tir::Schedule& sch = picks[task_id];
       bool failed = false;
-      for (const Postproc& proc : postprocs) {
-        if (!proc->Apply(sch)) {
-          failed = true;
-          break;
+      try {
+        sch->EnterPostproc();
+        for (const Postproc& proc : postprocs) {
+          if (!proc->Apply(sch)) {
+            failed = true;
+            break;
+          }
         }
+      } catch (const std::exception& e) {
+        DLOG(WARNING) << "Postprocessing failed with exception: " << e.what();
+        failed = true;
       }
-      if (!failed) {
-        ffi::Array<ArgInfo> args_info = ArgInfo::FromEntryFunc(sch->mod(), /*remove_preproc=*/true);
-        result.push_back(MeasureCandidate(sch, args_info));
-        break;
+      if (failed) {
+        std::lock_guard<std::mutex> lock(retry_mutex);
+        retry.push_back(unfilled[task_id]);
+        return;
       }
-    }
+      ffi::Array<ArgInfo> args_info = ArgInfo::FromEntryFunc(sch->mod(), /*remove_preproc=*/true);
+      per_slot_result.Set(unfilled[task_id], MeasureCandidate(sch, args_info));
+    };
+    support::parallel_for_dynamic(0, static_cast<int>(picks.size()), self->num_threads_, f_worker);
+    std::sort(retry.begin(), retry.end());
+    unfilled = std::move(retry);
+  }
+  ffi::Array<MeasureCandidate> result;
+  result.reserve(num_slots);
+  for (ffi::Optional<MeasureCandidate> candidate : per_slot_result) {
+    result.push_back(*std::move(candidate));
   }
   return result;
 }
@@ -18,12 +18,99 @@
  */
 #include <tvm/ffi/reflection/registry.h>
 
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+#include "../../../support/env.h"
+#include "../module_equality.h"
 #include "../utils.h"
 
 namespace tvm {
 namespace s_tir {
 namespace meta_schedule {
 
+/**************** Rule accounting and pruning ****************/
+
+/*! \brief The short name of a schedule rule, i.e. its type key without the namespace prefix */
+std::string RuleShortName(const ScheduleRule& rule) {
+  std::string type_key = rule->GetTypeKey();
+  size_t pos = type_key.rfind('.');
+  return pos == std::string::npos ? type_key : type_key.substr(pos + 1);
+}
+
+/*!
+ * \brief Configuration for pruning schedule rules by their historical hit rate.
+ *
+ * Enabled by pointing `TVM_META_SCHEDULE_RULE_STATS` at a JSON dict of the counters
+ * collected by a previous session's profiler (the `ProfilerGetCounters` dump) and setting
+ * `TVM_META_SCHEDULE_RULE_MIN_HIT_RATE` to a positive fraction. A rule is skipped for a
+ * workload class when it was applied at least `TVM_META_SCHEDULE_RULE_MIN_APPLIES` times
+ * (default 64) for that class and transformed a block in fewer than the given fraction of
+ * those applications.
+ */
+struct RulePruningConfig {
+  /*! \brief The counters of a previous session, keyed like the profiler counters */
+  std::unordered_map<std::string, int64_t> counters;
+  /*! \brief The hit rate below which a rule is skipped */
+  double min_hit_rate = 0.0;
+  /*! \brief The number of recorded applications required before a rule can be skipped */
+  int64_t min_applies = 64;
+  /*! \brief Whether pruning is enabled */
+  bool enabled = false;
+
+  static const RulePruningConfig& Global() {
+    static RulePruningConfig config = Load();
+    return config;
+  }
+
+  static RulePruningConfig Load() {
+    RulePruningConfig config;
+    std::string path = support::GetEnv<std::string>("TVM_META_SCHEDULE_RULE_STATS", "");
+    config.min_hit_rate = support::GetEnv<double>("TVM_META_SCHEDULE_RULE_MIN_HIT_RATE", 0.0);
+    config.min_applies = support::GetEnv<int>("TVM_META_SCHEDULE_RULE_MIN_APPLIES", 64);
+    if (path.empty() || config.min_hit_rate <= 0.0) {
+      return config;
+    }
+    std::ifstream is(path);
+    if (!is.good()) {
+      LOG(WARNING) << "Cannot open the schedule-rule stats file, rule pruning disabled: " << path;
+      return config;
+    }
+    std::ostringstream ss;
+    ss << is.rdbuf();
+    try {
+      ffi::Map<ffi::String, Any> dict = JSONLoads(ss.str()).cast<ffi::Map<ffi::String, Any>>();
+      for (const auto& kv : dict) {
+        config.counters[kv.first] = kv.second.cast<int64_t>();
+      }
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Cannot parse the schedule-rule stats file, rule pruning disabled: " << path
+                   << ". Details: " << e.what();
+      config.counters.clear();
+      return config;
+    }
+    config.enabled = true;
+    return config;
+  }
+
+  /*! \brief Whether the rule behind the given counter prefix should be skipped. */
+  bool ShouldSkip(const std::string& counter_prefix) const {
+    if (!enabled) {
+      return false;
+    }
+    auto it_applies = counters.find(counter_prefix + "/applies");
+    if (it_applies == counters.end() || it_applies->second < min_applies) {
+      return false;
+    }
+    auto it_hits = counters.find(counter_prefix + "/hits");
+    int64_t hits = it_hits == counters.end() ? 0 : it_hits->second;
+    return static_cast<double>(hits) / it_applies->second < min_hit_rate;
+  }
+};
+
 /*!
  * \brief Design Space Generator that generates design spaces by applying schedule rules to blocks
  *  in post-DFS order.
@@ -60,7 +147,29 @@ class PostOrderApplyNode : public SpaceGeneratorNode {
     ffi::Array<s_tir::Schedule> result{sch};
     ffi::Array<s_tir::SBlockRV> all_blocks = SBlockCollector::Collect(sch, f_block_filter_);
 
+    // Workload class for the per-rule accounting: modules with the same anchor block share
+    // the same useful rules, so their statistics are pooled under one key. The hash is
+    // environment-dependent, so stale stats files simply stop matching and disable pruning.
+    std::string workload_class;
+    {
+      static std::unique_ptr<ModuleEquality> anchor_eq = ModuleEquality::Create("anchor-block");
+      std::ostringstream os;
+      os << "0x" << std::hex << anchor_eq->Hash(mod);
+      workload_class = os.str();
+    }
+    const RulePruningConfig& pruning = RulePruningConfig::Global();
+
     for (ScheduleRule sch_rule : sch_rules.value()) {
+      std::string counter_prefix = "ScheduleRule/" + workload_class + "/" + RuleShortName(sch_rule);
+      if (pruning.ShouldSkip(counter_prefix)) {
+        // Skipping a rule leaves the schedules of the previous round untouched, exactly as
+        // if the rule had returned every block unchanged.
+        LOG(INFO) << "Skipping schedule rule with near-zero historical hit rate: "
+                  << counter_prefix;
+        continue;
+      }
+      int64_t num_applies = 0;
+      int64_t num_hits = 0;
       for (const s_tir::Schedule& sch : result) {
         stack.emplace_back(sch, all_blocks);
       }
@@ -88,10 +197,18 @@ class PostOrderApplyNode : public SpaceGeneratorNode {
           }
         }
         ffi::Array<s_tir::Schedule> applied = sch_rule->Apply(sch, /*block=*/block_rv);
+        ++num_applies;
+        // A hit is an application that actually transformed the block, i.e. the rule
+        // returned anything but the unchanged input schedule.
+        if (applied.size() != 1 || !applied[0].same_as(sch)) {
+          ++num_hits;
+        }
         for (const s_tir::Schedule& sch : applied) {
           stack.emplace_back(sch, blocks);
         }
       }
+      Profiler::IncCounter(counter_prefix + "/applies", num_applies);
+      Profiler::IncCounter(counter_prefix + "/hits", num_hits);
     }
     return result;
   }
@@ -20,6 +20,9 @@
 #include <tvm/ffi/reflection/registry.h>
 #include <tvm/s_tir/analysis.h>
 
+#include "../../../support/env.h"
+#include "../module_equality.h"
+#include "../trace_apply.h"
 #include "../utils.h"
 
 namespace tvm {
@@ -105,6 +108,89 @@ void SendToRunner(TaskRecordNode* self, const Runner& runner) {
   self->runner_futures = results;
 }
 
+/*!
+ * \brief The number of candidates built per pipeline stage in SendToBuilderAndRunner.
+ * Controlled by TVM_META_SCHEDULE_PIPELINE_CHUNK; non-positive values disable pipelining and
+ * restore the batched build-then-run behavior.
+ */
+int PipelineChunkSize() {
+  static int chunk_size = support::GetEnv<int>("TVM_META_SCHEDULE_PIPELINE_CHUNK", 16);
+  return chunk_size;
+}
+
+/*!
+ * \brief Build and dispatch the measure candidates of a task as a pipeline.
+ *
+ * The candidates are built in chunks, and each chunk is handed to the runner as soon as its
+ * builds finish, so the device measures one chunk while the next one is compiling instead of
+ * idling until the whole batch is built. Measurement requests are only issued as chunks complete,
+ * which bounds the number of artifacts in flight. The aggregated builder results and runner
+ * futures are indistinguishable from those of the batched path.
+ * \param self The task to be built and measured.
+ * \param builder The builder.
+ * \param runner The runner.
+ */
+void SendToBuilderAndRunner(TaskRecordNode* self, const Builder& builder, const Runner& runner) {
+  ffi::Array<MeasureCandidate> candidates = self->measure_candidates.value();
+  int n = candidates.size();
+  int chunk_size = PipelineChunkSize();
+  if (chunk_size <= 0 || chunk_size >= n) {
+    SendToBuilder(self, builder);
+    SendToRunner(self, runner);
+    return;
+  }
+  Target target = self->ctx->target.value();
+  ffi::Array<BuilderResult> builder_results;
+  builder_results.reserve(n);
+  ffi::Array<RunnerFuture> futures;
+  futures.reserve(n);
+  for (int st = 0; st < n; st += chunk_size) {
+    int ed = std::min(st + chunk_size, n);
+    ffi::Array<BuilderInput> inputs;
+    inputs.reserve(ed - st);
+    for (int i = st; i < ed; ++i) {
+      inputs.push_back(BuilderInput(candidates[i]->sch->mod(), target));
+    }
+    ffi::Array<BuilderResult> chunk_results;
+    {
+      auto _ = Profiler::TimedScope("SendToBuilder");
+      chunk_results = builder->Build(inputs);
+    }
+    ffi::Array<RunnerInput> runner_inputs;
+    runner_inputs.reserve(ed - st);
+    for (int i = st; i < ed; ++i) {
+      const BuilderResult& builder_result = chunk_results[i - st];
+      if (builder_result->error_msg.has_value()) {
+        continue;
+      }
+      runner_inputs.push_back(RunnerInput(/*artifact_path=*/builder_result->artifact_path.value(),
+                                          /*device_type=*/target->kind->name,
+                                          /*args_info=*/candidates[i]->args_info));
+    }
+    ffi::Array<RunnerFuture> chunk_futures;
+    {
+      auto _ = Profiler::TimedScope("SendToRunner");
+      chunk_futures = runner->Run(runner_inputs);
+    }
+    for (int i = st, j = 0; i < ed; ++i) {
+      const BuilderResult& builder_result = chunk_results[i - st];
+      builder_results.push_back(builder_result);
+      if (builder_result->error_msg.has_value()) {
+        futures.push_back(RunnerFuture(
+            /*f_done=*/[]() -> bool { return true; },
+            /*f_result=*/
+            [msg = builder_result->error_msg]() -> RunnerResult {
+              return RunnerResult(std::nullopt, msg);
+            }));
+      } else {
+        futures.push_back(chunk_futures[j++]);
+      }
+    }
+  }
+  self->builder_results = builder_results;
+  self->runner_futures = futures;
+}
+
 void TaskCleanUp(TaskRecordNode* self, int task_id, const ffi::Array<RunnerResult>& results) {
   TVM_FFI_ICHECK_EQ(self->builder_results.value().size(), results.size());
   TVM_FFI_ICHECK_EQ(self->runner_futures.value().size(), results.size());
@@ -151,6 +237,88 @@ void TaskCleanUp(TaskRecordNode* self, int task_id, const ffi::Array<RunnerResul
   self->runner_futures = std::nullopt;
 }
 
+/*! \brief The maximum number of traces transferred to a task from similar workloads. */
+constexpr int kMaxTransferSeeds = 5;
+
+/*!
+ * \brief Collect the best valid record of each workload in the database, bucketed by the
+ * anchor-block hash of the workload's module.
+ *
+ * Tasks extracted from different variants of the same model often share their anchor block (e.g.
+ * the same GEMM at another shape, or with different fused elementwise ops), so the buckets group
+ * exactly the workloads whose tuned traces are transferable via ScheduleUsingAnchorTrace.
+ * \param database The database holding records of previously tuned workloads.
+ * \param anchor_eq The anchor-block equality method used for bucketing.
+ * \return The mapping from anchor-block hash to records, best-first within each bucket.
+ */
+std::unordered_map<size_t, std::vector<TuningRecord>> CollectTransferPool(
+    const Database& database, const ModuleEquality& anchor_eq) {
+  std::unordered_map<const WorkloadNode*, TuningRecord> best_per_workload;
+  for (const TuningRecord& record : database->GetAllTuningRecords()) {
+    if (!record->IsValid()) {
+      continue;
+    }
+    auto [it, inserted] = best_per_workload.emplace(record->workload.get(), record);
+    if (!inserted && SortTuningRecordByMeanRunSecs()(record, it->second)) {
+      it->second = record;
+    }
+  }
+  std::unordered_map<size_t, std::vector<TuningRecord>> pool;
+  for (const auto& [workload, record] : best_per_workload) {
+    pool[anchor_eq.Hash(workload->mod)].push_back(record);
+  }
+  for (auto& [shash, records] : pool) {
+    std::sort(records.begin(), records.end(), SortTuningRecordByMeanRunSecs());
+  }
+  return pool;
+}
+
+/*!
+ * \brief Seed the search population of a task from the best traces of similar workloads.
+ *
+ * Each donor trace is transplanted onto the task's module with ScheduleUsingAnchorTrace and
+ * committed to the database under the task's own workload, so the search strategy picks the
+ * transferred traces up as part of its measured initial population. The donor's run seconds are
+ * kept as a ranking prior only; the transferred candidates get re-measured as tuning proceeds.
+ * \param task The task to be seeded.
+ * \param workload The task's workload as committed to the database.
+ * \param database The database tuned records are committed to.
+ * \param anchor_eq The anchor-block equality method used for similarity detection.
+ * \param donors The best records of workloads whose anchor-block hash matches the task.
+ * \return The number of traces transferred.
+ */
+int SeedWithSimilarTraces(TaskRecordNode* task, const Workload& workload, const Database& database,
+                          const ModuleEquality& anchor_eq,
+                          const std::vector<TuningRecord>& donors) {
+  IRModule mod = task->ctx->mod.value();
+  Target target = task->ctx->target.value();
+  int num_seeded = 0;
+  for (const TuningRecord& record : donors) {
+    if (num_seeded >= kMaxTransferSeeds) {
+      break;
+    }
+    // The hash bucket may contain colliding workloads; keep only true anchor-block matches, and
+    // skip the task's own workload whose records the search strategy already picks up.
+    if (database->GetModuleEquality().Equal(record->workload->mod, mod) ||
+        !anchor_eq.Equal(record->workload->mod, mod)) {
+      continue;
+    }
+    try {
+      s_tir::Schedule sch = s_tir::Schedule::Traced(
+          mod, /*seed=*/-1, /*debug_mask=*/0,
+          /*error_render_level=*/s_tir::ScheduleErrorRenderLevel::kNone);
+      ScheduleUsingAnchorTrace(sch, record->trace, target);
+      database->CommitTuningRecord(TuningRecord(sch->trace().value(), workload, record->run_secs,
+                                                record->target, /*args_info=*/std::nullopt));
+      ++num_seeded;
+    } catch (const std::runtime_error& e) {
+      // A donor trace may not apply to the task's module; skip it.
+      continue;
+    }
+  }
+  return num_seeded;
+}
+
 void TaskSchedulerNode::Tune(ffi::Array<TuneContext> ctxs, ffi::Array<FloatImm> task_weights,
                              int max_trials_global, int max_trials_per_task,
                              int num_trials_per_iter, Builder builder, Runner runner,
@@ -166,6 +334,14 @@ void TaskSchedulerNode::Tune(ffi::Array<TuneContext> ctxs, ffi::Array<FloatImm>
   this->cost_model_ = cost_model;
   this->tasks_.clear();
   this->tasks_.reserve(n_tasks);
+  // Cross-task transfer: bucket the best records already in the database by anchor-block hash, so
+  // that a task without tuned history can seed its search population from similar workloads.
+  std::unique_ptr<ModuleEquality> anchor_eq = ModuleEquality::Create("anchor-block");
+  std::unordered_map<size_t, std::vector<TuningRecord>> transfer_pool;
+  if (database.defined() && database.value()->Size() > 0) {
+    auto _ = Profiler::TimedScope("CollectTransferPool");
+    transfer_pool = CollectTransferPool(database.value(), *anchor_eq);
+  }
   for (int i = 0; i < n_tasks; ++i) {
     const TuneContext& ctx = ctxs[i];
     double weight = task_weights[i]->value;
@@ -184,6 +360,20 @@ void TaskSchedulerNode::Tune(ffi::Array<TuneContext> ctxs, ffi::Array<FloatImm>
                                     << sch->mod() << "\n"
                                     << Concat(trace->AsPython(false), "\n");
     }
+    if (!transfer_pool.empty()) {
+      auto _ = Profiler::TimedScope("SeedWithSimilarTraces");
+      Workload workload = database.value()->CommitWorkload(ctx->mod.value());
+      auto it = transfer_pool.find(anchor_eq->Hash(ctx->mod.value()));
+      if (it != transfer_pool.end() && database.value()->GetTopK(workload, 1).empty()) {
+        int num_seeded = SeedWithSimilarTraces(this->tasks_.back().get(), workload,
+                                               database.value(), *anchor_eq, it->second);
+        if (num_seeded > 0) {
+          TVM_PY_LOG(INFO, ctx->logger)
+              << "Seeded the task with " << num_seeded
+              << " trace(s) transferred from structurally similar workloads";
+        }
+      }
+    }
     ctx->search_strategy.value()->PreTuning(max_trials_per_task, num_trials_per_iter, design_spaces,
                                             database, cost_model);
   }
@@ -204,7 +394,7 @@ void TaskSchedulerNode::Tune(ffi::Array<TuneContext> ctxs, ffi::Array<FloatImm>
       int num_candidates = candidates.value().size();
       num_trials_already += num_candidates;
       TVM_PY_LOG(INFO, this->logger) << "Sending " << num_candidates << " sample(s) to builder";
-      SendToBuilder(task, builder);
+      SendToBuilderAndRunner(task, builder, runner);
       int n_build_errs = 0;
       const ffi::Array<BuilderResult>& builder_results = task->builder_results.value();
       for (int i = 0; i < num_candidates; i++) {
@@ -214,8 +404,7 @@ void TaskSchedulerNode::Tune(ffi::Array<TuneContext> ctxs, ffi::Array<FloatImm>
         TVM_PY_LOG(INFO, this->logger) << "Build errors: " << n_build_errs << " sample(s)";
       }
       TVM_PY_LOG(INFO, this->logger)
-          << "Sending " << num_candidates - n_build_errs << " valid sample(s) to runner";
-      SendToRunner(task, runner);
+          << "Sent " << num_candidates - n_build_errs << " valid sample(s) to runner";
     } else {
       TerminateTask(task_id);
     }
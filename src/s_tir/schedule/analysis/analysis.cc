@@ -17,10 +17,15 @@
  * under the License.
  */
 #include <tvm/ffi/cast.h>
+#include <tvm/ffi/extra/structural_equal.h>
+#include <tvm/ffi/extra/structural_hash.h>
 #include <tvm/ffi/reflection/registry.h>
 #include <tvm/ir/op.h>
 #include <tvm/s_tir/stmt.h>
 
+#include <mutex>
+#include <optional>
+
 #include "../ir_comparator.h"
 #include "../utils.h"
 
@@ -850,6 +855,12 @@ SBlockRealize CheckGetSingleChildBlockRealizeOnSRefTree(const ScheduleState& sel
 }
 
 SBlockRealize GetSBlockRealize(const ScheduleState& self, const StmtSRef& block_sref) {
+  {
+    auto it = self->analysis_cache.block_realize.find(block_sref);
+    if (it != self->analysis_cache.block_realize.end()) {
+      return it->second;
+    }
+  }
   struct BlockRealizeFinder : public StmtVisitor {
     explicit BlockRealizeFinder(const SBlockNode* target_sblock)
         : target_sblock(target_sblock), result(nullptr) {}
@@ -873,16 +884,19 @@ SBlockRealize GetSBlockRealize(const ScheduleState& self, const StmtSRef& block_
   };
 
   const SBlockNode* block = TVM_SREF_TO_SBLOCK(block_sref);
+  SBlockRealize result{ffi::UnsafeInit()};
   if (block_sref->parent == nullptr) {
     const PrimFuncNode* func = GetRootPrimFunc(self->mod, block, nullptr);
-    return func->body.as_or_throw<SBlockRealize>();
+    result = func->body.as_or_throw<SBlockRealize>();
   } else {
     BlockRealizeFinder finder(block);
     finder(ffi::GetRef<Stmt>(block_sref->parent->stmt));
     TVM_FFI_CHECK(finder.result != nullptr, InternalError)
         << "Cannot find the BlockRealize of block " << ffi::GetRef<SBlock>(block);
-    return ffi::GetRef<SBlockRealize>(finder.result);
+    result = ffi::GetRef<SBlockRealize>(finder.result);
   }
+  self->analysis_cache.block_realize[block_sref] = result;
+  return result;
 }
 
 TVM_FFI_STATIC_INIT_BLOCK() {
@@ -2108,6 +2122,70 @@ class AutoTensorizeMappingProposer {
   std::unordered_map<Var, VarSet> lhs_feasible_vars_;
 };
 
+/*!
+ * \brief Process-wide memo of auto-tensorize applicability verdicts.
+ *
+ * Schedule rules probe every candidate block against every tensor intrin they know about, and
+ * database replay repeats the probes against fresh copies of the same workloads. The comparator's
+ * verdict depends only on the structure of the block and on the intrin description, so verdicts
+ * are memoized keyed by the block's structural hash and the description function. Free variables
+ * are mapped when hashing so blocks from different copies of a module hit the same entry, and a
+ * hit is confirmed with a structural equality check, which is far cheaper than replaying the
+ * comparator's arithmetic proofs.
+ */
+class AutoTensorizeVerdictCache {
+ public:
+  static AutoTensorizeVerdictCache* Global() {
+    static AutoTensorizeVerdictCache inst;
+    return &inst;
+  }
+
+  /*! \brief Return the memoized verdict for (block, desc_func), if there is one. */
+  std::optional<bool> Lookup(const SBlock& block, const PrimFunc& desc_func) {
+    size_t hash = ffi::StructuralHash::Hash(block, /*map_free_vars=*/true,
+                                            /*skip_tensor_content=*/false);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(hash);
+    if (it == entries_.end()) {
+      return std::nullopt;
+    }
+    for (const Entry& entry : it->second) {
+      if (entry.desc_func.same_as(desc_func) &&
+          ffi::StructuralEqual::Equal(entry.block, block, /*map_free_vars=*/true,
+                                      /*skip_tensor_content=*/false)) {
+        return entry.verdict;
+      }
+    }
+    return std::nullopt;
+  }
+
+  /*! \brief Memoize the verdict for (block, desc_func). */
+  void Record(const SBlock& block, const PrimFunc& desc_func, bool verdict) {
+    size_t hash = ffi::StructuralHash::Hash(block, /*map_free_vars=*/true,
+                                            /*skip_tensor_content=*/false);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (num_entries_ >= kCapacity) {
+      entries_.clear();
+      num_entries_ = 0;
+    }
+    entries_[hash].push_back(Entry{block, desc_func, verdict});
+    ++num_entries_;
+  }
+
+ private:
+  struct Entry {
+    SBlock block;
+    PrimFunc desc_func;
+    bool verdict;
+  };
+
+  static constexpr size_t kCapacity = 1024;
+
+  std::mutex mutex_;
+  std::unordered_map<size_t, std::vector<Entry>> entries_;
+  size_t num_entries_ = 0;
+};
+
 bool CheckAutoTensorizeApplicable(const ScheduleState& state, const tirx::StmtSRef& block_sref,
                                   const tirx::PrimFunc& desc_func,
                                   AutoTensorizeComparator* extractor) {
@@ -2123,15 +2201,35 @@ bool CheckAutoTensorizeApplicable(const ScheduleState& state, const tirx::StmtSR
 
 bool CheckAutoTensorizeApplicable(const s_tir::Schedule& sch, const s_tir::SBlockRV& block_rv,
                                   const tirx::PrimFunc& desc_func) {
+  const StmtSRef& block_sref = sch->GetSRef(block_rv);
+  const SBlockRealize& block = GetSBlockRealize(sch->state(), block_sref);
+  AutoTensorizeVerdictCache* cache = AutoTensorizeVerdictCache::Global();
+  if (std::optional<bool> verdict = cache->Lookup(block->block, desc_func)) {
+    return verdict.value();
+  }
   AutoTensorizeComparator extractor(sch->state()->mod);
-  return CheckAutoTensorizeApplicable(sch->state(), sch->GetSRef(block_rv), desc_func, &extractor);
+  bool verdict = CheckAutoTensorizeApplicable(sch->state(), block_sref, desc_func, &extractor);
+  cache->Record(block->block, desc_func, verdict);
+  return verdict;
 }
 
 ffi::Optional<AutoTensorizeMappingInfo> GetAutoTensorizeMappingInfo(
     const s_tir::ScheduleState& self, const tirx::StmtSRef& block_sref,
     const tirx::PrimFunc& desc_func) {
+  const SBlockRealize& block = GetSBlockRealize(self, block_sref);
+  AutoTensorizeVerdictCache* cache = AutoTensorizeVerdictCache::Global();
+  std::optional<bool> cached = cache->Lookup(block->block, desc_func);
+  if (cached.has_value() && !cached.value()) {
+    return std::nullopt;
+  }
+  // A positive verdict does not spare the comparison here: the extractor's byproducts
+  // (iters and buffer correspondences) are needed to propose the mappings below.
   AutoTensorizeComparator extractor(self->mod);
-  if (!CheckAutoTensorizeApplicable(self, block_sref, desc_func, &extractor)) {
+  bool applicable = CheckAutoTensorizeApplicable(self, block_sref, desc_func, &extractor);
+  if (!cached.has_value()) {
+    cache->Record(block->block, desc_func, applicable);
+  }
+  if (!applicable) {
     return std::nullopt;
   }
   arith::Analyzer analyzer;
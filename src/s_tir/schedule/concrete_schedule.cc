@@ -196,18 +196,49 @@ void ConcreteScheduleNode::Copy(ScheduleState* new_state, TSymbolTable* new_symb
   new_state->get()->DebugVerify();
 }
 
+void ConcreteScheduleNode::ShareStateTo(ConcreteScheduleNode* other) {
+  if (this->copy_on_write_group_ == nullptr) {
+    this->copy_on_write_group_ = std::make_shared<int>(0);
+  }
+  other->state_ = this->state_;
+  other->symbol_table_ = this->symbol_table_;
+  other->copy_on_write_group_ = this->copy_on_write_group_;
+}
+
+void ConcreteScheduleNode::EnsureStateOwned() {
+  // `use_count() == 1` means every other schedule of the group is gone, so the shared state can
+  // be mutated in place without ever paying for the deep copy.
+  if (copy_on_write_group_ == nullptr || copy_on_write_group_.use_count() == 1) {
+    return;
+  }
+  ScheduleState new_state = this->state_;
+  TSymbolTable new_symbol_table;
+  ConcreteScheduleNode::Copy(&new_state, &new_symbol_table);
+  this->state_ = std::move(new_state);
+  this->symbol_table_ = std::move(new_symbol_table);
+  this->copy_on_write_group_ = nullptr;
+}
+
 Schedule ConcreteScheduleNode::Copy() {
   ffi::ObjectPtr<ConcreteScheduleNode> n = ffi::make_object<ConcreteScheduleNode>();
   n->func_working_on_ = this->func_working_on_;
   n->error_render_level_ = this->error_render_level_;
-  ConcreteScheduleNode::Copy(&n->state_, &n->symbol_table_);
+  // Forking is O(1): the sref tree, block info and symbol table are shared with the new schedule,
+  // and the deep copy is deferred until either side invokes its next schedule primitive.
+  ShareStateTo(n.get());
   n->analyzer_ = arith::Analyzer();  // new analyzer needed because it is stateful
   n->rand_state_ = ForkSeed();
   return Schedule(std::move(n));
 }
 
-/*! \brief Macro that guards the beginning of each invocation of TensorIR schedule primitive */
-#define TVM_TIR_SCHEDULE_BEGIN() try {
+/*!
+ * \brief Macro that guards the beginning of each invocation of TensorIR schedule primitive.
+ * Materializing the private state here keeps lazily forked schedules (see `Copy`) from mutating
+ * state still shared with their siblings.
+ */
+#define TVM_TIR_SCHEDULE_BEGIN() \
+  this->EnsureStateOwned();      \
+  try {
 /*!
  * \brief Macro that pairs with `TVM_TIR_SCHEDULE_BEGIN`, handling potential errors and error
  * message rendering
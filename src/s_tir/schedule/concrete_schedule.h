@@ -51,6 +51,12 @@ class ConcreteScheduleNode : public ScheduleNode {
   arith::Analyzer analyzer_;
   /*! \brief The value of random state for sampling. */
   LinearCongruentialEngine::TRandState rand_state_;
+  /*!
+   * \brief Non-null when `state_` and `symbol_table_` are shared with other schedules forked via
+   * `Copy()`. Forking only joins the group; the deep copy of the sref tree is deferred to
+   * `EnsureStateOwned()`, which runs before the first schedule primitive touches the shared state.
+   */
+  std::shared_ptr<void> copy_on_write_group_;
 
  public:
   static void RegisterReflection() {
@@ -203,6 +209,18 @@ class ConcreteScheduleNode : public ScheduleNode {
    * \param new_symbol_table The symbol table copied
    */
   void Copy(ScheduleState* new_state, TSymbolTable* new_symbol_table) const;
+  /*!
+   * \brief Share the schedule state and symbol table with a schedule forked from this one,
+   * making the fork O(1). Both sides join the same copy-on-write group.
+   * \param other The forked schedule to share the state with.
+   */
+  void ShareStateTo(ConcreteScheduleNode* other);
+  /*!
+   * \brief Materialize a private deep copy of the schedule state and symbol table if they are
+   * still shared with other schedules. No-op when this schedule owns its state, including when
+   * all other members of the copy-on-write group are gone.
+   */
+  void EnsureStateOwned();
   /*!
    * \brief Add srefs as random variables into the symbol table
    * \tparam T The type of the random variables
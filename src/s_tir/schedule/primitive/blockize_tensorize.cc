@@ -21,6 +21,8 @@
 #include <tvm/runtime/logging.h>
 
 #include <functional>
+#include <mutex>
+#include <unordered_map>
 
 #include "../../../tirx/ir/data_type_rewriter.h"
 #include "../../../tirx/transform/stmt_simplify.h"
@@ -749,6 +751,29 @@ StmtSRef Blockize(ScheduleState self, const ffi::Array<StmtSRef>& blocks,
   return result;
 }
 
+/*!
+ * \brief Return the simplified description function of a tensor intrin, memoized per intrin.
+ *
+ * Trace replay applies the same tensorize instruction against many copies of a workload, and
+ * registered tensor intrins are immutable, so the simplification only needs to run once per
+ * intrin in a process.
+ */
+PrimFunc SimplifiedIntrinDesc(const TensorIntrin& intrin) {
+  static std::mutex mutex;
+  static std::unordered_map<TensorIntrin, PrimFunc, ffi::ObjectPtrHash, ffi::ObjectPtrEqual> memo;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = memo.find(intrin);
+    if (it != memo.end()) {
+      return it->second;
+    }
+  }
+  arith::Analyzer analyzer;
+  PrimFunc desc = StmtSimplify(intrin->desc, analyzer);
+  std::lock_guard<std::mutex> lock(mutex);
+  return memo.emplace(intrin, std::move(desc)).first->second;
+}
+
 void Tensorize(ScheduleState self, const StmtSRef& sref, const TensorIntrin& intrin,
                bool preserve_unit_iters) {
   // Step 1: Blockize the subtree rooted at the given loop if needed
@@ -768,8 +793,7 @@ void Tensorize(ScheduleState self, const StmtSRef& sref, const TensorIntrin& int
     throw;
   }
 
-  arith::Analyzer analyzer;
-  PrimFunc intrin_desc = StmtSimplify(intrin->desc, analyzer);
+  PrimFunc intrin_desc = SimplifiedIntrinDesc(intrin);
   PrimFunc intrin_impl = DeepCopy(intrin->impl);
 
   int index_dtype_bits = -1;
@@ -822,6 +822,29 @@ class ChildReplacer : private StmtMutator {
   int seq_index_;
 };
 
+void ScheduleAnalysisCache::Invalidate(const StmtSRefNode* sref) {
+  auto on_root_path = [sref](const StmtSRefNode* s) {
+    for (const StmtSRefNode* p = s; p != nullptr; p = p->parent) {
+      if (p == sref) {
+        return true;
+      }
+    }
+    for (const StmtSRefNode* p = sref; p != nullptr; p = p->parent) {
+      if (p == s) {
+        return true;
+      }
+    }
+    return false;
+  };
+  for (auto it = block_realize.begin(); it != block_realize.end();) {
+    if (on_root_path(it->first.get())) {
+      it = block_realize.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
 void ScheduleStateNode::Replace(const tirx::StmtSRef& _src_sref, const Stmt& tgt_stmt,
                                 const ffi::Map<SBlock, SBlock>& _block_sref_reuse) {
   if (this->debug_mask != 0) {
@@ -842,6 +865,9 @@ void ScheduleStateNode::Replace(const tirx::StmtSRef& _src_sref, const Stmt& tgt
   if (_src_sref->stmt == tgt_stmt.get()) {
     return;
   }
+  // Invalidate the memoized analysis results the mutation can affect, while
+  // the parent chains of the cached srefs are still the pre-mutation ones.
+  this->analysis_cache.Invalidate(_src_sref.get());
   // Reset sref as a new sref so that its content won't be affected by subsequent changes
   StmtSRef src_sref(_src_sref->stmt, _src_sref->parent, _src_sref->seq_index);
   Stmt src_stmt = ffi::GetRef<Stmt>(src_sref->stmt);
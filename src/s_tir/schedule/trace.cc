@@ -20,7 +20,9 @@
 #include <tvm/ffi/reflection/registry.h>
 
 #include <sstream>
+#include <vector>
 
+#include "../support/parallel_for.h"
 #include "./utils.h"
 
 namespace tvm {
@@ -335,9 +337,13 @@ Any TraceNode::GetDecision(const Instruction& inst) const {
   return this->decisions.Get(inst).value_or(Any{nullptr});
 }
 
-void TraceNode::Append(Instruction inst) { insts.push_back(std::move(inst)); }
+void TraceNode::Append(Instruction inst) {
+  InvalidateCompiled();
+  insts.push_back(std::move(inst));
+}
 
 void TraceNode::Append(Instruction inst, Any decision) {
+  InvalidateCompiled();
   decisions.Set(inst, std::move(decision));
   insts.push_back(std::move(inst));
 }
@@ -346,6 +352,7 @@ ffi::Optional<Instruction> TraceNode::Pop() {
   if (insts.empty()) {
     return std::nullopt;
   }
+  InvalidateCompiled();
   Instruction inst = insts.back();
   insts.pop_back();
   if (decisions.count(inst)) {
@@ -354,6 +361,133 @@ ffi::Optional<Instruction> TraceNode::Pop() {
   return inst;
 }
 
+/**************** Compiled replay form ****************/
+
+/*! \brief How a single instruction input is translated when replaying a trace */
+enum class InputRVKind : uint8_t {
+  /*! \brief POD value or string, passed through unchanged */
+  kPOD,
+  /*! \brief SBlockRV / LoopRV / VarRV, translated by a direct rv_map lookup */
+  kRV,
+  /*! \brief A PrimExpr possibly containing VarRVs, substituted via rv_map */
+  kExpr,
+  /*! \brief An IndexMap possibly containing VarRVs, substituted via rv_map */
+  kIndexMap,
+  /*! \brief A nested array, translated recursively with full type dispatch */
+  kNested,
+};
+
+struct TraceNode::Compiled {
+  struct Inst {
+    /*! \brief The instruction; kept alive by TraceNode::insts */
+    const InstructionNode* inst;
+    /*! \brief Pre-classified translation kind of each input of the instruction */
+    std::vector<InputRVKind> input_kinds;
+    /*! \brief The decision made on the instruction; nullptr if there is none */
+    Any decision;
+  };
+  /*! \brief The pre-decoded instructions, in trace order */
+  std::vector<Inst> insts;
+  /*! \brief The number of leading instructions that are not postprocessors */
+  int num_non_postproc;
+};
+
+/*! \brief Classify an input the same way `TranslateInputRVs` dispatches on it */
+InputRVKind ClassifyInputRV(const Any& input) {
+  if (input.type_index() < ffi::TypeIndex::kTVMFFISmallStr || input.as<ffi::String>()) {
+    return InputRVKind::kPOD;
+  }
+  if (input.as<SBlockRVNode>() || input.as<LoopRVNode>() || input.as<VarNode>()) {
+    return InputRVKind::kRV;
+  }
+  if (input.try_cast<PrimExpr>()) {
+    return InputRVKind::kExpr;
+  }
+  if (input.as<IndexMap>()) {
+    return InputRVKind::kIndexMap;
+  }
+  if (input.as<ffi::Array<Any>>()) {
+    return InputRVKind::kNested;
+  }
+  TVM_FFI_THROW(TypeError) << "Cannot recognize the type of an input random variable: "
+                           << input.GetTypeKey();
+  throw;
+}
+
+/*! \brief The pre-classified counterpart of `TranslateInputRVs` over an rv_map */
+ffi::Array<Any> TranslateInputRVs(
+    const ffi::Array<Any>& inputs, const std::vector<InputRVKind>& input_kinds,
+    const std::unordered_map<const ffi::Object*, const ffi::Object*>& rv_map) {
+  ffi::Array<Any> result;
+  result.reserve(inputs.size());
+  auto f_subst_with_rv_map = [&rv_map](const Var& var) -> ffi::Optional<PrimExpr> {
+    auto it = rv_map.find(var.get());
+    if (it == rv_map.end()) {
+      return std::nullopt;
+    }
+    const ffi::Object* dst = it->second;
+    TVM_FFI_CHECK(dst->IsInstance<VarNode>(), TypeError)
+        << "Expect 'tirx.Var', but gets: " << dst->GetTypeKey();
+    return ffi::GetRef<Var>(static_cast<const VarNode*>(dst));
+  };
+  int n = inputs.size();
+  for (int i = 0; i < n; ++i) {
+    const Any& input = inputs[i];
+    switch (input_kinds[i]) {
+      case InputRVKind::kPOD: {
+        result.push_back(input);
+        break;
+      }
+      case InputRVKind::kRV: {
+        auto it = rv_map.find(input.as<ffi::Object>());
+        TVM_FFI_CHECK(it != rv_map.end(), IndexError)
+            << "Random variable doesn't exist: " << input;
+        result.push_back(ffi::GetRef<ffi::ObjectRef>(it->second));
+        break;
+      }
+      case InputRVKind::kExpr: {
+        result.push_back(Substitute(input.cast<PrimExpr>(), f_subst_with_rv_map));
+        break;
+      }
+      case InputRVKind::kIndexMap: {
+        result.push_back(Substitute(input.cast<IndexMap>(), f_subst_with_rv_map));
+        break;
+      }
+      case InputRVKind::kNested: {
+        result.push_back(TranslateInputRVs(input.cast<ffi::Array<Any>>(), rv_map));
+        break;
+      }
+    }
+  }
+  return result;
+}
+
+std::shared_ptr<const TraceNode::Compiled> TraceNode::GetCompiled() const {
+  std::lock_guard<std::mutex> lock(compiled_mutex_);
+  if (compiled_ == nullptr) {
+    auto compiled = std::make_shared<Compiled>();
+    compiled->num_non_postproc = GetNumValidInstructions(this->insts, /*remove_postproc=*/true);
+    compiled->insts.reserve(this->insts.size());
+    for (const Instruction& inst : this->insts) {
+      Compiled::Inst entry;
+      entry.inst = inst.get();
+      entry.input_kinds.reserve(inst->inputs.size());
+      for (const Any& input : inst->inputs) {
+        entry.input_kinds.push_back(ClassifyInputRV(input));
+      }
+      entry.decision = this->GetDecision(inst);
+      compiled->insts.push_back(std::move(entry));
+    }
+    compiled_ = std::move(compiled);
+  }
+  return compiled_;
+}
+
+void TraceNode::InvalidateCompiled() {
+  std::lock_guard<std::mutex> lock(compiled_mutex_);
+  compiled_ = nullptr;
+}
+
 /**************** Interfacing with InstructionKind ****************/
 
 void TraceNode::ApplyToSchedule(
@@ -362,18 +496,19 @@ void TraceNode::ApplyToSchedule(
                            const ffi::Array<Any>& attrs,                            //
                            const Any& decision)>
         decision_provider) const {
+  std::shared_ptr<const Compiled> compiled = this->GetCompiled();
+  int n_insts = remove_postproc ? compiled->num_non_postproc
+                                : static_cast<int>(compiled->insts.size());
   std::unordered_map<const ffi::Object*, const ffi::Object*> rv_map;
-  for (const Instruction& inst : this->insts) {
-    if (remove_postproc && inst->kind->IsPostproc()) {
-      break;
-    }
-    ffi::Array<Any> inputs = TranslateInputRVs(inst->inputs, rv_map);
-    ffi::Array<Any> attrs = inst->attrs;
-    Any decision = this->GetDecision(inst);
+  for (int i = 0; i < n_insts; ++i) {
+    const Compiled::Inst& entry = compiled->insts[i];
+    const InstructionNode* inst = entry.inst;
+    ffi::Array<Any> inputs = TranslateInputRVs(inst->inputs, entry.input_kinds, rv_map);
+    Any decision = entry.decision;
     if (decision_provider != nullptr) {
-      decision = decision_provider(inst, inputs, attrs, decision);
+      decision = decision_provider(ffi::GetRef<Instruction>(inst), inputs, inst->attrs, decision);
     }
-    ffi::Array<Any> outputs = inst->kind->f_apply_to_schedule(sch, inputs, attrs, decision);
+    ffi::Array<Any> outputs = inst->kind->f_apply_to_schedule(sch, inputs, inst->attrs, decision);
     TranslateAddOutputRVs(inst->outputs, outputs, &rv_map);
   }
 }
@@ -636,11 +771,70 @@ struct EnterPostprocTraits : public UnpackedInstTraits<EnterPostprocTraits> {
 
 TVM_REGISTER_INST_KIND_TRAITS(EnterPostprocTraits);
 
+/**************** Batch sampling ****************/
+
+ffi::Array<Trace> SampleTraces(const Trace& trace, const IRModule& mod,
+                               LinearCongruentialEngine::TRandState seed, int num_samples,
+                               int num_threads, int max_fail_count) {
+  TVM_FFI_CHECK(num_samples >= 0, ValueError)
+      << "`num_samples` should be non-negative, but gets: " << num_samples;
+  if (num_threads < 1) {
+    num_threads = 1;
+  }
+  // One PRNG drives the batch; each worker forks its own stream from it so the
+  // samples are deterministic given (seed, num_threads).
+  LinearCongruentialEngine::TRandState rand_state =
+      LinearCongruentialEngine::NormalizeSeed(seed);
+  std::vector<LinearCongruentialEngine::TRandState> per_thread_rand_state;
+  per_thread_rand_state.reserve(num_threads);
+  // Schedules copy-on-write into the module they hold, so each worker replays
+  // against its own deep copy.
+  std::vector<IRModule> per_thread_mod;
+  per_thread_mod.reserve(num_threads);
+  for (int i = 0; i < num_threads; ++i) {
+    per_thread_rand_state.push_back(LinearCongruentialEngine(&rand_state).ForkSeed());
+    per_thread_mod.push_back(ffi::FromJSONGraph(ffi::ToJSONGraph(mod)).cast<IRModule>());
+  }
+  std::vector<ffi::Optional<Trace>> results(num_samples);
+  auto f_worker = [&trace, &per_thread_rand_state, &per_thread_mod, &results,
+                   max_fail_count](int thread_id, int task_id) -> void {
+    LinearCongruentialEngine::TRandState& worker_rand_state = per_thread_rand_state[thread_id];
+    const IRModule& worker_mod = per_thread_mod[thread_id];
+    for (int fail_count = 0; fail_count <= max_fail_count; ++fail_count) {
+      try {
+        Schedule sch = Schedule::Traced(
+            worker_mod,
+            /*seed=*/LinearCongruentialEngine(&worker_rand_state).ForkSeed(),
+            /*debug_mask=*/0,
+            /*error_render_level=*/ScheduleErrorRenderLevel::kNone);
+        // Dropping the decisions makes every sampling instruction redraw.
+        Trace(trace->insts, {})->ApplyToSchedule(sch, /*remove_postproc=*/true);
+        results[task_id] = sch->trace().value();
+        break;
+      } catch (const ScheduleError&) {
+        continue;
+      } catch (const std::exception&) {
+        continue;
+      }
+    }
+  };
+  support::parallel_for_dynamic(0, num_samples, num_threads, f_worker);
+  ffi::Array<Trace> sampled;
+  sampled.reserve(num_samples);
+  for (const ffi::Optional<Trace>& result : results) {
+    if (result.has_value()) {
+      sampled.push_back(result.value());
+    }
+  }
+  return sampled;
+}
+
 /**************** FFI ****************/
 
 TVM_FFI_STATIC_INIT_BLOCK() {
   namespace refl = tvm::ffi::reflection;
   refl::GlobalDef()
+      .def("s_tir.schedule.TraceSampleTraces", SampleTraces)
       .def("s_tir.schedule.Trace",
            [](ffi::Optional<ffi::Array<Instruction>> insts,
               ffi::Optional<ffi::Map<Instruction, Any>> decisions) {
@@ -43,7 +43,9 @@ Schedule Schedule::Traced(IRModule mod, LinearCongruentialEngine::TRandState see
 Schedule TracedScheduleNode::Copy() {
   ffi::ObjectPtr<TracedScheduleNode> n = ffi::make_object<TracedScheduleNode>();
   n->error_render_level_ = this->error_render_level_;
-  ConcreteScheduleNode::Copy(&n->state_, &n->symbol_table_);
+  // O(1) fork; see ConcreteScheduleNode::Copy. All schedule primitives delegate to the concrete
+  // implementations, whose entry guard materializes a private state before the first mutation.
+  ShareStateTo(n.get());
   n->func_working_on_ = this->func_working_on_;
   n->analyzer_ = arith::Analyzer();  // new analyzer needed because it is stateful
   n->rand_state_ = ForkSeed();
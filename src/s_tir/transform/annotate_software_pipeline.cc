@@ -0,0 +1,212 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file annotate_software_pipeline.cc
+ * \brief Automatically annotate loops with a copy/compute software pipeline.
+ *
+ * InjectSoftwarePipeline only acts on loops that carry explicit
+ * `software_pipeline_stage`/`software_pipeline_order` annotations, which are
+ * normally placed by hand or by a tuned schedule. This pass detects the common
+ * structure of a serial loop whose body first copies data from global to
+ * shared memory and then computes on it, and places the annotations
+ * automatically, so unscheduled fallback kernels still get double-buffered
+ * (and on Ampere+ asynchronous) copies.
+ */
+#include <tvm/ffi/cast.h>
+#include <tvm/ffi/function.h>
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/ir/transform.h>
+#include <tvm/s_tir/stmt.h>
+#include <tvm/s_tir/transform.h>
+#include <tvm/target/target.h>
+#include <tvm/tirx/expr.h>
+#include <tvm/tirx/stmt_functor.h>
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "../../runtime/thread_storage_scope.h"
+#include "../../support/utils.h"
+
+namespace tvm {
+namespace s_tir {
+
+using namespace tvm::tirx;
+using runtime::StorageRank;
+using runtime::StorageScope;
+
+/*! \brief Whether the target is a CUDA device with cp.async support (sm_80+). */
+bool TargetSupportsAsyncCopy(const Target& target) {
+  if (target->kind->name != "cuda") return false;
+  ffi::Optional<ffi::String> opt_arch = target->GetAttr<ffi::String>("arch");
+  if (!opt_arch.defined()) return false;
+  std::string arch = opt_arch.value();
+  if (!support::StartsWith(arch, "sm_")) return false;
+  try {
+    return std::stoi(arch.substr(3)) >= 80;
+  } catch (const std::invalid_argument&) {
+    return false;
+  }
+}
+
+class PipelineAnnotator : public StmtMutator {
+ public:
+  static Stmt Annotate(Stmt body, bool enable_async) {
+    PipelineAnnotator annotator;
+    annotator.enable_async_ = enable_async;
+    return annotator.VisitStmt(std::move(body));
+  }
+
+ private:
+  PipelineAnnotator() = default;
+
+  Stmt VisitStmt_(const ForNode* op) final {
+    bool outer_annotated = annotated_below_;
+    annotated_below_ = false;
+    For loop = StmtMutator::VisitStmt_(op).as_or_throw<For>();
+    bool inner_annotated = annotated_below_;
+    annotated_below_ = outer_annotated || inner_annotated;
+    // Nested pipelines change the number of direct children seen by the
+    // injector, so only the innermost eligible loop is annotated.
+    if (inner_annotated) return loop;
+    if (TryAnnotate(&loop)) {
+      annotated_below_ = true;
+    }
+    return loop;
+  }
+
+  // Annotate the loop if its body is a sequence of global-to-shared copy
+  // blocks followed by blocks consuming the copied data.
+  bool TryAnnotate(For* p_loop) {
+    const For& loop = *p_loop;
+    if (loop->kind != ForKind::kSerial) return false;
+    if (loop->annotations.count(s_tir::attr::software_pipeline_stage) ||
+        loop->annotations.count(s_tir::attr::software_pipeline_order)) {
+      return false;
+    }
+    // The pipeline needs at least two iterations to overlap anything.
+    const auto* extent = loop->extent.as<IntImmNode>();
+    if (extent == nullptr || extent->value < 2) return false;
+
+    Stmt body = loop->body;
+    if (const auto* realize = body.as<SBlockRealizeNode>()) {
+      if (!is_one(realize->predicate)) return false;
+      if (!realize->block->match_buffers.empty()) return false;
+      body = realize->block->body;
+    }
+    const auto* seq = body.as<SeqStmtNode>();
+    if (seq == nullptr || seq->seq.size() < 2) return false;
+
+    std::vector<SBlock> children;
+    for (const Stmt& child : seq->seq) {
+      const auto* realize = child.as<SBlockRealizeNode>();
+      if (realize == nullptr || !is_one(realize->predicate)) return false;
+      // Children with nested sequences are flattened by the injector and
+      // would make the annotation size disagree with what it expects.
+      if (realize->block->body->IsInstance<SeqStmtNode>()) return false;
+      children.push_back(realize->block);
+    }
+
+    // Split the children into a prefix of global-to-shared copies and the
+    // consuming computation.
+    size_t num_copies = 0;
+    while (num_copies < children.size() && IsGlobalToSharedCopy(children[num_copies])) {
+      ++num_copies;
+    }
+    if (num_copies == 0 || num_copies == children.size()) return false;
+    std::unordered_set<const BufferNode*> copied;
+    for (size_t i = 0; i < num_copies; ++i) {
+      for (const BufferRegion& write : children[i]->writes) {
+        copied.insert(write->buffer.get());
+      }
+    }
+    bool consumed = false;
+    for (size_t i = num_copies; i < children.size(); ++i) {
+      // A copy stage after the compute started would need its own pipeline
+      // stage; leave such loops to explicit scheduling.
+      if (IsGlobalToSharedCopy(children[i])) return false;
+      for (const BufferRegion& read : children[i]->reads) {
+        if (copied.count(read->buffer.get())) consumed = true;
+      }
+    }
+    if (!consumed) return false;
+
+    ffi::Array<int64_t> stages;
+    ffi::Array<int64_t> orders;
+    for (size_t i = 0; i < children.size(); ++i) {
+      stages.push_back(i < num_copies ? 0 : 1);
+      orders.push_back(static_cast<int64_t>(i));
+    }
+    auto* n = p_loop->CopyOnWrite();
+    n->annotations.Set(s_tir::attr::software_pipeline_stage, stages);
+    n->annotations.Set(s_tir::attr::software_pipeline_order, orders);
+    if (enable_async_) {
+      n->annotations.Set(s_tir::attr::software_pipeline_async_stages, ffi::Array<int64_t>{0});
+    }
+    return true;
+  }
+
+  // A copy stage reads only global memory and writes only shared memory.
+  static bool IsGlobalToSharedCopy(const SBlock& block) {
+    if (block->reads.empty() || block->writes.empty()) return false;
+    if (!block->init.defined() && block->match_buffers.empty()) {
+      for (const BufferRegion& read : block->reads) {
+        if (StorageScope::Create(read->buffer.scope()).rank != StorageRank::kGlobal) return false;
+      }
+      for (const BufferRegion& write : block->writes) {
+        if (StorageScope::Create(write->buffer.scope()).rank != StorageRank::kShared) return false;
+      }
+      return true;
+    }
+    return false;
+  }
+
+  // whether async copy annotations should be placed on the copy stage.
+  bool enable_async_{false};
+  // whether a loop in the currently visited subtree was annotated.
+  bool annotated_below_{false};
+};
+
+namespace transform {
+
+Pass AnnotateSoftwarePipeline() {
+  auto pass_func = [=](PrimFunc f, IRModule m, PassContext ctx) {
+    ffi::Optional<Target> target = f->GetAttr<Target>(tvm::attr::kTarget);
+    if (!target.defined() || !TargetSupportsAsyncCopy(target.value())) {
+      return f;
+    }
+    bool enable_async = ctx->GetConfig<bool>("tirx.use_async_copy", false).value();
+    auto* fptr = f.CopyOnWrite();
+    fptr->body = PipelineAnnotator::Annotate(std::move(fptr->body), enable_async);
+    return f;
+  };
+  return CreatePrimFuncPass(pass_func, 0, "s_tir.AnnotateSoftwarePipeline", {});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("s_tir.transform.AnnotateSoftwarePipeline", AnnotateSoftwarePipeline);
+}
+
+}  // namespace transform
+
+}  // namespace s_tir
+}  // namespace tvm
@@ -384,10 +384,17 @@ class BufferAccessRegionCollector : public StmtExprVisitor {
         const VarNode* v = ancestor_iters_[i]->var.get();
         dom_map_.emplace(v, non_relaxed[i]);
       }
-      // Step 4. Update relaxed_accesses_ dict
+      // Step 4. Update relaxed_accesses_ dict.  Use the segment-preserving
+      // union so that disjoint strided accesses are not eagerly collapsed to
+      // a hull per access; the hull is taken once during narrowing, from the
+      // exact segment bounds.
       auto access_it = relaxed_accesses_.find(buffer);
       if (access_it != relaxed_accesses_.end()) {
-        support::NDIntSetUnionWith(&access_it->second, nd_int_set);
+        NDIntSet& accumulated = access_it->second;
+        TVM_FFI_ICHECK_EQ(accumulated.size(), nd_int_set.size());
+        for (size_t i = 0; i < nd_int_set.size(); ++i) {
+          accumulated[i] = arith::UnionBounded({accumulated[i], nd_int_set[i]});
+        }
       } else {
         relaxed_accesses_.insert(access_it, {buffer, nd_int_set});
       }
@@ -38,12 +38,16 @@ using namespace tvm::tirx;
 
 struct InjectDoubleBufferConfigNode : public ffi::Object {
   int split_loop;
+  bool auto_inject;
 
   static void RegisterReflection() {
     namespace refl = tvm::ffi::reflection;
-    refl::ObjectDef<InjectDoubleBufferConfigNode>().def_ro(
-        "split_loop", &InjectDoubleBufferConfigNode::split_loop, "Split loop factors",
-        refl::DefaultValue(1));
+    refl::ObjectDef<InjectDoubleBufferConfigNode>()
+        .def_ro("split_loop", &InjectDoubleBufferConfigNode::split_loop, "Split loop factors",
+                refl::DefaultValue(1))
+        .def_ro("auto_inject", &InjectDoubleBufferConfigNode::auto_inject,
+                "Automatically double buffer eligible shared-memory producers",
+                refl::DefaultValue(false));
   }
   TVM_FFI_DECLARE_OBJECT_INFO_FINAL("s_tir.transform.InjectDoubleBufferConfig",
                                     InjectDoubleBufferConfigNode, ffi::Object);
@@ -91,11 +95,165 @@ class StripDoubleBufferWrite : public StmtMutator {
   }
 };
 
+/*!
+ * \brief Automatically mark double-buffer candidates when no annotation is present.
+ *
+ * The pass runs on flat IR, so applicability is decided structurally rather than from
+ * block-level dependence info: a buffer qualifies if it is a flat shared-memory
+ * allocation whose stores all live in a single direct child of a serial loop's body,
+ * that child stores no other buffer, and every load of the buffer happens in later
+ * children of the same loop body. Such a producer can be shifted one iteration ahead
+ * without reordering any other effect, which is exactly the contract the
+ * double_buffer_scope annotation promises, so the marker synthesizes the annotation
+ * and lets the existing injector do the rewriting.
+ */
+class AutoDoubleBufferMarker : public StmtMutator {
+ public:
+  static Stmt Run(Stmt stmt) {
+    AutoDoubleBufferMarker marker;
+    marker.collector_(stmt);
+    if (marker.collector_.alloc_vars.empty()) {
+      return stmt;
+    }
+    return marker(std::move(stmt));
+  }
+
+ private:
+  /*! \brief Counts the buffer loads and stores per buffer variable in a subtree. */
+  struct AccessCounter : public StmtExprVisitor {
+    void VisitStmt_(const BufferStoreNode* op) final {
+      stores[op->buffer->data.get()] += 1;
+      StmtExprVisitor::VisitStmt_(op);
+    }
+    void VisitExpr_(const BufferLoadNode* op) final {
+      loads[op->buffer->data.get()] += 1;
+      StmtExprVisitor::VisitExpr_(op);
+    }
+    std::unordered_map<const VarNode*, int> loads;
+    std::unordered_map<const VarNode*, int> stores;
+  };
+
+  /*! \brief Collects candidate allocations and whole-function access counts. */
+  struct CandidateCollector : public AccessCounter {
+    void VisitStmt_(const AllocBufferNode* op) final {
+      ffi::String scope = op->buffer.scope();
+      if ((scope == "shared" || scope == "shared.dyn") && op->buffer->shape.size() == 1) {
+        alloc_vars[op->buffer->data.get()] = op->buffer->data;
+      }
+      AccessCounter::VisitStmt_(op);
+    }
+    void VisitStmt_(const AttrStmtNode* op) final {
+      if (op->attr_key == s_tir::attr::double_buffer_scope) {
+        if (const VarNode* v = op->node.as<VarNode>()) {
+          annotated.insert(v);
+        }
+      }
+      AccessCounter::VisitStmt_(op);
+    }
+    // A raw occurrence of the data variable means the buffer is accessed opaquely
+    // (e.g. its address is taken), which the structural analysis cannot reason about.
+    void VisitExpr_(const VarNode* op) final { opaque.insert(op); }
+
+    std::unordered_map<const VarNode*, Var> alloc_vars;
+    std::unordered_set<const VarNode*> annotated;
+    std::unordered_set<const VarNode*> opaque;
+  };
+
+  Stmt VisitStmt_(const ForNode* op) final {
+    // Mutate bottom-up so inner loops get the first chance to claim a buffer.
+    Stmt stmt = StmtMutator::VisitStmt_(op);
+    op = stmt.as<ForNode>();
+    if (op->kind != ForKind::kSerial || !is_zero(op->min)) {
+      return stmt;
+    }
+    const SeqStmtNode* seq = op->body.as<SeqStmtNode>();
+    if (seq == nullptr) {
+      return stmt;
+    }
+    size_t n = seq->size();
+    std::vector<AccessCounter> counters(n);
+    for (size_t i = 0; i < n; ++i) {
+      counters[i](seq->seq[i]);
+    }
+    // child index -> buffer variables whose producer is that child
+    std::unordered_map<size_t, std::vector<Var>> to_wrap;
+    for (const auto& kv : collector_.alloc_vars) {
+      const VarNode* var = kv.first;
+      const Var& var_ref = kv.second;
+      if (collector_.annotated.count(var) || collector_.opaque.count(var) ||
+          marked_.count(var)) {
+        continue;
+      }
+      auto f_count = [var](const std::unordered_map<const VarNode*, int>& m) {
+        auto it = m.find(var);
+        return it == m.end() ? 0 : it->second;
+      };
+      int total_stores = f_count(collector_.stores);
+      int total_loads = f_count(collector_.loads);
+      if (total_stores == 0 || total_loads == 0) {
+        continue;
+      }
+      // Find the single child holding all stores of the buffer.
+      int producer = -1;
+      bool stores_split = false;
+      for (size_t i = 0; i < n; ++i) {
+        int num_stores = f_count(counters[i].stores);
+        if (num_stores == 0) {
+          continue;
+        }
+        if (producer != -1 || num_stores != total_stores) {
+          stores_split = true;
+          break;
+        }
+        producer = static_cast<int>(i);
+      }
+      if (producer == -1 || stores_split) {
+        continue;
+      }
+      // The producer must be a pure copy into the buffer, and all loads must
+      // come after it in the same loop body.
+      if (counters[producer].stores.size() != 1 || f_count(counters[producer].loads) != 0) {
+        continue;
+      }
+      int loads_after = 0;
+      for (size_t i = static_cast<size_t>(producer) + 1; i < n; ++i) {
+        loads_after += f_count(counters[i].loads);
+      }
+      if (loads_after != total_loads) {
+        continue;
+      }
+      to_wrap[producer].push_back(var_ref);
+      marked_.insert(var);
+    }
+    if (to_wrap.empty()) {
+      return stmt;
+    }
+    ffi::Array<Stmt> new_seq = seq->seq;
+    for (const auto& [idx, vars] : to_wrap) {
+      Stmt child = new_seq[idx];
+      for (const Var& v : vars) {
+        child = AttrStmt(v, s_tir::attr::double_buffer_scope, 1, child);
+      }
+      new_seq.Set(idx, child);
+    }
+    For ret = ffi::GetRef<For>(op);
+    ret.CopyOnWrite()->body = SeqStmt(new_seq, seq->span);
+    return ret;
+  }
+
+  CandidateCollector collector_;
+  std::unordered_set<const VarNode*> marked_;
+};
+
 class DoubleBufferInjector : public StmtExprMutator {
  public:
-  explicit DoubleBufferInjector(int split_loop) : split_loop_(split_loop) {}
+  explicit DoubleBufferInjector(int split_loop, bool auto_inject)
+      : split_loop_(split_loop), auto_inject_(auto_inject) {}
 
   Stmt Inject(Stmt stmt) {
+    if (auto_inject_) {
+      stmt = AutoDoubleBufferMarker::Run(std::move(stmt));
+    }
     DoubleBufferDetector detector;
     detector(stmt);
     if (detector.touched_.empty()) return stmt;
@@ -309,6 +467,8 @@ class DoubleBufferInjector : public StmtExprMutator {
   };
   // Whether split loop
   int32_t split_loop_;
+  // Whether to automatically detect and mark double-buffer candidates.
+  bool auto_inject_;
   // Whether we are inside double buffer scope.
   bool in_double_buffer_scope_{false};
   // The current loop next
@@ -334,7 +494,8 @@ Pass InjectDoubleBuffer() {
     if (!cfg.defined()) {
       cfg = tvm::transform::PassConfigWithDefaults<InjectDoubleBufferConfig>();
     }
-    n->body = DoubleBufferInjector(cfg.value()->split_loop).Inject(std::move(n->body));
+    n->body = DoubleBufferInjector(cfg.value()->split_loop, cfg.value()->auto_inject)
+                  .Inject(std::move(n->body));
     return f;
   };
   return CreatePrimFuncPass(pass_func, 0, "s_tir.InjectDoubleBuffer", {});
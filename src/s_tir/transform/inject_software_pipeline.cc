@@ -33,6 +33,7 @@
 #include <map>
 #include <unordered_set>
 
+#include "../../arith/region_overlap.h"
 #include "../../support/utils.h"
 #include "../../tirx/transform/ir_utils.h"
 #include "../schedule/utils.h"
@@ -446,17 +447,7 @@ class PipelineRewriter : public StmtExprMutator {
    * \return Whether region1 and region2 have intersections.
    */
   bool MayConflict(Region region1, Region region2) {
-    TVM_FFI_ICHECK(region1.size() == region2.size());
-    for (size_t i = 0; i < region1.size(); i++) {
-      Range dim1 = region1[i];
-      Range dim2 = region2[i];
-      auto int_set1 = arith::IntSet::FromRange(dim1);
-      auto int_set2 = arith::IntSet::FromRange(dim2);
-      if (arith::Intersect({int_set1, int_set2}).IsNothing()) {
-        return false;
-      }
-    }
-    return true;
+    return overlap_oracle_.MayOverlap(region1, region2);
   }
 
   /*!
@@ -980,6 +971,7 @@ class PipelineRewriter : public StmtExprMutator {
   }
 
   arith::Analyzer analyzer_;
+  arith::RegionOverlapOracle overlap_oracle_;
   ffi::Map<Var, Buffer> buffer_data_to_buffer_;
   const std::unordered_set<Buffer, ffi::ObjectPtrHash, ffi::ObjectPtrEqual>& double_buffers_;
   ffi::Array<Buffer> pipeline_allocs_;
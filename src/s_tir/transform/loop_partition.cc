@@ -326,7 +326,81 @@ class PartitionFinder : public StmtExprVisitor {
           partitions[{cond, false}] = interval;
         }
       }
+
+      // Fall back to a bound witness when the deducer cannot solve the condition
+      // directly, which typically happens when inner loop variables are coupled
+      // with current_var_ in a form the bound deducer does not handle.
+      if (!partitions.count(PartitionKey{cond, true})) {
+        DeduceWitnessInterval(cond, cond, /*cond_value=*/true);
+      }
+      if (inverse_cond.defined() && !partitions.count(PartitionKey{cond, false})) {
+        DeduceWitnessInterval(cond, inverse_cond, /*cond_value=*/false);
+      }
+    }
+  }
+
+  /*!
+   * \brief Deduce an interval for current_var_ from the bound witness of a condition.
+   * \param cond The condition recorded in `partitions`.
+   * \param deduce_cond The condition (`cond` or its inverse) the witness is built from.
+   * \param cond_value The value `cond` provably has in the deduced interval.
+   */
+  void DeduceWitnessInterval(const PrimExpr& cond, const PrimExpr& deduce_cond, bool cond_value) {
+    PrimExpr witness = MakeBoundWitness(deduce_cond);
+    if (!witness.defined()) {
+      return;
+    }
+    IntSet interval = DeduceBound(current_var_, witness, hint_map_, relax_map_);
+    if (!interval.IsNothing()) {
+      partitions[{cond, cond_value}] = interval;
+    }
+  }
+
+  /*!
+   * \brief Strengthen a comparison into a witness condition free of inner loop variables.
+   *
+   * Each side of the comparison is evaluated over the domains of the relaxed (inner)
+   * variables, and the worst-case bounds are compared: whenever `max(lhs) < min(rhs)`
+   * holds, `lhs < rhs` holds for every inner iteration, so the witness' truth
+   * witnesses the truth of the original condition over the whole inner domain.
+   * Deducing the bound of the witness then peels exact prologue/epilogue iterations
+   * of current_var_ and leaves the steady-state body branch-free, at worst moving a
+   * few boundary iterations into the peeled parts.
+   * \return The witness condition, or an undefined expression if the condition is not
+   * a comparison, does not involve a relaxed variable, or the bounds do not exist.
+   */
+  PrimExpr MakeBoundWitness(const PrimExpr& cond) {
+    PrimExpr lhs, rhs;
+    bool strict = false;
+    if (const LTNode* op = cond.as<LTNode>()) {
+      lhs = op->a;
+      rhs = op->b;
+      strict = true;
+    } else if (const LENode* op = cond.as<LENode>()) {
+      lhs = op->a;
+      rhs = op->b;
+    } else if (const GTNode* op = cond.as<GTNode>()) {
+      lhs = op->b;
+      rhs = op->a;
+      strict = true;
+    } else if (const GENode* op = cond.as<GENode>()) {
+      lhs = op->b;
+      rhs = op->a;
+    } else {
+      return PrimExpr();
+    }
+    // Only worthwhile when relaxed variables actually occur; otherwise the witness
+    // is the condition itself, which the deducer has already rejected.
+    auto f_relaxed = [this](const VarNode* var) { return relax_map_.count(var); };
+    if (!UsesVar(lhs, f_relaxed) && !UsesVar(rhs, f_relaxed)) {
+      return PrimExpr();
+    }
+    IntSet lhs_set = arith::EvalSet(lhs, relax_map_);
+    IntSet rhs_set = arith::EvalSet(rhs, relax_map_);
+    if (!lhs_set.HasUpperBound() || !rhs_set.HasLowerBound()) {
+      return PrimExpr();
     }
+    return strict ? LT(lhs_set.max(), rhs_set.min()) : LE(lhs_set.max(), rhs_set.min());
   }
 
   PrimExpr InverseCond(const PrimExpr& cond) {
@@ -45,8 +45,7 @@ class ThreadAllreduceBuilder final : public StmtExprMutator {
  public:
   explicit ThreadAllreduceBuilder(const TargetNode* target)
       : target_(target),
-        warp_size_(target->GetAttr<int64_t>("thread_warp_size", 1).value()),
-        max_num_threads_(target->GetAttr<int64_t>("max_num_threads", -1).value()) {}
+        warp_size_(target->GetAttr<int64_t>("thread_warp_size", 1).value()) {}
 
   Stmt VisitStmt_(const AttrStmtNode* op) final {
     if (op->attr_key == tirx::attr::thread_extent) {
@@ -786,9 +785,14 @@ class ThreadAllreduceBuilder final : public StmtExprMutator {
         return false;  // no need to warp reduce
       } else {
         bool is_subwarp_reduction = warp_size_ % reduce_extent == 0;
-        bool is_multiwarp_reduction = max_num_threads_ != -1 &&
-                                      max_num_threads_ <= warp_size_ * warp_size_ &&
-                                      reduce_extent % warp_size_ == 0;
+        // The two-stage reduction reduces one element per warp in the second stage
+        // using the lanes of a single warp, so it applies whenever the number of
+        // warps fits into one warp. The reduce extent is a known constant at this
+        // point, so the bound is derived from the thread extents directly rather
+        // than from the target's optional max_num_threads attribute, whose absence
+        // used to force shuffle-eligible reductions onto the shared-memory path.
+        bool is_multiwarp_reduction =
+            reduce_extent % warp_size_ == 0 && reduce_extent <= warp_size_ * warp_size_;
         if (is_subwarp_reduction || is_multiwarp_reduction) {
           return true;
         } else {
@@ -803,8 +807,6 @@ class ThreadAllreduceBuilder final : public StmtExprMutator {
 
   // The warp size of the device.
   int warp_size_{1};
-  // The maximum number of threads of the device. "-1" denotes unknown.
-  int max_num_threads_{-1};
   // A boolean indicating if the target supports warp-level masking.
   bool need_warp_shuffle_mask_;
 
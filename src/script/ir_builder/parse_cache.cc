@@ -0,0 +1,104 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*!
+ * \file parse_cache.cc
+ * \brief A process-wide cache of parsed IR fragments for the TVMScript frontend.
+ *
+ * Parsing a module class re-parses every member even when only one of them
+ * changed, which dominates ingestion time on generated files with thousands
+ * of functions. The frontend can instead hash each member's source (together
+ * with anything else the parse result depends on, e.g. the dialect and the
+ * names of referenced globals), look the hash up here, and only parse on a
+ * miss. Cached values are immutable IR, so sharing them across modules is
+ * safe; the cache is guarded by a mutex so that members parsed on multiple
+ * threads (the IRBuilder scope stack is already thread-local) can share it.
+ *
+ * The cache is deliberately dumb: the key must capture everything the parse
+ * output depends on, and the caller is responsible for clearing it when that
+ * contract cannot be maintained.
+ */
+#include <tvm/ffi/function.h>
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/script/ir_builder/base.h>
+
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace tvm {
+namespace script {
+namespace ir_builder {
+
+namespace {
+
+/*! \brief The singleton cache mapping a caller-computed key to a parsed fragment. */
+class ParseCache {
+ public:
+  static ParseCache* Global() {
+    static ParseCache inst;
+    return &inst;
+  }
+
+  ffi::Optional<ffi::ObjectRef> Get(const ffi::String& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = cache_.find(key);
+    if (it == cache_.end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  }
+
+  void Put(const ffi::String& key, ffi::ObjectRef value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cache_[key] = std::move(value);
+  }
+
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cache_.clear();
+  }
+
+  int64_t Size() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<int64_t>(cache_.size());
+  }
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<ffi::String, ffi::ObjectRef> cache_;
+};
+
+}  // namespace
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef()
+      .def("script.ir_builder.ParseCacheGet",
+           [](ffi::String key) { return ParseCache::Global()->Get(key); })
+      .def("script.ir_builder.ParseCachePut",
+           [](ffi::String key, ffi::ObjectRef value) {
+             ParseCache::Global()->Put(key, std::move(value));
+           })
+      .def("script.ir_builder.ParseCacheClear", []() { ParseCache::Global()->Clear(); })
+      .def("script.ir_builder.ParseCacheSize", []() { return ParseCache::Global()->Size(); });
+}
+
+}  // namespace ir_builder
+}  // namespace script
+}  // namespace tvm
@@ -18,6 +18,10 @@
  */
 #include <tvm/ir/type.h>
 
+#include <atomic>
+#include <fstream>
+#include <thread>
+
 #include "./utils.h"
 
 namespace tvm {
@@ -179,6 +183,214 @@ TVM_REGISTER_SCRIPT_AS_REPR(FuncTypeNode, ReprPrintIR);
 TVM_REGISTER_SCRIPT_AS_REPR(RangeNode, ReprPrintIR);
 TVM_REGISTER_SCRIPT_AS_REPR(IRModuleNode, ReprPrintIRModule);
 
+//////////////////////////// Streaming printing ////////////////////////////
+
+namespace {
+
+/*! \brief Copy a printer config so each rendering task can mutate its own. */
+PrinterConfig CopyConfig(const PrinterConfig& cfg) {
+  return PrinterConfig(ffi::make_object<PrinterConfigNode>(*cfg.get()));
+}
+
+/*! \brief Write \p text to \p os with every non-empty line indented one level. */
+void WriteIndented(const std::string& text, int indent_spaces, std::ostream& os) {
+  const std::string indent(indent_spaces, ' ');
+  size_t start = 0;
+  while (start < text.size()) {
+    size_t end = text.find('\n', start);
+    if (end == std::string::npos) {
+      end = text.size();
+    }
+    if (end != start) {
+      os << indent;
+      os.write(text.data() + start, end - start);
+    }
+    os << '\n';
+    start = end + 1;
+  }
+}
+
+/*!
+ * \brief Render one sorted member of the module with its own docsifier.
+ *
+ * The docsifier only lives for the duration of this call, which is what
+ * bounds the doc-tree lifetime in streaming mode. To keep cross-function
+ * references printing the same way as in whole-module mode, the module and
+ * every GlobalVar it holds are defined up front, exactly as the IRModule
+ * dispatch above does.
+ */
+std::string ScriptModuleMember(IRModule mod, const SortableFunction& entry,
+                               const PrinterConfig& base_cfg, const ffi::String& module_name) {
+  const GlobalVar& gv = entry.gv;
+  const BaseFunc& base_func = entry.func;
+  // The docsifier pushes onto cfg->binding_names while printing, so parallel
+  // rendering tasks must not share the caller's config.
+  PrinterConfig cfg = CopyConfig(base_cfg);
+  cfg->binding_names.push_back(gv->name_hint);
+  IRDocsifier d(cfg);
+  With<IRFrame> f(d);
+  (*f)->AddDispatchToken(d, "ir");
+  (*f)->global_infos = &mod->global_infos;
+  AccessPath p = AccessPath::Root();
+  d->Define(mod, f(), module_name);
+  for (const auto& kv : mod->functions) {
+    const GlobalVar& other_gv = kv.first;
+    d->Define(other_gv, f(), [=]() {
+      return d->AsDoc<ExprDoc>(mod, p->Attr("global_vars"))->Attr(other_gv->name_hint);
+    });
+  }
+  // Seed the docsifier's global infos so vdevice annotations resolve to the
+  // same indices as in whole-module printing.
+  if (mod->global_infos.defined() && !mod->global_infos.empty()) {
+    d->AsDoc<ExprDoc>(mod->global_infos, p->Attr("global_infos"));
+  }
+  Doc doc = d->AsDoc(base_func, p->Attr("functions")->MapItem(gv));
+  StmtDoc stmt = [&]() -> StmtDoc {
+    if (const auto* stmt_block = doc.as<StmtBlockDocNode>()) {
+      StmtDoc last = stmt_block->stmts.back();
+      last->source_paths = std::move(doc->source_paths);
+      return last;
+    } else if (auto s = doc.as<StmtDoc>()) {
+      return s.value();
+    } else if (auto func = doc.as<FunctionDoc>()) {
+      return func.value();
+    } else if (auto expr = doc.as<ExprDoc>()) {
+      return AssignDoc(IdDoc(gv->name_hint), expr.value(), std::nullopt);
+    }
+    TVM_FFI_THROW(TypeError) << "Expected IRModule to only contain functions, "
+                             << " but mod[" << gv->name_hint << "] with type  "
+                             << base_func->GetTypeKey() << " produced Doc type of "
+                             << doc->GetTypeKey();
+    TVM_FFI_UNREACHABLE();
+  }();
+  return std::string(DocToPythonScript(stmt, cfg));
+}
+
+}  // namespace
+
+void StreamingScript(IRModule mod, std::ostream& os, PrinterConfig cfg, int num_threads) {
+  TVM_FFI_CHECK(!cfg->show_meta, ValueError)
+      << "show_meta is not supported by the streaming printer; "
+      << "metadata indices are only meaningful for a whole-module doc tree";
+  std::vector<SortableFunction> functions;
+  for (const auto& kv : mod->functions) {
+    functions.push_back(SortableFunction(kv));
+  }
+  std::sort(functions.begin(), functions.end());
+  ffi::String module_name =
+      cfg->binding_names.empty() ? ffi::String("Module") : cfg->binding_names.back();
+  // Header comments are derived from the member kinds: the docsifiers that
+  // would normally accumulate `ir_usage` only exist one function at a time.
+  bool uses_tir = false;
+  bool uses_relax = false;
+  for (const auto& entry : functions) {
+    if (!entry.func.defined()) {
+      continue;
+    }
+    if (entry.func->GetTypeKey() == "tirx.PrimFunc") {
+      uses_tir = true;
+    } else {
+      uses_relax = true;
+    }
+  }
+  os << "# from tvm.script import ir as " << cfg->ir_prefix << "\n";
+  if (uses_tir) {
+    os << "# from tvm.script import tirx as "
+       << cfg->GetExtraConfig<ffi::String>("tirx.prefix", "T") << "\n";
+    os << "# from tvm.tirx.layout import Axis\n";
+  }
+  if (uses_relax) {
+    os << "# from tvm.script import relax as "
+       << cfg->GetExtraConfig<ffi::String>("relax.prefix", "R") << "\n";
+  }
+  os << "#\n\n";
+  os << "@" << cfg->ir_prefix << ".ir_module\n";
+  os << "class " << module_name << ":\n";
+  bool has_members = false;
+  // Module-level attributes and global infos are small; render them with a
+  // short-lived docsifier just like the members.
+  {
+    PrinterConfig mod_cfg = CopyConfig(cfg);
+    IRDocsifier d(mod_cfg);
+    With<IRFrame> f(d);
+    (*f)->AddDispatchToken(d, "ir");
+    AccessPath p = AccessPath::Root();
+    d->Define(mod, f(), module_name);
+    std::vector<StmtDoc> stmts;
+    if (!mod->attrs->dict.empty()) {
+      stmts.push_back(
+          ExprStmtDoc(IR(d, "module_attrs")  //
+                          ->Call({d->AsDoc<ExprDoc>(mod->attrs, p->Attr("attrs"))})));
+    }
+    if (mod->global_infos.defined() && !mod->global_infos.empty()) {
+      stmts.push_back(ExprStmtDoc(
+          IR(d, "module_global_infos")  //
+              ->Call({d->AsDoc<ExprDoc>(mod->global_infos, p->Attr("global_infos"))})));
+    }
+    for (const StmtDoc& stmt : stmts) {
+      WriteIndented(std::string(DocToPythonScript(stmt, mod_cfg)), cfg->indent_spaces, os);
+      has_members = true;
+    }
+  }
+  size_t num_functions = functions.size();
+  if (num_threads > 1 && num_functions > 1) {
+    // Render independent functions in parallel, then write the pieces out in
+    // the deterministic order. Only the rendered strings are buffered; the
+    // per-function doc trees are still bounded by the worker lifetime.
+    std::vector<std::string> pieces(num_functions);
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+      for (size_t i = next.fetch_add(1); i < num_functions; i = next.fetch_add(1)) {
+        pieces[i] = ScriptModuleMember(mod, functions[i], cfg, module_name);
+      }
+    };
+    size_t num_workers = std::min<size_t>(num_threads, num_functions);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i + 1 < num_workers; ++i) {
+      threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& t : threads) {
+      t.join();
+    }
+    for (const std::string& piece : pieces) {
+      if (has_members) {
+        os << '\n';
+      }
+      WriteIndented(piece, cfg->indent_spaces, os);
+      has_members = true;
+    }
+  } else {
+    for (const SortableFunction& entry : functions) {
+      if (has_members) {
+        os << '\n';
+      }
+      WriteIndented(ScriptModuleMember(mod, entry, cfg, module_name), cfg->indent_spaces, os);
+      has_members = true;
+    }
+  }
+  if (!has_members) {
+    os << std::string(cfg->indent_spaces, ' ') << "pass\n";
+  }
+}
+
 }  // namespace printer
 }  // namespace script
+
+void ScriptStreaming(const IRModule& mod, std::ostream& os,
+                     const ffi::Optional<PrinterConfig>& config, int num_threads) {
+  script::printer::StreamingScript(mod, os, config.value_or(PrinterConfig()), num_threads);
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def(
+      "node.TVMScriptPrinterScriptToFile",
+      [](IRModule mod, ffi::String path, ffi::Optional<PrinterConfig> cfg, int num_threads) {
+        std::ofstream os(std::string(path));
+        TVM_FFI_CHECK(os.good(), ValueError) << "Cannot open file for writing: " << path;
+        ScriptStreaming(mod, os, cfg, num_threads);
+      });
+}
+
 }  // namespace tvm
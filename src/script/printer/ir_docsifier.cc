@@ -195,6 +195,10 @@ void IRDocsifierNode::SetCommonPrefix(const ffi::ObjectRef& root,
 IRDocsifier::IRDocsifier(const PrinterConfig& cfg) {
   auto n = ffi::make_object<IRDocsifierNode>();
   n->cfg = cfg;
+  n->ir_prefix = cfg->ir_prefix;
+  n->tir_prefix = cfg->GetExtraConfig<ffi::String>("tirx.prefix", "T");
+  n->relax_prefix = cfg->GetExtraConfig<ffi::String>("relax.prefix", "R");
+  n->relax_show_all_ty = cfg->GetExtraConfig<bool>("relax.show_all_ty", true);
   n->dispatch_tokens.push_back("");
   // Define builtin keywords according to cfg.
   for (const ffi::String& keyword : cfg->GetBuiltinKeywords()) {
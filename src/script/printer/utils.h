@@ -96,13 +96,13 @@ inline std::string Docsify(const ffi::ObjectRef& obj, const IRDocsifier& d, cons
 /*! \brief Creates the IR common prefix, which is by default `I` */
 inline ExprDoc IR(const IRDocsifier& d, const ffi::String& attr) {
   d->ir_usage.insert("ir");
-  return IdDoc(d->cfg->ir_prefix)->Attr(attr);
+  return IdDoc(d->ir_prefix)->Attr(attr);
 }
 
 /*! \brief Creates the TIR common prefix, which is by default `T` */
 inline ExprDoc TIR(const IRDocsifier& d, const ffi::String& attr) {
   d->ir_usage.insert("tirx");
-  return IdDoc(d->cfg->GetExtraConfig<ffi::String>("tirx.prefix", "T"))->Attr(attr);
+  return IdDoc(d->tir_prefix)->Attr(attr);
 }
 
 /*! \brief Alias for TIR — historical TIRx name used by tirx printer code */
@@ -111,7 +111,7 @@ inline ExprDoc TIRx(const IRDocsifier& d, const ffi::String& attr) { return TIR(
 /*! \brief Creates the Relax common prefix, which is by default `R` */
 inline ExprDoc Relax(const IRDocsifier& d, const ffi::String& attr) {
   d->ir_usage.insert("relax");
-  return IdDoc(d->cfg->GetExtraConfig<ffi::String>("relax.prefix", "R"))->Attr(attr);
+  return IdDoc(d->relax_prefix)->Attr(attr);
 }
 
 inline std::string DType2Str(DLDataType dtype) {
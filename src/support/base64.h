@@ -29,10 +29,21 @@
 #include <tvm/ffi/error.h>
 #include <tvm/support/io.h>
 
+#include <algorithm>
 #include <cctype>
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <string>
 
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define TVM_BASE64_SIMD_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define TVM_BASE64_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
 namespace tvm {
 namespace support {
 /*! \brief namespace of base64 decoding and encoding table */
@@ -53,6 +64,255 @@ const char DecodeTable[] = {
 // encoding table
 static const char EncodeTable[] =
     "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/*! \brief whether the character belongs to the base64 alphabet, padding excluded */
+inline bool IsBase64Char(int ch) {
+  return (ch >= 'A' && ch <= 'Z') || (ch >= 'a' && ch <= 'z') || (ch >= '0' && ch <= '9') ||
+         ch == '+' || ch == '/';
+}
+
+/*!
+ * \brief Encode full 3-byte groups from a contiguous buffer.
+ * \param src The input bytes, at least 3 * num_groups long.
+ * \param num_groups The number of 3-byte groups to encode.
+ * \param dst The output characters, at least 4 * num_groups long.
+ */
+inline void EncodeGroupsScalar(const unsigned char* src, size_t num_groups, char* dst) {
+  for (size_t i = 0; i < num_groups; ++i, src += 3, dst += 4) {
+    uint32_t v = (static_cast<uint32_t>(src[0]) << 16) | (static_cast<uint32_t>(src[1]) << 8) |
+                 static_cast<uint32_t>(src[2]);
+    dst[0] = EncodeTable[(v >> 18) & 0x3F];
+    dst[1] = EncodeTable[(v >> 12) & 0x3F];
+    dst[2] = EncodeTable[(v >> 6) & 0x3F];
+    dst[3] = EncodeTable[v & 0x3F];
+  }
+}
+
+/*!
+ * \brief Decode full 4-character groups from a contiguous buffer.
+ * \param src The input characters, at least 4 * num_groups long.
+ * \param num_groups The number of 4-character groups to decode.
+ * \param dst The output bytes, at least 3 * num_groups long.
+ * \return The number of groups decoded. Decoding stops before the first group
+ *  that contains a character outside the base64 alphabet (padding, whitespace
+ *  or garbage); the caller handles that group through its per-character path.
+ */
+inline size_t DecodeGroupsScalar(const char* src, size_t num_groups, unsigned char* dst) {
+  for (size_t i = 0; i < num_groups; ++i, src += 4, dst += 3) {
+    if (!IsBase64Char(src[0]) || !IsBase64Char(src[1]) || !IsBase64Char(src[2]) ||
+        !IsBase64Char(src[3])) {
+      return i;
+    }
+    uint32_t v = (static_cast<uint32_t>(DecodeTable[static_cast<int>(src[0])]) << 18) |
+                 (static_cast<uint32_t>(DecodeTable[static_cast<int>(src[1])]) << 12) |
+                 (static_cast<uint32_t>(DecodeTable[static_cast<int>(src[2])]) << 6) |
+                 static_cast<uint32_t>(DecodeTable[static_cast<int>(src[3])]);
+    dst[0] = (v >> 16) & 0xFF;
+    dst[1] = (v >> 8) & 0xFF;
+    dst[2] = v & 0xFF;
+  }
+  return num_groups;
+}
+
+#if TVM_BASE64_SIMD_X86
+/*!
+ * \brief Whether the host supports SSSE3.
+ * \note The codec below only needs pshufb, which predates every CPU we target,
+ *  but the build may not pass -mssse3, so the kernels carry a target attribute
+ *  and are selected at runtime.
+ */
+inline bool HasSSSE3() {
+  static const bool supported = __builtin_cpu_supports("ssse3");
+  return supported;
+}
+
+/*!
+ * \brief SSSE3 kernel behind EncodeGroups, following the Mula-Lemire pshufb
+ *  scheme: split each 12-byte block into sixteen 6-bit indices with two
+ *  16-bit multiplies, then map index ranges onto ascii offsets with pshufb.
+ * \return The number of groups encoded; the remainder goes through the scalar path.
+ */
+__attribute__((target("ssse3"))) inline size_t EncodeGroupsSSSE3(const unsigned char* src,
+                                                                 size_t num_groups, char* dst) {
+  const __m128i shuf = _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+  const __m128i offset_lut =
+      _mm_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+  size_t done = 0;
+  // Each iteration loads 16 bytes but only consumes 12, so stay 6 groups away
+  // from the end of the caller's buffer and finish through the scalar path.
+  while (num_groups - done >= 6) {
+    __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    in = _mm_shuffle_epi8(in, shuf);
+    const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0FC0FC00));
+    const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+    const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003F03F0));
+    const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+    const __m128i indices = _mm_or_si128(t1, t3);
+    // index -> ascii: pick the per-range offset, then add it to the index.
+    __m128i offset_idx = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    offset_idx = _mm_sub_epi8(offset_idx, _mm_cmpgt_epi8(indices, _mm_set1_epi8(25)));
+    const __m128i ascii = _mm_add_epi8(indices, _mm_shuffle_epi8(offset_lut, offset_idx));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), ascii);
+    src += 12;
+    dst += 16;
+    done += 4;
+  }
+  return done;
+}
+
+/*!
+ * \brief SSSE3 kernel behind DecodeGroups: classify characters through two
+ *  nibble luts (rejecting anything outside the alphabet), roll ascii down to
+ *  6-bit values, and pack them with the maddubs/madd pair.
+ * \return The number of groups decoded; stops before the first 16-character
+ *  block holding a non-alphabet character.
+ */
+__attribute__((target("ssse3"))) inline size_t DecodeGroupsSSSE3(const char* src,
+                                                                 size_t num_groups,
+                                                                 unsigned char* dst) {
+  const __m128i lut_lo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                       0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+  const __m128i lut_hi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10,
+                                       0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+  const __m128i lut_roll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m128i mask_2f = _mm_set1_epi8(0x2F);
+  const __m128i nibble_mask = _mm_set1_epi8(0x0F);
+  const __m128i pack_shuf =
+      _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+  size_t done = 0;
+  // Each iteration consumes 16 characters but stores 16 bytes of which only
+  // 12 are payload, so stay 6 groups away from the end of the output buffer.
+  while (num_groups - done >= 6) {
+    const __m128i str = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    const __m128i hi_nib = _mm_and_si128(_mm_srli_epi32(str, 4), nibble_mask);
+    const __m128i lo_nib = _mm_and_si128(str, nibble_mask);
+    const __m128i hi = _mm_shuffle_epi8(lut_hi, hi_nib);
+    const __m128i lo = _mm_shuffle_epi8(lut_lo, lo_nib);
+    if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())) != 0) {
+      break;
+    }
+    const __m128i eq_2f = _mm_cmpeq_epi8(str, mask_2f);
+    const __m128i roll = _mm_shuffle_epi8(lut_roll, _mm_add_epi8(eq_2f, hi_nib));
+    const __m128i sextets = _mm_add_epi8(str, roll);
+    const __m128i merge_ab_bc = _mm_maddubs_epi16(sextets, _mm_set1_epi32(0x01400140));
+    const __m128i merged = _mm_madd_epi16(merge_ab_bc, _mm_set1_epi32(0x00011000));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_shuffle_epi8(merged, pack_shuf));
+    src += 16;
+    dst += 12;
+    done += 4;
+  }
+  return done;
+}
+#elif TVM_BASE64_SIMD_NEON
+/*!
+ * \brief NEON kernel behind EncodeGroups: deinterleave 48 bytes with vld3,
+ *  slice out the sixteen sextet lanes with shifts, and run the 64-entry
+ *  encode table through vqtbl4q.
+ * \return The number of groups encoded; the remainder goes through the scalar path.
+ */
+inline size_t EncodeGroupsNeon(const unsigned char* src, size_t num_groups, char* dst) {
+  uint8x16x4_t table;
+  table.val[0] = vld1q_u8(reinterpret_cast<const uint8_t*>(EncodeTable));
+  table.val[1] = vld1q_u8(reinterpret_cast<const uint8_t*>(EncodeTable) + 16);
+  table.val[2] = vld1q_u8(reinterpret_cast<const uint8_t*>(EncodeTable) + 32);
+  table.val[3] = vld1q_u8(reinterpret_cast<const uint8_t*>(EncodeTable) + 48);
+  size_t done = 0;
+  while (num_groups - done >= 16) {
+    uint8x16x3_t in = vld3q_u8(src);
+    uint8x16x4_t out;
+    out.val[0] = vshrq_n_u8(in.val[0], 2);
+    out.val[1] =
+        vorrq_u8(vshlq_n_u8(vandq_u8(in.val[0], vdupq_n_u8(0x03)), 4), vshrq_n_u8(in.val[1], 4));
+    out.val[2] =
+        vorrq_u8(vshlq_n_u8(vandq_u8(in.val[1], vdupq_n_u8(0x0F)), 2), vshrq_n_u8(in.val[2], 6));
+    out.val[3] = vandq_u8(in.val[2], vdupq_n_u8(0x3F));
+    for (int k = 0; k < 4; ++k) {
+      out.val[k] = vqtbl4q_u8(table, out.val[k]);
+    }
+    vst4q_u8(reinterpret_cast<uint8_t*>(dst), out);
+    src += 48;
+    dst += 64;
+    done += 16;
+  }
+  return done;
+}
+
+/*!
+ * \brief NEON kernel behind DecodeGroups: deinterleave 64 characters with
+ *  vld4, classify and roll them to sextets with the same nibble luts as the
+ *  SSSE3 kernel, and reinterleave the packed bytes with vst3.
+ * \return The number of groups decoded; stops before the first 64-character
+ *  block holding a non-alphabet character.
+ */
+inline size_t DecodeGroupsNeon(const char* src, size_t num_groups, unsigned char* dst) {
+  static const uint8_t kLutLo[16] = {0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                     0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A};
+  static const uint8_t kLutHi[16] = {0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                     0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10};
+  // offsets are added modulo 256: 0xBF = -65 ('A' -> 0), 0xB9 = -71 ('a' -> 26)
+  static const uint8_t kLutRoll[16] = {0, 16, 19, 4, 0xBF, 0xBF, 0xB9, 0xB9, 0, 0, 0, 0, 0, 0, 0,
+                                       0};
+  const uint8x16_t lut_lo = vld1q_u8(kLutLo);
+  const uint8x16_t lut_hi = vld1q_u8(kLutHi);
+  const uint8x16_t lut_roll = vld1q_u8(kLutRoll);
+  size_t done = 0;
+  while (num_groups - done >= 16) {
+    uint8x16x4_t in = vld4q_u8(reinterpret_cast<const uint8_t*>(src));
+    uint8x16_t invalid = vdupq_n_u8(0);
+    uint8x16x4_t sextets;
+    for (int k = 0; k < 4; ++k) {
+      const uint8x16_t str = in.val[k];
+      const uint8x16_t lo_nib = vandq_u8(str, vdupq_n_u8(0x0F));
+      const uint8x16_t hi_nib = vshrq_n_u8(str, 4);
+      invalid = vorrq_u8(invalid, vandq_u8(vqtbl1q_u8(lut_lo, lo_nib), vqtbl1q_u8(lut_hi, hi_nib)));
+      const uint8x16_t eq_2f = vceqq_u8(str, vdupq_n_u8(0x2F));
+      sextets.val[k] = vaddq_u8(str, vqtbl1q_u8(lut_roll, vaddq_u8(hi_nib, eq_2f)));
+    }
+    if (vmaxvq_u8(invalid) != 0) break;
+    uint8x16x3_t out;
+    out.val[0] = vorrq_u8(vshlq_n_u8(sextets.val[0], 2), vshrq_n_u8(sextets.val[1], 4));
+    out.val[1] = vorrq_u8(vshlq_n_u8(sextets.val[1], 4), vshrq_n_u8(sextets.val[2], 2));
+    out.val[2] = vorrq_u8(vshlq_n_u8(sextets.val[2], 6), sextets.val[3]);
+    vst3q_u8(dst, out);
+    src += 64;
+    dst += 48;
+    done += 16;
+  }
+  return done;
+}
+#endif  // TVM_BASE64_SIMD_X86 / TVM_BASE64_SIMD_NEON
+
+/*!
+ * \brief Encode full 3-byte groups from a contiguous buffer, vectorized when
+ *  the host supports it.
+ * \param src The input bytes, at least 3 * num_groups long.
+ * \param num_groups The number of 3-byte groups to encode.
+ * \param dst The output characters, at least 4 * num_groups long.
+ */
+inline void EncodeGroups(const unsigned char* src, size_t num_groups, char* dst) {
+  size_t done = 0;
+#if TVM_BASE64_SIMD_X86
+  if (HasSSSE3()) done = EncodeGroupsSSSE3(src, num_groups, dst);
+#elif TVM_BASE64_SIMD_NEON
+  done = EncodeGroupsNeon(src, num_groups, dst);
+#endif
+  EncodeGroupsScalar(src + 3 * done, num_groups - done, dst + 4 * done);
+}
+
+/*!
+ * \brief Decode full 4-character groups from a contiguous buffer, vectorized
+ *  when the host supports it. Same contract as DecodeGroupsScalar.
+ */
+inline size_t DecodeGroups(const char* src, size_t num_groups, unsigned char* dst) {
+  size_t done = 0;
+#if TVM_BASE64_SIMD_X86
+  if (HasSSSE3()) done = DecodeGroupsSSSE3(src, num_groups, dst);
+#elif TVM_BASE64_SIMD_NEON
+  done = DecodeGroupsNeon(src, num_groups, dst);
+#endif
+  done += DecodeGroupsScalar(src + 4 * done, num_groups - done, dst + 3 * done);
+  return done;
+}
 }  // namespace base64
 
 /*!
@@ -86,6 +346,15 @@ class StreamBufferReader {
   }
   /*! \return whether we are reaching the end of file */
   bool AtEnd() const { return read_len_ == 0; }
+  /*! \return pointer to the buffered bytes that have not been consumed yet */
+  const char* BufferedData() const { return buffer_.data() + read_ptr_; }
+  /*! \return the number of buffered bytes that have not been consumed yet */
+  size_t BufferedBytes() const { return read_len_ - read_ptr_; }
+  /*!
+   * \brief Mark nbytes of buffered data as consumed.
+   * \param nbytes The number of bytes, at most BufferedBytes().
+   */
+  void Skip(size_t nbytes) { read_ptr_ += nbytes; }
 
  private:
   /*! \brief the underlying stream */
@@ -103,7 +372,9 @@ class StreamBufferReader {
  */
 class Base64InStream : public tvm::support::Stream {
  public:
-  explicit Base64InStream(tvm::support::Stream* fs) : reader_(256) { reader_.set_stream(fs); }
+  explicit Base64InStream(tvm::support::Stream* fs) : reader_(kDecodeChunkSize) {
+    reader_.set_stream(fs);
+  }
   /*!
    * \brief initialize the stream position to beginning of next base64 stream
    * \note call this function before actually start read
@@ -148,6 +419,25 @@ class Base64InStream : public tvm::support::Stream {
       }
     }
     if (tlen == 0) return size;
+    // Bulk-decode whole 4-character groups straight out of the reader's
+    // buffer. The per-character loop below keeps one lookahead character in
+    // temp_ch_, so the staging chunk is that character followed by whatever
+    // the reader has buffered. Decoding stops before any group that holds
+    // padding, whitespace or EOF, which the loop below then deals with.
+    while (tlen >= 3 && base64::IsBase64Char(temp_ch_)) {
+      char chunk[kDecodeChunkSize + 1];
+      chunk[0] = static_cast<char>(temp_ch_);
+      size_t nbuffered = std::min(reader_.BufferedBytes(), sizeof(chunk) - 1);
+      std::memcpy(chunk + 1, reader_.BufferedData(), nbuffered);
+      size_t num_groups = std::min((nbuffered + 1) / 4, tlen / 3);
+      size_t done = num_groups == 0 ? 0 : base64::DecodeGroups(chunk, num_groups, cptr);
+      if (done == 0) break;
+      reader_.Skip(4 * done - 1);
+      cptr += 3 * done;
+      tlen -= 3 * done;
+      temp_ch_ = reader_.GetChar();
+    }
+    if (tlen == 0) return size;
     int nvalue;
     // note: everything goes with 4 bytes in Base64
     // so we process 4 bytes a unit
@@ -213,6 +503,8 @@ class Base64InStream : public tvm::support::Stream {
   }
 
  private:
+  /*! \brief size of the reader buffer, and thus of one bulk decode chunk */
+  static constexpr size_t kDecodeChunkSize = 4096;
   // internal reader
   StreamBufferReader reader_;
   int temp_ch_{0};
@@ -236,6 +528,19 @@ class Base64OutStream : public tvm::support::Stream {
     size_t tlen = size;
     const unsigned char* cptr = static_cast<const unsigned char*>(ptr);
     while (tlen) {
+      // Bulk-encode whole 3-byte groups straight into the output buffer once
+      // the carry buffer is empty; the head and tail of the write fall
+      // through to the per-character path below.
+      if (buf__top_ == 0 && tlen >= 3) {
+        size_t num_groups = std::min(tlen / 3, kBulkWriteGroups);
+        size_t pos = out_buf_.size();
+        out_buf_.resize(pos + num_groups * 4);
+        base64::EncodeGroups(cptr, num_groups, &out_buf_[pos]);
+        cptr += num_groups * 3;
+        tlen -= num_groups * 3;
+        if (out_buf_.length() >= kBufferSize) Flush();
+        continue;
+      }
       while (buf__top_ < 3 && tlen != 0) {
         buf_[++buf__top_] = *cptr++;
         --tlen;
@@ -280,6 +585,8 @@ class Base64OutStream : public tvm::support::Stream {
 
  private:
   static constexpr size_t kBufferSize = 256;
+  /*! \brief cap on groups per bulk write, bounding out_buf_ growth to 64KB */
+  static constexpr size_t kBulkWriteGroups = 16384;
 
   tvm::support::Stream* fp_{nullptr};
   int buf__top_{0};
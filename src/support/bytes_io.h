@@ -66,6 +66,12 @@ class BytesInStream : public Stream {
     return 0;
   }
 
+  /*! \return The current read position in the region. */
+  size_t Tell() const { return pos_; }
+
+  /*! \brief Move the read position to \p pos, clamped to the region size. */
+  void Seek(size_t pos) { pos_ = std::min(pos, size_); }
+
  private:
   const char* data_;
   size_t size_;
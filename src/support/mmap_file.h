@@ -0,0 +1,100 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file mmap_file.h
+ * \brief Read-only memory mapping of a file.
+ *
+ * The mapping is lazily paged in by the OS and the clean pages are shared
+ * through the page cache across processes mapping the same file. The pages are
+ * mapped copy-on-write so callers may write through the pointer without
+ * affecting the file.
+ */
+#ifndef TVM_SUPPORT_MMAP_FILE_H_
+#define TVM_SUPPORT_MMAP_FILE_H_
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <memory>
+#include <string>
+
+namespace tvm {
+namespace support {
+
+/*! \brief RAII holder of a copy-on-write file mapping. */
+class MMapFile {
+ public:
+  ~MMapFile() {
+#ifndef _WIN32
+    if (data_ != nullptr) {
+      munmap(data_, size_);
+    }
+#endif
+  }
+
+  MMapFile(const MMapFile&) = delete;
+  MMapFile& operator=(const MMapFile&) = delete;
+
+  /*! \return The base address of the mapping. */
+  char* data() const { return static_cast<char*>(data_); }
+  /*! \return The size of the mapping in bytes. */
+  size_t size() const { return size_; }
+
+  /*!
+   * \brief Map a file for reading.
+   * \param path The path of the file to map.
+   * \return The mapping, or nullptr if mapping is unsupported or failed,
+   *         in which case the caller should fall back to buffered reads.
+   */
+  static std::shared_ptr<MMapFile> Open(const std::string& path) {
+#ifndef _WIN32
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return nullptr;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+      close(fd);
+      return nullptr;
+    }
+    size_t size = static_cast<size_t>(st.st_size);
+    void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    // the mapping keeps its own reference to the file.
+    close(fd);
+    if (data == MAP_FAILED) return nullptr;
+    return std::shared_ptr<MMapFile>(new MMapFile(data, size));
+#else
+    return nullptr;
+#endif
+  }
+
+ private:
+  MMapFile(void* data, size_t size) : data_(data), size_(size) {}
+
+  void* data_{nullptr};
+  size_t size_{0};
+};
+
+}  // namespace support
+}  // namespace tvm
+
+#endif  // TVM_SUPPORT_MMAP_FILE_H_
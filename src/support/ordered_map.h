@@ -25,7 +25,6 @@
 #define TVM_SUPPORT_ORDERED_MAP_H_
 
 #include <functional>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -35,6 +34,11 @@ namespace support {
 /**
  * \brief An STL-like map that preserves insertion order.
  *
+ * Lookups go through a flat open-addressing table of indices into the
+ * element vector, so inserts never allocate per node. Maps at or below
+ * kLinearScanThreshold entries, which covers most pass-internal maps, skip
+ * the table entirely and scan the element vector.
+ *
  * \tparam K The key type.
  * \tparam V The value type.
  * \tparam Hash The hash function.
@@ -47,76 +51,59 @@ class OrderedMap {
  public:
   OrderedMap() = default;
 
-  /* \brief Explicit copy constructor
-   *
-   * The default copy constructor would copy both `elements_` and
-   * `elem_to_iter_`.  While this is the correct behavior for
-   * `elements_`, the copy of `elem_to_iter_` would contain references
-   * to the original's `element_`, rather than to its own
-   */
-  OrderedMap(const OrderedMap<K, V, Hash, KeyEqual>& other) : elements_(other.elements_) {
-    InitElementToIter();
-  }
-
-  /* \brief Explicit copy assignment
-   *
-   * Implemented in terms of the copy constructor, and the default
-   * move assignment.
+  /*
+   * The index table holds positions rather than references into
+   * `elements_`, so the compiler-generated copy and move operations are
+   * correct as-is.
    */
-  OrderedMap& operator=(const OrderedMap<K, V, Hash, KeyEqual>& other) {
-    return *this = OrderedMap(other);
-  }
-
+  OrderedMap(const OrderedMap<K, V, Hash, KeyEqual>&) = default;
+  OrderedMap& operator=(const OrderedMap<K, V, Hash, KeyEqual>&) = default;
   OrderedMap(OrderedMap<K, V, Hash, KeyEqual>&&) = default;
   OrderedMap& operator=(OrderedMap<K, V, Hash, KeyEqual>&&) = default;
 
   template <typename Iter>
   OrderedMap(Iter begin, Iter end) : elements_(begin, end) {
-    InitElementToIter();
+    if (elements_.size() > kLinearScanThreshold) {
+      Rehash(TableSizeFor(elements_.size()));
+    }
   }
 
   auto find(const K& k) {
-    auto it = elem_to_index_.find(k);
-    if (it != elem_to_index_.end()) {
-      return elements_.begin() + it->second;
-    }
-    return elements_.end();
+    size_t i = FindIndex(k);
+    return i == kNotFound ? elements_.end() : elements_.begin() + i;
   }
 
   auto find(const K& k) const {
-    auto it = elem_to_index_.find(k);
-    if (it != elem_to_index_.end()) {
-      return elements_.begin() + it->second;
-    }
-    return elements_.end();
+    size_t i = FindIndex(k);
+    return i == kNotFound ? elements_.end() : elements_.begin() + i;
   }
 
   V& operator[](const K& k) {
-    auto it = elem_to_index_.find(k);
-    if (it != elem_to_index_.end()) {
-      return elements_[it->second].second;
+    size_t i = FindIndex(k);
+    if (i != kNotFound) {
+      return elements_[i].second;
     }
     elements_.emplace_back(k, V());
-    elem_to_index_[k] = elements_.size() - 1;
+    OnInserted();
     return elements_.back().second;
   }
 
   void insert(const K& k, V v) {
-    auto it = elem_to_index_.find(k);
-    if (it != elem_to_index_.end()) {
-      elements_[it->second].second = std::move(v);
+    size_t i = FindIndex(k);
+    if (i != kNotFound) {
+      elements_[i].second = std::move(v);
     } else {
-      elements_.emplace_back(k, v);
-      elem_to_index_[k] = elements_.size() - 1;
+      elements_.emplace_back(k, std::move(v));
+      OnInserted();
     }
   }
 
   void clear() {
     elements_.clear();
-    elem_to_index_.clear();
+    index_.clear();
   }
 
-  size_t count(const K& k) const { return elem_to_index_.count(k); }
+  size_t count(const K& k) const { return FindIndex(k) == kNotFound ? 0 : 1; }
 
   auto begin() const { return elements_.begin(); }
   auto end() const { return elements_.end(); }
@@ -126,17 +113,87 @@ class OrderedMap {
   size_t size() const { return elements_.size(); }
   bool empty() const { return elements_.empty(); }
 
-  void reserve(size_t n) { elem_to_index_.reserve(n); }
+  void reserve(size_t n) {
+    elements_.reserve(n);
+    if (n > kLinearScanThreshold) {
+      size_t table_size = TableSizeFor(n);
+      if (table_size > index_.size()) Rehash(table_size);
+    }
+  }
 
  private:
-  void InitElementToIter() {
-    for (size_t i = 0; i < elements_.size(); i++) {
-      elem_to_index_[elements_[i].first] = i;
+  /*! \brief sentinel for both FindIndex misses and empty table slots */
+  static constexpr size_t kNotFound = static_cast<size_t>(-1);
+  /*! \brief largest size served by a plain scan of the element vector */
+  static constexpr size_t kLinearScanThreshold = 8;
+
+  /*! \return the power-of-two table size keeping n entries under 3/4 load */
+  static size_t TableSizeFor(size_t n) {
+    size_t table_size = kLinearScanThreshold * 4;
+    while (table_size * 3 < n * 4) table_size *= 2;
+    return table_size;
+  }
+
+  /*! \return the position of k in elements_, or kNotFound */
+  size_t FindIndex(const K& k) const {
+    if (index_.empty()) {
+      // Scan newest-first: recently inserted keys are the likeliest probes,
+      // and duplicate keys from the range constructor must resolve to the
+      // last occurrence, as they did with the previous backing map.
+      for (size_t i = elements_.size(); i > 0; --i) {
+        if (equal_(elements_[i - 1].first, k)) return i - 1;
+      }
+      return kNotFound;
+    }
+    size_t mask = index_.size() - 1;
+    for (size_t i = hash_(k) & mask;; i = (i + 1) & mask) {
+      size_t pos = index_[i];
+      if (pos == kNotFound) return kNotFound;
+      if (equal_(elements_[pos].first, k)) return pos;
+    }
+  }
+
+  /*!
+   * \brief Link the element at elem_index into the table by linear probing.
+   * \note An occupied slot with an equal key is overwritten so that, as with
+   *  the previous backing map, the range constructor resolves duplicate keys
+   *  to the last occurrence.
+   */
+  void InsertSlot(size_t elem_index) {
+    size_t mask = index_.size() - 1;
+    size_t i = hash_(elements_[elem_index].first) & mask;
+    while (index_[i] != kNotFound &&
+           !equal_(elements_[index_[i]].first, elements_[elem_index].first)) {
+      i = (i + 1) & mask;
+    }
+    index_[i] = elem_index;
+  }
+
+  /*! \brief Maintain the index table after a push onto elements_. */
+  void OnInserted() {
+    size_t n = elements_.size();
+    if (index_.empty()) {
+      if (n <= kLinearScanThreshold) return;
+      Rehash(kLinearScanThreshold * 4);
+    } else if (n * 4 > index_.size() * 3) {
+      Rehash(index_.size() * 2);
+    } else {
+      InsertSlot(n - 1);
+    }
+  }
+
+  void Rehash(size_t table_size) {
+    index_.assign(table_size, kNotFound);
+    for (size_t i = 0; i < elements_.size(); ++i) {
+      InsertSlot(i);
     }
   }
 
   std::vector<std::pair<K, V>> elements_;
-  std::unordered_map<K, size_t, Hash, KeyEqual> elem_to_index_;
+  /*! \brief open-addressing table of positions in elements_; empty in scan mode */
+  std::vector<size_t> index_;
+  Hash hash_;
+  KeyEqual equal_;
 };
 
 }  // namespace support
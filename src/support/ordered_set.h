@@ -25,60 +25,59 @@
 #define TVM_SUPPORT_ORDERED_SET_H_
 
 #include <functional>
-#include <unordered_map>
 #include <vector>
 
 namespace tvm {
 namespace support {
 
+/**
+ * \brief An STL-like set that preserves insertion order.
+ *
+ * Membership checks go through a flat open-addressing table of indices into
+ * the element vector, so inserts never allocate per node. Sets at or below
+ * kLinearScanThreshold entries, which covers most pass-internal sets, skip
+ * the table entirely and scan the element vector.
+ *
+ * \tparam T The element type.
+ * \tparam Hash The hash function.
+ * \tparam KeyEqual The element equality function.
+ */
 template <typename T, typename Hash = std::hash<T>, typename KeyEqual = std::equal_to<T>>
 class OrderedSet {
  public:
   OrderedSet() = default;
 
-  /* \brief Explicit copy constructor
-   *
-   * The default copy constructor would copy both `elements_` and
-   * `elem_to_iter_`.  While this is the correct behavior for
-   * `elements_`, the copy of `elem_to_iter_` would contain references
-   * to the original's `element_`, rather than to its own
-   */
-  OrderedSet(const OrderedSet<T, Hash, KeyEqual>& other) : elements_(other.elements_) {
-    InitElementToIter();
-  }
-
-  /* \brief Explicit copy assignment
-   *
-   * Implemented in terms of the copy constructor, and the default
-   * move assignment.
+  /*
+   * The index table holds positions rather than references into
+   * `elements_`, so the compiler-generated copy and move operations are
+   * correct as-is.
    */
-  OrderedSet& operator=(const OrderedSet<T, Hash, KeyEqual>& other) {
-    return *this = OrderedSet(other);
-  }
-
+  OrderedSet(const OrderedSet<T, Hash, KeyEqual>&) = default;
+  OrderedSet& operator=(const OrderedSet<T, Hash, KeyEqual>&) = default;
   OrderedSet(OrderedSet<T, Hash, KeyEqual>&&) = default;
   OrderedSet& operator=(OrderedSet<T, Hash, KeyEqual>&&) = default;
 
   template <typename Iter>
-  OrderedSet(Iter begin, Iter end) : elements_(begin, end) {
-    InitElementToIter();
+  OrderedSet(Iter begin, Iter end) {
+    for (Iter it = begin; it != end; ++it) {
+      push_back(*it);
+    }
   }
 
   void push_back(const T& t) {
-    if (!elem_to_index_.count(t)) {
-      elements_.push_back(t);
-      elem_to_index_[t] = elements_.size() - 1;
-    }
+    if (FindIndex(t) != kNotFound) return;
+    elements_.push_back(t);
+    OnInserted();
   }
 
   void insert(const T& t) { push_back(t); }
 
   void clear() {
     elements_.clear();
-    elem_to_index_.clear();
+    index_.clear();
   }
 
-  size_t count(const T& t) const { return elem_to_index_.count(t); }
+  size_t count(const T& t) const { return FindIndex(t) == kNotFound ? 0 : 1; }
 
   auto begin() const { return elements_.begin(); }
   auto end() const { return elements_.end(); }
@@ -86,14 +85,63 @@ class OrderedSet {
   auto empty() const { return elements_.empty(); }
 
  private:
-  void InitElementToIter() {
+  /*! \brief sentinel for both FindIndex misses and empty table slots */
+  static constexpr size_t kNotFound = static_cast<size_t>(-1);
+  /*! \brief largest size served by a plain scan of the element vector */
+  static constexpr size_t kLinearScanThreshold = 8;
+
+  /*! \return the position of t in elements_, or kNotFound */
+  size_t FindIndex(const T& t) const {
+    if (index_.empty()) {
+      // Scan newest-first: recently inserted elements are the likeliest probes.
+      for (size_t i = elements_.size(); i > 0; --i) {
+        if (equal_(elements_[i - 1], t)) return i - 1;
+      }
+      return kNotFound;
+    }
+    size_t mask = index_.size() - 1;
+    for (size_t i = hash_(t) & mask;; i = (i + 1) & mask) {
+      size_t pos = index_[i];
+      if (pos == kNotFound) return kNotFound;
+      if (equal_(elements_[pos], t)) return pos;
+    }
+  }
+
+  /*! \brief Link the element at elem_index into the table by linear probing. */
+  void InsertSlot(size_t elem_index) {
+    size_t mask = index_.size() - 1;
+    size_t i = hash_(elements_[elem_index]) & mask;
+    while (index_[i] != kNotFound) {
+      i = (i + 1) & mask;
+    }
+    index_[i] = elem_index;
+  }
+
+  /*! \brief Maintain the index table after a push onto elements_. */
+  void OnInserted() {
+    size_t n = elements_.size();
+    if (index_.empty()) {
+      if (n <= kLinearScanThreshold) return;
+      Rehash(kLinearScanThreshold * 4);
+    } else if (n * 4 > index_.size() * 3) {
+      Rehash(index_.size() * 2);
+    } else {
+      InsertSlot(n - 1);
+    }
+  }
+
+  void Rehash(size_t table_size) {
+    index_.assign(table_size, kNotFound);
     for (size_t i = 0; i < elements_.size(); ++i) {
-      elem_to_index_[elements_[i]] = i;
+      InsertSlot(i);
     }
   }
 
   std::vector<T> elements_;
-  std::unordered_map<T, size_t, Hash, KeyEqual> elem_to_index_;
+  /*! \brief open-addressing table of positions in elements_; empty in scan mode */
+  std::vector<size_t> index_;
+  Hash hash_;
+  KeyEqual equal_;
 };
 
 }  // namespace support
@@ -27,6 +27,9 @@
 #include <tvm/ffi/error.h>
 
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include <vector>
 
@@ -190,6 +193,153 @@ class RingBuffer {
   // The internal data ring.
   std::vector<char> ring_;
 };
+
+/*!
+ * \brief Lock-free single-producer single-consumer byte ring.
+ *
+ * Unlike RingBuffer above, one thread may write while another reads without
+ * any locking: the producer and consumer positions are monotonically
+ * increasing atomics on separate cache lines, each side additionally caching
+ * the other side's position so the common case touches only its own line.
+ *
+ * The capacity is a power of two fixed at construction; growing under
+ * concurrent access would need deferred reclamation of the old ring, which
+ * the buffering use cases do not justify. Data is produced and consumed in
+ * batches through reserve/commit pairs that expose contiguous, wrap-free
+ * regions of the ring, so both sides can operate zero-copy: a region never
+ * wraps, a batch larger than the distance to the end of the ring is simply
+ * split across two reserve/commit rounds.
+ */
+class SpscRingBuffer {
+ public:
+  /*!
+   * \brief Construct the ring.
+   * \param min_capacity Minimum capacity in bytes, rounded up to a power of two.
+   */
+  explicit SpscRingBuffer(size_t min_capacity = RingBuffer::kInitCapacity) {
+    size_t capacity = 1;
+    while (capacity < min_capacity) capacity <<= 1;
+    ring_.resize(capacity);
+    mask_ = capacity - 1;
+  }
+  /*! \return Capacity of the ring in bytes. */
+  size_t capacity() const { return ring_.size(); }
+  /*! \return Number of bytes currently buffered; safe to call from either side. */
+  size_t bytes_available() const {
+    return static_cast<size_t>(tail_.load(std::memory_order_acquire) -
+                               head_.load(std::memory_order_acquire));
+  }
+  /*!
+   * \brief Reserve a contiguous region to write into. Producer side only.
+   * \param avail_nbytes Filled with the size of the returned region.
+   * \return Pointer to the writable region, or nullptr if the ring is full.
+   */
+  void* BeginWrite(size_t* avail_nbytes) {
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    size_t free_bytes = capacity() - static_cast<size_t>(tail - cached_head_);
+    if (free_bytes == 0) {
+      cached_head_ = head_.load(std::memory_order_acquire);
+      free_bytes = capacity() - static_cast<size_t>(tail - cached_head_);
+    }
+    size_t offset = static_cast<size_t>(tail) & mask_;
+    *avail_nbytes = std::min(free_bytes, capacity() - offset);
+    return *avail_nbytes == 0 ? nullptr : &ring_[offset];
+  }
+  /*!
+   * \brief Publish bytes written into the region returned by BeginWrite.
+   * \param nbytes Number of bytes written, at most the reserved size.
+   */
+  void CommitWrite(size_t nbytes) {
+    tail_.store(tail_.load(std::memory_order_relaxed) + nbytes, std::memory_order_release);
+  }
+  /*!
+   * \brief Get a contiguous view of buffered bytes. Consumer side only.
+   * \param avail_nbytes Filled with the size of the returned view.
+   * \return Pointer to the readable view, or nullptr if the ring is empty.
+   */
+  const void* BeginRead(size_t* avail_nbytes) {
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    size_t buffered = static_cast<size_t>(cached_tail_ - head);
+    if (buffered == 0) {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+      buffered = static_cast<size_t>(cached_tail_ - head);
+    }
+    size_t offset = static_cast<size_t>(head) & mask_;
+    *avail_nbytes = std::min(buffered, capacity() - offset);
+    return *avail_nbytes == 0 ? nullptr : &ring_[offset];
+  }
+  /*!
+   * \brief Release bytes consumed from the view returned by BeginRead.
+   * \param nbytes Number of bytes consumed, at most the view size.
+   */
+  void CommitRead(size_t nbytes) {
+    head_.store(head_.load(std::memory_order_relaxed) + nbytes, std::memory_order_release);
+  }
+  /*!
+   * \brief Write a batch of bytes, all or nothing. Producer side only.
+   * \param data The data pointer.
+   * \param size The number of bytes to write.
+   * \return Whether the batch fit into the ring.
+   */
+  bool Write(const void* data, size_t size) {
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    if (capacity() - static_cast<size_t>(tail - cached_head_) < size) {
+      cached_head_ = head_.load(std::memory_order_acquire);
+      if (capacity() - static_cast<size_t>(tail - cached_head_) < size) return false;
+    }
+    const char* src = static_cast<const char*>(data);
+    while (size != 0) {
+      size_t nbytes;
+      void* dst = BeginWrite(&nbytes);
+      nbytes = std::min(nbytes, size);
+      memcpy(dst, src, nbytes);
+      CommitWrite(nbytes);
+      src += nbytes;
+      size -= nbytes;
+    }
+    return true;
+  }
+  /*!
+   * \brief Read a batch of bytes, all or nothing. Consumer side only.
+   * \param data The data pointer.
+   * \param size The number of bytes to read.
+   * \return Whether the batch was available.
+   */
+  bool Read(void* data, size_t size) {
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    if (static_cast<size_t>(cached_tail_ - head) < size) {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+      if (static_cast<size_t>(cached_tail_ - head) < size) return false;
+    }
+    char* dst = static_cast<char*>(data);
+    while (size != 0) {
+      size_t nbytes;
+      const void* src = BeginRead(&nbytes);
+      nbytes = std::min(nbytes, size);
+      memcpy(dst, src, nbytes);
+      CommitRead(nbytes);
+      dst += nbytes;
+      size -= nbytes;
+    }
+    return true;
+  }
+
+ private:
+  /*! \brief Assumed cache line size for separating the two sides. */
+  static constexpr size_t kCacheLineBytes = 64;
+  // The internal data ring; size is a power of two.
+  std::vector<char> ring_;
+  // capacity() - 1, for masking monotonic positions into ring offsets.
+  size_t mask_{0};
+  // Consumer position, monotonically increasing.
+  alignas(kCacheLineBytes) std::atomic<uint64_t> head_{0};
+  // Producer's cached copy of head_, refreshed only when the ring looks full.
+  alignas(kCacheLineBytes) uint64_t cached_head_{0};
+  // Producer position, monotonically increasing.
+  alignas(kCacheLineBytes) std::atomic<uint64_t> tail_{0};
+  // Consumer's cached copy of tail_, refreshed only when the ring looks empty.
+  alignas(kCacheLineBytes) uint64_t cached_tail_{0};
+};
 }  // namespace support
 }  // namespace tvm
 #endif  // TVM_SUPPORT_RING_BUFFER_H_
@@ -0,0 +1,164 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file codegen_params.cc
+ */
+#ifdef TVM_LLVM_VERSION
+
+#include "codegen_params.h"
+
+#include <llvm/ADT/StringRef.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/DataLayout.h>
+#include <llvm/IR/DerivedTypes.h>
+#include <llvm/IR/GlobalVariable.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/Alignment.h>
+#include <llvm/Support/SwapByteOrder.h>
+#if LLVM_VERSION_MAJOR >= 17
+#include <llvm/TargetParser/Triple.h>
+#else
+#include <llvm/ADT/Triple.h>
+#endif
+
+#include <string>
+
+namespace tvm {
+namespace codegen {
+
+namespace {
+
+/*!
+ * \brief Validate the tensor and return the flattened element count.
+ *
+ * Only contiguous, single-lane CPU tensors of 8/16/32/64-bit elements can be emitted
+ * directly over their buffer.
+ */
+int64_t CheckTensorLayout(const ::tvm::runtime::Tensor& arr) {
+  auto arr_type = arr.DataType();
+  TVM_FFI_ICHECK(arr.IsContiguous()) << "CodegenParams: only support contiguous arrays";
+  TVM_FFI_ICHECK_EQ(arr->device.device_type, kDLCPU)
+      << "CodegenParams: only support contiguous arrays";
+  TVM_FFI_ICHECK_EQ(arr_type.lanes, 1)
+      << "CodegenParams: only support generating 1-lane parameters; saw " << arr_type.lanes;
+  TVM_FFI_ICHECK(arr_type.bits == 8 || arr_type.bits == 16 || arr_type.bits == 32 ||
+                 arr_type.bits == 64)
+      << "CodegenParams: only support generating 8-, 16-, 32-, or 64-bit params; saw "
+      << arr_type.bits << "-bit array";
+
+  int64_t num_elements = 1;
+  for (auto shape_elem : arr.Shape()) {
+    num_elements *= shape_elem;
+  }
+  return num_elements;
+}
+
+}  // namespace
+
+llvm::Constant* TensorToLLVMArray(llvm::LLVMContext* ctx, ::tvm::runtime::Tensor arr) {
+  auto arr_type = arr.DataType();
+  int64_t num_elements = CheckTensorLayout(arr);
+
+  llvm::Type* element_type = nullptr;
+  switch (arr_type.code) {
+    case kDLInt:
+    case kDLUInt:
+      element_type = llvm::Type::getIntNTy(*ctx, arr_type.bits);
+      break;
+
+    case kDLFloat:
+      switch (arr_type.bits) {
+        case 16:
+          // NOTE: float16 is treated as uint16_t.
+          element_type = llvm::Type::getIntNTy(*ctx, arr_type.bits);
+          break;
+        case 32:
+          element_type = llvm::Type::getFloatTy(*ctx);
+          break;
+        case 64:
+          element_type = llvm::Type::getDoubleTy(*ctx);
+          break;
+        default:
+          TVM_FFI_ICHECK(false) << "CodegenParams: only support 32- or 64-bit floating point; saw "
+                                << arr_type.bits << "-bit array";
+          break;
+      }
+      break;
+
+    case kDLBfloat:
+      TVM_FFI_ICHECK(arr_type.bits == 16)
+          << "CodegenParams: only support 16-bit bfloat; saw " << arr_type.bits << "-bit array";
+      element_type = llvm::Type::getIntNTy(*ctx, arr_type.bits);
+      break;
+
+    default:
+      TVM_FFI_ICHECK(false) << "Data type not supported";
+  }
+
+  // Bulk emission over the tensor buffer: getRaw expects the elements in host byte
+  // order, which is how Tensor stores them, and LLVM re-encodes per the target's
+  // endianness when the module is emitted.
+  llvm::StringRef raw_data(static_cast<const char*>(arr->data),
+                           static_cast<size_t>(num_elements) * (arr_type.bits / 8));
+  return llvm::ConstantDataArray::getRaw(raw_data, static_cast<uint64_t>(num_elements),
+                                         element_type);
+}
+
+llvm::GlobalVariable* TensorToLLVMByteBlob(llvm::Module* module, ::tvm::runtime::Tensor arr,
+                                           const std::string& name) {
+  auto arr_type = arr.DataType();
+  int64_t num_elements = CheckTensorLayout(arr);
+  size_t num_bytes = static_cast<size_t>(num_elements) * (arr_type.bits / 8);
+
+  // The blob stores the buffer bytes verbatim, so host and target byte order must agree.
+  TVM_FFI_ICHECK_EQ(module->getDataLayout().isLittleEndian(), llvm::sys::IsLittleEndianHost)
+      << "CodegenParams: cannot emit a byte-blob param for a target whose endianness differs "
+         "from the host";
+
+  llvm::LLVMContext* ctx = &module->getContext();
+  llvm::StringRef raw_data(static_cast<const char*>(arr->data), num_bytes);
+  auto* blob_value = llvm::ConstantDataArray::getString(*ctx, raw_data, false);
+  auto* param_blob =
+      new llvm::GlobalVariable(*module, blob_value->getType(), true,
+                               llvm::GlobalValue::PrivateLinkage, blob_value, name, nullptr,
+                               llvm::GlobalVariable::NotThreadLocal, 0);
+
+  // Large const data (>1GB) in .rodata breaks shared-library links on x86_64 ELF
+  // (relocation truncated to fit: R_X86_64_PC32), so it is placed in .lrodata instead,
+  // mirroring the workaround in codegen_blob.cc.
+#if TVM_LLVM_VERSION >= 210
+  const llvm::Triple& triple = module->getTargetTriple();
+#else
+  llvm::Triple triple(module->getTargetTriple());
+#endif
+  const size_t large_data_threshold = 1 << 30;
+  if (num_bytes > large_data_threshold && triple.getArch() == llvm::Triple::x86_64 &&
+      triple.isOSBinFormatELF()) {
+    param_blob->setSection(".lrodata");
+  }
+  param_blob->setAlignment(llvm::Align(arr_type.bits / 8));
+  return param_blob;
+}
+
+}  // namespace codegen
+}  // namespace tvm
+
+#endif  // TVM_LLVM_VERSION
@@ -0,0 +1,72 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file codegen_params.h
+ */
+
+#ifndef TVM_TARGET_LLVM_CODEGEN_PARAMS_H_
+#define TVM_TARGET_LLVM_CODEGEN_PARAMS_H_
+
+#include <tvm/runtime/tensor.h>
+
+#include <string>
+
+namespace llvm {
+class Constant;
+class GlobalVariable;
+class LLVMContext;
+class Module;
+}  // namespace llvm
+
+namespace tvm {
+namespace codegen {
+
+/*!
+ * \brief Convert an Tensor to an LLVM array of constants.
+ *
+ * The supplied Tensor is flattened and emitted as a single `ConstantDataArray` directly
+ * over the tensor buffer, so no per-element `Constant` objects are materialized.
+ *
+ * \param ctx LLVM context used to create the various primitive datatypes.
+ * \param arr Tensor to convert.
+ * \return LLVM array containing the array data.
+ */
+llvm::Constant* TensorToLLVMArray(llvm::LLVMContext* ctx, tvm::runtime::Tensor arr);
+
+/*!
+ * \brief Emit an Tensor as an untyped byte-blob constant global.
+ *
+ * Unlike TensorToLLVMArray, the tensor bytes never enter LLVM as typed IR: the global is
+ * a plain i8 array over the raw buffer, which keeps very large parameters out of the
+ * optimizer entirely. The blob bakes the bytes in host order, so the module's target must
+ * have the same endianness as the host.
+ *
+ * \param module Module the global is created in; determines section placement.
+ * \param arr Tensor to emit.
+ * \param name Symbol name of the created global.
+ * \return the created read-only global holding the array data.
+ */
+llvm::GlobalVariable* TensorToLLVMByteBlob(llvm::Module* module, tvm::runtime::Tensor arr,
+                                           const std::string& name);
+
+}  // namespace codegen
+}  // namespace tvm
+
+#endif  // TVM_TARGET_LLVM_CODEGEN_PARAMS_H_
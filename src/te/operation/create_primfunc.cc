@@ -31,12 +31,14 @@
 #include <tvm/tirx/stmt_functor.h>
 
 #include <algorithm>
+#include <mutex>
 #include <set>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include "../../support/utils.h"
 #include "../../tirx/ir/data_type_rewriter.h"
 #include "../../tirx/ir/functor_common.h"
 #include "graph.h"
@@ -760,8 +762,84 @@ PrimFunc GenerateAndCompletePrimFunc(const ffi::Array<te::Tensor>& arg_list,
   return func;
 }
 
+/*!
+ * \brief Process-wide memo of lowered TE compute DAGs.
+ *
+ * Operator libraries instantiate the same compute expression thousands of
+ * times during tuning, and every instantiation used to redo op ordering,
+ * block rewriting and the bound analysis inside RewriteStageToBlock from
+ * scratch. The memo keys on the structural hash of the argument DAG, which
+ * covers op bodies, iteration axes and shapes, and verifies candidates with
+ * StructuralEqual before reuse so a hash collision cannot alias two different
+ * ops. Sharing one PrimFunc is safe because downstream transforms copy on
+ * write.
+ */
+class CreatePrimFuncMemo {
+ public:
+  static CreatePrimFuncMemo* Global() {
+    // NOTE: explicitly use new to avoid destruction order issues at process exit
+    static CreatePrimFuncMemo* inst = new CreatePrimFuncMemo();
+    return inst;
+  }
+
+  static uint64_t Key(const ffi::Array<ffi::ObjectRef>& arg_list,
+                      const std::optional<PrimType>& index_dtype_override) {
+    uint64_t key = ffi::StructuralHash()(arg_list);
+    if (index_dtype_override.has_value()) {
+      key = support::HashCombine(key, ffi::StructuralHash()(index_dtype_override.value()));
+    }
+    return key;
+  }
+
+  ffi::Optional<PrimFunc> Lookup(uint64_t key, const ffi::Array<ffi::ObjectRef>& arg_list,
+                                 const std::optional<PrimType>& index_dtype_override) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = memo_.find(key);
+    if (it == memo_.end()) {
+      return std::nullopt;
+    }
+    ffi::StructuralEqual eq;
+    for (const Entry& entry : it->second) {
+      if (entry.index_dtype_override.has_value() != index_dtype_override.has_value()) {
+        continue;
+      }
+      if (entry.index_dtype_override.has_value() &&
+          !eq(entry.index_dtype_override.value(), index_dtype_override.value())) {
+        continue;
+      }
+      if (eq(entry.arg_list, arg_list)) {
+        return entry.func;
+      }
+    }
+    return std::nullopt;
+  }
+
+  void Insert(uint64_t key, ffi::Array<ffi::ObjectRef> arg_list,
+              std::optional<PrimType> index_dtype_override, PrimFunc func) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    memo_[key].push_back(Entry{std::move(arg_list), std::move(index_dtype_override),
+                               std::move(func)});
+  }
+
+ private:
+  struct Entry {
+    ffi::Array<ffi::ObjectRef> arg_list;
+    std::optional<PrimType> index_dtype_override;
+    PrimFunc func;
+  };
+
+  std::mutex mutex_;
+  std::unordered_map<uint64_t, std::vector<Entry>> memo_;
+};
+
 PrimFunc CreatePrimFunc(const ffi::Array<te::Tensor>& arg_list,
                         std::optional<PrimType> index_dtype_override) {
+  ffi::Array<ffi::ObjectRef> memo_args(arg_list.begin(), arg_list.end());
+  CreatePrimFuncMemo* memo = CreatePrimFuncMemo::Global();
+  uint64_t memo_key = CreatePrimFuncMemo::Key(memo_args, index_dtype_override);
+  if (auto cached = memo->Lookup(memo_key, memo_args, index_dtype_override)) {
+    return cached.value();
+  }
   // Information used in CreatePrimFunc and its sub-functions.
   CreateFuncInfo info(arg_list);
   // Root body stmts.
@@ -786,6 +864,7 @@ PrimFunc CreatePrimFunc(const ffi::Array<te::Tensor>& arg_list,
     func = IndexDataTypeNormalizer(index_dtype_override.value()).Rewrite(std::move(func));
   }
   auto result = LayoutFreePlaceholdersNormalizer().Process(std::move(func));
+  memo->Insert(memo_key, std::move(memo_args), index_dtype_override, result);
   return result;
 }
 
@@ -834,6 +913,11 @@ PrimFunc GenerateAndCompletePrimFunc(const ffi::Array<ffi::ObjectRef>& arg_tir_v
 
 PrimFunc CreatePrimFunc(const ffi::Array<ffi::ObjectRef>& arg_list,
                         std::optional<PrimType> index_dtype_override) {
+  CreatePrimFuncMemo* memo = CreatePrimFuncMemo::Global();
+  uint64_t memo_key = CreatePrimFuncMemo::Key(arg_list, index_dtype_override);
+  if (auto cached = memo->Lookup(memo_key, arg_list, index_dtype_override)) {
+    return cached.value();
+  }
   ffi::Array<te::Tensor> tensor_arg_list;
   for (const ffi::ObjectRef& x : arg_list) {
     if (auto tensor_node = x.as<te::TensorNode>()) {
@@ -863,6 +947,7 @@ PrimFunc CreatePrimFunc(const ffi::Array<ffi::ObjectRef>& arg_list,
     func = IndexDataTypeNormalizer(index_dtype_override.value()).Rewrite(std::move(func));
   }
   auto result = LayoutFreePlaceholdersNormalizer().Process(std::move(func));
+  memo->Insert(memo_key, arg_list, index_dtype_override, result);
   return result;
 }
 
@@ -67,29 +67,33 @@ CheckContains::CheckContains(std::function<bool(const PrimExpr&)> predicate)
     : predicate_(predicate) {}
 
 /*!
- * \brief The method which overrides the generic dispatcher of StmtExprVisitor for expressions.
- * \param expr The expression to visit
+ * \brief The pre-order hook of IterativeStmtExprVisitor, called once per expression node.
+ * \param expr The expression about to be visited
+ * \return Whether the traversal should descend into `expr`
  */
-void CheckContains::VisitExpr(const PrimExpr& expr) {
+bool CheckContains::EnterExpr(const PrimExpr& expr) {
+  // Once the answer is known there is nothing left to look for
+  if (contains_it_) return false;
   // If the predicate holds on `expr`, we know `expr` contains something which makes
-  // the predicate hold
+  // the predicate hold, and there is no need to descend into it
   if (predicate_(expr)) {
     contains_it_ = true;
-  } else {
-    // Otherwise we continue to look for it recursively by calling the dispatcher
-    StmtExprVisitor::VisitExpr(expr);
+    return false;
   }
+  // Otherwise we continue to look for it in the subexpressions
+  return true;
 }
 
 /*!
- * \brief The method which overrides the generic dispatcher of StmtExprVisitor for statements.
+ * \brief The method which overrides the generic dispatcher of IterativeStmtExprVisitor
+          for statements.
  * \param stmt The statement to visit
  */
 void CheckContains::VisitStmt(const Stmt& stmt) {
   // We keep exploring only if `contains_it_` is false
   if (!contains_it_) {
     // and in order to do that we call the general dispatcher
-    StmtExprVisitor::VisitStmt(stmt);
+    IterativeStmtExprVisitor::VisitStmt(stmt);
   }
   // As otherwise we already have our answer
 }
@@ -27,7 +27,7 @@
 #define TVM_TIR_ANALYSIS_CHECK_CONTAINS_H_
 
 #include <tvm/tirx/expr.h>
-#include <tvm/tirx/stmt_functor.h>  // For the class StmtExprVisitor
+#include <tvm/tirx/stmt_functor.h>  // For the class IterativeStmtExprVisitor
 
 namespace tvm {
 namespace tirx {
@@ -36,7 +36,7 @@ namespace tirx {
  * \brief Visitor which tells if a given expression or statement contains a subexpression
           that satisfies a given predicate
  */
-class CheckContains : public StmtExprVisitor {
+class CheckContains : public IterativeStmtExprVisitor {
  public:
   // Toplevel (static) functions
   static bool ExprContains(const PrimExpr& expr, std::function<bool(const PrimExpr&)> predicate);
@@ -46,7 +46,7 @@ class CheckContains : public StmtExprVisitor {
   // Constructor
   explicit CheckContains(std::function<bool(const PrimExpr&)> predicate);
 
-  void VisitExpr(const PrimExpr& expr) override;
+  bool EnterExpr(const PrimExpr& expr) override;
   void VisitStmt(const Stmt& stmt) override;
 
  private:
@@ -22,6 +22,9 @@
 #include <tvm/ffi/cast.h>
 #include <tvm/tirx/expr_functor.h>
 
+#include <utility>
+#include <vector>
+
 #include "functor_common.h"
 
 namespace tvm {
@@ -112,6 +115,78 @@ void ExprVisitor::VisitExpr_(const ShuffleNode* op) {
 
 void ExprVisitor::VisitExpr_(const BroadcastNode* op) { this->VisitExpr(op->value); }
 
+void IterativeExprVisitor::VisitExpr(const PrimExpr& e) {
+  // One frame per node on the explicit stack. A node of a chain-forming kind
+  // is pushed twice: once to expand its operands (expanded = false) and once,
+  // underneath them, to run its own VisitExpr_ after the operands finished
+  // (expanded = true).
+  struct WorkItem {
+    PrimExpr expr;
+    bool expanded;
+  };
+  std::vector<WorkItem> stack;
+  stack.push_back({e, false});
+  while (!stack.empty()) {
+    WorkItem item = std::move(stack.back());
+    stack.pop_back();
+    if (item.expanded) {
+      // Operands are fully visited; run the node's own visit (a no-op unless
+      // a subclass overrides the corresponding VisitExpr_).
+      ExprVisitor::VisitExpr(item.expr);
+      continue;
+    }
+    if (!EnterExpr(item.expr)) continue;
+    // Chain-forming kinds: re-push the node as expanded, then its operands
+    // in reverse so that they are visited in the usual left-to-right order.
+#define TVM_TIR_EXPAND_BINOP_ITER(OP)              \
+  if (const OP* op = item.expr.as<OP>()) {         \
+    stack.push_back({std::move(item.expr), true}); \
+    stack.push_back({op->b, false});               \
+    stack.push_back({op->a, false});               \
+    continue;                                      \
+  }
+    TVM_TIR_EXPAND_BINOP_ITER(AddNode);
+    TVM_TIR_EXPAND_BINOP_ITER(SubNode);
+    TVM_TIR_EXPAND_BINOP_ITER(MulNode);
+    TVM_TIR_EXPAND_BINOP_ITER(DivNode);
+    TVM_TIR_EXPAND_BINOP_ITER(ModNode);
+    TVM_TIR_EXPAND_BINOP_ITER(FloorDivNode);
+    TVM_TIR_EXPAND_BINOP_ITER(FloorModNode);
+    TVM_TIR_EXPAND_BINOP_ITER(MinNode);
+    TVM_TIR_EXPAND_BINOP_ITER(MaxNode);
+    TVM_TIR_EXPAND_BINOP_ITER(EQNode);
+    TVM_TIR_EXPAND_BINOP_ITER(NENode);
+    TVM_TIR_EXPAND_BINOP_ITER(LTNode);
+    TVM_TIR_EXPAND_BINOP_ITER(LENode);
+    TVM_TIR_EXPAND_BINOP_ITER(GTNode);
+    TVM_TIR_EXPAND_BINOP_ITER(GENode);
+    TVM_TIR_EXPAND_BINOP_ITER(AndNode);
+    TVM_TIR_EXPAND_BINOP_ITER(OrNode);
+#undef TVM_TIR_EXPAND_BINOP_ITER
+    if (const NotNode* op = item.expr.as<NotNode>()) {
+      stack.push_back({std::move(item.expr), true});
+      stack.push_back({op->a, false});
+      continue;
+    }
+    if (const CastNode* op = item.expr.as<CastNode>()) {
+      stack.push_back({std::move(item.expr), true});
+      stack.push_back({op->value, false});
+      continue;
+    }
+    if (const SelectNode* op = item.expr.as<SelectNode>()) {
+      stack.push_back({std::move(item.expr), true});
+      stack.push_back({op->false_value, false});
+      stack.push_back({op->true_value, false});
+      stack.push_back({op->condition, false});
+      continue;
+    }
+    // Every other kind: ordinary recursive dispatch. Its operand visits
+    // re-enter this driver, so the recursion depth is bounded by the nesting
+    // of these kinds rather than by the total expression depth.
+    ExprVisitor::VisitExpr(item.expr);
+  }
+}
+
 PrimExpr ExprMutator::VisitExpr_(const VarNode* op) { return ffi::GetRef<PrimExpr>(op); }
 
 PrimExpr ExprMutator::VisitExpr_(const SizeVarNode* op) {
@@ -124,7 +199,7 @@ PrimExpr ExprMutator::VisitExpr_(const BufferLoadNode* op) {
   if (indices.same_as(op->indices)) {
     return ffi::GetRef<PrimExpr>(op);
   } else {
-    return BufferLoad(op->buffer, indices, op->predicate);
+    return BufferLoad(op->buffer, indices, op->predicate, op->span);
   }
 }
 
@@ -134,7 +209,7 @@ PrimExpr ExprMutator::VisitExpr_(const ProducerLoadNode* op) {
   if (indices.same_as(op->indices)) {
     return ffi::GetRef<PrimExpr>(op);
   } else {
-    return ProducerLoad(op->producer, indices);
+    return ProducerLoad(op->producer, indices, op->span);
   }
 }
 
@@ -144,7 +219,7 @@ PrimExpr ExprMutator::VisitExpr_(const LetNode* op) {
   if (value.same_as(op->value) && body.same_as(op->body)) {
     return ffi::GetRef<PrimExpr>(op);
   } else {
-    return Let(op->var, value, body);
+    return Let(op->var, value, body, op->span);
   }
 }
 
@@ -173,7 +248,7 @@ DEFINE_OP_RETURN_SELF_EXPR_MUTATE_(StringImmNode)
     if (a.same_as(op->a) && b.same_as(op->b)) {          \
       return ffi::GetRef<PrimExpr>(op);                  \
     } else {                                             \
-      return OP(a, b);                                   \
+      return OP(a, b, op->span);                         \
     }                                                    \
   }
 
@@ -203,7 +278,8 @@ PrimExpr ExprMutator::VisitExpr_(const ReduceNode* op) {
     if (min.same_as(r->min) && extent.same_as(r->extent)) {
       return v;
     } else {
-      return IterVar(Range::FromMinExtent(min, extent), v->var, v->iter_type, v->thread_tag);
+      return IterVar(Range::FromMinExtent(min, extent), v->var, v->iter_type, v->thread_tag,
+                     v->span);
     }
   };
   ffi::Array<IterVar> axis = op->axis.Map(fitervar);
@@ -218,7 +294,7 @@ PrimExpr ExprMutator::VisitExpr_(const ReduceNode* op) {
       init.same_as(op->init)) {
     return ffi::GetRef<PrimExpr>(op);
   } else {
-    return Reduce(op->combiner, source, axis, condition, op->value_index, init);
+    return Reduce(op->combiner, source, axis, condition, op->value_index, init, op->span);
   }
 }
 
@@ -227,7 +303,7 @@ PrimExpr ExprMutator::VisitExpr_(const CastNode* op) {
   if (value.same_as(op->value)) {
     return ffi::GetRef<PrimExpr>(op);
   } else {
-    return Cast(op->ExprNode::ty.as_or_throw<PrimType>(), value);
+    return Cast(op->ExprNode::ty.as_or_throw<PrimType>(), value, op->span);
   }
 }
 
@@ -236,7 +312,7 @@ PrimExpr ExprMutator::VisitExpr_(const NotNode* op) {
   if (a.same_as(op->a)) {
     return ffi::GetRef<PrimExpr>(op);
   } else {
-    return Not(a);
+    return Not(a, op->span);
   }
 }
 
@@ -248,7 +324,7 @@ PrimExpr ExprMutator::VisitExpr_(const SelectNode* op) {
       false_value.same_as(op->false_value)) {
     return ffi::GetRef<PrimExpr>(op);
   } else {
-    return Select(condition, true_value, false_value);
+    return Select(condition, true_value, false_value, op->span);
   }
 }
 
@@ -259,7 +335,7 @@ PrimExpr ExprMutator::VisitExpr_(const RampNode* op) {
   if (base.same_as(op->base) && stride.same_as(op->stride) && lanes.same_as(op->lanes)) {
     return ffi::GetRef<PrimExpr>(op);
   } else {
-    return Ramp(base, stride, lanes);
+    return Ramp(base, stride, lanes, op->span);
   }
 }
 
@@ -269,7 +345,7 @@ PrimExpr ExprMutator::VisitExpr_(const BroadcastNode* op) {
   if (value.same_as(op->value) && lanes.same_as(op->lanes)) {
     return ffi::GetRef<PrimExpr>(op);
   } else {
-    return Broadcast(value, lanes);
+    return Broadcast(value, lanes, op->span);
   }
 }
 
@@ -280,7 +356,7 @@ PrimExpr ExprMutator::VisitExpr_(const ShuffleNode* op) {
   if (vectors.same_as(op->vectors) && indices.same_as(op->indices)) {
     return ffi::GetRef<PrimExpr>(op);
   } else {
-    return Shuffle(vectors, indices);
+    return Shuffle(vectors, indices, op->span);
   }
 }
 
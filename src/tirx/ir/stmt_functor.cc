@@ -80,6 +80,11 @@ void StmtExprVisitor::VisitExpr_(const BufferLoadNode* op) {
   ExprVisitor::VisitExpr_(op);
 }
 
+void IterativeStmtExprVisitor::VisitExpr_(const BufferLoadNode* op) {
+  this->VisitBufferUse(op->buffer);
+  ExprVisitor::VisitExpr_(op);
+}
+
 void StmtVisitor::VisitStmt_(const AllocBufferNode* op) {
   this->VisitBufferDef(op->buffer, /*alloc_data=*/true);
 }
@@ -611,26 +616,20 @@ Stmt StmtMutator::VisitStmt_(const SBlockRealizeNode* op) {
 
 Stmt StmtMutator::VisitStmt_(const ScopeIdDefStmtNode* op) {
   // Mutate extents and preferred_extents; deferred defs have nothing to
-  // mutate -- pass through.
+  // mutate -- pass through. Array::Map returns the original array when no
+  // element changed, so the unchanged case allocates nothing.
+  auto fmutate = [this](const PrimExpr& e) { return this->VisitExpr(e); };
   bool changed = false;
   ffi::Optional<ffi::Array<PrimExpr>> new_extents = op->def->extents;
   if (op->def->extents.has_value()) {
-    ffi::Array<PrimExpr> new_arr;
-    for (const auto& e : op->def->extents.value()) {
-      PrimExpr ne = this->VisitExpr(e);
-      if (!ne.same_as(e)) changed = true;
-      new_arr.push_back(ne);
-    }
+    ffi::Array<PrimExpr> new_arr = op->def->extents.value().Map(fmutate);
+    if (!new_arr.same_as(op->def->extents.value())) changed = true;
     new_extents = new_arr;
   }
   ffi::Optional<ffi::Array<PrimExpr>> new_pref = op->def->preferred_extents;
   if (op->def->preferred_extents.has_value()) {
-    ffi::Array<PrimExpr> new_arr;
-    for (const auto& e : op->def->preferred_extents.value()) {
-      PrimExpr ne = this->VisitExpr(e);
-      if (!ne.same_as(e)) changed = true;
-      new_arr.push_back(ne);
-    }
+    ffi::Array<PrimExpr> new_arr = op->def->preferred_extents.value().Map(fmutate);
+    if (!new_arr.same_as(op->def->preferred_extents.value())) changed = true;
     new_pref = new_arr;
   }
   if (!changed) return ffi::GetRef<Stmt>(op);
@@ -653,14 +652,19 @@ Stmt StmtMutator::VisitStmt_(const tirx::TilePrimitiveCallNode* op) {
     return e;
   };
   ffi::Array<ffi::Any> args = Internal::MutateArray(this, op->args, fmutate);
-  // Also mutate PrimExpr values in the config map
-  ffi::Map<ffi::String, ffi::Any> config(op->config.begin(), op->config.end());
+  // Also mutate PrimExpr values in the config map. The map is only copied
+  // once the first value actually changes, so the common unchanged case
+  // allocates nothing.
+  ffi::Map<ffi::String, ffi::Any> config;
   bool config_changed = false;
   for (const auto& [key, value] : op->config) {
     ffi::Any new_value = fmutate(value);
     if (!new_value.same_as(value)) {
+      if (!config_changed) {
+        config = ffi::Map<ffi::String, ffi::Any>(op->config.begin(), op->config.end());
+        config_changed = true;
+      }
       config.Set(key, new_value);
-      config_changed = true;
     }
   }
   if (args.same_as(op->args) && !config_changed) {
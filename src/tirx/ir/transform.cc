@@ -44,11 +44,14 @@ TVM_REGISTER_PASS_CONFIG_OPTION("tirx.is_entry_func", bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("tirx.add_lower_pass", ffi::Array<ffi::Array<ffi::ObjectRef>>);
 TVM_REGISTER_PASS_CONFIG_OPTION("tirx.debug_keep_trivial_loop", bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("tirx.use_async_copy", bool);
+TVM_REGISTER_PASS_CONFIG_OPTION("tirx.auto_software_pipeline", bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("tirx.merge_static_smem", bool);
+TVM_REGISTER_PASS_CONFIG_OPTION("tirx.merge_static_global_allocs", bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("tirx.instrument_lwp", bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("tirx.vtcm_capacity", int64_t);
 TVM_REGISTER_PASS_CONFIG_OPTION("tirx.ptx.ldg32", bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("tirx.enable_fast_math", bool);
+TVM_REGISTER_PASS_CONFIG_OPTION("tirx.bounded_fast_math_bits", int64_t);
 
 /*!
  * \brief Function level pass that applies transformations to all
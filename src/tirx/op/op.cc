@@ -1319,11 +1319,9 @@ TVM_FFI_STATIC_INIT_BLOCK() {
       .DEF_MAKE_BIT_OP(right_shift, right_shift);
 }
 
-PrimExpr fast_erf_float_expr(PrimExpr arg, int bits) {
-  PrimType fp_ty = PrimType::Float(bits);
-  auto plus_4 = FloatImm(fp_ty, 4.f);
-  auto minus_4 = FloatImm(fp_ty, -4.f);
-
+// Evaluate the Eigen erf rational approximation. Callers must keep the
+// argument within [-4, 4], either by clamping or by a proven value range.
+static PrimExpr ErfRationalExpr(PrimExpr x, PrimType fp_ty) {
   // The monomial coefficients of the numerator polynomial (odd).
   auto alpha_1 = FloatImm(fp_ty, -1.60960333262415e-02f);
   auto alpha_3 = FloatImm(fp_ty, -2.95459980854025e-03f);
@@ -1340,8 +1338,6 @@ PrimExpr fast_erf_float_expr(PrimExpr arg, int bits) {
   auto beta_6 = FloatImm(fp_ty, -2.13374055278905e-04f);
   auto beta_8 = FloatImm(fp_ty, -1.45660718464996e-05f);
 
-  // clamp x
-  auto x = tvm::max(tvm::min(arg, plus_4), minus_4);
   auto x2 = x * x;
 
   // Evaluate the numerator polynomial p.
@@ -1362,6 +1358,141 @@ PrimExpr fast_erf_float_expr(PrimExpr arg, int bits) {
   return p / q;
 }
 
+PrimExpr fast_erf_float_expr(PrimExpr arg, int bits) {
+  PrimType fp_ty = PrimType::Float(bits);
+  auto plus_4 = FloatImm(fp_ty, 4.f);
+  auto minus_4 = FloatImm(fp_ty, -4.f);
+
+  // clamp x
+  auto x = tvm::max(tvm::min(arg, plus_4), minus_4);
+  return ErfRationalExpr(x, fp_ty);
+}
+
+// Truncated Taylor expansion of exp evaluated with Horner's scheme.
+static PrimExpr ExpTaylorExpr(PrimExpr x, PrimType fp_ty, int degree) {
+  double coeff = 1.0;
+  for (int k = 2; k <= degree; ++k) coeff /= k;
+  PrimExpr y = FloatImm(fp_ty, coeff);
+  for (int k = degree - 1; k >= 0; --k) {
+    coeff *= (k + 1);
+    y = y * x + FloatImm(fp_ty, coeff);
+  }
+  return y;
+}
+
+ffi::Optional<PrimExpr> bounded_exp_float_expr(PrimExpr arg, double lo, double hi,
+                                               int accuracy_bits) {
+  PrimType ty = arg.ty();
+  if (ty.IsScalableVector() || ty.code() != DLDataTypeCode::kDLFloat || ty.bits() != 32) {
+    return std::nullopt;
+  }
+  // Stay strictly inside the representable domain of float32 exp so neither
+  // the clamp nor the overflow guard of the generic fast path is needed.
+  if (!(lo <= hi) || lo < -87.0 || hi > 88.0) return std::nullopt;
+  // Float32 arithmetic caps what any polynomial scheme can deliver.
+  if (accuracy_bits > 21) return std::nullopt;
+  PrimType f32_ty = PrimType::Float(32);
+  double tolerance = std::ldexp(1.0, -accuracy_bits);
+
+  // On a narrow domain a truncated Taylor expansion around zero meets the
+  // budget without range reduction. The Lagrange remainder of the degree-d
+  // expansion relative to exp(x) is bounded by r^(d+1)/(d+1)! * e^r with
+  // r = max(|lo|, |hi|).
+  double radius = std::max(std::fabs(lo), std::fabs(hi));
+  auto taylor_rel_error = [](double r, int degree) {
+    double term = std::exp(r);
+    for (int k = 1; k <= degree + 1; ++k) term *= r / k;
+    return term;
+  };
+  constexpr int kMaxTaylorDegree = 8;
+  for (int degree = 2; degree <= kMaxTaylorDegree; ++degree) {
+    if (taylor_rel_error(radius, degree) <= tolerance) {
+      return ExpTaylorExpr(arg, f32_ty, degree);
+    }
+  }
+
+  // Otherwise reduce to exp(x) = 2^n * exp(f) with |f| <= ln(2)/2 and pick
+  // the cheapest fractional polynomial meeting the budget: the truncated
+  // Taylor forms are accurate to ~10 (degree 3) and ~14 bits (degree 4), the
+  // Cephes polynomial to ~21 bits.
+  auto log2e = FloatImm(f32_ty, 1.44269504088896341f);
+  auto ln2 = FloatImm(f32_ty, 0.6931471805599453f);
+  auto one = FloatImm(f32_ty, 1.0f);
+  auto one_half = FloatImm(f32_ty, 0.5f);
+  auto b = FloatImm(f32_ty, 127.0f);
+  PrimExpr n = tvm::floor(arg * log2e + one_half);
+  PrimExpr f = arg - n * ln2;
+  PrimExpr y;
+  if (accuracy_bits <= 10) {
+    y = ExpTaylorExpr(f, f32_ty, 3);
+  } else if (accuracy_bits <= 14) {
+    y = ExpTaylorExpr(f, f32_ty, 4);
+  } else {
+    PrimExpr p[6] = {FloatImm(f32_ty, 1.9875691500E-4f), FloatImm(f32_ty, 1.3981999507E-3f),
+                     FloatImm(f32_ty, 8.3334519073E-3f), FloatImm(f32_ty, 4.1665795894E-2f),
+                     FloatImm(f32_ty, 1.6666665459E-1f), FloatImm(f32_ty, 5.0000001201E-1f)};
+    y = (((((p[0] * f + p[1]) * f + p[2]) * f + p[3]) * f + p[4]) * f + p[5]) * f * f + f + one;
+  }
+  // 2^n through exponent assembly; n + 127 stays in (0, 255) on the proven
+  // domain, so no overflow handling is required.
+  PrimType i32_ty = PrimType::Int(32, ty.lanes());
+  PrimType f32_lanes_ty = PrimType::Float(32, ty.lanes());
+  PrimExpr two_n = reinterpret(f32_lanes_ty, cast(i32_ty, n + b) << 23);
+  return two_n * y;
+}
+
+ffi::Optional<PrimExpr> bounded_erf_float_expr(PrimExpr arg, int bits, double lo, double hi,
+                                               int accuracy_bits) {
+  PrimType ty = arg.ty();
+  if (ty.IsScalableVector() || ty.code() != DLDataTypeCode::kDLFloat ||
+      (bits != 16 && bits != 32)) {
+    return std::nullopt;
+  }
+  if (!(lo <= hi) || lo < -4.0 || hi > 4.0) return std::nullopt;
+  if (accuracy_bits > 21) return std::nullopt;
+  PrimType fp_ty = PrimType::Float(bits);
+  double tolerance = std::ldexp(1.0, -accuracy_bits);
+  double radius = std::max(std::fabs(lo), std::fabs(hi));
+  // Keep the error model away from the degenerate single-point domain.
+  radius = std::max(radius, 0.125);
+
+  // Truncated Taylor: erf(x) = 2/sqrt(pi) * sum (-1)^k x^(2k+1) / (k! (2k+1)).
+  // For radius <= 1.5 the terms decrease monotonically, so the alternating
+  // series bounds the truncation error by the first omitted term, and the
+  // relative error is worst at the radius.
+  constexpr double kTwoOverSqrtPi = 1.1283791670955126;
+  if (radius <= 1.5) {
+    constexpr int kMaxTerms = 7;  // degree 13, matching the rational fallback
+    double erf_radius = std::erf(radius);
+    double n_factorial = 1.0;
+    for (int terms = 1; terms <= kMaxTerms; ++terms) {
+      n_factorial *= terms;
+      double omitted =
+          kTwoOverSqrtPi * std::pow(radius, 2 * terms + 1) / (n_factorial * (2 * terms + 1));
+      if (omitted > tolerance * erf_radius) continue;
+      double coeff[kMaxTerms];
+      double k_factorial = 1.0;
+      for (int k = 0; k < terms; ++k) {
+        if (k > 0) k_factorial *= k;
+        coeff[k] = kTwoOverSqrtPi * ((k % 2 == 0) ? 1.0 : -1.0) / (k_factorial * (2 * k + 1));
+      }
+      PrimExpr x2 = arg * arg;
+      PrimExpr p = FloatImm(fp_ty, coeff[terms - 1]);
+      for (int k = terms - 2; k >= 0; --k) {
+        p = x2 * p + FloatImm(fp_ty, coeff[k]);
+      }
+      return arg * p;
+    }
+  }
+
+  // The domain is proven inside [-4, 4], so the rational approximation
+  // applies without the clamp. It is accurate to ~20 bits.
+  if (accuracy_bits <= 20) {
+    return ErfRationalExpr(arg, fp_ty);
+  }
+  return std::nullopt;
+}
+
 // Helper function to safely extract boolean from PackedArgs
 bool ExtractBool(const ffi::PackedArgs& args, int index) {
   try {
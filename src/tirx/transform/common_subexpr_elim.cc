@@ -28,13 +28,18 @@
  *   Phase 1 — **CSEPlanner** (analysis, no mutation)
  *     Walks the TIR tree bottom-up and builds:
  *       - A *scope tree* that mirrors the nesting structure of For/If/While/AttrStmt.
- *       - An *expression DAG* mapping each structurally-unique eligible expression
- *         to its occurrence count, LCA scope, first-use location, and direct
- *         children (which shallower expressions it contains).
+ *       - A *value numbering*: every visited expression node gets an integer
+ *         value number such that two nodes share a number iff they are
+ *         structurally equal. A node's number is derived from its operands'
+ *         numbers in O(arity), so equivalence costs O(1) expected per node
+ *         instead of a deep hash or comparison per lookup — the pass stays
+ *         O(n) expected even on the deep chains full unrolling produces.
+ *       - An *expression DAG* mapping each value number of an eligible
+ *         expression to its occurrence count, LCA scope, first-use location,
+ *         and direct children (which shallower expressions it contains).
  *     From this it produces a *plan* in a single pass (shallower expressions
  *     first): two tables describing what to insert where (InsertBeforeTable)
- *     and what to replace (ExprRemapTable). Shallower-first processing with
- *     repr propagation resolves all CSE opportunities without a cascade loop.
+ *     and what to replace (ExprRemapTable).
  *
  *   Phase 2 — **CSERewriter** (mechanical mutation)
  *     Consumes the plan and performs two kinds of edits:
@@ -65,11 +70,9 @@
 #include <tvm/ffi/cast.h>
 #include <tvm/ffi/container/array.h>
 #include <tvm/ffi/container/map.h>
-#include <tvm/ffi/extra/structural_hash.h>
 #include <tvm/ffi/reflection/registry.h>
 #include <tvm/ffi/string.h>
 #include <tvm/ir/transform.h>
-#include <tvm/tirx/analysis.h>
 #include <tvm/tirx/expr.h>
 #include <tvm/tirx/expr_functor.h>
 #include <tvm/tirx/function.h>
@@ -78,12 +81,15 @@
 #include <tvm/tirx/transform.h>
 
 #include <algorithm>
+#include <cstring>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "../../support/ordered_map.h"
+#include "../../support/utils.h"
 #include "../analysis/check_contains.h"
 
 namespace tvm {
@@ -94,12 +100,24 @@ namespace tirx {
 // ============================================================================
 
 /*!
- * \brief Map from expression to CSE variable, keyed by structural equality.
+ * \brief Map from expression node (by pointer) to its value number.
  *
- * Used by CSERewriter to look up whether a visited expression should be
- * replaced by a previously-introduced CSE variable.
+ * Built by CSEPlanner during the scan: two nodes carry the same value number
+ * iff they are structurally equal (free variables by identity, matching
+ * ExprDeepEqual). Handed to CSERewriter so phase 2 can test whether a visited
+ * node matches a planned expression with one O(1) pointer lookup instead of a
+ * deep structural hash and comparison per node.
  */
-using ExprRemapTable = std::unordered_map<PrimExpr, Var, ffi::StructuralHash, ExprDeepEqual>;
+using ExprVNTable = std::unordered_map<const ffi::Object*, uint64_t>;
+
+/*!
+ * \brief Map from value number to CSE variable.
+ *
+ * Used by CSERewriter (together with ExprVNTable) to look up whether a
+ * visited expression should be replaced by a previously-introduced CSE
+ * variable.
+ */
+using ExprRemapTable = std::unordered_map<uint64_t, Var>;
 
 /*!
  * \brief Map from statement (by pointer identity) to a list of Bind
@@ -119,24 +137,34 @@ using InsertBeforeTable =
 /*!
  * \brief Phase 1 of the two-phase CSE pass.
  *
- * CSEPlanner is a read-only visitor that scans the TIR tree bottom-up and builds:
+ * CSEPlanner is a read-only visitor that scans the TIR tree bottom-up. It is
+ * built on IterativeStmtExprVisitor so that the scan survives the deep
+ * expression chains of fully unrolled kernels without exhausting the call
+ * stack. The scan builds:
  *   1. A **scope tree** (vector of ScopeEntry) reflecting For/If/While/AttrStmt nesting.
- *   2. An **expression DAG** (ExprTable) where each node is an eligible expression
- *      with occurrence count, expr_depth, LCA scope, first-use location, and
- *      direct children (other table entries reachable without passing through
- *      another table entry). Children and expr_depth are computed incrementally
- *      during the bottom-up scan — no separate traversal needed.
+ *   2. A **value numbering** (ExprVNTable) assigning each visited expression
+ *      node an integer such that two nodes share a number iff they are
+ *      structurally equal. Numbers are assigned bottom-up from a shallow
+ *      signature (node kind, dtype, operand numbers), so each node costs
+ *      O(arity) expected — no deep hashing or comparison anywhere.
+ *   3. An **expression DAG** (ExprTable) keyed by value number, where each
+ *      entry is an eligible expression with occurrence count, expr_depth,
+ *      LCA scope, first-use location, and direct children (other table
+ *      entries reachable without passing through another table entry).
+ *      Children and expr_depth are computed incrementally during the
+ *      bottom-up scan — no separate traversal needed.
  *
- * After scanning, ComputePlan() converts the internal state into two output tables:
+ * After scanning, ComputePlan() converts the internal state into the output tables:
  *   - InsertBeforeTable: where to insert `Bind(cse_var, expr)` statements.
- *   - ExprRemapTable: which expressions to replace with their CSE variable.
+ *   - ExprVNTable + ExprRemapTable: which expressions to replace with their
+ *     CSE variable, matched by value number.
  *
  * Usage:
  * \code
- *   auto [insert_before, expr_remap] = CSEPlanner::Plan(body, params);
+ *   auto [insert_before, vn_of_node, expr_remap] = CSEPlanner::Plan(body);
  * \endcode
  */
-class CSEPlanner : public StmtExprVisitor {
+class CSEPlanner : public IterativeStmtExprVisitor {
  public:
   /*!
    * \brief Run the planner on a function body (static entry point).
@@ -145,10 +173,10 @@ class CSEPlanner : public StmtExprVisitor {
    * and returns the computed plan.
    *
    * \param body The TIR function body to analyze.
-   * \return A pair of (InsertBeforeTable, ExprRemapTable) describing the
-   *         planned CSE transformations.
+   * \return A tuple of (InsertBeforeTable, ExprVNTable, ExprRemapTable)
+   *         describing the planned CSE transformations.
    */
-  static std::pair<InsertBeforeTable, ExprRemapTable> Plan(const Stmt& body) {
+  static std::tuple<InsertBeforeTable, ExprVNTable, ExprRemapTable> Plan(const Stmt& body) {
     CSEPlanner planner;
     // Root scope (no parent, depth 0, no creator statement)
     planner.scopes_.push_back({-1, 0, Stmt()});
@@ -186,7 +214,7 @@ class CSEPlanner : public StmtExprVisitor {
    * \brief Node in the expression DAG built during the bottom-up scan.
    *
    * The planner maintains one ExprEntry per structurally-unique eligible
-   * expression (keyed by ExprDeepEqual). Since expressions are recorded
+   * expression (keyed by value number). Since expressions are recorded
    * bottom-up (children before parents), the DAG children are naturally
    * discovered when a node is first added. Fields like expr_depth are
    * computed incrementally from children — no separate traversal needed.
@@ -222,14 +250,14 @@ class CSEPlanner : public StmtExprVisitor {
      */
     Stmt first_use_stmt;
     /*!
-     * \brief Direct children in the expression DAG: (child_expr, multiplicity).
+     * \brief Direct children in the expression DAG: (child value number, multiplicity).
      *
      * A "direct child" is an eligible table entry reachable from this expression
      * without passing through another table entry. Multiplicity counts how many
      * times the child appears (e.g., 2 for `(x+y) * (x+y)` with child `x+y`).
      * Populated during RecordExpr (bottom-up: children already in table).
      */
-    std::vector<std::pair<PrimExpr, int>> children;
+    std::vector<std::pair<uint64_t, int>> children;
     /*!
      * \brief Number of occurrences consumed by parent expressions' CSE bindings.
      *
@@ -241,15 +269,15 @@ class CSEPlanner : public StmtExprVisitor {
   };
 
   /*!
-   * \brief Expression table keyed by structural equality (ExprDeepEqual).
+   * \brief Expression table keyed by value number.
    *
    * An insertion-ordered map so that iteration visits entries in discovery
    * (program) order. This makes the plan — and hence cse_v numbering —
-   * deterministic. A plain unordered_map iterates in hash order, and
-   * StructuralHash hashes free variables by object identity, which varies
-   * between processes (ASLR).
+   * deterministic: value numbers themselves are assigned in discovery order,
+   * so neither the keys nor the iteration order depend on where objects
+   * happen to be allocated (ASLR).
    */
-  using ExprTable = support::OrderedMap<PrimExpr, ExprEntry, ffi::StructuralHash, ExprDeepEqual>;
+  using ExprTable = support::OrderedMap<uint64_t, ExprEntry>;
 
   // ------------------------------------------------------------------
   // Eligibility predicates
@@ -269,18 +297,22 @@ class CSEPlanner : public StmtExprVisitor {
   }
 
   /*!
-   * \brief Check if an expression is eligible for common subexpression elimination.
+   * \brief Check the shallow (per-node) eligibility rules for CSE.
    *
    * An expression is eligible if it represents a non-trivial pure computation:
    *   - Not a leaf (Var, IntImm, FloatImm, StringImm — no computation to save).
    *   - Not a Call or BufferLoad (side effects / memory dependence).
    *   - Not Ramp or Broadcast (hardware-specific vector construction).
-   *   - Does not transitively contain any forbidden node.
    *   - Is not bool-typed (predicates are kept inline for readability and
    *     downstream simplification).
    *
+   * The transitive rule — that the expression must not contain a forbidden
+   * node anywhere — is carried on the value number (see AssignVN), where it
+   * is computed once per structurally-unique expression from the operands'
+   * bits instead of re-walking the subtree at every occurrence.
+   *
    * \param expr The expression to check.
-   * \return true if the expression can participate in CSE.
+   * \return true if the expression passes the shallow eligibility rules.
    */
   static bool IsEligible(const PrimExpr& expr) {
     if (expr.as<IntImmNode>() || expr.as<FloatImmNode>() || expr.as<StringImmNode>() ||
@@ -298,39 +330,216 @@ class CSEPlanner : public StmtExprVisitor {
     // (LT/LE/GT/GE/EQ/NE/And/Or/Not/Cast-to-bool/Select-of-bool).
     PrimType expr_ty = expr.ty();
     if (expr_ty.MatchesCode(DLDataTypeCode::kDLBool)) return false;
-    if (CheckContains::ExprContains(expr, IsForbiddenNode)) return false;
     return true;
   }
 
   // ------------------------------------------------------------------
-  // Expression substitution
+  // Value numbering
   // ------------------------------------------------------------------
 
+  /*! \brief Shallow signature of a node: kind, dtype, then payload or operand numbers. */
+  using Signature = std::vector<uint64_t>;
+
+  struct SignatureHash {
+    size_t operator()(const Signature& sig) const {
+      uint64_t hash = sig.size();
+      for (uint64_t word : sig) hash = support::HashCombine(hash, word);
+      return static_cast<size_t>(hash);
+    }
+  };
+
+  /*!
+   * \brief Collect the operands that define a node's structural signature.
+   *
+   * Returns true for the kinds whose equivalence is decided shallowly from
+   * their operands' value numbers (the arithmetic/comparison/logical
+   * operators, Not, Cast, Select, Ramp, Broadcast) and for the leaves, whose
+   * signature is built from their payload instead. Returns false for the
+   * remaining kinds (Call, BufferLoad, ProducerLoad, Let, Shuffle, Reduce),
+   * which are numbered by object identity: Call and BufferLoad poison
+   * eligibility anyway, and the others are rare enough in lowered TIR that
+   * identity is the right precision/cost trade-off.
+   */
+  static bool StructuralOperands(const PrimExpr& expr, std::vector<PrimExpr>* operands) {
+#define CSE_VN_BINARY(NodeType)               \
+  if (const auto* op = expr.as<NodeType>()) { \
+    operands->push_back(op->a);               \
+    operands->push_back(op->b);               \
+    return true;                              \
+  }
+    CSE_VN_BINARY(AddNode)
+    CSE_VN_BINARY(SubNode)
+    CSE_VN_BINARY(MulNode)
+    CSE_VN_BINARY(DivNode)
+    CSE_VN_BINARY(ModNode)
+    CSE_VN_BINARY(FloorDivNode)
+    CSE_VN_BINARY(FloorModNode)
+    CSE_VN_BINARY(MinNode)
+    CSE_VN_BINARY(MaxNode)
+    CSE_VN_BINARY(EQNode)
+    CSE_VN_BINARY(NENode)
+    CSE_VN_BINARY(LTNode)
+    CSE_VN_BINARY(LENode)
+    CSE_VN_BINARY(GTNode)
+    CSE_VN_BINARY(GENode)
+    CSE_VN_BINARY(AndNode)
+    CSE_VN_BINARY(OrNode)
+#undef CSE_VN_BINARY
+    if (const auto* op = expr.as<NotNode>()) {
+      operands->push_back(op->a);
+      return true;
+    }
+    if (const auto* op = expr.as<CastNode>()) {
+      operands->push_back(op->value);
+      return true;
+    }
+    if (const auto* op = expr.as<SelectNode>()) {
+      operands->push_back(op->condition);
+      operands->push_back(op->true_value);
+      operands->push_back(op->false_value);
+      return true;
+    }
+    if (const auto* op = expr.as<RampNode>()) {
+      operands->push_back(op->base);
+      operands->push_back(op->stride);
+      operands->push_back(op->lanes);
+      return true;
+    }
+    if (const auto* op = expr.as<BroadcastNode>()) {
+      operands->push_back(op->value);
+      operands->push_back(op->lanes);
+      return true;
+    }
+    // Leaves: signature built from the payload, no operands.
+    if (expr.as<VarNode>() || expr.as<IntImmNode>() || expr.as<FloatImmNode>() ||
+        expr.as<StringImmNode>()) {
+      return true;
+    }
+    return false;
+  }
+
+  /*! \brief Pack a node's DLPack dtype into one signature word. */
+  static uint64_t PackType(const PrimExpr& expr) {
+    DLDataType dtype = expr.ty()->dtype;
+    return (static_cast<uint64_t>(dtype.code) << 32) | (static_cast<uint64_t>(dtype.bits) << 16) |
+           static_cast<uint64_t>(dtype.lanes);
+  }
+
+  /*! \brief Intern a StringImm payload so signatures stay fixed-width words. */
+  uint64_t InternString(const ffi::String& value) {
+    return interned_strings_.emplace(std::string(value), interned_strings_.size()).first->second;
+  }
+
+  /*!
+   * \brief Assign a value number to a node whose operands are already numbered.
+   *
+   * Builds the node's shallow signature and reuses the number of an earlier
+   * node with the same signature, or allocates the next number. Also folds
+   * the "contains a forbidden node" bit up from the operands, so transitive
+   * eligibility is a per-number lookup rather than a subtree scan.
+   */
+  void AssignVN(const PrimExpr& expr, bool structural, const std::vector<PrimExpr>& operands) {
+    Signature sig;
+    sig.reserve(2 + operands.size());
+    sig.push_back(static_cast<uint64_t>(expr->type_index()));
+    sig.push_back(PackType(expr));
+    bool forbidden = false;
+    if (!structural || expr.as<VarNode>()) {
+      // Vars compare by identity, matching ExprDeepEqual which does not
+      // remap free variables. The identity-numbered kinds need one subtree
+      // scan each for the forbidden bit — once per object, not per lookup.
+      sig.push_back(reinterpret_cast<uint64_t>(expr.get()));
+      if (!structural) {
+        forbidden = IsForbiddenNode(expr) || CheckContains::ExprContains(expr, IsForbiddenNode);
+      }
+    } else if (const auto* int_imm = expr.as<IntImmNode>()) {
+      sig.push_back(static_cast<uint64_t>(int_imm->value));
+    } else if (const auto* float_imm = expr.as<FloatImmNode>()) {
+      uint64_t bits;
+      static_assert(sizeof(bits) == sizeof(float_imm->value));
+      std::memcpy(&bits, &float_imm->value, sizeof(bits));
+      sig.push_back(bits);
+    } else if (const auto* str_imm = expr.as<StringImmNode>()) {
+      sig.push_back(InternString(str_imm->value));
+    } else {
+      for (const PrimExpr& operand : operands) {
+        uint64_t operand_vn = vn_of_node_.at(operand.get());
+        sig.push_back(operand_vn);
+        forbidden = forbidden || vn_contains_forbidden_[operand_vn];
+      }
+    }
+    auto it = sig_to_vn_.find(sig);
+    uint64_t vn;
+    if (it != sig_to_vn_.end()) {
+      vn = it->second;
+    } else {
+      vn = static_cast<uint64_t>(vn_contains_forbidden_.size());
+      vn_contains_forbidden_.push_back(forbidden);
+      sig_to_vn_.emplace(std::move(sig), vn);
+    }
+    vn_of_node_[expr.get()] = vn;
+  }
+
   /*!
-   * \brief Replace all occurrences of `target` in `body` with `replacement`.
+   * \brief Get (or assign) the value number of an expression.
    *
-   * Uses structural equality (ExprDeepEqual) to find matches. Stops recursing
-   * into a sub-tree once a match is found (the replacement is a leaf Var).
+   * Runs an explicit-stack post-order walk over the not-yet-numbered part of
+   * the subtree. Every node is numbered at most once across the whole scan
+   * (the pointer memo short-circuits both re-visits and shared subtrees), so
+   * the total numbering cost is O(nodes) expected — the key property that
+   * keeps this pass linear where per-lookup deep hashing would be quadratic
+   * on the unrolled chains it is most needed on.
+   */
+  uint64_t GetVN(const PrimExpr& expr) {
+    std::vector<PrimExpr> stack{expr};
+    std::vector<PrimExpr> operands;
+    while (!stack.empty()) {
+      PrimExpr cur = stack.back();
+      if (vn_of_node_.count(cur.get())) {
+        stack.pop_back();
+        continue;
+      }
+      operands.clear();
+      bool structural = StructuralOperands(cur, &operands);
+      if (structural) {
+        size_t before = stack.size();
+        for (const PrimExpr& operand : operands) {
+          if (!vn_of_node_.count(operand.get())) stack.push_back(operand);
+        }
+        // Number the operands first, then come back to this node.
+        if (stack.size() > before) continue;
+      }
+      stack.pop_back();
+      AssignVN(cur, structural, operands);
+    }
+    return vn_of_node_.at(expr.get());
+  }
+
+  /*!
+   * \brief Replace every already-planned sub-expression of `body` with its CSE variable.
    *
-   * \param body The expression to transform.
-   * \param target The sub-expression to find.
-   * \param replacement The expression to substitute in (typically a CSE Var).
-   * \return The transformed expression.
+   * Matches by value number — a pointer lookup into vn_of_node_ — so one call
+   * is a single walk with O(1) work per node. The body's own value number is
+   * not yet in the remap when this runs (ComputePlan inserts it afterwards),
+   * so the expression itself is preserved.
    */
-  static PrimExpr SubstituteSubexpr(const PrimExpr& body, const PrimExpr& target,
-                                    const PrimExpr& replacement) {
+  PrimExpr RewritePlanned(const PrimExpr& body, const ExprRemapTable& expr_remap) const {
     struct Replacer : public ExprMutator {
-      ExprDeepEqual eq;
-      PrimExpr target, replacement;
+      const ExprVNTable* vn_of_node;
+      const ExprRemapTable* remap;
       PrimExpr VisitExpr(const PrimExpr& e) final {
-        if (eq(e, target)) return replacement;
+        auto vn_it = vn_of_node->find(e.get());
+        if (vn_it != vn_of_node->end()) {
+          auto var_it = remap->find(vn_it->second);
+          if (var_it != remap->end()) return var_it->second;
+        }
         return ExprMutator::VisitExpr(e);
       }
     };
-    Replacer r;
-    r.target = target;
-    r.replacement = replacement;
-    return r.VisitExpr(body);
+    Replacer replacer;
+    replacer.vn_of_node = &vn_of_node_;
+    replacer.remap = &expr_remap;
+    return replacer.VisitExpr(body);
   }
 
   // ------------------------------------------------------------------
@@ -410,11 +619,16 @@ class CSEPlanner : public StmtExprVisitor {
    */
   void RecordExpr(const PrimExpr& e, std::initializer_list<PrimExpr> ast_children) {
     if (!IsEligible(e)) return;
+    // Number the node even when recording is suppressed below: the rewriter
+    // matches occurrences through vn_of_node_, and an occurrence inside a Let
+    // body must still be replaced when the same value is CSE'd outside.
+    uint64_t vn = GetVN(e);
+    if (vn_contains_forbidden_[vn]) return;
     // Inside a Let body, expressions may reference Let-bound variables that
     // are not visible at the statement level. Skip recording to prevent
     // extracting them before the containing statement.
     if (let_depth_ > 0) return;
-    ExprEntry& entry = table_[e];
+    ExprEntry& entry = table_[vn];
     bool is_first_occurrence = (entry.count == 0);
     if (is_first_occurrence) {
       entry.lca_scope = current_scope_;
@@ -439,22 +653,23 @@ class CSEPlanner : public StmtExprVisitor {
    * child `x+y` with multiplicity 2). expr_depth is 1 + max child depth.
    */
   void CollectChildren(ExprEntry& entry, std::initializer_list<PrimExpr> ast_children) {
-    ExprDeepEqual eq;
     int max_child_depth = 0;
     for (const PrimExpr& child : ast_children) {
-      auto it = table_.find(child);
+      // Memoized: GetVN on the parent already numbered the whole subtree.
+      uint64_t child_vn = GetVN(child);
+      auto it = table_.find(child_vn);
       if (it == table_.end()) continue;
       max_child_depth = std::max(max_child_depth, it->second.expr_depth);
       // Check if this child was already seen (handles multiplicity).
       bool already_recorded = false;
-      for (auto& [existing_child, multiplicity] : entry.children) {
-        if (eq(existing_child, child)) {
+      for (auto& [existing_child_vn, multiplicity] : entry.children) {
+        if (existing_child_vn == child_vn) {
           multiplicity++;
           already_recorded = true;
           break;
         }
       }
-      if (!already_recorded) entry.children.push_back({child, 1});
+      if (!already_recorded) entry.children.push_back({child_vn, 1});
     }
     entry.expr_depth = 1 + max_child_depth;
   }
@@ -462,18 +677,19 @@ class CSEPlanner : public StmtExprVisitor {
   // ------------------------------------------------------------------
   // Visitor overrides — expressions
   // ------------------------------------------------------------------
-  // Each arithmetic/comparison/logical/cast/select node visitor calls the
-  // base class to recurse into children first, then records the full
-  // expression. This bottom-up order ensures that sub-expressions are
-  // recorded before their parents.
+  // The iterative base drives these node kinds in post order from an
+  // explicit work stack: when a visitor below runs, the children have
+  // already been visited (and recorded), so each visitor only records the
+  // full expression. This bottom-up order ensures that sub-expressions are
+  // in the table before their parents, without consuming one call-stack
+  // frame per node on the deep chains produced by full loop unrolling.
   // ------------------------------------------------------------------
 
-  using StmtExprVisitor::VisitExpr_;
+  using IterativeStmtExprVisitor::VisitExpr_;
 
   // Binary arithmetic operators (op->a, op->b)
 #define CSE_VISIT_BINARY(NodeType)                         \
   void VisitExpr_(const NodeType* op) override {           \
-    StmtExprVisitor::VisitExpr_(op);                       \
     RecordExpr(ffi::GetRef<PrimExpr>(op), {op->a, op->b}); \
   }
   CSE_VISIT_BINARY(AddNode)
@@ -495,16 +711,11 @@ class CSEPlanner : public StmtExprVisitor {
   CSE_VISIT_BINARY(OrNode)
 #undef CSE_VISIT_BINARY
 
-  void VisitExpr_(const NotNode* op) override {
-    StmtExprVisitor::VisitExpr_(op);
-    RecordExpr(ffi::GetRef<PrimExpr>(op), {op->a});
-  }
+  void VisitExpr_(const NotNode* op) override { RecordExpr(ffi::GetRef<PrimExpr>(op), {op->a}); }
   void VisitExpr_(const CastNode* op) override {
-    StmtExprVisitor::VisitExpr_(op);
     RecordExpr(ffi::GetRef<PrimExpr>(op), {op->value});
   }
   void VisitExpr_(const SelectNode* op) override {
-    StmtExprVisitor::VisitExpr_(op);
     RecordExpr(ffi::GetRef<PrimExpr>(op), {op->condition, op->true_value, op->false_value});
   }
 
@@ -536,7 +747,7 @@ class CSEPlanner : public StmtExprVisitor {
    */
   void VisitStmt(const Stmt& stmt) override {
     current_stmt_ = stmt;
-    StmtExprVisitor::VisitStmt(stmt);
+    IterativeStmtExprVisitor::VisitStmt(stmt);
   }
 
   /*! \brief For loops: bounds in parent scope, body in child scope. */
@@ -599,9 +810,9 @@ class CSEPlanner : public StmtExprVisitor {
   // ------------------------------------------------------------------
 
   /*!
-   * \brief Convert the accumulated expression table into InsertBefore + ExprRemap tables.
+   * \brief Convert the accumulated expression table into the output tables.
    *
-   * Algorithm (shallower-first with repr propagation):
+   * Algorithm (shallower-first):
    *   1. Collect all entries and sort by expr_depth ascending (shallower first).
    *      The stable sort over the insertion-ordered table keeps entries of
    *      equal depth in discovery (program) order, so the plan is deterministic.
@@ -612,25 +823,27 @@ class CSEPlanner : public StmtExprVisitor {
    *      is skipped (avoids unnecessary single-use bindings).
    *   3. For each entry with independent_count >= 2:
    *      a. Determine the insertion point.
-   *      b. Create a CSE variable and Bind statement (using the entry's repr,
-   *         which may already reference CSE vars from shallower entries).
+   *      b. Create a CSE variable and Bind statement. The Bind value is the
+   *         entry's expression rewritten through the remap built so far, so
+   *         it references the CSE variables of shallower entries instead of
+   *         recomputing them. One O(size) walk per candidate with O(1)
+   *         lookups per node — not a propagation sweep over every deeper
+   *         entry per new variable.
    *      c. Add to insert_before and expr_remap.
-   *      d. Propagate: replace this expression in all deeper entries' repr
-   *         with the new CSE variable.
    *
-   * \return A pair of (InsertBeforeTable, ExprRemapTable).
+   * \return A tuple of (InsertBeforeTable, ExprVNTable, ExprRemapTable).
    */
-  std::pair<InsertBeforeTable, ExprRemapTable> ComputePlan() {
+  std::tuple<InsertBeforeTable, ExprVNTable, ExprRemapTable> ComputePlan() {
     // Step 1: Sort entries by depth ascending (shallower first). table_ iterates
     // in discovery order, which the stable sort preserves among equal depths.
-    std::vector<std::pair<PrimExpr, ExprEntry*>> all_entries;
+    std::vector<std::pair<uint64_t, ExprEntry*>> all_entries;
     for (auto& kv : table_) {
       all_entries.push_back({kv.first, &kv.second});
     }
 
     std::stable_sort(
         all_entries.begin(), all_entries.end(),
-        [](const std::pair<PrimExpr, ExprEntry*>& a, const std::pair<PrimExpr, ExprEntry*>& b) {
+        [](const std::pair<uint64_t, ExprEntry*>& a, const std::pair<uint64_t, ExprEntry*>& b) {
           return a.second->expr_depth < b.second->expr_depth;
         });
 
@@ -638,10 +851,10 @@ class CSEPlanner : public StmtExprVisitor {
     // For each parent P with count >= 2, each child's consumed count is
     // incremented by (P.count - 1) * multiplicity. Only direct children
     // are affected — no double-counting through grandparents.
-    for (auto& [expr, entry] : all_entries) {
+    for (auto& [vn, entry] : all_entries) {
       if (entry->count < 2) continue;
-      for (const auto& [child_expr, mult] : entry->children) {
-        auto cit = table_.find(child_expr);
+      for (const auto& [child_vn, mult] : entry->children) {
+        auto cit = table_.find(child_vn);
         if (cit != table_.end()) {
           cit->second.consumed += (entry->count - 1) * mult;
         }
@@ -653,35 +866,27 @@ class CSEPlanner : public StmtExprVisitor {
     int counter = 0;
 
     // Step 3: Process each candidate (shallower first)
-    for (auto& [expr, entry] : all_entries) {
+    for (auto& [vn, entry] : all_entries) {
       if (entry->count - entry->consumed < 2) continue;
 
       // Step 3a: Determine where to insert the Bind
       Stmt insert_at = FindInsertionStmt(*entry);
 
-      // Step 3b: Create CSE variable and Bind statement.
-      // entry->repr may already contain CSE vars from shallower entries.
+      // Step 3b: Create CSE variable and Bind statement. Rewriting through
+      // the remap built so far makes the Bind value reference the CSE
+      // variables of shallower entries; this entry's own number is added to
+      // the remap only afterwards, so the value itself survives.
       ++counter;
       std::string name = "cse_v" + std::to_string(counter);
       Var cse_var(name, entry->repr.ty());
-      Stmt bind = Bind(cse_var, entry->repr);
+      Stmt bind = Bind(cse_var, RewritePlanned(entry->repr, expr_remap));
 
       // Step 3c: Record in output tables.
-      // expr_remap maps the ORIGINAL expression (for tree matching by the rewriter).
       insert_before[insert_at].push_back(bind);
-      expr_remap[expr] = cse_var;
-
-      // Step 3d: Propagate into deeper entries' repr.
-      // Replace occurrences of this entry's repr with cse_var so that
-      // deeper Bind values reference the CSE variable instead of
-      // recomputing the sub-expression.
-      for (auto& [other_expr, other_entry] : all_entries) {
-        if (other_entry->expr_depth <= entry->expr_depth) continue;
-        other_entry->repr = SubstituteSubexpr(other_entry->repr, entry->repr, cse_var);
-      }
+      expr_remap[vn] = cse_var;
     }
 
-    return {insert_before, expr_remap};
+    return {std::move(insert_before), std::move(vn_of_node_), std::move(expr_remap)};
   }
 
   // ------------------------------------------------------------------
@@ -689,8 +894,16 @@ class CSEPlanner : public StmtExprVisitor {
   // ------------------------------------------------------------------
   /*! \brief The scope tree (indexed by scope ID). */
   std::vector<ScopeEntry> scopes_;
-  /*! \brief Expression → metadata table. */
+  /*! \brief Value number → metadata table (eligible expressions only). */
   ExprTable table_;
+  /*! \brief Node pointer → value number (covers every numbered occurrence). */
+  ExprVNTable vn_of_node_;
+  /*! \brief Shallow signature → value number. */
+  std::unordered_map<Signature, uint64_t, SignatureHash> sig_to_vn_;
+  /*! \brief Per value number: whether the expression contains a forbidden node. */
+  std::vector<bool> vn_contains_forbidden_;
+  /*! \brief Interned StringImm payloads (string → signature word). */
+  std::unordered_map<std::string, uint64_t> interned_strings_;
   /*! \brief Scope ID of the currently visited node. */
   int current_scope_ = 0;
   /*! \brief Current statement for insertion-point tracking. Set by VisitStmt. */
@@ -724,10 +937,13 @@ class CSERewriter : public StmtExprMutator {
   /*!
    * \brief Construct a rewriter from the plan tables.
    * \param insert_before Map from stmt → list of Bind stmts to insert before it.
-   * \param expr_remap Map from expression → CSE variable to substitute.
+   * \param vn_of_node Map from expression node → value number, as assigned by the planner.
+   * \param expr_remap Map from value number → CSE variable to substitute.
    */
-  CSERewriter(InsertBeforeTable insert_before, ExprRemapTable expr_remap)
-      : insert_before_(std::move(insert_before)), expr_remap_(std::move(expr_remap)) {}
+  CSERewriter(InsertBeforeTable insert_before, ExprVNTable vn_of_node, ExprRemapTable expr_remap)
+      : insert_before_(std::move(insert_before)),
+        vn_of_node_(std::move(vn_of_node)),
+        expr_remap_(std::move(expr_remap)) {}
 
   /*!
    * \brief Apply the rewrite to a function body.
@@ -743,12 +959,18 @@ class CSERewriter : public StmtExprMutator {
   /*!
    * \brief Visit an expression, replacing it with its CSE variable if planned.
    *
-   * Checks the remap table before recursing — if the full expression matches,
-   * it is replaced without visiting children.
+   * Matches through the planner's value numbering: a pointer lookup resolves
+   * the node to its number, and a hit in the remap replaces the whole
+   * expression without visiting children. Both lookups are O(1), so phase 2
+   * adds constant work per node where a structural match would re-hash and
+   * re-compare whole subtrees.
    */
   PrimExpr VisitExpr(const PrimExpr& e) override {
-    auto it = expr_remap_.find(e);
-    if (it != expr_remap_.end()) return it->second;
+    auto vn_it = vn_of_node_.find(e.get());
+    if (vn_it != vn_of_node_.end()) {
+      auto it = expr_remap_.find(vn_it->second);
+      if (it != expr_remap_.end()) return it->second;
+    }
     return StmtExprMutator::VisitExpr(e);
   }
 
@@ -774,7 +996,9 @@ class CSERewriter : public StmtExprMutator {
  private:
   /*! \brief Plan: stmts to insert before each target. */
   InsertBeforeTable insert_before_;
-  /*! \brief Plan: expressions to replace with CSE vars. */
+  /*! \brief Plan: node → value number, for O(1) expression matching. */
+  ExprVNTable vn_of_node_;
+  /*! \brief Plan: value numbers to replace with CSE vars. */
   ExprRemapTable expr_remap_;
 };
 
@@ -787,17 +1011,18 @@ namespace transform {
 /*!
  * \brief Create the CommonSubexprElim pass.
  *
- * Plans all CSE opportunities in a single pass (shallower-first with repr
- * propagation), then rewrites the tree once.
+ * Plans all CSE opportunities in a single value-numbered pass
+ * (shallower-first), then rewrites the tree once.
  *
  * \return The pass.
  */
 Pass CommonSubexprElim() {
   auto pass_func = [](PrimFunc f, IRModule m, PassContext ctx) {
-    auto [insert_before, expr_remap] = CSEPlanner::Plan(f->body);
+    auto [insert_before, vn_of_node, expr_remap] = CSEPlanner::Plan(f->body);
     if (!insert_before.empty()) {
       auto* n = f.CopyOnWrite();
-      n->body = CSERewriter(std::move(insert_before), std::move(expr_remap)).Rewrite(f->body);
+      n->body = CSERewriter(std::move(insert_before), std::move(vn_of_node), std::move(expr_remap))
+                    .Rewrite(f->body);
     }
     return f;
   };
@@ -0,0 +1,68 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file compact_ir_layout.cc
+ * \brief Re-materialize a module's IR nodes in traversal order.
+ *
+ * After a long pass pipeline, the nodes of a surviving AST are scattered
+ * across the heap: every pass interleaves its freshly-allocated nodes with
+ * survivors from earlier generations, so a visitor walking the final tree
+ * chases pointers in allocation-history order rather than traversal order.
+ * On large modules the visitor-heavy passes in this directory then spend
+ * most of their time waiting on cache misses.
+ *
+ * IR nodes are individually reference-counted ffi objects, so they cannot
+ * be moved in place into a contiguous slab. What we can do is rebuild the
+ * module in one burst: the JSON-graph round trip (the same mechanism
+ * meta_schedule uses for module deep copies) re-allocates every node in
+ * graph traversal order, which the allocator lays out near-contiguously.
+ * A pass pipeline running after the compaction therefore touches memory
+ * roughly sequentially.
+ *
+ * The round trip preserves structural contents and the consistency of all
+ * intra-module references (a cloned Var or GlobalVar is shared by its
+ * definition and all its uses), but not node identity: any externally held
+ * `same_as`-based cache is invalidated. Run it at phase boundaries, e.g.
+ * before a lowering phase that will traverse a large module many times.
+ */
+#include <tvm/ffi/extra/serialization.h>
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/ir/transform.h>
+#include <tvm/tirx/transform.h>
+
+namespace tvm {
+namespace tirx {
+namespace transform {
+
+Pass CompactIRLayout() {
+  auto pass_func = [](IRModule mod, PassContext ctx) {
+    return ffi::FromJSONGraph(ffi::ToJSONGraph(mod)).cast<IRModule>();
+  };
+  return tvm::transform::CreateModulePass(pass_func, 0, "tirx.CompactIRLayout", {});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("tirx.transform.CompactIRLayout", CompactIRLayout);
+}
+
+}  // namespace transform
+}  // namespace tirx
+}  // namespace tvm
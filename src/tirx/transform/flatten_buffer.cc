@@ -27,6 +27,7 @@
 #include <tvm/ir/type.h>
 #include <tvm/tirx/analysis.h>
 #include <tvm/tirx/layout.h>
+#include <tvm/tirx/op.h>
 #include <tvm/tirx/stmt_functor.h>
 #include <tvm/tirx/transform.h>
 
@@ -161,9 +162,100 @@ class BufferFlattener : public arith::IRMutatorWithAnalyzer {
     return load;
   }
 
+  /*!
+   * \brief Per-buffer linearization plan.
+   *
+   * For each input axis this records the output axis group it belongs to
+   * (as split by the buffer's axis_separators) and its stride within that
+   * group.  Strides are the suffix products of the buffer shape, simplified
+   * once when the plan is built; an undefined stride stands for the
+   * innermost stride of 1.
+   */
+  struct FlattenPlan {
+    std::vector<size_t> group_of_axis;
+    std::vector<PrimExpr> strides;
+    size_t num_groups;
+  };
+
+  const FlattenPlan& GetFlattenPlan(const Buffer& buf) {
+    auto it = flatten_plan_.find(buf);
+    if (it != flatten_plan_.end()) {
+      return it->second;
+    }
+
+    FlattenPlan plan;
+    size_t ndim = buf->shape.size();
+    plan.num_groups = buf->axis_separators.size() + 1;
+    plan.group_of_axis.resize(ndim);
+    plan.strides.resize(ndim);
+
+    size_t group = 0;
+    for (size_t i = 0; i < ndim; ++i) {
+      if (group < buf->axis_separators.size() &&
+          i == static_cast<size_t>(buf->axis_separators[group]->value)) {
+        group++;
+      }
+      plan.group_of_axis[i] = group;
+    }
+
+    if (buf->strides.size()) {
+      TVM_FFI_ICHECK_EQ(buf->strides.size(), ndim)
+          << "If strides are defined, "
+          << "their dimensionality must match the dimensionality of the buffer.";
+      for (size_t i = 0; i < ndim; ++i) {
+        plan.strides[i] = buf->strides[i];
+      }
+    } else {
+      // Suffix products of the shape, restarting at each axis separator.
+      PrimExpr running;
+      size_t current_group = plan.num_groups;
+      for (size_t i = ndim; i > 0; --i) {
+        size_t axis = i - 1;
+        if (plan.group_of_axis[axis] != current_group) {
+          current_group = plan.group_of_axis[axis];
+          running = PrimExpr();
+        }
+        plan.strides[axis] = running;
+        running = running.defined() ? analyzer_->canonical_simplify(running * buf->shape[axis])
+                                    : buf->shape[axis];
+      }
+    }
+
+    return flatten_plan_.emplace(buf, std::move(plan)).first->second;
+  }
+
   ffi::Array<PrimExpr> GetSimplifiedElemOffset(const Buffer& buffer,
                                                const ffi::Array<PrimExpr>& indices) {
-    auto flattened_indices = buffer->ElemOffset(indices);
+    TVM_FFI_ICHECK_EQ(buffer->shape.size(), indices.size())
+        << "Buffer " << buffer->name << " is " << buffer->shape.size()
+        << "-dimensional, cannot be indexed with the " << indices.size()
+        << "-dimensional indices provided.";
+    const FlattenPlan& plan = GetFlattenPlan(buffer);
+
+    // Emit the linearized index directly in sum-of-products form with the
+    // cached strides, so IterMapSimplify starts from the canonical shape
+    // instead of re-deriving it from a per-access multiply chain.
+    std::vector<PrimExpr> group_offsets(plan.num_groups);
+    for (size_t i = 0; i < indices.size(); ++i) {
+      PrimExpr term = indices[i];
+      if (plan.strides[i].defined() && !is_one(plan.strides[i])) {
+        term = term * plan.strides[i];
+      }
+      PrimExpr& offset = group_offsets[plan.group_of_axis[i]];
+      offset = offset.defined() ? offset + term : term;
+    }
+
+    if (buffer->elem_offset.defined() && !is_zero(buffer->elem_offset)) {
+      TVM_FFI_ICHECK_EQ(plan.num_groups, 1)
+          << "A non-zero element offset is only supported for flat memory allocations.";
+      group_offsets[0] = group_offsets[0].defined() ? group_offsets[0] + buffer->elem_offset
+                                                    : buffer->elem_offset;
+    }
+
+    ffi::Array<PrimExpr> flattened_indices;
+    for (const PrimExpr& offset : group_offsets) {
+      flattened_indices.push_back(offset.defined() ? offset : PrimExpr(0));
+    }
     return this->IterMapSimplifyWithContext(flattened_indices, false);
   }
 
@@ -209,6 +301,9 @@ class BufferFlattener : public arith::IRMutatorWithAnalyzer {
   /*! \brief Map of buffers being remapped. */
   std::unordered_map<Buffer, Buffer, ffi::ObjectPtrHash, ffi::ObjectPtrEqual> buffer_remap_;
 
+  /*! \brief Cached linearization plans, one per accessed buffer. */
+  std::unordered_map<Buffer, FlattenPlan, ffi::ObjectPtrHash, ffi::ObjectPtrEqual> flatten_plan_;
+
   /*! \brief Set of buffers accessed during visitation (used to emit DeclBuffer for param buffers).
    */
   std::unordered_set<Buffer, ffi::ObjectPtrHash, ffi::ObjectPtrEqual> buffers_used_;
@@ -0,0 +1,185 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file hoist_tile_config.cc
+ * \brief Hoist loop-invariant tile-configuration calls out of loops.
+ *
+ * Tensorized AMX kernels configure the tile registers (ldtilecfg) before
+ * issuing tile loads and TMUL instructions.  When the tensor intrinsic's
+ * implementation carries the configuration call, lowering leaves one call per
+ * tensorized loop iteration even though every iteration uses the same palette.
+ * Reconfiguring drains the tile state and stalls the TMUL pipeline, so the
+ * repeated calls dominate small GEMM tiles.
+ *
+ * This pass hoists a tile-configuration call in front of the enclosing serial
+ * loop when every configuration call under that loop is identical,
+ * unconditionally executed, and independent of the loop variable.  Applied
+ * bottom-up, a config inside a loop nest bubbles up to the outermost loop
+ * that satisfies these conditions.
+ */
+#include <tvm/ffi/extra/structural_equal.h>
+#include <tvm/ffi/function.h>
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/tirx/analysis.h>
+#include <tvm/tirx/builtin.h>
+#include <tvm/tirx/op.h>
+#include <tvm/tirx/stmt.h>
+#include <tvm/tirx/stmt_functor.h>
+#include <tvm/tirx/transform.h>
+
+#include <vector>
+
+namespace tvm {
+namespace tirx {
+
+namespace {
+
+// Whether the evaluated call configures the tile registers.  Both the extern
+// lowering (llvm.x86.ldtilecfg or the amx_tileconfig shim) and the
+// packed-call form used by the runtime are recognized.
+bool IsTileConfigCall(const EvaluateNode* op) {
+  const auto* call = op->value.as<CallNode>();
+  if (call == nullptr || call->args.empty()) {
+    return false;
+  }
+  if (!call->op.same_as(builtin::call_extern()) &&
+      !call->op.same_as(builtin::tvm_call_packed())) {
+    return false;
+  }
+  const auto* symbol = call->args[0].as<StringImmNode>();
+  if (symbol == nullptr) {
+    return false;
+  }
+  const ffi::String& name = symbol->value;
+  return name == "runtime.amx_tileconfig" || name == "amx_tileconfig" ||
+         name == "llvm.x86.ldtilecfg" || name == "llvm.x86.ldtilecfg.internal";
+}
+
+// Collects the tile-configuration calls under a statement, tracking whether
+// any of them executes conditionally relative to the root.
+class TileConfigCollector : public StmtVisitor {
+ public:
+  static TileConfigCollector Collect(const Stmt& stmt) {
+    TileConfigCollector collector;
+    collector(stmt);
+    return collector;
+  }
+
+  std::vector<Stmt> configs;
+  bool has_conditional_config{false};
+
+ private:
+  void VisitStmt_(const EvaluateNode* op) final {
+    if (IsTileConfigCall(op)) {
+      if (conditional_depth_ > 0) {
+        has_conditional_config = true;
+      } else {
+        configs.push_back(ffi::GetRef<Stmt>(op));
+      }
+    }
+  }
+
+  void VisitStmt_(const IfThenElseNode* op) final {
+    ++conditional_depth_;
+    StmtVisitor::VisitStmt_(op);
+    --conditional_depth_;
+  }
+
+  void VisitStmt_(const WhileNode* op) final {
+    ++conditional_depth_;
+    StmtVisitor::VisitStmt_(op);
+    --conditional_depth_;
+  }
+
+  int conditional_depth_{0};
+};
+
+// Erases the tile-configuration calls from a statement, leaving no-ops that
+// RemoveNoOp cleans up afterwards.
+class TileConfigEraser : public StmtMutator {
+ private:
+  Stmt VisitStmt_(const EvaluateNode* op) final {
+    if (IsTileConfigCall(op)) {
+      return Evaluate(0);
+    }
+    return StmtMutator::VisitStmt_(op);
+  }
+};
+
+class TileConfigHoister : public StmtMutator {
+ public:
+  Stmt VisitStmt_(const ForNode* op) final {
+    // Post order, so configs hoisted out of inner loops sit at the head of
+    // this loop's body and can bubble further out.
+    Stmt stmt = StmtMutator::VisitStmt_(op);
+    op = stmt.as<ForNode>();
+    if (op->kind != ForKind::kSerial && op->kind != ForKind::kUnrolled) {
+      return stmt;
+    }
+    TileConfigCollector collected = TileConfigCollector::Collect(op->body);
+    if (collected.configs.empty() || collected.has_conditional_config) {
+      return stmt;
+    }
+    // Hoisting is only sound when the loop applies one configuration: all
+    // calls identical and none depending on the loop variable.
+    const Stmt& config = collected.configs.front();
+    for (const Stmt& other : collected.configs) {
+      if (!ffi::StructuralEqual::Equal(config, other, /*map_free_vars=*/false,
+                                       /*skip_tensor_content=*/false)) {
+        return stmt;
+      }
+    }
+    const VarNode* loop_var = op->loop_var.get();
+    if (UsesVar(config, [loop_var](const VarNode* var) { return var == loop_var; })) {
+      return stmt;
+    }
+    Stmt body = TileConfigEraser()(op->body);
+    auto n = CopyOnWrite(op);
+    n->body = std::move(body);
+    return SeqStmt::Flatten(config, For(n));
+  }
+};
+
+}  // namespace
+
+namespace transform {
+
+Pass HoistTileConfigInternal() {
+  auto pass_func = [](PrimFunc f, IRModule m, PassContext ctx) {
+    auto* n = f.CopyOnWrite();
+    n->body = TileConfigHoister()(std::move(n->body));
+    return f;
+  };
+  return CreatePrimFuncPass(pass_func, 0, "tirx.HoistTileConfigInternal", {});
+}
+
+Pass HoistTileConfig() {
+  return Sequential({HoistTileConfigInternal(), RemoveNoOp()}, "tirx.HoistTileConfig");
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("tirx.transform.HoistTileConfig", HoistTileConfig);
+}
+
+}  // namespace transform
+
+}  // namespace tirx
+}  // namespace tvm
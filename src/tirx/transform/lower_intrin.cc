@@ -32,6 +32,8 @@
 #include <tvm/tirx/op.h>
 #include <tvm/tirx/transform.h>
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
 #include <unordered_set>
 
@@ -47,8 +49,9 @@ class IntrinInjecter : public tvm::arith::IRMutatorWithAnalyzer {
   using IRMutatorWithAnalyzer::VisitStmt_;
   using FLowerGeneral = ffi::TypedFunction<PrimExpr(PrimExpr)>;
 
-  IntrinInjecter(const arith::Analyzer& analyzer, const Target& tgt, bool enable_fast_math)
-      : IRMutatorWithAnalyzer(analyzer) {
+  IntrinInjecter(const arith::Analyzer& analyzer, const Target& tgt, bool enable_fast_math,
+                 int bounded_fast_math_bits)
+      : IRMutatorWithAnalyzer(analyzer), bounded_fast_math_bits_(bounded_fast_math_bits) {
     std::string target = tgt->kind->name;
     ffi::String mtriple = tgt->GetAttr<ffi::String>("mtriple").value_or("");
 
@@ -81,6 +84,11 @@ class IntrinInjecter : public tvm::arith::IRMutatorWithAnalyzer {
   }
 
   PrimExpr VisitExpr_(const CallNode* op) final {
+    if (bounded_fast_math_bits_ > 0) {
+      if (ffi::Optional<PrimExpr> bounded = TryLowerBoundedIntrin(op)) {
+        return this->VisitExpr(bounded.value());
+      }
+    }
     if (auto* ptr_op = op->op.as<OpNode>()) {
       for (const auto& f_attr_map : attr_maps_) {
         FLowerGeneral f = f_attr_map.get(ffi::GetRef<Op>(ptr_op), nullptr);
@@ -266,6 +274,96 @@ class IntrinInjecter : public tvm::arith::IRMutatorWithAnalyzer {
   }
 
  private:
+  /*!
+   * \brief Try to lower exp/erf to a range-specialized approximation.
+   *
+   * Quantized models evaluate the transcendentals over small provable domains
+   * (e.g. dequantized int8 activations). When the argument range can be
+   * bounded, a clamp-free polynomial of the lowest degree that meets the
+   * configured accuracy budget replaces the generic lowering.
+   */
+  ffi::Optional<PrimExpr> TryLowerBoundedIntrin(const CallNode* op) {
+    static const Op& exp_op = Op::Get("tirx.exp");
+    static const Op& erf_op = Op::Get("tirx.erf");
+    bool is_exp = op->op.same_as(exp_op);
+    if (!is_exp && !op->op.same_as(erf_op)) return std::nullopt;
+    if (op->args.size() != 1) return std::nullopt;
+    PrimType ty = op->ty();
+    if (ty.code() != DLDataTypeCode::kDLFloat) return std::nullopt;
+    double lo, hi;
+    if (!TryBoundFloatDomain(op->args[0], /*depth=*/0, &lo, &hi)) return std::nullopt;
+    if (is_exp) {
+      return bounded_exp_float_expr(op->args[0], lo, hi, bounded_fast_math_bits_);
+    }
+    return bounded_erf_float_expr(op->args[0], ty.bits(), lo, hi, bounded_fast_math_bits_);
+  }
+
+  /*!
+   * \brief Bound the value domain of a float expression with interval analysis.
+   *
+   * Constant integer bounds from the analyzer propagate through the cast at
+   * the dequantization boundary; the float arithmetic on top of it is folded
+   * with plain interval arithmetic.
+   */
+  bool TryBoundFloatDomain(const PrimExpr& e, int depth, double* lo, double* hi) {
+    constexpr int kMaxDepth = 16;
+    if (depth >= kMaxDepth) return false;
+    if (const FloatImmNode* imm = e.as<FloatImmNode>()) {
+      *lo = *hi = imm->value;
+      return true;
+    }
+    if (const CastNode* cast_node = e.as<CastNode>()) {
+      PrimType value_ty = cast_node->value.ty();
+      if (value_ty.code() == DLDataTypeCode::kDLFloat) {
+        return TryBoundFloatDomain(cast_node->value, depth + 1, lo, hi);
+      }
+      if (!value_ty.MatchesCode(DLDataTypeCode::kDLInt, DLDataTypeCode::kDLUInt)) {
+        return false;
+      }
+      arith::ConstIntBound bound = analyzer_->const_int_bound(cast_node->value);
+      if (bound->min_value == arith::ConstIntBound::kNegInf ||
+          bound->max_value == arith::ConstIntBound::kPosInf) {
+        return false;
+      }
+      *lo = static_cast<double>(bound->min_value);
+      *hi = static_cast<double>(bound->max_value);
+      return true;
+    }
+    if (const BroadcastNode* broadcast = e.as<BroadcastNode>()) {
+      return TryBoundFloatDomain(broadcast->value, depth + 1, lo, hi);
+    }
+    double a_lo, a_hi, b_lo, b_hi;
+    auto bound_operands = [&](const PrimExpr& a, const PrimExpr& b) {
+      return TryBoundFloatDomain(a, depth + 1, &a_lo, &a_hi) &&
+             TryBoundFloatDomain(b, depth + 1, &b_lo, &b_hi);
+    };
+    if (const AddNode* add = e.as<AddNode>()) {
+      if (!bound_operands(add->a, add->b)) return false;
+      *lo = a_lo + b_lo;
+      *hi = a_hi + b_hi;
+    } else if (const SubNode* sub = e.as<SubNode>()) {
+      if (!bound_operands(sub->a, sub->b)) return false;
+      *lo = a_lo - b_hi;
+      *hi = a_hi - b_lo;
+    } else if (const MulNode* mul = e.as<MulNode>()) {
+      if (!bound_operands(mul->a, mul->b)) return false;
+      double products[4] = {a_lo * b_lo, a_lo * b_hi, a_hi * b_lo, a_hi * b_hi};
+      *lo = *std::min_element(products, products + 4);
+      *hi = *std::max_element(products, products + 4);
+    } else if (const MinNode* min_node = e.as<MinNode>()) {
+      if (!bound_operands(min_node->a, min_node->b)) return false;
+      *lo = std::min(a_lo, b_lo);
+      *hi = std::min(a_hi, b_hi);
+    } else if (const MaxNode* max_node = e.as<MaxNode>()) {
+      if (!bound_operands(max_node->a, max_node->b)) return false;
+      *lo = std::max(a_lo, b_lo);
+      *hi = std::max(a_hi, b_hi);
+    } else {
+      return false;
+    }
+    return std::isfinite(*lo) && std::isfinite(*hi);
+  }
+
   PrimExpr SwapBroadcastCast(const PrimExpr& e) {
     // Try to change broadcast(cast(x)) to cast(broadcast(x))
     // For some targets, LLVM will generate more efficient FMA
@@ -368,13 +466,18 @@ class IntrinInjecter : public tvm::arith::IRMutatorWithAnalyzer {
   std::vector<OpAttrMap<FLowerGeneral>> attr_maps_;
   FLowerGeneral fma_{nullptr};
   bool support_bitwise_op_{true};
+  // accuracy budget for range-specialized intrinsic lowering, 0 disables it
+  int bounded_fast_math_bits_{0};
 };
 
 Stmt LowerIntrinStmt(Stmt stmt, const std::string& target) {
   arith::Analyzer analyzer;
-  bool enable_fast_math =
-      transform::PassContext::Current()->GetConfig<bool>("tirx.enable_fast_math", false).value();
-  return IntrinInjecter(analyzer, Target(ffi::String(target)), enable_fast_math)(std::move(stmt));
+  transform::PassContext ctx = transform::PassContext::Current();
+  bool enable_fast_math = ctx->GetConfig<bool>("tirx.enable_fast_math", false).value();
+  int bounded_fast_math_bits =
+      static_cast<int>(ctx->GetConfig<int64_t>("tirx.bounded_fast_math_bits", int64_t{0}).value());
+  return IntrinInjecter(analyzer, Target(ffi::String(target)), enable_fast_math,
+                        bounded_fast_math_bits)(std::move(stmt));
 }
 
 namespace transform {
@@ -386,7 +489,10 @@ Pass LowerIntrin() {
     TVM_FFI_ICHECK(target.defined()) << "LowerIntrin: Require the target attribute";
     arith::Analyzer analyzer;
     bool enable_fast_math = ctx->GetConfig<bool>("tirx.enable_fast_math", false).value();
-    n->body = IntrinInjecter(analyzer, target.value(), enable_fast_math)(std::move(n->body));
+    int bounded_fast_math_bits = static_cast<int>(
+        ctx->GetConfig<int64_t>("tirx.bounded_fast_math_bits", int64_t{0}).value());
+    n->body = IntrinInjecter(analyzer, target.value(), enable_fast_math,
+                             bounded_fast_math_bits)(std::move(n->body));
     return f;
   };
   return CreatePrimFuncPass(pass_func, 0, "tirx.LowerIntrin", {});
@@ -538,11 +538,22 @@ class BuiltinLower : public StmtExprMutator {
                     std::vector<tirx::Stmt>* prep_seq) {
     auto* call_pattern = arg.as<CallNode>();
     if (call_pattern && call_pattern->op.same_as(builtin::anylist_getitem())) {
-      // call runtime function to set anylist
-      static const Op& anylist_set_packed_arg_op = Op::Get("tirx.TVMBackendAnyListSetPackedArg");
-      prep_seq->emplace_back(Evaluate(Call(
-          PrimType::Int(32), anylist_set_packed_arg_op,
-          {call_pattern->args[0], call_pattern->args[1], args_stack, ConstInt32(stack_offset)})));
+      // The list slot holds a borrowed TVMFFIAny, so forwarding it to the
+      // call stack is a plain 16-byte copy; emit it inline rather than
+      // through the TVMBackendAnyListSetPackedArg helper, which costs an
+      // out-of-line call per argument per kernel invocation.
+      PrimExpr list_handle = call_pattern->args[0];
+      PrimExpr list_index = call_pattern->args[1];
+      prep_seq->emplace_back(TVMStructSet(
+          args_stack, stack_offset, builtin::kTVMFFIAnyTypeIndex,
+          TVMStructGet(PrimType::Int(32), list_handle, list_index, builtin::kTVMFFIAnyTypeIndex)));
+      prep_seq->emplace_back(
+          TVMStructSet(args_stack, stack_offset, builtin::kTVMFFIAnyZeroPadding,
+                       TVMStructGet(PrimType::Int(32), list_handle, list_index,
+                                    builtin::kTVMFFIAnyZeroPadding)));
+      prep_seq->emplace_back(TVMStructSet(
+          args_stack, stack_offset, builtin::kTVMFFIAnyUnionValue,
+          TVMStructGet(PrimType::Int(64), list_handle, list_index, builtin::kTVMFFIAnyUnionValue)));
     } else {
       PrimType arg_ty = arg.ty();
       PrimType api_ty = APIType(arg_ty);
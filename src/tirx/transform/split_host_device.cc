@@ -115,6 +115,84 @@ class LaunchBoundsAttrExtractor : public StmtMutator {
   std::optional<int64_t> min_blocks_per_sm_;
 };
 
+/*!
+ * \brief Rewrite a small-grid kernel into a persistent grid-stride form.
+ *
+ * When the device target defines "max_persistent_blocks", the kernel is
+ * launched with at most that many thread blocks, and each block walks the
+ * original grid with a serial stride loop:
+ *
+ *     // before                          // after
+ *     attr [bx] thread_extent = N        attr [bx] thread_extent = min(N, cap)
+ *     body(bx)                           for (step, 0, ceildiv(N, min(N, cap)))
+ *                                          vbx = bx + step * min(N, cap)
+ *                                          if (vbx < N) body(vbx)
+ *
+ * This keeps a sequence of small decode-style kernels resident on the
+ * device instead of paying a launch per tiny grid.  The guard condition
+ * is uniform within a block, so block-wide synchronization in the body
+ * remains valid.  Only kernels that bind a single blockIdx.x axis are
+ * rewritten; multi-dimensional grids launch as-is.
+ */
+class PersistentBlockRewriter : public StmtMutator {
+ public:
+  static Stmt Apply(Stmt stmt, int64_t max_blocks) {
+    struct GridScanner : StmtVisitor {
+      void VisitStmt_(const AttrStmtNode* op) final {
+        if (op->attr_key == attr::thread_extent) {
+          if (auto iv = op->node.as<IterVar>()) {
+            const ffi::String& tag = iv.value()->thread_tag;
+            if (tag == "blockIdx.x") {
+              num_block_x++;
+            } else if (tag == "blockIdx.y" || tag == "blockIdx.z") {
+              multi_dim_grid = true;
+            }
+          }
+        }
+        StmtVisitor::VisitStmt_(op);
+      }
+      int num_block_x{0};
+      bool multi_dim_grid{false};
+    } scanner;
+    scanner(stmt);
+    if (scanner.num_block_x != 1 || scanner.multi_dim_grid) {
+      return stmt;
+    }
+    PersistentBlockRewriter rewriter(max_blocks);
+    return rewriter(std::move(stmt));
+  }
+
+ private:
+  explicit PersistentBlockRewriter(int64_t max_blocks) : max_blocks_(max_blocks) {}
+
+  Stmt VisitStmt_(const AttrStmtNode* op) final {
+    if (op->attr_key != attr::thread_extent) {
+      return StmtMutator::VisitStmt_(op);
+    }
+    auto iv = op->node.as<IterVar>();
+    if (!iv || iv.value()->thread_tag != "blockIdx.x") {
+      return StmtMutator::VisitStmt_(op);
+    }
+    PrimExpr extent = op->value;
+    // A grid that statically fits under the cap launches unchanged.
+    if (const auto* imm = extent.as<IntImmNode>(); imm && imm->value <= max_blocks_) {
+      return ffi::GetRef<Stmt>(op);
+    }
+    Var block_var = iv.value()->var;
+    PrimExpr grid_size = min(extent, IntImm(block_var.ty(), max_blocks_));
+    Var virtual_block(block_var->name_hint + "_virtual", block_var.ty());
+    Var step(block_var->name_hint + "_step", block_var.ty());
+    Stmt body = Substitute(op->body, {{block_var, virtual_block}});
+    body = IfThenElse(virtual_block < extent, body);
+    body = SeqStmt::Flatten(Bind(virtual_block, block_var + step * grid_size), body);
+    Stmt loop = For(step, IntImm(block_var.ty(), 0), ceildiv(extent, grid_size), ForKind::kSerial,
+                    body);
+    return AttrStmt(op->node, op->attr_key, grid_size, loop, op->span);
+  }
+
+  int64_t max_blocks_;
+};
+
 class HostDeviceSplitter : public StmtMutator {
  public:
   explicit HostDeviceSplitter(IRModule* device_mod, std::function<GlobalVar()> var_supply,
@@ -181,6 +259,9 @@ class HostDeviceSplitter : public StmtMutator {
     }
     LaunchBoundsAttrExtractor launch_bounds_attr;
     body = launch_bounds_attr.Extract(std::move(body));
+    if (auto max_blocks = device_target->GetAttr<int64_t>("max_persistent_blocks")) {
+      body = PersistentBlockRewriter::Apply(std::move(body), max_blocks.value());
+    }
     PrimFunc device_func(params, body, kernel_ret_type);
     device_func = WithAttrs(std::move(device_func), {{tvm::attr::kTarget, device_target},
                                                      {tirx::attr::kNoAlias, true},
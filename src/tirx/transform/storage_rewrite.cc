@@ -419,8 +419,9 @@ class StoragePlanRewriter : public StmtExprMutator {
   using AllocEntry = LinearAccessPatternFinder::AllocEntry;
 
   Stmt Rewrite(Stmt stmt, bool detect_inplace, bool enable_reuse,
-               bool reuse_require_exact_matched_dtype) {
+               bool reuse_require_exact_matched_dtype, bool merge_static_global_allocs = false) {
     detect_inplace_ = detect_inplace;
+    merge_static_global_allocs_ = merge_static_global_allocs;
     // plan the rewrite
     LinearAccessPatternFinder finder;
     finder(stmt);
@@ -620,6 +621,12 @@ class StoragePlanRewriter : public StmtExprMutator {
     // This allows effective sharing among different types as long as their alignment
     // requirement fits into the max_simd_bits.
     uint64_t bits_offset{0};
+    // First gen and last kill event index of this entry in the linearized
+    // statement sequence, maintained by PlanMemory. The interval is the
+    // union of the entry's live ranges and is used to decide whether two
+    // entries may share bytes when packed into an arena allocation.
+    size_t gen_index{std::numeric_limits<size_t>::max()};
+    size_t kill_index{std::numeric_limits<size_t>::max()};
   };
 
   // Checks whether the storage_scope is especially tagged for a specific memory.
@@ -674,9 +681,14 @@ class StoragePlanRewriter : public StmtExprMutator {
           }
         }
       }
+      if (merge_static_global_allocs_) {
+        PackArenaAllocs(vec);
+      }
       // Start allocation
       for (size_t i = 0; i < vec.size(); ++i) {
         StorageEntry* e = vec[i];
+        // packed into an arena allocation, already emitted by PackArenaAllocs.
+        if (arena_packed_.count(e)) continue;
         // already merged
         if (e->bits_offset != 0) continue;
         if (e->merged_children.size() != 0) {
@@ -818,6 +830,101 @@ class StoragePlanRewriter : public StmtExprMutator {
     }
     e->alloc_nest.push_back(AllocBuffer(buf, annotations));
   }
+  // Whether two storage entries can be live at the same time. The intervals
+  // are the union of each entry's live ranges, so the test is conservative
+  // for entries that were recycled through the free lists.
+  static bool LifetimesOverlap(const StorageEntry* a, const StorageEntry* b) {
+    return a->gen_index <= b->kill_index && b->gen_index <= a->kill_index;
+  }
+  // Pack constant-size untagged global allocations that share an attach scope
+  // into a single arena allocation. Offsets are assigned first-fit-decreasing
+  // over the liveness intervals collected by PlanMemory, so entries whose
+  // lifetimes do not interfere may share the same bytes. This collapses the
+  // per-buffer allocations a fused kernel would otherwise emit into a single
+  // workspace request at runtime.
+  void PackArenaAllocs(const std::vector<StorageEntry*>& vec) {
+    std::vector<StorageEntry*> group;
+    for (StorageEntry* e : vec) {
+      if (e->scope.tag.length() != 0 || e->scope.rank != StorageRank::kGlobal) continue;
+      if (e->const_nbits == 0) continue;
+      // small arrays are lowered to registers, keep them out of the arena.
+      if (e->const_nbits <= 32) continue;
+      if (e->bits_offset != 0 || e->merged_children.size() != 0) continue;
+      bool packable = true;
+      for (const AllocBufferNode* op : e->allocs) {
+        if (op->buffer->shape.size() != 1 || op->buffer->dtype.IsHandle() ||
+            op->buffer->dtype.IsScalableVector()) {
+          packable = false;
+          break;
+        }
+      }
+      if (packable) group.push_back(e);
+    }
+    if (group.size() < 2) return;
+    // Place big buffers first so small ones can slot into lifetime holes.
+    std::vector<StorageEntry*> order = group;
+    std::stable_sort(order.begin(), order.end(), [](const StorageEntry* a, const StorageEntry* b) {
+      return a->const_nbits > b->const_nbits;
+    });
+    struct Placement {
+      StorageEntry* entry;
+      uint64_t begin;
+      uint64_t end;
+    };
+    std::vector<Placement> placed;
+    uint64_t total_bits = 0;
+    for (StorageEntry* e : order) {
+      // Offsets are aligned so RemapIndex can convert them to whole elements
+      // for every access dtype that appears in the entry.
+      uint64_t align = 32;
+      for (const AllocBufferNode* op : e->allocs) {
+        align = std::max<uint64_t>(align, op->buffer->dtype.bits());
+      }
+      // collect the ranges occupied by interfering entries, then take the
+      // lowest aligned offset that fits between them.
+      std::vector<std::pair<uint64_t, uint64_t>> busy;
+      for (const Placement& p : placed) {
+        if (LifetimesOverlap(e, p.entry)) busy.emplace_back(p.begin, p.end);
+      }
+      std::sort(busy.begin(), busy.end());
+      uint64_t offset = 0;
+      for (const auto& range : busy) {
+        if (offset + e->const_nbits <= range.first) break;
+        if (range.second > offset) {
+          offset = range.second;
+          if (offset % align != 0) offset += align - (offset % align);
+        }
+      }
+      e->bits_offset = offset;
+      placed.push_back({e, offset, offset + e->const_nbits});
+      total_bits = std::max(total_bits, offset + e->const_nbits);
+    }
+    // The largest entry was placed first and sits at offset zero; it owns the
+    // arena allocation and the others alias its buffer var.
+    StorageEntry* owner = order[0];
+    TVM_FFI_ICHECK_EQ(owner->bits_offset, 0U);
+    owner->alloc_var = owner->allocs[0]->buffer->data;
+    bool any_volatile = false;
+    for (StorageEntry* e : group) {
+      if (e != owner) {
+        e->alloc_var = owner->alloc_var;
+      }
+      if (e->is_volatile) any_volatile = true;
+    }
+    uint64_t type_bits = owner->elem_type.bits() * owner->elem_type.lanes();
+    PrimExpr alloc_size = MakeConst(owner->allocs[0]->buffer->shape[0].ty(),
+                                    (total_bits + type_bits - 1) / type_bits);
+    Buffer buf(owner->alloc_var, owner->elem_type, {alloc_size}, {}, PrimExpr(),
+               owner->alloc_var->name_hint, 0, 0, BufferType::kDefault);
+    ffi::Map<ffi::String, ffi::Any> annotations;
+    if (any_volatile) {
+      annotations.Set(attr::kVolatile, true);
+    }
+    owner->alloc_nest.push_back(AllocBuffer(buf, annotations));
+    for (StorageEntry* e : group) {
+      arena_packed_.insert(e);
+    }
+  }
   // Liveness analysis to find gen and kill point of each variable.
   void LivenessAnalysis(const std::vector<StmtEntry>& seq) {
     // find kill point, do a reverse linear scan.
@@ -932,6 +1039,9 @@ class StoragePlanRewriter : public StmtExprMutator {
             dst_entry->is_volatile = true;
           }
           alloc_map_[var] = dst_entry;
+          dst_entry->gen_index = std::min(dst_entry->gen_index, i);
+          // live again until the next kill event.
+          dst_entry->kill_index = std::numeric_limits<size_t>::max();
         }
       }
       // enter/exit new scope
@@ -959,7 +1069,7 @@ class StoragePlanRewriter : public StmtExprMutator {
         for (const VarNode* var : it->second.kill) {
           // skip space which are already replaced by inplace
           if (!inplace_flag.count(var)) {
-            this->Free(var);
+            this->Free(var, i);
           }
         }
       }
@@ -1061,11 +1171,12 @@ class StoragePlanRewriter : public StmtExprMutator {
     return NewAlloc(op, attach_scope, scope, const_nbits);
   }
   // simulated free.
-  void Free(const VarNode* var) {
+  void Free(const VarNode* var, size_t kill_index) {
     auto it = alloc_map_.find(var);
     TVM_FFI_ICHECK(it != alloc_map_.end());
     StorageEntry* e = it->second;
     TVM_FFI_ICHECK_NE(e->allocs.size(), 0U);
+    e->kill_index = kill_index;
 
     // disable reuse of small arrays, they will be lowered to registers in LLVM
     // This rules only apply if we are using non special memory
@@ -1089,6 +1200,10 @@ class StoragePlanRewriter : public StmtExprMutator {
   const ffi::Object* thread_scope_{nullptr};
   // whether enable inplace detection.
   bool detect_inplace_{false};
+  // whether constant-size global allocations are packed into one arena.
+  bool merge_static_global_allocs_{false};
+  // entries whose allocation was emitted by PackArenaAllocs.
+  std::unordered_set<StorageEntry*> arena_packed_;
   // Locations of free ops.
   std::unordered_map<const ffi::Object*, EventEntry> event_map_;
   // constant size free map.
@@ -1779,6 +1894,8 @@ Pass StorageRewrite() {
       // And so we don't enable reuse in this pass.
       enable_reuse = false;
     }
+    bool merge_static_global_allocs =
+        ctx->GetConfig<bool>("tirx.merge_static_global_allocs", false).value();
 
     ffi::Optional<Target> target = f->GetAttr<Target>("target");
     if (target.defined() &&
@@ -1788,7 +1905,8 @@ Pass StorageRewrite() {
     }
     auto* n = f.CopyOnWrite();
     n->body = StoragePlanRewriter().Rewrite(std::move(n->body), true, enable_reuse,
-                                            reuse_require_exact_matched_dtype);
+                                            reuse_require_exact_matched_dtype,
+                                            merge_static_global_allocs);
     // Parameters may not be rewritten, but internal allocations may.
     return PointerValueTypeRewrite(std::move(f), true, false, false, true, true, true, false);
   };
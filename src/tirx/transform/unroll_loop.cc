@@ -26,6 +26,7 @@
 #include <tvm/ffi/cast.h>
 #include <tvm/ffi/function.h>
 #include <tvm/ffi/reflection/registry.h>
+#include <tvm/target/target.h>
 #include <tvm/tirx/expr.h>
 #include <tvm/tirx/op.h>
 #include <tvm/tirx/stmt_functor.h>
@@ -45,6 +46,7 @@ struct UnrollLoopConfigNode : public ffi::Object {
   int auto_max_extent;
   int explicit_unroll;
   int unroll_local_access;
+  int occupancy_aware;
 
   static void RegisterReflection() {
     namespace refl = tvm::ffi::reflection;
@@ -61,7 +63,11 @@ struct UnrollLoopConfigNode : public ffi::Object {
                 "Whether to explicitly unroll the loop instead of setting a pragma",
                 refl::DefaultValue(true))
         .def_ro("unroll_local_access", &UnrollLoopConfigNode::unroll_local_access,
-                "Whether to always unroll local access", refl::DefaultValue(false));
+                "Whether to always unroll local access", refl::DefaultValue(false))
+        .def_ro("occupancy_aware", &UnrollLoopConfigNode::occupancy_aware,
+                "Whether to cap automatic unrolling by the per-thread register budget of the "
+                "target, to avoid spills that reduce GPU occupancy",
+                refl::DefaultValue(false));
   }
   TVM_FFI_DECLARE_OBJECT_INFO_FINAL("tirx.transform.UnrollLoopConfig", UnrollLoopConfigNode,
                                     ffi::Object);
@@ -88,18 +94,57 @@ class VarLocalAccessMarker : public ExprVisitor {
   std::unordered_set<Var>* var_touched_local_;
 };
 
+// Estimates how many register-resident values one iteration of a loop body
+// produces: bound SSA values plus stores into local/warp scope buffers, which
+// lowering turns into registers.  Unrolling a loop by factor k keeps roughly
+// k times this many values live at once, so the estimate bounds the register
+// cost of unrolling.  This is a coarse upper bound -- it ignores values whose
+// live ranges the register allocator can overlap -- but erring high only
+// forgoes an unroll, while erring low causes spills to local memory.
+class RegisterPressureEstimator : public StmtExprVisitor {
+ public:
+  static int Estimate(const Stmt& stmt) {
+    RegisterPressureEstimator estimator;
+    estimator(stmt);
+    return estimator.num_values_;
+  }
+
+ private:
+  void VisitStmt_(const BindNode* op) final {
+    num_values_ += NumRegisters(op->var.ty());
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitStmt_(const BufferStoreNode* op) final {
+    auto storage_scope = runtime::StorageScope::Create(GetPtrStorageScope(op->buffer->data));
+    if (storage_scope.rank == runtime::StorageRank::kLocal ||
+        storage_scope.rank == runtime::StorageRank::kWarp) {
+      num_values_ += NumRegisters(op->value.ty());
+    }
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  static int NumRegisters(const PrimType& ty) {
+    // Scalable vectors have no compile-time lane count; count one value.
+    return ty.IsScalableVector() ? 1 : std::max<int>(ty.lanes(), 1);
+  }
+
+  int num_values_{0};
+};
+
 // The Visitor is used to check whether var is used as write index in a local memory
 // If a loop var is used as indices to a local memory, it must be unrolled so
 // the local memory access can be turned into register access.
 class LoopUnroller : public StmtExprMutator {
  public:
   explicit LoopUnroller(int auto_max_step, int auto_max_depth, int auto_max_extent,
-                        bool explicit_unroll, bool unroll_local_access)
+                        bool explicit_unroll, bool unroll_local_access, int max_registers)
       : auto_max_step_(auto_max_step),
         auto_max_depth_(auto_max_depth),
         auto_max_extent_(auto_max_extent),
         explicit_unroll_(explicit_unroll),
-        unroll_local_access_(unroll_local_access) {}
+        unroll_local_access_(unroll_local_access),
+        max_registers_(max_registers) {}
 
   Stmt VisitStmt_(const AttrStmtNode* op) final {
     if (op->attr_key == "pragma_auto_unroll_max_step") {
@@ -131,6 +176,15 @@ class LoopUnroller : public StmtExprMutator {
     auto_unroll =
         auto_unroll && (value * step_count_ <= auto_max_step_ || value <= auto_max_extent_);
 
+    // Occupancy-aware cap: unrolling multiplies the per-iteration register
+    // footprint by the trip count, and exceeding the per-thread budget makes
+    // the compiler spill to local memory.  Only automatic unrolls are vetoed;
+    // explicitly requested unrolls (ForKind::kUnrolled, local-access loops)
+    // are honored as written.
+    if (auto_unroll && max_registers_ > 0 && value > 1) {
+      auto_unroll = value * RegisterPressureEstimator::Estimate(op->body) <= max_registers_;
+    }
+
     if (op->kind == ForKind::kUnrolled) {
       TVM_FFI_ICHECK_GE(value, 0) << "Cannot unroll non-constant loop";
       auto_unroll = true;
@@ -256,6 +310,8 @@ class LoopUnroller : public StmtExprMutator {
   bool explicit_unroll_;
   // Wether to unroll loops to local access.
   bool unroll_local_access_{false};
+  // Per-thread register budget for automatic unrolling; 0 disables the cap.
+  int max_registers_{0};
   // Number of normal loops in scope
   int normal_loop_depth_{0};
   // number of unrolled cases in current scope.
@@ -268,9 +324,9 @@ class LoopUnroller : public StmtExprMutator {
   arith::Analyzer analyzer_;
 };
 
-Stmt UnrollLoop(Stmt stmt, UnrollLoopConfig cfg) {
+Stmt UnrollLoop(Stmt stmt, UnrollLoopConfig cfg, int max_registers) {
   Stmt ret = LoopUnroller(cfg->auto_max_step, cfg->auto_max_depth, cfg->auto_max_extent,
-                          cfg->explicit_unroll, cfg->unroll_local_access)(stmt);
+                          cfg->explicit_unroll, cfg->unroll_local_access, max_registers)(stmt);
   if (!ret.same_as(stmt)) {
     return ConvertSSA(ret);
   } else {
@@ -278,6 +334,22 @@ Stmt UnrollLoop(Stmt stmt, UnrollLoopConfig cfg) {
   }
 }
 
+// Derives the per-thread register budget from the target attributes: the
+// register file of a block divided by the number of resident threads.  Returns
+// 0 when the target does not describe its register file, disabling the cap.
+int GetMaxRegistersPerThread(const ffi::Optional<Target>& target) {
+  if (!target.defined()) {
+    return 0;
+  }
+  auto registers_per_block = target.value()->GetAttr<int64_t>("registers_per_block");
+  auto max_num_threads = target.value()->GetAttr<int64_t>("max_num_threads");
+  if (!registers_per_block.has_value() || !max_num_threads.has_value() ||
+      max_num_threads.value() <= 0) {
+    return 0;
+  }
+  return static_cast<int>(registers_per_block.value() / max_num_threads.value());
+}
+
 namespace transform {
 
 Pass UnrollLoop() {
@@ -287,7 +359,11 @@ Pass UnrollLoop() {
     if (!cfg.defined()) {
       cfg = tvm::transform::PassConfigWithDefaults<UnrollLoopConfig>();
     }
-    n->body = UnrollLoop(std::move(f->body), cfg.value());
+    int max_registers = 0;
+    if (cfg.value()->occupancy_aware) {
+      max_registers = GetMaxRegistersPerThread(f->GetAttr<Target>(tvm::attr::kTarget));
+    }
+    n->body = UnrollLoop(std::move(f->body), cfg.value(), max_registers);
     return f;
   };
   return CreatePrimFuncPass(pass_func, 0, "tirx.UnrollLoop", {});
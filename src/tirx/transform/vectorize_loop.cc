@@ -67,25 +67,24 @@ bool TargetHasRVV(Target target) {
   return target_has_feature_fn.has_value() && (*target_has_feature_fn)("v", target).cast<bool>();
 }
 
-// File-local helper: true if the target supports Variable-Length Array extensions
-// (AArch64 SVE or RISC-V V).
-bool TargetHasVLA(Target target) {
+// File-local helper: true if the target supports AArch64 SVE.
+bool TargetHasSVE(Target target) {
   if (!target.defined()) return false;
-  bool has_vla = target->GetAttr<bool>("feature.has_sve").value_or(false);
-  if (!has_vla) {
-    if (auto mattr = target->GetAttr<ffi::Array<ffi::String>>("mattr")) {
-      for (const ffi::String& attr : mattr.value()) {
-        if (attr == "+sve") {
-          has_vla = true;
-          break;
-        }
+  if (target->GetAttr<bool>("feature.has_sve").value_or(false)) return true;
+  if (auto mattr = target->GetAttr<ffi::Array<ffi::String>>("mattr")) {
+    for (const ffi::String& attr : mattr.value()) {
+      if (attr == "+sve") {
+        return true;
       }
     }
   }
-  has_vla |= TargetHasRVV(target);
-  return has_vla;
+  return false;
 }
 
+// File-local helper: true if the target supports Variable-Length Array extensions
+// (AArch64 SVE or RISC-V V).
+bool TargetHasVLA(Target target) { return TargetHasSVE(target) || TargetHasRVV(target); }
+
 bool ContainsCallNode(const Stmt& stmt) {
   return CheckContains::StmtContains(
       stmt, [](const PrimExpr& expr) { return expr.as<CallNode>() != nullptr; });
@@ -676,6 +675,47 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
       }
     }
   }
+  // Try to recover a single Ramp from a vectorized buffer index.
+  //
+  // Flattened multi-dimensional indices (e.g. floordiv/floormod chains over
+  // the vectorized loop var) often escape the per-operator ramp propagation
+  // rules and come out as general vector expressions, which codegen has to
+  // lower as gathers/scatters. If the scalar form of the index provably
+  // advances by a loop-invariant stride between consecutive lanes, the whole
+  // index is a Ramp and we rebuild it as one.
+  PrimExpr TryRecoverRamp(const PrimExpr& scalar_index, const PrimExpr& vec_index) {
+    if (!vec_index.ty().IsFixedLengthVector()) return vec_index;
+    if (vec_index->IsInstance<RampNode>() || vec_index->IsInstance<BroadcastNode>()) {
+      return vec_index;
+    }
+    const auto* lanes_imm = var_lanes_.as<IntImmNode>();
+    if (lanes_imm == nullptr || vec_index.ty().lanes() != lanes_imm->value) return vec_index;
+    // Lane i of the vectorized index equals the scalar index at var_ = i, but
+    // only when the scalar form depends on the lanes through var_ alone.
+    // Indices that pick up lanes through vectorized let bindings are skipped.
+    bool uses_vector_let = UsesVar(scalar_index, [this](const VarNode* v) {
+      auto it = let_binding_.find(ffi::GetRef<Var>(v));
+      return it != let_binding_.end() && !it->second.same_as(it->first);
+    });
+    if (uses_vector_let) return vec_index;
+    PrimExpr next = Substitute(scalar_index, {{var_, var_ + MakeConst(var_.ty(), 1)}});
+    PrimExpr stride;
+    {
+      // The difference only needs to be invariant for adjacent lanes, so the
+      // loop var can be constrained to [0, lanes - 1) while simplifying.
+      With<arith::ConstraintContext> ctx(
+          analyzer_, var_ >= MakeConst(var_.ty(), 0) &&
+                         var_ < MakeConst(var_.ty(), lanes_imm->value - 1));
+      stride = analyzer_->Simplify(next - scalar_index);
+    }
+    if (!stride.ty().IsScalar() ||
+        UsesVar(stride, [this](const VarNode* v) { return v == var_.get(); })) {
+      return vec_index;
+    }
+    PrimExpr base =
+        analyzer_->Simplify(Substitute(scalar_index, {{var_, MakeConst(var_.ty(), 0)}}));
+    return Ramp(base, stride, var_lanes_);
+  }
   // BufferLoad
   PrimExpr VisitExpr_(const BufferLoadNode* op) final {
     auto load = ffi::GetRef<BufferLoad>(op);
@@ -683,6 +723,12 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
     auto fmutate = [this](const PrimExpr& index) { return this->VisitExpr(index); };
     ffi::Array<PrimExpr> indices = op->indices.Map(fmutate);
 
+    for (size_t i = 0; i < indices.size(); ++i) {
+      if (!indices[i].same_as(op->indices[i])) {
+        indices.Set(i, TryRecoverRamp(op->indices[i], indices[i]));
+      }
+    }
+
     if (!indices.same_as(op->indices)) {
       auto writer = load.CopyOnWrite();
       writer->indices = indices;
@@ -792,6 +838,12 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
     auto fmutate = [this](const PrimExpr& index) { return this->VisitExpr(index); };
     ffi::Array<PrimExpr> indices = op->indices.Map(fmutate);
 
+    for (size_t i = 0; i < indices.size(); ++i) {
+      if (!indices[i].same_as(op->indices[i])) {
+        indices.Set(i, TryRecoverRamp(op->indices[i], indices[i]));
+      }
+    }
+
     PrimExpr value = this->VisitExpr(op->value);
 
     if (!indices.same_as(op->indices) || !value.same_as(op->value)) {
@@ -1036,9 +1088,9 @@ class LoopVectorizer : public StmtMutator {
       TVM_FFI_ICHECK(is_zero(op->min));
       // General calls still have vectorization paths that query a compile-time
       // lane count, so keep them on the existing fixed-width path for now.
-      if (extent_as_int && extent_as_int->value > 1 && TargetHasRVV(target_) &&
+      if (extent_as_int && extent_as_int->value > 1 && TargetHasVLA(target_) &&
           !ContainsCallNode(op->body)) {
-        return VectorizeFixedLoopForRVV(op, extent_as_int->value);
+        return VectorizeFixedLoopVLA(op, extent_as_int->value);
       }
 
       if (!extent_as_int || extent_as_int->value < 1) {
@@ -1064,9 +1116,12 @@ class LoopVectorizer : public StmtMutator {
   }
 
  private:
-  Stmt VectorizeFixedLoopForRVV(const ForNode* op, int64_t extent) {
-    // Match the existing TIRx scalable-vector convention.  LLVM/RVV still
-    // selects the runtime vector length with vsetvli.
+  Stmt VectorizeFixedLoopVLA(const ForNode* op, int64_t extent) {
+    // Match the existing TIRx scalable-vector convention.  The runtime vector
+    // length comes from the hardware: SVE reads it from the implementation
+    // (one binary runs at full width on any SVE machine), RVV selects it with
+    // vsetvli.  The guard below becomes a predicated tail through
+    // TryPredicateBufferAccesses, so no scalar remainder loop is emitted.
     static constexpr int kDefaultVScaleFactor = 4;
     PrimType index_dtype = op->loop_var.ty();
     PrimExpr zero = IntImm(index_dtype, 0);
@@ -384,6 +384,30 @@ def test_union_lower_bound():
     assert result.max_value.same_as(pos_inf)
 
 
+def test_union_bounded():
+    # Disjoint intervals survive as segments; the hull stays available.
+    set_0 = tvm.arith.IntervalSet(0, 3)
+    set_1 = tvm.arith.IntervalSet(64, 67)
+    result = tvm.arith.int_set.union_bounded([set_0, set_1])
+    assert isinstance(result, tvm.arith.UnionSet)
+    assert len(result.segments) == 2
+    assert result.hull.min_value.value == 0
+    assert result.hull.max_value.value == 67
+    # Overlapping or adjacent intervals are merged back to a single interval.
+    result = tvm.arith.int_set.union_bounded(
+        [tvm.arith.IntervalSet(0, 3), tvm.arith.IntervalSet(4, 7)]
+    )
+    assert isinstance(result, tvm.arith.IntervalSet)
+    assert result.min_value.value == 0
+    assert result.max_value.value == 7
+    # Exceeding the segment bound falls back to the convex hull.
+    many = [tvm.arith.IntervalSet(i * 16, i * 16 + 3) for i in range(12)]
+    result = tvm.arith.int_set.union_bounded(many)
+    assert isinstance(result, tvm.arith.IntervalSet)
+    assert result.min_value.value == 0
+    assert result.max_value.value == 179
+
+
 def test_modular_set():
     ck = IntSetChecker()
     x = tvm.tirx.Var("x", "int32")
@@ -118,6 +118,22 @@ def test_mod():
     assert m.base == 1
 
 
+def test_floor_div_mod_negative_base():
+    analyzer = tvm.arith.Analyzer()
+    x = tvm.tirx.Var("x", "int32")
+    fld = tvm.tirx.floordiv
+    fmod = tvm.tirx.floormod
+    # the multiple of the divisor passes through the floor exactly,
+    # even though the base is negative: floordiv(x * 8 - 4, 4) == x * 2 - 1
+    m = analyzer.modular_set(fld(x * 8 - 4, 4))
+    assert m.coeff == 2
+    assert m.base == 1
+    # floormod stays within the congruence class of the base
+    m = analyzer.modular_set(fmod(x * 8 - 4, 6))
+    assert m.coeff == 2
+    assert m.base == 0
+
+
 def test_min_max_select():
     analyzer = tvm.arith.Analyzer()
     x, y = tvm.tirx.Var("x", "int32"), tvm.tirx.Var("y", "int32")
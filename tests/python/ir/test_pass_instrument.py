@@ -61,3 +61,38 @@ def test_relax_print_all_passes(capsys):
     assert "Before Running Pass:" in all_passes_output
     assert "After Running Pass:" in all_passes_output
     assert 'name="_pipeline"' in all_passes_output
+
+
+def test_pass_profiling_instrument_and_diff(tmp_path):
+    import json
+
+    from tvm.exec.pass_report_diff import diff_reports, load_report
+    from tvm.ir.instrument import PassProfilingInstrument
+
+    @T.prim_func(s_tir=True)
+    def func(a: T.handle, b: T.handle) -> None:
+        A = T.match_buffer(a, (16,))
+        B = T.match_buffer(b, (16,))
+        for i in range(16):
+            with T.sblock("B"):
+                vi = T.axis.remap("S", [i])
+                B[vi] = A[vi] * 2.0
+
+    report_path = tmp_path / "report.jsonl"
+    instrument = PassProfilingInstrument(str(report_path))
+    with tvm.transform.PassContext(opt_level=3, instruments=[instrument]):
+        tvm.compile(func)
+
+    records = [json.loads(line) for line in report_path.read_text().splitlines()]
+    assert records
+    assert records == instrument.records
+    for record in records:
+        assert record["wall_time_us"] >= 0
+        assert record["nodes_delta"] == record["nodes_after"] - record["nodes_before"]
+
+    baseline = load_report(str(report_path))
+    rows = diff_reports(baseline, baseline)
+    assert rows
+    for row in rows:
+        assert row["delta_us"] == 0
+        assert row["ratio"] == 1.0
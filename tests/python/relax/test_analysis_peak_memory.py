@@ -0,0 +1,89 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+import pytest
+
+import tvm
+import tvm.testing
+from tvm.relax.analysis import estimate_peak_memory
+from tvm.script import relax as R
+from tvm.script import tirx as T
+
+
+def test_static_shapes():
+    @tvm.script.ir_module
+    class Module:
+        @R.function(pure=False)
+        def main(x: R.Tensor((2, 4), dtype="float32")) -> R.Tensor((2, 4), dtype="float32"):
+            storage: R.Any = R.memory.alloc_storage(
+                R.shape([32]), virtual_device_index=0, storage_scope="global", dtype="float32"
+            )
+            alloc: R.Tensor((2, 4), dtype="float32") = R.memory.alloc_tensor(
+                storage, offset=0, shape=R.shape([2, 4]), dtype="float32"
+            )
+            alloc1: R.Tensor((2, 4), dtype="float32") = R.builtin.alloc_tensor(
+                R.shape([2, 4]), dtype="float32", runtime_device_index=0
+            )
+            _: R.Tuple = R.memory.kill_tensor(alloc)
+            _1: R.Tuple = R.memory.kill_storage(storage)
+            return alloc1
+
+    model = estimate_peak_memory(Module)
+    assert model.function_names == ["main"]
+    assert model.shape_params("main") == []
+    # 32 bytes of planned storage + 2 * 4 * 4 bytes of unplanned allocation
+    assert model.query("main", {}) == 64
+
+
+def test_symbolic_shapes():
+    @tvm.script.ir_module
+    class Module:
+        @R.function(pure=False)
+        def main(
+            x: R.Tensor(("batch", "seq_len"), dtype="float32"),
+        ) -> R.Tensor(("batch", "seq_len"), dtype="float32"):
+            batch = T.int64()
+            seq_len = T.int64()
+            storage: R.Any = R.memory.alloc_storage(
+                R.shape([4 * (batch * seq_len)]),
+                virtual_device_index=0,
+                storage_scope="global",
+                dtype="float32",
+            )
+            alloc: R.Tensor((batch, seq_len), dtype="float32") = R.memory.alloc_tensor(
+                storage, offset=0, shape=R.shape([batch, seq_len]), dtype="float32"
+            )
+            alloc1: R.Tensor((batch, seq_len), dtype="float16") = R.builtin.alloc_tensor(
+                R.shape([batch, seq_len]), dtype="float16", runtime_device_index=0
+            )
+            _: R.Tuple = R.memory.kill_tensor(alloc)
+            _1: R.Tuple = R.memory.kill_storage(storage)
+            return alloc1
+
+    model = estimate_peak_memory(Module)
+    assert sorted(model.shape_params("main")) == ["batch", "seq_len"]
+    # 4 * batch * seq_len planned bytes + 2 * batch * seq_len unplanned fp16 bytes
+    assert model.query("main", {"batch": 8, "seq_len": 1024}) == 6 * 8 * 1024
+    assert model.query("main", {"batch": 1, "seq_len": 128}) == 6 * 128
+    with pytest.raises(ValueError):
+        model.query("main", {"batch": 8})
+    with pytest.raises(ValueError):
+        model.query("nonexistent", {})
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
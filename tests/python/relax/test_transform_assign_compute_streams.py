@@ -0,0 +1,78 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Tests for relax.transform.AssignComputeStreams."""
+
+import tvm
+import tvm.testing
+from tvm import relax
+from tvm.script import ir as I
+from tvm.script import relax as R
+
+
+@I.ir_module
+class ForkJoinModule:
+    @R.function
+    def main(x: R.Tensor((4, 4), "float32")) -> R.Tensor((4, 4), "float32"):
+        with R.dataflow():
+            a = R.add(x, x)
+            b = R.multiply(a, a)
+            c = R.subtract(a, a)
+            gv = R.add(b, c)
+            R.output(gv)
+        return gv
+
+
+def _collect_extern_funcs(func):
+    extern_funcs = set()
+
+    def fvisit(expr):
+        if isinstance(expr, relax.ExternFunc):
+            extern_funcs.add(expr.global_symbol)
+
+    relax.analysis.post_order_visit(func, fvisit)
+    return extern_funcs
+
+
+def test_parallel_branches_get_switch_and_join():
+    mod = relax.transform.AssignComputeStreams(max_streams=2)(ForkJoinModule)
+    extern_funcs = _collect_extern_funcs(mod["main"])
+    assert extern_funcs == {"vm.builtin.stream_switch", "vm.builtin.stream_join"}
+
+
+def test_serial_block_is_untouched():
+    @I.ir_module
+    class Serial:
+        @R.function
+        def main(x: R.Tensor((4, 4), "float32")) -> R.Tensor((4, 4), "float32"):
+            with R.dataflow():
+                a = R.add(x, x)
+                b = R.multiply(a, a)
+                gv = R.add(b, b)
+                R.output(gv)
+            return gv
+
+    mod = relax.transform.AssignComputeStreams(max_streams=2)(Serial)
+    tvm.ir.assert_structural_equal(mod, Serial)
+
+
+def test_single_stream_budget_is_a_no_op():
+    mod = relax.transform.AssignComputeStreams(max_streams=1)(ForkJoinModule)
+    tvm.ir.assert_structural_equal(mod, ForkJoinModule)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
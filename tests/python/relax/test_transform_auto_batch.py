@@ -0,0 +1,69 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Tests for relax.transform.AutoBatch."""
+
+import tvm
+import tvm.testing
+from tvm import relax
+from tvm.script import ir as I
+from tvm.script import relax as R
+
+
+@I.ir_module
+class PerRequestModule:
+    @R.function
+    def main(
+        x: R.Tensor((1, 8), "float32"), w: R.Tensor((8, 8), "float32")
+    ) -> R.Tensor((1, 8), "float32"):
+        with R.dataflow():
+            gv = R.matmul(x, w)
+            R.output(gv)
+        return gv
+
+
+def test_auto_batch_adds_batched_clone():
+    mod = relax.transform.AutoBatch(["main"])(PerRequestModule)
+
+    names = {gv.name_hint for gv in mod.get_global_vars()}
+    assert names == {"main", "main_batched"}
+
+    # The per-request entry point is untouched.
+    tvm.ir.assert_structural_equal(mod["main"], PerRequestModule["main"])
+
+    batched = mod["main_batched"]
+    x_shape = batched.params[0].ty.shape
+    batch_dim = x_shape[0]
+    assert isinstance(batch_dim, tvm.tirx.Var)
+    assert batch_dim.name == "batch_size"
+    assert int(x_shape[1]) == 8
+
+    # The weight has no unit leading dimension and keeps its static shape.
+    w_shape = [int(dim) for dim in batched.params[1].ty.shape]
+    assert w_shape == [8, 8]
+
+    # The body is re-derived: the result carries the shared batch dimension.
+    out_shape = batched.body.body.ty.shape
+    assert out_shape[0].same_as(batch_dim)
+
+
+def test_auto_batch_skips_unselected_functions():
+    mod = relax.transform.AutoBatch(["other"])(PerRequestModule)
+    tvm.ir.assert_structural_equal(mod, PerRequestModule)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
@@ -1644,6 +1644,158 @@ def test_binary_ewise_scalar():
     verify(Input, Expected)
 
 
+def test_conv2d_reshape():
+    # reshape has no layout inference, so its input is rewritten to the initial
+    # layout. With a single consumer the conversion stays at the use site.
+    @I.ir_module
+    class Input:
+        @R.function
+        def main(
+            x: R.Tensor((2, 3, 28, 28), "float32"), w: R.Tensor((4, 3, 3, 3), "float32")
+        ) -> R.Tensor((2, 4, 676), "float32"):
+            with R.dataflow():
+                gv: R.Tensor((2, 4, 26, 26), "float32") = R.nn.conv2d(x, w, out_dtype="float32")
+                gv2: R.Tensor((2, 4, 676), "float32") = R.reshape(gv, R.shape([2, 4, 676]))
+                R.output(gv2)
+            return gv2
+
+    @I.ir_module
+    class Expected:
+        @R.function
+        def main(
+            x: R.Tensor((2, 3, 28, 28), dtype="float32"), w: R.Tensor((4, 3, 3, 3), dtype="float32")
+        ) -> R.Tensor((2, 4, 676), dtype="float32"):
+            with R.dataflow():
+                lv: R.Tensor((2, 28, 28, 3), dtype="float32") = R.permute_dims(x, axes=[0, 2, 3, 1])
+                lv1: R.Tensor((4, 3, 3, 3), dtype="float32") = R.permute_dims(w, axes=[0, 2, 3, 1])
+                gv: R.Tensor((2, 26, 26, 4), dtype="float32") = R.nn.conv2d(
+                    lv,
+                    lv1,
+                    strides=[1, 1],
+                    padding=[0, 0, 0, 0],
+                    dilation=[1, 1],
+                    groups=1,
+                    data_layout="NHWC",
+                    kernel_layout="OHWI",
+                    out_layout="NHWC",
+                    out_dtype="float32",
+                )
+                lv2: R.Tensor((2, 4, 26, 26), dtype="float32") = R.permute_dims(
+                    gv, axes=[0, 3, 1, 2]
+                )
+                gv2: R.Tensor((2, 4, 676), dtype="float32") = R.reshape(lv2, R.shape([2, 4, 676]))
+                R.output(gv2)
+            return gv2
+
+    verify(Input, Expected)
+
+
+def test_conv2d_reshape_fork():
+    # When several consumers expect the initial layout, the planner realizes the
+    # conv output in that layout: one conversion at the definition instead of one
+    # per consumer.
+    @I.ir_module
+    class Input:
+        @R.function
+        def main(
+            x: R.Tensor((2, 3, 28, 28), "float32"), w: R.Tensor((4, 3, 3, 3), "float32")
+        ) -> R.Tensor((2, 4, 676), "float32"):
+            with R.dataflow():
+                gv: R.Tensor((2, 4, 26, 26), "float32") = R.nn.conv2d(x, w, out_dtype="float32")
+                gv2: R.Tensor((2, 4, 676), "float32") = R.reshape(gv, R.shape([2, 4, 676]))
+                gv3: R.Tensor((2, 4, 676), "float32") = R.reshape(gv, R.shape([2, 4, 676]))
+                gv4: R.Tensor((2, 4, 676), "float32") = R.add(gv2, gv3)
+                R.output(gv4)
+            return gv4
+
+    @I.ir_module
+    class Expected:
+        @R.function
+        def main(
+            x: R.Tensor((2, 3, 28, 28), dtype="float32"), w: R.Tensor((4, 3, 3, 3), dtype="float32")
+        ) -> R.Tensor((2, 4, 676), dtype="float32"):
+            with R.dataflow():
+                lv: R.Tensor((2, 28, 28, 3), dtype="float32") = R.permute_dims(x, axes=[0, 2, 3, 1])
+                lv1: R.Tensor((4, 3, 3, 3), dtype="float32") = R.permute_dims(w, axes=[0, 2, 3, 1])
+                lv2: R.Tensor((2, 26, 26, 4), dtype="float32") = R.nn.conv2d(
+                    lv,
+                    lv1,
+                    strides=[1, 1],
+                    padding=[0, 0, 0, 0],
+                    dilation=[1, 1],
+                    groups=1,
+                    data_layout="NHWC",
+                    kernel_layout="OHWI",
+                    out_layout="NHWC",
+                    out_dtype="float32",
+                )
+                gv: R.Tensor((2, 4, 26, 26), dtype="float32") = R.permute_dims(
+                    lv2, axes=[0, 3, 1, 2]
+                )
+                gv2: R.Tensor((2, 4, 676), dtype="float32") = R.reshape(gv, R.shape([2, 4, 676]))
+                gv3: R.Tensor((2, 4, 676), dtype="float32") = R.reshape(gv, R.shape([2, 4, 676]))
+                gv4: R.Tensor((2, 4, 676), dtype="float32") = R.add(gv2, gv3)
+                R.output(gv4)
+            return gv4
+
+    verify(Input, Expected)
+
+
+def test_conv2d_relu_reshape_keeps_produced_layout():
+    # A layout-following consumer votes with the produced layout, so a single
+    # disagreeing consumer does not move the realization away from NHWC.
+    @I.ir_module
+    class Input:
+        @R.function
+        def main(
+            x: R.Tensor((2, 3, 28, 28), "float32"), w: R.Tensor((4, 3, 3, 3), "float32")
+        ) -> R.Tensor((2, 4, 676), "float32"):
+            with R.dataflow():
+                gv: R.Tensor((2, 4, 26, 26), "float32") = R.nn.conv2d(x, w, out_dtype="float32")
+                gv2: R.Tensor((2, 4, 26, 26), "float32") = R.nn.relu(gv)
+                gv3: R.Tensor((2, 4, 676), "float32") = R.reshape(gv, R.shape([2, 4, 676]))
+                gv4: R.Tensor((2, 4, 676), "float32") = R.reshape(gv2, R.shape([2, 4, 676]))
+                gv5: R.Tensor((2, 4, 676), "float32") = R.add(gv3, gv4)
+                R.output(gv5)
+            return gv5
+
+    @I.ir_module
+    class Expected:
+        @R.function
+        def main(
+            x: R.Tensor((2, 3, 28, 28), dtype="float32"), w: R.Tensor((4, 3, 3, 3), dtype="float32")
+        ) -> R.Tensor((2, 4, 676), dtype="float32"):
+            with R.dataflow():
+                lv: R.Tensor((2, 28, 28, 3), dtype="float32") = R.permute_dims(x, axes=[0, 2, 3, 1])
+                lv1: R.Tensor((4, 3, 3, 3), dtype="float32") = R.permute_dims(w, axes=[0, 2, 3, 1])
+                gv: R.Tensor((2, 26, 26, 4), dtype="float32") = R.nn.conv2d(
+                    lv,
+                    lv1,
+                    strides=[1, 1],
+                    padding=[0, 0, 0, 0],
+                    dilation=[1, 1],
+                    groups=1,
+                    data_layout="NHWC",
+                    kernel_layout="OHWI",
+                    out_layout="NHWC",
+                    out_dtype="float32",
+                )
+                gv2: R.Tensor((2, 26, 26, 4), dtype="float32") = R.nn.relu(gv)
+                lv2: R.Tensor((2, 4, 26, 26), dtype="float32") = R.permute_dims(
+                    gv, axes=[0, 3, 1, 2]
+                )
+                gv3: R.Tensor((2, 4, 676), dtype="float32") = R.reshape(lv2, R.shape([2, 4, 676]))
+                lv3: R.Tensor((2, 4, 26, 26), dtype="float32") = R.permute_dims(
+                    gv2, axes=[0, 3, 1, 2]
+                )
+                gv4: R.Tensor((2, 4, 676), dtype="float32") = R.reshape(lv3, R.shape([2, 4, 676]))
+                gv5: R.Tensor((2, 4, 676), dtype="float32") = R.add(gv3, gv4)
+                R.output(gv5)
+            return gv5
+
+    verify(Input, Expected)
+
+
 def test_conv2d_NCHW_sub_indexed():
     @I.ir_module
     class Input:
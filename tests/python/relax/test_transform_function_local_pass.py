@@ -0,0 +1,103 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Tests for the function-local parallel function-pass executor."""
+
+import threading
+
+import tvm
+import tvm.testing
+from tvm import relax
+from tvm.script import ir as I
+from tvm.script import relax as R
+
+
+@I.ir_module
+class MultiFunctionModule:
+    @R.function
+    def f0(x: R.Tensor((4,), "float32")) -> R.Tensor((4,), "float32"):
+        with R.dataflow():
+            gv = R.add(x, x)
+            R.output(gv)
+        return gv
+
+    @R.function
+    def f1(x: R.Tensor((4,), "float32")) -> R.Tensor((4,), "float32"):
+        with R.dataflow():
+            gv = R.multiply(x, x)
+            R.output(gv)
+        return gv
+
+    @R.function
+    def f2(x: R.Tensor((4,), "float32")) -> R.Tensor((4,), "float32"):
+        with R.dataflow():
+            gv = R.subtract(x, x)
+            R.output(gv)
+        return gv
+
+    @R.function
+    def f3(x: R.Tensor((4,), "float32")) -> R.Tensor((4,), "float32"):
+        with R.dataflow():
+            gv = R.add(x, x)
+            R.output(gv)
+        return gv
+
+
+def test_to_non_dataflow_is_function_local():
+    """ToNonDataflow declares itself function-local, enabling the parallel executor."""
+    assert relax.transform.ToNonDataflow().info.function_local
+
+
+def test_function_local_pass_runs_on_every_function():
+    """The parallel executor rewrites every relax function of the module."""
+    mod = relax.transform.ToNonDataflow()(MultiFunctionModule)
+
+    def fvisit(expr):
+        assert not isinstance(expr, relax.DataflowBlock)
+
+    for _, func in mod.functions_items():
+        assert isinstance(func, relax.Function)
+        relax.analysis.post_order_visit(func, fvisit)
+
+
+def test_python_function_pass_opts_into_function_local():
+    """A python pass can opt in through the decorator and sees every function.
+
+    The worker threads serialize on the GIL while calling back into python, so
+    only the transformation result is asserted, not concurrency itself.
+    """
+    seen_names = set()
+    seen_threads = set()
+    lock = threading.Lock()
+
+    @relax.transform.function_pass(opt_level=0, function_local=True)
+    def annotate(func, mod, ctx):
+        with lock:
+            seen_names.add(func.attrs["global_symbol"])
+            seen_threads.add(threading.get_ident())
+        return func.with_attr("visited", 1)
+
+    assert annotate.info.function_local
+
+    mod = annotate(MultiFunctionModule)
+    assert seen_names == {"f0", "f1", "f2", "f3"}
+    assert len(seen_threads) >= 1
+    for _, func in mod.functions_items():
+        assert func.attrs["visited"] == 1
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
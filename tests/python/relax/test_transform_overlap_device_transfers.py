@@ -0,0 +1,80 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Tests for relax.transform.OverlapDeviceTransfers."""
+
+import tvm
+import tvm.testing
+from tvm import relax
+from tvm.script import ir as I
+from tvm.script import relax as R
+
+
+def _collect_callees(func):
+    extern_funcs = set()
+    ops = set()
+
+    def fvisit(expr):
+        if isinstance(expr, relax.ExternFunc):
+            extern_funcs.add(expr.global_symbol)
+        if isinstance(expr, relax.Call) and isinstance(expr.op, tvm.ir.Op):
+            ops.add(expr.op.name)
+
+    relax.analysis.post_order_visit(func, fvisit)
+    return extern_funcs, ops
+
+
+def test_transfer_is_split_into_async_copy_and_wait():
+    @I.ir_module
+    class Before:
+        I.module_global_infos({"vdevice": [I.vdevice("llvm"), I.vdevice("cuda", 0)]})
+
+        @R.function
+        def main(
+            x: R.Tensor((2, 3), "float32", "llvm"),
+            y: R.Tensor((2, 3), "float32", "cuda"),
+        ) -> R.Tensor((2, 3), "float32", "cuda"):
+            with R.dataflow():
+                lv0 = R.to_vdevice(x, "cuda")
+                lv1 = R.add(y, y)
+                gv = R.multiply(lv0, lv1)
+                R.output(gv)
+            return gv
+
+    mod = relax.transform.OverlapDeviceTransfers()(Before)
+    extern_funcs, ops = _collect_callees(mod["main"])
+    assert extern_funcs == {"vm.builtin.to_device_async", "vm.builtin.device_transfer_wait"}
+    assert "relax.to_vdevice" not in ops
+
+
+def test_transfer_leaving_the_block_stays_synchronous():
+    @I.ir_module
+    class Before:
+        I.module_global_infos({"vdevice": [I.vdevice("llvm"), I.vdevice("cuda", 0)]})
+
+        @R.function
+        def main(x: R.Tensor((2, 3), "float32", "llvm")) -> R.Tensor((2, 3), "float32", "cuda"):
+            with R.dataflow():
+                gv = R.to_vdevice(x, "cuda")
+                R.output(gv)
+            return gv
+
+    mod = relax.transform.OverlapDeviceTransfers()(Before)
+    tvm.ir.assert_structural_equal(mod, Before)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
@@ -0,0 +1,96 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Tests for relax.transform.RewriteAttentionKVCache."""
+
+import tvm
+import tvm.testing
+from tvm import relax
+from tvm.script import ir as I
+from tvm.script import relax as R
+
+KV_CACHE_BUILTIN = "vm.builtin.attention_kv_cache_attention_with_fused_qkv"
+
+
+@I.ir_module
+class CausalAttention:
+    @R.function
+    def main(
+        hidden: R.Tensor((1, 4, 64), "float32"),
+        wq: R.Tensor((64, 64), "float32"),
+        wk: R.Tensor((64, 64), "float32"),
+        wv: R.Tensor((64, 64), "float32"),
+    ) -> R.Tensor((1, 4, 8, 8), "float32"):
+        with R.dataflow():
+            q = R.reshape(R.matmul(hidden, wq), R.shape([1, 4, 8, 8]))
+            k = R.reshape(R.matmul(hidden, wk), R.shape([1, 4, 8, 8]))
+            v = R.reshape(R.matmul(hidden, wv), R.shape([1, 4, 8, 8]))
+            out = R.nn.attention(q, k, v, causal_mask="TopLeft")
+            R.output(out)
+        return out
+
+
+def _collect_callees(func):
+    extern_funcs = set()
+    ops = set()
+
+    def fvisit(expr):
+        if isinstance(expr, relax.ExternFunc):
+            extern_funcs.add(expr.global_symbol)
+        if isinstance(expr, relax.Call) and isinstance(expr.op, tvm.ir.Op):
+            ops.add(expr.op.name)
+
+    relax.analysis.post_order_visit(func, fvisit)
+    return extern_funcs, ops
+
+
+def test_causal_attention_is_rewritten_to_the_builtin():
+    mod = relax.transform.RewriteAttentionKVCache()(CausalAttention)
+    func = mod["main"]
+
+    # The rewritten function gains a trailing cache object parameter.
+    assert len(func.params) == 5
+    assert func.params[-1].name_hint == "paged_kv_cache"
+
+    extern_funcs, ops = _collect_callees(func)
+    assert KV_CACHE_BUILTIN in extern_funcs
+    assert "relax.nn.attention" not in ops
+
+
+def test_non_causal_attention_is_untouched():
+    @I.ir_module
+    class NonCausal:
+        @R.function
+        def main(
+            hidden: R.Tensor((1, 4, 64), "float32"),
+            wq: R.Tensor((64, 64), "float32"),
+            wk: R.Tensor((64, 64), "float32"),
+            wv: R.Tensor((64, 64), "float32"),
+        ) -> R.Tensor((1, 4, 8, 8), "float32"):
+            with R.dataflow():
+                q = R.reshape(R.matmul(hidden, wq), R.shape([1, 4, 8, 8]))
+                k = R.reshape(R.matmul(hidden, wk), R.shape([1, 4, 8, 8]))
+                v = R.reshape(R.matmul(hidden, wv), R.shape([1, 4, 8, 8]))
+                out = R.nn.attention(q, k, v)
+                R.output(out)
+            return out
+
+    mod = relax.transform.RewriteAttentionKVCache()(NonCausal)
+    tvm.ir.assert_structural_equal(mod, NonCausal)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
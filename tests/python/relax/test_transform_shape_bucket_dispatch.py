@@ -0,0 +1,71 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Tests for relax.transform.ShapeBucketDispatch."""
+
+import tvm
+import tvm.testing
+from tvm import relax
+from tvm.script import ir as I
+from tvm.script import relax as R
+
+
+@I.ir_module
+class Before:
+    @R.function
+    def main(x: R.Tensor(("n", 8), "float32")) -> R.Tensor(("n", 8), "float32"):
+        gv = R.add(x, x)
+        return gv
+
+
+def test_shape_bucket_dispatch_builds_dispatch_tree():
+    mod = relax.transform.ShapeBucketDispatch({"n": [2, 4]})(Before)
+
+    names = {gv.name_hint for gv in mod.get_global_vars()}
+    assert names == {"main", "main_generic", "main_n2", "main_n4"}
+
+    # Each specialized clone compiles with fully static shapes.
+    for value in (2, 4):
+        func = mod[f"main_n{value}"]
+        shape = [int(dim) for dim in func.params[0].ty.shape]
+        assert shape == [value, 8]
+
+    # The fallback keeps the dynamic shape of the original function.
+    generic = mod["main_generic"]
+    assert isinstance(generic.params[0].ty.shape[0], tvm.tirx.Var)
+
+    # The dispatcher tests each bucket and falls back to the generic clone.
+    if_nodes = []
+    callees = set()
+
+    def fvisit(expr):
+        if isinstance(expr, relax.If):
+            if_nodes.append(expr)
+        if isinstance(expr, relax.Call) and isinstance(expr.op, tvm.ir.GlobalVar):
+            callees.add(expr.op.name_hint)
+
+    relax.analysis.post_order_visit(mod["main"], fvisit)
+    assert len(if_nodes) == 2
+    assert callees == {"main_generic", "main_n2", "main_n4"}
+
+
+def test_functions_without_bucketed_vars_are_untouched():
+    mod = relax.transform.ShapeBucketDispatch({"seq_len": [128, 512]})(Before)
+    tvm.ir.assert_structural_equal(mod, Before)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
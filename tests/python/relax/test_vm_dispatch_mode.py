@@ -0,0 +1,77 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Test the VM interpreter dispatch-mode selection.
+
+TVM_VM_DISPATCH_MODE is read when an executable is loaded into a VM, so the
+same executable can run under both the switch loop and the direct-threaded
+(computed goto) loop. Builds without computed-goto support silently fall back
+to the switch loop, so both settings must produce identical results.
+"""
+
+import numpy as np
+import pytest
+
+import tvm
+import tvm.testing
+from tvm import relax
+from tvm.script import ir as I
+from tvm.script import relax as R
+
+
+@I.ir_module
+class BranchingModule:
+    @R.function
+    def main(
+        x: R.Tensor((4,), "float32"), cond: R.Tensor((), "bool")
+    ) -> R.Tensor((4,), "float32"):
+        if cond:
+            ret = R.add(x, x)
+        else:
+            ret = R.multiply(x, x)
+        return ret
+
+
+DISPATCH_MODES = ["switch", "direct_threaded"]
+
+
+@pytest.mark.parametrize("dispatch_mode", DISPATCH_MODES)
+def test_vm_runs_under_dispatch_mode(dispatch_mode, monkeypatch):
+    monkeypatch.setenv("TVM_VM_DISPATCH_MODE", dispatch_mode)
+    ex = tvm.compile(BranchingModule, target="llvm")
+    vm = relax.VirtualMachine(ex, tvm.cpu())
+    x = tvm.runtime.tensor(np.random.rand(4).astype(np.float32))
+    for cond in [True, False]:
+        res = vm["main"](x, tvm.runtime.tensor(np.bool_(cond)))
+        expected = x.numpy() + x.numpy() if cond else x.numpy() * x.numpy()
+        tvm.testing.assert_allclose(res.numpy(), expected, rtol=1e-7, atol=1e-7)
+
+
+def test_dispatch_modes_agree(monkeypatch):
+    """Both interpreter loops execute the same bytecode to the same result."""
+    ex = tvm.compile(BranchingModule, target="llvm")
+    x = tvm.runtime.tensor(np.random.rand(4).astype(np.float32))
+    cond = tvm.runtime.tensor(np.bool_(True))
+    results = []
+    for dispatch_mode in DISPATCH_MODES:
+        monkeypatch.setenv("TVM_VM_DISPATCH_MODE", dispatch_mode)
+        vm = relax.VirtualMachine(ex, tvm.cpu())
+        results.append(vm["main"](x, cond).numpy())
+    tvm.testing.assert_allclose(results[0], results[1], rtol=0, atol=0)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
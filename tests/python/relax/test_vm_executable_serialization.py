@@ -0,0 +1,93 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Tests for the VM executable bytecode serialization formats.
+
+The current format (V3) stores the code section as variable-width
+instruction words; the loader must also keep accepting the fixed-width V2
+format that older artifacts were saved with.
+"""
+
+import struct
+
+import numpy as np
+
+import tvm
+import tvm.testing
+from tvm import relax
+from tvm.script import relax as R
+
+V2_MAGIC = 0xD225DE2F4214151E
+V3_MAGIC = 0xD225DE2F4214151F
+
+save_to_bytes = tvm.get_global_func("relax.testing.ExecutableSaveToBytes")
+save_to_bytes_legacy = tvm.get_global_func("relax.testing.ExecutableSaveToBytesLegacy")
+load_from_bytes = tvm.get_global_func("relax.testing.ExecutableLoadFromBytes")
+
+
+def build_executable():
+    @tvm.script.ir_module
+    class CopyModule:
+        @R.function(pure=False)
+        def foo(x: R.Tensor((3, 4), "float32")):
+            R.func_attr({"global_symbol": "foo"})
+            z = R.call_packed("vm.builtin.copy", x, ty_args=(R.Tensor((3, 4), dtype="float32")))
+            return z
+
+    builder = relax.ExecBuilder()
+    target = tvm.target.Target("llvm", host="llvm")
+    tir_mod = relax.vm_build._vmcodegen(builder, CopyModule, exec_mode="bytecode")
+    return relax.vm_build._vmlink(builder, target, tir_mod).mod
+
+
+def _magic(blob):
+    return struct.unpack("<Q", bytes(blob)[:8])[0]
+
+
+def _run_foo(rt_mod):
+    vm = relax.VirtualMachine(rt_mod, tvm.cpu())
+    inp = tvm.runtime.tensor(np.random.rand(3, 4).astype("float32"))
+    return inp, vm["foo"](inp)
+
+
+def test_v3_save_load_round_trip():
+    rt_mod = build_executable()
+    blob = save_to_bytes(rt_mod)
+    assert _magic(blob) == V3_MAGIC
+
+    reloaded = load_from_bytes(blob)
+    assert reloaded["as_text"]() == rt_mod["as_text"]()
+
+    # A reloaded executable runs and serializes back to the same bytes.
+    inp, res = _run_foo(reloaded)
+    tvm.testing.assert_allclose(res.numpy(), inp.numpy(), rtol=1e-7, atol=1e-7)
+    assert bytes(save_to_bytes(reloaded)) == bytes(blob)
+
+
+def test_v2_executable_still_loads():
+    rt_mod = build_executable()
+    blob = save_to_bytes_legacy(rt_mod)
+    assert _magic(blob) == V2_MAGIC
+
+    reloaded = load_from_bytes(blob)
+    assert reloaded["as_text"]() == rt_mod["as_text"]()
+
+    inp, res = _run_foo(reloaded)
+    tvm.testing.assert_allclose(res.numpy(), inp.numpy(), rtol=1e-7, atol=1e-7)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
@@ -15,6 +15,8 @@
 # specific language governing permissions and limitations
 # under the License.
 # ruff: noqa: RUF005
+import math
+
 import numpy as np
 import pytest
 
@@ -192,7 +194,139 @@ def test_lower_floordiv_overflow_checks():
     check_value(res, [x], data_check5, lambda a: (min(max(a, -10), 32758)) // 3)
 
 
+def lower_bounded(params, expr, bits):
+    """Lower with the range-specialized fast math budget set to `bits`."""
+    with tvm.transform.PassContext(config={"tirx.bounded_fast_math_bits": bits}):
+        return lower_intrin(params, expr)
+
+
+def intrin_op_names(expr):
+    """Collect the names of all builtin ops called in expr."""
+    names = set()
+
+    def fvisit(node):
+        if isinstance(node, tvm.tirx.Call) and isinstance(node.op, tvm.ir.Op):
+            names.add(node.op.name)
+
+    tvm.tirx.stmt_functor.post_order_visit(expr, fvisit)
+    return names
+
+
+def has_min_max(expr):
+    found = False
+
+    def fvisit(node):
+        nonlocal found
+        if isinstance(node, (tvm.tirx.Min, tvm.tirx.Max)):
+            found = True
+
+    tvm.tirx.stmt_functor.post_order_visit(expr, fvisit)
+    return found
+
+
+def check_relative_accuracy(expr, variable, data, fref, bits):
+    """Check that expr stays within the 2^-bits relative error budget of fref."""
+    n = len(data)
+    in_buf = tvm.tirx.decl_buffer((n,), dtype=variable.ty, name="v0")
+    out_buf = tvm.tirx.decl_buffer((n,), dtype=expr.ty, name="C")
+    loop_var = tvm.tirx.Var("i", "int32")
+    body = tvm.tirx.BufferStore(
+        out_buf, tvm.tirx.Let(variable, tvm.tirx.BufferLoad(in_buf, [loop_var]), expr), [loop_var]
+    )
+    loop = tvm.tirx.For(
+        loop_var,
+        tvm.tirx.const(0, "int32"),
+        tvm.tirx.const(n, "int32"),
+        tvm.tirx.ForKind.SERIAL,
+        body,
+    )
+    prim_func = tvm.tirx.PrimFunc([in_buf, out_buf], loop)
+    prim_func = prim_func.with_attr({"tirx.noalias": True, "global_symbol": "main"})
+    f = tvm.compile(prim_func, "llvm")
+
+    a = tvm.runtime.tensor(np.array(data, dtype=str(variable.ty)))
+    c = tvm.runtime.tensor(np.zeros(n, dtype=str(expr.ty)))
+    f(a, c)
+    cref = np.array([fref(v) for v in data], dtype="float64")
+    rel_err = np.abs(c.numpy().astype("float64") - cref) / np.maximum(
+        np.abs(cref), np.finfo("float32").tiny
+    )
+    assert np.max(rel_err) <= 2.0**-bits, f"relative error {np.max(rel_err)} exceeds 2^-{bits}"
+
+
+@pytest.mark.skipif(not env.has_llvm(), reason="need llvm")
+def test_lower_bounded_exp():
+    """exp over a provable domain lowers to a polynomial meeting the budget."""
+    x = tvm.tirx.Var("x", "int8")
+    data = list(range(-128, 128))
+
+    # Wide domain [-6.4, 6.35]: the 2^n * p(f) reduction, with the fractional
+    # polynomial degree selected by the accuracy budget.
+    expr = tvm.tirx.exp(tvm.tirx.Cast("float32", x) * tvm.tirx.const(0.05, "float32"))
+    for bits in [8, 13, 18]:
+        res = lower_bounded([x], expr, bits)
+        assert "tirx.exp" not in intrin_op_names(res)
+        check_relative_accuracy(res, x, data, lambda v: math.exp(v * 0.05), bits)
+
+    # Narrow domain [-0.5, 0.496]: a plain truncated Taylor expansion, without
+    # the exponent assembly of the range reduction.
+    narrow = tvm.tirx.exp(tvm.tirx.Cast("float32", x) * tvm.tirx.const(1.0 / 256.0, "float32"))
+    res = lower_bounded([x], narrow, 16)
+    names = intrin_op_names(res)
+    assert "tirx.exp" not in names
+    assert "tirx.reinterpret" not in names
+    check_relative_accuracy(res, x, data, lambda v: math.exp(v / 256.0), 16)
+
+
+@pytest.mark.skipif(not env.has_llvm(), reason="need llvm")
+def test_lower_bounded_erf():
+    """erf over a provable domain lowers to the cheapest fitting approximation."""
+    x = tvm.tirx.Var("x", "int8")
+    data = list(range(-128, 128))
+
+    # Domain [-1, 0.992]: the lowest-degree odd Taylor polynomial meeting the
+    # budget.
+    narrow = tvm.tirx.erf(tvm.tirx.Cast("float32", x) * tvm.tirx.const(1.0 / 128.0, "float32"))
+    for bits in [8, 12]:
+        res = lower_bounded([x], narrow, bits)
+        assert "tirx.erf" not in intrin_op_names(res)
+        check_relative_accuracy(res, x, data, lambda v: math.erf(v / 128.0), bits)
+
+    # Domain [-4, 3.97]: the rational approximation, with the [-4, 4] clamp of
+    # the generic fast path elided because the domain is proven.
+    wide = tvm.tirx.erf(tvm.tirx.Cast("float32", x) * tvm.tirx.const(1.0 / 32.0, "float32"))
+    res = lower_bounded([x], wide, 14)
+    assert "tirx.erf" not in intrin_op_names(res)
+    assert not has_min_max(res)
+    check_relative_accuracy(res, x, data, lambda v: math.erf(v / 32.0), 14)
+
+
+def test_bounded_fast_math_disabled_by_default():
+    """Without the config the generic lowering is untouched."""
+    x = tvm.tirx.Var("x", "int8")
+    expr = tvm.tirx.exp(tvm.tirx.Cast("float32", x) * tvm.tirx.const(0.05, "float32"))
+    default_res = lower_intrin([x], expr)
+    zero_res = lower_bounded([x], expr, 0)
+    bounded_res = lower_bounded([x], expr, 16)
+    tvm.ir.assert_structural_equal(default_res, zero_res)
+    assert not tvm.ir.structural_equal(default_res, bounded_res)
+    assert "tirx.exp" not in intrin_op_names(bounded_res)
+
+
+def test_bounded_fast_math_declines_unbounded_domain():
+    """A float argument with no provable range keeps the generic lowering."""
+    x = tvm.tirx.Var("x", "float32")
+    expr = tvm.tirx.exp(x)
+    default_res = lower_intrin([x], expr)
+    bounded_res = lower_bounded([x], expr, 16)
+    tvm.ir.assert_structural_equal(default_res, bounded_res)
+
+
 if __name__ == "__main__":
     test_lower_floordiv()
     test_lower_floormod()
     test_lower_floordiv_overflow_checks()
+    test_lower_bounded_exp()
+    test_lower_bounded_erf()
+    test_bounded_fast_math_disabled_by_default()
+    test_bounded_fast_math_declines_unbounded_domain()
@@ -0,0 +1,64 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Unittests for the TVMScript parse cache (TVM_SCRIPT_PARSE_CACHE=1)."""
+
+import tvm
+import tvm.testing
+from tvm.script.ir_builder import _ffi_api as ir_builder_ffi
+from tvm.script.parser.core.entry import parse
+
+MODULE_SOURCE = """
+@I.ir_module
+class Module:
+    @R.function
+    def main(x: R.Tensor((4,), "float32")) -> R.Tensor((4,), "float32"):
+        gv = R.add(x, x)
+        return gv
+"""
+
+
+def test_parse_cache_disabled_by_default(monkeypatch):
+    monkeypatch.delenv("TVM_SCRIPT_PARSE_CACHE", raising=False)
+    ir_builder_ffi.ParseCacheClear()
+    parse(MODULE_SOURCE)
+    assert ir_builder_ffi.ParseCacheSize() == 0
+
+
+def test_parse_cache_hit(monkeypatch):
+    monkeypatch.setenv("TVM_SCRIPT_PARSE_CACHE", "1")
+    ir_builder_ffi.ParseCacheClear()
+    first = parse(MODULE_SOURCE)
+    assert ir_builder_ffi.ParseCacheSize() == 1
+    second = parse(MODULE_SOURCE)
+    # Served from the cache: no new entry, structurally identical result.
+    assert ir_builder_ffi.ParseCacheSize() == 1
+    tvm.ir.assert_structural_equal(first, second)
+    # The module container is cloned on every hit so callers may mutate it.
+    assert first is not second
+
+
+def test_parse_cache_key_includes_parse_flags(monkeypatch):
+    monkeypatch.setenv("TVM_SCRIPT_PARSE_CACHE", "1")
+    ir_builder_ffi.ParseCacheClear()
+    parse(MODULE_SOURCE, check_well_formed=True)
+    parse(MODULE_SOURCE, check_well_formed=False)
+    # Distinct parse options must not share an entry.
+    assert ir_builder_ffi.ParseCacheSize() == 2
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
@@ -455,13 +455,28 @@ export class WebGPUContext {
   }
 
   /**
-   * Flush all pending compute passes by finishing and submitting the
-   * accumulated command encoder.
+   * Get the pending command encoder, creating one if no batch is open.
+   *
+   * Compute passes and GPU↔GPU copies are recorded into this shared
+   * encoder; WebGPU orders commands within a command buffer, so the
+   * implicit barriers between consecutive passes and copies come for
+   * free and a whole sequence of kernel launches submits as a single
+   * command buffer on flush.
+   */
+  private getPendingEncoder(): GPUCommandEncoder {
+    if (!this.pendingEncoder) {
+      this.pendingEncoder = this.device.createCommandEncoder();
+    }
+    return this.pendingEncoder;
+  }
+
+  /**
+   * Flush all pending compute passes and copies by finishing and
+   * submitting the accumulated command encoder.
    *
    * Must be called before:
    * - GPU→CPU readback (deviceCopyFromGPU)
    * - CPU→GPU writes (deviceCopyToGPU, copyRawBytesToBuffer)
-   * - GPU↔GPU copies (deviceCopyWithinGPU)
    * - Buffer deallocation (deviceFreeDataSpace)
    * - Queue sync (sync)
    */
@@ -533,6 +548,9 @@ export class WebGPUContext {
     if (this.canvasRenderManager == undefined) {
       throw Error("Do not have a canvas context, call bindCanvas first");
     }
+    // The render manager submits its own command buffer, so the batched
+    // passes and copies producing the image must be submitted first.
+    this.flushCommands();
     this.canvasRenderManager.draw(this.gpuBufferFromPtr(ptr), height, width);
   }
 
@@ -721,11 +739,7 @@ export class WebGPUContext {
         }
 
         // Reuse a single command encoder across dispatches; only flush on sync/readback.
-        if (!this.pendingEncoder) {
-          this.pendingEncoder = this.device.createCommandEncoder();
-        }
-
-        const compute = this.pendingEncoder.beginComputePass();
+        const compute = this.getPendingEncoder().beginComputePass();
         compute.setPipeline(pipeline);
         const bindGroupEntries: Array<GPUBindGroupEntry> = [];
         const numBufferOrPodArgs = bufferArgIndices.length + podArgIndices.length;
@@ -1038,18 +1052,17 @@ export class WebGPUContext {
     toOffset: number,
     nbytes: number
   ): void {
-    // Flush batched compute passes before the GPU-to-GPU copy.
-    this.flushCommands();
-    const copyEncoder = this.device.createCommandEncoder();
-    copyEncoder.copyBufferToBuffer(
+    // Record the copy into the pending batch instead of submitting its
+    // own command buffer. Commands within one encoder execute in order,
+    // so the copy sees every pending dispatch that wrote its source and
+    // later dispatches see the copied bytes, without splitting the batch.
+    this.getPendingEncoder().copyBufferToBuffer(
       this.gpuBufferFromPtr(from),
       fromOffset,
       this.gpuBufferFromPtr(to),
       toOffset,
       nbytes
     );
-    const copyCommands = copyEncoder.finish();
-    this.device.queue.submit([copyCommands]);
   }
 
   private gpuBufferFromPtr(ptr: GPUPointer): GPUBuffer {